@@ -73,6 +73,14 @@ public:
     */
     virtual ppl::common::RetCode Sync() = 0;
 
+    /**
+       @brief runs the model `count` times with shapes of current inputs, so that tensor buffers, temporary buffers
+       and threads used by engines are ready before the first real `Run()`.
+       @note inputs without data are filled with zeros. fill them with representative data before calling this
+       function if the model depends on input values, e.g. shapes computed from inputs.
+    */
+    virtual ppl::common::RetCode WarmUp(uint32_t count = 1) = 0;
+
     /**
        @brief get the number of outputs of the associated graph.
     */
@@ -31,6 +31,7 @@ TensorBufferInfo::TensorBufferInfo(TensorBufferInfo&& info) {
     buffer_ = info.buffer_;
     device_ = info.device_;
     shape_ = std::move(info.shape_);
+    parent_buffer_ = std::move(info.parent_buffer_);
 
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
@@ -46,6 +47,7 @@ TensorBufferInfo& TensorBufferInfo::operator=(TensorBufferInfo&& info) {
     buffer_ = info.buffer_;
     device_ = info.device_;
     shape_ = std::move(info.shape_);
+    parent_buffer_ = std::move(info.parent_buffer_);
 
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
@@ -79,6 +81,7 @@ void TensorBufferInfo::SetBuffer(const BufferDesc& buf, Device* device, bool is_
 
     buffer_ = buf;
     is_buffer_owner_ = is_buffer_owner;
+    parent_buffer_.reset();
 }
 
 RetCode TensorBufferInfo::ReallocBuffer() {
@@ -89,6 +92,7 @@ RetCode TensorBufferInfo::ReallocBuffer() {
 
     if (!is_buffer_owner_) {
         buffer_.addr = nullptr;
+        parent_buffer_.reset();
     }
 
     auto status = device_->Realloc(shape_, &buffer_);
@@ -106,6 +110,7 @@ BufferDesc TensorBufferInfo::DetachBuffer() {
     auto ret = buffer_;
     buffer_.addr = nullptr;
     is_buffer_owner_ = false;
+    parent_buffer_.reset();
     return ret;
 }
 
@@ -116,6 +121,39 @@ void TensorBufferInfo::FreeBuffer() {
     }
 
     buffer_.addr = nullptr;
+    parent_buffer_.reset();
+}
+
+void TensorBufferInfo::TransferBufferFrom(TensorBufferInfo* another) {
+    auto parent_buffer = std::move(another->parent_buffer_);
+    SetBuffer(another->buffer_, another->device_, another->is_buffer_owner_);
+    parent_buffer_ = std::move(parent_buffer);
+    another->DetachBuffer();
+}
+
+RetCode TensorBufferInfo::ShareBufferFrom(TensorBufferInfo* another, uint64_t offset) {
+    if (!another->CanShareBuffer()) {
+        LOG(ERROR) << "ShareBufferFrom() failed: buffer of the source tensor cannot be shared.";
+        return RC_PERMISSION_DENIED;
+    }
+
+    if (another->is_buffer_owner_) {
+        auto device = another->device_;
+        another->parent_buffer_.reset(new BufferDesc(another->buffer_), [device](BufferDesc* buffer) -> void {
+            device->Free(buffer);
+            delete buffer;
+        });
+        another->is_buffer_owner_ = false;
+    }
+
+    auto parent_buffer = another->parent_buffer_;
+    BufferDesc view = another->buffer_;
+    view.addr = (char*)another->buffer_.addr + offset;
+
+    SetBuffer(view, another->device_, false);
+    parent_buffer_ = std::move(parent_buffer);
+
+    return RC_SUCCESS;
 }
 
 }} // namespace ppl::nn
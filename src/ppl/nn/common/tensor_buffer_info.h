@@ -20,6 +20,7 @@
 
 #include "ppl/nn/common/tensor_shape.h"
 #include "ppl/nn/common/device.h"
+#include <memory>
 
 namespace ppl { namespace nn {
 
@@ -60,6 +61,24 @@ public:
     /** @brief free internal buffer */
     void FreeBuffer();
 
+    /**
+       @brief move buffer from `another`. old buffer of this tensor will be freed(or detached).
+       @note this tensor inherits the ownership of `another`, including buffers shared by views.
+    */
+    void TransferBufferFrom(TensorBufferInfo* another);
+
+    /** @brief tells whether ShareBufferFrom() can make views of this tensor's buffer */
+    bool CanShareBuffer() const {
+        return (is_buffer_owner_ || parent_buffer_) && buffer_.addr;
+    }
+
+    /**
+       @brief makes this tensor a view of `another`'s buffer starting at `offset` bytes. old buffer of this tensor
+       will be freed(or detached). the shared buffer is freed after `another` and all of its views release it.
+       @note `another` must satisfy CanShareBuffer(). it gives up the ownership of its buffer to the shared one.
+    */
+    ppl::common::RetCode ShareBufferFrom(TensorBufferInfo* another, uint64_t offset);
+
     ppl::common::RetCode ReallocBuffer();
 
     template <typename T = void>
@@ -91,6 +110,9 @@ private:
     Device* device_;
     TensorShape shape_;
 
+    /** keeps the buffer alive while this tensor is (or is a view of) a shared buffer */
+    std::shared_ptr<BufferDesc> parent_buffer_;
+
 private:
     TensorBufferInfo(const TensorBufferInfo&) = delete;
     TensorBufferInfo& operator=(const TensorBufferInfo&) = delete;
@@ -21,6 +21,7 @@
 #include "ppl/nn/utils/generic_cpu_device.h"
 #include "ppl/nn/utils/utils.h"
 #include "ppl/nn/common/logger.h"
+#include <algorithm>
 using namespace std;
 using namespace ppl::common;
 
@@ -29,22 +30,32 @@ namespace ppl { namespace nn { namespace common {
 template <typename T>
 void EmptyDeleter(T*) {}
 
-RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, const RuntimeGraphInfo* info,
-                                     const RuntimeAuxInfo* aux_info, utils::SharedResource* resource,
-                                     LoopConcatOutputFunc func) {
-    auto status = subgraph_.Init(RuntimeOptions(), // TODO
-                                 topo, shared_ptr<const RuntimeGraphInfo>(info, EmptyDeleter<const RuntimeGraphInfo>),
-                                 shared_ptr<const RuntimeAuxInfo>(aux_info, EmptyDeleter<const RuntimeAuxInfo>),
-                                 shared_ptr<utils::SharedResource>(resource, EmptyDeleter<utils::SharedResource>));
+void LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, const RuntimeGraphInfo* info,
+                                  const RuntimeAuxInfo* aux_info, utils::SharedResource* resource) {
+    topo_ = topo;
+    graph_info_ = info;
+    aux_info_ = aux_info;
+    resource_ = resource;
+}
+
+RetCode LoopKernel::InitSubgraph(const RuntimeOptions& options) {
+    auto status = subgraph_.Init(
+        options, topo_, shared_ptr<const RuntimeGraphInfo>(graph_info_, EmptyDeleter<const RuntimeGraphInfo>),
+        shared_ptr<const RuntimeAuxInfo>(aux_info_, EmptyDeleter<const RuntimeAuxInfo>),
+        shared_ptr<utils::SharedResource>(resource_, EmptyDeleter<utils::SharedResource>));
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "init loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
         return status;
     }
 
-    concat_output_func_ = func;
+    is_subgraph_initialized_ = true;
     return RC_SUCCESS;
 }
 
+RetCode LoopKernel::SetRuntimeOptions(const RuntimeOptions& options) {
+    return InitSubgraph(options);
+}
+
 static inline int64_t GetMaxTripCount(const KernelExecContext& ctx) {
     int64_t trip_count = INT64_MAX;
     auto input0 = ctx.GetInput<TensorImpl>(0);
@@ -67,49 +78,126 @@ static inline RetCode GetKeepGoing(const KernelExecContext& ctx, bool* keep_goin
     return RC_SUCCESS;
 }
 
+/*
+  scan outputs of all iterations are stored back to back in one buffer, which is allocated by the device of the loop's
+  output and grows geometrically, so that it can be handed over to the output without concatenating.
+*/
+struct ScanOutputBuffer {
+    TensorBufferInfo buffer;
+    TensorShape slice_shape;
+    uint64_t slice_bytes = 0;
+    uint64_t capacity = 0; // in iterations
+    vector<char> host_slice; // slices from another device are copied through it
+};
+
 struct LoopInfo {
     LoopInfo(const KernelExecContext& ctx) {
         loop_carried_dep_num = ctx.GetInputCount() - 2; // N
         scan_output_num = ctx.GetOutputCount() - loop_carried_dep_num; // K
-        intermediate_outputs.resize(scan_output_num);
+        scan_outputs.resize(scan_output_num);
     }
 
     uint32_t loop_carried_dep_num;
     uint32_t scan_output_num;
-    vector<vector<TensorBufferInfo>> intermediate_outputs;
+    vector<ScanOutputBuffer> scan_outputs;
 };
 
-static RetCode SaveSubgraphOutputs(RuntimeImpl* subgraph, LoopInfo* info) {
+static const uint64_t g_min_scan_output_capacity = 8;
+
+static RetCode ReserveScanOutputBuffer(uint64_t capacity, Device* device, ScanOutputBuffer* scan_buffer) {
+    TensorBufferInfo new_buffer;
+    auto status = new_buffer.SetDevice(device);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    int64_t bytes = capacity * scan_buffer->slice_bytes;
+    new_buffer.GetShape().SetDataType(DATATYPE_UINT8);
+    new_buffer.GetShape().SetDataFormat(DATAFORMAT_NDARRAY);
+    new_buffer.GetShape().Reshape(&bytes, 1);
+    status = new_buffer.ReallocBuffer();
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    // slices saved so far are kept in the same place
+    const uint64_t used_bytes = min(scan_buffer->capacity, capacity) * scan_buffer->slice_bytes;
+    if (used_bytes > 0) {
+        status = device->Copy(&new_buffer.GetBufferDesc(), scan_buffer->buffer.GetBufferDesc(), used_bytes);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+    }
+
+    scan_buffer->buffer = std::move(new_buffer);
+    scan_buffer->capacity = capacity;
+    return RC_SUCCESS;
+}
+
+static bool IsSameDims(const TensorShape& a, const TensorShape& b) {
+    if (a.GetDimCount() != b.GetDimCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetDimCount(); ++i) {
+        if (a.GetDim(i) != b.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// copies the scan output of one iteration into `dst`, which may be on another device than the subgraph's output
+static RetCode CopySlice(const TensorImpl& src, Device* dst_device, BufferDesc* dst, ScanOutputBuffer* scan_buffer) {
+    auto src_device = src.GetDevice();
+    if (src_device == dst_device) {
+        return dst_device->Copy(dst, src.GetBufferDesc(), scan_buffer->slice_bytes);
+    }
+
+    scan_buffer->host_slice.resize(scan_buffer->slice_bytes);
+    auto status = src_device->CopyToHost(scan_buffer->host_slice.data(), src.GetBufferDesc(), scan_buffer->slice_bytes);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+    return dst_device->CopyFromHost(dst, scan_buffer->host_slice.data(), scan_buffer->slice_bytes);
+}
+
+static RetCode AppendSubgraphOutputs(int64_t iteration, int64_t max_trip_count, RuntimeImpl* subgraph,
+                                     KernelExecContext* ctx, LoopInfo* info) {
     for (uint32_t i = 0; i < info->scan_output_num; ++i) {
         auto scan_output = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        auto scan_buffer = &info->scan_outputs[i];
+
+        if (iteration == 0) {
+            scan_buffer->slice_shape = scan_output->GetShape();
+            scan_buffer->slice_bytes = scan_output->GetShape().GetBytesIncludingPadding();
+        } else if (!IsSameDims(scan_buffer->slice_shape, scan_output->GetShape())) {
+            LOG(ERROR) << "shape of scan output[" << scan_output->GetName() << "] changes in iteration[" << iteration
+                       << "].";
+            return RC_INVALID_VALUE;
+        }
 
-        TensorBufferInfo output_buffer;
-        if (scan_output->IsBufferOwner()) {
-            output_buffer.Reshape(scan_output->GetShape());
-            output_buffer.SetBuffer(scan_output->GetBufferDesc(), scan_output->GetDevice(), true);
-            scan_output->DetachBuffer();
-        } else {
-            auto device = scan_output->GetDevice();
-
-            output_buffer.SetDevice(scan_output->GetDevice());
-            output_buffer.Reshape(scan_output->GetShape());
-            auto status = output_buffer.ReallocBuffer();
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "alloc buffer for tensor[" << scan_output->GetName()
-                           << "] failed: " << GetRetCodeStr(status);
-                return status;
+        if ((uint64_t)iteration >= scan_buffer->capacity) {
+            auto device = ctx->GetOutput<TensorImpl>(info->loop_carried_dep_num + i)->GetDevice();
+            if (!device) {
+                device = scan_output->GetDevice();
             }
-
-            status =
-                device->Copy(&output_buffer.GetBufferDesc(), scan_output->GetBufferDesc(), scan_output->GetShape());
+            const uint64_t capacity = min<uint64_t>(max(scan_buffer->capacity * 2, g_min_scan_output_capacity),
+                                                    max<int64_t>(max_trip_count, iteration + 1));
+            auto status = ReserveScanOutputBuffer(capacity, device, scan_buffer);
             if (status != RC_SUCCESS) {
-                LOG(ERROR) << "copy data from tensor[" << scan_output->GetName()
+                LOG(ERROR) << "reserve [" << capacity << "] slices for scan output[" << scan_output->GetName()
                            << "] failed: " << GetRetCodeStr(status);
                 return status;
             }
         }
 
-        info->intermediate_outputs[i].emplace_back(std::move(output_buffer));
+        BufferDesc slice = scan_buffer->buffer.GetBufferDesc();
+        slice.addr = (char*)slice.addr + iteration * scan_buffer->slice_bytes;
+        auto status = CopySlice(*scan_output, scan_buffer->buffer.GetDevice(), &slice, scan_buffer);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "copy data from tensor[" << scan_output->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
     }
 
     return RC_SUCCESS;
@@ -129,7 +217,18 @@ static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
         auto src = subgraph->GetOutputTensorImpl(i - 1);
         dst->GetShape() = src->GetShape();
         if (dst->GetDevice() == src->GetDevice()) {
-            dst->TransferBufferFrom(src);
+            if (dst->GetBufferPtr() == src->GetBufferPtr()) {
+                continue; // output is the input itself
+            }
+            if (dst->IsBufferOwner() && src->IsBufferOwner()) {
+                // double buffering: the output takes over the input's old buffer and writes the next value into it
+                auto device = dst->GetDevice();
+                BufferDesc prev = dst->DetachBuffer();
+                dst->SetBuffer(src->DetachBuffer(), device, true);
+                src->SetBuffer(prev, device, true);
+            } else {
+                dst->TransferBufferFrom(src);
+            }
         } else {
             // outputs are already synchronized by subgraph->Sync()
             status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
@@ -216,7 +315,8 @@ static RetCode InitSubgraphInputs(const KernelExecContext& ctx, bool keep_going,
     return RC_SUCCESS;
 }
 
-static RetCode SetOutputsFromInputs(const LoopInfo& info, const string& loop_kernel_name, Device* tmp_cpu_device,
+static RetCode SetOutputsFromInputs(const LoopInfo& info, const string& loop_kernel_name,
+                                    const RuntimeGraphInfo& graph_info, Device* tmp_cpu_device,
                                     RuntimeImpl* subgraph, KernelExecContext* ctx) {
     // copy loop carried deps from loop's input
     for (uint32_t i = 0; i < info.loop_carried_dep_num; ++i) {
@@ -233,35 +333,44 @@ static RetCode SetOutputsFromInputs(const LoopInfo& info, const string& loop_ker
         }
     }
 
-    // create empty scan outputs
+    // scan outputs of zero iterations are empty tensors with dims [0, <dims of a slice>]
     for (uint32_t i = info.loop_carried_dep_num; i < ctx->GetOutputCount(); ++i) {
         auto src = subgraph->GetOutputTensorImpl(i + 1); // skip `cond`
-        auto& src_shape = src->GetShape();
+        const TensorShape* slice_shape = &src->GetShape();
+        if (slice_shape->IsEmpty()) { // subgraph has never run, try the shape inferred when it was optimized
+            auto shape_ref = graph_info.shapes.find(src->GetEdge()->GetId());
+            if (shape_ref != graph_info.shapes.end()) {
+                slice_shape = &shape_ref->second;
+            }
+        }
 
-        if (src_shape.IsEmpty()) {
+        if (slice_shape->IsEmpty()) {
             LOG(WARNING) << "loop kernel[" << loop_kernel_name << "] trip count is 0 and "
                          << "cannot find output shape from subgraph.";
-        } else {
-            auto output = ctx->GetOutput<TensorImpl>(i);
-            output->GetShape() = src_shape;
+            continue;
+        }
 
-            auto status = output->ReallocBuffer();
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "ReallocBuffer for empty scan output[" << output->GetName()
-                           << "] failed: " << GetRetCodeStr(status);
-                return status;
-            }
+        vector<int64_t> dims(1 + slice_shape->GetDimCount());
+        dims[0] = 0;
+        for (uint32_t j = 0; j < slice_shape->GetDimCount(); ++j) {
+            dims[j + 1] = slice_shape->GetDim(j);
         }
+
+        auto output = ctx->GetOutput<TensorImpl>(i);
+        output->FreeBuffer();
+        auto output_shape = &output->GetShape();
+        output_shape->SetDataType(slice_shape->GetDataType());
+        output_shape->SetDataFormat(slice_shape->GetDataFormat());
+        output_shape->Reshape(dims.data(), dims.size());
     }
 
     return RC_SUCCESS;
 }
 
-static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_device,
-                                      LoopConcatOutputFunc concat_output_func, RuntimeImpl* subgraph,
-                                      KernelExecContext* ctx) {
+static RetCode SetOutputsFromSubgraph(int64_t trip_count, Device* tmp_cpu_device, RuntimeImpl* subgraph,
+                                      LoopInfo* info, KernelExecContext* ctx) {
     // copy loop carried deps from subgraph's output
-    for (uint32_t i = 0; i < info.loop_carried_dep_num; ++i) {
+    for (uint32_t i = 0; i < info->loop_carried_dep_num; ++i) {
         auto src = subgraph->GetOutputTensorImpl(i + 1);
         auto dst = ctx->GetOutput<TensorImpl>(i);
 
@@ -276,33 +385,25 @@ static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_devi
         }
     }
 
-    for (uint32_t i = info.loop_carried_dep_num; i < ctx->GetOutputCount(); ++i) {
-        auto dst = ctx->GetOutput<TensorImpl>(i);
-
-        auto& outputs = info.intermediate_outputs[i];
-        auto& output_shape = outputs[i].GetShape();
-
-        vector<int64_t> dims(1 + output_shape.GetDimCount());
-        dims[0] = outputs.size();
-        for (uint32_t j = 0; j < output_shape.GetDimCount(); ++j) {
-            dims[j + 1] = output_shape.GetDim(j);
+    // scan outputs take over the buffers that all iterations have been written into
+    for (uint32_t i = 0; i < info->scan_output_num; ++i) {
+        auto dst = ctx->GetOutput<TensorImpl>(info->loop_carried_dep_num + i);
+        auto scan_buffer = &info->scan_outputs[i];
+        auto& slice_shape = scan_buffer->slice_shape;
+
+        vector<int64_t> dims(1 + slice_shape.GetDimCount());
+        dims[0] = trip_count;
+        for (uint32_t j = 0; j < slice_shape.GetDimCount(); ++j) {
+            dims[j + 1] = slice_shape.GetDim(j);
         }
 
         auto dst_shape = &dst->GetShape();
-        dst_shape->SetDataType(output_shape.GetDataType());
-        dst_shape->SetDataFormat(output_shape.GetDataFormat());
+        dst_shape->SetDataType(slice_shape.GetDataType());
+        dst_shape->SetDataFormat(slice_shape.GetDataFormat());
         dst_shape->Reshape(dims.data(), dims.size());
 
-        auto status = dst->ReallocBuffer();
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "ReallocBuffer for tensor[" << dst->GetName() << "] failed: " << GetRetCodeStr(status);
-            return status;
-        }
-
-        status = concat_output_func(outputs, &dst->GetBufferDesc());
-        if (status != RC_SUCCESS) {
-            return status;
-        }
+        auto device = scan_buffer->buffer.GetDevice();
+        dst->SetBuffer(scan_buffer->buffer.DetachBuffer(), device, true);
     }
 
     return RC_SUCCESS;
@@ -337,6 +438,13 @@ static RetCode SyncAllInputs(KernelExecContext* ctx) {
 }
 
 RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
+    if (!is_subgraph_initialized_) {
+        auto status = InitSubgraph(RuntimeOptions());
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+    }
+
     auto status = SyncAllInputs(ctx);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "sync inputs of loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
@@ -354,7 +462,7 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
     }
 
     if (!keep_going) {
-        return SetOutputsFromInputs(loop_info, GetName(), &tmp_cpu_device, &subgraph_, ctx);
+        return SetOutputsFromInputs(loop_info, GetName(), *graph_info_, &tmp_cpu_device, &subgraph_, ctx);
     }
 
     const int64_t max_trip_count = GetMaxTripCount(*ctx);
@@ -373,11 +481,6 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
                 LOG(ERROR) << "UpdateSubgraphInputs failed: " << GetRetCodeStr(status);
                 return status;
             }
-            status = SaveSubgraphOutputs(&subgraph_, &loop_info);
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "SaveSubgraphOutputs failed: " << GetRetCodeStr(status);
-                return status;
-            }
         }
 
         status = subgraph_.Run();
@@ -392,6 +495,12 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             return status;
         }
 
+        status = AppendSubgraphOutputs(trip_count, max_trip_count, &subgraph_, ctx, &loop_info);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "AppendSubgraphOutputs failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
         ++trip_count;
         status = subgraph_.GetOutputTensorImpl(0)->CopyToHost(&keep_going);
         if (status != RC_SUCCESS) {
@@ -401,14 +510,13 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
     }
 
     if (trip_count == 0) {
-        status = SetOutputsFromInputs(loop_info, GetName(), &tmp_cpu_device, &subgraph_, ctx);
+        status = SetOutputsFromInputs(loop_info, GetName(), *graph_info_, &tmp_cpu_device, &subgraph_, ctx);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "SetOutputsFromInputs of loop kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
             return status;
         }
     } else {
-        SaveSubgraphOutputs(&subgraph_, &loop_info);
-        status = SetOutputsFromSubgraph(loop_info, &tmp_cpu_device, concat_output_func_, &subgraph_, ctx);
+        status = SetOutputsFromSubgraph(trip_count, &tmp_cpu_device, &subgraph_, &loop_info, ctx);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "SetOutputsFromSubgraph of loop kernel[" << GetName()
                        << "] failed: " << GetRetCodeStr(status);
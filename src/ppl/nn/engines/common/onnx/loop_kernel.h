@@ -23,20 +23,29 @@
 
 namespace ppl { namespace nn { namespace common {
 
-typedef ppl::common::RetCode (*LoopConcatOutputFunc)(const std::vector<TensorBufferInfo>&, BufferDesc*);
-
 class LoopKernel final : public CommonKernelImpl {
 public:
     LoopKernel(const ir::Node* node) : CommonKernelImpl(node) {}
-    ppl::common::RetCode SetExecutionInfo(const std::shared_ptr<ir::GraphTopo>&, const RuntimeGraphInfo*,
-                                          const RuntimeAuxInfo*, utils::SharedResource*, LoopConcatOutputFunc func);
+    void SetExecutionInfo(const std::shared_ptr<ir::GraphTopo>&, const RuntimeGraphInfo*, const RuntimeAuxInfo*,
+                          utils::SharedResource*);
+
+    /** @brief the subgraph is initialized here with options of the outer runtime */
+    ppl::common::RetCode SetRuntimeOptions(const RuntimeOptions&) override;
 
 protected:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
 private:
+    ppl::common::RetCode InitSubgraph(const RuntimeOptions&);
+
+private:
+    bool is_subgraph_initialized_ = false;
     RuntimeImpl subgraph_;
-    LoopConcatOutputFunc concat_output_func_;
+
+    std::shared_ptr<ir::GraphTopo> topo_;
+    const RuntimeGraphInfo* graph_info_ = nullptr;
+    const RuntimeAuxInfo* aux_info_ = nullptr;
+    utils::SharedResource* resource_ = nullptr;
 };
 
 }}} // namespace ppl::nn::common
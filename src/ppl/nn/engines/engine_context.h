@@ -34,6 +34,12 @@ public:
 
     /** @brief get device instance used by `Runtime` */
     virtual Device* GetDevice() = 0;
+
+    /** @brief called on the calling thread of `Runtime::Run()` before any kernel of this run is executed */
+    virtual void BeforeRun() {}
+
+    /** @brief called on the calling thread of `Runtime::Run()` after all kernels of this run are executed */
+    virtual void AfterRun() {}
 };
 
 }} // namespace ppl::nn
@@ -55,6 +55,19 @@ public:
     /** @brief tells whether this engine can run an op specified by `node`. */
     virtual bool CanRunOp(const ir::Node* node) const = 0;
 
+    /**
+       @brief estimates the time of running `node` in microseconds, so that results of different engines are
+       comparable.
+       @param graph where `node` and its attributes come from
+       @param input_shapes shapes of `node`'s inputs. an element is nullptr if that shape is unknown.
+       @return RC_UNSUPPORTED if this engine cannot estimate `node`, and callers should use their own defaults.
+    */
+    virtual ppl::common::RetCode EstimateOpCost(const ir::Graph* graph, const ir::Node* node,
+                                                const std::vector<const ir::Shape*>& input_shapes,
+                                                double* cost) const {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
     /**
        @brief optimize the compute graph `graph` and fill `info`
        @param graph graph to be optimized and can be modified
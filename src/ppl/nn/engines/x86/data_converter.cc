@@ -56,6 +56,12 @@ RetCode X86DataConverter::Convert(BufferDesc* dst_buf, const TensorShape& dst_de
                     return ppl::kernel::x86::reorder_n16cx_ndarray_fp32(&src_desc, (const float*)(src_buf.addr),
                                                                         (float*)(dst_buf->addr));
                 }
+            } else if (dst_data_format == DATAFORMAT_NHWC && src_data_format == DATAFORMAT_NDARRAY) {
+                return ppl::kernel::x86::reorder_ndarray_nhwc_fp32(&src_desc, (const float*)(src_buf.addr),
+                                                                   (float*)(dst_buf->addr));
+            } else if (dst_data_format == DATAFORMAT_NDARRAY && src_data_format == DATAFORMAT_NHWC) {
+                return ppl::kernel::x86::reorder_nhwc_ndarray_fp32(&src_desc, (const float*)(src_buf.addr),
+                                                                   (float*)(dst_buf->addr));
             }
         } else if (GetSizeOfDataType(dst_data_type) == 8) {
             if (dst_data_format == DATAFORMAT_N16CX && src_data_format == DATAFORMAT_NDARRAY) {
@@ -24,6 +24,7 @@
 #include "ppl/nn/common/logger.h"
 #include "ppl/nn/utils/utils.h"
 #include "ppl/kernel/x86/common/simd_tools.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
 
 using namespace std;
 using namespace ppl::common;
@@ -35,7 +36,7 @@ X86Engine::X86Engine() : EngineImpl("x86"), device_(X86_DEFAULT_ALIGNMENT, ppl::
 }
 
 EngineContext* X86Engine::CreateEngineContext(const string&, const EngineContextOptions& options) {
-    return new X86EngineContext(GetName(), device_.GetISA(), options);
+    return new X86EngineContext(GetName(), device_, options);
 }
 
 bool X86Engine::CanRunOp(const ir::Node* node) const {
@@ -43,6 +44,13 @@ bool X86Engine::CanRunOp(const ir::Node* node) const {
     return (OptKernelCreatorManager::Instance()->Find(type.domain, type.name) != nullptr);
 }
 
+RetCode X86Engine::EstimateOpCost(const ir::Graph* graph, const ir::Node* node,
+                                  const vector<const ir::Shape*>& input_shapes, double* cost) const {
+    const uint32_t num_threads = device_.GetThreadNum();
+    return cost_model_.Estimate(graph, node, input_shapes, device_.GetISA(),
+                                num_threads > 0 ? num_threads : ppl::kernel::x86::get_omp_max_threads(), cost);
+}
+
 RetCode X86Engine::DoOptimize(ir::Graph* graph, utils::SharedResource* resource, RuntimePartitionInfo* info) {
     OptGraph opt_graph;
     auto status = opt_graph.Init(graph, resource, info);
@@ -85,8 +93,68 @@ RetCode X86Engine::DisableAVX512(X86Engine* engine, va_list) {
     return RC_SUCCESS;
 }
 
+RetCode X86Engine::SetOpCostCalibration(X86Engine* engine, va_list args) {
+    auto stat = va_arg(args, const ProfilingStatistics*);
+    if (!stat) {
+        LOG(ERROR) << "profiling statistics is nullptr.";
+        return RC_INVALID_VALUE;
+    }
+    engine->cost_model_.SetCalibration(*stat);
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetMemoryPolicy(X86Engine* engine, va_list args) {
+    auto policy = va_arg(args, uint32_t);
+    const uint32_t all_policies = X86_MEM_HUGE_PAGE | X86_MEM_NUMA_LOCAL | X86_MEM_NUMA_INTERLEAVE;
+    if (policy & ~all_policies) {
+        LOG(ERROR) << "invalid memory policy[" << policy << "]";
+        return RC_INVALID_VALUE;
+    }
+    engine->device_.SetMemoryPolicy(policy);
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetThreadNum(X86Engine* engine, va_list args) {
+    auto num_threads = va_arg(args, uint32_t);
+    engine->device_.SetThreadNum(num_threads);
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetCpuSet(X86Engine* engine, va_list args) {
+    auto cpus = va_arg(args, const int32_t*);
+    auto num_cpus = va_arg(args, uint32_t);
+    if (num_cpus > 0 && !cpus) {
+        LOG(ERROR) << "cpu list is nullptr.";
+        return RC_INVALID_VALUE;
+    }
+    engine->device_.SetCpuSet(vector<int32_t>(cpus, cpus + num_cpus));
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetParallelBackend(X86Engine* engine, va_list args) {
+    auto backend = va_arg(args, uint32_t);
+    if (backend != X86_PARALLEL_OPENMP && backend != X86_PARALLEL_THREAD_POOL) {
+        LOG(ERROR) << "invalid parallel backend[" << backend << "]";
+        return RC_INVALID_VALUE;
+    }
+    engine->device_.SetParallelBackend(backend);
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetThreadPoolSpinCount(X86Engine* engine, va_list args) {
+    auto spin_count = va_arg(args, uint64_t);
+    engine->device_.SetSpinCount(spin_count);
+    return RC_SUCCESS;
+}
+
 X86Engine::ConfHandlerFunc X86Engine::conf_handlers_[] = {
     X86Engine::DisableAVX512,
+    X86Engine::SetOpCostCalibration,
+    X86Engine::SetMemoryPolicy,
+    X86Engine::SetThreadNum,
+    X86Engine::SetCpuSet,
+    X86Engine::SetParallelBackend,
+    X86Engine::SetThreadPoolSpinCount,
 };
 
 RetCode X86Engine::Configure(uint32_t option, ...) {
@@ -21,6 +21,7 @@
 #include "ppl/nn/engines/engine_impl.h"
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/nn/engines/x86/op_cost_model.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -30,6 +31,8 @@ public:
     ppl::common::RetCode Configure(uint32_t, ...) override;
     EngineContext* CreateEngineContext(const std::string& graph_name, const EngineContextOptions&) override;
     bool CanRunOp(const ir::Node*) const override;
+    ppl::common::RetCode EstimateOpCost(const ir::Graph*, const ir::Node*, const std::vector<const ir::Shape*>&,
+                                        double* cost) const override;
     ppl::common::RetCode ProcessGraph(utils::SharedResource*, ir::Graph*, RuntimePartitionInfo*) override;
 
 private:
@@ -41,12 +44,19 @@ private:
      * defined as member functions can avoid exporting unnecessary APIs
      */
     static ppl::common::RetCode DisableAVX512(X86Engine*, va_list);
+    static ppl::common::RetCode SetOpCostCalibration(X86Engine*, va_list);
+    static ppl::common::RetCode SetMemoryPolicy(X86Engine*, va_list);
+    static ppl::common::RetCode SetThreadNum(X86Engine*, va_list);
+    static ppl::common::RetCode SetCpuSet(X86Engine*, va_list);
+    static ppl::common::RetCode SetParallelBackend(X86Engine*, va_list);
+    static ppl::common::RetCode SetThreadPoolSpinCount(X86Engine*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(X86Engine*, va_list);
     static ConfHandlerFunc conf_handlers_[X86_CONF_MAX];
 
 private:
     X86Device device_;
+    OpCostModel cost_model_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -30,15 +30,30 @@ namespace ppl { namespace nn { namespace x86 {
 
 class X86EngineContext final : public EngineContext {
 public:
-    X86EngineContext(const std::string& name, ppl::common::isa_t isa, const EngineContextOptions& options)
-        : name_(name), device_(X86_DEFAULT_ALIGNMENT, isa, options.mm_policy) {}
+    /** @param engine_device device of the engine whose isa, memory and threading options are inherited */
+    X86EngineContext(const std::string& name, const X86Device& engine_device, const EngineContextOptions& options)
+        : name_(name)
+        , device_(X86_DEFAULT_ALIGNMENT, engine_device.GetISA(), options.mm_policy, engine_device.GetMemoryPolicy()) {
+        device_.SetThreadNum(engine_device.GetThreadNum());
+        device_.SetCpuSet(engine_device.GetCpuSet());
+        device_.SetParallelBackend(engine_device.GetParallelBackend());
+        device_.SetSpinCount(engine_device.GetSpinCount());
+    }
     Device* GetDevice() override {
         return &device_;
     }
 
+    void BeforeRun() override {
+        run_scope_.reset(new X86Device::RunScope(&device_));
+    }
+    void AfterRun() override {
+        run_scope_.reset();
+    }
+
 private:
     const std::string name_;
     RuntimeX86Device device_;
+    std::unique_ptr<X86Device::RunScope> run_scope_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -27,11 +27,35 @@ typedef uint64_t conv_fuse_flag_t;
 class conv_fuse_flag {
 public:
     enum {
-        none  = 0,
-        relu  = 1 << 0,
-        relu6 = 1 << 1,
-        sum   = 1 << 16,
+        none       = 0,
+        relu       = 1 << 0,
+        relu6      = 1 << 1,
+        sigmoid    = 1 << 2,
+        swish      = 1 << 3,
+        hswish     = 1 << 4,
+        leaky_relu = 1 << 5,
+        clip       = 1 << 6,
+        sum        = 1 << 16,
+        post_sum   = 1 << 17,
     };
+
+    // activations applied in microkernel registers
+    static const conv_fuse_flag_t kernel_activation = relu | relu6;
+    // activations applied by the post-op epilogue on the fresh output tile
+    static const conv_fuse_flag_t post_activation = sigmoid | swish | hswish | leaky_relu | clip;
+    static const conv_fuse_flag_t activation = kernel_activation | post_activation;
+
+    // Fuse order: bias -> sum -> activation -> post_sum
+    static bool has_post_op(const conv_fuse_flag_t flag)
+    {
+        return (flag & (post_activation | post_sum)) != 0;
+    }
+};
+
+struct conv_fuse_param {
+    float leaky_relu_alpha;
+    float clip_min;
+    float clip_max;
 };
 
 }}}; // namespace ppl::kernel::x86
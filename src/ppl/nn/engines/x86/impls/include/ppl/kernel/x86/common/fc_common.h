@@ -24,11 +24,14 @@ namespace ppl { namespace kernel { namespace x86 {
 
 typedef uint64_t fc_fuse_flag_t;
 
+// Fuse order: bias -> relu/sigmoid -> sum
 class fc_fuse_flag {
 public:
     enum {
-        none  = 0,
-        relu  = 1 << 0,
+        none    = 0,
+        relu    = 1 << 0,
+        sigmoid = 1 << 1,
+        sum     = 1 << 16,
     };
 };
 
@@ -23,14 +23,21 @@
 
 namespace ppl { namespace kernel { namespace x86 {
 
+typedef uint32_t gemm_v2_fuse_flag_t;
+
+// Fuse order: alpha * A * B + beta * C -> relu/sigmoid -> sum
 class gemm_v2_fuse_flag {
 public:
     enum {
-        none = 0,
-        relu = 1 << 0,
+        none    = 0,
+        relu    = 1 << 0,
+        sigmoid = 1 << 1,
+        sum     = 1 << 16,
     };
+
+    // ops applied by the post-op epilogue on the fresh output tile
+    static const gemm_v2_fuse_flag_t post_op = sigmoid | sum;
 };
-typedef uint32_t gemm_v2_fuse_flag_t;
 
 class gemm_v2_C_type {
 public:
@@ -45,21 +52,23 @@ public:
 typedef uint32_t gemm_v2_C_type_t;
 
 struct gemm_v2_param_fp32 {
-    const float* src_A = nullptr;
-    const float* src_B = nullptr;
-    const float* src_C = nullptr;
-    float* dst_Y       = nullptr;
-    int32_t trans_A    = 0;
-    int32_t trans_B    = 0;
-    int32_t M          = 0;
-    int32_t N          = 0;
-    int32_t K          = 0;
-    int32_t lda        = 0;
-    int32_t ldb        = 0;
-    int32_t ldc        = 0;
-    int32_t ldy        = 0;
-    float alpha        = 1.0f;
-    float beta         = 0.0f;
+    const float* src_A   = nullptr;
+    const float* src_B   = nullptr;
+    const float* src_C   = nullptr;
+    const float* src_sum = nullptr; // same shape as Y, used by gemm_v2_fuse_flag::sum
+    float* dst_Y         = nullptr;
+    int32_t trans_A      = 0;
+    int32_t trans_B      = 0;
+    int32_t M            = 0;
+    int32_t N            = 0;
+    int32_t K            = 0;
+    int32_t lda          = 0;
+    int32_t ldb          = 0;
+    int32_t ldc          = 0;
+    int32_t ldy          = 0;
+    int32_t ldsum        = 0;
+    float alpha          = 1.0f;
+    float beta           = 0.0f;
 
     ppl::common::isa_t isa_flag   = ppl::common::ISA_undef;
     gemm_v2_fuse_flag_t fuse_flag = gemm_v2_fuse_flag::none;
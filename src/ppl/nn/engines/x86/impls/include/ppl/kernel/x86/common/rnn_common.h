@@ -0,0 +1,74 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_COMMON_RNN_COMMON_H_
+#define __ST_PPL_KERNEL_X86_COMMON_RNN_COMMON_H_
+
+#include <stdint.h>
+
+namespace ppl { namespace kernel { namespace x86 {
+
+class rnn_cell_type {
+public:
+    enum {
+        lstm = 0,
+        gru  = 1,
+        rnn  = 2,
+    };
+};
+typedef uint32_t rnn_cell_type_t;
+
+class rnn_direction {
+public:
+    enum {
+        forward       = 0,
+        reverse       = 1,
+        bidirectional = 2,
+    };
+};
+typedef uint32_t rnn_direction_t;
+
+class rnn_activation {
+public:
+    enum {
+        sigmoid = 0,
+        tanh    = 1,
+        relu    = 2,
+    };
+};
+typedef uint32_t rnn_activation_t;
+
+inline int64_t rnn_num_direction(const rnn_direction_t direction)
+{
+    return direction == rnn_direction::bidirectional ? 2 : 1;
+}
+
+// gates stacked in W/R/B, in onnx order: lstm iofc, gru zrh, rnn i
+inline int64_t rnn_num_gate(const rnn_cell_type_t cell)
+{
+    return cell == rnn_cell_type::lstm ? 4 : (cell == rnn_cell_type::gru ? 3 : 1);
+}
+
+// activations used by a cell per direction: lstm f/g/h, gru f/g, rnn f
+inline int64_t rnn_num_activation(const rnn_cell_type_t cell)
+{
+    return cell == rnn_cell_type::lstm ? 3 : (cell == rnn_cell_type::gru ? 2 : 1);
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
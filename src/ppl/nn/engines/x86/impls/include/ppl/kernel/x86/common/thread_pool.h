@@ -0,0 +1,107 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_COMMON_THREAD_POOL_H_
+#define __ST_PPL_KERNEL_X86_COMMON_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+/*
+    A fork/join pool whose workers spin for a while after each job before
+    sleeping, so that back-to-back parallel regions of small kernels do not
+    pay for a wake-up. The calling thread of run() is thread 0 of every job.
+    A pool is used by one calling thread at a time, which is bound to the
+    first core during run() if cores are given.
+*/
+class thread_pool {
+public:
+    typedef void (*job_func_t)(void *ctx, const int32_t tid, const int32_t num_threads);
+
+    static const int64_t default_spin_count = 1 << 16;
+
+    /*
+        num_threads: number of threads of a job, including the calling thread
+        cores:       nullptr, or num_threads cores to bind thread i to cores[i]
+        spin_count:  number of polls before an idle worker sleeps, 0 to sleep at once.
+                     it is 0 if there are more threads than cores.
+    */
+    thread_pool(const int32_t num_threads, const int32_t *cores = nullptr, const int64_t spin_count = default_spin_count);
+    ~thread_pool();
+
+    int32_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    void set_spin_count(const int64_t spin_count)
+    {
+        spin_count_.store(spin_count, std::memory_order_relaxed);
+    }
+    int64_t spin_count() const
+    {
+        return spin_count_.load(std::memory_order_relaxed);
+    }
+
+    // calls func(ctx, tid, num_threads()) on every thread and returns after all of them finish
+    void run(job_func_t func, void *ctx);
+
+    // makes idle workers sleep at once instead of spinning until the next run(),
+    // e.g. before parallel regions of OpenMP that share their cores.
+    void park()
+    {
+        parked_.store(true, std::memory_order_relaxed);
+    }
+
+private:
+    thread_pool(const thread_pool &);
+    thread_pool &operator=(const thread_pool &);
+
+    void worker_loop(const int32_t tid);
+
+    const int32_t num_threads_;
+    std::vector<int32_t> cores_;
+    std::vector<std::thread> workers_;
+    std::atomic<int64_t> spin_count_;
+    std::atomic<bool> parked_;
+
+    job_func_t job_func_;
+    void *job_ctx_;
+    bool stop_;
+    std::atomic<uint64_t> generation_;
+    std::atomic<int32_t> num_pending_;
+    std::atomic<int32_t> num_sleeping_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+// parallel regions of converted kernels started by the calling thread run on `pool`, or on OpenMP if it is nullptr.
+// returns the previous one.
+thread_pool *set_thread_pool(thread_pool *pool);
+
+thread_pool *get_thread_pool();
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
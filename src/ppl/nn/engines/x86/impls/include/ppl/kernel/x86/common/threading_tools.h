@@ -34,6 +34,21 @@ void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const i
 
 int32_t get_omp_max_threads();
 
+// sets the number of threads of parallel regions started by the calling thread from now on, returns the previous one
+int32_t set_omp_num_threads(const int32_t num_threads);
+
+// cpu affinity of the threads of parallel regions started by a calling thread, which is the 0th of them
+struct omp_core_binding_t {
+    int32_t num_threads = 0;
+    std::vector<uint8_t> masks; // a platform-specific mask per thread, all zeros if it is not saved
+};
+
+// binds the i-th thread of parallel regions started by the calling thread to cores[i], i < num_threads, and saves the
+// previous affinity of these threads into `prev` for restore_omp_core_binding()
+void swap_omp_core_binding(const int32_t *cores, const int32_t num_threads, omp_core_binding_t *prev);
+
+void restore_omp_core_binding(const omp_core_binding_t &prev);
+
 struct single_parallel_loop_config_t {
     int64_t depth_of_loop;
     int64_t num_threads;
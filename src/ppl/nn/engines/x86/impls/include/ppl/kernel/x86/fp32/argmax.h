@@ -28,6 +28,13 @@ ppl::common::RetCode argmax_ndarray_fp32(
     const int64_t axis,
     int64_t *dst);
 
+// argmax over channels, only axis == 1 is supported. dst is a ndarray
+ppl::common::RetCode argmax_n16cx_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const int64_t axis,
+    int64_t *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
@@ -82,6 +82,22 @@ ppl::common::RetCode averagepool2d_nchw_normal_fp32(
     const int32_t ceil_mode,
     float *dst);
 
+// averagepool2d nhwc normal
+
+ppl::common::RetCode averagepool2d_nhwc_normal_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t pooling_mode,
+    const int32_t ceil_mode,
+    float *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_AVERAGEPOOL_H_
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef __ST_PPL_KERNEL_X86_FP32_AVERAGEPOOL3D_H_
+#define __ST_PPL_KERNEL_X86_FP32_AVERAGEPOOL3D_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// averagepool3d n16cdhw blk
+
+ppl::common::RetCode averagepool3d_n16cdhw_blk1x16_fp32_avx512(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int32_t kernel_d,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_d,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_d,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t pooling_mode,
+    const int32_t ceil_mode,
+    float *dst);
+
+ppl::common::RetCode averagepool3d_n16cdhw_blk1x8_fp32_avx(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int32_t kernel_d,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_d,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_d,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t pooling_mode,
+    const int32_t ceil_mode,
+    float *dst);
+
+// averagepool3d ncdhw normal
+
+ppl::common::RetCode averagepool3d_ncdhw_normal_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int32_t kernel_d,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_d,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_d,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t pooling_mode,
+    const int32_t ceil_mode,
+    float *dst);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif //! __ST_PPL_KERNEL_X86_FP32_AVERAGEPOOL3D_H_
@@ -40,6 +40,7 @@ struct conv2d_fp32_param {
     int64_t num_output;
     int64_t group;
     conv_fuse_flag_t fuse_flag;
+    conv_fuse_param fuse_param;
 
     float sparse_level() const
     {
@@ -93,6 +94,7 @@ public:
     static const conv2d_fp32_algo_t direct          = 5;
     static const conv2d_fp32_algo_t winograd_b2f3   = 32;
     static const conv2d_fp32_algo_t winograd_b4f3   = 33;
+    static const conv2d_fp32_algo_t winograd_b6f3   = 34;
     static const conv2d_fp32_algo_t gemm_direct_v2  = 61;
     static const conv2d_fp32_algo_t direct_v2       = 62;
 };
@@ -338,6 +340,12 @@ public:
         }
     }
 
+    // algorithms with a post-op epilogue should override this
+    virtual bool is_fuse_supported(const conv_fuse_flag_t fuse_flag) const
+    {
+        return (fuse_flag & ~(conv_fuse_flag_t(conv_fuse_flag::kernel_activation) | conv_fuse_flag::sum)) == 0;
+    }
+
     virtual bool is_supported()                                                          = 0;
     virtual ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) = 0;
     virtual conv2d_fp32_executor *gen_executor()                                         = 0;
@@ -348,6 +356,8 @@ public:
 class conv2d_algo_selector {
 public:
     static conv2d_fp32_algo_info select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
+    // same as above, but also picks the winograd tile size by src_shape when its dims are known
+    static conv2d_fp32_algo_info select_algo(const ppl::nn::TensorShape &src_shape, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
     static conv2d_fp32_manager *gen_algo(const conv2d_fp32_param &param, const conv2d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator);
 };
 
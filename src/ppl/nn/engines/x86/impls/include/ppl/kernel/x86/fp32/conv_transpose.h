@@ -19,6 +19,7 @@
 #define __ST_PPL_KERNEL_X86_FP32_CONV_TRANSPOSE_H_
 
 #include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/conv_common.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -127,6 +128,67 @@ ppl::common::RetCode conv_transpose_ndarray_fp32_sse(
     float *tmp_buffer,
     float *output);
 
+// N16CX path: filter is packed once into [ocb][kh][kw][ic_per_group][16o] blocks,
+// an output channel block must not cross groups
+bool conv_transpose_n16cx_is_supported_fp32(
+    const int64_t channels,
+    const int64_t num_output,
+    const int64_t group);
+
+uint64_t conv_transpose_n16cx_cal_packed_filter_size_fp32(
+    const int64_t channels,
+    const int64_t num_output,
+    const int64_t group,
+    const int64_t kernel_h,
+    const int64_t kernel_w);
+
+ppl::common::RetCode conv_transpose_n16cx_pack_filter_fp32(
+    const float *filter,
+    const int64_t channels,
+    const int64_t num_output,
+    const int64_t group,
+    const int64_t kernel_h,
+    const int64_t kernel_w,
+    float *packed_filter);
+
+ppl::common::RetCode conv_transpose_n16cx_direct_fp32_avx512(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const float *sum_src,
+    const float *packed_filter,
+    const float *bias,
+    const int32_t group,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t hole_h,
+    const int32_t hole_w,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst);
+
+ppl::common::RetCode conv_transpose_n16cx_direct_fp32_fma(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const float *sum_src,
+    const float *packed_filter,
+    const float *bias,
+    const int32_t group,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t hole_h,
+    const int32_t hole_w,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
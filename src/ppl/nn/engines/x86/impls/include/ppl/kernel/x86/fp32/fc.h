@@ -57,6 +57,8 @@ protected:
     float *dst_;
     const ppl::nn::TensorShape *dst_shape_;
 
+    const float *sum_src_;
+
     void *temp_buffer_;
 
 public:
@@ -68,6 +70,7 @@ public:
         , src_shape_(nullptr)
         , dst_(nullptr)
         , dst_shape_(nullptr)
+        , sum_src_(nullptr)
         , temp_buffer_(nullptr) {}
 
     fc_fp32_executor(const fc_fp32_param *fc_param, const float *cvt_filter, const float *cvt_bias)
@@ -78,6 +81,7 @@ public:
         , src_shape_(nullptr)
         , dst_(nullptr)
         , dst_shape_(nullptr)
+        , sum_src_(nullptr)
         , temp_buffer_(nullptr) {}
 
     virtual uint64_t cal_temp_buffer_size() = 0;
@@ -158,6 +162,15 @@ public:
         return dst_shape_;
     }
 
+    void set_sum_src(const float *sum_src)
+    {
+        sum_src_ = sum_src;
+    }
+    const float *sum_src() const
+    {
+        return sum_src_;
+    }
+
     void set_temp_buffer(void *temp_buffer)
     {
         temp_buffer_ = temp_buffer;
@@ -255,6 +268,18 @@ public:
         }
     }
 
+    // adds another bias of num_output elements, e.g. from a following Add, to the converted bias
+    ppl::common::RetCode fuse_bias(const float *bias)
+    {
+        if (!cvt_bias_ || cvt_bias_size_ < (uint64_t)param_.num_output) {
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        for (int64_t i = 0; i < param_.num_output; ++i) {
+            cvt_bias_[i] += bias[i];
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
     virtual ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) = 0;
     virtual fc_fp32_executor *gen_executor() = 0;
 
@@ -19,6 +19,7 @@
 #define __ST_PPL_KERNEL_X86_FP32_MATMUL_H_
 
 #include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -37,6 +38,21 @@ common::RetCode matmul_ndarray_fp32(
     void *temp_buffer,
     float *dst);
 
+// bias has dst's last dim elements and sum_src has the same shape as dst, both are optional.
+// computes act(src0 * src1 + bias) + sum_src, act is selected by fuse_flag.
+common::RetCode matmul_ndarray_fused_fp32(
+    const ppl::nn::TensorShape *src0_shape,
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src0,
+    const float *src1,
+    const float *bias,
+    const float *sum_src,
+    const gemm_v2_fuse_flag_t fuse_flag,
+    const ppl::common::isa_t isa_flag,
+    void *temp_buffer,
+    float *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_MATMUL_H_
@@ -89,6 +89,20 @@ ppl::common::RetCode maxpool2d_nchw_with_indices_fp32(
     float *dst,
     int64_t *indices);
 
+// maxpool2d nhwc normal
+
+ppl::common::RetCode maxpool2d_nhwc_normal_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    float *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_MAXPOOL_H_
@@ -0,0 +1,178 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_PD_CONV2D_H_
+#define __ST_PPL_KERNEL_X86_FP32_PD_CONV2D_H_
+
+#include "ppl/kernel/x86/fp32/conv2d.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// pd_conv2d: a pointwise conv and a depthwise conv fused in either order.
+// Both convs run on the same spatial tile so the intermediate tensor never leaves cache.
+
+typedef uint32_t pd_conv2d_fp32_algo_t;
+
+class pd_conv2d_fp32_algo {
+public:
+    static const pd_conv2d_fp32_algo_t unknown             = 0;
+    static const pd_conv2d_fp32_algo_t pointwise_depthwise = 1;
+    static const pd_conv2d_fp32_algo_t depthwise_pointwise = 2;
+};
+
+struct pd_conv2d_fp32_algo_info {
+    pd_conv2d_fp32_algo_t algo_type;
+    ppl::common::isa_t isa;
+    ppl::common::dataformat_t input_format;
+    ppl::common::dataformat_t output_format;
+};
+
+class pd_conv2d_fp32_executor {
+protected:
+    conv2d_fp32_executor *conv2d_executor_;
+    conv2d_fp32_executor *post_conv2d_executor_;
+
+    const float *src_;
+    const ppl::nn::TensorShape *src_shape_;
+    float *dst_;
+    const ppl::nn::TensorShape *dst_shape_;
+
+    void *temp_buffer_;
+
+public:
+    pd_conv2d_fp32_executor()
+        : conv2d_executor_(nullptr)
+        , post_conv2d_executor_(nullptr)
+        , src_(nullptr)
+        , src_shape_(nullptr)
+        , dst_(nullptr)
+        , dst_shape_(nullptr)
+        , temp_buffer_(nullptr) {}
+
+    // takes the ownership of the executors
+    pd_conv2d_fp32_executor(conv2d_fp32_executor *conv2d_executor, conv2d_fp32_executor *post_conv2d_executor)
+        : conv2d_executor_(conv2d_executor)
+        , post_conv2d_executor_(post_conv2d_executor)
+        , src_(nullptr)
+        , src_shape_(nullptr)
+        , dst_(nullptr)
+        , dst_shape_(nullptr)
+        , temp_buffer_(nullptr) {}
+
+    virtual uint64_t cal_temp_buffer_size() = 0;
+    virtual ppl::common::RetCode prepare()  = 0;
+    virtual ppl::common::RetCode execute()  = 0;
+    virtual ~pd_conv2d_fp32_executor()
+    {
+        if (conv2d_executor_) delete conv2d_executor_;
+        if (post_conv2d_executor_) delete post_conv2d_executor_;
+    }
+
+    conv2d_fp32_executor *conv2d_executor() const
+    {
+        return conv2d_executor_;
+    }
+    conv2d_fp32_executor *post_conv2d_executor() const
+    {
+        return post_conv2d_executor_;
+    }
+
+    void set_src(const float *src)
+    {
+        src_ = src;
+    }
+    const float *src() const
+    {
+        return src_;
+    }
+
+    void set_src_shape(const ppl::nn::TensorShape *src_shape)
+    {
+        src_shape_ = src_shape;
+    }
+    const ppl::nn::TensorShape *src_shape() const
+    {
+        return src_shape_;
+    }
+
+    void set_dst(float *dst)
+    {
+        dst_ = dst;
+    }
+    float *dst() const
+    {
+        return dst_;
+    }
+
+    void set_dst_shape(const ppl::nn::TensorShape *dst_shape)
+    {
+        dst_shape_ = dst_shape;
+    }
+    const ppl::nn::TensorShape *dst_shape() const
+    {
+        return dst_shape_;
+    }
+
+    void set_temp_buffer(void *temp_buffer)
+    {
+        temp_buffer_ = temp_buffer;
+    }
+    void *temp_buffer() const
+    {
+        return temp_buffer_;
+    }
+};
+
+class pd_conv2d_fp32_manager {
+protected:
+    conv2d_fp32_manager *conv2d_manager_;
+    conv2d_fp32_manager *post_conv2d_manager_;
+
+public:
+    pd_conv2d_fp32_manager()
+        : conv2d_manager_(nullptr)
+        , post_conv2d_manager_(nullptr) {}
+
+    // does not take the ownership of the managers, weights must be generated before gen_executor
+    pd_conv2d_fp32_manager(conv2d_fp32_manager *conv2d_manager, conv2d_fp32_manager *post_conv2d_manager)
+        : conv2d_manager_(conv2d_manager)
+        , post_conv2d_manager_(post_conv2d_manager) {}
+
+    conv2d_fp32_manager *conv2d_manager() const
+    {
+        return conv2d_manager_;
+    }
+    conv2d_fp32_manager *post_conv2d_manager() const
+    {
+        return post_conv2d_manager_;
+    }
+
+    virtual bool is_supported()                     = 0;
+    virtual pd_conv2d_fp32_executor *gen_executor() = 0;
+
+    virtual ~pd_conv2d_fp32_manager() {}
+};
+
+class pd_conv2d_algo_selector {
+public:
+    static pd_conv2d_fp32_algo_info select_algo(const conv2d_fp32_algo_info &algo_info, const conv2d_fp32_algo_info &post_algo_info);
+    static pd_conv2d_fp32_manager *gen_algo(const pd_conv2d_fp32_algo_info &algo_info, conv2d_fp32_manager *conv2d_manager, conv2d_fp32_manager *post_conv2d_manager);
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
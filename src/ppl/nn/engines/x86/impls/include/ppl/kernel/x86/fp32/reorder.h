@@ -52,6 +52,38 @@ ppl::common::RetCode reorder_n16cx_nxc_fp32(
     const float *src,
     float *dst);
 
+// nhwc here is DATAFORMAT_NHWC, whose channels are padded to 8
+ppl::common::RetCode reorder_ndarray_nhwc_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst);
+
+ppl::common::RetCode reorder_nhwc_ndarray_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst);
+
+ppl::common::RetCode reorder_n16cx_nhwc_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst);
+
+ppl::common::RetCode reorder_nhwc_n16cx_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst);
+
+// nxc is a dense channels-last ndarray, e.g. what transpose 0,2,3,1 of nchw gives
+ppl::common::RetCode reorder_nxc_nhwc_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst);
+
+ppl::common::RetCode reorder_nhwc_nxc_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst);
+
 uint64_t reorder_goidhw_gIOdhwB16i16o_fp32_get_dst_size(
     const int32_t group,
     const int32_t num_output,
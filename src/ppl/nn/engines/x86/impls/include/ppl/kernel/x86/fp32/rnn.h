@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_RNN_H_
+#define __ST_PPL_KERNEL_X86_FP32_RNN_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/rnn_common.h"
+#include "ppl/common/sys.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct rnn_fp32_param {
+    rnn_cell_type_t cell;
+    rnn_direction_t direction;
+    int64_t hidden_size;
+    float clip; // no clipping when <= 0
+    int32_t input_forget; // lstm only
+    int32_t linear_before_reset; // gru only
+    rnn_activation_t activations[6]; // rnn_num_activation() per direction, forward first
+};
+
+// recurrence weight R repacked per direction into blocks of 8 hidden units,
+// each block laid out as [hidden_size][num_gate][8] so one step streams it once
+uint64_t rnn_fp32_get_packed_weight_bytes(
+    const rnn_fp32_param &param);
+
+void rnn_fp32_pack_weight(
+    const rnn_fp32_param &param,
+    const float *R,
+    float *packed_R);
+
+uint64_t rnn_fp32_get_buffer_bytes(
+    const ppl::common::isa_t isa,
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_fp32_param &param,
+    const bool has_packed_weight);
+
+// X: [seq_len, batch, input_size], Y: [seq_len, num_direction, batch, hidden_size],
+// Y_h/Y_c: [num_direction, batch, hidden_size]. optional inputs and outputs may be nullptr,
+// packed_R may be nullptr then R is packed into temp_buffer on the fly.
+ppl::common::RetCode rnn_fp32(
+    const ppl::common::isa_t isa,
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *W,
+    const float *R,
+    const float *packed_R,
+    const float *B,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const float *initial_c,
+    const float *P,
+    const rnn_fp32_param &param,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h,
+    float *Y_c);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif //! __ST_PPL_KERNEL_X86_FP32_RNN_H_
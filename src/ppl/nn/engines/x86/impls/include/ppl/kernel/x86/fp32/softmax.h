@@ -40,6 +40,19 @@ ppl::common::RetCode softmax_ndarray_fp32(
     const int64_t axis,
     float *dst);
 
+// softmax over all dims from axis 1, only axis == 1 is supported
+ppl::common::RetCode softmax_n16cx_fp32_fma(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const int64_t axis,
+    float *dst);
+
+ppl::common::RetCode softmax_n16cx_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const int64_t axis,
+    float *dst);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
@@ -19,10 +19,49 @@
 #define __ST_PPL_KERNEL_X86_COMMON_ARGMAX_ARGMAX_COMMON_H_
 
 #include <limits>
+#include <string.h>
+
 #include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
+template <typename eT>
+inline void argmax_ndarray_tasks(
+    const eT *src,
+    const eT numeric_min,
+    const int64_t argmax_dim,
+    const int64_t inner_dim,
+    const int64_t start_task,
+    const int64_t end_task,
+    int64_t *dst)
+{
+    const int64_t j_blk     = 64;
+    const int64_t num_j_blk = div_up(inner_dim, j_blk);
+    eT max_value[j_blk];
+    int64_t max_idx[j_blk];
+    for (int64_t task = start_task; task < end_task; ++task) {
+        const int64_t i     = task / num_j_blk;
+        const int64_t j     = (task % num_j_blk) * j_blk;
+        const int64_t j_eff = min<int64_t>(inner_dim - j, j_blk);
+        for (int64_t jj = 0; jj < j_eff; ++jj) {
+            max_value[jj] = numeric_min;
+            max_idx[jj]   = 0;
+        }
+        const eT *p_src = src + i * argmax_dim * inner_dim + j;
+        for (int64_t k = 0; k < argmax_dim; ++k) {
+            for (int64_t jj = 0; jj < j_eff; ++jj) {
+                if (p_src[jj] > max_value[jj]) {
+                    max_value[jj] = p_src[jj];
+                    max_idx[jj]   = k;
+                }
+            }
+            p_src += inner_dim;
+        }
+        memcpy(dst + i * inner_dim + j, max_idx, j_eff * sizeof(int64_t));
+    }
+}
+
 template <typename eT>
 ppl::common::RetCode argmax_ndarray(
     const ppl::nn::TensorShape *src_shape,
@@ -46,23 +85,98 @@ ppl::common::RetCode argmax_ndarray(
         inner_dim *= src_shape->GetDim(i);
     }
 
-#ifndef PPL_USE_X86_OMP_COLLAPSE
+    // scan argmax_dim once for a block of inner columns so the compares run on contiguous memory
+    const int64_t j_blk       = 64; // same as argmax_ndarray_tasks
+    const int64_t num_j_blk   = div_up(inner_dim, j_blk);
+    const int64_t total_tasks = outer_dim * num_j_blk;
+    const int64_t task_len    = min<int64_t>(inner_dim, j_blk);
+
+    auto pc = select_single_parallel_loop({total_tasks}, ppl::common::ISA_undef, argmax_dim * task_len * sizeof(eT), task_len * sizeof(int64_t), task_len * sizeof(int64_t), argmax_dim);
+    if (pc.num_threads <= 1) {
+        argmax_ndarray_tasks<eT>(src, numeric_min, argmax_dim, inner_dim, 0, total_tasks, dst);
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t task_per_thread = div_up(total_tasks, pc.num_threads);
     PRAGMA_OMP_PARALLEL_FOR()
-#else
-    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-#endif
-    for (int64_t i = 0; i < outer_dim; ++i) {
-        for (int64_t j = 0; j < inner_dim; ++j) {
-            eT max_value = numeric_min;
-            int64_t idx = 0;
-            for (int64_t k = 0; k < argmax_dim; ++k) {
-                if (src[(i * argmax_dim + k) * inner_dim + j] > max_value) {
-                    max_value = src[(i * argmax_dim + k) * inner_dim + j];
-                    idx       = k;
+    for (int64_t t = 0; t < pc.num_threads; ++t) {
+        const int64_t start_task = t * task_per_thread;
+        const int64_t end_task   = min<int64_t>(start_task + task_per_thread, total_tasks);
+        argmax_ndarray_tasks<eT>(src, numeric_min, argmax_dim, inner_dim, start_task, end_task, dst);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+template <typename eT>
+inline void argmax_n16cx_tasks(
+    const eT *src,
+    const eT numeric_min,
+    const int64_t channels,
+    const int64_t inner_dim,
+    const int64_t start_task,
+    const int64_t end_task,
+    int64_t *dst)
+{
+    const int64_t c_blk    = 16;
+    const int64_t padded_c = round_up(channels, c_blk);
+    for (int64_t task = start_task; task < end_task; ++task) {
+        const int64_t b = task / inner_dim;
+        const int64_t j = task % inner_dim;
+        const eT *p_src = src + b * padded_c * inner_dim + j * c_blk;
+        eT max_value    = numeric_min;
+        int64_t idx     = 0;
+        for (int64_t c = 0; c < channels; c += c_blk) {
+            const int64_t c_eff = min<int64_t>(channels - c, c_blk);
+            for (int64_t k = 0; k < c_eff; ++k) {
+                if (p_src[k] > max_value) {
+                    max_value = p_src[k];
+                    idx       = c + k;
                 }
             }
-            dst[i * inner_dim + j] = idx;
+            p_src += inner_dim * c_blk;
         }
+        dst[task] = idx;
+    }
+}
+
+template <typename eT>
+ppl::common::RetCode argmax_n16cx(
+    const ppl::nn::TensorShape *src_shape,
+    const eT *src,
+    const int64_t axis,
+    int64_t *dst)
+{
+    const int64_t real_axis = axis < 0 ? axis + src_shape->GetDimCount() : axis;
+    if (src_shape->GetDataFormat() != ppl::common::DATAFORMAT_N16CX || real_axis != 1) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    eT numeric_min = std::numeric_limits<eT>().min();
+    if (std::is_same<eT, float>().value || std::is_same<eT, double>().value || std::is_same<eT, long double>().value) {
+        numeric_min = -std::numeric_limits<eT>().max();
+    }
+
+    const int64_t batch    = src_shape->GetDim(0);
+    const int64_t channels = src_shape->GetDim(1);
+    int64_t inner_dim      = 1;
+    for (uint32_t i = 2; i < src_shape->GetDimCount(); i++) {
+        inner_dim *= src_shape->GetDim(i);
+    }
+
+    const int64_t total_tasks = batch * inner_dim;
+    auto pc = select_single_parallel_loop({total_tasks}, ppl::common::ISA_undef, channels * sizeof(eT), sizeof(int64_t), sizeof(int64_t), channels);
+    if (pc.num_threads <= 1) {
+        argmax_n16cx_tasks<eT>(src, numeric_min, channels, inner_dim, 0, total_tasks, dst);
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t task_per_thread = div_up(total_tasks, pc.num_threads);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < pc.num_threads; ++t) {
+        const int64_t start_task = t * task_per_thread;
+        const int64_t end_task   = min<int64_t>(start_task + task_per_thread, total_tasks);
+        argmax_n16cx_tasks<eT>(src, numeric_min, channels, inner_dim, start_task, end_task, dst);
     }
 
     return ppl::common::RC_SUCCESS;
@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -45,9 +46,7 @@ ppl::common::RetCode expand_ndarray_recursive(
                     dst[i] = src[i];
                 }
             } else {
-                for (int64_t i = 0; i < dst_shape->GetDim(dim_idx); i++) {
-                    dst[i] = src[i];
-                }
+                memcpy(dst, src, dst_shape->GetDim(dim_idx) * sizeof(eT));
             }
         } else { // broadcast
             const eT val = src[0];
@@ -141,7 +140,10 @@ ppl::common::RetCode expand_ndarray_common(
         stride_dst[i] = stride_dst[i + 1] * dst_shape->GetDim(i + 1);
     }
 
-    return expand_ndarray_recursive<eT>(&padded_input_shape, dst_shape, src, stride_src, stride_dst, 0, false, dst);
+    // small outputs are expanded by the calling thread only, forking a team costs more than the copy
+    std::vector<int64_t> loops(dst_shape->GetDims(), dst_shape->GetDims() + dim_count);
+    auto pc = select_single_parallel_loop(loops, ppl::common::ISA_undef, sizeof(eT), sizeof(eT), sizeof(eT), 1);
+    return expand_ndarray_recursive<eT>(&padded_input_shape, dst_shape, src, stride_src, stride_dst, 0, pc.num_threads <= 1, dst);
 }
 
 }}}; // namespace ppl::kernel::x86
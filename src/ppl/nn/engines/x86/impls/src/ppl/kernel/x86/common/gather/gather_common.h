@@ -19,10 +19,50 @@
 #define __ST_PPL_KERNEL_X86_COMMON_GATHER_GATHER_COMMON_H_
 
 #include "ppl/kernel/x86/common/internal_include.h"
-#include <string.h> 
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include <string.h>
 
 namespace ppl { namespace kernel { namespace x86 {
 
+template <typename eT>
+inline void gather_ndarray_rows(
+    const eT *src,
+    const int64_t *indices,
+    const int64_t gather_dim,
+    const int64_t inner_dim,
+    const int64_t rows_per_outer,
+    const int64_t start_row,
+    const int64_t end_row,
+    eT *dst)
+{
+    int64_t o = start_row / rows_per_outer;
+    int64_t r = start_row % rows_per_outer;
+
+    const uint64_t row_bytes = inner_dim * sizeof(eT);
+    const eT *l_src          = src + o * gather_dim * inner_dim;
+    eT *l_dst                = dst + start_row * inner_dim;
+    for (int64_t row = start_row; row < end_row; ++row) {
+        const eT *p_src = l_src + indices[r] * inner_dim;
+        if (inner_dim >= 4) {
+            memcpy(l_dst, p_src, row_bytes);
+        } else if (inner_dim == 3) {
+            l_dst[0] = p_src[0];
+            l_dst[1] = p_src[1];
+            l_dst[2] = p_src[2];
+        } else if (inner_dim == 2) {
+            l_dst[0] = p_src[0];
+            l_dst[1] = p_src[1];
+        } else {
+            l_dst[0] = p_src[0];
+        }
+        l_dst += inner_dim;
+        if (++r == rows_per_outer) {
+            r = 0;
+            l_src += gather_dim * inner_dim;
+        }
+    }
+}
+
 template <typename eT>
 ppl::common::RetCode gather_ndarray_common(
     const eT *src,
@@ -34,70 +74,24 @@ ppl::common::RetCode gather_ndarray_common(
     const int64_t indices_dim,
     eT *dst)
 {
-    if (inner_dim >= 4) {
-#ifdef PPL_USE_X86_OMP_COLLAPSE
-        PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-#else
-        PRAGMA_OMP_PARALLEL_FOR()
-#endif
-        for (int64_t o = 0; o < outer_dim; ++o) {
-            for (int64_t k = 0; k < num_indices; ++k) {
-                for (int64_t i = 0; i < indices_dim; ++i) {
-                    eT *l_dst = dst + o * num_indices * indices_dim * inner_dim +
-                               k * indices_dim * inner_dim + i * inner_dim;
-                    int64_t index  = indices[k * indices_dim + i];
-                    const eT *l_src = src + o * gather_dim * inner_dim + index * inner_dim;
-                    memcpy(l_dst, l_src, inner_dim * sizeof(eT));
-                }
-            }
-        }
-    } else if (inner_dim >= 2) {
-#ifdef PPL_USE_X86_OMP_COLLAPSE
-        PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-#else
-        PRAGMA_OMP_PARALLEL_FOR()
-#endif
-        for (int64_t o = 0; o < outer_dim; ++o) {
-            for (int64_t k = 0; k < num_indices; ++k) {
-                eT *l_dst =
-                    dst + o * num_indices * indices_dim * inner_dim + k * indices_dim * inner_dim;
-                const int64_t *l_indices = indices + k * indices_dim;
-                const eT *l_src           = src + o * gather_dim * inner_dim;
-                if (inner_dim == 2) {
-                    for (int64_t i = 0; i < indices_dim; ++i) {
-                        l_dst[0] = l_src[l_indices[0] + 0];
-                        l_dst[1] = l_src[l_indices[0] + 1];
-                        l_dst += inner_dim;
-                        ++l_indices;
-                    }
-                } else {
-                    for (int64_t i = 0; i < indices_dim; ++i) {
-                        l_dst[0] = l_src[l_indices[0] + 0];
-                        l_dst[1] = l_src[l_indices[0] + 1];
-                        l_dst[2] = l_src[l_indices[0] + 2];
-                        l_dst += inner_dim;
-                        ++l_indices;
-                    }
-                }
-            }
-        }
-    } else {
-#ifdef PPL_USE_X86_OMP_COLLAPSE
-        PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-#else
-        PRAGMA_OMP_PARALLEL_FOR()
-#endif
-        for (int64_t o = 0; o < outer_dim; ++o) {
-            for (int64_t k = 0; k < num_indices; ++k) {
-                eT *l_dst                 = dst + o * num_indices * indices_dim + k * indices_dim;
-                const int64_t *l_indices = indices + k * indices_dim;
-                const eT *l_src           = src + o * gather_dim;
-                for (int64_t i = 0; i < indices_dim; ++i) {
-                    l_dst[0] = l_src[l_indices[0]];
-                    ++l_dst;
-                    ++l_indices;
-                }
-            }
+    // every output row of inner_dim elements is one task, threads are chosen by the bytes moved
+    const int64_t rows_per_outer = num_indices * indices_dim;
+    const int64_t total_rows     = outer_dim * rows_per_outer;
+    const uint64_t row_bytes     = inner_dim * sizeof(eT);
+
+    auto pc = select_single_parallel_loop({total_rows}, ppl::common::ISA_undef, row_bytes, row_bytes, row_bytes, 1);
+    if (pc.num_threads <= 1) {
+        gather_ndarray_rows<eT>(src, indices, gather_dim, inner_dim, rows_per_outer, 0, total_rows, dst);
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t rows_per_thread = div_up(total_rows, pc.num_threads);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < pc.num_threads; ++t) {
+        const int64_t start_row = t * rows_per_thread;
+        const int64_t end_row   = min<int64_t>(start_row + rows_per_thread, total_rows);
+        if (start_row < end_row) {
+            gather_ndarray_rows<eT>(src, indices, gather_dim, inner_dim, rows_per_outer, start_row, end_row, dst);
         }
     }
 
@@ -19,7 +19,7 @@
 #define __ST_PPL_KERNEL_X86_COMMON_NON_ZERO_NON_ZERO_COMMON_H_
 
 #include "ppl/kernel/x86/common/internal_include.h"
-#include <string.h>
+#include "ppl/kernel/x86/common/threading_tools.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -36,6 +36,49 @@ inline void calc_idx(
     }
 }
 
+template <typename eT>
+inline int64_t non_zero_count_chunk(
+    const eT *src,
+    const int64_t start_idx,
+    const int64_t end_idx)
+{
+    int64_t count = 0;
+    for (int64_t i = start_idx; i < end_idx; i++) {
+        count += src[i] != 0;
+    }
+    return count;
+}
+
+template <typename eT>
+inline void non_zero_write_chunk(
+    const ppl::nn::TensorShape *src_shape,
+    const uint64_t *strides,
+    const eT *src,
+    const int64_t start_idx,
+    const int64_t end_idx,
+    const int64_t total,
+    int64_t pos,
+    int64_t *dst)
+{
+    const int64_t dim_count = src_shape->GetDimCount();
+    uint64_t idx[PPL_X86_TENSOR_MAX_DIMS()];
+    calc_idx(strides, start_idx, dim_count, idx);
+    for (int64_t i = start_idx; i < end_idx; i++) {
+        if (src[i] != 0) {
+            for (int64_t j = 0; j < dim_count; j++) {
+                dst[j * total + pos] = idx[j];
+            }
+            ++pos;
+        }
+        for (int64_t j = dim_count - 1; j >= 0; j--) {
+            if (++idx[j] < (uint64_t)src_shape->GetDim(j) || j == 0) {
+                break;
+            }
+            idx[j] = 0;
+        }
+    }
+}
+
 template <typename eT>
 ppl::common::RetCode non_zero_ndarray_common(
     const ppl::nn::TensorShape *src_shape,
@@ -44,30 +87,58 @@ ppl::common::RetCode non_zero_ndarray_common(
     int64_t *non_zero_num,
     int64_t *dst)
 {
-    const int64_t dim_count  = src_shape->GetDimCount();
-    const int64_t stride_out = src_shape->GetElementsExcludingPadding();
-    uint64_t idx[dim_count];
-    uint64_t strides[dim_count];
-    int64_t *temp_output = (int64_t*)temp_buffer;
+    const int64_t dim_count = src_shape->GetDimCount();
+    const int64_t length    = src_shape->GetElementsExcludingPadding();
+    if (dim_count > PPL_X86_TENSOR_MAX_DIMS()) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
 
+    *non_zero_num = 0;
+    if (length == 0 || dim_count == 0) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    uint64_t strides[PPL_X86_TENSOR_MAX_DIMS()];
     strides[dim_count - 1] = 1;
     for (int64_t i = dim_count - 2; i >= 0; i--) {
         strides[i] = strides[i + 1] * src_shape->GetDim(i + 1);
     }
 
-    *non_zero_num = 0;
-    for (uint64_t i = 0; i < src_shape->GetElementsExcludingPadding(); i++) {
-        if (src[i] != 0) {
-            calc_idx(strides, i, dim_count, idx);
-            for (int64_t j = 0; j < dim_count; j++) {
-                temp_output[j * stride_out + *non_zero_num] = idx[j];
-            }
-            (*non_zero_num)++;
-        }
+    // two passes over the same chunks: count non-zeros per chunk, then each chunk
+    // writes its coordinates at its prefix offset, so the output order stays row-major.
+    // temp_buffer holds at least length int64 and there are never more chunks than that.
+    auto pc = select_single_parallel_loop({length}, ppl::common::ISA_undef, sizeof(eT), dim_count * sizeof(int64_t), sizeof(int64_t), 1);
+    if (pc.num_threads <= 1) {
+        const int64_t total = non_zero_count_chunk<eT>(src, 0, length);
+        *non_zero_num       = total;
+        non_zero_write_chunk<eT>(src_shape, strides, src, 0, length, total, 0, dst);
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t len_per_chunk = div_up(length, pc.num_threads);
+    const int64_t num_chunks    = div_up(length, len_per_chunk);
+    int64_t *chunk_offset       = (int64_t *)temp_buffer;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t c = 0; c < num_chunks; ++c) {
+        const int64_t start_idx = c * len_per_chunk;
+        const int64_t end_idx   = min<int64_t>(start_idx + len_per_chunk, length);
+        chunk_offset[c]         = non_zero_count_chunk<eT>(src, start_idx, end_idx);
+    }
+
+    int64_t total = 0;
+    for (int64_t c = 0; c < num_chunks; ++c) {
+        const int64_t count = chunk_offset[c];
+        chunk_offset[c]     = total;
+        total += count;
     }
+    *non_zero_num = total;
 
-    for (int64_t i = 0; i < dim_count; i++) {
-        memcpy(dst + i * *non_zero_num, temp_output + i * stride_out, *non_zero_num * sizeof(int64_t));
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t c = 0; c < num_chunks; ++c) {
+        const int64_t start_idx = c * len_per_chunk;
+        const int64_t end_idx   = min<int64_t>(start_idx + len_per_chunk, length);
+        non_zero_write_chunk<eT>(src_shape, strides, src, start_idx, end_idx, total, chunk_offset[c], dst);
     }
 
     return ppl::common::RC_SUCCESS;
@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_COMMON_PARALLEL_FOR_H_
+#define __ST_PPL_KERNEL_X86_COMMON_PARALLEL_FOR_H_
+
+#include "ppl/kernel/x86/common/thread_pool.h"
+#include "ppl/kernel/x86/common/macros.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// whether the calling thread is running a job of a thread_pool
+bool in_thread_pool_job();
+
+template <typename Func>
+struct parallel_for_job {
+    int64_t num_iters;
+    const Func *func;
+
+    static void run(void *ctx, const int32_t tid, const int32_t num_threads)
+    {
+        const parallel_for_job *job = static_cast<const parallel_for_job *>(ctx);
+        // static schedule, same as "omp for" without a schedule clause
+        const int64_t begin = job->num_iters * tid / num_threads;
+        const int64_t end   = job->num_iters * (tid + 1) / num_threads;
+        for (int64_t i = begin; i < end; ++i) {
+            (*job->func)(i);
+        }
+    }
+};
+
+/*
+    Calls func(i) for i in [0, num_iters) in parallel, on the thread pool set
+    by set_thread_pool() if there is one, or on OpenMP. Nested calls inside a
+    thread pool job run sequentially.
+*/
+template <typename Func>
+void parallel_for(const int64_t num_iters, const Func &func)
+{
+    thread_pool *pool = get_thread_pool();
+    if (in_thread_pool_job() || (pool && num_iters <= 1)) {
+        for (int64_t i = 0; i < num_iters; ++i) {
+            func(i);
+        }
+        return;
+    }
+    if (pool) {
+        parallel_for_job<Func> job = {num_iters, &func};
+        pool->run(parallel_for_job<Func>::run, &job);
+        return;
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < num_iters; ++i) {
+        func(i);
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
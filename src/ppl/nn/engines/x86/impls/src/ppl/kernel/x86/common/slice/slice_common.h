@@ -47,11 +47,19 @@ ppl::common::RetCode slice_ndarray_recursive(
             for (int64_t t = 0; t < pc.num_threads; ++t) {
                 const int64_t start_idx = t * len_per_thread;
                 const int64_t end_idx = min<int64_t>(start_idx + len_per_thread, output_length);
-                for (int64_t i = start_idx; i < end_idx; i++) {
-                    const int64_t src_i = starts[dim_idx] + i * steps[dim_idx];
-                    dst[i]              = src[src_i];
+                if (steps[dim_idx] == 1) {
+                    if (end_idx > start_idx) {
+                        memcpy(dst + start_idx, src + starts[dim_idx] + start_idx, (end_idx - start_idx) * sizeof(eT));
+                    }
+                } else {
+                    for (int64_t i = start_idx; i < end_idx; i++) {
+                        const int64_t src_i = starts[dim_idx] + i * steps[dim_idx];
+                        dst[i]              = src[src_i];
+                    }
                 }
             }
+        } else if (steps[dim_idx] == 1) {
+            memcpy(dst, src + starts[dim_idx], output_length * sizeof(eT));
         } else {
             for (int64_t i = 0; i < output_length; i++) {
                 const int64_t src_i = starts[dim_idx] + i * steps[dim_idx];
@@ -123,6 +131,9 @@ ppl::common::RetCode slice_ndarray_common(
         if (real_starts[i] < 0) {
             real_starts[i] += src_shape->GetDim(i);
         }
+        if (real_starts[i] < 0) {
+            real_starts[i] = 0;
+        }
     }
 
     int64_t stride_in[PPL_X86_TENSOR_MAX_DIMS()] = {0};
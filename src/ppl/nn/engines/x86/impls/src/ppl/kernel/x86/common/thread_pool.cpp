@@ -0,0 +1,199 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#if defined(__linux__)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#endif
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/thread_pool.h"
+#include "ppl/kernel/x86/common/parallel_for.h"
+#include "ppl/common/log.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static thread_local thread_pool *g_thread_pool = nullptr;
+static thread_local bool g_in_thread_pool_job  = false;
+
+static void bind_current_thread(const int32_t core)
+{
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+        LOG(ERROR) << "Core binding failed";
+    }
+#endif
+}
+
+// binds the calling thread to a core during its lifetime, and gives the thread its previous affinity back
+class calling_thread_binding {
+public:
+    calling_thread_binding(const int32_t core)
+        : rebound_(false)
+    {
+#if defined(__linux__)
+        if (core < 0 || pthread_getaffinity_np(pthread_self(), sizeof(prev_cpuset_), &prev_cpuset_) != 0) {
+            return;
+        }
+        // e.g. already bound by the device for its OpenMP threads
+        if (CPU_COUNT(&prev_cpuset_) == 1 && CPU_ISSET(core, &prev_cpuset_)) {
+            return;
+        }
+        bind_current_thread(core);
+        rebound_ = true;
+#endif
+    }
+    ~calling_thread_binding()
+    {
+#if defined(__linux__)
+        if (rebound_ && pthread_setaffinity_np(pthread_self(), sizeof(prev_cpuset_), &prev_cpuset_) != 0) {
+            LOG(ERROR) << "Restoring core binding failed";
+        }
+#endif
+    }
+
+private:
+    bool rebound_;
+#if defined(__linux__)
+    cpu_set_t prev_cpuset_;
+#endif
+};
+
+thread_pool::thread_pool(const int32_t num_threads, const int32_t *cores, const int64_t spin_count)
+    : num_threads_(num_threads > 1 ? num_threads : 1)
+    // spinning workers starve the others when there are more threads than cores
+    , spin_count_(num_threads > (int32_t)std::thread::hardware_concurrency() ? 0 : spin_count)
+    , parked_(false)
+    , job_func_(nullptr)
+    , job_ctx_(nullptr)
+    , stop_(false)
+    , generation_(0)
+    , num_pending_(0)
+    , num_sleeping_(0)
+{
+    if (cores) {
+        cores_.assign(cores, cores + num_threads_);
+    }
+    workers_.reserve(num_threads_ - 1);
+    for (int32_t tid = 1; tid < num_threads_; ++tid) {
+        workers_.emplace_back(&thread_pool::worker_loop, this, tid);
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        generation_.fetch_add(1);
+    }
+    cond_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void thread_pool::worker_loop(const int32_t tid)
+{
+    if (!cores_.empty()) {
+        bind_current_thread(cores_[tid]);
+    }
+
+    uint64_t last_generation = 0;
+    while (true) {
+        uint64_t generation = generation_.load(std::memory_order_acquire);
+        for (int64_t spin = spin_count(); generation == last_generation && spin > 0; --spin) {
+            if (parked_.load(std::memory_order_relaxed)) {
+                break;
+            }
+            _mm_pause();
+            generation = generation_.load(std::memory_order_acquire);
+        }
+        if (generation == last_generation) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            num_sleeping_.fetch_add(1);
+            // pairs with run(): either run() sees this sleeper, or this sees the new generation
+            cond_.wait(lock, [&] { return (generation = generation_.load()) != last_generation; });
+            num_sleeping_.fetch_sub(1);
+        }
+        last_generation = generation;
+        if (stop_) {
+            return;
+        }
+
+        g_in_thread_pool_job = true;
+        job_func_(job_ctx_, tid, num_threads_);
+        g_in_thread_pool_job = false;
+        num_pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void thread_pool::run(job_func_t func, void *ctx)
+{
+    calling_thread_binding binding(cores_.empty() ? -1 : cores_[0]);
+    if (num_threads_ == 1) {
+        func(ctx, 0, 1);
+        return;
+    }
+
+    job_func_     = func;
+    job_ctx_      = ctx;
+    parked_.store(false, std::memory_order_relaxed);
+    num_pending_.store(num_threads_ - 1, std::memory_order_relaxed);
+    generation_.fetch_add(1);
+    if (num_sleeping_.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cond_.notify_all();
+    }
+
+    g_in_thread_pool_job = true;
+    func(ctx, 0, num_threads_);
+    g_in_thread_pool_job = false;
+
+    for (int64_t spin = 0; num_pending_.load(std::memory_order_acquire) > 0; ++spin) {
+        if (spin < spin_count()) {
+            _mm_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+thread_pool *set_thread_pool(thread_pool *pool)
+{
+    thread_pool *prev_pool = g_thread_pool;
+    g_thread_pool          = pool;
+    return prev_pool;
+}
+
+thread_pool *get_thread_pool()
+{
+    return g_thread_pool;
+}
+
+bool in_thread_pool_job()
+{
+    return g_in_thread_pool_job;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -56,6 +56,62 @@ int32_t get_omp_max_threads()
 {
     return PPL_OMP_MAX_THREADS();
 }
+
+int32_t set_omp_num_threads(const int32_t num_threads)
+{
+    const int32_t prev_num_threads = PPL_OMP_MAX_THREADS();
+#ifdef PPL_USE_X86_OMP
+    omp_set_num_threads(num_threads);
+#endif
+    return prev_num_threads;
+}
+
+void swap_omp_core_binding(const int32_t *cores, const int32_t num_threads, omp_core_binding_t *prev)
+{
+#if defined(__linux__)
+    prev->num_threads = num_threads;
+    prev->masks.assign(num_threads * sizeof(cpu_set_t), 0);
+    cpu_set_t *prev_masks = (cpu_set_t *)prev->masks.data();
+#ifdef PPL_USE_X86_OMP
+    PPL_X86_PRAGMA(omp parallel num_threads(num_threads))
+#endif
+    {
+        const int32_t omp_tid = PPL_OMP_THREAD_ID();
+        if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &prev_masks[omp_tid]) != 0) {
+            CPU_ZERO(&prev_masks[omp_tid]);
+        }
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cores[omp_tid], &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            LOG(ERROR) << "Core binding failed";
+        }
+    }
+#endif
+}
+
+void restore_omp_core_binding(const omp_core_binding_t &prev)
+{
+#if defined(__linux__)
+    if (prev.num_threads == 0) {
+        return;
+    }
+    const cpu_set_t *prev_masks = (const cpu_set_t *)prev.masks.data();
+#ifdef PPL_USE_X86_OMP
+    PPL_X86_PRAGMA(omp parallel num_threads(prev.num_threads))
+#endif
+    {
+        const int32_t omp_tid = PPL_OMP_THREAD_ID();
+        // a team may be smaller than requested, threads that were not in it have nothing saved
+        if (omp_tid < prev.num_threads && CPU_COUNT(&prev_masks[omp_tid]) > 0) {
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &prev_masks[omp_tid]) != 0) {
+                LOG(ERROR) << "Restoring core binding failed";
+            }
+        }
+    }
+#endif
+}
+
 // A very naive version
 single_parallel_loop_config_t select_single_parallel_loop(
     const std::vector<int64_t> &iter_of_loop,
@@ -21,6 +21,7 @@
 #include <string.h> // for memcpy
 
 #include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -88,7 +89,10 @@ static ppl::common::RetCode tile_ndarray(
     const int64_t *repeats,
     eT *dst)
 {
-    return tile_ndarray_recursive<eT>(src_shape, dst_shape, src, repeats, 0, false, dst);
+    // small outputs are copied by the calling thread only, forking a team costs more than the copy
+    std::vector<int64_t> loops(dst_shape->GetDims(), dst_shape->GetDims() + dst_shape->GetDimCount());
+    auto pc = select_single_parallel_loop(loops, ppl::common::ISA_undef, sizeof(eT), sizeof(eT), sizeof(eT), 1);
+    return tile_ndarray_recursive<eT>(src_shape, dst_shape, src, repeats, 0, pc.num_threads <= 1, dst);
 }
 
 }}}; // namespace ppl::kernel::x86
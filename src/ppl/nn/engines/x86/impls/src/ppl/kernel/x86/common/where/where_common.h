@@ -19,9 +19,34 @@
 #define __ST_PPL_KERNEL_X86_COMMON_WHERE_WHERE_COMMON_H_
 
 #include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
+template <typename eT>
+inline void where_ndarray_lastdim(
+    const uint8_t *cond,
+    const eT *src_x,
+    const eT *src_y,
+    const int64_t inc_cond,
+    const int64_t inc_x,
+    const int64_t inc_y,
+    const int64_t start_idx,
+    const int64_t end_idx,
+    eT *dst)
+{
+    if (inc_cond == 1 && inc_x == 1 && inc_y == 1) {
+        // unit stride on all inputs lets the compiler turn this into blends
+        for (int64_t i = start_idx; i < end_idx; i++) {
+            dst[i] = cond[i] != 0 ? src_x[i] : src_y[i];
+        }
+    } else {
+        for (int64_t i = start_idx; i < end_idx; i++) {
+            dst[i] = cond[i * inc_cond] != 0 ? src_x[i * inc_x] : src_y[i * inc_y];
+        }
+    }
+}
+
 template <typename eT>
 ppl::common::RetCode where_eltwise_common(
     const ppl::nn::TensorShape *dst_shape,
@@ -30,11 +55,20 @@ ppl::common::RetCode where_eltwise_common(
     const eT *src_y,
     eT *dst)
 {
-    const uint32_t length = dst_shape->GetElementsIncludingPadding();
+    const int64_t length = dst_shape->GetElementsIncludingPadding();
 
+    auto pc = select_single_parallel_loop({length}, ppl::common::ISA_undef, 2 * sizeof(eT) + sizeof(uint8_t), sizeof(eT), sizeof(eT), 1);
+    if (pc.num_threads <= 1) {
+        where_ndarray_lastdim<eT>(cond, src_x, src_y, 1, 1, 1, 0, length, dst);
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t len_per_thread = div_up(length, pc.num_threads);
     PRAGMA_OMP_PARALLEL_FOR()
-    for (uint32_t i = 0; i < length; i++) {
-        dst[i] = cond[i] != 0 ? src_x[i] : src_y[i];
+    for (int64_t t = 0; t < pc.num_threads; ++t) {
+        const int64_t start_idx = t * len_per_thread;
+        const int64_t end_idx   = min<int64_t>(start_idx + len_per_thread, length);
+        where_ndarray_lastdim<eT>(cond, src_x, src_y, 1, 1, 1, start_idx, end_idx, dst);
     }
 
     return ppl::common::RC_SUCCESS;
@@ -42,6 +76,7 @@ ppl::common::RetCode where_eltwise_common(
 
 template <typename eT>
 ppl::common::RetCode where_ndarray_recursive(
+    const single_parallel_loop_config_t &pc,
     const ppl::nn::TensorShape *dst_shape,
     const uint8_t *cond,
     const eT *src_x,
@@ -51,38 +86,38 @@ ppl::common::RetCode where_ndarray_recursive(
     const int64_t *inc_y,
     const int64_t *inc_out,
     const uint32_t dim_idx,
-    const bool has_paralleld,
     eT *dst)
 {
     const uint32_t dim_count = dst_shape->GetDimCount();
-    const int64_t length    = dst_shape->GetDim(dim_idx);
+    const int64_t length     = dst_shape->GetDim(dim_idx);
+    const bool do_parallel   = pc.depth_of_loop == dim_idx && pc.num_threads > 1 && length > 1;
+    const int64_t num_tasks  = do_parallel ? pc.num_threads : 1;
+    const int64_t len_per_task = div_up(length, num_tasks);
 
     if (dim_idx == dim_count - 1) {
-        if (length > 1 && !has_paralleld) {
+        if (do_parallel) {
             PRAGMA_OMP_PARALLEL_FOR()
-            for (int64_t i = 0; i < length; i++) {
-                bool cond_value = cond[i * inc_cond[dim_idx]];
-                eT x_value       = src_x[i * inc_x[dim_idx]];
-                eT y_value       = src_y[i * inc_y[dim_idx]];
-                dst[i]          = cond_value ? x_value : y_value;
+            for (int64_t t = 0; t < num_tasks; ++t) {
+                const int64_t start_idx = t * len_per_task;
+                const int64_t end_idx   = min<int64_t>(start_idx + len_per_task, length);
+                where_ndarray_lastdim<eT>(cond, src_x, src_y, inc_cond[dim_idx], inc_x[dim_idx], inc_y[dim_idx], start_idx, end_idx, dst);
             }
         } else {
-            for (int64_t i = 0; i < length; i++) {
-                bool cond_value = cond[i * inc_cond[dim_idx]];
-                eT x_value       = src_x[i * inc_x[dim_idx]];
-                eT y_value       = src_y[i * inc_y[dim_idx]];
-                dst[i]          = cond_value ? x_value : y_value;
-            }
+            where_ndarray_lastdim<eT>(cond, src_x, src_y, inc_cond[dim_idx], inc_x[dim_idx], inc_y[dim_idx], 0, length, dst);
         }
     } else {
-        if (length > 1 && !has_paralleld) {
+        if (do_parallel) {
             PRAGMA_OMP_PARALLEL_FOR()
-            for (int64_t i = 0; i < length; i++) {
-                where_ndarray_recursive<eT>(dst_shape, cond + i * inc_cond[dim_idx], src_x + i * inc_x[dim_idx], src_y + i * inc_y[dim_idx], inc_cond, inc_x, inc_y, inc_out, dim_idx + 1, true, dst + i * inc_out[dim_idx]);
+            for (int64_t t = 0; t < num_tasks; ++t) {
+                const int64_t start_idx = t * len_per_task;
+                const int64_t end_idx   = min<int64_t>(start_idx + len_per_task, length);
+                for (int64_t i = start_idx; i < end_idx; i++) {
+                    where_ndarray_recursive<eT>(pc, dst_shape, cond + i * inc_cond[dim_idx], src_x + i * inc_x[dim_idx], src_y + i * inc_y[dim_idx], inc_cond, inc_x, inc_y, inc_out, dim_idx + 1, dst + i * inc_out[dim_idx]);
+                }
             }
         } else {
             for (int64_t i = 0; i < length; i++) {
-                where_ndarray_recursive<eT>(dst_shape, cond + i * inc_cond[dim_idx], src_x + i * inc_x[dim_idx], src_y + i * inc_y[dim_idx], inc_cond, inc_x, inc_y, inc_out, dim_idx + 1, has_paralleld, dst + i * inc_out[dim_idx]);
+                where_ndarray_recursive<eT>(pc, dst_shape, cond + i * inc_cond[dim_idx], src_x + i * inc_x[dim_idx], src_y + i * inc_y[dim_idx], inc_cond, inc_x, inc_y, inc_out, dim_idx + 1, dst + i * inc_out[dim_idx]);
             }
         }
     }
@@ -156,7 +191,10 @@ ppl::common::RetCode where_ndarray_common(
         stride_out *= dst_shape->GetDim(i);
     }
 
-    return where_ndarray_recursive<eT>(dst_shape, cond, src_x, src_y, inc_cond, inc_x, inc_y, inc_out, 0, false, dst);
+    std::vector<int64_t> loops(dst_shape->GetDims(), dst_shape->GetDims() + dim_count);
+    auto pc = select_single_parallel_loop(loops, ppl::common::ISA_undef, 2 * sizeof(eT) + sizeof(uint8_t), sizeof(eT), sizeof(eT), 1);
+
+    return where_ndarray_recursive<eT>(pc, dst_shape, cond, src_x, src_y, inc_cond, inc_x, inc_y, inc_out, 0, dst);
 }
 
 }}}; // namespace ppl::kernel::x86
@@ -28,4 +28,13 @@ ppl::common::RetCode argmax_ndarray_fp32(
     return argmax_ndarray<float>(src_shape, src, axis, dst);
 }
 
+ppl::common::RetCode argmax_n16cx_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const int64_t axis,
+    int64_t *dst)
+{
+    return argmax_n16cx<float>(src_shape, src, axis, dst);
+}
+
 }}}; // namespace ppl::kernel::x86
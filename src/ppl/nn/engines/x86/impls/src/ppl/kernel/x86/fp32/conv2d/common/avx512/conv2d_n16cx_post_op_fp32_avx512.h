@@ -0,0 +1,173 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_CONV2D_COMMON_AVX512_CONV2D_N16CX_POST_OP_FP32_AVX512_H_
+#define __ST_PPL_KERNEL_X86_FP32_CONV2D_COMMON_AVX512_CONV2D_N16CX_POST_OP_FP32_AVX512_H_
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/fp32/sigmoid/avx512/sigmoid_kernel_fp32_avx512.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct conv2d_n16cx_post_op_avx512_param {
+    __m512 alpha;
+    __m512 clip_min;
+    __m512 clip_max;
+};
+
+template <conv_fuse_flag_t activation>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p);
+
+template <>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512<conv_fuse_flag::none>(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p)
+{
+    return x;
+}
+
+template <>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512<conv_fuse_flag::sigmoid>(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p)
+{
+    return _avx512_sigmoid_ps(x);
+}
+
+template <>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512<conv_fuse_flag::swish>(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p)
+{
+    return _mm512_mul_ps(x, _avx512_sigmoid_ps(x));
+}
+
+template <>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512<conv_fuse_flag::hswish>(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p)
+{
+    __m512 t = _mm512_add_ps(x, _mm512_set1_ps(3.0f));
+    t        = _mm512_min_ps(_mm512_max_ps(t, _mm512_setzero_ps()), _mm512_set1_ps(6.0f));
+    return _mm512_mul_ps(_mm512_mul_ps(x, t), _mm512_set1_ps(1.0f / 6.0f));
+}
+
+template <>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512<conv_fuse_flag::leaky_relu>(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p)
+{
+    const __mmask16 neg = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+    return _mm512_mask_mul_ps(x, neg, x, p.alpha);
+}
+
+template <>
+inline __m512 conv2d_n16cx_post_act_fp32_avx512<conv_fuse_flag::clip>(const __m512 x, const conv2d_n16cx_post_op_avx512_param &p)
+{
+    return _mm512_min_ps(_mm512_max_ps(x, p.clip_min), p.clip_max);
+}
+
+template <conv_fuse_flag_t activation, bool with_post_sum>
+void conv2d_n16cx_post_op_kernel_fp32_avx512(
+    const conv2d_n16cx_post_op_avx512_param &p,
+    const float *post_sum,
+    const int64_t post_sum_ocb_stride,
+    const int64_t oc_len,
+    const int64_t hw_len,
+    const int64_t dst_ocb_stride,
+    float *dst)
+{
+    const int64_t ch_dt_blk = 16;
+    for (int64_t oc = 0; oc < oc_len; oc += ch_dt_blk) {
+        const int64_t oc_eff  = min<int64_t>(oc_len - oc, ch_dt_blk);
+        const __mmask16 mask  = oc_eff == ch_dt_blk ? __mmask16(0xffff) : __mmask16((1 << oc_eff) - 1);
+        const float *l_sum    = post_sum;
+        float *l_dst          = dst;
+        for (int64_t hw = 0; hw < hw_len; ++hw) {
+            __m512 v = conv2d_n16cx_post_act_fp32_avx512<activation>(_mm512_loadu_ps(l_dst), p);
+            if (with_post_sum) {
+                v = _mm512_add_ps(v, _mm512_maskz_loadu_ps(mask, l_sum));
+                l_sum += ch_dt_blk;
+            }
+            _mm512_mask_storeu_ps(l_dst, mask, v);
+            l_dst += ch_dt_blk;
+        }
+        if (with_post_sum) post_sum += post_sum_ocb_stride;
+        dst += dst_ocb_stride;
+    }
+}
+
+typedef void (*conv2d_n16cx_post_op_kernel_fp32_avx512_func_t)(
+    const conv2d_n16cx_post_op_avx512_param &,
+    const float *,
+    const int64_t,
+    const int64_t,
+    const int64_t,
+    const int64_t,
+    float *);
+
+template <bool with_post_sum>
+inline conv2d_n16cx_post_op_kernel_fp32_avx512_func_t conv2d_n16cx_select_post_op_kernel_fp32_avx512(const conv_fuse_flag_t fuse_flag)
+{
+    switch (fuse_flag & conv_fuse_flag::post_activation) {
+        case conv_fuse_flag::sigmoid: return conv2d_n16cx_post_op_kernel_fp32_avx512<conv_fuse_flag::sigmoid, with_post_sum>;
+        case conv_fuse_flag::swish: return conv2d_n16cx_post_op_kernel_fp32_avx512<conv_fuse_flag::swish, with_post_sum>;
+        case conv_fuse_flag::hswish: return conv2d_n16cx_post_op_kernel_fp32_avx512<conv_fuse_flag::hswish, with_post_sum>;
+        case conv_fuse_flag::leaky_relu: return conv2d_n16cx_post_op_kernel_fp32_avx512<conv_fuse_flag::leaky_relu, with_post_sum>;
+        case conv_fuse_flag::clip: return conv2d_n16cx_post_op_kernel_fp32_avx512<conv_fuse_flag::clip, with_post_sum>;
+        default: return conv2d_n16cx_post_op_kernel_fp32_avx512<conv_fuse_flag::none, with_post_sum>;
+    }
+}
+
+// Post-op epilogue for n16cx conv2d executors. Runs the activations that do not
+// fit in the microkernels (see conv_fuse_flag::post_activation) and post_sum on
+// an output tile right after it has been stored, while it is still in cache.
+// The tile is oc_len channels by hw_len pixels, channel blocks are
+// dst_ocb_stride/post_sum_ocb_stride apart. Padded channels are left untouched.
+class conv2d_n16cx_post_op_fp32_avx512 {
+public:
+    conv2d_n16cx_post_op_fp32_avx512(const conv2d_fp32_param &param)
+    {
+        p_.alpha    = _mm512_set1_ps(param.fuse_param.leaky_relu_alpha);
+        p_.clip_min = _mm512_set1_ps(param.fuse_param.clip_min);
+        p_.clip_max = _mm512_set1_ps(param.fuse_param.clip_max);
+        enabled_    = conv_fuse_flag::has_post_op(param.fuse_flag);
+        if (param.fuse_flag & conv_fuse_flag::post_sum) {
+            kernel_ = conv2d_n16cx_select_post_op_kernel_fp32_avx512<true>(param.fuse_flag);
+        } else {
+            kernel_ = conv2d_n16cx_select_post_op_kernel_fp32_avx512<false>(param.fuse_flag);
+        }
+    }
+
+    bool enabled() const
+    {
+        return enabled_;
+    }
+
+    void execute(
+        const float *post_sum,
+        const int64_t post_sum_ocb_stride,
+        const int64_t oc_len,
+        const int64_t hw_len,
+        const int64_t dst_ocb_stride,
+        float *dst) const
+    {
+        kernel_(p_, post_sum, post_sum_ocb_stride, oc_len, hw_len, dst_ocb_stride, dst);
+    }
+
+private:
+    conv2d_n16cx_post_op_avx512_param p_;
+    conv2d_n16cx_post_op_kernel_fp32_avx512_func_t kernel_;
+    bool enabled_;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,197 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_CONV2D_COMMON_FMA_CONV2D_N16CX_POST_OP_FP32_FMA_H_
+#define __ST_PPL_KERNEL_X86_FP32_CONV2D_COMMON_FMA_CONV2D_N16CX_POST_OP_FP32_FMA_H_
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/fp32/sigmoid/fma/sigmoid_kernel_fp32_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct conv2d_n16cx_post_op_fma_param {
+    __m256 alpha;
+    __m256 clip_min;
+    __m256 clip_max;
+};
+
+template <conv_fuse_flag_t activation>
+inline __m256 conv2d_n16cx_post_act_fp32_fma(const __m256 x, const conv2d_n16cx_post_op_fma_param &p);
+
+template <>
+inline __m256 conv2d_n16cx_post_act_fp32_fma<conv_fuse_flag::none>(const __m256 x, const conv2d_n16cx_post_op_fma_param &p)
+{
+    return x;
+}
+
+template <>
+inline __m256 conv2d_n16cx_post_act_fp32_fma<conv_fuse_flag::sigmoid>(const __m256 x, const conv2d_n16cx_post_op_fma_param &p)
+{
+    return _fma_sigmoid_ps(x);
+}
+
+template <>
+inline __m256 conv2d_n16cx_post_act_fp32_fma<conv_fuse_flag::swish>(const __m256 x, const conv2d_n16cx_post_op_fma_param &p)
+{
+    return _mm256_mul_ps(x, _fma_sigmoid_ps(x));
+}
+
+template <>
+inline __m256 conv2d_n16cx_post_act_fp32_fma<conv_fuse_flag::hswish>(const __m256 x, const conv2d_n16cx_post_op_fma_param &p)
+{
+    __m256 t = _mm256_add_ps(x, _mm256_set1_ps(3.0f));
+    t        = _mm256_min_ps(_mm256_max_ps(t, _mm256_setzero_ps()), _mm256_set1_ps(6.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(x, t), _mm256_set1_ps(1.0f / 6.0f));
+}
+
+template <>
+inline __m256 conv2d_n16cx_post_act_fp32_fma<conv_fuse_flag::leaky_relu>(const __m256 x, const conv2d_n16cx_post_op_fma_param &p)
+{
+    const __m256 neg = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+    return _mm256_blendv_ps(x, _mm256_mul_ps(x, p.alpha), neg);
+}
+
+template <>
+inline __m256 conv2d_n16cx_post_act_fp32_fma<conv_fuse_flag::clip>(const __m256 x, const conv2d_n16cx_post_op_fma_param &p)
+{
+    return _mm256_min_ps(_mm256_max_ps(x, p.clip_min), p.clip_max);
+}
+
+template <conv_fuse_flag_t activation, bool with_post_sum>
+void conv2d_n16cx_post_op_kernel_fp32_fma(
+    const conv2d_n16cx_post_op_fma_param &p,
+    const float *post_sum,
+    const int64_t post_sum_ocb_stride,
+    const int64_t oc_len,
+    const int64_t hw_len,
+    const int64_t dst_ocb_stride,
+    float *dst)
+{
+    const int64_t ch_dt_blk = 16;
+    const int64_t simd_w    = 8;
+    const __m256 lane_idx   = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    for (int64_t oc = 0; oc < oc_len; oc += ch_dt_blk) {
+        const int64_t oc_eff = min<int64_t>(oc_len - oc, ch_dt_blk);
+        const float *l_sum   = post_sum;
+        float *l_dst         = dst;
+        if (oc_eff == ch_dt_blk) {
+            for (int64_t hw = 0; hw < hw_len; ++hw) {
+                __m256 v0 = conv2d_n16cx_post_act_fp32_fma<activation>(_mm256_loadu_ps(l_dst + 0 * simd_w), p);
+                __m256 v1 = conv2d_n16cx_post_act_fp32_fma<activation>(_mm256_loadu_ps(l_dst + 1 * simd_w), p);
+                if (with_post_sum) {
+                    v0 = _mm256_add_ps(v0, _mm256_loadu_ps(l_sum + 0 * simd_w));
+                    v1 = _mm256_add_ps(v1, _mm256_loadu_ps(l_sum + 1 * simd_w));
+                    l_sum += ch_dt_blk;
+                }
+                _mm256_storeu_ps(l_dst + 0 * simd_w, v0);
+                _mm256_storeu_ps(l_dst + 1 * simd_w, v1);
+                l_dst += ch_dt_blk;
+            }
+        } else {
+            // keep padded channels untouched
+            const __m256 mask0 = _mm256_cmp_ps(lane_idx, _mm256_set1_ps(float(oc_eff - 0 * simd_w)), _CMP_LT_OQ);
+            const __m256 mask1 = _mm256_cmp_ps(lane_idx, _mm256_set1_ps(float(oc_eff - 1 * simd_w)), _CMP_LT_OQ);
+            for (int64_t hw = 0; hw < hw_len; ++hw) {
+                const __m256 d0 = _mm256_loadu_ps(l_dst + 0 * simd_w);
+                const __m256 d1 = _mm256_loadu_ps(l_dst + 1 * simd_w);
+                __m256 v0 = conv2d_n16cx_post_act_fp32_fma<activation>(d0, p);
+                __m256 v1 = conv2d_n16cx_post_act_fp32_fma<activation>(d1, p);
+                if (with_post_sum) {
+                    v0 = _mm256_add_ps(v0, _mm256_loadu_ps(l_sum + 0 * simd_w));
+                    v1 = _mm256_add_ps(v1, _mm256_loadu_ps(l_sum + 1 * simd_w));
+                    l_sum += ch_dt_blk;
+                }
+                _mm256_storeu_ps(l_dst + 0 * simd_w, _mm256_blendv_ps(d0, v0, mask0));
+                _mm256_storeu_ps(l_dst + 1 * simd_w, _mm256_blendv_ps(d1, v1, mask1));
+                l_dst += ch_dt_blk;
+            }
+        }
+        if (with_post_sum) post_sum += post_sum_ocb_stride;
+        dst += dst_ocb_stride;
+    }
+}
+
+typedef void (*conv2d_n16cx_post_op_kernel_fp32_fma_func_t)(
+    const conv2d_n16cx_post_op_fma_param &,
+    const float *,
+    const int64_t,
+    const int64_t,
+    const int64_t,
+    const int64_t,
+    float *);
+
+template <bool with_post_sum>
+inline conv2d_n16cx_post_op_kernel_fp32_fma_func_t conv2d_n16cx_select_post_op_kernel_fp32_fma(const conv_fuse_flag_t fuse_flag)
+{
+    switch (fuse_flag & conv_fuse_flag::post_activation) {
+        case conv_fuse_flag::sigmoid: return conv2d_n16cx_post_op_kernel_fp32_fma<conv_fuse_flag::sigmoid, with_post_sum>;
+        case conv_fuse_flag::swish: return conv2d_n16cx_post_op_kernel_fp32_fma<conv_fuse_flag::swish, with_post_sum>;
+        case conv_fuse_flag::hswish: return conv2d_n16cx_post_op_kernel_fp32_fma<conv_fuse_flag::hswish, with_post_sum>;
+        case conv_fuse_flag::leaky_relu: return conv2d_n16cx_post_op_kernel_fp32_fma<conv_fuse_flag::leaky_relu, with_post_sum>;
+        case conv_fuse_flag::clip: return conv2d_n16cx_post_op_kernel_fp32_fma<conv_fuse_flag::clip, with_post_sum>;
+        default: return conv2d_n16cx_post_op_kernel_fp32_fma<conv_fuse_flag::none, with_post_sum>;
+    }
+}
+
+// Post-op epilogue for n16cx conv2d executors. Runs the activations that do not
+// fit in the microkernels (see conv_fuse_flag::post_activation) and post_sum on
+// an output tile right after it has been stored, while it is still in cache.
+// The tile is oc_len channels by hw_len pixels, channel blocks are
+// dst_ocb_stride/post_sum_ocb_stride apart. Padded channels are left untouched.
+class conv2d_n16cx_post_op_fp32_fma {
+public:
+    conv2d_n16cx_post_op_fp32_fma(const conv2d_fp32_param &param)
+    {
+        p_.alpha    = _mm256_set1_ps(param.fuse_param.leaky_relu_alpha);
+        p_.clip_min = _mm256_set1_ps(param.fuse_param.clip_min);
+        p_.clip_max = _mm256_set1_ps(param.fuse_param.clip_max);
+        enabled_    = conv_fuse_flag::has_post_op(param.fuse_flag);
+        if (param.fuse_flag & conv_fuse_flag::post_sum) {
+            kernel_ = conv2d_n16cx_select_post_op_kernel_fp32_fma<true>(param.fuse_flag);
+        } else {
+            kernel_ = conv2d_n16cx_select_post_op_kernel_fp32_fma<false>(param.fuse_flag);
+        }
+    }
+
+    bool enabled() const
+    {
+        return enabled_;
+    }
+
+    void execute(
+        const float *post_sum,
+        const int64_t post_sum_ocb_stride,
+        const int64_t oc_len,
+        const int64_t hw_len,
+        const int64_t dst_ocb_stride,
+        float *dst) const
+    {
+        kernel_(p_, post_sum, post_sum_ocb_stride, oc_len, hw_len, dst_ocb_stride, dst);
+    }
+
+private:
+    conv2d_n16cx_post_op_fma_param p_;
+    conv2d_n16cx_post_op_kernel_fp32_fma_func_t kernel_;
+    bool enabled_;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
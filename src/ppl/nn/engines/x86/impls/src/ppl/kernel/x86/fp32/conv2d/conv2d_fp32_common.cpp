@@ -21,19 +21,25 @@
 
 #include "ppl/kernel/x86/fp32/conv2d/implicit_gemm/fma/conv2d_n16cx_implicit_gemm_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_n16cx_gemm_direct_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b2f3_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b4f3_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b6f3_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_n16cx_depthwise_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/im2col_gemm/fma/conv2d_im2col_gemm_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/fma/conv2d_n16cx_direct_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/fma/conv2d_n16cx_direct_ndarray_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_n16cx_gemm_direct_v2_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/fma/conv2d_n16cx_direct_v2_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_nhwc_gemm_direct_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_nhwc_depthwise_fp32_fma.h"
 
 #include "ppl/kernel/x86/fp32/conv2d/direct/avx512/conv2d_n16cx_direct_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/avx512/conv2d_n16cx_gemm_direct_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/avx512/conv2d_n16cx_depthwise_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/avx512/conv2d_n16cx_direct_ndarray_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_b2f3_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_b4f3_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_b6f3_fp32_avx512.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -51,6 +57,15 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
             .input_format  = ppl::common::DATAFORMAT_NDARRAY,
             .output_format = ppl::common::DATAFORMAT_NDARRAY};
 
+    // keep nhwc inputs in nhwc instead of reordering them into n16cx
+    if (src_format == ppl::common::DATAFORMAT_NHWC && (isa_flags & ppl::common::ISA_X86_FMA)) {
+        return (conv2d_fp32_algo_info){
+            .algo_type     = param.is_depthwise() ? conv2d_fp32_algo::depthwise : conv2d_fp32_algo::gemm_direct,
+            .isa           = ppl::common::ISA_X86_FMA,
+            .input_format  = ppl::common::DATAFORMAT_NHWC,
+            .output_format = ppl::common::DATAFORMAT_NHWC};
+    }
+
     if (isa_flags & ppl::common::ISA_X86_AVX512) {
         if (src_format == ppl::common::DATAFORMAT_NDARRAY) {
             auto direct_ndarray_mgr = new conv2d_n16cx_direct_ndarray_fp32_avx512_manager(param, nullptr);
@@ -198,6 +213,61 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
     }
 }
 
+// rough cost of a winograd bXf3 variant: gemm flops plus input/output transform flops of all tiles
+static inline float winograd_cost(
+    const int64_t tile_out,
+    const int64_t batch,
+    const int64_t dst_h,
+    const int64_t dst_w,
+    const conv2d_fp32_param &param)
+{
+    const int64_t tile_in   = tile_out + 2;
+    const int64_t num_tiles = batch * div_up(dst_h, tile_out) * div_up(dst_w, tile_out);
+    const float gemm_flops  = (float)param.channels * param.num_output / param.group;
+    const float trans_flops = 2.0f * tile_in * (param.channels + param.num_output);
+    return (float)num_tiles * tile_in * tile_in * (gemm_flops + trans_flops);
+}
+
+conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::nn::TensorShape &src_shape, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags)
+{
+    conv2d_fp32_algo_info algo_info = select_algo(src_shape.GetDataFormat(), param, isa_flags);
+    if (algo_info.algo_type != conv2d_fp32_algo::winograd_b4f3 || src_shape.GetDimCount() != 4) {
+        return algo_info;
+    }
+
+    const int64_t batch = src_shape.GetDim(0);
+    const int64_t dst_h = src_shape.GetDim(2) + 2 * param.pad_h - 2;
+    const int64_t dst_w = src_shape.GetDim(3) + 2 * param.pad_w - 2;
+    if (batch <= 0 || dst_h <= 0 || dst_w <= 0) {
+        return algo_info;
+    }
+
+    // b4f3 is the default, the others must be strictly cheaper since their tiles are less friendly to
+    // precision (b6f3) or to gemm efficiency (b2f3)
+    const conv2d_fp32_algo_t variants[] = {conv2d_fp32_algo::winograd_b2f3, conv2d_fp32_algo::winograd_b6f3};
+    const int64_t variant_tile_out[] = {2, 6};
+    float best_cost = winograd_cost(4, batch, dst_h, dst_w, param);
+    conv2d_fp32_algo_t best_algo = conv2d_fp32_algo::winograd_b4f3;
+    for (int64_t i = 0; i < 2; ++i) {
+        const float cost = winograd_cost(variant_tile_out[i], batch, dst_h, dst_w, param);
+        if (cost >= best_cost) {
+            continue;
+        }
+        conv2d_fp32_algo_info variant_info = algo_info;
+        variant_info.algo_type = variants[i];
+        auto mgr = gen_algo(param, variant_info, nullptr);
+        bool supported = mgr->is_supported();
+        delete mgr;
+        if (supported) {
+            best_cost = cost;
+            best_algo = variants[i];
+        }
+    }
+    algo_info.algo_type = best_algo;
+
+    return algo_info;
+}
+
 conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &param, const conv2d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator)
 {
     conv2d_fp32_manager *conv_mgr = nullptr;
@@ -225,18 +295,42 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         conv_mgr = new conv2d_n16cx_depthwise_fp32_fma_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::winograd_b2f3 &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        conv_mgr = new conv2d_n16cx_winograd_b2f3_fp32_fma_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::winograd_b4f3 &&
         algo_info.isa == ppl::common::ISA_X86_FMA &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         conv_mgr = new conv2d_n16cx_winograd_b4f3_fp32_fma_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::winograd_b6f3 &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        conv_mgr = new conv2d_n16cx_winograd_b6f3_fp32_fma_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::winograd_b2f3 &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        conv_mgr = new conv2d_n16cx_winograd_b2f3_fp32_avx512_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::winograd_b4f3 &&
         algo_info.isa == ppl::common::ISA_X86_AVX512 &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         conv_mgr = new conv2d_n16cx_winograd_b4f3_fp32_avx512_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::winograd_b6f3 &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        conv_mgr = new conv2d_n16cx_winograd_b6f3_fp32_avx512_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::direct &&
         algo_info.isa == ppl::common::ISA_X86_FMA &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
@@ -261,6 +355,18 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
         algo_info.output_format == ppl::common::DATAFORMAT_NDARRAY) {
         conv_mgr = new conv2d_im2col_gemm_fp32_fma_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::gemm_direct &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_NHWC &&
+        algo_info.output_format == ppl::common::DATAFORMAT_NHWC) {
+        conv_mgr = new conv2d_nhwc_gemm_direct_fp32_fma_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::depthwise &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_NHWC &&
+        algo_info.output_format == ppl::common::DATAFORMAT_NHWC) {
+        conv_mgr = new conv2d_nhwc_depthwise_fp32_fma_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::direct &&
         algo_info.isa == ppl::common::ISA_X86_AVX512 &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
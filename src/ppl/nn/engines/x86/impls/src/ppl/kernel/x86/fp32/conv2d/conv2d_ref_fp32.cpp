@@ -15,6 +15,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <math.h>
+
 #include "ppl/kernel/x86/common/internal_include.h"
 #include "ppl/kernel/x86/fp32/conv2d.h"
 
@@ -96,6 +98,25 @@ ppl::common::RetCode conv2d_ref_fp32(
                         if (param.fuse_flag & conv_fuse_flag::relu6) {
                             sum_val = min(sum_val, 6.0f);
                         }
+                        if (param.fuse_flag & conv_fuse_flag::sigmoid) {
+                            sum_val = 1.0f / (1.0f + expf(-sum_val));
+                        }
+                        if (param.fuse_flag & conv_fuse_flag::swish) {
+                            sum_val = sum_val / (1.0f + expf(-sum_val));
+                        }
+                        if (param.fuse_flag & conv_fuse_flag::hswish) {
+                            sum_val = sum_val * min(max(sum_val + 3.0f, 0.0f), 6.0f) / 6.0f;
+                        }
+                        if (param.fuse_flag & conv_fuse_flag::leaky_relu) {
+                            sum_val = sum_val < 0.0f ? sum_val * param.fuse_param.leaky_relu_alpha : sum_val;
+                        }
+                        if (param.fuse_flag & conv_fuse_flag::clip) {
+                            sum_val = min(max(sum_val, param.fuse_param.clip_min), param.fuse_param.clip_max);
+                        }
+                        if (param.fuse_flag & conv_fuse_flag::post_sum) {
+                            const float *sum_d = sum_src + (b * sum_src_shape->GetDim(1) + g * oc_per_gp) * dst_h * dst_w;
+                            sum_val += sum_d[output_idx];
+                        }
                         output_d[output_idx] = sum_val;
                         ++output_idx;
                     }
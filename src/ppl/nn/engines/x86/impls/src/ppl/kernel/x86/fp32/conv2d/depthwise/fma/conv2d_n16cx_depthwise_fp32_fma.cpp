@@ -23,6 +23,7 @@
 #include "ppl/kernel/x86/common/avx_tools.h"
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_n16cx_depthwise_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_n16cx_depthwise_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/common/fma/conv2d_n16cx_post_op_fp32_fma.h"
 #include "ppl/common/sys.h"
 
 #define ASSUME_L2_BYTES() (256 * 1024)
@@ -57,13 +58,12 @@ void conv2d_n16cx_depthwise_fp32_fma_executor::cal_kernel_tunning_param()
     const int32_t src_w      = src_shape_->GetDim(3);
     const int32_t dst_h      = dst_shape_->GetDim(2);
     const int32_t dst_w      = dst_shape_->GetDim(3);
-    const int32_t ext_kernel_w = (cp.kernel_w - 1) * cp.dilation_w + 1;
 
     const float l3_cap_all_core = (ppl::common::GetCpuCacheL3() == 0 ? (ASSUME_L3_BYTES() * num_thread) : ppl::common::GetCpuCacheL3()) * L3_RATIO() / sizeof(float);
 
     const int64_t src_len     = int64_t(batch) * sp.padded_ch * src_h * src_w;
     const int64_t dst_len     = int64_t(batch) * sp.padded_ch * dst_h * dst_w;
-    const int64_t sum_src_len = (conv_param_->fuse_flag & conv_fuse_flag::sum) ? int64_t(batch) * sp.padded_ch * dst_h * dst_w : 0;
+    const int64_t sum_src_len = (conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) ? int64_t(batch) * sp.padded_ch * dst_h * dst_w : 0;
     const int64_t tot_data_len = src_len + dst_len + sum_src_len;
 
     if (tot_data_len < l3_cap_all_core
@@ -76,35 +76,46 @@ void conv2d_n16cx_depthwise_fp32_fma_executor::cal_kernel_tunning_param()
         sp.padding_policy = PADDING_POLICY_NOPAD();
     }
 
-    sp.unroll_ow_start = -1;
-    sp.unroll_ow_end = -1;
     if (sp.padding_policy == PADDING_POLICY_NOPAD()) {
-        for (int32_t ow = 0; ow < dst_w; ++ow) {
-            if (ow * cp.stride_w - cp.pad_w >= 0) {
-                sp.unroll_ow_start = ow;
-                break;
-            }
-        }
-        for (int32_t ow = dst_w - 1; ow >= 0; --ow) {
-            if (ow * cp.stride_w - cp.pad_w + ext_kernel_w <= src_w) {
-                sp.unroll_ow_end = ow + 1;
-                break;
-            }
-        }
-        if (sp.unroll_ow_start >= sp.unroll_ow_end || sp.unroll_ow_start < 0 || sp.unroll_ow_end < 0) {
-            sp.unroll_ow_start = sp.unroll_ow_end = dst_w;
-        }
+        cal_unroll_ow_nopad(&sp.unroll_ow_start, &sp.unroll_ow_end);
     } else {
         sp.unroll_ow_start = 0;
         sp.unroll_ow_end = dst_w;
     }
 
     sp.use_nt_store = 0;
-    if (tot_data_len > l3_cap_all_core * 3) {
+    if (tot_data_len > l3_cap_all_core * 3 && !conv_fuse_flag::has_post_op(cp.fuse_flag)) {
         sp.use_nt_store = 1;
     }
 }
 
+void conv2d_n16cx_depthwise_fp32_fma_executor::cal_unroll_ow_nopad(int32_t *unroll_ow_start, int32_t *unroll_ow_end) const
+{
+    const conv2d_fp32_param &cp = *conv_param_;
+
+    const int32_t src_w        = src_shape_->GetDim(3);
+    const int32_t dst_w        = dst_shape_->GetDim(3);
+    const int32_t ext_kernel_w = (cp.kernel_w - 1) * cp.dilation_w + 1;
+
+    *unroll_ow_start = -1;
+    *unroll_ow_end   = -1;
+    for (int32_t ow = 0; ow < dst_w; ++ow) {
+        if (ow * cp.stride_w - cp.pad_w >= 0) {
+            *unroll_ow_start = ow;
+            break;
+        }
+    }
+    for (int32_t ow = dst_w - 1; ow >= 0; --ow) {
+        if (ow * cp.stride_w - cp.pad_w + ext_kernel_w <= src_w) {
+            *unroll_ow_end = ow + 1;
+            break;
+        }
+    }
+    if (*unroll_ow_start >= *unroll_ow_end || *unroll_ow_start < 0 || *unroll_ow_end < 0) {
+        *unroll_ow_start = *unroll_ow_end = dst_w;
+    }
+}
+
 uint64_t conv2d_n16cx_depthwise_fp32_fma_executor::cal_temp_buffer_size()
 {
     if (schedule_param_.padding_policy == PADDING_POLICY_NOPAD()) {
@@ -119,7 +130,7 @@ uint64_t conv2d_n16cx_depthwise_fp32_fma_executor::cal_temp_buffer_size()
 
 ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_executor::prepare()
 {
-    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_shape_)) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -131,7 +142,7 @@ ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_executor::prepare()
 
 ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_executor::execute()
 {
-    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_) || !temp_buffer_) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -160,9 +171,12 @@ ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_executor::execute()
     const bool with_sum = cp.fuse_flag & conv_fuse_flag::sum;
     const bool with_relu  = cp.fuse_flag & conv_fuse_flag::relu;
     const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::relu6;
+    const bool with_post_sum = cp.fuse_flag & conv_fuse_flag::post_sum;
+
+    const conv2d_n16cx_post_op_fp32_fma post_op(cp);
 
     int64_t sum_src_b_stride = 0;
-    if (with_sum) {
+    if (with_sum || with_post_sum) {
         sum_src_b_stride = int64_t(round_up(sum_src_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
     }
 
@@ -273,6 +287,11 @@ ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_executor::execute()
                 PICK_PARAM(const float*, private_param, SUM_SRC_IDX()) += CH_DT_BLK();
                 PICK_PARAM(float*, private_param, DST_IDX()) += CH_DT_BLK();
             }
+
+            if (post_op.enabled()) {
+                const float *l_post = with_post_sum ? base_sum_src + oh * dst_w * CH_DT_BLK() : nullptr;
+                post_op.execute(l_post, 0, min<int64_t>(cp.num_output - c, CH_DT_BLK()), dst_w, 0, base_dst + oh * dst_w * CH_DT_BLK());
+            }
         }
     }
     if (sp.use_nt_store) {
@@ -285,6 +304,124 @@ ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_executor::execute()
     return ppl::common::RC_SUCCESS;
 }
 
+void conv2d_n16cx_depthwise_fp32_fma_executor::execute_rows(
+    const float *src,
+    const int64_t src_c_stride,
+    const int64_t oh_start,
+    const int64_t oh_end,
+    const int64_t dst_c_stride,
+    float *dst) const
+{
+    const conv2d_fp32_param &cp     = *conv_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int32_t src_h = src_shape_->GetDim(2);
+    const int32_t src_w = src_shape_->GetDim(3);
+    const int32_t dst_w = dst_shape_->GetDim(3);
+
+    const int32_t ext_kernel_h = (cp.kernel_h - 1) * cp.dilation_h + 1;
+    const int32_t ext_kernel_w = (cp.kernel_w - 1) * cp.dilation_w + 1;
+
+    const int64_t src_h_stride  = int64_t(src_w) * CH_DT_BLK();
+    const int64_t src_sw_stride = cp.stride_w * CH_DT_BLK();
+    const int64_t dst_h_stride  = int64_t(dst_w) * CH_DT_BLK();
+
+    const conv2d_n16cx_post_op_fp32_fma post_op(cp);
+
+    int32_t unroll_ow_start, unroll_ow_end;
+    cal_unroll_ow_nopad(&unroll_ow_start, &unroll_ow_end);
+    const int64_t ow_unroll_len  = unroll_ow_end - unroll_ow_start;
+    const int64_t ow_unroll_body = round(ow_unroll_len, sp.ow_kr_blk);
+    const int64_t ow_unroll_tail = ow_unroll_len - ow_unroll_body;
+
+    int64_t share_param[SHAR_PARAM_LEN()];
+    share_param[SRC_SW_STRIDE_IDX()] = src_sw_stride;
+    share_param[SRC_DH_STRIDE_IDX()] = cp.dilation_h * src_h_stride;
+    share_param[SRC_DW_STRIDE_IDX()] = cp.dilation_w * CH_DT_BLK();
+    share_param[KW_IDX()] = cp.kernel_w;
+    {
+        uint64_t kernel_flags = 0;
+        if (cp.fuse_flag & conv_fuse_flag::relu) kernel_flags |= KERNEL_FLAG_RELU();
+        if (cp.fuse_flag & conv_fuse_flag::relu6) kernel_flags |= KERNEL_FLAG_RELU6();
+        share_param[FLAGS_IDX()] = kernel_flags;
+    }
+    const int32_t nt_store_sel = 0;
+    const int32_t stride_w_sel = cp.stride_w > 2 ? 0: cp.stride_w;
+
+    int64_t private_param[PRIV_PARAM_LEN()];
+    for (int64_t c = 0; c < sp.padded_ch; c += CH_DT_BLK()) {
+        const float *base_src = src + c / CH_DT_BLK() * src_c_stride;
+        float *base_dst       = dst + c / CH_DT_BLK() * dst_c_stride;
+
+        PICK_PARAM(const float*, private_param, FLT_IDX()) = cvt_filter_ + c * cp.kernel_h * cp.kernel_w;
+        PICK_PARAM(const float*, private_param, BIAS_IDX()) = cvt_bias_ + c;
+
+        for (int64_t oh = oh_start; oh < oh_end; ++oh) {
+            const int64_t ih = oh * cp.stride_h - cp.pad_h;
+            if (cp.dilation_h == 1) {
+                private_param[KH_START_IDX()] = min<int64_t>(max<int64_t>(0 - ih, 0), cp.kernel_h - 1);
+                private_param[KH_END_IDX()]   = max<int64_t>(min<int64_t>(src_h - ih, cp.kernel_h), 0);
+            } else {
+                private_param[KH_START_IDX()] = div_up(min<int64_t>(max<int64_t>(0 - ih, 0), ext_kernel_h - 1), cp.dilation_h);
+                private_param[KH_END_IDX()]   = div_up(max<int64_t>(min<int64_t>(src_h - ih, ext_kernel_h), 0), cp.dilation_h);
+            }
+
+            PICK_PARAM(const float*, private_param, SRC_IDX())     = base_src + ih * src_h_stride - cp.pad_w * CH_DT_BLK();
+            PICK_PARAM(const float*, private_param, SUM_SRC_IDX()) = base_dst + oh * dst_h_stride; // not used without sum
+            PICK_PARAM(float*, private_param, DST_IDX())           = base_dst + oh * dst_h_stride;
+
+            for (int64_t ow = 0; ow < unroll_ow_start; ++ow) {
+                const int64_t iw = ow * cp.stride_w - cp.pad_w;
+                if (cp.dilation_w == 1) {
+                    private_param[KW_START_IDX()] = min<int64_t>(max<int64_t>(0 - iw, 0), cp.kernel_w - 1);
+                    private_param[KW_END_IDX()]   = max<int64_t>(min<int64_t>(src_w - iw, cp.kernel_w), 0);
+                } else {
+                    private_param[KW_START_IDX()] = div_up(min<int64_t>(max<int64_t>(0 - iw, 0), ext_kernel_w - 1), cp.dilation_w);
+                    private_param[KW_END_IDX()]   = div_up(max<int64_t>(min<int64_t>(src_w - iw, ext_kernel_w), 0), cp.dilation_w);
+                }
+                conv2d_n16cx_depthwise_kernel_fp32_fma_pad_table[nt_store_sel](private_param, share_param);
+                PICK_PARAM(const float*, private_param, SRC_IDX()) += src_sw_stride;
+                PICK_PARAM(const float*, private_param, SUM_SRC_IDX()) += CH_DT_BLK();
+                PICK_PARAM(float*, private_param, DST_IDX()) += CH_DT_BLK();
+            }
+
+            if (ow_unroll_body) {
+                private_param[OW_IDX()] = ow_unroll_body;
+                conv2d_n16cx_depthwise_kernel_fp32_fma_blk_table[nt_store_sel][stride_w_sel][sp.ow_kr_blk - 1](private_param, share_param);
+                PICK_PARAM(const float *, private_param, SRC_IDX()) += ow_unroll_body * src_sw_stride;
+                PICK_PARAM(const float *, private_param, SUM_SRC_IDX()) += ow_unroll_body * CH_DT_BLK();
+                PICK_PARAM(float *, private_param, DST_IDX()) += ow_unroll_body * CH_DT_BLK();
+            }
+            if (ow_unroll_tail) {
+                private_param[OW_IDX()] = ow_unroll_tail;
+                conv2d_n16cx_depthwise_kernel_fp32_fma_blk_table[nt_store_sel][stride_w_sel][ow_unroll_tail - 1](private_param, share_param);
+                PICK_PARAM(const float *, private_param, SRC_IDX()) += ow_unroll_tail * src_sw_stride;
+                PICK_PARAM(const float *, private_param, SUM_SRC_IDX()) += ow_unroll_tail * CH_DT_BLK();
+                PICK_PARAM(float *, private_param, DST_IDX()) += ow_unroll_tail * CH_DT_BLK();
+            }
+
+            for (int64_t ow = unroll_ow_end; ow < dst_w; ++ow) {
+                const int64_t iw = ow * cp.stride_w - cp.pad_w;
+                if (cp.dilation_w == 1) {
+                    private_param[KW_START_IDX()] = min<int64_t>(max<int64_t>(0 - iw, 0), cp.kernel_w - 1);
+                    private_param[KW_END_IDX()]   = max<int64_t>(min<int64_t>(src_w - iw, cp.kernel_w), 0);
+                } else {
+                    private_param[KW_START_IDX()] = div_up(min<int64_t>(max<int64_t>(0 - iw, 0), ext_kernel_w - 1), cp.dilation_w);
+                    private_param[KW_END_IDX()]   = div_up(max<int64_t>(min<int64_t>(src_w - iw, ext_kernel_w), 0), cp.dilation_w);
+                }
+                conv2d_n16cx_depthwise_kernel_fp32_fma_pad_table[nt_store_sel](private_param, share_param);
+                PICK_PARAM(const float*, private_param, SRC_IDX()) += src_sw_stride;
+                PICK_PARAM(const float*, private_param, SUM_SRC_IDX()) += CH_DT_BLK();
+                PICK_PARAM(float*, private_param, DST_IDX()) += CH_DT_BLK();
+            }
+
+            if (post_op.enabled()) {
+                post_op.execute(nullptr, 0, min<int64_t>(cp.num_output - c, CH_DT_BLK()), dst_w, 0, base_dst + oh * dst_h_stride);
+            }
+        }
+    }
+}
+
 ppl::common::RetCode conv2d_n16cx_depthwise_fp32_fma_manager::gen_cvt_weights(const float *filter, const float *bias)
 {
     if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
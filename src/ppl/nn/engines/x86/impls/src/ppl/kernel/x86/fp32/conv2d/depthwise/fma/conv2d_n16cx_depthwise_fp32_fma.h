@@ -36,6 +36,16 @@ public:
     ppl::common::RetCode prepare() override;
     ppl::common::RetCode execute() override;
 
+    // Compute output rows [oh_start, oh_end) of one image without padding copy and nt-store, for fused executors.
+    // src and dst are addressed by absolute row of channel block 0, each channel block is *_c_stride apart.
+    void execute_rows(
+        const float *src,
+        const int64_t src_c_stride,
+        const int64_t oh_start,
+        const int64_t oh_end,
+        const int64_t dst_c_stride,
+        float *dst) const;
+
 private:
     struct kernel_schedule_param {
         // Preprocessed param
@@ -53,6 +63,7 @@ private:
 
     void init_preproc_param();
     void cal_kernel_tunning_param();
+    void cal_unroll_ow_nopad(int32_t *unroll_ow_start, int32_t *unroll_ow_end) const;
 
     friend conv2d_n16cx_depthwise_fp32_fma_manager;
 };
@@ -62,6 +73,10 @@ public:
     conv2d_n16cx_depthwise_fp32_fma_manager() {}
     conv2d_n16cx_depthwise_fp32_fma_manager(const conv2d_fp32_param &param, ppl::common::Allocator *allocator)
         : conv2d_fp32_manager(param, allocator) {}
+    bool is_fuse_supported(const conv_fuse_flag_t fuse_flag) const override
+    {
+        return true;
+    }
     bool is_supported() override;
     ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) override;
     conv2d_fp32_executor *gen_executor() override;
@@ -0,0 +1,158 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_nhwc_depthwise_fp32_fma.h"
+
+#define CH_DT_BLK() 8
+
+namespace ppl { namespace kernel { namespace x86 {
+
+void conv2d_nhwc_depthwise_fp32_fma_executor::init_preproc_param()
+{
+    schedule_param_.padded_ch = round_up(conv_param_->group, CH_DT_BLK());
+}
+
+uint64_t conv2d_nhwc_depthwise_fp32_fma_executor::cal_temp_buffer_size()
+{
+    return 0;
+}
+
+ppl::common::RetCode conv2d_nhwc_depthwise_fp32_fma_executor::prepare()
+{
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    init_preproc_param();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_nhwc_depthwise_fp32_fma_executor::execute()
+{
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const conv2d_fp32_param &cp     = *conv_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t batch    = src_shape_->GetDim(0);
+    const int64_t src_h    = src_shape_->GetDim(2);
+    const int64_t src_w    = src_shape_->GetDim(3);
+    const int64_t dst_h    = dst_shape_->GetDim(2);
+    const int64_t dst_w    = dst_shape_->GetDim(3);
+    // channels of nhwc tensors are padded to whole vectors, padded lanes are computed as well and ignored
+    const int64_t channels = src_shape_->GetElementsIncludingPadding() / (batch * src_h * src_w);
+
+    const bool with_sum   = cp.fuse_flag & conv_fuse_flag::sum;
+    const bool with_relu  = cp.fuse_flag & (conv_fuse_flag::relu | conv_fuse_flag::relu6);
+    const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::relu6;
+
+#ifdef PPL_USE_X86_OMP_COLLAPSE
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
+#endif
+    for (int64_t b = 0; b < batch; ++b) {
+#ifndef PPL_USE_X86_OMP_COLLAPSE
+        PRAGMA_OMP_PARALLEL_FOR()
+#endif
+        for (int64_t oh = 0; oh < dst_h; ++oh) {
+            const int64_t ih_start = oh * cp.stride_h - cp.pad_h;
+            const int64_t kh_start = max<int64_t>(div_up(-ih_start, cp.dilation_h), 0);
+            const int64_t kh_end   = min<int64_t>(div_up(src_h - ih_start, cp.dilation_h), cp.kernel_h);
+            const float *src_b     = src_ + b * src_h * src_w * channels;
+            for (int64_t ow = 0; ow < dst_w; ++ow) {
+                const int64_t iw_start = ow * cp.stride_w - cp.pad_w;
+                const int64_t kw_start = max<int64_t>(div_up(-iw_start, cp.dilation_w), 0);
+                const int64_t kw_end   = min<int64_t>(div_up(src_w - iw_start, cp.dilation_w), cp.kernel_w);
+                const int64_t dst_offset = ((b * dst_h + oh) * dst_w + ow) * channels;
+                for (int64_t c = 0; c < channels; c += CH_DT_BLK()) {
+                    __m256 acc = _mm256_loadu_ps(cvt_bias_ + c);
+                    for (int64_t kh = kh_start; kh < kh_end; ++kh) {
+                        const float *src_row = src_b + ((ih_start + kh * cp.dilation_h) * src_w + iw_start) * channels + c;
+                        const float *flt_row = cvt_filter_ + kh * cp.kernel_w * sp.padded_ch + c;
+                        for (int64_t kw = kw_start; kw < kw_end; ++kw) {
+                            const float *src_pix = src_row + kw * cp.dilation_w * channels;
+                            acc = _mm256_fmadd_ps(_mm256_loadu_ps(src_pix), _mm256_loadu_ps(flt_row + kw * sp.padded_ch), acc);
+                        }
+                    }
+                    if (with_sum) {
+                        acc = _mm256_add_ps(acc, _mm256_loadu_ps(sum_src_ + dst_offset + c));
+                    }
+                    if (with_relu) {
+                        acc = _mm256_max_ps(acc, _mm256_setzero_ps());
+                    }
+                    if (with_relu6) {
+                        acc = _mm256_min_ps(acc, _mm256_set1_ps(6.0f));
+                    }
+                    _mm256_storeu_ps(dst_ + dst_offset + c, acc);
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_nhwc_depthwise_fp32_fma_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t channels  = param_.group;
+    const int64_t padded_ch = round_up(channels, CH_DT_BLK());
+    const int64_t kernel_hw = param_.kernel_h * param_.kernel_w;
+
+    cvt_bias_size_ = padded_ch;
+    cvt_bias_      = (float *)allocator_->Alloc(cvt_bias_size_ * sizeof(float));
+    if (cvt_bias_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    memcpy(cvt_bias_, bias, channels * sizeof(float));
+    memset(cvt_bias_ + channels, 0, (padded_ch - channels) * sizeof(float));
+
+    // filter: c, kh, kw -> kh, kw, c
+    cvt_filter_size_ = kernel_hw * padded_ch;
+    cvt_filter_      = (float *)allocator_->Alloc(cvt_filter_size_ * sizeof(float));
+    if (cvt_filter_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    memset(cvt_filter_, 0, cvt_filter_size_ * sizeof(float));
+    for (int64_t c = 0; c < channels; ++c) {
+        for (int64_t k = 0; k < kernel_hw; ++k) {
+            cvt_filter_[k * padded_ch + c] = filter[c * kernel_hw + k];
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+bool conv2d_nhwc_depthwise_fp32_fma_manager::is_supported()
+{
+    return param_.is_depthwise();
+}
+
+conv2d_fp32_executor *conv2d_nhwc_depthwise_fp32_fma_manager::gen_executor()
+{
+    return new conv2d_nhwc_depthwise_fp32_fma_executor(&param_, cvt_filter_, cvt_bias_);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -23,6 +23,7 @@
 #include "ppl/kernel/x86/common/avx_tools.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/avx512/conv2d_n16cx_direct_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/avx512/conv2d_n16cx_direct_kernel_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/common/avx512/conv2d_n16cx_post_op_fp32_avx512.h"
 #include "ppl/common/sys.h"
 
 #define ASSUME_L2_BYTES() (256 * 1024)
@@ -136,7 +137,7 @@ void conv2d_n16cx_direct_fp32_avx512_executor::cal_kernel_tunning_param()
     sp.oc_l2_blk = sp.oc_kr_blk <= 2 * CH_DT_BLK() ? 4 * CH_DT_BLK() : sp.oc_kr_blk;
 
     sp.use_nt_store = 0;
-    if (batch * cp.group * sp.padded_oc * dst_h * dst_w > l3_cap_all_core * 2) {
+    if (batch * cp.group * sp.padded_oc * dst_h * dst_w > l3_cap_all_core * 2 && !conv_fuse_flag::has_post_op(cp.fuse_flag)) {
         sp.use_nt_store = 1;
     }
 }
@@ -154,7 +155,7 @@ uint64_t conv2d_n16cx_direct_fp32_avx512_executor::cal_temp_buffer_size()
 
 ppl::common::RetCode conv2d_n16cx_direct_fp32_avx512_executor::prepare()
 {
-    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_shape_)) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -166,7 +167,7 @@ ppl::common::RetCode conv2d_n16cx_direct_fp32_avx512_executor::prepare()
 
 ppl::common::RetCode conv2d_n16cx_direct_fp32_avx512_executor::execute()
 {
-    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_) || !temp_buffer_) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -199,9 +200,12 @@ ppl::common::RetCode conv2d_n16cx_direct_fp32_avx512_executor::execute()
     const bool with_sum   = cp.fuse_flag & conv_fuse_flag::sum;
     const bool with_relu  = cp.fuse_flag & conv_fuse_flag::relu;
     const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::relu6;
+    const bool with_post_sum = cp.fuse_flag & conv_fuse_flag::post_sum;
+
+    const conv2d_n16cx_post_op_fp32_avx512 post_op(cp);
 
     int64_t sum_src_b_stride = 0;
-    if (with_sum) {
+    if (with_sum || with_post_sum) {
         sum_src_b_stride = int64_t(round_up(sum_src_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
     }
 
@@ -386,6 +390,10 @@ ppl::common::RetCode conv2d_n16cx_direct_fp32_avx512_executor::execute()
                                         PICK_PARAM(const float *, private_param, HIS_IDX()) += CH_DT_BLK();
                                         PICK_PARAM(float *, private_param, DST_IDX()) += CH_DT_BLK();
                                     }
+                                    if (is_last_ic && post_op.enabled()) {
+                                        const float *l_post = with_post_sum ? sum_src_ + (mbl3 + b) * sum_src_b_stride + (gpl3 + g) * dst_g_stride + oc * dst_h * dst_w + oh * dst_h_stride : nullptr;
+                                        post_op.execute(l_post, dst_ocb_stride, min<int64_t>(oc_eff, sp.oc_per_gp - oc), dst_w, dst_ocb_stride, l_dst);
+                                    }
                                     l_bias += sp.oc_kr_blk;
                                     l_flt  += sp.oc_kr_blk * sp.ic_l2_blk * cp.kernel_h * cp.kernel_w;
                                     l_dst  += sp.oc_kr_blk * dst_h * dst_w;
@@ -23,6 +23,7 @@
 #include "ppl/kernel/x86/common/avx_tools.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/fma/conv2d_n16cx_direct_v2_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct/fma/conv2d_n16cx_direct_v2_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/common/fma/conv2d_n16cx_post_op_fp32_fma.h"
 #include "ppl/common/sys.h"
 
 #define ASSUME_L2_BYTES() (256 * 1024)
@@ -144,7 +145,7 @@ void conv2d_n16cx_direct_v2_fp32_fma_executor::cal_kernel_tunning_param()
     sp.oc_l2_blk = min(OC_L2_BLK_MAX(), sp.padded_oc);
 
     sp.use_nt_store = 0;
-    if (batch * cp.group * sp.padded_oc * dst_h * dst_w > l3_cap_all_core * 2) {
+    if (batch * cp.group * sp.padded_oc * dst_h * dst_w > l3_cap_all_core * 2 && !conv_fuse_flag::has_post_op(cp.fuse_flag)) {
         sp.use_nt_store = 1;
     }
 }
@@ -162,7 +163,7 @@ uint64_t conv2d_n16cx_direct_v2_fp32_fma_executor::cal_temp_buffer_size()
 
 ppl::common::RetCode conv2d_n16cx_direct_v2_fp32_fma_executor::prepare()
 {
-    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_shape_)) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -174,7 +175,7 @@ ppl::common::RetCode conv2d_n16cx_direct_v2_fp32_fma_executor::prepare()
 
 ppl::common::RetCode conv2d_n16cx_direct_v2_fp32_fma_executor::execute()
 {
-    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_) || !temp_buffer_) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -201,14 +202,18 @@ ppl::common::RetCode conv2d_n16cx_direct_v2_fp32_fma_executor::execute()
     const int64_t dst_b_stride   = int64_t(round_up(dst_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
     const int64_t dst_g_stride   = int64_t(sp.padded_oc) * dst_h * dst_w;
     const int64_t dst_h_stride   = int64_t(dst_w) * CH_DT_BLK();
+    const int64_t dst_ocb_stride = int64_t(dst_h) * dst_w * CH_DT_BLK();
     const int64_t flt_g_stride   = int64_t(sp.ic_l2_cnt) * sp.padded_oc * cp.kernel_h * cp.kernel_w * sp.ic_l2_blk;
 
     const bool with_sum   = cp.fuse_flag & conv_fuse_flag::sum;
     const bool with_relu  = cp.fuse_flag & conv_fuse_flag::relu;
     const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::relu6;
+    const bool with_post_sum = cp.fuse_flag & conv_fuse_flag::post_sum;
+
+    const conv2d_n16cx_post_op_fp32_fma post_op(cp);
 
     int64_t sum_src_b_stride = 0;
-    if (with_sum) {
+    if (with_sum || with_post_sum) {
         sum_src_b_stride = int64_t(round_up(sum_src_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
     }
 
@@ -381,6 +386,10 @@ ppl::common::RetCode conv2d_n16cx_direct_v2_fp32_fma_executor::execute()
                                         PICK_PARAM(const float *, private_param, HIS_IDX()) += CH_DT_BLK();
                                         PICK_PARAM(float *, private_param, DST_IDX()) += CH_DT_BLK();
                                     }
+                                    if (is_last_ic && post_op.enabled()) {
+                                        const float *l_post = with_post_sum ? sum_src_ + (mbl3 + b) * sum_src_b_stride + (gpl3 + g) * dst_g_stride + oc * dst_h * dst_w + oh * dst_h_stride : nullptr;
+                                        post_op.execute(l_post, dst_ocb_stride, min<int64_t>(oc_eff, sp.oc_per_gp - oc), dst_w, dst_ocb_stride, l_dst);
+                                    }
                                     l_bias += CH_DT_BLK();
                                     l_flt  += CH_DT_BLK() * sp.ic_l2_blk * cp.kernel_h * cp.kernel_w;
                                     l_dst  += CH_DT_BLK() * dst_h * dst_w;
@@ -23,6 +23,7 @@
 #include "ppl/kernel/x86/common/avx_tools.h"
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/avx512/conv2d_n16cx_gemm_direct_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/avx512/conv2d_n16cx_gemm_direct_kernel_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/common/avx512/conv2d_n16cx_post_op_fp32_avx512.h"
 #include "ppl/common/sys.h"
 
 #define ASSUME_L2_BYTES() (256 * 1024)
@@ -124,7 +125,7 @@ void conv2d_n16cx_gemm_direct_fp32_avx512_executor::cal_kernel_tunning_param()
     }
 
     sp.use_nt_store = 0;
-    if (batch * cp.group * sp.padded_oc * dst_hw > l3_cap_all_core * 3) {
+    if (batch * cp.group * sp.padded_oc * dst_hw > l3_cap_all_core * 3 && !conv_fuse_flag::has_post_op(cp.fuse_flag)) {
         sp.use_nt_store = 1;
     }
 }
@@ -140,7 +141,7 @@ uint64_t conv2d_n16cx_gemm_direct_fp32_avx512_executor::cal_temp_buffer_size()
 
 ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_executor::prepare()
 {
-    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_shape_)) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -152,7 +153,7 @@ ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_executor::prepare()
 
 ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_executor::execute()
 {
-    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_) || !temp_buffer_) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -177,9 +178,12 @@ ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_executor::execute()
     const bool with_sum   = cp.fuse_flag & conv_fuse_flag::sum;
     const bool with_relu  = cp.fuse_flag & conv_fuse_flag::relu;
     const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::relu6;
+    const bool with_post_sum = cp.fuse_flag & conv_fuse_flag::post_sum;
+
+    const conv2d_n16cx_post_op_fp32_avx512 post_op(cp);
 
     int64_t sum_src_b_stride = 0;
-    if (with_sum) {
+    if (with_sum || with_post_sum) {
         sum_src_b_stride = int64_t(round_up(sum_src_shape_->GetDim(1), CH_DT_BLK())) * dst_hw;
     }
 
@@ -308,6 +312,10 @@ ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_executor::execute()
                                     }
                                     PICK_PARAM(const float *, private_param, FLT_IDX())  += sp.oc_kr_blk * sp.ic_l2_blk;
                                     PICK_PARAM(const float *, private_param, BIAS_IDX()) += sp.oc_kr_blk;
+                                    if (is_last_ic && post_op.enabled()) {
+                                        const float *l_post = with_post_sum ? sum_src_ + (mbl3 + b) * sum_src_b_stride + (gpl3 + g) * dst_g_stride + oc * dst_hw + hwl2 * CH_DT_BLK() : nullptr;
+                                        post_op.execute(l_post, dst_ocb_stride, min<int64_t>(oc_eff, sp.oc_per_gp - oc), hwl2_eff, dst_ocb_stride, l_dst);
+                                    }
                                     l_his += sp.oc_kr_blk * dst_hw;
                                     l_dst += sp.oc_kr_blk * dst_hw;
                                 }
@@ -328,6 +336,90 @@ ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_executor::execute()
     return ppl::common::RC_SUCCESS;
 }
 
+void conv2d_n16cx_gemm_direct_fp32_avx512_executor::execute_tile(
+    const float *src,
+    const int64_t src_icb_stride,
+    const int64_t hw_len,
+    const int64_t dst_ocb_stride,
+    float *dst) const
+{
+    const conv2d_fp32_param &cp     = *conv_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t flt_ocb_stride = int64_t(sp.ic_l2_blk) * CH_DT_BLK();
+
+    const bool with_relu  = cp.fuse_flag & conv_fuse_flag::relu;
+    const bool with_relu6 = cp.fuse_flag & conv_fuse_flag::relu6;
+
+    const conv2d_n16cx_post_op_fp32_avx512 post_op(cp);
+
+    int64_t share_param[SHAR_PARAM_LEN()];
+    int64_t private_param[PRIV_PARAM_LEN()];
+    share_param[SRC_ICB_STRIDE_IDX()] = src_icb_stride;
+    share_param[HIS_OCB_STRIDE_IDX()] = dst_ocb_stride;
+    share_param[DST_OCB_STRIDE_IDX()] = dst_ocb_stride;
+    share_param[FLT_OCB_STRIDE_IDX()] = flt_ocb_stride;
+    const int64_t nt_store_sel = 0;
+    for (int64_t hwl2 = 0; hwl2 < hw_len; hwl2 += sp.hw_l2_blk) {
+        const int64_t hwl2_eff = min<int64_t>(hw_len - hwl2, sp.hw_l2_blk);
+        const int64_t hw_body = round(hwl2_eff, sp.hw_kr_blk);
+        const int64_t hw_tail = hwl2_eff - hw_body;
+        for (int64_t icl2 = 0; icl2 < sp.padded_ic; icl2 += sp.ic_l2_blk) {
+            const int64_t icl2_eff = min<int64_t>(sp.ic_per_gp - icl2, sp.ic_l2_blk);
+            const bool is_first_ic = icl2 == 0;
+            const bool is_last_ic  = (icl2 + sp.ic_l2_blk >= sp.ic_per_gp);
+            uint64_t kernel_flags  = 0;
+            if (is_first_ic) {
+                kernel_flags |= KERNEL_FLAG_LD_BIAS();
+            }
+            if (is_last_ic) {
+                if (with_relu) {
+                    kernel_flags |= KERNEL_FLAG_RELU();
+                } else if (with_relu6) {
+                    kernel_flags |= KERNEL_FLAG_RELU6();
+                }
+            }
+            share_param[CHANNELS_IDX()] = icl2_eff;
+            PICK_PARAM(uint64_t, share_param, FLAGS_IDX()) = kernel_flags;
+
+            const float *l_src = src + icl2 / CH_DT_BLK() * src_icb_stride + hwl2 * CH_DT_BLK();
+            float *l_dst       = dst + hwl2 * CH_DT_BLK();
+            PICK_PARAM(const float *, private_param, FLT_IDX())  = cvt_filter_ + icl2 * sp.padded_oc;
+            PICK_PARAM(const float *, private_param, BIAS_IDX()) = cvt_bias_;
+            for (int64_t oc = 0; oc < sp.padded_oc; oc += sp.oc_kr_blk) {
+                const int64_t oc_eff = min<int64_t>(sp.padded_oc - oc, sp.oc_kr_blk);
+                const int64_t oc_sel = div_up(oc_eff, CH_DT_BLK()) - 1;
+                if (hw_body) {
+                    PICK_PARAM(const float *, private_param, SRC_IDX()) = l_src;
+                    PICK_PARAM(const float *, private_param, HIS_IDX()) = l_dst;
+                    PICK_PARAM(float *, private_param, DST_IDX())       = l_dst;
+                    private_param[HW_IDX()] = hw_body;
+                    switch (oc_sel) {
+                        case 0: conv2d_n16cx_gemm_direct_kernel_fp32_avx512_o16_table[nt_store_sel][sp.hw_kr_blk - 1](private_param, share_param); break;
+                        case 1: conv2d_n16cx_gemm_direct_kernel_fp32_avx512_o32_table[nt_store_sel][sp.hw_kr_blk - 1](private_param, share_param); break;
+                    }
+                }
+                if (hw_tail) {
+                    PICK_PARAM(const float *, private_param, SRC_IDX()) = l_src + hw_body * CH_DT_BLK();
+                    PICK_PARAM(const float *, private_param, HIS_IDX()) = l_dst + hw_body * CH_DT_BLK();
+                    PICK_PARAM(float *, private_param, DST_IDX())       = l_dst + hw_body * CH_DT_BLK();
+                    private_param[HW_IDX()] = hw_tail;
+                    switch (oc_sel) {
+                        case 0: conv2d_n16cx_gemm_direct_kernel_fp32_avx512_o16_table[nt_store_sel][hw_tail - 1](private_param, share_param); break;
+                        case 1: conv2d_n16cx_gemm_direct_kernel_fp32_avx512_o32_table[nt_store_sel][hw_tail - 1](private_param, share_param); break;
+                    }
+                }
+                PICK_PARAM(const float *, private_param, FLT_IDX())  += sp.oc_kr_blk * sp.ic_l2_blk;
+                PICK_PARAM(const float *, private_param, BIAS_IDX()) += sp.oc_kr_blk;
+                if (is_last_ic && post_op.enabled()) {
+                    post_op.execute(nullptr, 0, min<int64_t>(oc_eff, sp.oc_per_gp - oc), hwl2_eff, dst_ocb_stride, l_dst);
+                }
+                l_dst += (sp.oc_kr_blk / CH_DT_BLK()) * dst_ocb_stride;
+            }
+        }
+    }
+}
+
 ppl::common::RetCode conv2d_n16cx_gemm_direct_fp32_avx512_manager::gen_cvt_weights(const float *filter, const float *bias)
 {
     if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
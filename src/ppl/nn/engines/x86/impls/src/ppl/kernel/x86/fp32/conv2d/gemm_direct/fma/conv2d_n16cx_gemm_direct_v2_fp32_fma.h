@@ -35,6 +35,15 @@ public:
     ppl::common::RetCode prepare() override;
     ppl::common::RetCode execute() override;
 
+    // Compute a spatial tile of one image for all output channels without nt-store, for fused executors.
+    // Requires group == 1 and stride == 1. src/dst point to the first pixel of the tile.
+    void execute_tile(
+        const float *src,
+        const int64_t src_icb_stride,
+        const int64_t hw_len,
+        const int64_t dst_ocb_stride,
+        float *dst) const;
+
 private:
     struct kernel_schedule_param {
         // Preprocessed param
@@ -68,6 +77,10 @@ public:
     conv2d_n16cx_gemm_direct_v2_fp32_fma_manager() {}
     conv2d_n16cx_gemm_direct_v2_fp32_fma_manager(const conv2d_fp32_param &param, ppl::common::Allocator *allocator)
         : conv2d_fp32_manager(param, allocator) {}
+    bool is_fuse_supported(const conv_fuse_flag_t fuse_flag) const override
+    {
+        return true;
+    }
     bool is_supported() override;
     ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) override;
     conv2d_fp32_executor *gen_executor() override;
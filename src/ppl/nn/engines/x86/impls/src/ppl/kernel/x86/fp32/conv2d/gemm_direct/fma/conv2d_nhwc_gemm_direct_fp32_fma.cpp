@@ -0,0 +1,261 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_nhwc_gemm_direct_fp32_fma.h"
+
+#define OC_DT_BLK() 16
+#define OW_KR_BLK() 6
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// dst[m][0:oc_eff] = act(bias + sum_src[m] + sum over k, ic of src_list[k][m][ic] * flt[k][ic][0:16])
+template <int64_t m_len>
+static void conv2d_nhwc_gemm_direct_fp32_fma_blk(
+    const float **src_list,
+    const float *flt,
+    const float *bias,
+    const float *sum_src,
+    const int64_t kernel_hw,
+    const int64_t ic,
+    const int64_t dst_c_stride,
+    const int64_t oc_eff,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst)
+{
+    __m256 acc[m_len][2];
+    const __m256 b0 = _mm256_loadu_ps(bias);
+    const __m256 b1 = _mm256_loadu_ps(bias + 8);
+    for (int64_t m = 0; m < m_len; ++m) {
+        acc[m][0] = b0;
+        acc[m][1] = b1;
+    }
+
+    for (int64_t k = 0; k < kernel_hw; ++k) {
+        const float **k_src = src_list + k * m_len;
+        const float *k_flt  = flt + k * ic * OC_DT_BLK();
+        for (int64_t c = 0; c < ic; ++c) {
+            const __m256 w0 = _mm256_loadu_ps(k_flt + c * OC_DT_BLK());
+            const __m256 w1 = _mm256_loadu_ps(k_flt + c * OC_DT_BLK() + 8);
+            for (int64_t m = 0; m < m_len; ++m) {
+                const __m256 s = _mm256_set1_ps(k_src[m][c]);
+                acc[m][0]      = _mm256_fmadd_ps(s, w0, acc[m][0]);
+                acc[m][1]      = _mm256_fmadd_ps(s, w1, acc[m][1]);
+            }
+        }
+    }
+
+    const __m256i lane  = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i mask0 = _mm256_cmpgt_epi32(_mm256_set1_epi32(oc_eff), lane);
+    const __m256i mask1 = _mm256_cmpgt_epi32(_mm256_set1_epi32(oc_eff - 8), lane);
+    for (int64_t m = 0; m < m_len; ++m) {
+        if (fuse_flag & conv_fuse_flag::sum) {
+            acc[m][0] = _mm256_add_ps(acc[m][0], _mm256_maskload_ps(sum_src + m * dst_c_stride, mask0));
+            acc[m][1] = _mm256_add_ps(acc[m][1], _mm256_maskload_ps(sum_src + m * dst_c_stride + 8, mask1));
+        }
+        if (fuse_flag & (conv_fuse_flag::relu | conv_fuse_flag::relu6)) {
+            acc[m][0] = _mm256_max_ps(acc[m][0], _mm256_setzero_ps());
+            acc[m][1] = _mm256_max_ps(acc[m][1], _mm256_setzero_ps());
+        }
+        if (fuse_flag & conv_fuse_flag::relu6) {
+            acc[m][0] = _mm256_min_ps(acc[m][0], _mm256_set1_ps(6.0f));
+            acc[m][1] = _mm256_min_ps(acc[m][1], _mm256_set1_ps(6.0f));
+        }
+        if (oc_eff == OC_DT_BLK()) {
+            _mm256_storeu_ps(dst + m * dst_c_stride, acc[m][0]);
+            _mm256_storeu_ps(dst + m * dst_c_stride + 8, acc[m][1]);
+        } else {
+            _mm256_maskstore_ps(dst + m * dst_c_stride, mask0, acc[m][0]);
+            _mm256_maskstore_ps(dst + m * dst_c_stride + 8, mask1, acc[m][1]);
+        }
+    }
+}
+
+typedef void (*conv2d_nhwc_gemm_direct_fp32_fma_blk_func_t)(
+    const float **, const float *, const float *, const float *, const int64_t,
+    const int64_t, const int64_t, const int64_t, const conv_fuse_flag_t, float *);
+
+static const conv2d_nhwc_gemm_direct_fp32_fma_blk_func_t conv2d_nhwc_gemm_direct_fp32_fma_blk_table[OW_KR_BLK()] = {
+    conv2d_nhwc_gemm_direct_fp32_fma_blk<1>,
+    conv2d_nhwc_gemm_direct_fp32_fma_blk<2>,
+    conv2d_nhwc_gemm_direct_fp32_fma_blk<3>,
+    conv2d_nhwc_gemm_direct_fp32_fma_blk<4>,
+    conv2d_nhwc_gemm_direct_fp32_fma_blk<5>,
+    conv2d_nhwc_gemm_direct_fp32_fma_blk<6>,
+};
+
+void conv2d_nhwc_gemm_direct_fp32_fma_executor::init_preproc_param()
+{
+    schedule_param_.ic_per_gp        = conv_param_->channels / conv_param_->group;
+    schedule_param_.oc_per_gp        = conv_param_->num_output / conv_param_->group;
+    schedule_param_.padded_oc_per_gp = round_up(schedule_param_.oc_per_gp, OC_DT_BLK());
+}
+
+uint64_t conv2d_nhwc_gemm_direct_fp32_fma_executor::cal_temp_buffer_size()
+{
+    // a zero row to read padding pixels from and one list of source rows per thread
+    const int64_t kernel_hw         = conv_param_->kernel_h * conv_param_->kernel_w;
+    const uint64_t zero_row_size    = round_up(schedule_param_.ic_per_gp * sizeof(float), PPL_X86_CACHELINE_BYTES());
+    const uint64_t src_list_per_thr = round_up(kernel_hw * OW_KR_BLK() * sizeof(float *), PPL_X86_CACHELINE_BYTES());
+    return zero_row_size + src_list_per_thr * PPL_OMP_MAX_THREADS();
+}
+
+ppl::common::RetCode conv2d_nhwc_gemm_direct_fp32_fma_executor::prepare()
+{
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    init_preproc_param();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_nhwc_gemm_direct_fp32_fma_executor::execute()
+{
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const conv2d_fp32_param &cp     = *conv_param_;
+    const kernel_schedule_param &sp = schedule_param_;
+
+    const int64_t batch = src_shape_->GetDim(0);
+    const int64_t src_h = src_shape_->GetDim(2);
+    const int64_t src_w = src_shape_->GetDim(3);
+    const int64_t dst_h = dst_shape_->GetDim(2);
+    const int64_t dst_w = dst_shape_->GetDim(3);
+    // channels of nhwc tensors are padded, use the padded channels as pixel stride
+    const int64_t src_c = src_shape_->GetElementsIncludingPadding() / (batch * src_h * src_w);
+    const int64_t dst_c = dst_shape_->GetElementsIncludingPadding() / (batch * dst_h * dst_w);
+
+    const int64_t kernel_hw = cp.kernel_h * cp.kernel_w;
+    const int64_t oc_blks   = sp.padded_oc_per_gp / OC_DT_BLK();
+
+    float *zero_row = (float *)temp_buffer_;
+    memset(zero_row, 0, sp.ic_per_gp * sizeof(float));
+    const float **src_list_base = (const float **)((uint8_t *)temp_buffer_ + round_up(sp.ic_per_gp * sizeof(float), PPL_X86_CACHELINE_BYTES()));
+    const int64_t src_list_stride = round_up(kernel_hw * OW_KR_BLK() * sizeof(float *), PPL_X86_CACHELINE_BYTES()) / sizeof(float *);
+
+    const int64_t task_count = batch * dst_h * cp.group * oc_blks;
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < task_count; ++task) {
+        const int64_t ocb = task % oc_blks;
+        const int64_t g   = task / oc_blks % cp.group;
+        const int64_t oh  = task / oc_blks / cp.group % dst_h;
+        const int64_t b   = task / oc_blks / cp.group / dst_h;
+
+        const float **src_list = src_list_base + PPL_OMP_THREAD_ID() * src_list_stride;
+        const int64_t oc       = ocb * OC_DT_BLK();
+        const int64_t oc_eff   = min<int64_t>(sp.oc_per_gp - oc, OC_DT_BLK());
+        const float *flt       = cvt_filter_ + (g * oc_blks + ocb) * kernel_hw * sp.ic_per_gp * OC_DT_BLK();
+        const float *bias      = cvt_bias_ + g * sp.padded_oc_per_gp + oc;
+
+        const float *src_b = src_ + b * src_h * src_w * src_c + g * sp.ic_per_gp;
+        const int64_t dst_offset = ((b * dst_h + oh) * dst_w) * dst_c + g * sp.oc_per_gp + oc;
+        float *dst_row = dst_ + dst_offset;
+        const float *sum_src_row = (cp.fuse_flag & conv_fuse_flag::sum) ? sum_src_ + dst_offset : nullptr;
+
+        for (int64_t ow = 0; ow < dst_w; ow += OW_KR_BLK()) {
+            const int64_t ow_eff = min<int64_t>(dst_w - ow, OW_KR_BLK());
+            for (int64_t kh = 0; kh < cp.kernel_h; ++kh) {
+                const int64_t ih = oh * cp.stride_h - cp.pad_h + kh * cp.dilation_h;
+                for (int64_t kw = 0; kw < cp.kernel_w; ++kw) {
+                    const float **k_src = src_list + (kh * cp.kernel_w + kw) * ow_eff;
+                    for (int64_t m = 0; m < ow_eff; ++m) {
+                        const int64_t iw = (ow + m) * cp.stride_w - cp.pad_w + kw * cp.dilation_w;
+                        if (ih >= 0 && ih < src_h && iw >= 0 && iw < src_w) {
+                            k_src[m] = src_b + (ih * src_w + iw) * src_c;
+                        } else {
+                            k_src[m] = zero_row;
+                        }
+                    }
+                }
+            }
+            conv2d_nhwc_gemm_direct_fp32_fma_blk_table[ow_eff - 1](
+                src_list,
+                flt,
+                bias,
+                sum_src_row ? sum_src_row + ow * dst_c : nullptr,
+                kernel_hw,
+                sp.ic_per_gp,
+                dst_c,
+                oc_eff,
+                cp.fuse_flag,
+                dst_row + ow * dst_c);
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode conv2d_nhwc_gemm_direct_fp32_fma_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_bias_ != nullptr || cvt_filter_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t ic_per_gp        = param_.channels / param_.group;
+    const int64_t oc_per_gp        = param_.num_output / param_.group;
+    const int64_t padded_oc_per_gp = round_up(oc_per_gp, OC_DT_BLK());
+    const int64_t kernel_hw        = param_.kernel_h * param_.kernel_w;
+
+    cvt_bias_size_ = param_.group * padded_oc_per_gp;
+    cvt_bias_      = (float *)allocator_->Alloc(cvt_bias_size_ * sizeof(float));
+    if (cvt_bias_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    memset(cvt_bias_, 0, cvt_bias_size_ * sizeof(float));
+    for (int64_t g = 0; g < param_.group; ++g) {
+        memcpy(cvt_bias_ + g * padded_oc_per_gp, bias + g * oc_per_gp, oc_per_gp * sizeof(float));
+    }
+
+    // filter: g, oc, ic, kh, kw -> g, oc/16, kh, kw, ic, 16oc
+    cvt_filter_size_ = param_.group * padded_oc_per_gp * kernel_hw * ic_per_gp;
+    cvt_filter_      = (float *)allocator_->Alloc(cvt_filter_size_ * sizeof(float));
+    if (cvt_filter_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    memset(cvt_filter_, 0, cvt_filter_size_ * sizeof(float));
+    for (int64_t g = 0; g < param_.group; ++g) {
+        for (int64_t oc = 0; oc < oc_per_gp; ++oc) {
+            float *l_cvt_flt = cvt_filter_ + (g * padded_oc_per_gp + oc / OC_DT_BLK() * OC_DT_BLK()) * kernel_hw * ic_per_gp + oc % OC_DT_BLK();
+            const float *l_flt = filter + (g * oc_per_gp + oc) * ic_per_gp * kernel_hw;
+            for (int64_t ic = 0; ic < ic_per_gp; ++ic) {
+                for (int64_t k = 0; k < kernel_hw; ++k) {
+                    l_cvt_flt[(k * ic_per_gp + ic) * OC_DT_BLK()] = l_flt[ic * kernel_hw + k];
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+bool conv2d_nhwc_gemm_direct_fp32_fma_manager::is_supported()
+{
+    return true;
+}
+
+conv2d_fp32_executor *conv2d_nhwc_gemm_direct_fp32_fma_manager::gen_executor()
+{
+    return new conv2d_nhwc_gemm_direct_fp32_fma_executor(&param_, cvt_filter_, cvt_bias_);
+}
+
+}}}; // namespace ppl::kernel::x86
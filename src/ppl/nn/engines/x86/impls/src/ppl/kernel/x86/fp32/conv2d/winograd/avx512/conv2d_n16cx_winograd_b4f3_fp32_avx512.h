@@ -105,6 +105,10 @@ public:
     conv2d_n16cx_winograd_b4f3_fp32_avx512_manager() {}
     conv2d_n16cx_winograd_b4f3_fp32_avx512_manager(const conv2d_fp32_param &param, ppl::common::Allocator *allocator)
         : conv2d_fp32_manager(param, allocator) {}
+    bool is_fuse_supported(const conv_fuse_flag_t fuse_flag) const override
+    {
+        return true;
+    }
     bool is_supported() override;
     ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) override;
     conv2d_fp32_executor *gen_executor() override;
@@ -21,6 +21,7 @@
 
 #include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b4f3_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/common/fma/conv2d_n16cx_post_op_fp32_fma.h"
 #include "ppl/kernel/x86/common/avx_tools.h"
 #include "ppl/common/sys.h"
 
@@ -227,7 +228,7 @@ void conv2d_n16cx_winograd_b4f3_fp32_fma_executor::init_preproc_param()
 
     sp.use_nt_store = 0;
     const int64_t dst_element_num = batch * cp.group * sp.padded_oc * dst_shape_->GetDim(2) * dst_shape_->GetDim(3);
-    if (dst_element_num + sp.gemm_out_len > l3_cap_all_core * 2) {
+    if (dst_element_num + sp.gemm_out_len > l3_cap_all_core * 2 && !conv_fuse_flag::has_post_op(cp.fuse_flag)) {
         sp.use_nt_store = 1;
     }
 }
@@ -248,7 +249,7 @@ uint64_t conv2d_n16cx_winograd_b4f3_fp32_fma_executor::cal_temp_buffer_size()
 
 ppl::common::RetCode conv2d_n16cx_winograd_b4f3_fp32_fma_executor::prepare()
 {
-    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+    if (!conv_param_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_shape_)) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -747,7 +748,7 @@ void winograd_b4f3_store_dst_fp32_fma(
 
 ppl::common::RetCode conv2d_n16cx_winograd_b4f3_fp32_fma_executor::execute()
 {
-    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
+    if (!conv_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) && !sum_src_) || !temp_buffer_) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -769,9 +770,11 @@ ppl::common::RetCode conv2d_n16cx_winograd_b4f3_fp32_fma_executor::execute()
     const int64_t bias_g_stride    = sp.padded_oc;
     const int64_t cvt_flt_g_stride = sp.padded_ic * sp.padded_oc * TILE_IN_H() * TILE_IN_W();
     int64_t sum_src_b_stride       = 0;
-    if (conv_param_->fuse_flag & conv_fuse_flag::sum) {
+    if (conv_param_->fuse_flag & (conv_fuse_flag::sum | conv_fuse_flag::post_sum)) {
         sum_src_b_stride = int64_t(round_up(sum_src_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
     }
+    const bool with_post_sum = cp.fuse_flag & conv_fuse_flag::post_sum;
+    const conv2d_n16cx_post_op_fp32_fma post_op(cp);
 
     // cvt_flt:   [group, ic_l2_cnt, 6h, 6w, oc/16o, icl2_eff, 16o]
     // src_trans: [6h, 6w, tile_l2_blk/6t, icl2_eff/16o, tile_kr_eff, 16i]
@@ -955,6 +958,14 @@ ppl::common::RetCode conv2d_n16cx_winograd_b4f3_fp32_fma_executor::execute()
                                                         cp.fuse_flag, l_dst);
                                                 }
                                             }
+                                            if (post_op.enabled()) {
+                                                for (int64_t h = 0; h < oh_len; ++h) {
+                                                    post_op.execute(
+                                                        with_post_sum ? l_sum_src + h * dst_w * CH_DT_BLK() : nullptr, 0,
+                                                        min<int64_t>(sp.oc_per_gp - ocb, CH_DT_BLK()), ow_len, 0,
+                                                        l_dst + h * dst_w * CH_DT_BLK());
+                                                }
+                                            }
                                         }
                                     }
                             }
@@ -1161,6 +1172,14 @@ ppl::common::RetCode conv2d_n16cx_winograd_b4f3_fp32_fma_executor::execute()
                                                 cp.fuse_flag, l_dst);
                                         }
                                     }
+                                    if (post_op.enabled()) {
+                                        for (int64_t h = 0; h < oh_len; ++h) {
+                                            post_op.execute(
+                                                with_post_sum ? l_sum_src + h * dst_w * CH_DT_BLK() : nullptr, 0,
+                                                min<int64_t>(sp.oc_per_gp - ocb, CH_DT_BLK()), ow_len, 0,
+                                                l_dst + h * dst_w * CH_DT_BLK());
+                                        }
+                                    }
 #ifdef PPL_X86_KERNEL_TIMING
                                     profiler_.toc(DSTTR_TIMER());
 #endif
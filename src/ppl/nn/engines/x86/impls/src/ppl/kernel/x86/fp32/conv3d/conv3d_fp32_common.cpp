@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <new>
+
+#include "ppl/kernel/x86/fp32/conv3d.h"
+
+#include "ppl/kernel/x86/fp32/conv3d/direct/fma/conv3d_n16cx_direct_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv3d/direct/avx512/conv3d_n16cx_direct_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv3d/gemm_direct/conv3d_n16cx_gemm_direct_fp32.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+conv3d_fp32_algo_info conv3d_algo_selector::select_algo(const ppl::common::dataformat_t src_format, const conv3d_fp32_param &param, const ppl::common::isa_t isa_flags)
+{
+    static conv3d_fp32_algo_info unknown_info = {
+        .algo_type     = conv3d_fp32_algo::unknown,
+        .isa           = ppl::common::ISA_undef,
+        .input_format  = ppl::common::DATAFORMAT_UNKNOWN,
+        .output_format = ppl::common::DATAFORMAT_UNKNOWN};
+
+    ppl::common::isa_t isa;
+    if (isa_flags & ppl::common::ISA_X86_AVX512) {
+        isa = ppl::common::ISA_X86_AVX512;
+    } else if (isa_flags & ppl::common::ISA_X86_FMA) {
+        isa = ppl::common::ISA_X86_FMA;
+    } else {
+        return unknown_info;
+    }
+
+    if (param.is_pointwise()) {
+        auto gd_mgr = new conv3d_n16cx_gemm_direct_fp32_manager(param, isa, nullptr);
+        bool supported = gd_mgr->is_supported();
+        delete gd_mgr;
+        if (supported) {
+            return (conv3d_fp32_algo_info){
+                .algo_type     = conv3d_fp32_algo::gemm_direct,
+                .isa           = isa,
+                .input_format  = ppl::common::DATAFORMAT_N16CX,
+                .output_format = ppl::common::DATAFORMAT_N16CX};
+        }
+    }
+
+    conv3d_fp32_manager *direct_mgr;
+    if (isa == ppl::common::ISA_X86_AVX512) {
+        direct_mgr = new conv3d_n16cx_direct_fp32_avx512_manager(param, nullptr);
+    } else {
+        direct_mgr = new conv3d_n16cx_direct_fp32_fma_manager(param, nullptr);
+    }
+    bool supported = direct_mgr->is_supported();
+    delete direct_mgr;
+    if (supported) {
+        return (conv3d_fp32_algo_info){
+            .algo_type     = conv3d_fp32_algo::direct,
+            .isa           = isa,
+            .input_format  = ppl::common::DATAFORMAT_N16CX,
+            .output_format = ppl::common::DATAFORMAT_N16CX};
+    }
+
+    return unknown_info;
+}
+
+conv3d_fp32_manager *conv3d_algo_selector::gen_algo(const conv3d_fp32_param &param, const conv3d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator)
+{
+    conv3d_fp32_manager *conv_mgr = nullptr;
+    if (algo_info.input_format != ppl::common::DATAFORMAT_N16CX ||
+        algo_info.output_format != ppl::common::DATAFORMAT_N16CX) {
+        return conv_mgr;
+    }
+
+    if (algo_info.algo_type == conv3d_fp32_algo::gemm_direct &&
+        (algo_info.isa == ppl::common::ISA_X86_FMA || algo_info.isa == ppl::common::ISA_X86_AVX512)) {
+        conv_mgr = new conv3d_n16cx_gemm_direct_fp32_manager(param, algo_info.isa, allocator);
+    }
+    if (algo_info.algo_type == conv3d_fp32_algo::direct &&
+        algo_info.isa == ppl::common::ISA_X86_FMA) {
+        conv_mgr = new conv3d_n16cx_direct_fp32_fma_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv3d_fp32_algo::direct &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512) {
+        conv_mgr = new conv3d_n16cx_direct_fp32_avx512_manager(param, allocator);
+    }
+
+    return conv_mgr;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "ppl/kernel/x86/fp32/conv3d/gemm_direct/conv3d_n16cx_gemm_direct_fp32.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline void reshape_as_conv2d(const ppl::nn::TensorShape &shape_3d, ppl::nn::TensorShape *shape_2d)
+{
+    *shape_2d = shape_3d;
+    shape_2d->Reshape({shape_3d.GetDim(0), shape_3d.GetDim(1), shape_3d.GetDim(2) * shape_3d.GetDim(3), shape_3d.GetDim(4)});
+}
+
+uint64_t conv3d_n16cx_gemm_direct_fp32_executor::cal_temp_buffer_size()
+{
+    return conv2d_executor_->cal_temp_buffer_size();
+}
+
+ppl::common::RetCode conv3d_n16cx_gemm_direct_fp32_executor::prepare()
+{
+    if (!conv_param_ || !conv2d_executor_ || !src_shape_ || !dst_shape_ || ((conv_param_->fuse_flag & conv_fuse_flag::sum) && !sum_src_shape_)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    reshape_as_conv2d(*src_shape_, &src_shape_2d_);
+    reshape_as_conv2d(*dst_shape_, &dst_shape_2d_);
+    conv2d_executor_->set_src_shape(&src_shape_2d_);
+    conv2d_executor_->set_dst_shape(&dst_shape_2d_);
+    if (conv_param_->fuse_flag & conv_fuse_flag::sum) {
+        reshape_as_conv2d(*sum_src_shape_, &sum_src_shape_2d_);
+        conv2d_executor_->set_sum_src_shape(&sum_src_shape_2d_);
+    }
+
+    return conv2d_executor_->prepare();
+}
+
+ppl::common::RetCode conv3d_n16cx_gemm_direct_fp32_executor::execute()
+{
+    if (!conv2d_executor_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    conv2d_executor_->set_src(src_);
+    conv2d_executor_->set_dst(dst_);
+    conv2d_executor_->set_sum_src(sum_src_);
+    conv2d_executor_->set_temp_buffer(temp_buffer_);
+
+    return conv2d_executor_->execute();
+}
+
+conv2d_fp32_param conv3d_n16cx_gemm_direct_fp32_manager::to_conv2d_param(const conv3d_fp32_param &param)
+{
+    conv2d_fp32_param param_2d;
+    param_2d.kernel_h   = 1;
+    param_2d.kernel_w   = 1;
+    param_2d.stride_h   = 1;
+    param_2d.stride_w   = 1;
+    param_2d.dilation_h = 1;
+    param_2d.dilation_w = 1;
+    param_2d.pad_h      = 0;
+    param_2d.pad_w      = 0;
+    param_2d.channels   = param.channels;
+    param_2d.num_output = param.num_output;
+    param_2d.group      = param.group;
+    param_2d.fuse_flag  = param.fuse_flag;
+    param_2d.fuse_param = {0.0f, 0.0f, 0.0f};
+    return param_2d;
+}
+
+conv3d_n16cx_gemm_direct_fp32_manager::conv3d_n16cx_gemm_direct_fp32_manager(
+    const conv3d_fp32_param &param,
+    const ppl::common::isa_t isa,
+    ppl::common::Allocator *allocator)
+    : conv3d_fp32_manager(param, allocator)
+    , conv2d_manager_(nullptr)
+{
+    conv2d_fp32_algo_info algo_info;
+    algo_info.algo_type     = (isa & ppl::common::ISA_X86_AVX512) ? conv2d_fp32_algo::gemm_direct : conv2d_fp32_algo::gemm_direct_v2;
+    algo_info.isa           = (isa & ppl::common::ISA_X86_AVX512) ? ppl::common::ISA_X86_AVX512 : ppl::common::ISA_X86_FMA;
+    algo_info.input_format  = ppl::common::DATAFORMAT_N16CX;
+    algo_info.output_format = ppl::common::DATAFORMAT_N16CX;
+
+    conv2d_manager_ = conv2d_algo_selector::gen_algo(to_conv2d_param(param), algo_info, allocator);
+}
+
+void conv3d_n16cx_gemm_direct_fp32_manager::set_param(const conv3d_fp32_param &param)
+{
+    param_ = param;
+    if (conv2d_manager_) {
+        conv2d_manager_->set_param(to_conv2d_param(param));
+    }
+}
+
+void conv3d_n16cx_gemm_direct_fp32_manager::release_cvt_weights()
+{
+    if (conv2d_manager_) {
+        conv2d_manager_->release_cvt_weights();
+    }
+    cvt_filter_ = nullptr;
+    cvt_bias_   = nullptr;
+}
+
+bool conv3d_n16cx_gemm_direct_fp32_manager::is_supported()
+{
+    return param_.is_pointwise() && conv2d_manager_ && conv2d_manager_->is_supported();
+}
+
+ppl::common::RetCode conv3d_n16cx_gemm_direct_fp32_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (!conv2d_manager_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    auto rc = conv2d_manager_->gen_cvt_weights(filter, bias);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    cvt_filter_      = const_cast<float *>(conv2d_manager_->cvt_filter());
+    cvt_filter_size_ = conv2d_manager_->cvt_filter_size();
+    cvt_bias_        = const_cast<float *>(conv2d_manager_->cvt_bias());
+    cvt_bias_size_   = conv2d_manager_->cvt_bias_size();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+conv3d_fp32_executor *conv3d_n16cx_gemm_direct_fp32_manager::gen_executor()
+{
+    if (!conv2d_manager_) {
+        return nullptr;
+    }
+    return new conv3d_n16cx_gemm_direct_fp32_executor(&param_, conv2d_manager_->gen_executor());
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef __ST_PPL_KERNEL_X86_FP32_CONV3D_GEMM_DIRECT_CONV3D_N16CX_GEMM_DIRECT_FP32_H_
+#define __ST_PPL_KERNEL_X86_FP32_CONV3D_GEMM_DIRECT_CONV3D_N16CX_GEMM_DIRECT_FP32_H_
+
+#include "ppl/kernel/x86/fp32/conv3d.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// Pointwise conv3d is a pointwise conv2d on a [N, C, D * H, W] view of the
+// same N16CX tensor, so it runs the conv2d gemm_direct kernels of the given isa.
+class conv3d_n16cx_gemm_direct_fp32_executor final : public conv3d_fp32_executor {
+public:
+    conv3d_n16cx_gemm_direct_fp32_executor(const conv3d_fp32_param *conv_param, conv2d_fp32_executor *conv2d_executor)
+        : conv3d_fp32_executor(conv_param, nullptr, nullptr)
+        , conv2d_executor_(conv2d_executor) {}
+    ~conv3d_n16cx_gemm_direct_fp32_executor()
+    {
+        if (conv2d_executor_) {
+            delete conv2d_executor_;
+        }
+    }
+    uint64_t cal_temp_buffer_size() override;
+    ppl::common::RetCode prepare() override;
+    ppl::common::RetCode execute() override;
+
+private:
+    conv2d_fp32_executor *conv2d_executor_;
+    ppl::nn::TensorShape src_shape_2d_;
+    ppl::nn::TensorShape dst_shape_2d_;
+    ppl::nn::TensorShape sum_src_shape_2d_;
+};
+
+class conv3d_n16cx_gemm_direct_fp32_manager final : public conv3d_fp32_manager {
+public:
+    conv3d_n16cx_gemm_direct_fp32_manager(const conv3d_fp32_param &param, const ppl::common::isa_t isa, ppl::common::Allocator *allocator);
+    ~conv3d_n16cx_gemm_direct_fp32_manager()
+    {
+        if (conv2d_manager_) {
+            delete conv2d_manager_;
+        }
+    }
+    void set_param(const conv3d_fp32_param &param) override;
+    void release_cvt_weights() override;
+    bool is_supported() override;
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias) override;
+    conv3d_fp32_executor *gen_executor() override;
+
+private:
+    static conv2d_fp32_param to_conv2d_param(const conv3d_fp32_param &param);
+
+    conv2d_fp32_manager *conv2d_manager_;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,277 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/conv_transpose.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+#define CH_DT_BLK() 16
+#define MAX_IW_BLK() 14
+
+// dst[j * dst_ow_stride] += sum(src[j][ic] * flt[ic]) for j in [0, w_len), one 16-channel output block
+template <int64_t w_len>
+static void conv_transpose_n16cx_direct_kernel_fp32_avx512(
+    const float *src,
+    const float *flt,
+    const int64_t ic_start,
+    const int64_t ic_len,
+    const int64_t src_icb_stride,
+    const int64_t dst_ow_stride,
+    float *dst)
+{
+    __m512 zmm00, zmm01, zmm02, zmm03;
+    __m512 zmm04, zmm05, zmm06, zmm07;
+    __m512 zmm08, zmm09, zmm10, zmm11;
+    __m512 zmm12, zmm13, zmm14, zmm15;
+
+    if (w_len > 0) zmm00 = _mm512_loadu_ps(dst + 0 * dst_ow_stride + 0);
+    if (w_len > 1) zmm01 = _mm512_loadu_ps(dst + 1 * dst_ow_stride + 0);
+    if (w_len > 2) zmm02 = _mm512_loadu_ps(dst + 2 * dst_ow_stride + 0);
+    if (w_len > 3) zmm03 = _mm512_loadu_ps(dst + 3 * dst_ow_stride + 0);
+    if (w_len > 4) zmm04 = _mm512_loadu_ps(dst + 4 * dst_ow_stride + 0);
+    if (w_len > 5) zmm05 = _mm512_loadu_ps(dst + 5 * dst_ow_stride + 0);
+    if (w_len > 6) zmm06 = _mm512_loadu_ps(dst + 6 * dst_ow_stride + 0);
+    if (w_len > 7) zmm07 = _mm512_loadu_ps(dst + 7 * dst_ow_stride + 0);
+    if (w_len > 8) zmm08 = _mm512_loadu_ps(dst + 8 * dst_ow_stride + 0);
+    if (w_len > 9) zmm09 = _mm512_loadu_ps(dst + 9 * dst_ow_stride + 0);
+    if (w_len > 10) zmm10 = _mm512_loadu_ps(dst + 10 * dst_ow_stride + 0);
+    if (w_len > 11) zmm11 = _mm512_loadu_ps(dst + 11 * dst_ow_stride + 0);
+    if (w_len > 12) zmm12 = _mm512_loadu_ps(dst + 12 * dst_ow_stride + 0);
+    if (w_len > 13) zmm13 = _mm512_loadu_ps(dst + 13 * dst_ow_stride + 0);
+
+    for (int64_t ic = 0; ic < ic_len; ++ic) {
+        const int64_t c   = ic_start + ic;
+        const float *l_src = src + (c / CH_DT_BLK()) * src_icb_stride + c % CH_DT_BLK();
+        zmm14 = _mm512_loadu_ps(flt + ic * CH_DT_BLK() + 0);
+        if (w_len > 0) {
+            zmm15 = _mm512_set1_ps(l_src[0 * CH_DT_BLK()]);
+            zmm00 = _mm512_fmadd_ps(zmm14, zmm15, zmm00);
+        }
+        if (w_len > 1) {
+            zmm15 = _mm512_set1_ps(l_src[1 * CH_DT_BLK()]);
+            zmm01 = _mm512_fmadd_ps(zmm14, zmm15, zmm01);
+        }
+        if (w_len > 2) {
+            zmm15 = _mm512_set1_ps(l_src[2 * CH_DT_BLK()]);
+            zmm02 = _mm512_fmadd_ps(zmm14, zmm15, zmm02);
+        }
+        if (w_len > 3) {
+            zmm15 = _mm512_set1_ps(l_src[3 * CH_DT_BLK()]);
+            zmm03 = _mm512_fmadd_ps(zmm14, zmm15, zmm03);
+        }
+        if (w_len > 4) {
+            zmm15 = _mm512_set1_ps(l_src[4 * CH_DT_BLK()]);
+            zmm04 = _mm512_fmadd_ps(zmm14, zmm15, zmm04);
+        }
+        if (w_len > 5) {
+            zmm15 = _mm512_set1_ps(l_src[5 * CH_DT_BLK()]);
+            zmm05 = _mm512_fmadd_ps(zmm14, zmm15, zmm05);
+        }
+        if (w_len > 6) {
+            zmm15 = _mm512_set1_ps(l_src[6 * CH_DT_BLK()]);
+            zmm06 = _mm512_fmadd_ps(zmm14, zmm15, zmm06);
+        }
+        if (w_len > 7) {
+            zmm15 = _mm512_set1_ps(l_src[7 * CH_DT_BLK()]);
+            zmm07 = _mm512_fmadd_ps(zmm14, zmm15, zmm07);
+        }
+        if (w_len > 8) {
+            zmm15 = _mm512_set1_ps(l_src[8 * CH_DT_BLK()]);
+            zmm08 = _mm512_fmadd_ps(zmm14, zmm15, zmm08);
+        }
+        if (w_len > 9) {
+            zmm15 = _mm512_set1_ps(l_src[9 * CH_DT_BLK()]);
+            zmm09 = _mm512_fmadd_ps(zmm14, zmm15, zmm09);
+        }
+        if (w_len > 10) {
+            zmm15 = _mm512_set1_ps(l_src[10 * CH_DT_BLK()]);
+            zmm10 = _mm512_fmadd_ps(zmm14, zmm15, zmm10);
+        }
+        if (w_len > 11) {
+            zmm15 = _mm512_set1_ps(l_src[11 * CH_DT_BLK()]);
+            zmm11 = _mm512_fmadd_ps(zmm14, zmm15, zmm11);
+        }
+        if (w_len > 12) {
+            zmm15 = _mm512_set1_ps(l_src[12 * CH_DT_BLK()]);
+            zmm12 = _mm512_fmadd_ps(zmm14, zmm15, zmm12);
+        }
+        if (w_len > 13) {
+            zmm15 = _mm512_set1_ps(l_src[13 * CH_DT_BLK()]);
+            zmm13 = _mm512_fmadd_ps(zmm14, zmm15, zmm13);
+        }
+    }
+
+    if (w_len > 0) _mm512_storeu_ps(dst + 0 * dst_ow_stride + 0, zmm00);
+    if (w_len > 1) _mm512_storeu_ps(dst + 1 * dst_ow_stride + 0, zmm01);
+    if (w_len > 2) _mm512_storeu_ps(dst + 2 * dst_ow_stride + 0, zmm02);
+    if (w_len > 3) _mm512_storeu_ps(dst + 3 * dst_ow_stride + 0, zmm03);
+    if (w_len > 4) _mm512_storeu_ps(dst + 4 * dst_ow_stride + 0, zmm04);
+    if (w_len > 5) _mm512_storeu_ps(dst + 5 * dst_ow_stride + 0, zmm05);
+    if (w_len > 6) _mm512_storeu_ps(dst + 6 * dst_ow_stride + 0, zmm06);
+    if (w_len > 7) _mm512_storeu_ps(dst + 7 * dst_ow_stride + 0, zmm07);
+    if (w_len > 8) _mm512_storeu_ps(dst + 8 * dst_ow_stride + 0, zmm08);
+    if (w_len > 9) _mm512_storeu_ps(dst + 9 * dst_ow_stride + 0, zmm09);
+    if (w_len > 10) _mm512_storeu_ps(dst + 10 * dst_ow_stride + 0, zmm10);
+    if (w_len > 11) _mm512_storeu_ps(dst + 11 * dst_ow_stride + 0, zmm11);
+    if (w_len > 12) _mm512_storeu_ps(dst + 12 * dst_ow_stride + 0, zmm12);
+    if (w_len > 13) _mm512_storeu_ps(dst + 13 * dst_ow_stride + 0, zmm13);
+}
+
+typedef void (*conv_transpose_n16cx_direct_kernel_fp32_avx512_func_t)(const float *, const float *, const int64_t, const int64_t, const int64_t, const int64_t, float *);
+static const conv_transpose_n16cx_direct_kernel_fp32_avx512_func_t conv_transpose_n16cx_direct_kernel_fp32_avx512_table[MAX_IW_BLK() + 1]{
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<0>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<1>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<2>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<3>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<4>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<5>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<6>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<7>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<8>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<9>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<10>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<11>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<12>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<13>,
+    conv_transpose_n16cx_direct_kernel_fp32_avx512<14>,
+};
+
+ppl::common::RetCode conv_transpose_n16cx_direct_fp32_avx512(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const float *sum_src,
+    const float *packed_filter,
+    const float *bias,
+    const int32_t group,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t hole_h,
+    const int32_t hole_w,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst)
+{
+    const int64_t batch      = src_shape->GetDim(0);
+    const int64_t channels   = src_shape->GetDim(1);
+    const int64_t src_h      = src_shape->GetDim(2);
+    const int64_t src_w      = src_shape->GetDim(3);
+    const int64_t num_output = dst_shape->GetDim(1);
+    const int64_t dst_h      = dst_shape->GetDim(2);
+    const int64_t dst_w      = dst_shape->GetDim(3);
+
+    if (!conv_transpose_n16cx_is_supported_fp32(channels, num_output, group)) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t ic_per_gp  = channels / group;
+    const int64_t oc_per_gp  = num_output / group;
+    const int64_t padded_ic  = round_up(channels, CH_DT_BLK());
+    const int64_t padded_oc  = round_up(num_output, CH_DT_BLK());
+    const int64_t num_ocb    = padded_oc / CH_DT_BLK();
+    const int64_t src_icb_stride = src_h * src_w * CH_DT_BLK();
+    const int64_t dst_ow_stride  = stride_w * CH_DT_BLK();
+    const int64_t flt_ocb_stride = int64_t(kernel_h) * kernel_w * ic_per_gp * CH_DT_BLK();
+
+    const bool with_sum   = (fuse_flag & conv_fuse_flag::sum) && sum_src != nullptr;
+    const bool with_relu  = fuse_flag & (conv_fuse_flag::relu | conv_fuse_flag::relu6);
+    const bool with_relu6 = fuse_flag & conv_fuse_flag::relu6;
+
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(3)
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t ocb = 0; ocb < num_ocb; ++ocb) {
+            for (int64_t oh = 0; oh < dst_h; ++oh) {
+                const int64_t g        = ocb * CH_DT_BLK() / oc_per_gp;
+                const int64_t ic_start = g * ic_per_gp;
+                const int64_t dst_row_offset = ((b * num_ocb + ocb) * dst_h + oh) * dst_w * CH_DT_BLK();
+                float *l_dst = dst + dst_row_offset;
+
+                float bias_blk[CH_DT_BLK()];
+                for (int64_t i = 0; i < CH_DT_BLK(); ++i) {
+                    const int64_t oc = ocb * CH_DT_BLK() + i;
+                    bias_blk[i] = (bias != nullptr && oc < num_output) ? bias[oc] : 0.0f;
+                }
+                if (with_sum) {
+                    const float *l_sum = sum_src + dst_row_offset;
+                    for (int64_t ow = 0; ow < dst_w; ++ow) {
+                        for (int64_t i = 0; i < CH_DT_BLK(); ++i) {
+                            l_dst[ow * CH_DT_BLK() + i] = l_sum[ow * CH_DT_BLK() + i] + bias_blk[i];
+                        }
+                    }
+                } else {
+                    for (int64_t ow = 0; ow < dst_w; ++ow) {
+                        memcpy(l_dst + ow * CH_DT_BLK(), bias_blk, CH_DT_BLK() * sizeof(float));
+                    }
+                }
+
+                const float *l_src_b = src + b * padded_ic * src_h * src_w;
+                for (int64_t kh = 0; kh < kernel_h; ++kh) {
+                    const int64_t ih_stride = oh + pad_h - kh * hole_h;
+                    if (ih_stride < 0 || ih_stride % stride_h != 0) {
+                        continue;
+                    }
+                    const int64_t ih = ih_stride / stride_h;
+                    if (ih >= src_h) {
+                        continue;
+                    }
+                    for (int64_t kw = 0; kw < kernel_w; ++kw) {
+                        // ow = iw * stride_w - pad_w + kw * hole_w must fall in [0, dst_w)
+                        const int64_t ow_offset = kw * hole_w - pad_w;
+                        const int64_t iw_start  = max<int64_t>(div_up(max<int64_t>(-ow_offset, 0), stride_w), 0);
+                        const int64_t iw_end    = min<int64_t>(dst_w - ow_offset > 0 ? div_up(dst_w - ow_offset, stride_w) : 0, src_w);
+                        const float *l_flt = packed_filter + ocb * flt_ocb_stride + (kh * kernel_w + kw) * ic_per_gp * CH_DT_BLK();
+                        for (int64_t iw = iw_start; iw < iw_end; iw += MAX_IW_BLK()) {
+                            const int64_t iw_len = min<int64_t>(iw_end - iw, MAX_IW_BLK());
+                            const int64_t ow     = iw * stride_w + ow_offset;
+                            conv_transpose_n16cx_direct_kernel_fp32_avx512_table[iw_len](
+                                l_src_b + (ih * src_w + iw) * CH_DT_BLK(),
+                                l_flt,
+                                ic_start,
+                                ic_per_gp,
+                                src_icb_stride,
+                                dst_ow_stride,
+                                l_dst + ow * CH_DT_BLK());
+                        }
+                    }
+                }
+
+                if (with_relu) {
+                    const __m512 vzero = _mm512_setzero_ps();
+                    const __m512 vsix  = _mm512_set1_ps(6.0f);
+                    for (int64_t i = 0; i < dst_w * CH_DT_BLK(); i += 16) {
+                        __m512 v = _mm512_max_ps(_mm512_loadu_ps(l_dst + i), vzero);
+                        if (with_relu6) {
+                            v = _mm512_min_ps(v, vsix);
+                        }
+                        _mm512_storeu_ps(l_dst + i, v);
+                    }
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
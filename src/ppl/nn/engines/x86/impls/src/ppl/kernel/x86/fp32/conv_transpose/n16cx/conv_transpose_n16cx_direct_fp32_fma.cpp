@@ -0,0 +1,240 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/conv_transpose.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+#define CH_DT_BLK() 16
+#define MAX_IW_BLK() 6
+
+// dst[j * dst_ow_stride] += sum(src[j][ic] * flt[ic]) for j in [0, w_len), one 16-channel output block
+template <int64_t w_len>
+static void conv_transpose_n16cx_direct_kernel_fp32_fma(
+    const float *src,
+    const float *flt,
+    const int64_t ic_start,
+    const int64_t ic_len,
+    const int64_t src_icb_stride,
+    const int64_t dst_ow_stride,
+    float *dst)
+{
+    __m256 ymm00, ymm01, ymm02, ymm03;
+    __m256 ymm04, ymm05, ymm06, ymm07;
+    __m256 ymm08, ymm09, ymm10, ymm11;
+    __m256 ymm12, ymm13, ymm14;
+
+    if (w_len > 0) ymm00 = _mm256_loadu_ps(dst + 0 * dst_ow_stride + 0);
+    if (w_len > 0) ymm01 = _mm256_loadu_ps(dst + 0 * dst_ow_stride + 8);
+    if (w_len > 1) ymm02 = _mm256_loadu_ps(dst + 1 * dst_ow_stride + 0);
+    if (w_len > 1) ymm03 = _mm256_loadu_ps(dst + 1 * dst_ow_stride + 8);
+    if (w_len > 2) ymm04 = _mm256_loadu_ps(dst + 2 * dst_ow_stride + 0);
+    if (w_len > 2) ymm05 = _mm256_loadu_ps(dst + 2 * dst_ow_stride + 8);
+    if (w_len > 3) ymm06 = _mm256_loadu_ps(dst + 3 * dst_ow_stride + 0);
+    if (w_len > 3) ymm07 = _mm256_loadu_ps(dst + 3 * dst_ow_stride + 8);
+    if (w_len > 4) ymm08 = _mm256_loadu_ps(dst + 4 * dst_ow_stride + 0);
+    if (w_len > 4) ymm09 = _mm256_loadu_ps(dst + 4 * dst_ow_stride + 8);
+    if (w_len > 5) ymm10 = _mm256_loadu_ps(dst + 5 * dst_ow_stride + 0);
+    if (w_len > 5) ymm11 = _mm256_loadu_ps(dst + 5 * dst_ow_stride + 8);
+
+    for (int64_t ic = 0; ic < ic_len; ++ic) {
+        const int64_t c   = ic_start + ic;
+        const float *l_src = src + (c / CH_DT_BLK()) * src_icb_stride + c % CH_DT_BLK();
+        ymm12 = _mm256_loadu_ps(flt + ic * CH_DT_BLK() + 0);
+        ymm13 = _mm256_loadu_ps(flt + ic * CH_DT_BLK() + 8);
+        if (w_len > 0) {
+            ymm14 = _mm256_set1_ps(l_src[0 * CH_DT_BLK()]);
+            ymm00 = _mm256_fmadd_ps(ymm12, ymm14, ymm00);
+            ymm01 = _mm256_fmadd_ps(ymm13, ymm14, ymm01);
+        }
+        if (w_len > 1) {
+            ymm14 = _mm256_set1_ps(l_src[1 * CH_DT_BLK()]);
+            ymm02 = _mm256_fmadd_ps(ymm12, ymm14, ymm02);
+            ymm03 = _mm256_fmadd_ps(ymm13, ymm14, ymm03);
+        }
+        if (w_len > 2) {
+            ymm14 = _mm256_set1_ps(l_src[2 * CH_DT_BLK()]);
+            ymm04 = _mm256_fmadd_ps(ymm12, ymm14, ymm04);
+            ymm05 = _mm256_fmadd_ps(ymm13, ymm14, ymm05);
+        }
+        if (w_len > 3) {
+            ymm14 = _mm256_set1_ps(l_src[3 * CH_DT_BLK()]);
+            ymm06 = _mm256_fmadd_ps(ymm12, ymm14, ymm06);
+            ymm07 = _mm256_fmadd_ps(ymm13, ymm14, ymm07);
+        }
+        if (w_len > 4) {
+            ymm14 = _mm256_set1_ps(l_src[4 * CH_DT_BLK()]);
+            ymm08 = _mm256_fmadd_ps(ymm12, ymm14, ymm08);
+            ymm09 = _mm256_fmadd_ps(ymm13, ymm14, ymm09);
+        }
+        if (w_len > 5) {
+            ymm14 = _mm256_set1_ps(l_src[5 * CH_DT_BLK()]);
+            ymm10 = _mm256_fmadd_ps(ymm12, ymm14, ymm10);
+            ymm11 = _mm256_fmadd_ps(ymm13, ymm14, ymm11);
+        }
+    }
+
+    if (w_len > 0) _mm256_storeu_ps(dst + 0 * dst_ow_stride + 0, ymm00);
+    if (w_len > 0) _mm256_storeu_ps(dst + 0 * dst_ow_stride + 8, ymm01);
+    if (w_len > 1) _mm256_storeu_ps(dst + 1 * dst_ow_stride + 0, ymm02);
+    if (w_len > 1) _mm256_storeu_ps(dst + 1 * dst_ow_stride + 8, ymm03);
+    if (w_len > 2) _mm256_storeu_ps(dst + 2 * dst_ow_stride + 0, ymm04);
+    if (w_len > 2) _mm256_storeu_ps(dst + 2 * dst_ow_stride + 8, ymm05);
+    if (w_len > 3) _mm256_storeu_ps(dst + 3 * dst_ow_stride + 0, ymm06);
+    if (w_len > 3) _mm256_storeu_ps(dst + 3 * dst_ow_stride + 8, ymm07);
+    if (w_len > 4) _mm256_storeu_ps(dst + 4 * dst_ow_stride + 0, ymm08);
+    if (w_len > 4) _mm256_storeu_ps(dst + 4 * dst_ow_stride + 8, ymm09);
+    if (w_len > 5) _mm256_storeu_ps(dst + 5 * dst_ow_stride + 0, ymm10);
+    if (w_len > 5) _mm256_storeu_ps(dst + 5 * dst_ow_stride + 8, ymm11);
+}
+
+typedef void (*conv_transpose_n16cx_direct_kernel_fp32_fma_func_t)(const float *, const float *, const int64_t, const int64_t, const int64_t, const int64_t, float *);
+static const conv_transpose_n16cx_direct_kernel_fp32_fma_func_t conv_transpose_n16cx_direct_kernel_fp32_fma_table[MAX_IW_BLK() + 1]{
+    conv_transpose_n16cx_direct_kernel_fp32_fma<0>,
+    conv_transpose_n16cx_direct_kernel_fp32_fma<1>,
+    conv_transpose_n16cx_direct_kernel_fp32_fma<2>,
+    conv_transpose_n16cx_direct_kernel_fp32_fma<3>,
+    conv_transpose_n16cx_direct_kernel_fp32_fma<4>,
+    conv_transpose_n16cx_direct_kernel_fp32_fma<5>,
+    conv_transpose_n16cx_direct_kernel_fp32_fma<6>,
+};
+
+ppl::common::RetCode conv_transpose_n16cx_direct_fp32_fma(
+    const ppl::nn::TensorShape *src_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src,
+    const float *sum_src,
+    const float *packed_filter,
+    const float *bias,
+    const int32_t group,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t hole_h,
+    const int32_t hole_w,
+    const conv_fuse_flag_t fuse_flag,
+    float *dst)
+{
+    const int64_t batch      = src_shape->GetDim(0);
+    const int64_t channels   = src_shape->GetDim(1);
+    const int64_t src_h      = src_shape->GetDim(2);
+    const int64_t src_w      = src_shape->GetDim(3);
+    const int64_t num_output = dst_shape->GetDim(1);
+    const int64_t dst_h      = dst_shape->GetDim(2);
+    const int64_t dst_w      = dst_shape->GetDim(3);
+
+    if (!conv_transpose_n16cx_is_supported_fp32(channels, num_output, group)) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t ic_per_gp  = channels / group;
+    const int64_t oc_per_gp  = num_output / group;
+    const int64_t padded_ic  = round_up(channels, CH_DT_BLK());
+    const int64_t padded_oc  = round_up(num_output, CH_DT_BLK());
+    const int64_t num_ocb    = padded_oc / CH_DT_BLK();
+    const int64_t src_icb_stride = src_h * src_w * CH_DT_BLK();
+    const int64_t dst_ow_stride  = stride_w * CH_DT_BLK();
+    const int64_t flt_ocb_stride = int64_t(kernel_h) * kernel_w * ic_per_gp * CH_DT_BLK();
+
+    const bool with_sum   = (fuse_flag & conv_fuse_flag::sum) && sum_src != nullptr;
+    const bool with_relu  = fuse_flag & (conv_fuse_flag::relu | conv_fuse_flag::relu6);
+    const bool with_relu6 = fuse_flag & conv_fuse_flag::relu6;
+
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(3)
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t ocb = 0; ocb < num_ocb; ++ocb) {
+            for (int64_t oh = 0; oh < dst_h; ++oh) {
+                const int64_t g        = ocb * CH_DT_BLK() / oc_per_gp;
+                const int64_t ic_start = g * ic_per_gp;
+                const int64_t dst_row_offset = ((b * num_ocb + ocb) * dst_h + oh) * dst_w * CH_DT_BLK();
+                float *l_dst = dst + dst_row_offset;
+
+                float bias_blk[CH_DT_BLK()];
+                for (int64_t i = 0; i < CH_DT_BLK(); ++i) {
+                    const int64_t oc = ocb * CH_DT_BLK() + i;
+                    bias_blk[i] = (bias != nullptr && oc < num_output) ? bias[oc] : 0.0f;
+                }
+                if (with_sum) {
+                    const float *l_sum = sum_src + dst_row_offset;
+                    for (int64_t ow = 0; ow < dst_w; ++ow) {
+                        for (int64_t i = 0; i < CH_DT_BLK(); ++i) {
+                            l_dst[ow * CH_DT_BLK() + i] = l_sum[ow * CH_DT_BLK() + i] + bias_blk[i];
+                        }
+                    }
+                } else {
+                    for (int64_t ow = 0; ow < dst_w; ++ow) {
+                        memcpy(l_dst + ow * CH_DT_BLK(), bias_blk, CH_DT_BLK() * sizeof(float));
+                    }
+                }
+
+                const float *l_src_b = src + b * padded_ic * src_h * src_w;
+                for (int64_t kh = 0; kh < kernel_h; ++kh) {
+                    const int64_t ih_stride = oh + pad_h - kh * hole_h;
+                    if (ih_stride < 0 || ih_stride % stride_h != 0) {
+                        continue;
+                    }
+                    const int64_t ih = ih_stride / stride_h;
+                    if (ih >= src_h) {
+                        continue;
+                    }
+                    for (int64_t kw = 0; kw < kernel_w; ++kw) {
+                        // ow = iw * stride_w - pad_w + kw * hole_w must fall in [0, dst_w)
+                        const int64_t ow_offset = kw * hole_w - pad_w;
+                        const int64_t iw_start  = max<int64_t>(div_up(max<int64_t>(-ow_offset, 0), stride_w), 0);
+                        const int64_t iw_end    = min<int64_t>(dst_w - ow_offset > 0 ? div_up(dst_w - ow_offset, stride_w) : 0, src_w);
+                        const float *l_flt = packed_filter + ocb * flt_ocb_stride + (kh * kernel_w + kw) * ic_per_gp * CH_DT_BLK();
+                        for (int64_t iw = iw_start; iw < iw_end; iw += MAX_IW_BLK()) {
+                            const int64_t iw_len = min<int64_t>(iw_end - iw, MAX_IW_BLK());
+                            const int64_t ow     = iw * stride_w + ow_offset;
+                            conv_transpose_n16cx_direct_kernel_fp32_fma_table[iw_len](
+                                l_src_b + (ih * src_w + iw) * CH_DT_BLK(),
+                                l_flt,
+                                ic_start,
+                                ic_per_gp,
+                                src_icb_stride,
+                                dst_ow_stride,
+                                l_dst + ow * CH_DT_BLK());
+                        }
+                    }
+                }
+
+                if (with_relu) {
+                    const __m256 vzero = _mm256_setzero_ps();
+                    const __m256 vsix  = _mm256_set1_ps(6.0f);
+                    for (int64_t i = 0; i < dst_w * CH_DT_BLK(); i += 8) {
+                        __m256 v = _mm256_max_ps(_mm256_loadu_ps(l_dst + i), vzero);
+                        if (with_relu6) {
+                            v = _mm256_min_ps(v, vsix);
+                        }
+                        _mm256_storeu_ps(l_dst + i, v);
+                    }
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
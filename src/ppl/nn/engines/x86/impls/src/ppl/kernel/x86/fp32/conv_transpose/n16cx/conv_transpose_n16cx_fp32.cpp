@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/conv_transpose.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+#define CH_DT_BLK() 16
+
+bool conv_transpose_n16cx_is_supported_fp32(
+    const int64_t channels,
+    const int64_t num_output,
+    const int64_t group)
+{
+    if (group <= 0 || channels % group != 0 || num_output % group != 0) {
+        return false;
+    }
+    return group == 1 || (num_output / group) % CH_DT_BLK() == 0;
+}
+
+uint64_t conv_transpose_n16cx_cal_packed_filter_size_fp32(
+    const int64_t channels,
+    const int64_t num_output,
+    const int64_t group,
+    const int64_t kernel_h,
+    const int64_t kernel_w)
+{
+    const int64_t padded_oc = round_up(num_output, CH_DT_BLK());
+    return uint64_t(padded_oc) * kernel_h * kernel_w * (channels / group) * sizeof(float);
+}
+
+// filter: [channels][num_output / group][kernel_h][kernel_w]
+ppl::common::RetCode conv_transpose_n16cx_pack_filter_fp32(
+    const float *filter,
+    const int64_t channels,
+    const int64_t num_output,
+    const int64_t group,
+    const int64_t kernel_h,
+    const int64_t kernel_w,
+    float *packed_filter)
+{
+    if (!conv_transpose_n16cx_is_supported_fp32(channels, num_output, group)) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t ic_per_gp = channels / group;
+    const int64_t oc_per_gp = num_output / group;
+    const int64_t num_ocb   = div_up(num_output, CH_DT_BLK());
+    const int64_t kernel_hw = kernel_h * kernel_w;
+
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
+    for (int64_t ocb = 0; ocb < num_ocb; ++ocb) {
+        for (int64_t k = 0; k < kernel_hw; ++k) {
+            float *l_packed = packed_filter + (ocb * kernel_hw + k) * ic_per_gp * CH_DT_BLK();
+            for (int64_t ic = 0; ic < ic_per_gp; ++ic) {
+                for (int64_t i = 0; i < CH_DT_BLK(); ++i) {
+                    const int64_t oc = ocb * CH_DT_BLK() + i;
+                    if (oc < num_output) {
+                        const int64_t g  = oc / oc_per_gp;
+                        const int64_t oc_in_gp = oc % oc_per_gp;
+                        l_packed[ic * CH_DT_BLK() + i] =
+                            filter[((g * ic_per_gp + ic) * oc_per_gp + oc_in_gp) * kernel_hw + k];
+                    } else {
+                        l_packed[ic * CH_DT_BLK() + i] = 0.0f;
+                    }
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -21,6 +21,7 @@
 #include "ppl/kernel/x86/fp32/reorder.h"
 #include "ppl/kernel/x86/fp32/fc/fma/fc_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/gemm/kernel/fma/gemm_nn_bcasta_vloadb_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/gemm_v2/fma/gemm_v2_post_op_fp32_fma.h"
 #include "ppl/kernel/x86/common/avx_tools.h"
 #include "ppl/common/sys.h"
 
@@ -83,7 +84,7 @@ ppl::common::RetCode fc_fp32_fma_executor::prepare()
 
 ppl::common::RetCode fc_fp32_fma_executor::execute()
 {
-    if (!fc_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || !temp_buffer_) {
+    if (!fc_param_ || !cvt_filter_ || !cvt_bias_ || !src_ || !dst_ || ((fc_param_->fuse_flag & fc_fuse_flag::sum) && !sum_src_) || !temp_buffer_) {
         return ppl::common::RC_INVALID_VALUE;
     }
 
@@ -99,6 +100,15 @@ ppl::common::RetCode fc_fp32_fma_executor::execute()
 
     const bool with_relu = fp.fuse_flag & fc_fuse_flag::relu;
 
+    // sigmoid and sum run on each output block right after its last ic pass, see gemm_v2_post_op_fp32_fma
+    gemm_v2_fuse_flag_t post_op_flag = gemm_v2_fuse_flag::none;
+    if (fp.fuse_flag & fc_fuse_flag::sigmoid) {
+        post_op_flag |= gemm_v2_fuse_flag::sigmoid;
+    }
+    if (fp.fuse_flag & fc_fuse_flag::sum) {
+        post_op_flag |= gemm_v2_fuse_flag::sum;
+    }
+
     int64_t src_trans_size = 0;
     if (sp.multi_batch) {
         src_trans_size = src_shape_->GetDim(0) * schedule_param_.ic_l2_blk;
@@ -198,6 +208,10 @@ ppl::common::RetCode fc_fp32_fma_executor::execute()
                         l_dst_buf += dst_buf_b_stride;
                     }
                 }
+                if (post_op_flag && is_last_ic) {
+                    const float *l_sum = sum_src_ ? sum_src_ + (base_dst - dst_) : nullptr;
+                    gemm_v2_post_op_fp32_fma(post_op_flag, l_sum, dst_b_stride, batch, oc_eff, dst_b_stride, base_dst);
+                }
                 PICK_PARAM(const float *, priv_param, B_IDX()) += CH_DT_BLK() * sp.ic_l2_blk;
                 PICK_PARAM(const float *, priv_param, V_IDX()) += CH_DT_BLK();
                 base_dst += CH_DT_BLK();
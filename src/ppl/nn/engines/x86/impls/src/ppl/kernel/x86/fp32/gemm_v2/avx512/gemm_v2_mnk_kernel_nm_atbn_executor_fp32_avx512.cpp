@@ -19,6 +19,7 @@
 
 #include "ppl/kernel/x86/common/internal_include.h"
 #include "ppl/kernel/x86/fp32/gemm_v2/avx512/gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/gemm_v2/avx512/gemm_v2_post_op_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/gemm_v2/avx512/kernel/gemm_kernel_fp32_avx512.h"
 
 namespace ppl { namespace kernel { namespace x86 {
@@ -443,15 +444,20 @@ void gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512::store_dst_data(
     const int32_t m_len,
     const int32_t n_len,
     const float* C,
+    const float* sum,
     float* dst)
 {
     const float& alpha      = param_.alpha;
     const float& beta       = param_.beta;
     const int32_t c_type    = (int32_t)param_.c_type;
-    const int32_t fuse_flag = (int32_t)param_.fuse_flag;
+    const int32_t with_relu = (param_.fuse_flag & gemm_v2_fuse_flag::relu) ? 1 : 0;
 
-    store_dst_data_func_tab[c_type][fuse_flag][alpha == 1.0f ? 1 : 0][beta == 0 ? 1 : 0](
+    store_dst_data_func_tab[c_type][with_relu][alpha == 1.0f ? 1 : 0][beta == 0 ? 1 : 0](
         src, m_len, n_len, alpha, beta, blk_partition_.n_blk_len, C, param_.ldc, param_.ldy, dst);
+
+    if (param_.fuse_flag & gemm_v2_fuse_flag::post_op) {
+        gemm_v2_post_op_fp32_avx512(param_.fuse_flag, sum, param_.ldsum, m_len, n_len, param_.ldy, dst);
+    }
 }
 
 void gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512::execute_sub_blk(
@@ -566,7 +572,8 @@ common::RetCode gemm_v2_mnk_kernel_nm_atbn_executor_fp32_avx512::execute(void)
             } else if (c_type == gemm_v2_C_type::matrix) {
                 l_src_c = C + m * ldc + n;
             }
-            store_dst_data(temp_dst, m_blk_eff, n_blk_eff, l_src_c, dst + m * ldy + n);
+            const float* l_src_sum = param_.src_sum ? param_.src_sum + m * param_.ldsum + n : nullptr;
+            store_dst_data(temp_dst, m_blk_eff, n_blk_eff, l_src_c, l_src_sum, dst + m * ldy + n);
         }
     }
 
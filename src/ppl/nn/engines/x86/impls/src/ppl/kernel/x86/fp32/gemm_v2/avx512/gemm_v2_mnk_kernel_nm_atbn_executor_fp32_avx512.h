@@ -88,7 +88,7 @@ private:
     // execute related functions
     inline void load_a_data(const float* src, const int32_t m_len, const int32_t k_len, float* dst);
     inline void load_b_data(const float* src, const int32_t n_len, const int32_t k_len, float* dst);
-    inline void store_dst_data(const float* src, const int32_t m_len, const int32_t n_len, const float* C, float* dst);
+    inline void store_dst_data(const float* src, const int32_t m_len, const int32_t n_len, const float* C, const float* sum, float* dst);
     inline void execute_sub_blk(const float* A, const float* B, const int32_t m_len, const int32_t n_len, const int32_t k_len, float* dst);
 
 private:
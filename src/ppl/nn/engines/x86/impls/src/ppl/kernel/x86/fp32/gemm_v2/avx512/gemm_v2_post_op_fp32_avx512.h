@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_GEMM_V2_AVX512_GEMM_V2_POST_OP_FP32_AVX512_H_
+#define __ST_PPL_KERNEL_X86_FP32_GEMM_V2_AVX512_GEMM_V2_POST_OP_FP32_AVX512_H_
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
+#include "ppl/kernel/x86/fp32/sigmoid/avx512/sigmoid_kernel_fp32_avx512.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+template <bool with_sigmoid, bool with_sum>
+void gemm_v2_post_op_kernel_fp32_avx512(
+    const float* sum,
+    const int32_t ldsum,
+    const int32_t m_len,
+    const int32_t n_len,
+    const int32_t ldy,
+    float* dst)
+{
+    const int32_t simd_w = 16;
+    for (int32_t m = 0; m < m_len; m++) {
+        float* l_dst       = dst + m * ldy;
+        const float* l_sum = with_sum ? sum + m * ldsum : nullptr;
+        int32_t n          = 0;
+        for (; n + simd_w <= n_len; n += simd_w) {
+            __m512 v_data = _mm512_loadu_ps(l_dst + n);
+            if (with_sigmoid) {
+                v_data = _avx512_sigmoid_ps(v_data);
+            }
+            if (with_sum) {
+                v_data = _mm512_add_ps(v_data, _mm512_loadu_ps(l_sum + n));
+            }
+            _mm512_storeu_ps(l_dst + n, v_data);
+        }
+        for (; n < n_len; n++) {
+            float data = l_dst[n];
+            if (with_sigmoid) {
+                data = 1.0f / (expf(-data) + 1.0f);
+            }
+            if (with_sum) {
+                data += l_sum[n];
+            }
+            l_dst[n] = data;
+        }
+    }
+}
+
+// Post-op epilogue for gemm_v2 executors. Runs sigmoid and sum on an output tile
+// of m_len x n_len right after it has been stored, while it is still in cache.
+// relu is applied when storing the tile, so it always comes before sum.
+inline void gemm_v2_post_op_fp32_avx512(
+    const gemm_v2_fuse_flag_t fuse_flag,
+    const float* sum,
+    const int32_t ldsum,
+    const int32_t m_len,
+    const int32_t n_len,
+    const int32_t ldy,
+    float* dst)
+{
+    const bool with_sigmoid = fuse_flag & gemm_v2_fuse_flag::sigmoid;
+    const bool with_sum     = (fuse_flag & gemm_v2_fuse_flag::sum) && sum;
+    if (with_sigmoid && with_sum) {
+        gemm_v2_post_op_kernel_fp32_avx512<true, true>(sum, ldsum, m_len, n_len, ldy, dst);
+    } else if (with_sigmoid) {
+        gemm_v2_post_op_kernel_fp32_avx512<true, false>(sum, ldsum, m_len, n_len, ldy, dst);
+    } else if (with_sum) {
+        gemm_v2_post_op_kernel_fp32_avx512<false, true>(sum, ldsum, m_len, n_len, ldy, dst);
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -69,6 +69,7 @@ uint64_t matmul_ndarray_fp32_get_buffer_bytes(
 static ppl::common::RetCode matmul_ndarray_recursive_fp32(
     const float *src0,
     const float *src1,
+    const float *sum_src,
     gemm_v2_executor_fp32 *executor,
     const int64_t *src0_strides,
     const int64_t *src1_strides,
@@ -84,13 +85,15 @@ static ppl::common::RetCode matmul_ndarray_recursive_fp32(
     if (dim_idx >= dim_count - 2) {
         executor->get_param_mutable().src_A = src0;
         executor->get_param_mutable().src_B = src1;
+        executor->get_param_mutable().src_sum = sum_src;
         executor->get_param_mutable().dst_Y = dst;
         return executor->execute();
     } else {
         const int64_t length = dst_dims[dim_idx];
         for (int64_t i = 0; i < length; i++) {
             ppl::common::RetCode ret = matmul_ndarray_recursive_fp32(
-                src0 + i * src0_strides[dim_idx], src1 + i * src1_strides[dim_idx], executor,
+                src0 + i * src0_strides[dim_idx], src1 + i * src1_strides[dim_idx],
+                sum_src ? sum_src + i * dst_strides[dim_idx] : nullptr, executor,
                 src0_strides, src1_strides, dst_strides, dst_dims,
                 dim_count, dim_idx + 1, m, n, k, dst + i * dst_strides[dim_idx]);
             if (ret != ppl::common::RC_SUCCESS) {
@@ -102,12 +105,15 @@ static ppl::common::RetCode matmul_ndarray_recursive_fp32(
     return ppl::common::RC_SUCCESS;
 }
 
-ppl::common::RetCode matmul_ndarray_fp32(
+ppl::common::RetCode matmul_ndarray_fused_fp32(
     const ppl::nn::TensorShape *src0_shape,
     const ppl::nn::TensorShape *src1_shape,
     const ppl::nn::TensorShape *dst_shape,
     const float *src0,
     const float *src1,
+    const float *bias,
+    const float *sum_src,
+    const gemm_v2_fuse_flag_t fuse_flag,
     const ppl::common::isa_t isa_flag,
     void *temp_buffer,
     float *dst)
@@ -143,6 +149,14 @@ ppl::common::RetCode matmul_ndarray_fp32(
     param.ldy      = n;
     param.isa_flag = isa_flag; // other param use default value
 
+    if (bias) {
+        param.src_C  = bias;
+        param.c_type = gemm_v2_C_type::vector_w;
+        param.beta   = 1.0f;
+    }
+    param.fuse_flag = fuse_flag;
+    param.ldsum     = n;
+
     auto executor = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(param));
     if (!executor) {
         return ppl::common::RC_UNSUPPORTED;
@@ -152,6 +166,7 @@ ppl::common::RetCode matmul_ndarray_fp32(
     if (src0_dims.size() == 2 && src1_dims.size() == 2) { // normal gemm
         executor->get_param_mutable().src_A = src0;
         executor->get_param_mutable().src_B = src1;
+        executor->get_param_mutable().src_sum = sum_src;
         executor->get_param_mutable().dst_Y = dst;
         return executor->execute();
     }
@@ -180,10 +195,26 @@ ppl::common::RetCode matmul_ndarray_fp32(
     }
 
     return matmul_ndarray_recursive_fp32(
-        src0, src1, executor.get(),
+        src0, src1, sum_src, executor.get(),
         src0_strides, src1_strides,
         dst_strides, dst_dims,
         max_dim_count, 0, m, n, k, dst);
 }
 
+ppl::common::RetCode matmul_ndarray_fp32(
+    const ppl::nn::TensorShape *src0_shape,
+    const ppl::nn::TensorShape *src1_shape,
+    const ppl::nn::TensorShape *dst_shape,
+    const float *src0,
+    const float *src1,
+    const ppl::common::isa_t isa_flag,
+    void *temp_buffer,
+    float *dst)
+{
+    return matmul_ndarray_fused_fp32(
+        src0_shape, src1_shape, dst_shape,
+        src0, src1, nullptr, nullptr,
+        gemm_v2_fuse_flag::none, isa_flag, temp_buffer, dst);
+}
+
 }}}; // namespace ppl::kernel::x86
@@ -17,38 +17,14 @@
 
 #include "ppl/kernel/x86/common/internal_include.h"
 
+#include <float.h>
 #include <vector>
 #include <algorithm>
 #include <numeric>
 
 namespace ppl { namespace kernel { namespace x86 {
 
-inline float calc_iou(
-        const float *boxes,
-        const float *areas,
-        const int64_t i0,
-        const int64_t i1,
-        const int64_t offset)
-{
-    float ix1 = boxes[i0 * 4 + 0];
-    float iy1 = boxes[i0 * 4 + 1];
-    float ix2 = boxes[i0 * 4 + 2];
-    float iy2 = boxes[i0 * 4 + 3];
-
-    float xx1 = max(ix1, boxes[i1 * 4 + 0]);
-    float yy1 = max(iy1, boxes[i1 * 4 + 1]);
-    float xx2 = min(ix2, boxes[i1 * 4 + 2]);
-    float yy2 = min(iy2, boxes[i1 * 4 + 3]);
-
-    float w = max(0.f, xx2 - xx1 + offset);
-    float h = max(0.f, yy2 - yy1 + offset);
-
-    float inter = w * h;
-    float ovr = inter / (areas[i0] + areas[i1] - inter);
-    return ovr;
-}
-
-ppl::common::RetCode mmcv_nms_ndarray_fp32_naive(
+ppl::common::RetCode mmcv_nms_ndarray_fp32(
         const float *boxes,
         const float *scores,
         const uint32_t num_boxes_in,
@@ -57,45 +33,55 @@ ppl::common::RetCode mmcv_nms_ndarray_fp32_naive(
         int64_t *dst,
         int64_t *num_boxes_out)
 {
-    std::vector<uint32_t> sorted_index_(num_boxes_in);
-    std::vector<float> areas_(num_boxes_in);
-    uint32_t *sorted_index = sorted_index_.data();
-    float *areas = areas_.data();
+    // same order as a stable descending argsort
+    std::vector<uint32_t> sorted_index(num_boxes_in);
+    std::iota(sorted_index.begin(), sorted_index.end(), 0);
+    std::sort(sorted_index.begin(), sorted_index.end(), [scores](const uint32_t a, const uint32_t b) {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+    });
 
-    for (uint32_t i = 0; i < num_boxes_in; i++) {
-        areas[i] = (boxes[i * 4 + 2] - boxes[i * 4 + 0] + offset) * (boxes[i * 4 + 3] - boxes[i * 4 + 1] + offset);
-    }
-    argsort(scores, sorted_index, num_boxes_in);
+    // kept boxes as separate coordinate arrays for the blocked iou loop,
+    // padded slots are empty boxes which never overlap anything
+    const int64_t blk = 8;
+    const int64_t padded_num = round_up(num_boxes_in, blk);
+    std::vector<float> sel_x1(padded_num, FLT_MAX), sel_y1(padded_num, FLT_MAX);
+    std::vector<float> sel_x2(padded_num, -FLT_MAX), sel_y2(padded_num, -FLT_MAX);
+    std::vector<float> sel_area(padded_num, 0.0f);
 
-    *num_boxes_out = 0;
+    int64_t num_sel = 0;
     for (uint32_t i = 0; i < num_boxes_in; i++) {
-        int64_t idx = sorted_index[i];
+        const int64_t idx = sorted_index[i];
+        const float x1 = boxes[idx * 4 + 0];
+        const float y1 = boxes[idx * 4 + 1];
+        const float x2 = boxes[idx * 4 + 2];
+        const float y2 = boxes[idx * 4 + 3];
+        const float area = (x2 - x1 + offset) * (y2 - y1 + offset);
+
         bool keep = true;
-        for (int64_t j = 0; j < *num_boxes_out; j++) {
-            float iou = calc_iou(boxes, areas, idx, dst[j], offset);
-            if (iou >= iou_threshold) {
-                keep = false;
-                break;
+        for (int64_t j = 0; j < num_sel && keep; j += blk) {
+            float ovr[blk];
+            for (int64_t k = 0; k < blk; k++) {
+                const float w = max(0.f, min(x2, sel_x2[j + k]) - max(x1, sel_x1[j + k]) + offset);
+                const float h = max(0.f, min(y2, sel_y2[j + k]) - max(y1, sel_y1[j + k]) + offset);
+                const float inter = w * h;
+                ovr[k] = inter / (area + sel_area[j + k] - inter);
+            }
+            for (int64_t k = 0; k < blk; k++) {
+                keep &= !(ovr[k] >= iou_threshold);
             }
         }
         if (keep) {
-            dst[(*num_boxes_out)++] = idx;
+            sel_x1[num_sel] = x1;
+            sel_y1[num_sel] = y1;
+            sel_x2[num_sel] = x2;
+            sel_y2[num_sel] = y2;
+            sel_area[num_sel] = area;
+            dst[num_sel++] = idx;
         }
     }
 
+    *num_boxes_out = num_sel;
     return ppl::common::RC_SUCCESS;
 }
 
-ppl::common::RetCode mmcv_nms_ndarray_fp32(
-        const float *boxes,
-        const float *scores,
-        const uint32_t num_boxes_in,
-        const float iou_threshold,
-        const int64_t offset,
-        int64_t *dst,
-        int64_t *num_boxes_out)
-{
-    return mmcv_nms_ndarray_fp32_naive(boxes, scores, num_boxes_in, iou_threshold, offset, dst, num_boxes_out);
-}
-
 }}}; // namespace ppl::kernel::x86
@@ -15,7 +15,6 @@
 // specific language governing permissions and limitations
 // under the License.
 
-
 #include <algorithm>
 #include <vector>
 
@@ -23,106 +22,125 @@
 
 namespace ppl { namespace kernel { namespace x86 {
 
-inline float calc_iou(const float *p_boxes, int64_t i0, int64_t i1, bool centered)
+// selected boxes of one batch-class as corners and areas, laid out for the blocked iou loop
+struct nms_selected_boxes {
+    std::vector<float> x1, y1, x2, y2, area;
+    std::vector<uint32_t> index;
+    int64_t num;
+
+    void reserve(const int64_t n)
+    {
+        const int64_t padded_n = round_up(n, 8);
+        x1.assign(padded_n, 0);
+        y1.assign(padded_n, 0);
+        x2.assign(padded_n, 0);
+        y2.assign(padded_n, 0);
+        area.assign(padded_n, 0);
+        index.resize(n);
+        num = 0;
+    }
+};
+
+inline void box_to_corners(const float *box, const bool centered, float *x1, float *y1, float *x2, float *y2)
 {
-    const float *b0 = p_boxes + i0 * 4;
-    const float *b1 = p_boxes + i1 * 4;
-    float x_min, x_max, y_min, y_max;
-    float w0, w1, h0, h1;
     if (centered == true) { // tf_format: [x_center, y_center, width, height]
-        w0    = b0[2];
-        w1    = b1[2];
-        h0    = b0[3];
-        h1    = b1[3];
-        x_min = min(b0[0] - w0 / 2, b1[0] - w1 / 2);
-        x_max = max(b0[0] + w0 / 2, b1[0] + w1 / 2);
-        y_min = min(b0[1] - h0 / 2, b1[1] - h1 / 2);
-        y_max = max(b0[1] + h0 / 2, b1[1] + h1 / 2);
+        *x1 = box[0] - box[2] / 2;
+        *x2 = box[0] + box[2] / 2;
+        *y1 = box[1] - box[3] / 2;
+        *y2 = box[1] + box[3] / 2;
     } else { // pytorch_format: [y1, x1, y2, x2]
-        w0    = abs(b0[1] - b0[3]);
-        w1    = abs(b1[1] - b1[3]);
-        h0    = abs(b0[0] - b0[2]);
-        h1    = abs(b1[0] - b1[2]);
-        x_min = min(min(b0[1], b0[3]), min(b1[1], b1[3]));
-        x_max = max(max(b0[1], b0[3]), max(b1[1], b1[3]));
-        y_min = min(min(b0[0], b0[2]), min(b1[0], b1[2]));
-        y_max = max(max(b0[0], b0[2]), max(b1[0], b1[2]));
+        *x1 = min(box[1], box[3]);
+        *x2 = max(box[1], box[3]);
+        *y1 = min(box[0], box[2]);
+        *y2 = max(box[0], box[2]);
     }
+}
 
-    if (w0 + w1 <= x_max - x_min || h0 + h1 <= y_max - y_min) {
-        return 0;
+// true if the box overlaps any selected box by more than iou_threshold
+static bool nms_is_suppressed(
+    const nms_selected_boxes &sel,
+    const float x1,
+    const float y1,
+    const float x2,
+    const float y2,
+    const float iou_threshold)
+{
+    const int64_t blk = 8;
+    const float area  = (x2 - x1) * (y2 - y1);
+    for (int64_t j = 0; j < sel.num; j += blk) {
+        // full blocks only, padded slots have zero area and never suppress
+        float iou[blk];
+        for (int64_t k = 0; k < blk; ++k) {
+            const float iw    = min(x2, sel.x2[j + k]) - max(x1, sel.x1[j + k]);
+            const float ih    = min(y2, sel.y2[j + k]) - max(y1, sel.y1[j + k]);
+            const float inter = max(iw, 0.0f) * max(ih, 0.0f);
+            iou[k]            = inter > 0 ? inter / (area + sel.area[j + k] - inter) : 0.0f;
+        }
+        bool suppressed = false;
+        for (int64_t k = 0; k < blk; ++k) {
+            suppressed |= iou[k] > iou_threshold;
+        }
+        if (suppressed) {
+            return true;
+        }
     }
-
-    float area0 = w0 * h0, area1 = w1 * h1;
-    float iw = w0 + w1 - (x_max - x_min);
-    float ih = h0 + h1 - (y_max - y_min);
-    float I  = ih * iw;
-    float U  = area0 + area1 - I;
-
-    return I / U;
+    return false;
 }
 
-static ppl::common::RetCode nms_ndarray_naive(
-    const float *boxes,
-    const float *scommons,
+static void nms_one_class(
+    const float *p_boxes,
+    const float *p_scores,
     const uint32_t num_boxes_in,
-    const uint32_t batch,
-    const uint32_t num_classes,
     const bool center_point_box,
-    const int64_t maxoutput_boxes_per_batch_per_class,
+    const int64_t max_output_boxes,
     const float iou_threshold,
-    const float scommon_threshold,
-    int64_t *dst,
-    int64_t *num_boxes_out)
+    const float score_threshold,
+    std::vector<uint32_t> *candidates,
+    nms_selected_boxes *sel)
 {
-    std::vector<uint32_t> sorted_index_;
-    std::vector<uint32_t> selected_index_;
-    sorted_index_.resize(num_boxes_in);
-    selected_index_.resize(num_boxes_in);
-    uint32_t *sorted_index   = sorted_index_.data();
-    uint32_t *selected_index = selected_index_.data();
-
-    uint64_t out_idx = 0;
-    for (int64_t n = 0; n < batch; n++) {
-        const float *p_boxes = boxes + n * num_boxes_in * 4;
-        for (int64_t c = 0; c < num_classes; c++) {
-            int64_t selected_num   = 0;
-            const float *p_scommons = scommons + (n * num_classes + c) * num_boxes_in;
-            argsort(p_scommons, sorted_index, num_boxes_in);
-            for (int64_t i = 0; i < num_boxes_in; i++) {
-                int64_t idx = sorted_index[i];
-                if (p_scommons[idx] <= scommon_threshold) {
-                    break;
-                }
-                bool keep = true;
-                for (int64_t j = 0; j < selected_num; j++) {
-                    float iou = calc_iou(p_boxes, idx, selected_index[j], center_point_box);
-                    if (iou > iou_threshold) {
-                        keep = false;
-                        break;
-                    }
-                }
-                if (keep) { // box i has not been suppressed
-                    selected_index[selected_num++] = idx;
-                }
-                if (selected_num >= maxoutput_boxes_per_batch_per_class) {
-                    break;
-                }
-            }
-            // process result
-            for (int64_t i = 0; i < selected_num; i++) {
-                int64_t *p_dst = dst + out_idx * 3;
-
-                p_dst[0] = n;
-                p_dst[1] = c;
-                p_dst[2] = selected_index[i];
-                out_idx++;
-            }
+    // boxes under the threshold can never be selected, so they are dropped before sorting
+    candidates->clear();
+    for (uint32_t i = 0; i < num_boxes_in; ++i) {
+        if (p_scores[i] > score_threshold) {
+            candidates->push_back(i);
         }
     }
+    const int64_t num_candidates = candidates->size();
+    sel->reserve(min<int64_t>(num_candidates, max_output_boxes));
+    if (num_candidates == 0 || max_output_boxes <= 0) {
+        return;
+    }
 
-    *num_boxes_out = out_idx;
-    return ppl::common::RC_SUCCESS;
+    // same order as a stable descending argsort
+    auto score_greater = [p_scores](const uint32_t a, const uint32_t b) {
+        return p_scores[a] > p_scores[b] || (p_scores[a] == p_scores[b] && a < b);
+    };
+
+    // sort in windows, most classes fill max_output_boxes long before all candidates are visited
+    const int64_t window = max<int64_t>(2 * max_output_boxes, 64);
+    int64_t sorted_end   = 0;
+    for (int64_t i = 0; i < num_candidates; ++i) {
+        if (i == sorted_end) {
+            sorted_end = min<int64_t>(sorted_end + window, num_candidates);
+            std::partial_sort(candidates->begin() + i, candidates->begin() + sorted_end, candidates->end(), score_greater);
+        }
+        const uint32_t idx = (*candidates)[i];
+        float x1, y1, x2, y2;
+        box_to_corners(p_boxes + idx * 4, center_point_box, &x1, &y1, &x2, &y2);
+        if (nms_is_suppressed(*sel, x1, y1, x2, y2, iou_threshold)) {
+            continue;
+        }
+        const int64_t s = sel->num++;
+        sel->x1[s]      = x1;
+        sel->y1[s]      = y1;
+        sel->x2[s]      = x2;
+        sel->y2[s]      = y2;
+        sel->area[s]    = (x2 - x1) * (y2 - y1);
+        sel->index[s]   = idx;
+        if (sel->num >= max_output_boxes) {
+            break;
+        }
+    }
 }
 
 ppl::common::RetCode nms_ndarray_fp32(
@@ -138,7 +156,38 @@ ppl::common::RetCode nms_ndarray_fp32(
     int64_t *dst,
     int64_t *num_boxes_out)
 {
-    return nms_ndarray_naive(boxes, scommons, num_boxes_in, batch, num_classes, center_point_box, maxoutput_boxes_per_batch_per_class, iou_threshold, scommon_threshold, dst, num_boxes_out);
+    const int64_t num_tasks = (int64_t)batch * num_classes;
+    std::vector<nms_selected_boxes> selected(num_tasks);
+
+    std::vector<std::vector<uint32_t>> candidates(PPL_OMP_MAX_THREADS());
+    // classes differ a lot in how many boxes pass the threshold
+    PRAGMA_OMP_PARALLEL_FOR_SCHEDULE(dynamic)
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        const int64_t n = t / num_classes;
+        nms_one_class(
+            boxes + n * num_boxes_in * 4, scommons + t * num_boxes_in, num_boxes_in, center_point_box,
+            maxoutput_boxes_per_batch_per_class, iou_threshold, scommon_threshold,
+            &candidates[PPL_OMP_THREAD_ID()], &selected[t]);
+    }
+
+    // output keeps the batch-major, class-minor order
+    std::vector<int64_t> offsets(num_tasks + 1, 0);
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        offsets[t + 1] = offsets[t] + selected[t].num;
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        int64_t *p_dst = dst + offsets[t] * 3;
+        for (int64_t i = 0; i < selected[t].num; ++i) {
+            p_dst[i * 3 + 0] = t / num_classes;
+            p_dst[i * 3 + 1] = t % num_classes;
+            p_dst[i * 3 + 2] = selected[t].index[i];
+        }
+    }
+
+    *num_boxes_out = offsets[num_tasks];
+    return ppl::common::RC_SUCCESS;
 }
 
 }}}; // namespace ppl::kernel::x86
@@ -0,0 +1,293 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <new>
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/pd_conv2d/fma/pd_conv2d_n16cx_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_n16cx_gemm_direct_v2_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_n16cx_depthwise_fp32_fma.h"
+#include "ppl/common/sys.h"
+
+#define ASSUME_L2_BYTES() (256 * 1024)
+#define L2_RATIO()        0.501
+
+#define CH_DT_BLK() 16
+
+namespace ppl { namespace kernel { namespace x86 {
+
+typedef conv2d_n16cx_gemm_direct_v2_fp32_fma_executor pointwise_executor_t;
+typedef conv2d_n16cx_depthwise_fp32_fma_executor depthwise_executor_t;
+
+void pd_conv2d_n16cx_fp32_fma_executor::init_preproc_param()
+{
+    kernel_schedule_param &sp = schedule_param_;
+
+    sp.inter_c = conv2d_executor_->conv_param()->num_output;
+    if (algo_type_ == pd_conv2d_fp32_algo::pointwise_depthwise) {
+        sp.inter_h = src_shape_->GetDim(2);
+        sp.inter_w = src_shape_->GetDim(3);
+    } else {
+        sp.inter_h = dst_shape_->GetDim(2);
+        sp.inter_w = dst_shape_->GetDim(3);
+    }
+
+    inter_shape_.SetDataType(src_shape_->GetDataType());
+    inter_shape_.SetDataFormat(ppl::common::DATAFORMAT_N16CX);
+    inter_shape_.Reshape({src_shape_->GetDim(0), sp.inter_c, sp.inter_h, sp.inter_w});
+}
+
+int64_t pd_conv2d_n16cx_fp32_fma_executor::cal_inter_buf_h(const int64_t oh_len) const
+{
+    if (algo_type_ == pd_conv2d_fp32_algo::pointwise_depthwise) {
+        const conv2d_fp32_param &dw_param = *post_conv2d_executor_->conv_param();
+        const int64_t ext_kernel_h        = (dw_param.kernel_h - 1) * dw_param.dilation_h + 1;
+        return min<int64_t>((oh_len - 1) * dw_param.stride_h + ext_kernel_h, schedule_param_.inter_h);
+    }
+    return oh_len;
+}
+
+void pd_conv2d_n16cx_fp32_fma_executor::cal_kernel_tunning_param()
+{
+    kernel_schedule_param &sp = schedule_param_;
+
+    const int32_t num_thread = PPL_OMP_MAX_THREADS();
+    const int32_t batch      = src_shape_->GetDim(0);
+    const int32_t dst_h      = dst_shape_->GetDim(2);
+
+    const float l2_cap_per_core = (ppl::common::GetCpuCacheL2() == 0 ? ASSUME_L2_BYTES() : ppl::common::GetCpuCacheL2()) * L2_RATIO() / sizeof(float);
+    const int64_t inter_row_len = int64_t(round_up(sp.inter_c, CH_DT_BLK())) * sp.inter_w;
+
+    // rows of each image are spread among threads, then every task walks its rows band by band
+    sp.oh_task_blk = div_up(dst_h, div_up(num_thread, batch));
+    sp.oh_l2_blk   = sp.oh_task_blk;
+    while (sp.oh_l2_blk > 1 && cal_inter_buf_h(sp.oh_l2_blk) * inter_row_len > l2_cap_per_core) {
+        --sp.oh_l2_blk;
+    }
+    sp.inter_buf_h = cal_inter_buf_h(sp.oh_l2_blk);
+}
+
+uint64_t pd_conv2d_n16cx_fp32_fma_executor::cal_temp_buffer_size()
+{
+    const kernel_schedule_param &sp = schedule_param_;
+    const uint64_t inter_buf_len    = uint64_t(round_up(sp.inter_c, CH_DT_BLK())) * sp.inter_buf_h * sp.inter_w;
+    return inter_buf_len * PPL_OMP_MAX_THREADS() * sizeof(float);
+}
+
+ppl::common::RetCode pd_conv2d_n16cx_fp32_fma_executor::prepare()
+{
+    if (!conv2d_executor_ || !post_conv2d_executor_ || !src_shape_ || !dst_shape_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    init_preproc_param();
+
+    conv2d_executor_->set_src_shape(src_shape_);
+    conv2d_executor_->set_dst_shape(&inter_shape_);
+    post_conv2d_executor_->set_src_shape(&inter_shape_);
+    post_conv2d_executor_->set_dst_shape(dst_shape_);
+
+    ppl::common::RetCode rc = conv2d_executor_->prepare();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+    rc = post_conv2d_executor_->prepare();
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    cal_kernel_tunning_param();
+
+    return ppl::common::RC_SUCCESS;
+}
+
+void pd_conv2d_n16cx_fp32_fma_executor::execute_pointwise_depthwise()
+{
+    const kernel_schedule_param &sp = schedule_param_;
+    const pointwise_executor_t *pw_executor = static_cast<const pointwise_executor_t *>(conv2d_executor_);
+    const depthwise_executor_t *dw_executor = static_cast<const depthwise_executor_t *>(post_conv2d_executor_);
+    const conv2d_fp32_param &dw_param       = *dw_executor->conv_param();
+
+    const int32_t batch = src_shape_->GetDim(0);
+    const int32_t src_h = src_shape_->GetDim(2);
+    const int32_t src_w = src_shape_->GetDim(3);
+    const int32_t dst_h = dst_shape_->GetDim(2);
+    const int32_t dst_w = dst_shape_->GetDim(3);
+
+    const int32_t ext_kernel_h = (dw_param.kernel_h - 1) * dw_param.dilation_h + 1;
+
+    const int64_t src_b_stride   = int64_t(round_up(src_shape_->GetDim(1), CH_DT_BLK())) * src_h * src_w;
+    const int64_t src_icb_stride = int64_t(src_h) * src_w * CH_DT_BLK();
+    const int64_t src_h_stride   = int64_t(src_w) * CH_DT_BLK();
+    const int64_t dst_b_stride   = int64_t(round_up(dst_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
+    const int64_t dst_c_stride   = int64_t(dst_h) * dst_w * CH_DT_BLK();
+    const int64_t inter_h_stride = int64_t(sp.inter_w) * CH_DT_BLK();
+    const int64_t inter_c_stride = int64_t(sp.inter_buf_h) * inter_h_stride;
+    const int64_t inter_c_blk    = div_up(sp.inter_c, CH_DT_BLK());
+    const int64_t inter_buf_len  = inter_c_blk * inter_c_stride;
+    const int64_t num_oh_task    = div_up(dst_h, sp.oh_task_blk);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < batch * num_oh_task; ++task) {
+        const int64_t b             = task / num_oh_task;
+        const int64_t oh_task_start = task % num_oh_task * sp.oh_task_blk;
+        const int64_t oh_task_end   = min<int64_t>(oh_task_start + sp.oh_task_blk, dst_h);
+        const float *l_src          = src_ + b * src_b_stride;
+        float *l_dst                = dst_ + b * dst_b_stride;
+        float *inter_buf            = reinterpret_cast<float *>(temp_buffer_) + PPL_OMP_THREAD_ID() * inter_buf_len;
+
+        // rows [buf_ih_start, buf_ih_end) of the intermediate are held in inter_buf
+        int64_t buf_ih_start = 0;
+        int64_t buf_ih_end   = 0;
+        for (int64_t oh = oh_task_start; oh < oh_task_end; oh += sp.oh_l2_blk) {
+            const int64_t oh_end   = min<int64_t>(oh + sp.oh_l2_blk, oh_task_end);
+            const int64_t ih_start = max<int64_t>(oh * dw_param.stride_h - dw_param.pad_h, 0);
+            const int64_t ih_end   = min<int64_t>((oh_end - 1) * dw_param.stride_h - dw_param.pad_h + ext_kernel_h, sp.inter_h);
+            if (ih_start >= buf_ih_end) {
+                buf_ih_start = ih_start;
+                buf_ih_end   = ih_start;
+            } else if (ih_start > buf_ih_start) {
+                // reuse the rows overlapped with previous band
+                const int64_t keep_len = (buf_ih_end - ih_start) * inter_h_stride;
+                for (int64_t icb = 0; icb < inter_c_blk; ++icb) {
+                    float *l_buf = inter_buf + icb * inter_c_stride;
+                    memmove(l_buf, l_buf + (ih_start - buf_ih_start) * inter_h_stride, keep_len * sizeof(float));
+                }
+                buf_ih_start = ih_start;
+            }
+            if (ih_end > buf_ih_end) {
+                pw_executor->execute_tile(
+                    l_src + buf_ih_end * src_h_stride,
+                    src_icb_stride,
+                    (ih_end - buf_ih_end) * src_w,
+                    inter_c_stride,
+                    inter_buf + (buf_ih_end - buf_ih_start) * inter_h_stride);
+                buf_ih_end = ih_end;
+            }
+            dw_executor->execute_rows(
+                inter_buf - buf_ih_start * inter_h_stride,
+                inter_c_stride,
+                oh,
+                oh_end,
+                dst_c_stride,
+                l_dst);
+        }
+    }
+}
+
+void pd_conv2d_n16cx_fp32_fma_executor::execute_depthwise_pointwise()
+{
+    const kernel_schedule_param &sp = schedule_param_;
+    const depthwise_executor_t *dw_executor = static_cast<const depthwise_executor_t *>(conv2d_executor_);
+    const pointwise_executor_t *pw_executor = static_cast<const pointwise_executor_t *>(post_conv2d_executor_);
+
+    const int32_t batch = src_shape_->GetDim(0);
+    const int32_t src_h = src_shape_->GetDim(2);
+    const int32_t src_w = src_shape_->GetDim(3);
+    const int32_t dst_h = dst_shape_->GetDim(2);
+    const int32_t dst_w = dst_shape_->GetDim(3);
+
+    const int64_t src_b_stride   = int64_t(round_up(src_shape_->GetDim(1), CH_DT_BLK())) * src_h * src_w;
+    const int64_t src_c_stride   = int64_t(src_h) * src_w * CH_DT_BLK();
+    const int64_t dst_b_stride   = int64_t(round_up(dst_shape_->GetDim(1), CH_DT_BLK())) * dst_h * dst_w;
+    const int64_t dst_h_stride   = int64_t(dst_w) * CH_DT_BLK();
+    const int64_t dst_ocb_stride = int64_t(dst_h) * dst_w * CH_DT_BLK();
+    const int64_t inter_h_stride = int64_t(sp.inter_w) * CH_DT_BLK();
+    const int64_t inter_c_stride = int64_t(sp.inter_buf_h) * inter_h_stride;
+    const int64_t inter_buf_len  = div_up(sp.inter_c, CH_DT_BLK()) * inter_c_stride;
+    const int64_t num_oh_task    = div_up(dst_h, sp.oh_task_blk);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t task = 0; task < batch * num_oh_task; ++task) {
+        const int64_t b             = task / num_oh_task;
+        const int64_t oh_task_start = task % num_oh_task * sp.oh_task_blk;
+        const int64_t oh_task_end   = min<int64_t>(oh_task_start + sp.oh_task_blk, dst_h);
+        const float *l_src          = src_ + b * src_b_stride;
+        float *l_dst                = dst_ + b * dst_b_stride;
+        float *inter_buf            = reinterpret_cast<float *>(temp_buffer_) + PPL_OMP_THREAD_ID() * inter_buf_len;
+
+        for (int64_t oh = oh_task_start; oh < oh_task_end; oh += sp.oh_l2_blk) {
+            const int64_t oh_end = min<int64_t>(oh + sp.oh_l2_blk, oh_task_end);
+            dw_executor->execute_rows(
+                l_src,
+                src_c_stride,
+                oh,
+                oh_end,
+                inter_c_stride,
+                inter_buf - oh * inter_h_stride);
+            pw_executor->execute_tile(
+                inter_buf,
+                inter_c_stride,
+                (oh_end - oh) * sp.inter_w,
+                dst_ocb_stride,
+                l_dst + oh * dst_h_stride);
+        }
+    }
+}
+
+ppl::common::RetCode pd_conv2d_n16cx_fp32_fma_executor::execute()
+{
+    if (!conv2d_executor_ || !post_conv2d_executor_ || !src_ || !dst_ || !temp_buffer_) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    if (algo_type_ == pd_conv2d_fp32_algo::pointwise_depthwise) {
+        execute_pointwise_depthwise();
+    } else if (algo_type_ == pd_conv2d_fp32_algo::depthwise_pointwise) {
+        execute_depthwise_pointwise();
+    } else {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+bool pd_conv2d_n16cx_fp32_fma_manager::is_supported()
+{
+    if (!conv2d_manager_ || !post_conv2d_manager_) {
+        return false;
+    }
+
+    const conv2d_fp32_param &param      = conv2d_manager_->param();
+    const conv2d_fp32_param &post_param = post_conv2d_manager_->param();
+    const bool pw_first                 = algo_type_ == pd_conv2d_fp32_algo::pointwise_depthwise;
+    const conv2d_fp32_param &pw_param   = pw_first ? param : post_param;
+    const conv2d_fp32_param &dw_param   = pw_first ? post_param : param;
+
+    if (param.num_output != post_param.channels) {
+        return false;
+    }
+    if (!pw_param.is_pointwise() || pw_param.group != 1 || pw_param.stride_h != 1 || pw_param.stride_w != 1) {
+        return false;
+    }
+    if (!dw_param.is_depthwise()) {
+        return false;
+    }
+    // fused op has only one input, so sum can not be fused
+    const conv_fuse_flag_t sum_flag = conv_fuse_flag::sum | conv_fuse_flag::post_sum;
+    if ((param.fuse_flag & sum_flag) || (post_param.fuse_flag & sum_flag)) {
+        return false;
+    }
+    return true;
+}
+
+pd_conv2d_fp32_executor *pd_conv2d_n16cx_fp32_fma_manager::gen_executor()
+{
+    return new pd_conv2d_n16cx_fp32_fma_executor(algo_type_, conv2d_manager_->gen_executor(), post_conv2d_manager_->gen_executor());
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_PD_CONV2D_FMA_PD_CONV2D_N16CX_FP32_FMA_H_
+#define __ST_PPL_KERNEL_X86_FP32_PD_CONV2D_FMA_PD_CONV2D_N16CX_FP32_FMA_H_
+
+#include "ppl/kernel/x86/fp32/pd_conv2d.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// pointwise conv uses gemm_direct_v2, depthwise conv uses depthwise
+class pd_conv2d_n16cx_fp32_fma_executor final : public pd_conv2d_fp32_executor {
+public:
+    pd_conv2d_n16cx_fp32_fma_executor() {}
+    pd_conv2d_n16cx_fp32_fma_executor(
+        const pd_conv2d_fp32_algo_t algo_type,
+        conv2d_fp32_executor *conv2d_executor,
+        conv2d_fp32_executor *post_conv2d_executor)
+        : pd_conv2d_fp32_executor(conv2d_executor, post_conv2d_executor)
+        , algo_type_(algo_type) {}
+    uint64_t cal_temp_buffer_size() override;
+    ppl::common::RetCode prepare() override;
+    ppl::common::RetCode execute() override;
+
+private:
+    struct kernel_schedule_param {
+        // Preprocessed param
+        int32_t inter_c;
+        int32_t inter_h;
+        int32_t inter_w;
+
+        // Kernel tunning
+        int32_t oh_l2_blk;
+        int32_t oh_task_blk;
+        int32_t inter_buf_h;
+    } schedule_param_;
+
+    pd_conv2d_fp32_algo_t algo_type_;
+    ppl::nn::TensorShape inter_shape_;
+
+    void init_preproc_param();
+    void cal_kernel_tunning_param();
+    int64_t cal_inter_buf_h(const int64_t oh_len) const;
+    void execute_pointwise_depthwise();
+    void execute_depthwise_pointwise();
+};
+
+class pd_conv2d_n16cx_fp32_fma_manager final : public pd_conv2d_fp32_manager {
+public:
+    pd_conv2d_n16cx_fp32_fma_manager() {}
+    pd_conv2d_n16cx_fp32_fma_manager(
+        const pd_conv2d_fp32_algo_t algo_type,
+        conv2d_fp32_manager *conv2d_manager,
+        conv2d_fp32_manager *post_conv2d_manager)
+        : pd_conv2d_fp32_manager(conv2d_manager, post_conv2d_manager)
+        , algo_type_(algo_type) {}
+    bool is_supported() override;
+    pd_conv2d_fp32_executor *gen_executor() override;
+
+private:
+    pd_conv2d_fp32_algo_t algo_type_;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
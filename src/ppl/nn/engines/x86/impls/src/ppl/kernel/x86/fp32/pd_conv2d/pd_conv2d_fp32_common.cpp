@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <new>
+
+#include "ppl/kernel/x86/fp32/pd_conv2d.h"
+
+#include "ppl/kernel/x86/fp32/pd_conv2d/fma/pd_conv2d_n16cx_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/pd_conv2d/avx512/pd_conv2d_n16cx_fp32_avx512.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static bool is_n16cx_algo(const conv2d_fp32_algo_info &algo_info)
+{
+    return algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+           algo_info.output_format == ppl::common::DATAFORMAT_N16CX;
+}
+
+pd_conv2d_fp32_algo_info pd_conv2d_algo_selector::select_algo(const conv2d_fp32_algo_info &algo_info, const conv2d_fp32_algo_info &post_algo_info)
+{
+    static pd_conv2d_fp32_algo_info unknown_info = {
+        .algo_type     = pd_conv2d_fp32_algo::unknown,
+        .isa           = ppl::common::ISA_undef,
+        .input_format  = ppl::common::DATAFORMAT_UNKNOWN,
+        .output_format = ppl::common::DATAFORMAT_UNKNOWN};
+
+    if (algo_info.isa != post_algo_info.isa || !is_n16cx_algo(algo_info) || !is_n16cx_algo(post_algo_info)) {
+        return unknown_info;
+    }
+
+    conv2d_fp32_algo_t pointwise_algo;
+    if (algo_info.isa == ppl::common::ISA_X86_AVX512) {
+        pointwise_algo = conv2d_fp32_algo::gemm_direct;
+    } else if (algo_info.isa == ppl::common::ISA_X86_FMA) {
+        pointwise_algo = conv2d_fp32_algo::gemm_direct_v2;
+    } else {
+        return unknown_info;
+    }
+
+    pd_conv2d_fp32_algo_t pd_algo = pd_conv2d_fp32_algo::unknown;
+    if (algo_info.algo_type == pointwise_algo && post_algo_info.algo_type == conv2d_fp32_algo::depthwise) {
+        pd_algo = pd_conv2d_fp32_algo::pointwise_depthwise;
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::depthwise && post_algo_info.algo_type == pointwise_algo) {
+        pd_algo = pd_conv2d_fp32_algo::depthwise_pointwise;
+    }
+    if (pd_algo == pd_conv2d_fp32_algo::unknown) {
+        return unknown_info;
+    }
+
+    return (pd_conv2d_fp32_algo_info){
+        .algo_type     = pd_algo,
+        .isa           = algo_info.isa,
+        .input_format  = ppl::common::DATAFORMAT_N16CX,
+        .output_format = ppl::common::DATAFORMAT_N16CX};
+}
+
+pd_conv2d_fp32_manager *pd_conv2d_algo_selector::gen_algo(const pd_conv2d_fp32_algo_info &algo_info, conv2d_fp32_manager *conv2d_manager, conv2d_fp32_manager *post_conv2d_manager)
+{
+    pd_conv2d_fp32_manager *pd_conv_mgr = nullptr;
+    if (algo_info.algo_type == pd_conv2d_fp32_algo::unknown ||
+        algo_info.input_format != ppl::common::DATAFORMAT_N16CX ||
+        algo_info.output_format != ppl::common::DATAFORMAT_N16CX) {
+        return pd_conv_mgr;
+    }
+
+    if (algo_info.isa == ppl::common::ISA_X86_FMA) {
+        pd_conv_mgr = new pd_conv2d_n16cx_fp32_fma_manager(algo_info.algo_type, conv2d_manager, post_conv2d_manager);
+    }
+    if (algo_info.isa == ppl::common::ISA_X86_AVX512) {
+        pd_conv_mgr = new pd_conv2d_n16cx_fp32_avx512_manager(algo_info.algo_type, conv2d_manager, post_conv2d_manager);
+    }
+
+    return pd_conv_mgr;
+}
+
+}}}; // namespace ppl::kernel::x86
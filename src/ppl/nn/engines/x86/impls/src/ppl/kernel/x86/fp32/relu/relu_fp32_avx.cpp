@@ -17,6 +17,7 @@
 
 #include <immintrin.h>
 #include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/parallel_for.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -31,17 +32,14 @@ ppl::common::RetCode relu_fp32_avx(
     const int64_t unroll_n_body = round(n_elem, unroll_n);
 
     if (unroll_n_body) {
-        PRAGMA_OMP_PARALLEL()
-        {
-            __m256 mm_zero = _mm256_setzero_ps();
-            PRAGMA_OMP_FOR()
-            for (int64_t n = 0; n < unroll_n_body; n += unroll_n) {
-                _mm256_storeu_ps(y + n + 0 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 0 * simd_w), mm_zero));
-                _mm256_storeu_ps(y + n + 1 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 1 * simd_w), mm_zero));
-                _mm256_storeu_ps(y + n + 2 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 2 * simd_w), mm_zero));
-                _mm256_storeu_ps(y + n + 3 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 3 * simd_w), mm_zero));
-            }
-        }
+        __m256 mm_zero = _mm256_setzero_ps();
+        parallel_for(unroll_n_body / unroll_n, [&](const int64_t i) {
+            const int64_t n = i * unroll_n;
+            _mm256_storeu_ps(y + n + 0 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 0 * simd_w), mm_zero));
+            _mm256_storeu_ps(y + n + 1 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 1 * simd_w), mm_zero));
+            _mm256_storeu_ps(y + n + 2 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 2 * simd_w), mm_zero));
+            _mm256_storeu_ps(y + n + 3 * simd_w, _mm256_max_ps(_mm256_loadu_ps(x + n + 3 * simd_w), mm_zero));
+        });
     }
     for (int64_t n = unroll_n_body; n < n_elem; ++n) {
         y[n] = max(x[n], 0.0f);
@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode reorder_nhwc_nxc_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst)
+{
+    if (src_shape->GetDataFormat() != ppl::common::DATAFORMAT_NHWC ||
+        src_shape->GetDimCount() < 3) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t channels = src_shape->GetDim(1);
+    const int64_t pixels   = src_shape->GetElementsExcludingPadding() / channels;
+
+    const int64_t c_blk    = 8;
+    const int64_t padded_c = round_up(channels, c_blk);
+
+    if (padded_c == channels) {
+        memcpy(dst, src, pixels * channels * sizeof(float));
+        return ppl::common::RC_SUCCESS;
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t p = 0; p < pixels; ++p) {
+        memcpy(dst + p * channels, src + p * padded_c, channels * sizeof(float));
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode reorder_nxc_nhwc_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    float *dst)
+{
+    if (src_shape->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY ||
+        src_shape->GetDimCount() < 3) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    // src is a channels-last ndarray, channels is its innermost dim
+    const int64_t channels = src_shape->GetDim(src_shape->GetDimCount() - 1);
+    const int64_t pixels   = src_shape->GetElementsExcludingPadding() / channels;
+
+    const int64_t c_blk    = 8;
+    const int64_t padded_c = round_up(channels, c_blk);
+
+    if (padded_c == channels) {
+        memcpy(dst, src, pixels * channels * sizeof(float));
+        return ppl::common::RC_SUCCESS;
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t p = 0; p < pixels; ++p) {
+        float *ldst       = dst + p * padded_c;
+        const float *lsrc = src + p * channels;
+        memcpy(ldst, lsrc, channels * sizeof(float));
+        for (int64_t c = channels; c < padded_c; ++c) {
+            ldst[c] = 0;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
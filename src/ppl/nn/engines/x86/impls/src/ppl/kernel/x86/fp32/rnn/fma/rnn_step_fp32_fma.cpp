@@ -0,0 +1,336 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/rnn/rnn_step_fp32.h"
+#include "ppl/kernel/x86/fp32/sigmoid/fma/sigmoid_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/tanh/fma/tanh_kernel_fp32_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// batch rows sharing one pass over a packed weight block
+#define RNN_BATCH_BLK() 4
+
+static inline __m256 rnn_activation_fp32_fma(const __m256 x, const rnn_activation_t act)
+{
+    if (act == rnn_activation::sigmoid) {
+        return _fma_sigmoid_ps(x);
+    }
+    if (act == rnn_activation::tanh) {
+        return _fma_tanh_ps(x);
+    }
+    return _mm256_max_ps(x, _mm256_setzero_ps());
+}
+
+static inline __m256 rnn_clip_fp32_fma(const __m256 x, const float clip)
+{
+    if (clip > 0.0f) {
+        return _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-clip)), _mm256_set1_ps(clip));
+    }
+    return x;
+}
+
+// unit 0..j_eff of a hidden block, tail blocks go through masked load/store
+struct rnn_lane_fp32_fma {
+    int64_t j_eff;
+    __m256i mask;
+
+    rnn_lane_fp32_fma(const int64_t j_eff)
+        : j_eff(j_eff)
+    {
+        const __m256 lane_idx = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        mask = _mm256_castps_si256(_mm256_cmp_ps(lane_idx, _mm256_set1_ps((float)j_eff), _CMP_LT_OQ));
+    }
+
+    inline __m256 load(const float *p) const
+    {
+        return j_eff == RNN_PACK_BLK() ? _mm256_loadu_ps(p) : _mm256_maskload_ps(p, mask);
+    }
+
+    inline void store(float *p, const __m256 v) const
+    {
+        if (j_eff == RNN_PACK_BLK()) {
+            _mm256_storeu_ps(p, v);
+        } else {
+            _mm256_maskstore_ps(p, mask, v);
+        }
+    }
+};
+
+// acc[g][b] += h_rows[b][0:H] * packed gates [g0, g0 + NG) of one hidden block
+template <int64_t NG, int64_t BN>
+static inline void rnn_recurrent_acc_fp32_fma(
+    const float *packed_blk,
+    const int64_t num_gate,
+    const int64_t g0,
+    const float **h_rows,
+    const int64_t hidden,
+    __m256 acc[NG][BN])
+{
+    const int64_t blk = RNN_PACK_BLK();
+    const float *p_r  = packed_blk + g0 * blk;
+    for (int64_t k = 0; k < hidden; ++k) {
+        __m256 h_k[BN];
+        for (int64_t b = 0; b < BN; ++b) {
+            h_k[b] = _mm256_set1_ps(h_rows[b][k]);
+        }
+        for (int64_t g = 0; g < NG; ++g) {
+            const __m256 w = _mm256_loadu_ps(p_r + g * blk);
+            for (int64_t b = 0; b < BN; ++b) {
+                acc[g][b] = _mm256_fmadd_ps(w, h_k[b], acc[g][b]);
+            }
+        }
+        p_r += num_gate * blk;
+    }
+}
+
+// rows of the batch block that are still inside their sequence
+static inline int64_t rnn_collect_rows_fp32_fma(
+    const rnn_step_fp32_args &args,
+    const int64_t b_start,
+    int64_t *rows)
+{
+    const int64_t b_end = min<int64_t>(b_start + RNN_BATCH_BLK(), args.batch);
+    int64_t count       = 0;
+    for (int64_t b = b_start; b < b_end; ++b) {
+        if (args.xw_rows[b]) {
+            rows[count++] = b;
+        }
+    }
+    return count;
+}
+
+static void rnn_copy_finished_rows_fp32(const rnn_step_fp32_args &args)
+{
+    for (int64_t b = 0; b < args.batch; ++b) {
+        if (!args.xw_rows[b]) {
+            memcpy(args.h_next + b * args.hidden, args.h_prev + b * args.hidden, args.hidden * sizeof(float));
+        }
+    }
+}
+
+template <int64_t BN>
+static void lstm_step_block_fp32_fma(
+    const rnn_step_fp32_args &args,
+    const int64_t hb,
+    const int64_t *rows)
+{
+    const int64_t H  = args.hidden;
+    const int64_t j0 = hb * RNN_PACK_BLK();
+    const rnn_lane_fp32_fma lane(min<int64_t>(H - j0, RNN_PACK_BLK()));
+
+    const float *h_rows[BN];
+    __m256 acc[4][BN];
+    for (int64_t b = 0; b < BN; ++b) {
+        h_rows[b] = args.h_prev + rows[b] * H;
+        for (int64_t g = 0; g < 4; ++g) {
+            acc[g][b] = lane.load(args.xw_rows[rows[b]] + g * H + j0);
+        }
+    }
+    rnn_recurrent_acc_fp32_fma<4, BN>(args.packed_R + hb * H * 4 * RNN_PACK_BLK(), 4, 0, h_rows, H, acc);
+
+    const rnn_activation_t act_f = args.activations[0];
+    const rnn_activation_t act_g = args.activations[1];
+    const rnn_activation_t act_h = args.activations[2];
+    for (int64_t b = 0; b < BN; ++b) {
+        float *c        = args.c + rows[b] * H + j0;
+        const __m256 c0 = lane.load(c);
+        __m256 gi       = acc[0][b];
+        __m256 go       = acc[1][b];
+        __m256 gf       = acc[2][b];
+        __m256 gc       = acc[3][b];
+        if (args.P) {
+            gi = _mm256_fmadd_ps(lane.load(args.P + 0 * H + j0), c0, gi);
+            gf = _mm256_fmadd_ps(lane.load(args.P + 2 * H + j0), c0, gf);
+        }
+        gi = rnn_activation_fp32_fma(rnn_clip_fp32_fma(gi, args.clip), act_f);
+        if (args.input_forget) {
+            gf = _mm256_sub_ps(_mm256_set1_ps(1.0f), gi);
+        } else {
+            gf = rnn_activation_fp32_fma(rnn_clip_fp32_fma(gf, args.clip), act_f);
+        }
+        gc              = rnn_activation_fp32_fma(rnn_clip_fp32_fma(gc, args.clip), act_g);
+        const __m256 c1 = _mm256_fmadd_ps(gf, c0, _mm256_mul_ps(gi, gc));
+        if (args.P) {
+            go = _mm256_fmadd_ps(lane.load(args.P + 1 * H + j0), c1, go);
+        }
+        go             = rnn_activation_fp32_fma(rnn_clip_fp32_fma(go, args.clip), act_f);
+        const __m256 h = _mm256_mul_ps(go, rnn_activation_fp32_fma(c1, act_h));
+        lane.store(c, c1);
+        lane.store(args.h_next + rows[b] * H + j0, h);
+        if (args.y_rows[rows[b]]) {
+            lane.store(args.y_rows[rows[b]] + j0, h);
+        }
+    }
+}
+
+template <int64_t BN>
+static void gru_step_gate_block_fp32_fma(
+    const rnn_step_fp32_args &args,
+    const int64_t hb,
+    const int64_t *rows)
+{
+    const int64_t H  = args.hidden;
+    const int64_t j0 = hb * RNN_PACK_BLK();
+    const rnn_lane_fp32_fma lane(min<int64_t>(H - j0, RNN_PACK_BLK()));
+    const float *packed_blk = args.packed_R + hb * H * 3 * RNN_PACK_BLK();
+    const rnn_activation_t act_f = args.activations[0];
+    const rnn_activation_t act_g = args.activations[1];
+
+    const float *h_rows[BN];
+    for (int64_t b = 0; b < BN; ++b) {
+        h_rows[b] = args.h_prev + rows[b] * H;
+    }
+
+    if (args.linear_before_reset) {
+        // h gate recurrence does not depend on r, all three gates go in one pass
+        __m256 acc[3][BN];
+        const __m256 rb = args.Rb_h ? lane.load(args.Rb_h + j0) : _mm256_setzero_ps();
+        for (int64_t b = 0; b < BN; ++b) {
+            acc[0][b] = lane.load(args.xw_rows[rows[b]] + 0 * H + j0);
+            acc[1][b] = lane.load(args.xw_rows[rows[b]] + 1 * H + j0);
+            acc[2][b] = rb;
+        }
+        rnn_recurrent_acc_fp32_fma<3, BN>(packed_blk, 3, 0, h_rows, H, acc);
+        for (int64_t b = 0; b < BN; ++b) {
+            const __m256 z  = rnn_activation_fp32_fma(rnn_clip_fp32_fma(acc[0][b], args.clip), act_f);
+            const __m256 r  = rnn_activation_fp32_fma(rnn_clip_fp32_fma(acc[1][b], args.clip), act_f);
+            __m256 gh       = _mm256_fmadd_ps(r, acc[2][b], lane.load(args.xw_rows[rows[b]] + 2 * H + j0));
+            gh              = rnn_activation_fp32_fma(rnn_clip_fp32_fma(gh, args.clip), act_g);
+            const __m256 h0 = lane.load(h_rows[b] + j0);
+            // (1 - z) * gh + z * h0 = gh + z * (h0 - gh)
+            const __m256 h = _mm256_fmadd_ps(z, _mm256_sub_ps(h0, gh), gh);
+            lane.store(args.h_next + rows[b] * H + j0, h);
+            if (args.y_rows[rows[b]]) {
+                lane.store(args.y_rows[rows[b]] + j0, h);
+            }
+        }
+    } else {
+        __m256 acc[2][BN];
+        for (int64_t b = 0; b < BN; ++b) {
+            acc[0][b] = lane.load(args.xw_rows[rows[b]] + 0 * H + j0);
+            acc[1][b] = lane.load(args.xw_rows[rows[b]] + 1 * H + j0);
+        }
+        rnn_recurrent_acc_fp32_fma<2, BN>(packed_blk, 3, 0, h_rows, H, acc);
+        for (int64_t b = 0; b < BN; ++b) {
+            const __m256 z = rnn_activation_fp32_fma(rnn_clip_fp32_fma(acc[0][b], args.clip), act_f);
+            const __m256 r = rnn_activation_fp32_fma(rnn_clip_fp32_fma(acc[1][b], args.clip), act_f);
+            lane.store(args.z + rows[b] * H + j0, z);
+            lane.store(args.rh + rows[b] * H + j0, _mm256_mul_ps(r, lane.load(h_rows[b] + j0)));
+        }
+    }
+}
+
+template <int64_t BN>
+static void gru_step_hidden_block_fp32_fma(
+    const rnn_step_fp32_args &args,
+    const int64_t hb,
+    const int64_t *rows)
+{
+    const int64_t H  = args.hidden;
+    const int64_t j0 = hb * RNN_PACK_BLK();
+    const rnn_lane_fp32_fma lane(min<int64_t>(H - j0, RNN_PACK_BLK()));
+    const rnn_activation_t act_g = args.activations[1];
+
+    const float *rh_rows[BN];
+    __m256 acc[1][BN];
+    const __m256 rb = args.Rb_h ? lane.load(args.Rb_h + j0) : _mm256_setzero_ps();
+    for (int64_t b = 0; b < BN; ++b) {
+        rh_rows[b] = args.rh + rows[b] * H;
+        acc[0][b]  = _mm256_add_ps(lane.load(args.xw_rows[rows[b]] + 2 * H + j0), rb);
+    }
+    rnn_recurrent_acc_fp32_fma<1, BN>(args.packed_R + hb * H * 3 * RNN_PACK_BLK(), 3, 2, rh_rows, H, acc);
+    for (int64_t b = 0; b < BN; ++b) {
+        const __m256 gh = rnn_activation_fp32_fma(rnn_clip_fp32_fma(acc[0][b], args.clip), act_g);
+        const __m256 z  = lane.load(args.z + rows[b] * H + j0);
+        const __m256 h0 = lane.load(args.h_prev + rows[b] * H + j0);
+        const __m256 h  = _mm256_fmadd_ps(z, _mm256_sub_ps(h0, gh), gh);
+        lane.store(args.h_next + rows[b] * H + j0, h);
+        if (args.y_rows[rows[b]]) {
+            lane.store(args.y_rows[rows[b]] + j0, h);
+        }
+    }
+}
+
+template <int64_t BN>
+static void rnn_step_block_fp32_fma(
+    const rnn_step_fp32_args &args,
+    const int64_t hb,
+    const int64_t *rows)
+{
+    const int64_t H  = args.hidden;
+    const int64_t j0 = hb * RNN_PACK_BLK();
+    const rnn_lane_fp32_fma lane(min<int64_t>(H - j0, RNN_PACK_BLK()));
+
+    const float *h_rows[BN];
+    __m256 acc[1][BN];
+    for (int64_t b = 0; b < BN; ++b) {
+        h_rows[b] = args.h_prev + rows[b] * H;
+        acc[0][b] = lane.load(args.xw_rows[rows[b]] + j0);
+    }
+    rnn_recurrent_acc_fp32_fma<1, BN>(args.packed_R + hb * H * RNN_PACK_BLK(), 1, 0, h_rows, H, acc);
+    for (int64_t b = 0; b < BN; ++b) {
+        const __m256 h = rnn_activation_fp32_fma(rnn_clip_fp32_fma(acc[0][b], args.clip), args.activations[0]);
+        lane.store(args.h_next + rows[b] * H + j0, h);
+        if (args.y_rows[rows[b]]) {
+            lane.store(args.y_rows[rows[b]] + j0, h);
+        }
+    }
+}
+
+// runs BLOCK_FUNC over every (hidden block, batch block) pair in parallel
+#define RNN_STEP_PARALLEL_FP32_FMA(ARGS, BLOCK_FUNC)                                              \
+    do {                                                                                          \
+        const int64_t __num_hb = div_up((ARGS).hidden, RNN_PACK_BLK());                           \
+        const int64_t __num_bb = div_up((ARGS).batch, RNN_BATCH_BLK());                           \
+        PRAGMA_OMP_PARALLEL_FOR()                                                                 \
+        for (int64_t __task = 0; __task < __num_hb * __num_bb; ++__task) {                        \
+            const int64_t __hb = __task % __num_hb;                                               \
+            int64_t __rows[RNN_BATCH_BLK()];                                                      \
+            const int64_t __bn = rnn_collect_rows_fp32_fma((ARGS), __task / __num_hb * RNN_BATCH_BLK(), __rows); \
+            if (__bn == 4) BLOCK_FUNC<4>((ARGS), __hb, __rows);                                   \
+            if (__bn == 3) BLOCK_FUNC<3>((ARGS), __hb, __rows);                                   \
+            if (__bn == 2) BLOCK_FUNC<2>((ARGS), __hb, __rows);                                   \
+            if (__bn == 1) BLOCK_FUNC<1>((ARGS), __hb, __rows);                                   \
+        }                                                                                         \
+    } while (0)
+
+void lstm_step_fp32_fma(const rnn_step_fp32_args &args)
+{
+    rnn_copy_finished_rows_fp32(args);
+    RNN_STEP_PARALLEL_FP32_FMA(args, lstm_step_block_fp32_fma);
+}
+
+void gru_step_fp32_fma(const rnn_step_fp32_args &args)
+{
+    rnn_copy_finished_rows_fp32(args);
+    RNN_STEP_PARALLEL_FP32_FMA(args, gru_step_gate_block_fp32_fma);
+    if (!args.linear_before_reset) {
+        // needs r * h_prev of every hidden unit
+        RNN_STEP_PARALLEL_FP32_FMA(args, gru_step_hidden_block_fp32_fma);
+    }
+}
+
+void rnn_step_fp32_fma(const rnn_step_fp32_args &args)
+{
+    rnn_copy_finished_rows_fp32(args);
+    RNN_STEP_PARALLEL_FP32_FMA(args, rnn_step_block_fp32_fma);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,434 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <string.h>
+
+#include <memory>
+
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+#include "ppl/kernel/x86/fp32/gemm_v2.h"
+#include "ppl/kernel/x86/fp32/rnn/rnn_step_fp32.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline float rnn_activation_fp32(const float x, const rnn_activation_t act)
+{
+    if (act == rnn_activation::sigmoid) {
+        return 1.0f / (1.0f + expf(-x));
+    }
+    if (act == rnn_activation::tanh) {
+        return tanhf(x);
+    }
+    return max(x, 0.0f);
+}
+
+static inline float rnn_clip_fp32(const float x, const float clip)
+{
+    return clip > 0.0f ? min(max(x, -clip), clip) : x;
+}
+
+// gate g of hidden unit j against h_prev row, reading the packed recurrence weight
+static inline float rnn_recurrent_dot_fp32(
+    const float *packed_R,
+    const float *h_row,
+    const int64_t hidden,
+    const int64_t num_gate,
+    const int64_t g,
+    const int64_t j)
+{
+    const int64_t blk = RNN_PACK_BLK();
+    const float *p_r  = packed_R + (j / blk) * hidden * num_gate * blk + g * blk + j % blk;
+    float sum         = 0.0f;
+    for (int64_t k = 0; k < hidden; ++k) {
+        sum += h_row[k] * p_r[k * num_gate * blk];
+    }
+    return sum;
+}
+
+void lstm_step_fp32(const rnn_step_fp32_args &args)
+{
+    const int64_t H = args.hidden;
+    const int64_t G = 4;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < args.batch; ++b) {
+        const float *h_prev = args.h_prev + b * H;
+        float *h_next       = args.h_next + b * H;
+        const float *xw     = args.xw_rows[b];
+        if (!xw) {
+            memcpy(h_next, h_prev, H * sizeof(float));
+            continue;
+        }
+        float *c = args.c + b * H;
+        float *y = args.y_rows[b];
+        for (int64_t j = 0; j < H; ++j) {
+            float gi = xw[0 * H + j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 0, j);
+            float go = xw[1 * H + j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 1, j);
+            float gf = xw[2 * H + j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 2, j);
+            float gc = xw[3 * H + j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 3, j);
+            if (args.P) {
+                gi += args.P[0 * H + j] * c[j];
+                gf += args.P[2 * H + j] * c[j];
+            }
+            gi = rnn_activation_fp32(rnn_clip_fp32(gi, args.clip), args.activations[0]);
+            gf = args.input_forget ? 1.0f - gi : rnn_activation_fp32(rnn_clip_fp32(gf, args.clip), args.activations[0]);
+            gc = rnn_activation_fp32(rnn_clip_fp32(gc, args.clip), args.activations[1]);
+            c[j] = gf * c[j] + gi * gc;
+            if (args.P) {
+                go += args.P[1 * H + j] * c[j];
+            }
+            go = rnn_activation_fp32(rnn_clip_fp32(go, args.clip), args.activations[0]);
+            h_next[j] = go * rnn_activation_fp32(c[j], args.activations[2]);
+        }
+        if (y) {
+            memcpy(y, h_next, H * sizeof(float));
+        }
+    }
+}
+
+void gru_step_fp32(const rnn_step_fp32_args &args)
+{
+    const int64_t H = args.hidden;
+    const int64_t G = 3;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < args.batch; ++b) {
+        const float *h_prev = args.h_prev + b * H;
+        float *h_next       = args.h_next + b * H;
+        const float *xw     = args.xw_rows[b];
+        if (!xw) {
+            memcpy(h_next, h_prev, H * sizeof(float));
+            continue;
+        }
+        float *z  = args.z + b * H;
+        float *rh = args.rh + b * H;
+        float *y  = args.y_rows[b];
+        for (int64_t j = 0; j < H; ++j) {
+            const float gz = xw[0 * H + j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 0, j);
+            const float gr = xw[1 * H + j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 1, j);
+            z[j]           = rnn_activation_fp32(rnn_clip_fp32(gz, args.clip), args.activations[0]);
+            const float r  = rnn_activation_fp32(rnn_clip_fp32(gr, args.clip), args.activations[0]);
+            if (args.linear_before_reset) {
+                const float rb = args.Rb_h ? args.Rb_h[j] : 0.0f;
+                rh[j]          = r * (rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, G, 2, j) + rb);
+            } else {
+                rh[j] = r * h_prev[j];
+            }
+        }
+        for (int64_t j = 0; j < H; ++j) {
+            float gh = xw[2 * H + j];
+            if (args.linear_before_reset) {
+                gh += rh[j];
+            } else {
+                gh += rnn_recurrent_dot_fp32(args.packed_R, rh, H, G, 2, j) + (args.Rb_h ? args.Rb_h[j] : 0.0f);
+            }
+            gh        = rnn_activation_fp32(rnn_clip_fp32(gh, args.clip), args.activations[1]);
+            h_next[j] = (1.0f - z[j]) * gh + z[j] * h_prev[j];
+        }
+        if (y) {
+            memcpy(y, h_next, H * sizeof(float));
+        }
+    }
+}
+
+void rnn_step_fp32(const rnn_step_fp32_args &args)
+{
+    const int64_t H = args.hidden;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < args.batch; ++b) {
+        const float *h_prev = args.h_prev + b * H;
+        float *h_next       = args.h_next + b * H;
+        const float *xw     = args.xw_rows[b];
+        if (!xw) {
+            memcpy(h_next, h_prev, H * sizeof(float));
+            continue;
+        }
+        float *y = args.y_rows[b];
+        for (int64_t j = 0; j < H; ++j) {
+            const float gi = xw[j] + rnn_recurrent_dot_fp32(args.packed_R, h_prev, H, 1, 0, j);
+            h_next[j]      = rnn_activation_fp32(rnn_clip_fp32(gi, args.clip), args.activations[0]);
+        }
+        if (y) {
+            memcpy(y, h_next, H * sizeof(float));
+        }
+    }
+}
+
+uint64_t rnn_fp32_get_packed_weight_bytes(
+    const rnn_fp32_param &param)
+{
+    const int64_t H = param.hidden_size;
+    return rnn_num_direction(param.direction) * round_up(H, RNN_PACK_BLK()) * H * rnn_num_gate(param.cell) * sizeof(float);
+}
+
+void rnn_fp32_pack_weight(
+    const rnn_fp32_param &param,
+    const float *R,
+    float *packed_R)
+{
+    const int64_t blk          = RNN_PACK_BLK();
+    const int64_t H            = param.hidden_size;
+    const int64_t G            = rnn_num_gate(param.cell);
+    const int64_t num_dir      = rnn_num_direction(param.direction);
+    const int64_t num_blk      = div_up(H, blk);
+    const int64_t dir_packed_len = num_blk * H * G * blk;
+
+#ifdef PPL_USE_X86_OMP_COLLAPSE
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
+#endif
+    for (int64_t d = 0; d < num_dir; ++d) {
+#ifndef PPL_USE_X86_OMP_COLLAPSE
+        PRAGMA_OMP_PARALLEL_FOR()
+#endif
+        for (int64_t hb = 0; hb < num_blk; ++hb) {
+            const float *l_R = R + d * G * H * H;
+            float *l_packed  = packed_R + d * dir_packed_len + hb * H * G * blk;
+            const int64_t j_eff = min<int64_t>(H - hb * blk, blk);
+            for (int64_t k = 0; k < H; ++k) {
+                for (int64_t g = 0; g < G; ++g) {
+                    float *dst = l_packed + (k * G + g) * blk;
+                    for (int64_t l = 0; l < j_eff; ++l) {
+                        dst[l] = l_R[(g * H + hb * blk + l) * H + k];
+                    }
+                    for (int64_t l = j_eff; l < blk; ++l) {
+                        dst[l] = 0.0f;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static gemm_v2_param_fp32 rnn_fp32_input_gemm_param(
+    const ppl::common::isa_t isa,
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_fp32_param &param)
+{
+    const int64_t seq_len    = X_shape->GetDim(0);
+    const int64_t batch      = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+
+    gemm_v2_param_fp32 gemm_param;
+    gemm_param.M        = seq_len * batch;
+    gemm_param.N        = rnn_num_gate(param.cell) * param.hidden_size;
+    gemm_param.K        = input_size;
+    gemm_param.lda      = input_size;
+    gemm_param.ldb      = input_size;
+    gemm_param.ldy      = gemm_param.N;
+    gemm_param.trans_B  = 1;
+    gemm_param.beta     = 1.0f;
+    gemm_param.c_type   = gemm_v2_C_type::vector_w;
+    gemm_param.isa_flag = isa;
+    return gemm_param;
+}
+
+static inline uint64_t rnn_fp32_align(const uint64_t bytes)
+{
+    return round_up(bytes, PPL_X86_CACHELINE_BYTES());
+}
+
+uint64_t rnn_fp32_get_buffer_bytes(
+    const ppl::common::isa_t isa,
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_fp32_param &param,
+    const bool has_packed_weight)
+{
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch   = X_shape->GetDim(1);
+    const int64_t H       = param.hidden_size;
+    const int64_t G       = rnn_num_gate(param.cell);
+
+    uint64_t bytes = 0;
+    bytes += rnn_fp32_align(seq_len * batch * G * H * sizeof(float)); // xw
+    bytes += rnn_fp32_align(G * H * sizeof(float)); // bias
+    bytes += 2 * rnn_fp32_align(batch * H * sizeof(float)); // h ping-pong
+    bytes += 3 * rnn_fp32_align(batch * H * sizeof(float)); // c or z/rh
+    bytes += 2 * rnn_fp32_align(batch * sizeof(void *)); // xw_rows, y_rows
+    if (!has_packed_weight) {
+        bytes += rnn_fp32_align(rnn_fp32_get_packed_weight_bytes(param));
+    }
+
+    auto executor = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(rnn_fp32_input_gemm_param(isa, X_shape, param)));
+    if (executor) {
+        bytes += rnn_fp32_align(executor->get_buffer_bytes());
+    }
+    return bytes;
+}
+
+ppl::common::RetCode rnn_fp32(
+    const ppl::common::isa_t isa,
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *W,
+    const float *R,
+    const float *packed_R,
+    const float *B,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const float *initial_c,
+    const float *P,
+    const rnn_fp32_param &param,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h,
+    float *Y_c)
+{
+    const int64_t seq_len    = X_shape->GetDim(0);
+    const int64_t batch      = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+    const int64_t H          = param.hidden_size;
+    const int64_t G          = rnn_num_gate(param.cell);
+    const int64_t num_dir    = rnn_num_direction(param.direction);
+    const int64_t num_act    = rnn_num_activation(param.cell);
+    const bool is_lstm       = param.cell == rnn_cell_type::lstm;
+    const bool is_gru        = param.cell == rnn_cell_type::gru;
+
+    uint8_t *buf = (uint8_t *)temp_buffer;
+    auto carve   = [&buf](const uint64_t bytes) -> uint8_t * {
+        uint8_t *p = buf;
+        buf += rnn_fp32_align(bytes);
+        return p;
+    };
+    float *xw            = (float *)carve(seq_len * batch * G * H * sizeof(float));
+    float *bias          = (float *)carve(G * H * sizeof(float));
+    float *h_state[2]    = {(float *)carve(batch * H * sizeof(float)), (float *)carve(batch * H * sizeof(float))};
+    float *c_state       = (float *)carve(batch * H * sizeof(float));
+    float *z_temp        = (float *)carve(batch * H * sizeof(float));
+    float *rh_temp       = (float *)carve(batch * H * sizeof(float));
+    const float **xw_rows = (const float **)carve(batch * sizeof(void *));
+    float **y_rows       = (float **)carve(batch * sizeof(void *));
+    if (!packed_R) {
+        float *l_packed_R = (float *)carve(rnn_fp32_get_packed_weight_bytes(param));
+        rnn_fp32_pack_weight(param, R, l_packed_R);
+        packed_R = l_packed_R;
+    }
+
+    auto gemm_param  = rnn_fp32_input_gemm_param(isa, X_shape, param);
+    auto executor    = std::unique_ptr<gemm_v2_executor_fp32>(create_gemm_v2_executor_fp32(gemm_param));
+    if (executor) {
+        executor->set_temp_buffer(carve(executor->get_buffer_bytes()));
+    }
+
+    if (Y && sequence_lens) {
+        memset(Y, 0, seq_len * num_dir * batch * H * sizeof(float));
+    }
+
+    const bool use_fma = (isa & ppl::common::ISA_X86_FMA) != 0;
+    void (*step_func)(const rnn_step_fp32_args &);
+    if (is_lstm) {
+        step_func = use_fma ? lstm_step_fp32_fma : lstm_step_fp32;
+    } else if (is_gru) {
+        step_func = use_fma ? gru_step_fp32_fma : gru_step_fp32;
+    } else {
+        step_func = use_fma ? rnn_step_fp32_fma : rnn_step_fp32;
+    }
+
+    const int64_t dir_packed_len = div_up(H, RNN_PACK_BLK()) * H * G * RNN_PACK_BLK();
+
+    for (int64_t d = 0; d < num_dir; ++d) {
+        const bool reverse = param.direction == rnn_direction::reverse || d == 1;
+
+        // every bias but gru's Rbh goes through the input projection
+        for (int64_t n = 0; n < G * H; ++n) {
+            float v = 0.0f;
+            if (B) {
+                v = B[d * 2 * G * H + n];
+                if (!is_gru || n < 2 * H) {
+                    v += B[d * 2 * G * H + G * H + n];
+                }
+            }
+            bias[n] = v;
+        }
+
+        // one gemm projects the whole sequence: xw = X * W^T + bias
+        const float *l_W = W + d * G * H * input_size;
+        if (executor) {
+            executor->get_param_mutable().src_A = X;
+            executor->get_param_mutable().src_B = l_W;
+            executor->get_param_mutable().src_C = bias;
+            executor->get_param_mutable().dst_Y = xw;
+            auto ret = executor->execute();
+            if (ret != ppl::common::RC_SUCCESS) {
+                return ret;
+            }
+        } else {
+            gemm_ref_fp32(X, l_W, bias, nullptr, 0, 1, gemm_param.M, gemm_param.N, gemm_param.K, 1.0f, 1.0f, xw);
+        }
+
+        if (initial_h) {
+            memcpy(h_state[0], initial_h + d * batch * H, batch * H * sizeof(float));
+        } else {
+            memset(h_state[0], 0, batch * H * sizeof(float));
+        }
+        if (is_lstm) {
+            if (initial_c) {
+                memcpy(c_state, initial_c + d * batch * H, batch * H * sizeof(float));
+            } else {
+                memset(c_state, 0, batch * H * sizeof(float));
+            }
+        }
+
+        rnn_step_fp32_args args;
+        args.xw_rows             = xw_rows;
+        args.packed_R            = packed_R + d * dir_packed_len;
+        args.Rb_h                = (is_gru && B) ? B + d * 2 * G * H + G * H + 2 * H : nullptr;
+        args.P                   = (is_lstm && P) ? P + d * 3 * H : nullptr;
+        args.c                   = c_state;
+        args.z                   = z_temp;
+        args.rh                  = rh_temp;
+        args.y_rows              = y_rows;
+        args.activations         = param.activations + d * num_act;
+        args.batch               = batch;
+        args.hidden              = H;
+        args.clip                = param.clip;
+        args.input_forget        = param.input_forget;
+        args.linear_before_reset = param.linear_before_reset;
+
+        int64_t cur = 0;
+        for (int64_t step = 0; step < seq_len; ++step) {
+            for (int64_t b = 0; b < batch; ++b) {
+                const int64_t len = sequence_lens ? min<int64_t>(sequence_lens[b], seq_len) : seq_len;
+                if (step >= len) {
+                    xw_rows[b] = nullptr;
+                    y_rows[b]  = nullptr;
+                } else {
+                    const int64_t t = reverse ? len - 1 - step : step;
+                    xw_rows[b]      = xw + (t * batch + b) * G * H;
+                    y_rows[b]       = Y ? Y + ((t * num_dir + d) * batch + b) * H : nullptr;
+                }
+            }
+            args.h_prev = h_state[cur];
+            args.h_next = h_state[cur ^ 1];
+            step_func(args);
+            cur ^= 1;
+        }
+
+        if (Y_h) {
+            memcpy(Y_h + d * batch * H, h_state[cur], batch * H * sizeof(float));
+        }
+        if (is_lstm && Y_c) {
+            memcpy(Y_c + d * batch * H, c_state, batch * H * sizeof(float));
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_RNN_RNN_STEP_FP32_H_
+#define __ST_PPL_KERNEL_X86_FP32_RNN_RNN_STEP_FP32_H_
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/rnn_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+#define RNN_PACK_BLK() 8
+
+// one timestep of one direction. input projection and every bias except
+// gru's Rbh are already summed into xw_rows.
+struct rnn_step_fp32_args {
+    const float **xw_rows; // [batch][num_gate * hidden], nullptr marks a row past its sequence length
+    const float *packed_R; // see rnn_fp32_pack_weight
+    const float *Rb_h; // gru only, recurrence bias of the h gate
+    const float *P; // lstm only, peephole [3][hidden], may be nullptr
+    const float *h_prev; // [batch][hidden]
+    float *h_next; // [batch][hidden]
+    float *c; // lstm only, cell state updated in place
+    float *z; // gru only, update gate scratch [batch][hidden]
+    float *rh; // gru only, r * h_prev scratch [batch][hidden]
+    float **y_rows; // [batch], entries may be nullptr
+    const rnn_activation_t *activations;
+    int64_t batch;
+    int64_t hidden;
+    float clip;
+    int32_t input_forget;
+    int32_t linear_before_reset;
+};
+
+void lstm_step_fp32(const rnn_step_fp32_args &args);
+void gru_step_fp32(const rnn_step_fp32_args &args);
+void rnn_step_fp32(const rnn_step_fp32_args &args);
+
+void lstm_step_fp32_fma(const rnn_step_fp32_args &args);
+void gru_step_fp32_fma(const rnn_step_fp32_args &args);
+void rnn_step_fp32_fma(const rnn_step_fp32_args &args);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -19,6 +19,7 @@
 #include <math.h>
 
 #include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/parallel_for.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -36,8 +37,8 @@ ppl::common::RetCode sigmoid_fp32(
     const int64_t unroll_n    = 16;
     const int64_t unroll_body = round(n_elem, unroll_n);
 
-    PRAGMA_OMP_PARALLEL_FOR()
-    for (int64_t i = 0; i < unroll_body; i += unroll_n) {
+    parallel_for(unroll_body / unroll_n, [&](const int64_t b) {
+        const int64_t i = b * unroll_n;
         _OP_SS(y[i + 0], x[i + 0]);
         _OP_SS(y[i + 8 + 0], x[i + 8 + 0]);
         _OP_SS(y[i + 1], x[i + 1]);
@@ -54,7 +55,7 @@ ppl::common::RetCode sigmoid_fp32(
         _OP_SS(y[i + 8 + 6], x[i + 8 + 6]);
         _OP_SS(y[i + 7], x[i + 7]);
         _OP_SS(y[i + 8 + 7], x[i + 8 + 7]);
-    }
+    });
     for (int64_t i = unroll_body; i < n_elem; ++i) {
         _OP_SS(y[i + 0], x[i + 0]);
     }
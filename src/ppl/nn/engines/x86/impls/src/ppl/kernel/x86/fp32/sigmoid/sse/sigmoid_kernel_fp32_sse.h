@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_SIGMOID_SSE_SIGMOID_KERNEL_FP32_SSE_H_
+#define __ST_PPL_KERNEL_X86_FP32_SIGMOID_SSE_SIGMOID_KERNEL_FP32_SSE_H_
+
+#include <nmmintrin.h>
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline __m128 _sse_sigmoid_ps(__m128 value)
+{
+    value = _mm_max_ps(_mm_set1_ps(-18.0f), value);
+    value = _mm_min_ps(_mm_set1_ps(18.0f), value);
+
+    __m128 value_squared = _mm_mul_ps(value, value);
+
+    __m128 p;
+    p = _mm_mul_ps(value_squared, _mm_set1_ps(4.37031012579801e-11f));
+    p = _mm_add_ps(p, _mm_set1_ps(1.15627324459942e-07f));
+    p = _mm_mul_ps(p, value_squared);
+    p = _mm_add_ps(p, _mm_set1_ps(6.08574864600143e-05f));
+    p = _mm_mul_ps(p, value_squared);
+    p = _mm_add_ps(p, _mm_set1_ps(8.51377133304701e-03f));
+    p = _mm_mul_ps(p, value_squared);
+    p = _mm_add_ps(p, _mm_set1_ps(2.48287947061529e-01f));
+    p = _mm_mul_ps(p, value);
+
+    __m128 q;
+    q = _mm_mul_ps(value_squared, _mm_set1_ps(6.10247389755681e-13f));
+    q = _mm_add_ps(q, _mm_set1_ps(5.76102136993427e-09f));
+    q = _mm_mul_ps(q, value_squared);
+    q = _mm_add_ps(q, _mm_set1_ps(6.29106785017040e-06f));
+    q = _mm_mul_ps(q, value_squared);
+    q = _mm_add_ps(q, _mm_set1_ps(1.70198817374094e-03f));
+    q = _mm_mul_ps(q, value_squared);
+    q = _mm_add_ps(q, _mm_set1_ps(1.16817656904453e-01f));
+    q = _mm_mul_ps(q, value_squared);
+    q = _mm_add_ps(q, _mm_set1_ps(9.93151921023180e-01f));
+
+    __m128 dst = _mm_add_ps(_mm_div_ps(p, q), _mm_set1_ps(0.5f));
+    return dst;
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
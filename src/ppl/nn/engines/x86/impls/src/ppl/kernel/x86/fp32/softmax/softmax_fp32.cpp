@@ -57,4 +57,52 @@ ppl::common::RetCode softmax_ndarray_fp32(
     return ppl::common::RC_SUCCESS;
 }
 
+ppl::common::RetCode softmax_n16cx_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const int64_t axis,
+    float *dst)
+{
+    if (src_shape->GetDataFormat() != ppl::common::DATAFORMAT_N16CX || axis != 1) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t c_blk    = 16;
+    const int64_t batch    = src_shape->GetDim(0);
+    const int64_t channels = src_shape->GetDim(1);
+    const int64_t padded_c = round_up(channels, c_blk);
+    int64_t inner_dim      = 1;
+    for (int64_t i = 2; i < src_shape->GetDimCount(); i++) {
+        inner_dim *= src_shape->GetDim(i);
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < batch; b++) {
+        const float *p_src = src + b * padded_c * inner_dim;
+        float *p_dst       = dst + b * padded_c * inner_dim;
+
+        float exp_sum = 0.0f;
+        for (int64_t c = 0; c < padded_c; c += c_blk) {
+            const int64_t c_eff = min<int64_t>(channels - c, c_blk);
+            for (int64_t j = 0; j < inner_dim; j++) {
+                const int64_t offset = c * inner_dim + j * c_blk;
+                for (int64_t k = 0; k < c_eff; k++) {
+                    float exp_val     = expf(p_src[offset + k]);
+                    p_dst[offset + k]     = exp_val;
+                    exp_sum += exp_val;
+                }
+                for (int64_t k = c_eff; k < c_blk; k++) {
+                    p_dst[offset + k] = 0.0f;
+                }
+            }
+        }
+        const float r_exp_sum = 1.0f / exp_sum;
+        for (int64_t j = 0; j < padded_c * inner_dim; j++) {
+            p_dst[j] *= r_exp_sum;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
 }}} // namespace ppl::kernel::x86
@@ -126,4 +126,73 @@ ppl::common::RetCode softmax_ndarray_fp32_fma(
     return ppl::common::RC_SUCCESS;
 }
 
+ppl::common::RetCode softmax_n16cx_fp32_fma(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const int64_t axis,
+    float *dst)
+{
+    if (src_shape->GetDataFormat() != ppl::common::DATAFORMAT_N16CX || axis != 1) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t simd_w   = 8;
+    const int64_t c_blk    = 16;
+    const int64_t batch    = src_shape->GetDim(0);
+    const int64_t channels = src_shape->GetDim(1);
+    const int64_t padded_c = round_up(channels, c_blk);
+    int64_t inner_dim      = 1;
+    for (int64_t i = 2; i < src_shape->GetDimCount(); i++) {
+        inner_dim *= src_shape->GetDim(i);
+    }
+    // channel blocks without padding can be processed as a flat array
+    const int64_t full_len = (channels / c_blk) * c_blk * inner_dim;
+    const int64_t c_tail   = channels % c_blk;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t b = 0; b < batch; b++) {
+        const float *p_src = src + b * padded_c * inner_dim;
+        float *p_dst       = dst + b * padded_c * inner_dim;
+
+        __m256 v_exp_sum_0 = _mm256_setzero_ps();
+        __m256 v_exp_sum_1 = _mm256_setzero_ps();
+        for (int64_t j = 0; j < full_len; j += c_blk) {
+            const __m256 v_exp_val_0 = _fma_exp_ps(_mm256_loadu_ps(p_src + j + 0 * simd_w));
+            const __m256 v_exp_val_1 = _fma_exp_ps(_mm256_loadu_ps(p_src + j + 1 * simd_w));
+            _mm256_storeu_ps(p_dst + j + 0 * simd_w, v_exp_val_0);
+            _mm256_storeu_ps(p_dst + j + 1 * simd_w, v_exp_val_1);
+            v_exp_sum_0 = _mm256_add_ps(v_exp_sum_0, v_exp_val_0);
+            v_exp_sum_1 = _mm256_add_ps(v_exp_sum_1, v_exp_val_1);
+        }
+
+        float temp[simd_w];
+        _mm256_storeu_ps(temp, _mm256_add_ps(v_exp_sum_0, v_exp_sum_1));
+        float exp_sum = 0.0f;
+        for (int64_t k = 0; k < simd_w; k++) {
+            exp_sum += temp[k];
+        }
+
+        if (c_tail) { // padded lanes of the last block are set to zero
+            for (int64_t j = 0; j < inner_dim; j++) {
+                const int64_t offset = full_len + j * c_blk;
+                for (int64_t k = 0; k < c_tail; k++) {
+                    float exp_val     = expf(p_src[offset + k]);
+                    p_dst[offset + k] = exp_val;
+                    exp_sum += exp_val;
+                }
+                for (int64_t k = c_tail; k < c_blk; k++) {
+                    p_dst[offset + k] = 0.0f;
+                }
+            }
+        }
+
+        const __m256 v_r_exp_sum = _mm256_set1_ps(1.0f / exp_sum);
+        for (int64_t j = 0; j < padded_c * inner_dim; j += simd_w) {
+            _mm256_storeu_ps(p_dst + j, _mm256_mul_ps(_mm256_loadu_ps(p_dst + j), v_r_exp_sum));
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
 }}} // namespace ppl::kernel::x86
@@ -17,6 +17,8 @@
 
 #include "ppl/kernel/x86/common/internal_include.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <functional>
 
@@ -50,6 +52,58 @@ uint64_t topk_ndarray_fp32_get_buffer_bytes(
     return temp_buffer_size * PPL_OMP_MAX_THREADS();
 }
 
+template <sort_order_t order>
+inline bool topk_beats_fp32(const float a, const float b)
+{
+    return order == SMALLEST ? a < b : a > b;
+}
+
+// top-k of one strided row into temp[0, k), element indices are offset by base_idx.
+// small k keeps a bounded heap whose root is the current k-th element, most of the row
+// is rejected by a single compare against it. large k falls back to nth_element.
+template <sort_order_t order, bool sorted>
+static void topk_select_row_fp32(
+    const float *src,
+    const int64_t stride,
+    const int64_t length,
+    const int64_t base_idx,
+    const int64_t k,
+    element_t<order> *temp)
+{
+    const int64_t small_k_max = 128;
+    if (k <= small_k_max && k * 8 <= length) {
+        for (int64_t i = 0; i < k; i++) {
+            temp[i].data = src[i * stride];
+            temp[i].idx  = base_idx + i;
+        }
+        std::make_heap(temp, temp + k, std::less<element_t<order>>());
+        float kth_value = temp[0].data;
+        for (int64_t i = k; i < length; i++) {
+            const float v = src[i * stride];
+            // equal values never replace the root, the root always has a smaller index
+            if (topk_beats_fp32<order>(v, kth_value)) {
+                std::pop_heap(temp, temp + k, std::less<element_t<order>>());
+                temp[k - 1].data = v;
+                temp[k - 1].idx  = base_idx + i;
+                std::push_heap(temp, temp + k, std::less<element_t<order>>());
+                kth_value = temp[0].data;
+            }
+        }
+        if (sorted) {
+            std::sort_heap(temp, temp + k, std::less<element_t<order>>());
+        }
+    } else {
+        for (int64_t i = 0; i < length; i++) {
+            temp[i].data = src[i * stride];
+            temp[i].idx  = base_idx + i;
+        }
+        std::nth_element(temp, temp + k, temp + length, std::less<element_t<order>>());
+        if (sorted) {
+            std::sort(temp, temp + k, std::less<element_t<order>>());
+        }
+    }
+}
+
 template <sort_order_t order, bool sorted>
 ppl::common::RetCode topk_ndarray_kernel_fp32(
     const ppl::nn::TensorShape *src_shape,
@@ -74,8 +128,49 @@ ppl::common::RetCode topk_ndarray_kernel_fp32(
         inner_dim *= src_shape->GetDim(i);
     }
 
+    if (k <= 0) {
+        return ppl::common::RC_SUCCESS;
+    }
+
     const uint64_t temp_buffer_size = round_up(axis_dim * sizeof(element_t<order>), PPL_X86_CACHELINE_BYTES());
 
+    // too few rows to feed every thread: split each row into segments,
+    // take a partial top-k per segment, then select the top-k of the partials
+    const int64_t num_threads = PPL_OMP_MAX_THREADS();
+    const int64_t min_seg_len = max<int64_t>(4096, 4 * k);
+    const int64_t num_seg     = min<int64_t>(num_threads, axis_dim / min_seg_len);
+    if (outer_dim * inner_dim < num_threads && num_seg > 1) {
+        const int64_t seg_len = div_up(axis_dim, num_seg);
+        element_t<order> *merge_temp = (element_t<order>*)temp_buffer;
+        for (int64_t od = 0; od < outer_dim; od++) {
+            for (int64_t id = 0; id < inner_dim; id++) {
+                const float *l_src = src + od * axis_dim * inner_dim + id;
+                PRAGMA_OMP_PARALLEL_FOR()
+                for (int64_t s = 0; s < num_seg; s++) {
+                    element_t<order>* l_temp = (element_t<order>*)((uint8_t*)temp_buffer + s * temp_buffer_size);
+                    const int64_t seg_start  = s * seg_len;
+                    const int64_t seg_eff    = min<int64_t>(axis_dim - seg_start, seg_len);
+                    topk_select_row_fp32<order, false>(l_src + seg_start * inner_dim, inner_dim, seg_eff, seg_start, k, l_temp);
+                }
+                for (int64_t s = 1; s < num_seg; s++) {
+                    const element_t<order>* l_temp = (element_t<order>*)((uint8_t*)temp_buffer + s * temp_buffer_size);
+                    memcpy(merge_temp + s * k, l_temp, k * sizeof(element_t<order>));
+                }
+                std::nth_element(merge_temp, merge_temp + k, merge_temp + num_seg * k, std::less<element_t<order>>());
+                if (sorted) {
+                    std::sort(merge_temp, merge_temp + k, std::less<element_t<order>>());
+                }
+                float *l_values = values + od * k * inner_dim + id;
+                int64_t *l_ind  = indices + od * k * inner_dim + id;
+                for (int64_t i = 0; i < k; i++) {
+                    l_values[i * inner_dim] = merge_temp[i].data;
+                    l_ind[i * inner_dim]    = merge_temp[i].idx;
+                }
+            }
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
 #ifdef PPL_USE_X86_OMP_COLLAPSE
     PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
 #else
@@ -87,15 +182,8 @@ ppl::common::RetCode topk_ndarray_kernel_fp32(
             const float *l_src     = src + od * axis_dim * inner_dim + id;
             float *l_values        = values + od * k * inner_dim + id;
             int64_t *l_ind         = indices + od * k * inner_dim + id;
-            for (uint32_t i = 0; i < axis_dim; i++) {
-                l_temp[i].data = l_src[i * inner_dim];
-                l_temp[i].idx  = i;
-            }
-            std::nth_element(l_temp, l_temp + k, l_temp + axis_dim, std::less<element_t<order>>());
-            if (sorted) {
-                std::sort(l_temp, l_temp + k, std::less<element_t<order>>());
-            }
-            for (uint32_t i = 0; i < k; i++) {
+            topk_select_row_fp32<order, sorted>(l_src, inner_dim, axis_dim, 0, k, l_temp);
+            for (int64_t i = 0; i < k; i++) {
                 l_values[i * inner_dim] = l_temp[i].data;
                 l_ind[i * inner_dim]    = l_temp[i].idx;
             }
@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include <stdio.h>
+
+#include "ppl/kernel/x86/common/thread_pool.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include "ppl/kernel/x86/common/parallel_for.h"
+#include "ppl/kernel/x86/fp32/relu.h"
+#include "ppl/common/sys.h"
+#include "simple_flags.h"
+
+Define_bool_opt("--help", Flag_help, false, "show these help information");
+Define_int32(num_threads, 0, "(0) number of threads, 0 for the default of openmp");
+Define_int64(spin_count, ppl::kernel::x86::thread_pool::default_spin_count, "(65536) polls before an idle worker of the thread pool sleeps");
+Define_int64(elems, 4096, "(4096) number of elements of each relu");
+Define_int32(warm_up, 100, "(100) warm up iterations");
+Define_int32(iters, 10000, "(10000) benchmark iterations");
+
+// measures the average time of each op in microseconds
+template <typename Func>
+static double bench(const Func &op)
+{
+    for (int32_t i = 0; i < Flag_warm_up; ++i) {
+        op();
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t i = 0; i < Flag_iters; ++i) {
+        op();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e3 / Flag_iters;
+}
+
+int main(int argc, char **argv) {
+    simple_flags::parse_args(argc, argv);
+    if (Flag_help) {
+        simple_flags::print_args_info();
+        return 0;
+    }
+
+    using namespace ppl::kernel::x86;
+
+    int32_t num_threads = Flag_num_threads;
+    if (num_threads > 0) {
+        set_omp_num_threads(num_threads);
+    } else {
+        num_threads = get_omp_max_threads();
+    }
+    std::vector<int32_t> cores(num_threads);
+    for (int32_t i = 0; i < num_threads; ++i) {
+        cores[i] = i;
+    }
+
+    std::cerr << "==============================================================\n";
+    fprintf(stderr, "num_threads=%d\nspin_count=%ld\nelems=%ld\nwarm_up=%d\niters=%d\n", num_threads,
+            Flag_spin_count, Flag_elems, Flag_warm_up, Flag_iters);
+    std::cerr << "==============================================================\n";
+
+    ppl::nn::TensorShape shape;
+    shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    shape.Reshape({Flag_elems});
+    std::vector<float> x(Flag_elems, -1.0f), y(Flag_elems);
+    const bool use_avx = ppl::common::GetCpuISA() & ppl::common::ISA_X86_AVX;
+
+    std::vector<int64_t> counters(num_threads * 16);
+    auto empty_op = [&]() {
+        parallel_for(num_threads, [&](const int64_t i) {
+            ++counters[i * 16];
+        });
+    };
+    auto relu_op = [&]() {
+        if (use_avx) {
+            relu_fp32_avx(&shape, x.data(), y.data());
+        } else {
+            relu_fp32_sse(&shape, x.data(), y.data());
+        }
+    };
+    // a relu on the current backend followed by one on OpenMP, as in graphs where only some kernels use the pool.
+    // workers of the pool spin on the cores of OpenMP threads unless they are parked.
+    auto mixed_op = [&](const bool park) {
+        relu_op();
+        thread_pool *prev_pool = set_thread_pool(nullptr);
+        if (prev_pool && park) {
+            prev_pool->park();
+        }
+        relu_op();
+        set_thread_pool(prev_pool);
+    };
+
+    // an OpenMP relu between binding threads to the cpu set and restoring them, as paid by each op if threads were
+    // bound per kernel instead of once per run. kernels using the thread pool leave OpenMP threads alone.
+    auto relu_rebind_op = [&]() {
+        omp_core_binding_t prev_binding;
+        swap_omp_core_binding(cores.data(), num_threads, &prev_binding);
+        relu_op();
+        restore_omp_core_binding(prev_binding);
+    };
+
+    std::cerr << "backend,bind,case,avg_us\n";
+    const char *backends[] = {"openmp", "thread_pool"};
+    // without a cpu set, then with the i-th thread bound to the i-th core
+    for (int32_t bind = 0; bind < 2; ++bind) {
+        if (bind) {
+            set_omp_core_binding(cores.data(), num_threads, 0);
+        }
+        std::unique_ptr<thread_pool> pool(new thread_pool(num_threads, bind ? cores.data() : nullptr, Flag_spin_count));
+        for (int32_t b = 0; b < 2; ++b) {
+            set_thread_pool(b == 0 ? nullptr : pool.get());
+            fprintf(stderr, "%s,%d,empty,%.3f\n", backends[b], bind, bench(empty_op));
+            fprintf(stderr, "%s,%d,relu,%.3f\n", backends[b], bind, bench(relu_op));
+            fprintf(stderr, "%s,%d,mixed,%.3f\n", backends[b], bind, bench([&]() { mixed_op(false); }));
+            if (b == 1) {
+                fprintf(stderr, "%s,%d,mixed_parked,%.3f\n", backends[b], bind, bench([&]() { mixed_op(true); }));
+            }
+            if (b == 0 && bind) {
+                fprintf(stderr, "%s,%d,relu_rebind,%.3f\n", backends[b], bind, bench(relu_rebind_op));
+            }
+        }
+        set_thread_pool(nullptr);
+    }
+
+    return 0;
+}
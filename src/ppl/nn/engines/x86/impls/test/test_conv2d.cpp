@@ -35,6 +35,7 @@
 #endif
 
 #include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/fp32/pd_conv2d.h"
 #include "ppl/kernel/x86/fp32/reorder.h"
 #include "ppl/kernel/x86/common/math.h"
 #include "ppl/kernel/x86/common/macros.h"
@@ -78,6 +79,9 @@ Define_int32(min_iter, 4, "(4) min benchmark iterations");
 Define_float(min_second, 0.5, "(0.5) min benchmark seconds");
 Define_int32(relu, 0, "(0) fuse relu, 0,1 or 6 for relu6");
 Define_bool(sum, false, "(false) fuse eltwise sum");
+Define_string(post_op, "", "(none) fuse post activation, sigmoid, swish, hswish, leaky_relu or clip");
+Define_bool(post_sum, false, "(false) fuse eltwise sum after activation");
+Define_string(pd, "", "(none) run fused pd_conv2d, dw appends a 3x3 depthwise conv to a pointwise case, pw appends a pointwise conv to a depthwise case");
 Define_bool(validate, false, "(false) do result validation");
 Define_float(eps, 1e-6, "(1e-6) rel error trunk for validation");
 Define_bool(dynamic, false, "(false) prepare and alloc temp buffer for each run");
@@ -159,6 +163,24 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             .output_format = ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_winograd_b2f3_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            .algo_type = ppl::kernel::x86::conv2d_fp32_algo::winograd_b2f3,
+            .isa = ppl::common::ISA_X86_FMA,
+            .input_format = ppl::common::DATAFORMAT_N16CX,
+            .output_format = ppl::common::DATAFORMAT_N16CX
+        })
+    },
+    {
+        "n16cx_winograd_b2f3_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            .algo_type = ppl::kernel::x86::conv2d_fp32_algo::winograd_b2f3,
+            .isa = ppl::common::ISA_X86_AVX512,
+            .input_format = ppl::common::DATAFORMAT_N16CX,
+            .output_format = ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "n16cx_winograd_b4f3_fp32_fma",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -177,6 +199,24 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             .output_format = ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_winograd_b6f3_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            .algo_type = ppl::kernel::x86::conv2d_fp32_algo::winograd_b6f3,
+            .isa = ppl::common::ISA_X86_FMA,
+            .input_format = ppl::common::DATAFORMAT_N16CX,
+            .output_format = ppl::common::DATAFORMAT_N16CX
+        })
+    },
+    {
+        "n16cx_winograd_b6f3_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            .algo_type = ppl::kernel::x86::conv2d_fp32_algo::winograd_b6f3,
+            .isa = ppl::common::ISA_X86_AVX512,
+            .input_format = ppl::common::DATAFORMAT_N16CX,
+            .output_format = ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "n16cx_direct_fp32_fma",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -290,6 +330,16 @@ int main(int argc, char **argv) {
         Flag_relu = 0;
     }
 
+    if (Flag_sum && Flag_post_sum) {
+        std::cerr << "sum and post_sum cannot be fused together\n";
+        Flag_post_sum = false;
+    }
+
+    if (!Flag_pd.empty() && Flag_pd != "dw" && Flag_pd != "pw") {
+        std::cerr << "invalid pd flag\n";
+        Flag_pd = "";
+    }
+
     if (Flag_validate) {
         Flag_warm_up = 0;
         Flag_min_iter = 1;
@@ -299,8 +349,8 @@ int main(int argc, char **argv) {
     std::cerr << "==============================================================\n";
     fprintf(
         stderr,
-        "num_threads=%d\ndynamic=%d\navx512=%d\nwarm_up=%d\nmin_iter=%d\nmin_second=%f\nvalidate=%d\neps=%f\nrelu=%d\nsum=%d\n",
-        num_threads, Flag_dynamic, !Flag_disable_avx512, Flag_warm_up, Flag_min_iter, Flag_min_second, Flag_validate, Flag_eps, Flag_relu, Flag_sum
+        "num_threads=%d\ndynamic=%d\navx512=%d\nwarm_up=%d\nmin_iter=%d\nmin_second=%f\nvalidate=%d\neps=%f\nrelu=%d\nsum=%d\npost_op=%s\npost_sum=%d\npd=%s\n",
+        num_threads, Flag_dynamic, !Flag_disable_avx512, Flag_warm_up, Flag_min_iter, Flag_min_second, Flag_validate, Flag_eps, Flag_relu, Flag_sum, Flag_post_op.c_str(), Flag_post_sum, Flag_pd.c_str()
     );
 
 for (int64_t lcfg = 0; lcfg < Flag_loop_cfg; ++lcfg) {
@@ -371,6 +421,23 @@ for (int64_t lcfg = 0; lcfg < Flag_loop_cfg; ++lcfg) {
         } else if (Flag_relu == 6) {
             param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::relu6;
         }
+        param.fuse_param.leaky_relu_alpha = 0.1f;
+        param.fuse_param.clip_min = -1.0f;
+        param.fuse_param.clip_max = 1.0f;
+        if (Flag_post_op == "sigmoid") {
+            param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::sigmoid;
+        } else if (Flag_post_op == "swish") {
+            param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::swish;
+        } else if (Flag_post_op == "hswish") {
+            param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::hswish;
+        } else if (Flag_post_op == "leaky_relu") {
+            param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::leaky_relu;
+        } else if (Flag_post_op == "clip") {
+            param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::clip;
+        }
+        if (Flag_post_sum) {
+            param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::post_sum;
+        }
 
         if (Flag_mb > 0) {
             batch = Flag_mb;
@@ -435,11 +502,52 @@ DEBUG_TAG(A);
 
         auto conv_mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(param, algoinfo, &allocator);
 
-        if (!conv_mgr->is_supported()) {
+        if (!conv_mgr->is_supported() || !conv_mgr->is_fuse_supported(param.fuse_flag)) {
             delete conv_mgr;
             std::cerr << "," << "unsupported case\n";
             continue;
         }
+
+        // pd mode: the case conv is followed by a stride 1 conv that keeps num_output and spatial size,
+        // so dst, dst16 and dst_ref below hold the output of the fused pair
+        ppl::kernel::x86::conv2d_fp32_param post_param;
+        ppl::kernel::x86::conv2d_fp32_manager *post_conv_mgr = nullptr;
+        ppl::kernel::x86::pd_conv2d_fp32_manager *pd_conv_mgr = nullptr;
+        if (!Flag_pd.empty()) {
+            post_param = param;
+            post_param.channels = param.num_output;
+            post_param.stride_h = 1;
+            post_param.stride_w = 1;
+            post_param.dilation_h = 1;
+            post_param.dilation_w = 1;
+            if (Flag_pd == "dw") {
+                post_param.group = param.num_output;
+                post_param.kernel_h = 3;
+                post_param.kernel_w = 3;
+                post_param.pad_h = 1;
+                post_param.pad_w = 1;
+            } else {
+                post_param.group = 1;
+                post_param.kernel_h = 1;
+                post_param.kernel_w = 1;
+                post_param.pad_h = 0;
+                post_param.pad_w = 0;
+            }
+            auto post_algoinfo = ppl::kernel::x86::conv2d_algo_selector::select_algo(
+                ppl::common::DATAFORMAT_N16CX, post_param, algoinfo.isa);
+            auto pd_algoinfo = ppl::kernel::x86::pd_conv2d_algo_selector::select_algo(algoinfo, post_algoinfo);
+            if (pd_algoinfo.algo_type != ppl::kernel::x86::pd_conv2d_fp32_algo::unknown) {
+                post_conv_mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(post_param, post_algoinfo, &allocator);
+                pd_conv_mgr = ppl::kernel::x86::pd_conv2d_algo_selector::gen_algo(pd_algoinfo, conv_mgr, post_conv_mgr);
+            }
+            if (!pd_conv_mgr || !pd_conv_mgr->is_supported()) {
+                if (pd_conv_mgr) delete pd_conv_mgr;
+                if (post_conv_mgr) delete post_conv_mgr;
+                delete conv_mgr;
+                std::cerr << "," << "unsupported pd case\n";
+                continue;
+            }
+        }
 DEBUG_TAG(B);
 
         const int32_t wei_mod = 7;
@@ -451,7 +559,11 @@ DEBUG_TAG(B);
 
         const int64_t ic = param.channels / param.group;
         const int64_t oc = param.num_output / param.group;
-        const float gops = param.group * batch * ic * oc * param.kernel_h * param.kernel_w * dst_h * dst_w * 2.0f / 1e9f;
+        float gops = param.group * batch * ic * oc * param.kernel_h * param.kernel_w * dst_h * dst_w * 2.0f / 1e9f;
+        if (pd_conv_mgr) {
+            gops += post_param.group * batch * (post_param.channels / post_param.group) * (post_param.num_output / post_param.group) *
+                    post_param.kernel_h * post_param.kernel_w * dst_h * dst_w * 2.0f / 1e9f;
+        }
 
 DEBUG_TAG(C);
         ppl::nn::TensorShape src_shape;
@@ -480,6 +592,9 @@ DEBUG_TAG(C);
         bias_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
         bias_shape.Reshape({param.num_output});
 
+        ppl::nn::TensorShape post_filter_shape = filter_shape;
+        post_filter_shape.Reshape({post_param.num_output, post_param.channels / post_param.group, post_param.kernel_h, post_param.kernel_w});
+
 DEBUG_TAG(D);
         float *src = nullptr;
         float *dst = nullptr;
@@ -490,6 +605,9 @@ DEBUG_TAG(D);
         float *sum_src16 = nullptr;
         float *filter = nullptr;
         float *bias = nullptr;
+        float *post_filter = nullptr;
+        float *post_bias = nullptr;
+        float *mid_ref = nullptr;
         void *temp_buffer = nullptr;
         src = (float*)allocator.Alloc(src_shape.GetBytesIncludingPadding());
         filter = (float*)allocator.Alloc(filter_shape.GetBytesIncludingPadding());
@@ -508,6 +626,20 @@ DEBUG_TAG(E);
         for (uint64_t i = 0; i < src_shape.GetElementsIncludingPadding(); ++i) {
             src[i] = (rand() % src_mod + src_shift) * src_scale;
         }
+        if (pd_conv_mgr) {
+            post_filter = (float*)allocator.Alloc(post_filter_shape.GetBytesIncludingPadding());
+            post_bias = (float*)allocator.Alloc(bias_shape.GetBytesIncludingPadding());
+            if (!post_filter || !post_bias) {
+                std::cerr << "," << "post conv weights out of memory\n";
+                return -1;
+            }
+            for (uint64_t i = 0; i < post_filter_shape.GetElementsIncludingPadding(); ++i) {
+                post_filter[i] = (rand() % wei_mod + wei_shift) * wei_scale;
+            }
+            for (uint64_t i = 0; i < bias_shape.GetElementsIncludingPadding(); ++i) {
+                post_bias[i] = (rand() % wei_mod + wei_shift) * wei_scale * 10.0f;
+            }
+        }
 
 DEBUG_TAG(F);
         if (algoinfo.input_format == ppl::common::DATAFORMAT_N16CX) {
@@ -538,6 +670,13 @@ DEBUG_TAG(H);
                 return -1;
             }
             memset(dst_ref, 0, dst_shape.GetBytesIncludingPadding());
+            if (pd_conv_mgr) {
+                mid_ref = (float*)allocator.Alloc(dst_shape.GetBytesIncludingPadding());
+                if (!mid_ref) {
+                    std::cerr << "," << "mid_ref out of memory\n";
+                    return -1;
+                }
+            }
         }
 DEBUG_TAG(I);
         if (algoinfo.output_format == ppl::common::DATAFORMAT_N16CX) {
@@ -548,7 +687,7 @@ DEBUG_TAG(I);
             }
             memset(dst16, 0, dst16_shape.GetBytesIncludingPadding());
         }
-        if (Flag_sum) {
+        if (Flag_sum || Flag_post_sum) {
             sum_src = (float*)allocator.Alloc(dst_shape.GetBytesIncludingPadding());
             if (!sum_src) {
                 std::cerr << "," << "sum_src out of memory\n";
@@ -575,6 +714,10 @@ DEBUG_TAG(J);
             std::cerr << "," << "gen_cvt_weights failed\n";
             return -1;
         }
+        if (pd_conv_mgr && ppl::common::RC_SUCCESS != post_conv_mgr->gen_cvt_weights(post_filter, post_bias)) {
+            std::cerr << "," << "post gen_cvt_weights failed\n";
+            return -1;
+        }
 
 DEBUG_TAG(K);
         auto conv_exe = conv_mgr->gen_executor();
@@ -613,9 +756,47 @@ DEBUG_TAG(M);
             conv_exe->set_dst(dst16);
         }
 
+        ppl::kernel::x86::pd_conv2d_fp32_executor *pd_conv_exe = nullptr;
+        void *pd_temp_buffer = nullptr;
+        if (pd_conv_mgr) {
+            pd_conv_exe = pd_conv_mgr->gen_executor();
+            pd_conv_exe->set_src_shape(&src_shape);
+            pd_conv_exe->set_src(src16);
+            pd_conv_exe->set_dst_shape(&dst_shape);
+            pd_conv_exe->set_dst(dst16);
+            if (ppl::common::RC_SUCCESS != pd_conv_exe->prepare()) {
+                std::cerr << "," << "pd prepare failed\n";
+                return -1;
+            }
+            if (!Flag_dynamic) {
+                const uint64_t pd_temp_buffer_size = pd_conv_exe->cal_temp_buffer_size();
+                pd_temp_buffer = allocator.Alloc(pd_temp_buffer_size);
+                if (!pd_temp_buffer) {
+                    std::cerr << "," << "pd_temp_buffer out of memory\n";
+                    return -1;
+                }
+                memset(pd_temp_buffer, 0, pd_temp_buffer_size);
+                pd_conv_exe->set_temp_buffer(pd_temp_buffer);
+            }
+        }
+
 DEBUG_TAG(N);
         const bool with_profiler = conv_exe->init_profiler();
         for (int32_t i = 0; i < Flag_warm_up; ++i) {
+            if (pd_conv_exe) {
+                if (Flag_dynamic) {
+                    pd_conv_exe->prepare();
+                    pd_conv_exe->set_temp_buffer(allocator.Alloc(pd_conv_exe->cal_temp_buffer_size()));
+                }
+                if (ppl::common::RC_SUCCESS != pd_conv_exe->execute()) {
+                    std::cerr << "," << "pd execute failed\n";
+                    return -1;
+                }
+                if (Flag_dynamic) {
+                    allocator.Free(pd_conv_exe->temp_buffer());
+                }
+                continue;
+            }
             if (Flag_dynamic) {
                 conv_exe->prepare();
                 conv_exe->set_temp_buffer(allocator.Alloc(conv_exe->cal_temp_buffer_size()));
@@ -639,13 +820,24 @@ DEBUG_TAG(N);
 
         for (; tot_exe_iter < Flag_min_iter || tot_exe_us < Flag_min_second * 1e6; ++tot_exe_iter) {
             start = std::chrono::high_resolution_clock::now();
-            if (Flag_dynamic) {
-                conv_exe->prepare();
-                conv_exe->set_temp_buffer(allocator.Alloc(conv_exe->cal_temp_buffer_size()));
-            }
-            conv_exe->execute();
-            if (Flag_dynamic) {
-                allocator.Free(conv_exe->temp_buffer());
+            if (pd_conv_exe) {
+                if (Flag_dynamic) {
+                    pd_conv_exe->prepare();
+                    pd_conv_exe->set_temp_buffer(allocator.Alloc(pd_conv_exe->cal_temp_buffer_size()));
+                }
+                pd_conv_exe->execute();
+                if (Flag_dynamic) {
+                    allocator.Free(pd_conv_exe->temp_buffer());
+                }
+            } else {
+                if (Flag_dynamic) {
+                    conv_exe->prepare();
+                    conv_exe->set_temp_buffer(allocator.Alloc(conv_exe->cal_temp_buffer_size()));
+                }
+                conv_exe->execute();
+                if (Flag_dynamic) {
+                    allocator.Free(conv_exe->temp_buffer());
+                }
             }
             end = std::chrono::high_resolution_clock::now();
             double dur = (end - start).count() / 1e3;
@@ -677,10 +869,23 @@ DEBUG_TAG(O);
                     filter,
                     bias,
                     param,
-                    dst_ref)) {
+                    pd_conv_exe ? mid_ref : dst_ref)) {
                 std::cerr << "," << "conv2d_ref_fp32 failed\n";
                 return -1;
             }
+            if (pd_conv_exe && ppl::common::RC_SUCCESS != ppl::kernel::x86::conv2d_ref_fp32(
+                    &dst_shape,
+                    &dst_shape,
+                    &dst_shape,
+                    mid_ref,
+                    nullptr,
+                    post_filter,
+                    post_bias,
+                    post_param,
+                    dst_ref)) {
+                std::cerr << "," << "post conv2d_ref_fp32 failed\n";
+                return -1;
+            }
             if (algoinfo.output_format == ppl::common::DATAFORMAT_N16CX) {
                 if (ppl::common::RC_SUCCESS != ppl::kernel::x86::reorder_n16cx_ndarray_fp32_avx(&dst16_shape, dst16, dst)) {
                     std::cerr << "," << "reorder dst16 failed\n";
@@ -697,12 +902,21 @@ DEBUG_TAG(O);
         }
 
 DEBUG_TAG(Y);
+        if (pd_conv_exe) delete pd_conv_exe;
+        if (pd_conv_mgr) delete pd_conv_mgr;
+        if (post_conv_mgr) {
+            post_conv_mgr->release_cvt_weights();
+            delete post_conv_mgr;
+        }
         conv_mgr->release_cvt_weights();
         if (conv_mgr) delete conv_mgr;
         if (conv_exe) delete conv_exe;
         if (src) allocator.Free(src);
         if (filter) allocator.Free(filter);
         if (bias) allocator.Free(bias);
+        if (post_filter) allocator.Free(post_filter);
+        if (post_bias) allocator.Free(post_bias);
+        if (mid_ref) allocator.Free(mid_ref);
         if (dst) allocator.Free(dst);
         if (sum_src) allocator.Free(sum_src);
         if (dst_ref) allocator.Free(dst_ref);
@@ -711,6 +925,7 @@ DEBUG_TAG(Y);
         if (sum_src16) allocator.Free(sum_src16);
         if (!Flag_dynamic) {
             if (temp_buffer) allocator.Free(temp_buffer);
+            if (pd_temp_buffer) allocator.Free(pd_temp_buffer);
         }
 DEBUG_TAG(Z);
         std::cerr << "\n";
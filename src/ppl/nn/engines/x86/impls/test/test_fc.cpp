@@ -24,6 +24,7 @@
 #include <chrono>
 
 #include <float.h>
+#include <math.h>
 #include <string.h>
 
 #if defined(__linux__) && defined(PPL_USE_X86_OMP)
@@ -60,6 +61,37 @@ Define_int32(min_iter, 20, "(20) min benchmark iterations");
 Define_float(min_second, 1.0, "(1.0) min benchmark seconds");
 Define_bool(validate, false, "(false) do result validation");
 Define_float(eps, 1e-6, "(1e-6) rel error trunk for validation");
+Define_uint64(fuse_flag, 0, "(0) fc_fuse_flag to test, relu=1, sigmoid=2, sum=65536");
+Define_bool(fuse_bias, false, "(false) fold a second bias into the converted bias by fc_fp32_manager::fuse_bias");
+
+// applies what the fused fc does after the first bias as separate passes, like the unfused graph does
+void fc_unfused_post_ops_fp32(
+    const ppl::kernel::x86::fc_fuse_flag_t fuse_flag,
+    const float *extra_bias,
+    const float *sum_src,
+    const int64_t M,
+    const int64_t N,
+    float *dst)
+{
+    for (int64_t m = 0; m < M; ++m) {
+        for (int64_t n = 0; n < N; ++n) {
+            float result = dst[m * N + n];
+            if (extra_bias) {
+                result += extra_bias[n];
+            }
+            if (fuse_flag & ppl::kernel::x86::fc_fuse_flag::relu) {
+                result = result > 0.0f ? result : 0.0f;
+            }
+            if (fuse_flag & ppl::kernel::x86::fc_fuse_flag::sigmoid) {
+                result = 1.0f / (1.0f + expf(-result));
+            }
+            if (fuse_flag & ppl::kernel::x86::fc_fuse_flag::sum) {
+                result += sum_src[m * N + n];
+            }
+            dst[m * N + n] = result;
+        }
+    }
+}
 
 int main(int argc, char **argv) {
     simple_flags::parse_args(argc, argv);
@@ -141,6 +173,7 @@ int main(int argc, char **argv) {
         }
         param.channels = K;
         param.num_output = N;
+        param.fuse_flag = Flag_fuse_flag;
         if (Flag_mb) {
             M = Flag_mb;
         }
@@ -201,6 +234,9 @@ DEBUG_TAG(D);
         float *dst_ref = nullptr;
         float *filter = nullptr;
         float *bias = nullptr;
+        float *extra_bias = nullptr;
+        float *sum_src = nullptr;
+        float *dst_unfused = nullptr;
         void *temp_buffer = nullptr;
         src = (float*)allocator.Alloc(src_shape.GetBytesIncludingPadding());
         filter = (float*)allocator.Alloc(filter_shape.GetBytesIncludingPadding());
@@ -223,6 +259,27 @@ DEBUG_TAG(E);
         }
         memset(dst, 0, dst_shape.GetBytesIncludingPadding());
 
+        if (Flag_fuse_bias) {
+            extra_bias = (float*)allocator.Alloc(bias_shape.GetBytesIncludingPadding());
+            if (!extra_bias) {
+                std::cerr << "," << "extra_bias out of memory\n";
+                return -1;
+            }
+            for (uint64_t i = 0; i < bias_shape.GetElementsIncludingPadding(); ++i) {
+                extra_bias[i] = (rand() % wei_mod + wei_shift) * wei_scale;
+            }
+        }
+        if (param.fuse_flag & ppl::kernel::x86::fc_fuse_flag::sum) {
+            sum_src = (float*)allocator.Alloc(dst_shape.GetBytesIncludingPadding());
+            if (!sum_src) {
+                std::cerr << "," << "sum_src out of memory\n";
+                return -1;
+            }
+            for (uint64_t i = 0; i < dst_shape.GetElementsIncludingPadding(); ++i) {
+                sum_src[i] = (rand() % src_mod + src_shift) * src_scale;
+            }
+        }
+
 DEBUG_TAG(H);
         if (Flag_validate) {
             dst_ref = (float*)allocator.Alloc(dst_shape.GetBytesIncludingPadding());
@@ -231,6 +288,12 @@ DEBUG_TAG(H);
                 return -1;
             }
             memset(dst_ref, 0, dst_shape.GetBytesIncludingPadding());
+            dst_unfused = (float*)allocator.Alloc(dst_shape.GetBytesIncludingPadding());
+            if (!dst_unfused) {
+                std::cerr << "," << "dst_unfused out of memory\n";
+                return -1;
+            }
+            memset(dst_unfused, 0, dst_shape.GetBytesIncludingPadding());
         }
 
 DEBUG_TAG(J);
@@ -238,6 +301,10 @@ DEBUG_TAG(J);
             std::cerr << "," << "gen_cvt_weights failed\n";
             return -1;
         }
+        if (extra_bias && ppl::common::RC_SUCCESS != fc_mgr->fuse_bias(extra_bias)) {
+            std::cerr << "," << "fuse_bias failed\n";
+            return -1;
+        }
 
 DEBUG_TAG(K);
         auto fc_exe = fc_mgr->gen_executor();
@@ -259,6 +326,7 @@ DEBUG_TAG(L);
         fc_exe->set_temp_buffer(temp_buffer);
         fc_exe->set_src(src);
         fc_exe->set_dst(dst);
+        fc_exe->set_sum_src(sum_src);
 
 DEBUG_TAG(N);
         const bool with_profiler = fc_exe->init_profiler();
@@ -314,8 +382,47 @@ DEBUG_TAG(O);
                 std::cerr << "," << "gemm_ref_fp32 failed\n";
                 return -1;
             }
+            fc_unfused_post_ops_fp32(param.fuse_flag, extra_bias, sum_src, M, N, dst_ref);
             std::cerr << ",";
             check_array_error(dst, dst_ref, dst_shape.GetElementsIncludingPadding(), Flag_eps);
+
+            if (param.fuse_flag != ppl::kernel::x86::fc_fuse_flag::none || extra_bias) {
+                // fused fc against a plain fc followed by separate bias, activation and sum passes
+                ppl::kernel::x86::fc_fp32_param unfused_param = param;
+                unfused_param.fuse_flag = ppl::kernel::x86::fc_fuse_flag::none;
+                auto unfused_mgr = ppl::kernel::x86::fc_algo_selector::gen_algo(unfused_param, algoinfo, &allocator);
+                if (ppl::common::RC_SUCCESS != unfused_mgr->gen_cvt_weights(filter, bias)) {
+                    std::cerr << "," << "unfused gen_cvt_weights failed\n";
+                    return -1;
+                }
+                auto unfused_exe = unfused_mgr->gen_executor();
+                unfused_exe->set_src_shape(&src_shape);
+                unfused_exe->set_dst_shape(&dst_shape);
+                if (ppl::common::RC_SUCCESS != unfused_exe->prepare()) {
+                    std::cerr << "," << "unfused prepare failed\n";
+                    return -1;
+                }
+                void *unfused_temp_buffer = allocator.Alloc(unfused_exe->cal_temp_buffer_size());
+                if (!unfused_temp_buffer) {
+                    std::cerr << "," << "unfused temp_buffer out of memory\n";
+                    return -1;
+                }
+                unfused_exe->set_temp_buffer(unfused_temp_buffer);
+                unfused_exe->set_src(src);
+                unfused_exe->set_dst(dst_unfused);
+                if (ppl::common::RC_SUCCESS != unfused_exe->execute()) {
+                    std::cerr << "," << "unfused execute failed\n";
+                    return -1;
+                }
+                fc_unfused_post_ops_fp32(param.fuse_flag, extra_bias, sum_src, M, N, dst_unfused);
+                std::cerr << ",unfused:";
+                check_array_error(dst, dst_unfused, dst_shape.GetElementsIncludingPadding(), Flag_eps);
+
+                unfused_mgr->release_cvt_weights();
+                delete unfused_exe;
+                delete unfused_mgr;
+                allocator.Free(unfused_temp_buffer);
+            }
         }
 
         if (with_profiler) {
@@ -332,6 +439,9 @@ DEBUG_TAG(Y);
         if (bias) allocator.Free(bias);
         if (dst) allocator.Free(dst);
         if (dst_ref) allocator.Free(dst_ref);
+        if (dst_unfused) allocator.Free(dst_unfused);
+        if (extra_bias) allocator.Free(extra_bias);
+        if (sum_src) allocator.Free(sum_src);
         if (temp_buffer) allocator.Free(temp_buffer);
 DEBUG_TAG(Z);
         std::cerr << "\n";
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <fstream>
 #include <float.h>
+#include <math.h>
 #include <string.h>
 #include <chrono>
 #include <memory>
@@ -31,6 +32,7 @@
 #endif
 
 #include "ppl/kernel/x86/fp32/gemm_v2.h"
+#include "ppl/kernel/x86/fp32/matmul.h"
 #include "ppl/common/generic_cpu_allocator.h"
 #include "ppl/kernel/x86/common/simd_tools.h"
 #include "ppl/kernel/x86/common/internal_include.h"
@@ -82,6 +84,12 @@ ppl::common::RetCode gemm_v2_ref_fp32(const ppl::kernel::x86::gemm_v2_param_fp32
             if (param.fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::relu) {
                 result = ppl::kernel::x86::max(result, 0.0f);
             }
+            if (param.fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::sigmoid) {
+                result = 1.0f / (1.0f + expf(-result));
+            }
+            if (param.fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::sum) {
+                result += param.src_sum[m * param.ldsum + n];
+            }
             param.dst_Y[m * param.ldy + n] = result;
         }
     }
@@ -89,6 +97,31 @@ ppl::common::RetCode gemm_v2_ref_fp32(const ppl::kernel::x86::gemm_v2_param_fp32
     return ppl::common::RC_SUCCESS;
 }
 
+// applies the fused post-ops of param as separate passes over an unfused result, like the unfused graph does
+void gemm_v2_unfused_post_ops_fp32(const ppl::kernel::x86::gemm_v2_param_fp32& param) {
+    if (param.fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::relu) {
+        for (int32_t m = 0; m < param.M; m++) {
+            for (int32_t n = 0; n < param.N; n++) {
+                param.dst_Y[m * param.ldy + n] = ppl::kernel::x86::max(param.dst_Y[m * param.ldy + n], 0.0f);
+            }
+        }
+    }
+    if (param.fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::sigmoid) {
+        for (int32_t m = 0; m < param.M; m++) {
+            for (int32_t n = 0; n < param.N; n++) {
+                param.dst_Y[m * param.ldy + n] = 1.0f / (1.0f + expf(-param.dst_Y[m * param.ldy + n]));
+            }
+        }
+    }
+    if (param.fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::sum) {
+        for (int32_t m = 0; m < param.M; m++) {
+            for (int32_t n = 0; n < param.N; n++) {
+                param.dst_Y[m * param.ldy + n] += param.src_sum[m * param.ldsum + n];
+            }
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     simple_flags::parse_args(argc, argv);
     if (Flag_help) {
@@ -239,20 +272,36 @@ DEBUG_TAG(C);
             C[i] = (float)rand() / INT32_MAX - 0.5f;
         }
 
+        float* sum = nullptr;
+        if (fuse_flag & ppl::kernel::x86::gemm_v2_fuse_flag::sum) {
+            sum = (float*)allocator.Alloc(dst_num_bytes);
+            if (!sum) {
+                std::cerr << "," << "sum tensor out of memory\n";
+                return -1;
+            }
+            for (int64_t i = 0; i < dst_num_elements; i++) {
+                sum[i] = (float)rand() / INT32_MAX - 0.5f;
+            }
+        }
+
         float* dst_ref = nullptr;
+        float* dst_unfused = nullptr;
         if (Flag_validate) {
             dst_ref = (float*)allocator.Alloc(dst_num_bytes);
-            if (!dst_ref) {
+            dst_unfused = (float*)allocator.Alloc(dst_num_bytes);
+            if (!dst_ref || !dst_unfused) {
                 std::cerr << "," << "dst_ref out of memory\n";
                 return -1;
             }
             memset(dst_ref, 0, dst_num_bytes);
+            memset(dst_unfused, 0, dst_num_bytes);
         }
 DEBUG_TAG(D);
         ppl::kernel::x86::gemm_v2_param_fp32 param;
         param.src_A = A;
         param.src_B = B;
         param.src_C = C;
+        param.src_sum = sum;
         param.dst_Y = dst;
         param.M = M;
         param.N = N;
@@ -261,6 +310,7 @@ DEBUG_TAG(D);
         param.ldb = ldb;
         param.ldc = ldc;
         param.ldy = ldy;
+        param.ldsum = sum ? N : 0;
         param.alpha = alpha;
         param.beta = beta;
         param.trans_A = trans_A;
@@ -293,9 +343,92 @@ DEBUG_TAG(F);
         }
 
         if (Flag_validate) {
-            param.dst_Y = dst_ref;
-            gemm_v2_ref_fp32(param);
+            ppl::kernel::x86::gemm_v2_param_fp32 ref_param = param;
+            ref_param.dst_Y = dst_ref;
+            gemm_v2_ref_fp32(ref_param);
             check_array_error(dst, dst_ref, dst_num_elements, Flag_eps);
+
+            if (fuse_flag != ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+                // fused epilogue against a plain gemm followed by separate post-op passes
+                ppl::kernel::x86::gemm_v2_param_fp32 unfused_param = param;
+                unfused_param.fuse_flag = ppl::kernel::x86::gemm_v2_fuse_flag::none;
+                unfused_param.dst_Y = dst_unfused;
+                auto unfused_executor = std::unique_ptr<ppl::kernel::x86::gemm_v2_executor_fp32>(
+                    ppl::kernel::x86::create_gemm_v2_executor_fp32(unfused_param));
+                if (unfused_executor == nullptr) {
+                    fprintf(stderr, "cannot create unfused executor!\n");
+                    return -1;
+                }
+                unfused_executor->set_temp_buffer(temp_buffer);
+                if (unfused_executor->execute() != ppl::common::RC_SUCCESS) {
+                    fprintf(stderr, "unfused execute failed!\n");
+                    return -1;
+                }
+                unfused_param.fuse_flag = param.fuse_flag;
+                gemm_v2_unfused_post_ops_fp32(unfused_param);
+                std::cerr << ",unfused:";
+                check_array_error(dst, dst_unfused, dst_num_elements, Flag_eps);
+            }
+
+            // matmul only takes plain A * B with an optional vector_w bias
+            const bool matmul_case = !trans_A && !trans_B && alpha == 1.0f &&
+                (c_type == ppl::kernel::x86::gemm_v2_C_type::empty ||
+                 (c_type == ppl::kernel::x86::gemm_v2_C_type::vector_w && beta == 1.0f));
+            if (matmul_case) {
+                ppl::nn::TensorShape A_shape, B_shape, Y_shape;
+                A_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+                A_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+                A_shape.Reshape({M, K});
+                B_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+                B_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+                B_shape.Reshape({K, N});
+                Y_shape.SetDataType(ppl::common::DATATYPE_FLOAT32);
+                Y_shape.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+                Y_shape.Reshape({M, N});
+
+                const uint64_t matmul_buffer_bytes = ppl::kernel::x86::matmul_ndarray_fp32_get_buffer_bytes(
+                    &A_shape, &B_shape, param.isa_flag);
+                void* matmul_buffer = nullptr;
+                if (matmul_buffer_bytes > 0) {
+                    matmul_buffer = allocator.Alloc(matmul_buffer_bytes);
+                    if (!matmul_buffer) {
+                        std::cerr << "," << "matmul temp_buffer out of memory\n";
+                        return -1;
+                    }
+                }
+
+                const float* bias = c_type == ppl::kernel::x86::gemm_v2_C_type::vector_w ? C : nullptr;
+                ret = ppl::kernel::x86::matmul_ndarray_fused_fp32(
+                    &A_shape, &B_shape, &Y_shape, A, B, bias, sum, fuse_flag, param.isa_flag, matmul_buffer, dst_ref);
+                if (ret != ppl::common::RC_SUCCESS) {
+                    fprintf(stderr, "matmul_ndarray_fused_fp32 failed!\n");
+                    return -1;
+                }
+                ret = ppl::kernel::x86::matmul_ndarray_fp32(
+                    &A_shape, &B_shape, &Y_shape, A, B, param.isa_flag, matmul_buffer, dst_unfused);
+                if (ret != ppl::common::RC_SUCCESS) {
+                    fprintf(stderr, "matmul_ndarray_fp32 failed!\n");
+                    return -1;
+                }
+                if (bias) {
+                    for (int64_t m = 0; m < M; m++) {
+                        for (int64_t n = 0; n < N; n++) {
+                            dst_unfused[m * N + n] += bias[n];
+                        }
+                    }
+                }
+                ppl::kernel::x86::gemm_v2_param_fp32 unfused_param = param;
+                unfused_param.dst_Y = dst_unfused;
+                gemm_v2_unfused_post_ops_fp32(unfused_param);
+                std::cerr << ",matmul_fused:";
+                check_array_error(dst_ref, dst, dst_num_elements, Flag_eps);
+                std::cerr << ",matmul_unfused:";
+                check_array_error(dst_ref, dst_unfused, dst_num_elements, Flag_eps);
+
+                if (matmul_buffer) {
+                    allocator.Free(matmul_buffer);
+                }
+            }
         }
 DEBUG_TAG(G);
         std::chrono::high_resolution_clock::time_point start;
@@ -333,9 +466,15 @@ DEBUG_TAG(H);
         allocator.Free(A);
         allocator.Free(B);
         allocator.Free(C);
+        if (sum) {
+            allocator.Free(sum);
+        }
         if (dst_ref) {
             allocator.Free(dst_ref);
         }
+        if (dst_unfused) {
+            allocator.Free(dst_unfused);
+        }
         if (temp_buffer) {
             allocator.Free(temp_buffer);
         }
@@ -25,6 +25,58 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+static bool IsSameShape(const TensorShape& lhs, const TensorShape& rhs) {
+    if (lhs.GetDataType() != rhs.GetDataType() || lhs.GetDataFormat() != rhs.GetDataFormat() ||
+        lhs.GetDimCount() != rhs.GetDimCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < lhs.GetDimCount(); ++i) {
+        if (lhs.GetDim(i) != rhs.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  producers of an in-place concat bind their outputs to slices of a buffer shared through the device, and the
+  concat takes the whole buffer over as its output. returns RC_NOT_FOUND if `tensor` should be allocated as usual.
+*/
+RetCode X86Kernel::BindInplaceConcatBuffer(const InplaceConcatBinding& binding, TensorImpl* tensor) {
+    auto device = GetX86Device();
+    auto info = binding.info.get();
+
+    if (binding.input_idx == InplaceConcatBinding::CONCAT_OUTPUT) {
+        auto buffer = device->GetSharedBuffer(info);
+        if (!buffer->addr || !IsSameShape(tensor->GetShape(), info->output_shape)) {
+            // the shared buffer, if any, is still referenced by inputs and is freed in AfterExecute()
+            return RC_NOT_FOUND;
+        }
+        tensor->SetBuffer(*buffer, device, true);
+        device->DetachSharedBuffer(info);
+        return RC_SUCCESS;
+    }
+
+    if (!IsSameShape(tensor->GetShape(), info->input_shapes[binding.input_idx]) ||
+        info->input_offsets[binding.input_idx] % device->GetAllocator()->GetAlignment() != 0) {
+        return RC_NOT_FOUND;
+    }
+
+    auto buffer = device->GetSharedBuffer(info);
+    if (!buffer->addr) {
+        auto status = device->Realloc(info->output_shape, buffer);
+        if (status != RC_SUCCESS) {
+            device->DetachSharedBuffer(info);
+            return status;
+        }
+    }
+
+    BufferDesc view = *buffer;
+    view.addr = (char*)buffer->addr + info->input_offsets[binding.input_idx];
+    tensor->SetBuffer(view, device, false);
+    return RC_SUCCESS;
+}
+
 RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
     auto status = Reshape(ctx);
     if (status != RC_SUCCESS) {
@@ -32,8 +84,27 @@ RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
         return status;
     }
 
+    // kernels that may share input buffers are never bound to in-place concats. see OptGraph::InplaceConcat().
+    if (CanShareInputBuffer(*ctx)) {
+        return RC_SUCCESS;
+    }
+
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
         auto tensor = ctx->GetOutput<TensorImpl>(i);
+
+        if (common_param_ && i < common_param_->inplace_concat_bindings.size() &&
+            common_param_->inplace_concat_bindings[i].info) {
+            status = BindInplaceConcatBuffer(common_param_->inplace_concat_bindings[i], tensor);
+            if (status == RC_SUCCESS) {
+                continue;
+            }
+            if (status != RC_NOT_FOUND) {
+                LOG(ERROR) << "BindInplaceConcatBuffer for tensor[" << tensor->GetName()
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+
         status = tensor->ReallocBuffer();
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "ReallocBuffer for tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
@@ -44,6 +115,20 @@ RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
     return RC_SUCCESS;
 }
 
+void X86Kernel::AfterExecute() {
+    if (!common_param_) {
+        return;
+    }
+
+    // shared buffers that are not taken over by concat outputs are useless from now on
+    for (auto it = common_param_->inplace_concat_bindings.begin(); it != common_param_->inplace_concat_bindings.end();
+         ++it) {
+        if (it->info && it->input_idx == InplaceConcatBinding::CONCAT_OUTPUT) {
+            GetX86Device()->FreeSharedBuffer(it->info.get());
+        }
+    }
+}
+
 bool X86Kernel::CanDoExecute(const KernelExecContext& ctx) const {
     for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
         auto tensor = ctx.GetInput<TensorImpl>(i);
@@ -59,14 +144,16 @@ RetCode X86Kernel::Execute(KernelExecContext* ctx) {
     utils::CpuTimingGuard __timing_guard__(&begin_ts_, &end_ts_, ctx->IsProfilingEnabled());
 #endif
 
+    X86Device::ThreadingScope threading_scope(GetX86Device(), UsesThreadPool());
+
     auto status = BeforeExecute(ctx);
-    if (status != RC_SUCCESS) {
+    if (status == RC_SUCCESS) {
+        if (CanDoExecute(*ctx)) {
+            status = DoExecute(ctx);
+        }
+        AfterExecute();
+    } else {
         LOG(ERROR) << "BeforeExecute() of kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
-        return status;
-    }
-
-    if (CanDoExecute(*ctx)) {
-        status = DoExecute(ctx);
     }
 
     return status;
@@ -52,8 +52,16 @@ public:
 
 protected:
     virtual bool CanDoExecute(const KernelExecContext&) const;
+    /** outputs are not allocated before DoExecute() if they are going to be views of inputs. called after Reshape(). */
+    virtual bool CanShareInputBuffer(const KernelExecContext&) const {
+        return false;
+    }
 
     virtual ppl::common::RetCode DoExecute(KernelExecContext*) = 0;
+    /** returns true if parallel regions of DoExecute() run on the thread pool of the device instead of OpenMP */
+    virtual bool UsesThreadPool() const {
+        return false;
+    }
     virtual uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const {
         return 0;
     }
@@ -86,6 +94,8 @@ private:
 
 private:
     ppl::common::RetCode BeforeExecute(KernelExecContext*);
+    ppl::common::RetCode BindInplaceConcatBuffer(const InplaceConcatBinding&, TensorImpl*);
+    void AfterExecute();
 
 private:
     const X86CommonParam* common_param_ = nullptr;
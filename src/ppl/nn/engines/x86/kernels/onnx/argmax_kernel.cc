@@ -36,6 +36,10 @@ ppl::common::RetCode ArgMaxKernel::DoExecute(KernelExecContext* ctx) {
     const auto data_type = data->GetShape().GetDataType();
 
     if (data_type == ppl::common::DATATYPE_FLOAT32) {
+        if (data->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_N16CX) {
+            return kernel::x86::argmax_n16cx_fp32(&data->GetShape(), data->GetBufferPtr<float>(), param_->axis,
+                                                  reduced->GetBufferPtr<int64_t>());
+        }
         return kernel::x86::argmax_ndarray_fp32(&data->GetShape(), data->GetBufferPtr<float>(), param_->axis,
                                                 reduced->GetBufferPtr<int64_t>());
     } else {
@@ -17,9 +17,93 @@
 
 #include "ppl/nn/engines/x86/kernels/onnx/averagepool_kernel.h"
 #include "ppl/kernel/x86/fp32/averagepool2d.h"
+#include "ppl/kernel/x86/fp32/averagepool3d.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
+ppl::common::RetCode AveragePoolKernel::DoExecute3D(KernelExecContext* ctx) {
+    auto X = ctx->GetInput<TensorImpl>(0);
+    auto Y = ctx->GetOutput<TensorImpl>(0);
+
+    const int32_t src_d = X->GetShape().GetDim(2);
+    const int32_t src_h = X->GetShape().GetDim(3);
+    const int32_t src_w = X->GetShape().GetDim(4);
+
+    int32_t kernel_d, kernel_h, kernel_w;
+    int32_t stride_d, stride_h, stride_w;
+    int32_t pad_d, pad_h, pad_w;
+    if (param_->global_pooling) {
+        kernel_d = src_d;
+        kernel_h = src_h;
+        kernel_w = src_w;
+        stride_d = src_d;
+        stride_h = src_h;
+        stride_w = src_w;
+        pad_d = 0;
+        pad_h = 0;
+        pad_w = 0;
+    } else {
+        if (param_->kernel_shape.size() != 3) {
+            LOG(ERROR) << "kernel_shape of 5-D input must have 3 elements.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        kernel_d = param_->kernel_shape[0];
+        kernel_h = param_->kernel_shape[1];
+        kernel_w = param_->kernel_shape[2];
+        stride_d = param_->strides.size() >= 1 ? param_->strides[0] : 1;
+        stride_h = param_->strides.size() >= 2 ? param_->strides[1] : 1;
+        stride_w = param_->strides.size() >= 3 ? param_->strides[2] : 1;
+        pad_d = param_->pads.size() >= 1 ? param_->pads[0] : 0;
+        pad_h = param_->pads.size() >= 2 ? param_->pads[1] : 0;
+        pad_w = param_->pads.size() >= 3 ? param_->pads[2] : 0;
+        if ((param_->pads.size() >= 4 && param_->pads[3] != pad_d) ||
+            (param_->pads.size() >= 5 && param_->pads[4] != pad_h) ||
+            (param_->pads.size() >= 6 && param_->pads[5] != pad_w)) {
+            LOG(ERROR) << "only support symmetrical pads now.";
+            return ppl::common::RC_UNSUPPORTED;
+        }
+        for (size_t i = 0; i < param_->dilations.size(); ++i) {
+            if (param_->dilations[i] != 1) {
+                LOG(ERROR) << "only support dilation = 1 now.";
+                return ppl::common::RC_UNSUPPORTED;
+            }
+        }
+    }
+
+    PPLNN_X86_DEBUG_TRACE("kernel_shape: %d %d %d\n", kernel_d, kernel_h, kernel_w);
+    PPLNN_X86_DEBUG_TRACE("strides: %d %d %d\n", stride_d, stride_h, stride_w);
+    PPLNN_X86_DEBUG_TRACE("pads: %d %d %d\n", pad_d, pad_h, pad_w);
+
+    const auto data_type = X->GetShape().GetDataType();
+    const auto data_format = X->GetShape().GetDataFormat();
+    if (data_type != ppl::common::DATATYPE_FLOAT32) {
+        LOG(ERROR) << "unsupported data type: " << ppl::common::GetDataTypeStr(data_type) << ".";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    if (data_format == ppl::common::DATAFORMAT_N16CX) {
+        if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+            return ppl::kernel::x86::averagepool3d_n16cdhw_blk1x16_fp32_avx512(
+                &X->GetShape(), &Y->GetShape(), X->GetBufferPtr<float>(), kernel_d, kernel_h, kernel_w, stride_d,
+                stride_h, stride_w, pad_d, pad_h, pad_w, param_->mode, param_->ceil_mode, Y->GetBufferPtr<float>());
+        } else if (MayUseISA(ppl::common::ISA_X86_AVX)) {
+            return ppl::kernel::x86::averagepool3d_n16cdhw_blk1x8_fp32_avx(
+                &X->GetShape(), &Y->GetShape(), X->GetBufferPtr<float>(), kernel_d, kernel_h, kernel_w, stride_d,
+                stride_h, stride_w, pad_d, pad_h, pad_w, param_->mode, param_->ceil_mode, Y->GetBufferPtr<float>());
+        } else {
+            LOG(ERROR) << "get unsupported isa " << GetISA() << ".";
+        }
+    } else if (data_format == ppl::common::DATAFORMAT_NDARRAY) {
+        return ppl::kernel::x86::averagepool3d_ncdhw_normal_fp32(
+            &X->GetShape(), &Y->GetShape(), X->GetBufferPtr<float>(), kernel_d, kernel_h, kernel_w, stride_d,
+            stride_h, stride_w, pad_d, pad_h, pad_w, param_->mode, param_->ceil_mode, Y->GetBufferPtr<float>());
+    } else {
+        LOG(ERROR) << "unsupported data format: " << ppl::common::GetDataFormatStr(data_format) << ".";
+    }
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
 ppl::common::RetCode AveragePoolKernel::DoExecute(KernelExecContext* ctx) {
     auto X = ctx->GetInput<TensorImpl>(0);
     auto Y = ctx->GetOutput<TensorImpl>(0);
@@ -30,8 +114,11 @@ ppl::common::RetCode AveragePoolKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
 
+    if (X->GetShape().GetDimCount() == 5) {
+        return DoExecute3D(ctx);
+    }
     if (X->GetShape().GetDimCount() != 4) {
-        LOG(ERROR) << "only support 4-D tensor now.";
+        LOG(ERROR) << "only support 4-D and 5-D tensor now.";
         return ppl::common::RC_UNSUPPORTED;
     }
 
@@ -115,6 +202,14 @@ ppl::common::RetCode AveragePoolKernel::DoExecute(KernelExecContext* ctx) {
         } else {
             LOG(ERROR) << "unsupported data type: " << ppl::common::GetDataTypeStr(data_type) << ".";
         }
+    } else if (data_format == ppl::common::DATAFORMAT_NHWC) {
+        if (data_type == ppl::common::DATATYPE_FLOAT32) {
+            return ppl::kernel::x86::averagepool2d_nhwc_normal_fp32(
+                &X->GetShape(), &Y->GetShape(), X->GetBufferPtr<float>(), kernel_h, kernel_w, stride_h, stride_w, pad_h,
+                pad_w, param_->mode, param_->ceil_mode, Y->GetBufferPtr<float>());
+        } else {
+            LOG(ERROR) << "unsupported data type: " << ppl::common::GetDataTypeStr(data_type) << ".";
+        }
     } else {
         LOG(ERROR) << "unsupported data format: " << ppl::common::GetDataFormatStr(data_format) << ".";
     }
@@ -19,6 +19,8 @@
 #include "ppl/nn/engines/x86/macros.h"
 #include "ppl/kernel/x86/fp32/concat.h"
 #include "ppl/kernel/x86/int64/concat.h"
+#include "ppl/kernel/x86/fp32/reorder.h"
+#include <string.h>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -40,6 +42,129 @@ uint64_t ConcatKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
     return 0;
 }
 
+bool ConcatKernel::TryExecuteInplace(const TensorImpl& concat_result, int32_t real_axis) const {
+    auto& dst_shape = concat_result.GetShape();
+    auto data_format = dst_shape.GetDataFormat();
+    if (data_format != ppl::common::DATAFORMAT_NDARRAY &&
+        !(data_format == ppl::common::DATAFORMAT_N16CX && real_axis == 1)) {
+        return false;
+    }
+    for (int32_t i = 0; i < real_axis; ++i) {
+        if (dst_shape.GetDim(i) != 1) {
+            return false;
+        }
+    }
+
+    // inputs are contiguous slices of the output now. find out those written into the output by their producers.
+    auto dst = (uint8_t*)concat_result.GetBufferPtr();
+    const uint64_t dst_bytes = dst_shape.GetBytesIncludingPadding();
+    auto is_bound = [dst, dst_bytes](const void* src) -> bool {
+        return (const uint8_t*)src >= dst && (const uint8_t*)src < dst + dst_bytes;
+    };
+
+    std::vector<uint64_t> offsets(src_shape_list_.size());
+    bool has_bound_input = false;
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < src_shape_list_.size(); ++i) {
+        if (data_format == ppl::common::DATAFORMAT_N16CX && i + 1 < src_shape_list_.size() &&
+            src_shape_list_[i]->GetDim(1) % 16 != 0) {
+            return false;
+        }
+        if (is_bound(src_list_[i])) {
+            has_bound_input = true;
+        }
+        offsets[i] = offset;
+        offset += src_shape_list_[i]->GetBytesIncludingPadding();
+    }
+    if (!has_bound_input || offset != dst_bytes) {
+        return false;
+    }
+
+    /*
+      bound inputs stay at the offsets of the shapes the graph was built with, which are not their offsets any more
+      if the shapes of other inputs changed. both keep the order of inputs, so moving those towards the front in
+      order and those towards the back in reverse order never overwrites a source that is not moved yet. inputs
+      from other buffers are copied after that.
+    */
+    for (uint32_t i = 0; i < src_shape_list_.size(); ++i) {
+        if (is_bound(src_list_[i]) && src_list_[i] > dst + offsets[i]) {
+            memmove(dst + offsets[i], src_list_[i], src_shape_list_[i]->GetBytesIncludingPadding());
+        }
+    }
+    for (uint32_t i = src_shape_list_.size(); i > 0; --i) {
+        if (is_bound(src_list_[i - 1]) && src_list_[i - 1] < dst + offsets[i - 1]) {
+            memmove(dst + offsets[i - 1], src_list_[i - 1], src_shape_list_[i - 1]->GetBytesIncludingPadding());
+        }
+    }
+    for (uint32_t i = 0; i < src_shape_list_.size(); ++i) {
+        if (!is_bound(src_list_[i])) {
+            memcpy(dst + offsets[i], src_list_[i], src_shape_list_[i]->GetBytesIncludingPadding());
+        }
+    }
+    return true;
+}
+
+ppl::common::RetCode ConcatKernel::ExecuteWithReorder(TensorImpl* concat_result, int32_t real_axis) const {
+    auto& dst_shape = concat_result->GetShape();
+    const auto dst_format = dst_shape.GetDataFormat();
+    if (dst_shape.GetDataType() != ppl::common::DATATYPE_FLOAT32 || dst_shape.GetDimCount() < 3 || real_axis != 1) {
+        LOG(ERROR) << "unsupported concat with mixed input formats.";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t batch = dst_shape.GetDim(0);
+    const int64_t inner_dims = dst_shape.GetElementsExcludingPadding() / batch / dst_shape.GetDim(1);
+    const int64_t dst_channels = dst_shape.GetElementsIncludingPadding() / batch / inner_dims;
+    float* dst = concat_result->GetBufferPtr<float>();
+
+    // with channels as the concat axis, one batch of an input is one contiguous block of the output
+    int64_t c_offset = 0;
+    for (uint32_t i = 0; i < src_shape_list_.size(); ++i) {
+        auto src_format = src_shape_list_[i]->GetDataFormat();
+        const int64_t channels = src_shape_list_[i]->GetDim(1);
+        const int64_t src_channels = src_shape_list_[i]->GetElementsIncludingPadding() / batch / inner_dims;
+        if (dst_format == ppl::common::DATAFORMAT_N16CX && i + 1 < src_shape_list_.size() && channels % 16 != 0) {
+            LOG(ERROR) << "channels of input[" << i << "] must be aligned to 16.";
+            return ppl::common::RC_UNSUPPORTED;
+        }
+
+        TensorShape batch_shape(*src_shape_list_[i]);
+        batch_shape.SetDim(0, 1);
+        for (int64_t b = 0; b < batch; ++b) {
+            const float* src = (const float*)src_list_[i] + b * src_channels * inner_dims;
+            float* dst_b = dst + (b * dst_channels + c_offset) * inner_dims;
+
+            ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+            if (src_format == dst_format) {
+                memcpy(dst_b, src, src_channels * inner_dims * sizeof(float));
+            } else if (src_format == ppl::common::DATAFORMAT_N16CX && dst_format == ppl::common::DATAFORMAT_NDARRAY) {
+                if (MayUseISA(ppl::common::ISA_X86_AVX)) {
+                    status = kernel::x86::reorder_n16cx_ndarray_fp32_avx(&batch_shape, src, dst_b);
+                } else {
+                    status = kernel::x86::reorder_n16cx_ndarray_fp32(&batch_shape, src, dst_b);
+                }
+            } else if (src_format == ppl::common::DATAFORMAT_NDARRAY && dst_format == ppl::common::DATAFORMAT_N16CX) {
+                if (MayUseISA(ppl::common::ISA_X86_AVX)) {
+                    status = kernel::x86::reorder_ndarray_n16cx_fp32_avx(&batch_shape, src, dst_b);
+                } else {
+                    status = kernel::x86::reorder_ndarray_n16cx_fp32(&batch_shape, src, dst_b);
+                }
+            } else {
+                status = ppl::common::RC_UNSUPPORTED;
+            }
+            if (status != ppl::common::RC_SUCCESS) {
+                LOG(ERROR) << "reorder concat input[" << i << "] from " << ppl::common::GetDataFormatStr(src_format)
+                           << " to " << ppl::common::GetDataFormatStr(dst_format)
+                           << " failed: " << ppl::common::GetRetCodeStr(status);
+                return status;
+            }
+        }
+        c_offset += channels;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
 ppl::common::RetCode ConcatKernel::DoExecute(KernelExecContext* ctx) {
     src_list_.resize(ctx->GetInputCount());
     src_shape_list_.resize(ctx->GetInputCount());
@@ -64,6 +189,16 @@ ppl::common::RetCode ConcatKernel::DoExecute(KernelExecContext* ctx) {
     const int32_t real_axis =
         param_->axis < 0 ? param_->axis + ctx->GetInput<TensorImpl>(0)->GetShape().GetDimCount() : param_->axis;
 
+    for (uint32_t i = 0; i < src_shape_list_.size(); ++i) {
+        if (src_shape_list_[i]->GetDataFormat() != data_format) {
+            return ExecuteWithReorder(concat_result, real_axis);
+        }
+    }
+
+    if (TryExecuteInplace(*concat_result, real_axis)) {
+        return ppl::common::RC_SUCCESS;
+    }
+
     if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_N16CX && real_axis == 1 &&
         MayUseISA(ppl::common::ISA_X86_AVX)) {
         bool interleave_channels = false;
@@ -35,6 +35,10 @@ private:
     uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
     bool CanDoExecute(const KernelExecContext&) const override;
+    // moves inputs written into the output by their producers to their offsets and copies the others
+    bool TryExecuteInplace(const TensorImpl& concat_result, int32_t real_axis) const;
+    // reorders inputs that are not in the output format straight into their slice of the output
+    ppl::common::RetCode ExecuteWithReorder(TensorImpl* concat_result, int32_t real_axis) const;
 
 private:
     const ppl::nn::common::ConcatParam* param_ = nullptr;
@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_CONV_CONV3D_KERNEL_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_CONV_CONV3D_KERNEL_H_
+
+#include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/params/convolution_param.h"
+#include "ppl/kernel/x86/fp32/conv3d.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+class Conv3dKernel : public X86Kernel {
+public:
+    Conv3dKernel(const ir::Node* node) : X86Kernel(node) {}
+    ~Conv3dKernel() {
+        if (executor_)
+            delete executor_;
+    }
+
+    void SetParam(const Convolution3DParam* p) {
+        param_ = p;
+        if (executor_)
+            delete executor_;
+        executor_ = p->mgr->gen_executor();
+    }
+
+private:
+    uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
+    ppl::common::RetCode DoExecute(KernelExecContext*) override;
+
+private:
+    const Convolution3DParam* param_ = nullptr;
+    ppl::kernel::x86::conv3d_fp32_executor* executor_ = nullptr;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
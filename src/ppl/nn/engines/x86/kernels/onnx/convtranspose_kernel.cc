@@ -22,11 +22,14 @@ namespace ppl { namespace nn { namespace x86 {
 
 uint64_t ConvTransposeKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
     auto x = ctx.GetInput<TensorImpl>(0);
+    if (x->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_N16CX) {
+        return 0;
+    }
 
     const int32_t batch = x->GetShape().GetDim(0);
     const int32_t src_h = x->GetShape().GetDim(2);
     const int32_t src_w = x->GetShape().GetDim(3);
-    const int32_t num_outputs = ctx.GetInput<TensorImpl>(1)->GetShape().GetDim(0);
+    const int32_t num_outputs = ctx.GetInput<TensorImpl>(1)->GetShape().GetDim(1);
     const int32_t channels = x->GetShape().GetDim(1);
 
     if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
@@ -34,7 +37,7 @@ uint64_t ConvTransposeKernel::CalcTmpBufferSize(const KernelExecContext& ctx) co
             batch, src_h, src_w, num_outputs, channels, param_->kernel_shape[0], param_->kernel_shape[1],
             param_->strides[0], param_->strides[1], param_->pads[0], param_->pads[1]);
     } else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
-        return kernel::x86::conv_transpose_ndarray_fp32_avx512_get_buffer_bytes(
+        return kernel::x86::conv_transpose_ndarray_fp32_fma_get_buffer_bytes(
             batch, src_h, src_w, num_outputs, channels, param_->kernel_shape[0], param_->kernel_shape[1],
             param_->strides[0], param_->strides[1], param_->pads[0], param_->pads[1]);
     } else if (MayUseISA(ppl::common::ISA_X86_SSE)) {
@@ -48,7 +51,51 @@ uint64_t ConvTransposeKernel::CalcTmpBufferSize(const KernelExecContext& ctx) co
     return 0;
 }
 
+ppl::common::RetCode ConvTransposeKernel::DoExecuteN16CX(KernelExecContext* ctx) {
+    TensorImpl* X = ctx->GetInput<TensorImpl>(0);
+    TensorImpl* Y = ctx->GetOutput<TensorImpl>(0);
+
+    const float* sum_src = nullptr;
+    if (convtranspose_param_->fuse_flag & ppl::kernel::x86::conv_fuse_flag::sum) {
+        TensorImpl* S = ctx->GetInput<TensorImpl>(ctx->GetInputCount() - 1);
+        PPLNN_X86_DEBUG_TRACE("Input [sum_src]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(S);
+        sum_src = S->GetBufferPtr<float>();
+    }
+    const float* bias = convtranspose_param_->bias.empty() ? nullptr : convtranspose_param_->bias.data();
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [X]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(X);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %lu\n", convtranspose_param_->fuse_flag);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+        return kernel::x86::conv_transpose_n16cx_direct_fp32_avx512(
+            &X->GetShape(), &Y->GetShape(), X->GetBufferPtr<float>(), sum_src, convtranspose_param_->packed_filter,
+            bias, param_->group, param_->kernel_shape[0], param_->kernel_shape[1], param_->strides[0],
+            param_->strides[1], param_->pads[0], param_->pads[1], param_->dilations[0], param_->dilations[1],
+            convtranspose_param_->fuse_flag, Y->GetBufferPtr<float>());
+    } else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+        return kernel::x86::conv_transpose_n16cx_direct_fp32_fma(
+            &X->GetShape(), &Y->GetShape(), X->GetBufferPtr<float>(), sum_src, convtranspose_param_->packed_filter,
+            bias, param_->group, param_->kernel_shape[0], param_->kernel_shape[1], param_->strides[0],
+            param_->strides[1], param_->pads[0], param_->pads[1], param_->dilations[0], param_->dilations[1],
+            convtranspose_param_->fuse_flag, Y->GetBufferPtr<float>());
+    }
+
+    LOG(ERROR) << "unsupported isa: " << GetISA();
+    return ppl::common::RC_UNSUPPORTED;
+}
+
 ppl::common::RetCode ConvTransposeKernel::DoExecute(KernelExecContext* ctx) {
+    if (ctx->GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_N16CX &&
+        convtranspose_param_->packed_filter) {
+        return DoExecuteN16CX(ctx);
+    }
+
     BufferDesc tmp_buffer_desc;
     auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
     auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
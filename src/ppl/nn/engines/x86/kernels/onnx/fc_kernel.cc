@@ -33,6 +33,16 @@ ppl::common::RetCode FCKernel::DoExecute(KernelExecContext* ctx) {
     executor_->set_dst_shape(&Y->GetShape());
     executor_->set_dst(Y->GetBufferPtr<float>());
 
+    TensorImpl* sum_src = nullptr;
+    if (executor_->fc_param()->fuse_flag & ppl::kernel::x86::fc_fuse_flag::sum) {
+        sum_src = ctx->GetInput<TensorImpl>(ctx->GetInputCount() - 1);
+        if (sum_src->GetShape().GetElementsExcludingPadding() != Y->GetShape().GetElementsExcludingPadding()) {
+            LOG(ERROR) << "fused sum input must have the same shape as output.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        executor_->set_sum_src(sum_src->GetBufferPtr<float>());
+    }
+
     ppl::common::RetCode rc;
     rc = executor_->prepare();
     if (ppl::common::RC_SUCCESS != rc) {
@@ -58,6 +68,10 @@ ppl::common::RetCode FCKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
     PPLNN_X86_DEBUG_TRACE("Input [A]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(A);
+    if (sum_src != nullptr) {
+        PPLNN_X86_DEBUG_TRACE("Input [sum_src]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(sum_src);
+    }
     PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
     PPLNN_X86_DEBUG_TRACE("channels: %ld\n", executor_->fc_param()->channels);
@@ -23,10 +23,16 @@ namespace ppl { namespace nn { namespace x86 {
 ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
     auto A = ctx->GetInput<TensorImpl>(0);
     auto B = ctx->GetInput<TensorImpl>(1);
+    const bool fuse_sum = fuse_flag_ & ppl::kernel::x86::gemm_v2_fuse_flag::sum;
+    const uint32_t gemm_input_count = ctx->GetInputCount() - (fuse_sum ? 1 : 0);
     TensorImpl* C = nullptr;
-    if (ctx->GetInputCount() == 3) {
+    if (gemm_input_count == 3) {
         C = ctx->GetInput<TensorImpl>(2);
     }
+    TensorImpl* sum_src = nullptr;
+    if (fuse_sum) {
+        sum_src = ctx->GetInput<TensorImpl>(gemm_input_count);
+    }
     auto Y = ctx->GetOutput<TensorImpl>(0);
 
     PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
@@ -38,12 +44,17 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
         PPLNN_X86_DEBUG_TRACE("Input [C]:\n");
         PPL_X86_TENSOR_PRINT_DEBUG_MSG(C);
     }
+    if (sum_src != nullptr) {
+        PPLNN_X86_DEBUG_TRACE("Input [sum_src]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(sum_src);
+    }
     PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
     PPLNN_X86_DEBUG_TRACE("trans_A: %d\n", param_->transA);
     PPLNN_X86_DEBUG_TRACE("trans_B: %d\n", param_->transB);
     PPLNN_X86_DEBUG_TRACE("alpha: %f\n", param_->alpha);
     PPLNN_X86_DEBUG_TRACE("beta: %f\n", param_->beta);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %u\n", fuse_flag_);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
     if (A->GetShape().GetDataType() != ppl::common::DATATYPE_FLOAT32 ||
@@ -83,10 +94,15 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
     param.trans_B = param_->transB;
     param.isa_flag = GetISA();
 
-    if (gemm_fuse_relu_) {
-        param.fuse_flag = ppl::kernel::x86::gemm_v2_fuse_flag::relu;
-    } else {
-        param.fuse_flag = ppl::kernel::x86::gemm_v2_fuse_flag::none;
+    param.fuse_flag = fuse_flag_;
+
+    if (sum_src != nullptr) {
+        if (sum_src->GetShape().GetElementsExcludingPadding() != Y->GetShape().GetElementsExcludingPadding()) {
+            LOG(ERROR) << "fused sum input must have the same shape as output.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        param.src_sum = sum_src->GetBufferPtr<float>();
+        param.ldsum = N;
     }
 
     param.src_C = nullptr;
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/engines/x86/kernel.h"
 #include "ppl/nn/params/onnx/gemm_param.h"
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -30,8 +31,9 @@ public:
     void SetParam(const ppl::nn::common::GemmParam* p) {
         param_ = p;
     }
-    void SetFuseReLU(bool fuse_relu) {
-        gemm_fuse_relu_ = fuse_relu;
+    // with gemm_v2_fuse_flag::sum the last input is the summand
+    void SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag_t fuse_flag) {
+        fuse_flag_ = fuse_flag;
     }
 
 private:
@@ -39,7 +41,7 @@ private:
 
 private:
     const ppl::nn::common::GemmParam* param_ = nullptr;
-    bool gemm_fuse_relu_ = false;
+    ppl::kernel::x86::gemm_v2_fuse_flag_t fuse_flag_ = ppl::kernel::x86::gemm_v2_fuse_flag::none;
 };
 
 }}} // namespace ppl::nn::x86
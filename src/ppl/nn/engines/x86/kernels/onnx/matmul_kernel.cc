@@ -46,23 +46,60 @@ ppl::common::RetCode MatMulKernel::DoExecute(KernelExecContext* ctx) {
     auto A = ctx->GetInput<TensorImpl>(0);
     auto B = ctx->GetInput<TensorImpl>(1);
     auto Y = ctx->GetOutput<TensorImpl>(0);
+    TensorImpl* bias = nullptr;
+    if (fuse_bias_) {
+        bias = ctx->GetInput<TensorImpl>(2);
+    }
+    TensorImpl* sum_src = nullptr;
+    if (fuse_flag_ & ppl::kernel::x86::gemm_v2_fuse_flag::sum) {
+        sum_src = ctx->GetInput<TensorImpl>(ctx->GetInputCount() - 1);
+    }
 
     PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
     PPLNN_X86_DEBUG_TRACE("Input [A]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(A);
     PPLNN_X86_DEBUG_TRACE("Input [B]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(B);
+    if (bias != nullptr) {
+        PPLNN_X86_DEBUG_TRACE("Input [bias]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(bias);
+    }
+    if (sum_src != nullptr) {
+        PPLNN_X86_DEBUG_TRACE("Input [sum_src]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(sum_src);
+    }
     PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %u\n", fuse_flag_);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
     const auto data_type = A->GetShape().GetDataType();
     const auto data_format = A->GetShape().GetDataFormat();
 
     if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_NDARRAY) {
-        return kernel::x86::matmul_ndarray_fp32(&A->GetShape(), &B->GetShape(), &Y->GetShape(),
-                                                A->GetBufferPtr<float>(), B->GetBufferPtr<float>(), GetISA(),
-                                                tmp_buffer, Y->GetBufferPtr<float>());
+        if (bias == nullptr && sum_src == nullptr && fuse_flag_ == ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+            return kernel::x86::matmul_ndarray_fp32(&A->GetShape(), &B->GetShape(), &Y->GetShape(),
+                                                    A->GetBufferPtr<float>(), B->GetBufferPtr<float>(), GetISA(),
+                                                    tmp_buffer, Y->GetBufferPtr<float>());
+        }
+        if (Y->GetShape().IsScalar()) {
+            LOG(ERROR) << "fused matmul requires a non-scalar output.";
+            return ppl::common::RC_UNSUPPORTED;
+        }
+        const int64_t dst_n = Y->GetShape().GetDim(Y->GetShape().GetDimCount() - 1);
+        if (bias != nullptr && bias->GetShape().GetElementsExcludingPadding() != (uint64_t)dst_n) {
+            LOG(ERROR) << "fused bias must have as many elements as the last dim of output.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        if (sum_src != nullptr &&
+            sum_src->GetShape().GetElementsExcludingPadding() != Y->GetShape().GetElementsExcludingPadding()) {
+            LOG(ERROR) << "fused sum input must have the same shape as output.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        return kernel::x86::matmul_ndarray_fused_fp32(
+            &A->GetShape(), &B->GetShape(), &Y->GetShape(), A->GetBufferPtr<float>(), B->GetBufferPtr<float>(),
+            bias ? bias->GetBufferPtr<float>() : nullptr, sum_src ? sum_src->GetBufferPtr<float>() : nullptr,
+            fuse_flag_, GetISA(), tmp_buffer, Y->GetBufferPtr<float>());
     } else {
         LOG(ERROR) << "only support fp32 ndarray now.";
     }
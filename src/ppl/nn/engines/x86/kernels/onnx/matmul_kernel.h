@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_MATMUL_KERNEL_H_
 
 #include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -26,9 +27,21 @@ class MatMulKernel : public X86Kernel {
 public:
     MatMulKernel(const ir::Node* node) : X86Kernel(node) {}
 
+    // input 2 is the bias when fuse_bias is set, and the last input is the summand with gemm_v2_fuse_flag::sum
+    void SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag_t fuse_flag) {
+        fuse_flag_ = fuse_flag;
+    }
+    void SetFuseBias(bool fuse_bias) {
+        fuse_bias_ = fuse_bias;
+    }
+
 private:
     uint64_t CalcTmpBufferSize(const KernelExecContext&) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
+
+private:
+    ppl::kernel::x86::gemm_v2_fuse_flag_t fuse_flag_ = ppl::kernel::x86::gemm_v2_fuse_flag::none;
+    bool fuse_bias_ = false;
 };
 
 }}} // namespace ppl::nn::x86
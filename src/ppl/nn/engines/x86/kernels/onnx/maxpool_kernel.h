@@ -33,6 +33,7 @@ public:
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
+    ppl::common::RetCode DoExecute3D(KernelExecContext*);
 
 private:
     const ppl::nn::common::PoolingParam* param_ = nullptr;
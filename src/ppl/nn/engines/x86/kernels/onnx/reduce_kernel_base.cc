@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/onnx/reduce_kernel_base.h"
+#include "ppl/nn/common/logger.h"
+
+#include "ppl/kernel/x86/fp32/reorder.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+// shape of the reduced tensor with keep_dims=1 in N16CX, used when the output is a NDARRAY without kept dims
+static TensorShape CalcKeptShape(const TensorShape& data_shape, const std::vector<int32_t>& axes) {
+    TensorShape kept_shape = data_shape;
+    const int32_t dim_count = data_shape.GetDimCount();
+    if (axes.empty()) {
+        for (int32_t i = 0; i < dim_count; ++i) {
+            kept_shape.SetDim(i, 1);
+        }
+    } else {
+        for (size_t i = 0; i < axes.size(); ++i) {
+            kept_shape.SetDim(axes[i] < 0 ? axes[i] + dim_count : axes[i], 1);
+        }
+    }
+    kept_shape.CalcPadding();
+    return kept_shape;
+}
+
+uint64_t ReduceKernelBase::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    auto& data_shape = ctx.GetInput<TensorImpl>(0)->GetShape();
+    if (data_shape.GetDataFormat() == ppl::common::DATAFORMAT_N16CX &&
+        ctx.GetOutput<TensorImpl>(0)->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_NDARRAY) {
+        return CalcKeptShape(data_shape, param_->axes).GetBytesIncludingPadding();
+    }
+    return 0;
+}
+
+ppl::common::RetCode ReduceKernelBase::DoExecuteN16CXToNdarray(KernelExecContext* ctx,
+                                                               const std::vector<int32_t>& axes,
+                                                               reduce_fp32_func_t avx_func,
+                                                               reduce_fp32_func_t sse_func) {
+    auto data = ctx->GetInput<TensorImpl>(0);
+    auto reduced = ctx->GetOutput<TensorImpl>(0);
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = (float*)tmp_buffer_desc.addr;
+
+    const TensorShape kept_shape = CalcKeptShape(data->GetShape(), axes);
+    if (MayUseISA(ppl::common::ISA_X86_AVX)) {
+        status = avx_func(&data->GetShape(), &kept_shape, data->GetBufferPtr<float>(), axes.data(), axes.size(),
+                          tmp_buffer);
+        if (status != ppl::common::RC_SUCCESS) {
+            return status;
+        }
+        return kernel::x86::reorder_n16cx_ndarray_fp32_avx(&kept_shape, tmp_buffer, reduced->GetBufferPtr<float>());
+    } else if (MayUseISA(ppl::common::ISA_X86_SSE)) {
+        status = sse_func(&data->GetShape(), &kept_shape, data->GetBufferPtr<float>(), axes.data(), axes.size(),
+                          tmp_buffer);
+        if (status != ppl::common::RC_SUCCESS) {
+            return status;
+        }
+        return kernel::x86::reorder_n16cx_ndarray_fp32(&kept_shape, tmp_buffer, reduced->GetBufferPtr<float>());
+    }
+
+    LOG(ERROR) << "get unsupported isa " << GetISA();
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,51 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_REDUCE_KERNEL_BASE_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_REDUCE_KERNEL_BASE_H_
+
+#include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/params/onnx/reduce_param.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+/** @brief base of ReduceMax/Min/Mean/Sum, which also reduce a N16CX input into a NDARRAY output without kept dims */
+class ReduceKernelBase : public X86Kernel {
+public:
+    ReduceKernelBase(const ir::Node* node) : X86Kernel(node) {}
+
+    void SetParam(const ppl::nn::common::ReduceParam* p) {
+        param_ = p;
+    }
+
+protected:
+    typedef ppl::common::RetCode (*reduce_fp32_func_t)(const TensorShape* src_shape, const TensorShape* dst_shape,
+                                                       const float* src, const int32_t* axes, const int32_t num_axes,
+                                                       float* dst);
+
+    uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
+    /** reduces into a N16CX tmp buffer with reduced dims kept, then reorders it into the output directly */
+    ppl::common::RetCode DoExecuteN16CXToNdarray(KernelExecContext*, const std::vector<int32_t>& axes,
+                                                 reduce_fp32_func_t avx_func, reduce_fp32_func_t sse_func);
+
+protected:
+    const ppl::nn::common::ReduceParam* param_ = nullptr;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
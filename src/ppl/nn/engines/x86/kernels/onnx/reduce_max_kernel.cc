@@ -55,6 +55,11 @@ ppl::common::RetCode ReduceMaxKernel::DoExecute(KernelExecContext* ctx) {
 
     auto data_type = data->GetShape().GetDataType();
     if (data_type == ppl::common::DATATYPE_FLOAT32) {
+        if (data->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_N16CX &&
+            reduced->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_NDARRAY) {
+            return DoExecuteN16CXToNdarray(ctx, fixed_axes, kernel::x86::reduce_max_fp32_avx,
+                                           kernel::x86::reduce_max_fp32_sse);
+        }
         if (MayUseISA(ppl::common::ISA_X86_AVX)) {
             return kernel::x86::reduce_max_fp32_avx(&data->GetShape(), &reduced->GetShape(),
                                                     data->GetBufferPtr<float>(), fixed_axes.data(), fixed_axes.size(),
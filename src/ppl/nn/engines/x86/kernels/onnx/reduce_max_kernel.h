@@ -18,24 +18,16 @@
 #ifndef _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_REDUCE_MAX_KERNEL_H_
 #define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_REDUCE_MAX_KERNEL_H_
 
-#include "ppl/nn/engines/x86/kernel.h"
-#include "ppl/nn/params/onnx/reduce_param.h"
+#include "ppl/nn/engines/x86/kernels/onnx/reduce_kernel_base.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
-class ReduceMaxKernel : public X86Kernel {
+class ReduceMaxKernel : public ReduceKernelBase {
 public:
-    ReduceMaxKernel(const ir::Node* node) : X86Kernel(node) {}
-
-    void SetParam(const ppl::nn::common::ReduceParam* p) {
-        param_ = p;
-    }
+    ReduceMaxKernel(const ir::Node* node) : ReduceKernelBase(node) {}
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
-
-private:
-    const ppl::nn::common::ReduceParam* param_ = nullptr;
 };
 
 }}} // namespace ppl::nn::x86
@@ -0,0 +1,134 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/onnx/rnn_kernel.h"
+#include "ppl/nn/common/logger.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+bool RNNKernel::CanDoExecute(const KernelExecContext& ctx) const {
+    // X, W and R are required, the others are optional
+    for (uint32_t i = 0; i < 3; ++i) {
+        auto tensor = ctx.GetInput<TensorImpl>(i);
+        if (!tensor || tensor->GetShape().GetBytesIncludingPadding() == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t RNNKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    return ppl::kernel::x86::rnn_fp32_get_buffer_bytes(GetISA(), &ctx.GetInput<TensorImpl>(0)->GetShape(),
+                                                       param_->param, !param_->packed_R.empty());
+}
+
+ppl::common::RetCode RNNKernel::DoExecute(KernelExecContext* ctx) {
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+
+    const bool is_lstm = param_->param.cell == ppl::kernel::x86::rnn_cell_type::lstm;
+    auto optional_input = [ctx](uint32_t idx) -> TensorImpl* {
+        return idx < ctx->GetInputCount() ? ctx->GetInput<TensorImpl>(idx) : nullptr;
+    };
+    auto optional_output = [ctx](uint32_t idx) -> TensorImpl* {
+        return idx < ctx->GetOutputCount() ? ctx->GetOutput<TensorImpl>(idx) : nullptr;
+    };
+
+    auto X = ctx->GetInput<TensorImpl>(0);
+    auto W = ctx->GetInput<TensorImpl>(1);
+    auto R = ctx->GetInput<TensorImpl>(2);
+    auto B = optional_input(3);
+    auto sequence_lens = optional_input(4);
+    auto initial_h = optional_input(5);
+    auto initial_c = is_lstm ? optional_input(6) : nullptr;
+    auto P = is_lstm ? optional_input(7) : nullptr;
+    auto Y = optional_output(0);
+    auto Y_h = optional_output(1);
+    auto Y_c = is_lstm ? optional_output(2) : nullptr;
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [X]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(X);
+    PPLNN_X86_DEBUG_TRACE("Input [W]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(W);
+    PPLNN_X86_DEBUG_TRACE("Input [R]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(R);
+    if (B) {
+        PPLNN_X86_DEBUG_TRACE("Input [B]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(B);
+    }
+    if (sequence_lens) {
+        PPLNN_X86_DEBUG_TRACE("Input [sequence_lens]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(sequence_lens);
+    }
+    if (initial_h) {
+        PPLNN_X86_DEBUG_TRACE("Input [initial_h]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(initial_h);
+    }
+    if (initial_c) {
+        PPLNN_X86_DEBUG_TRACE("Input [initial_c]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(initial_c);
+    }
+    if (P) {
+        PPLNN_X86_DEBUG_TRACE("Input [P]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(P);
+    }
+    PPLNN_X86_DEBUG_TRACE("hidden_size: %d\n", (int32_t)param_->param.hidden_size);
+    PPLNN_X86_DEBUG_TRACE("direction: %u\n", param_->param.direction);
+    PPLNN_X86_DEBUG_TRACE("packed_R: %d\n", !param_->packed_R.empty());
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    auto data_type = X->GetShape().GetDataType();
+    if (data_type != ppl::common::DATATYPE_FLOAT32) {
+        LOG(ERROR) << "unsupported data type: " << ppl::common::GetDataTypeStr(data_type) << ".";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    if (sequence_lens && sequence_lens->GetShape().GetDataType() != ppl::common::DATATYPE_INT32) {
+        LOG(ERROR) << "unsupported sequence_lens data type: "
+                   << ppl::common::GetDataTypeStr(sequence_lens->GetShape().GetDataType()) << ".";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    status = kernel::x86::rnn_fp32(
+        GetISA(), &X->GetShape(), X->GetBufferPtr<const float>(), W->GetBufferPtr<const float>(),
+        R->GetBufferPtr<const float>(), param_->packed_R.empty() ? nullptr : param_->packed_R.data(),
+        B ? B->GetBufferPtr<const float>() : nullptr,
+        sequence_lens ? sequence_lens->GetBufferPtr<const int32_t>() : nullptr,
+        initial_h ? initial_h->GetBufferPtr<const float>() : nullptr,
+        initial_c ? initial_c->GetBufferPtr<const float>() : nullptr, P ? P->GetBufferPtr<const float>() : nullptr,
+        param_->param, tmp_buffer, Y ? Y->GetBufferPtr<float>() : nullptr, Y_h ? Y_h->GetBufferPtr<float>() : nullptr,
+        Y_c ? Y_c->GetBufferPtr<float>() : nullptr);
+
+    if (Y) {
+        PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+    }
+
+    return status;
+}
+
+}}} // namespace ppl::nn::x86
@@ -28,6 +28,9 @@ public:
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
+    bool UsesThreadPool() const override {
+        return true;
+    }
 };
 
 }}} // namespace ppl::nn::x86
@@ -19,12 +19,76 @@
 
 #include "ppl/kernel/x86/fp32/slice.h"
 #include "ppl/kernel/x86/int64/slice.h"
+#include <algorithm>
 
 namespace ppl { namespace nn { namespace x86 {
 
+bool SliceKernel::CalcOutputOffset(const KernelExecContext& ctx, uint64_t* offset) const {
+    auto data = ctx.GetInput<TensorImpl>(0);
+    auto& data_shape = data->GetShape();
+    auto& output_shape = ctx.GetOutput<TensorImpl>(0)->GetShape();
+    if (!data->CanShareBuffer() || data_shape.GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
+        return false;
+    }
+
+    const int64_t dim_count = data_shape.GetDimCount();
+    const int64_t axes_num = ctx.GetInput<TensorImpl>(1)->GetShape().GetDim(0);
+    auto starts = ctx.GetInput<TensorImpl>(1)->GetBufferPtr<int64_t>();
+    auto axes = ctx.GetInputCount() >= 4 ? ctx.GetInput<TensorImpl>(3)->GetBufferPtr<int64_t>() : nullptr;
+    auto steps = ctx.GetInputCount() >= 5 ? ctx.GetInput<TensorImpl>(4)->GetBufferPtr<int64_t>() : nullptr;
+
+    std::vector<int64_t> real_starts(dim_count, 0);
+    for (int64_t i = 0; i < axes_num; ++i) {
+        const int64_t axis = axes ? (axes[i] < 0 ? axes[i] + dim_count : axes[i]) : i;
+        if (axis < 0 || axis >= dim_count || (steps && steps[i] != 1)) {
+            return false;
+        }
+        const int64_t dim = data_shape.GetDim(axis);
+        const int64_t start = starts[i] < 0 ? starts[i] + dim : starts[i];
+        real_starts[axis] = std::min(std::max(start, (int64_t)0), dim);
+    }
+
+    // the output is contiguous if it is sliced along one axis, dims before which are 1 and dims after which are
+    // taken as a whole
+    int64_t sliced_axis = dim_count;
+    for (int64_t i = 0; i < dim_count; ++i) {
+        if (output_shape.GetDim(i) != data_shape.GetDim(i)) {
+            sliced_axis = i;
+            break;
+        }
+    }
+    uint64_t stride = ppl::common::GetSizeOfDataType(data_shape.GetDataType());
+    for (int64_t i = dim_count - 1; i > sliced_axis; --i) {
+        if (real_starts[i] != 0 || output_shape.GetDim(i) != data_shape.GetDim(i)) {
+            return false;
+        }
+        stride *= data_shape.GetDim(i);
+    }
+    for (int64_t i = 0; i < sliced_axis; ++i) {
+        if (data_shape.GetDim(i) != 1) {
+            return false;
+        }
+    }
+
+    *offset = (sliced_axis < dim_count) ? real_starts[sliced_axis] * stride : 0;
+    const uint64_t alignment = GetX86Device()->GetAllocator()->GetAlignment();
+    return ((uintptr_t)data->GetBufferPtr() + *offset) % alignment == 0;
+}
+
+bool SliceKernel::CanShareInputBuffer(const KernelExecContext& ctx) const {
+    uint64_t offset;
+    return CalcOutputOffset(ctx, &offset);
+}
+
 ppl::common::RetCode SliceKernel::DoExecute(KernelExecContext* ctx) {
     auto data = ctx->GetInput<TensorImpl>(0);
     auto output = ctx->GetOutput<TensorImpl>(0);
+
+    uint64_t offset;
+    if (CalcOutputOffset(*ctx, &offset)) {
+        PPLNN_X86_DEBUG_TRACE("Op: %s, output shares the input buffer\n", GetName().c_str());
+        return output->ShareBufferFrom(data, offset);
+    }
     const int axes_num = ctx->GetInput<TensorImpl>(1)->GetShape().GetDim(0);
 
     PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
@@ -28,6 +28,9 @@ public:
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
+    bool CanShareInputBuffer(const KernelExecContext& ctx) const override;
+    // output is a view of the input if it is a contiguous and aligned part of it
+    bool CalcOutputOffset(const KernelExecContext& ctx, uint64_t* offset) const;
 };
 
 }}} // namespace ppl::nn::x86
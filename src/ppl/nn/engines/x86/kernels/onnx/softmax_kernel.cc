@@ -51,6 +51,19 @@ ppl::common::RetCode SoftmaxKernel::DoExecute(KernelExecContext* ctx) {
         } else {
             LOG(ERROR) << "unsupported data type " << ppl::common::GetDataTypeStr(data_type) << ".";
         }
+    } else if (data_format == ppl::common::DATAFORMAT_N16CX) {
+        if (data_type == ppl::common::DATATYPE_FLOAT32) {
+            const int64_t real_axis = param_->axis < 0 ? param_->axis + input->GetShape().GetDimCount() : param_->axis;
+            if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+                return ppl::kernel::x86::softmax_n16cx_fp32_fma(&input->GetShape(), input->GetBufferPtr<float>(),
+                                                                real_axis, output->GetBufferPtr<float>());
+            } else {
+                return ppl::kernel::x86::softmax_n16cx_fp32(&input->GetShape(), input->GetBufferPtr<float>(),
+                                                            real_axis, output->GetBufferPtr<float>());
+            }
+        } else {
+            LOG(ERROR) << "unsupported data type " << ppl::common::GetDataTypeStr(data_type) << ".";
+        }
     } else {
         LOG(ERROR) << "unsupported data format " << ppl::common::GetDataFormatStr(data_format) << ".";
     }
@@ -22,9 +22,66 @@
 
 namespace ppl { namespace nn { namespace x86 {
 
+bool SplitKernel::CalcOutputOffsets(const KernelExecContext& ctx, std::vector<uint64_t>* offsets) const {
+    auto input = ctx.GetInput<TensorImpl>(0);
+    if (!input->CanShareBuffer()) {
+        return false;
+    }
+
+    auto& input_shape = input->GetShape();
+    const int32_t real_axis = param_->axis < 0 ? param_->axis + input_shape.GetDimCount() : param_->axis;
+    const auto data_format = input_shape.GetDataFormat();
+    if (data_format != ppl::common::DATAFORMAT_NDARRAY &&
+        !(data_format == ppl::common::DATAFORMAT_N16CX && real_axis == 1)) {
+        return false;
+    }
+    for (int32_t i = 0; i < real_axis; ++i) {
+        if (input_shape.GetDim(i) != 1) {
+            return false;
+        }
+    }
+
+    const uint64_t alignment = GetX86Device()->GetAllocator()->GetAlignment();
+    auto base = (uintptr_t)input->GetBufferPtr();
+
+    offsets->resize(ctx.GetOutputCount());
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < ctx.GetOutputCount(); ++i) {
+        auto& output_shape = ctx.GetOutput<TensorImpl>(i)->GetShape();
+        if (data_format == ppl::common::DATAFORMAT_N16CX && i + 1 < ctx.GetOutputCount() &&
+            output_shape.GetDim(1) % 16 != 0) {
+            return false;
+        }
+        if ((base + offset) % alignment != 0) {
+            return false;
+        }
+        offsets->at(i) = offset;
+        offset += output_shape.GetBytesIncludingPadding();
+    }
+
+    return offset == input_shape.GetBytesIncludingPadding();
+}
+
+bool SplitKernel::CanShareInputBuffer(const KernelExecContext& ctx) const {
+    std::vector<uint64_t> offsets;
+    return CalcOutputOffsets(ctx, &offsets);
+}
+
 ppl::common::RetCode SplitKernel::DoExecute(KernelExecContext* ctx) {
     auto input = ctx->GetInput<TensorImpl>(0);
 
+    std::vector<uint64_t> offsets;
+    if (CalcOutputOffsets(*ctx, &offsets)) {
+        PPLNN_X86_DEBUG_TRACE("Op: %s, outputs share the input buffer\n", GetName().c_str());
+        for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+            auto status = ctx->GetOutput<TensorImpl>(i)->ShareBufferFrom(input, offsets[i]);
+            if (status != ppl::common::RC_SUCCESS) {
+                return status;
+            }
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
     std::vector<float*> dst_list(ctx->GetOutputCount());
     std::vector<const TensorShape*> dst_shape_list(ctx->GetOutputCount());
 
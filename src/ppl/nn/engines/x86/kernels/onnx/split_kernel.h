@@ -33,6 +33,9 @@ public:
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
+    bool CanShareInputBuffer(const KernelExecContext& ctx) const override;
+    // outputs are views of the input if they are contiguous and aligned slices of it
+    bool CalcOutputOffsets(const KernelExecContext& ctx, std::vector<uint64_t>* offsets) const;
 
 private:
     const ppl::nn::common::SplitParam* param_ = nullptr;
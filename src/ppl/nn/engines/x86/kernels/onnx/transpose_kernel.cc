@@ -67,6 +67,27 @@ ppl::common::RetCode TransposeKernel::DoExecute(KernelExecContext* ctx) {
         return ppl::common::RC_UNSUPPORTED;
     }
 
+    if (data_format == ppl::common::DATAFORMAT_NHWC) {
+        if (data_type == ppl::common::DATATYPE_FLOAT32 &&
+            transposed->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_NDARRAY && dim_count == 4 &&
+            modified_perm == std::vector<int32_t>{0, 2, 3, 1} && param_->reverse == false) {
+            return ppl::kernel::x86::reorder_nhwc_nxc_fp32(&data->GetShape(), data->GetBufferPtr<float>(),
+                                                           transposed->GetBufferPtr<float>());
+        }
+        LOG(ERROR) << "transpose nhwc only support fp32 4-D tensor input & ndarray output & perm 0,2,3,1 now.";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    if (transposed->GetShape().GetDataFormat() == ppl::common::DATAFORMAT_NHWC) {
+        if (data_type == ppl::common::DATATYPE_FLOAT32 && dim_count == 4 &&
+            modified_perm == std::vector<int32_t>{0, 3, 1, 2} && param_->reverse == false) {
+            return ppl::kernel::x86::reorder_nxc_nhwc_fp32(&data->GetShape(), data->GetBufferPtr<float>(),
+                                                           transposed->GetBufferPtr<float>());
+        }
+        LOG(ERROR) << "transpose to nhwc only support fp32 4-D ndarray input & perm 0,3,1,2 now.";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
     if (dim_count >= 3) {
         std::vector<uint32_t> transpose_dim;
         transpose_dim.reserve(dim_count);
@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/ppl/pd_conv2d_kernel.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t PDConv2dKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    return executor_->cal_temp_buffer_size();
+}
+
+ppl::common::RetCode PDConv2dKernel::DoExecute(KernelExecContext* ctx) {
+    TensorImpl* X = ctx->GetInput<TensorImpl>(0);
+    TensorImpl* Y = ctx->GetOutput<TensorImpl>(0);
+
+    executor_->set_src_shape(&X->GetShape());
+    executor_->set_src(X->GetBufferPtr<float>());
+
+    executor_->set_dst_shape(&Y->GetShape());
+    executor_->set_dst(Y->GetBufferPtr<float>());
+
+    ppl::common::RetCode rc;
+    rc = executor_->prepare();
+    if (ppl::common::RC_SUCCESS != rc) {
+        LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+
+    executor_->set_temp_buffer(tmp_buffer);
+
+    const ppl::kernel::x86::conv2d_fp32_param* conv_param = executor_->conv2d_executor()->conv_param();
+    const ppl::kernel::x86::conv2d_fp32_param* post_conv_param = executor_->post_conv2d_executor()->conv_param();
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [X]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(X);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+    PPLNN_X86_DEBUG_TRACE("algo_type: %u\n", param_->algo_info.algo_type);
+    PPLNN_X86_DEBUG_TRACE("kernel_shape: %ld %ld, %ld %ld\n", conv_param->kernel_h, conv_param->kernel_w,
+                          post_conv_param->kernel_h, post_conv_param->kernel_w);
+    PPLNN_X86_DEBUG_TRACE("strides: %ld %ld, %ld %ld\n", conv_param->stride_h, conv_param->stride_w,
+                          post_conv_param->stride_h, post_conv_param->stride_w);
+    PPLNN_X86_DEBUG_TRACE("pads: %ld %ld, %ld %ld\n", conv_param->pad_h, conv_param->pad_w, post_conv_param->pad_h,
+                          post_conv_param->pad_w);
+    PPLNN_X86_DEBUG_TRACE("channels: %ld, %ld\n", conv_param->channels, post_conv_param->channels);
+    PPLNN_X86_DEBUG_TRACE("num_output: %ld, %ld\n", conv_param->num_output, post_conv_param->num_output);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %ld, %ld\n", conv_param->fuse_flag, post_conv_param->fuse_flag);
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    rc = executor_->execute();
+    if (ppl::common::RC_SUCCESS != rc) {
+        LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
@@ -56,6 +56,19 @@ ppl::common::RetCode ReorderKernel::DoExecute(KernelExecContext* ctx) {
                 return ppl::kernel::x86::reorder_n16cx_ndarray_fp32(&input->GetShape(), input->GetBufferPtr<float>(),
                                                                     output->GetBufferPtr<float>());
             }
+        } else if (input_format == ppl::common::DATAFORMAT_NDARRAY && output_format == ppl::common::DATAFORMAT_NHWC) {
+            const TensorShape padded_input_shape = PadShapeTo3Dims(input->GetShape());
+            return ppl::kernel::x86::reorder_ndarray_nhwc_fp32(&padded_input_shape, input->GetBufferPtr<float>(),
+                                                               output->GetBufferPtr<float>());
+        } else if (input_format == ppl::common::DATAFORMAT_NHWC && output_format == ppl::common::DATAFORMAT_NDARRAY) {
+            return ppl::kernel::x86::reorder_nhwc_ndarray_fp32(&input->GetShape(), input->GetBufferPtr<float>(),
+                                                               output->GetBufferPtr<float>());
+        } else if (input_format == ppl::common::DATAFORMAT_N16CX && output_format == ppl::common::DATAFORMAT_NHWC) {
+            return ppl::kernel::x86::reorder_n16cx_nhwc_fp32(&input->GetShape(), input->GetBufferPtr<float>(),
+                                                             output->GetBufferPtr<float>());
+        } else if (input_format == ppl::common::DATAFORMAT_NHWC && output_format == ppl::common::DATAFORMAT_N16CX) {
+            return ppl::kernel::x86::reorder_nhwc_n16cx_fp32(&input->GetShape(), input->GetBufferPtr<float>(),
+                                                             output->GetBufferPtr<float>());
         } else {
             LOG(ERROR) << "unsupported reorder from " << ppl::common::GetDataFormatStr(input_format) << " to "
                        << ppl::common::GetDataFormatStr(output_format) << ".";
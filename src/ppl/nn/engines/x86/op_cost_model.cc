@@ -0,0 +1,297 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "ppl/nn/engines/x86/op_cost_model.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "ppl/nn/params/onnx/gemm_param.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+static const double g_cpu_mhz = 2500.0;
+static const double g_compute_efficiency = 0.5;
+static const double g_bytes_per_us_per_thread = 10000.0; // about 10GB/s
+// memory bandwidth is saturated by a few threads
+static const uint32_t g_max_bandwidth_threads = 4;
+static const double g_launch_overhead_us = 2.0;
+
+struct OpWorkload final {
+    double flops = 0;
+    double bytes = 0;
+};
+
+static double GetFlopsPerCycle(isa_t isa) {
+    if (isa & ISA_X86_AVX512) {
+        return 64;
+    }
+    if (isa & ISA_X86_FMA) {
+        return 32;
+    }
+    if (isa & ISA_X86_AVX) {
+        return 16;
+    }
+    return 8;
+}
+
+static double CalcElements(const ir::Shape& shape, uint32_t begin = 0) {
+    double elements = 1;
+    for (uint32_t i = begin; i < shape.dims.size(); ++i) {
+        elements *= shape.dims[i];
+    }
+    return elements;
+}
+
+static double CalcBytes(const ir::Shape& shape) {
+    return CalcElements(shape) * GetSizeOfDataType(shape.data_type);
+}
+
+static bool IsKnown(const ir::Shape* shape) {
+    if (!shape) {
+        return false;
+    }
+    for (auto it = shape->dims.begin(); it != shape->dims.end(); ++it) {
+        if (*it < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the first `count` inputs are required
+static bool HasShapes(const vector<const ir::Shape*>& shapes, uint32_t count) {
+    if (shapes.size() < count) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!shapes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static double CalcInputBytes(const vector<const ir::Shape*>& input_shapes) {
+    double bytes = 0;
+    for (auto it = input_shapes.begin(); it != input_shapes.end(); ++it) {
+        if (*it) {
+            bytes += CalcBytes(**it);
+        }
+    }
+    return bytes;
+}
+
+static RetCode CalcConvWorkload(const ir::Graph* graph, const ir::Node* node, const vector<const ir::Shape*>& shapes,
+                                OpWorkload* workload) {
+    if (!HasShapes(shapes, 2)) {
+        return RC_UNSUPPORTED;
+    }
+
+    auto attr_ref = graph->data->attrs.find(node->GetId());
+    if (attr_ref == graph->data->attrs.end()) {
+        return RC_NOT_FOUND;
+    }
+    auto param = static_cast<const common::ConvolutionParam*>(attr_ref->second.get());
+
+    const ir::Shape& x = *shapes[0];
+    const ir::Shape& w = *shapes[1];
+    if (x.dims.size() < 3 || x.dims.size() != w.dims.size()) {
+        return RC_UNSUPPORTED;
+    }
+
+    const uint32_t spatial = x.dims.size() - 2;
+    double dst_elements = x.dims[0] * w.dims[0];
+    for (uint32_t i = 0; i < spatial; ++i) {
+        const int64_t kernel = w.dims[2 + i];
+        const int64_t stride = (param->strides.size() > i) ? param->strides[i] : 1;
+        const int64_t dilation = (param->dilations.size() > i) ? param->dilations[i] : 1;
+        const int64_t pad_begin = (param->pads.size() == 2 * spatial) ? param->pads[i] : 0;
+        const int64_t pad_end = (param->pads.size() == 2 * spatial) ? param->pads[i + spatial] : 0;
+        const int64_t dst_dim =
+            (x.dims[2 + i] + pad_begin + pad_end - dilation * (kernel - 1) - 1) / std::max<int64_t>(stride, 1) + 1;
+        if (dst_dim <= 0) {
+            return RC_UNSUPPORTED;
+        }
+        dst_elements *= dst_dim;
+    }
+
+    workload->flops = 2.0 * dst_elements * CalcElements(w, 1);
+    workload->bytes = CalcInputBytes(shapes) + dst_elements * GetSizeOfDataType(x.data_type);
+    return RC_SUCCESS;
+}
+
+static RetCode CalcConvTransposeWorkload(const vector<const ir::Shape*>& shapes, OpWorkload* workload) {
+    if (!HasShapes(shapes, 2)) {
+        return RC_UNSUPPORTED;
+    }
+
+    const ir::Shape& x = *shapes[0];
+    const ir::Shape& w = *shapes[1];
+    if (x.dims.size() < 3 || w.dims.size() < 3 || w.dims[0] <= 0) {
+        return RC_UNSUPPORTED;
+    }
+
+    // each src element is scattered to (num_output / group) * kernel elements
+    workload->flops = 2.0 * CalcElements(x) * CalcElements(w, 1);
+    workload->bytes = CalcInputBytes(shapes) + CalcBytes(x);
+    return RC_SUCCESS;
+}
+
+static RetCode CalcGemmWorkload(const ir::Graph* graph, const ir::Node* node, const vector<const ir::Shape*>& shapes,
+                                OpWorkload* workload) {
+    if (!HasShapes(shapes, 2)) {
+        return RC_UNSUPPORTED;
+    }
+
+    auto attr_ref = graph->data->attrs.find(node->GetId());
+    if (attr_ref == graph->data->attrs.end()) {
+        return RC_NOT_FOUND;
+    }
+    auto param = static_cast<const common::GemmParam*>(attr_ref->second.get());
+
+    const ir::Shape& a = *shapes[0];
+    const ir::Shape& b = *shapes[1];
+    if (a.dims.size() != 2 || b.dims.size() != 2) {
+        return RC_UNSUPPORTED;
+    }
+
+    const double m = param->transA ? a.dims[1] : a.dims[0];
+    const double k = param->transA ? a.dims[0] : a.dims[1];
+    const double n = param->transB ? b.dims[0] : b.dims[1];
+    workload->flops = 2.0 * m * n * k;
+    workload->bytes = CalcInputBytes(shapes) + m * n * GetSizeOfDataType(a.data_type);
+    return RC_SUCCESS;
+}
+
+static RetCode CalcMatMulWorkload(const vector<const ir::Shape*>& shapes, OpWorkload* workload) {
+    if (!HasShapes(shapes, 2)) {
+        return RC_UNSUPPORTED;
+    }
+
+    const ir::Shape& a = *shapes[0];
+    const ir::Shape& b = *shapes[1];
+    if (a.dims.empty() || b.dims.empty()) {
+        return RC_UNSUPPORTED;
+    }
+
+    const double k = a.dims.back();
+    const double m = (a.dims.size() >= 2) ? a.dims[a.dims.size() - 2] : 1;
+    const double n = (b.dims.size() >= 2) ? b.dims.back() : 1;
+    const double batch_a = (a.dims.size() > 2) ? CalcElements(a) / (m * k) : 1;
+    const double batch_b = (b.dims.size() > 2) ? CalcElements(b) / (k * n) : 1;
+    const double batch = std::max(batch_a, batch_b);
+
+    workload->flops = 2.0 * batch * m * n * k;
+    workload->bytes = CalcInputBytes(shapes) + batch * m * n * GetSizeOfDataType(a.data_type);
+    return RC_SUCCESS;
+}
+
+// X: [seq_len, batch, input_size], W: [num_directions, num_gates * hidden_size, input_size],
+// R: [num_directions, num_gates * hidden_size, hidden_size]
+static RetCode CalcRNNWorkload(const vector<const ir::Shape*>& shapes, OpWorkload* workload) {
+    if (!HasShapes(shapes, 3)) {
+        return RC_UNSUPPORTED;
+    }
+
+    const ir::Shape& x = *shapes[0];
+    const ir::Shape& r = *shapes[2];
+    if (x.dims.size() != 3 || r.dims.size() != 3) {
+        return RC_UNSUPPORTED;
+    }
+
+    const double steps = x.dims[0] * x.dims[1];
+    workload->flops = 2.0 * steps * (CalcElements(*shapes[1]) + CalcElements(r));
+    workload->bytes = CalcInputBytes(shapes) + steps * r.dims[0] * r.dims[2] * GetSizeOfDataType(x.data_type);
+    return RC_SUCCESS;
+}
+
+// memory bound ops: reads all inputs, writes an output as large as the largest input and does one flop per element
+static void CalcGenericWorkload(const vector<const ir::Shape*>& shapes, OpWorkload* workload) {
+    double max_bytes = 0, max_elements = 0;
+    for (auto it = shapes.begin(); it != shapes.end(); ++it) {
+        if (*it) {
+            max_bytes = std::max(max_bytes, CalcBytes(**it));
+            max_elements = std::max(max_elements, CalcElements(**it));
+        }
+    }
+    workload->flops = max_elements;
+    workload->bytes = CalcInputBytes(shapes) + max_bytes;
+}
+
+void OpCostModel::SetCalibration(const ProfilingStatistics& stat) {
+    measured_costs_.clear();
+    for (auto it = stat.prof_info.begin(); it != stat.prof_info.end(); ++it) {
+        if (it->exec_count > 0) {
+            measured_costs_[it->name] = (double)it->exec_microseconds / it->exec_count;
+        }
+    }
+}
+
+RetCode OpCostModel::Estimate(const ir::Graph* graph, const ir::Node* node, const vector<const ir::Shape*>& input_shapes,
+                              isa_t isa, uint32_t num_threads, double* cost) const {
+    auto measured_ref = measured_costs_.find(node->GetName());
+    if (measured_ref != measured_costs_.end()) {
+        *cost = measured_ref->second;
+        return RC_SUCCESS;
+    }
+
+    // missing optional inputs are fine, but workloads of ops with unknown input shapes cannot be estimated
+    for (uint32_t i = 0; i < input_shapes.size(); ++i) {
+        if (node->GetInput(i) != INVALID_EDGEID && !IsKnown(input_shapes[i])) {
+            return RC_UNSUPPORTED;
+        }
+    }
+
+    auto& type = node->GetType();
+    if (!type.domain.empty()) {
+        return RC_UNSUPPORTED;
+    }
+
+    OpWorkload workload;
+    RetCode status = RC_SUCCESS;
+    if (type.name == "Conv") {
+        status = CalcConvWorkload(graph, node, input_shapes, &workload);
+    } else if (type.name == "ConvTranspose") {
+        status = CalcConvTransposeWorkload(input_shapes, &workload);
+    } else if (type.name == "Gemm") {
+        status = CalcGemmWorkload(graph, node, input_shapes, &workload);
+    } else if (type.name == "MatMul") {
+        status = CalcMatMulWorkload(input_shapes, &workload);
+    } else if (type.name == "LSTM" || type.name == "GRU" || type.name == "RNN") {
+        status = CalcRNNWorkload(input_shapes, &workload);
+    } else if (type.name == "Loop" || type.name == "If" || type.name == "NonMaxSuppression") {
+        // depend on runtime values
+        status = RC_UNSUPPORTED;
+    } else {
+        CalcGenericWorkload(input_shapes, &workload);
+    }
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    num_threads = std::max(num_threads, 1u);
+    const double flops_per_us = GetFlopsPerCycle(isa) * g_cpu_mhz * g_compute_efficiency * num_threads;
+    const double bytes_per_us = GetMemoryBandwidth(num_threads);
+    *cost = g_launch_overhead_us + std::max(workload.flops / flops_per_us, workload.bytes / bytes_per_us);
+    return RC_SUCCESS;
+}
+
+double OpCostModel::GetMemoryBandwidth(uint32_t num_threads) const {
+    return g_bytes_per_us_per_thread * std::min(std::max(num_threads, 1u), g_max_bandwidth_threads);
+}
+
+}}} // namespace ppl::nn::x86
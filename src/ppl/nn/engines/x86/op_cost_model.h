@@ -0,0 +1,50 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_OP_COST_MODEL_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_OP_COST_MODEL_H_
+
+#include "ppl/nn/ir/graph.h"
+#include "ppl/nn/runtime/profiling_statistics.h"
+#include "ppl/common/sys.h"
+#include <map>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @class OpCostModel
+   @brief estimates time of ops in microseconds. an op costs the larger one of its compute time, which is
+   flops / peak flops of `isa`, and its memory time, which is bytes / memory bandwidth.
+   nodes measured in a calibration run use their measured time instead.
+*/
+class OpCostModel final {
+public:
+    /** @brief uses the average time of each kernel in `stat` for the node of the same name. */
+    void SetCalibration(const ProfilingStatistics& stat);
+
+    ppl::common::RetCode Estimate(const ir::Graph*, const ir::Node*, const std::vector<const ir::Shape*>& input_shapes,
+                                  ppl::common::isa_t isa, uint32_t num_threads, double* cost) const;
+
+    /** @brief bytes moved per microsecond by `num_threads` threads */
+    double GetMemoryBandwidth(uint32_t num_threads) const;
+
+private:
+    std::map<std::string, double> measured_costs_; // node name => microseconds per run
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -33,6 +33,9 @@ public:
     void SetFuseReLU(bool fuse_relu) {
         fuse_relu_ = fuse_relu;
     }
+    bool GetFuseReLU() const {
+        return fuse_relu_;
+    }
 
 private:
     bool fuse_relu_ = false;
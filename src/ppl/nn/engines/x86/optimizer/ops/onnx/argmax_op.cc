@@ -42,6 +42,18 @@ RetCode ArgmaxOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
+RetCode ArgmaxOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
+                               vector<dataformat_t>* selected_output_formats) {
+    auto& input_shape = info.GetInput<TensorImpl>(0)->GetShape();
+    const int32_t real_axis = param_->axis < 0 ? param_->axis + input_shape.GetDimCount() : param_->axis;
+    if (input_shape.GetDataFormat() == DATAFORMAT_N16CX && input_shape.GetDataType() == DATATYPE_FLOAT32 &&
+        real_axis == 1) {
+        // indices are written as NDARRAY directly
+        selected_input_formats->at(0) = DATAFORMAT_N16CX;
+    }
+    return RC_SUCCESS;
+}
+
 KernelImpl* ArgmaxOp::CreateKernelImpl() const {
     return CreateKernelImplWithParam<ArgMaxKernel>(param_.get());
 }
@@ -45,6 +45,9 @@ RetCode AveragePoolOp::SelectFormat(const InputOutputInfo& info, vector<dataform
     if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_N16CX) {
         selected_input_formats->at(0) = DATAFORMAT_N16CX;
         selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    } else if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_NHWC) {
+        selected_input_formats->at(0) = DATAFORMAT_NHWC;
+        selected_output_formats->at(0) = DATAFORMAT_NHWC;
     }
     return RC_SUCCESS;
 }
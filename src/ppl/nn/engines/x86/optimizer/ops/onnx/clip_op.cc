@@ -34,6 +34,9 @@ RetCode ClipOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>*
     if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_N16CX) {
         selected_input_formats->at(0) = DATAFORMAT_N16CX;
         selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    } else if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_NHWC) {
+        selected_input_formats->at(0) = DATAFORMAT_NHWC;
+        selected_output_formats->at(0) = DATAFORMAT_NHWC;
     }
     return RC_SUCCESS;
 }
@@ -32,6 +32,10 @@ public:
                                       std::vector<ppl::common::dataformat_t>* selected_input_formats,
                                       std::vector<ppl::common::dataformat_t>* selected_output_formats) override;
 
+    const ppl::nn::common::ConcatParam* GetConcatParam() const {
+        return param_.get();
+    }
+
 private:
     std::shared_ptr<ppl::nn::common::ConcatParam> param_;
 };
@@ -18,6 +18,7 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/conv_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/conv/conv2d_dynamic_kernel.h"
 #include "ppl/nn/engines/x86/kernels/onnx/conv/conv2d_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/conv/conv3d_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_convolution.h"
 #include "ppl/nn/common/logger.h"
 
@@ -40,6 +41,13 @@ ConvOp::~ConvOp() {
         }
         delete conv2d_param_;
     }
+    if (conv3d_param_ != nullptr) {
+        if (conv3d_param_->mgr != nullptr) {
+            conv3d_param_->mgr->release_cvt_weights();
+            delete conv3d_param_->mgr;
+        }
+        delete conv3d_param_;
+    }
 }
 
 RetCode ConvOp::Init(const OptKernelOptions& options) {
@@ -58,6 +66,20 @@ RetCode ConvOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
+// output tile size of winograd algorithms, 0 for others
+static inline int64_t GetWinogradTileOut(const ppl::kernel::x86::conv2d_fp32_algo_t algo_type) {
+    if (algo_type == ppl::kernel::x86::conv2d_fp32_algo::winograd_b2f3) {
+        return 2;
+    }
+    if (algo_type == ppl::kernel::x86::conv2d_fp32_algo::winograd_b4f3) {
+        return 4;
+    }
+    if (algo_type == ppl::kernel::x86::conv2d_fp32_algo::winograd_b6f3) {
+        return 6;
+    }
+    return 0;
+}
+
 ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) {
     auto node = GetNode();
     auto graph_data = options.graph_data;
@@ -116,8 +138,27 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
         conv2d_param.channels = weight_shape.dims[1] * conv_param.group;
         conv2d_param.fuse_flag = 0;
 
+        // selected again once the layout pass has changed the input format
+        if (conv2d_param_->mgr) {
+            conv2d_param_->mgr->release_cvt_weights();
+            delete conv2d_param_->mgr;
+            conv2d_param_->mgr = nullptr;
+        }
+        if (conv2d_param_->fallback_mgr) {
+            conv2d_param_->fallback_mgr->release_cvt_weights();
+            delete conv2d_param_->fallback_mgr;
+            conv2d_param_->fallback_mgr = nullptr;
+            conv2d_param_->infer_fallback_func = nullptr;
+        }
+
         conv2d_param_->algo_info = ppl::kernel::x86::conv2d_algo_selector::select_algo(
-            info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat(), conv2d_param_->param, options.device->GetISA());
+            info.GetInput<TensorImpl>(0)->GetShape(), conv2d_param_->param, options.device->GetISA());
+
+        nhwc_algo_info_ = ppl::kernel::x86::conv2d_algo_selector::select_algo(DATAFORMAT_NHWC, conv2d_param_->param,
+                                                                             options.device->GetISA());
+        if (nhwc_algo_info_.input_format != DATAFORMAT_NHWC) {
+            nhwc_algo_info_.algo_type = ppl::kernel::x86::conv2d_fp32_algo::unknown;
+        }
 
         if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
             LOG(INFO) << "Conv select algorithm failed, use fallback kernel";
@@ -125,18 +166,20 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
             conv2d_param_->mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
                 conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
 
-            // winograd b4f3 avx512 may fallback to direct
-            if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::winograd_b4f3 &&
-                conv2d_param_->algo_info.isa == ppl::common::ISA_X86_AVX512) {
+            // winograd avx512 may fallback to direct
+            const ppl::kernel::x86::conv2d_fp32_algo_t algo_type = conv2d_param_->algo_info.algo_type;
+            const int64_t tile_out = GetWinogradTileOut(algo_type);
+            if (tile_out > 0 && conv2d_param_->algo_info.isa == ppl::common::ISA_X86_AVX512) {
                 conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::direct;
                 conv2d_param_->fallback_mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
                     conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
-                conv2d_param_->infer_fallback_func = [](const TensorImpl* X, const TensorImpl* Y,
-                                                        const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
+                conv2d_param_->infer_fallback_func = [tile_out](const TensorImpl* X, const TensorImpl* Y,
+                                                                const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
                     const int64_t dst_h = Y->GetShape().GetDim(2);
                     const int64_t dst_w = Y->GetShape().GetDim(3);
                     const int64_t batch = X->GetShape().GetDim(0);
-                    const int64_t num_tiles = batch * ((dst_h + 3) / 4) * ((dst_w + 3) / 4);
+                    const int64_t num_tiles =
+                        batch * ((dst_h + tile_out - 1) / tile_out) * ((dst_w + tile_out - 1) / tile_out);
 
                     const int64_t num_threads = ppl::kernel::x86::get_omp_max_threads();
                     if (num_threads > 4) { // Maybe memory bound. Just maybe.
@@ -152,7 +195,7 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
 
                     return num_tiles < 12;
                 };
-                conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::winograd_b4f3;
+                conv2d_param_->algo_info.algo_type = algo_type;
             }
 
             if (bias_data != nullptr) {
@@ -168,6 +211,52 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
                 }
             }
         }
+    } else if (kernel_dims == 3) {
+        if (!conv3d_param_) {
+            conv3d_param_ = new Convolution3DParam;
+        }
+        if (!conv3d_param_) {
+            return ppl::common::RC_OUT_OF_MEMORY;
+        }
+
+        ppl::kernel::x86::conv3d_fp32_param& conv3d_param = conv3d_param_->param;
+        conv3d_param.kernel_d = conv_param.kernel_shape[0];
+        conv3d_param.kernel_h = conv_param.kernel_shape[1];
+        conv3d_param.kernel_w = conv_param.kernel_shape[2];
+        conv3d_param.stride_d = conv_param.strides[0];
+        conv3d_param.stride_h = conv_param.strides[1];
+        conv3d_param.stride_w = conv_param.strides[2];
+        conv3d_param.pad_d = conv_param.pads[0];
+        conv3d_param.pad_h = conv_param.pads[1];
+        conv3d_param.pad_w = conv_param.pads[2];
+        conv3d_param.dilation_d = conv_param.dilations[0];
+        conv3d_param.dilation_h = conv_param.dilations[1];
+        conv3d_param.dilation_w = conv_param.dilations[2];
+        conv3d_param.group = conv_param.group;
+        conv3d_param.num_output = weight_shape.dims[0];
+        conv3d_param.channels = weight_shape.dims[1] * conv_param.group;
+        conv3d_param.fuse_flag = 0;
+
+        conv3d_param_->algo_info = ppl::kernel::x86::conv3d_algo_selector::select_algo(
+            DATAFORMAT_N16CX, conv3d_param_->param, options.device->GetISA());
+
+        if (conv3d_param_->algo_info.algo_type == ppl::kernel::x86::conv3d_fp32_algo::unknown) {
+            LOG(ERROR) << "Conv3d select algorithm failed, no kernel for this conv.";
+            return ppl::common::RC_UNSUPPORTED;
+        }
+
+        conv3d_param_->mgr = ppl::kernel::x86::conv3d_algo_selector::gen_algo(
+            conv3d_param_->param, conv3d_param_->algo_info, options.device->GetAllocator());
+        if (!conv3d_param_->mgr) {
+            return ppl::common::RC_OUT_OF_MEMORY;
+        }
+
+        if (bias_data != nullptr) {
+            conv3d_param_->mgr->gen_cvt_weights(weight_data, bias_data);
+        } else {
+            std::vector<float> zero_bias(weight_shape.dims[0], 0.0f);
+            conv3d_param_->mgr->gen_cvt_weights(weight_data, zero_bias.data());
+        }
     } else {
         LOG(ERROR) << "Unsupported kernel dim: " << kernel_dims;
         return ppl::common::RC_UNSUPPORTED;
@@ -178,21 +267,54 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
 
 RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
                              vector<dataformat_t>* selected_output_formats) {
-    if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+    if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::unknown &&
+        info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_NHWC &&
+        nhwc_algo_info_.algo_type != ppl::kernel::x86::conv2d_fp32_algo::unknown &&
+        !(conv2d_param_->mgr->param().fuse_flag &
+          (ppl::kernel::x86::conv_fuse_flag::sum | ppl::kernel::x86::conv_fuse_flag::post_sum))) {
+        // SelectAlgorithm runs again with the nhwc input if the layout pass keeps this
+        selected_input_formats->at(0) = DATAFORMAT_NHWC;
+        selected_output_formats->at(0) = DATAFORMAT_NHWC;
+    } else if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::unknown) {
         selected_input_formats->at(0) = conv2d_param_->algo_info.input_format;
-        if (conv2d_param_->mgr->param().fuse_flag & ppl::kernel::x86::conv_fuse_flag::sum) {
+        if (conv2d_param_->mgr->param().fuse_flag &
+            (ppl::kernel::x86::conv_fuse_flag::sum | ppl::kernel::x86::conv_fuse_flag::post_sum)) {
             selected_input_formats->at(info.GetInputCount() - 1) = conv2d_param_->algo_info.input_format;
         }
         selected_output_formats->at(0) = conv2d_param_->algo_info.output_format;
+    } else if (conv3d_param_) {
+        selected_input_formats->at(0) = conv3d_param_->algo_info.input_format;
+        if (conv3d_param_->mgr->param().fuse_flag & ppl::kernel::x86::conv_fuse_flag::sum) {
+            selected_input_formats->at(info.GetInputCount() - 1) = conv3d_param_->algo_info.input_format;
+        }
+        selected_output_formats->at(0) = conv3d_param_->algo_info.output_format;
     }
     return RC_SUCCESS;
 }
 
+isa_t ConvOp::GetKernelISA(const vector<dataformat_t>& input_formats, isa_t device_isa) const {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return device_isa;
+    }
+    // nhwc kernels are fma only, so they run slower than the blocked ones on avx512
+    if (input_formats[0] == DATAFORMAT_NHWC &&
+        nhwc_algo_info_.algo_type != ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return nhwc_algo_info_.isa;
+    }
+    return conv2d_param_->algo_info.isa;
+}
+
 bool ConvOp::SetFuseReLU() {
+    if (conv3d_param_) {
+        return SetFuseConv3D(ppl::kernel::x86::conv_fuse_flag::relu);
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
         return false;
     }
     ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (ppl::kernel::x86::conv_fuse_flag::has_post_op(param.fuse_flag)) { // relu runs before post-ops in kernel
+        return false;
+    }
     param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::relu;
     conv2d_param_->mgr->set_param(param);
     if (conv2d_param_->fallback_mgr) {
@@ -202,10 +324,16 @@ bool ConvOp::SetFuseReLU() {
 }
 
 bool ConvOp::SetFuseReLU6() {
+    if (conv3d_param_) {
+        return SetFuseConv3D(ppl::kernel::x86::conv_fuse_flag::relu6);
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
         return false;
     }
     ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (ppl::kernel::x86::conv_fuse_flag::has_post_op(param.fuse_flag)) {
+        return false;
+    }
     param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::relu6;
     conv2d_param_->mgr->set_param(param);
     if (conv2d_param_->fallback_mgr) {
@@ -215,12 +343,14 @@ bool ConvOp::SetFuseReLU6() {
 }
 
 bool ConvOp::SetFuseSum() {
+    if (conv3d_param_) {
+        return SetFuseConv3D(ppl::kernel::x86::conv_fuse_flag::sum);
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
         return false;
     }
     ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
-    if ((param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::relu) || // sum cannot fuse behind activation
-        (param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::relu6)) {
+    if (param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::activation) { // sum cannot fuse behind activation
         return false;
     }
     param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::sum;
@@ -231,7 +361,121 @@ bool ConvOp::SetFuseSum() {
     return true;
 }
 
+// 3d kernels only have relu/relu6 and sum in the epilogue, same ordering rules as conv2d
+bool ConvOp::SetFuseConv3D(const ppl::kernel::x86::conv_fuse_flag_t flag) {
+    ppl::kernel::x86::conv3d_fp32_param param = conv3d_param_->mgr->param();
+    if (flag & ppl::kernel::x86::conv_fuse_flag::sum) {
+        if (param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::activation) {
+            return false;
+        }
+    }
+    const ppl::kernel::x86::conv_fuse_flag_t new_flag = param.fuse_flag | flag;
+    if (!conv3d_param_->mgr->is_fuse_supported(new_flag)) {
+        return false;
+    }
+    param.fuse_flag = new_flag;
+    conv3d_param_->mgr->set_param(param);
+    return true;
+}
+
+bool ConvOp::TrySetFuseFlag(ppl::kernel::x86::conv2d_fp32_param* param,
+                            const ppl::kernel::x86::conv_fuse_flag_t flag) {
+    const ppl::kernel::x86::conv_fuse_flag_t new_flag = param->fuse_flag | flag;
+    if (!conv2d_param_->mgr->is_fuse_supported(new_flag)) {
+        return false;
+    }
+    if (conv2d_param_->fallback_mgr && !conv2d_param_->fallback_mgr->is_fuse_supported(new_flag)) {
+        return false;
+    }
+    param->fuse_flag = new_flag;
+    conv2d_param_->mgr->set_param(*param);
+    if (conv2d_param_->fallback_mgr) {
+        conv2d_param_->fallback_mgr->set_param(*param);
+    }
+    return true;
+}
+
+// post activations run after relu/relu6 in the epilogue, only one of them can be fused and none behind post sum
+static inline bool IsPostActivationFusible(const ppl::kernel::x86::conv2d_fp32_param& param) {
+    return !(param.fuse_flag &
+             (ppl::kernel::x86::conv_fuse_flag::post_activation | ppl::kernel::x86::conv_fuse_flag::post_sum));
+}
+
+bool ConvOp::SetFuseSigmoid() {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return false;
+    }
+    ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (!IsPostActivationFusible(param)) {
+        return false;
+    }
+    return TrySetFuseFlag(&param, ppl::kernel::x86::conv_fuse_flag::sigmoid);
+}
+
+bool ConvOp::SetFuseSwish() {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return false;
+    }
+    ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (!IsPostActivationFusible(param)) {
+        return false;
+    }
+    return TrySetFuseFlag(&param, ppl::kernel::x86::conv_fuse_flag::swish);
+}
+
+bool ConvOp::SetFuseHSwish() {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return false;
+    }
+    ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (!IsPostActivationFusible(param)) {
+        return false;
+    }
+    return TrySetFuseFlag(&param, ppl::kernel::x86::conv_fuse_flag::hswish);
+}
+
+bool ConvOp::SetFuseLeakyReLU(float alpha) {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return false;
+    }
+    ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (!IsPostActivationFusible(param)) {
+        return false;
+    }
+    param.fuse_param.leaky_relu_alpha = alpha;
+    return TrySetFuseFlag(&param, ppl::kernel::x86::conv_fuse_flag::leaky_relu);
+}
+
+bool ConvOp::SetFuseClip(float min_val, float max_val) {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return false;
+    }
+    ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    if (!IsPostActivationFusible(param)) {
+        return false;
+    }
+    param.fuse_param.clip_min = min_val;
+    param.fuse_param.clip_max = max_val;
+    return TrySetFuseFlag(&param, ppl::kernel::x86::conv_fuse_flag::clip);
+}
+
+bool ConvOp::SetFusePostSum() {
+    if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
+        return false;
+    }
+    ppl::kernel::x86::conv2d_fp32_param param = conv2d_param_->mgr->param();
+    // only one sum input is supported, and post sum is meaningless without an activation before it
+    if ((param.fuse_flag & (ppl::kernel::x86::conv_fuse_flag::sum | ppl::kernel::x86::conv_fuse_flag::post_sum)) ||
+        !(param.fuse_flag & ppl::kernel::x86::conv_fuse_flag::activation)) {
+        return false;
+    }
+    return TrySetFuseFlag(&param, ppl::kernel::x86::conv_fuse_flag::post_sum);
+}
+
 KernelImpl* ConvOp::CreateKernelImpl() const {
+    if (conv3d_param_) {
+        return CreateKernelImplWithParam<Conv3dKernel>(conv3d_param_);
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::unknown) {
         return CreateKernelImplWithParam<Conv2dDynamicKernel>(param_.get());
     }
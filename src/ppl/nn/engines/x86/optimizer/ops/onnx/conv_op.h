@@ -26,7 +26,9 @@ namespace ppl { namespace nn { namespace x86 {
 
 class ConvOp final : public X86OptKernel {
 public:
-    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr) {}
+    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr), conv3d_param_(nullptr) {
+        nhwc_algo_info_.algo_type = ppl::kernel::x86::conv2d_fp32_algo::unknown;
+    }
 
     ~ConvOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
@@ -35,12 +37,39 @@ public:
                                       std::vector<ppl::common::dataformat_t>* selected_input_formats,
                                       std::vector<ppl::common::dataformat_t>* selected_output_formats) override;
     ppl::common::RetCode SelectAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) override;
+    ppl::common::isa_t GetKernelISA(const std::vector<ppl::common::dataformat_t>& input_formats,
+                                    ppl::common::isa_t device_isa) const override;
     bool SetFuseReLU();
     bool SetFuseReLU6();
     bool SetFuseSum();
+    bool SetFuseSigmoid();
+    bool SetFuseSwish();
+    bool SetFuseHSwish();
+    bool SetFuseLeakyReLU(float alpha);
+    bool SetFuseClip(float min_val, float max_val);
+    bool SetFusePostSum();
+    const Convolution2DParam* GetConv2DParam() const {
+        return conv2d_param_;
+    }
+    // transfers the ownership of conv2d param to caller, this op can not create kernel any more
+    Convolution2DParam* ReleaseConv2DParam() {
+        auto conv2d_param = conv2d_param_;
+        conv2d_param_ = nullptr;
+        return conv2d_param;
+    }
+    const Convolution3DParam* GetConv3DParam() const {
+        return conv3d_param_;
+    }
 
 private:
+    bool TrySetFuseFlag(ppl::kernel::x86::conv2d_fp32_param* param, const ppl::kernel::x86::conv_fuse_flag_t flag);
+
+    bool SetFuseConv3D(const ppl::kernel::x86::conv_fuse_flag_t flag);
+
     Convolution2DParam* conv2d_param_;
+    Convolution3DParam* conv3d_param_;
+    // algorithm taking nhwc input, probed by the layout pass
+    ppl::kernel::x86::conv2d_fp32_algo_info nhwc_algo_info_;
     std::shared_ptr<ppl::nn::common::ConvolutionParam> param_;
 };
 
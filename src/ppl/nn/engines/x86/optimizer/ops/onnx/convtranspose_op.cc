@@ -24,6 +24,13 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+ConvTransposeOp::~ConvTransposeOp() {
+    if (convtranspose_param_.packed_filter != nullptr) {
+        convtranspose_param_.allocator->Free(convtranspose_param_.packed_filter);
+        convtranspose_param_.packed_filter = nullptr;
+    }
+}
+
 RetCode ConvTransposeOp::Init(const OptKernelOptions& options) {
     auto status = GenericLoadParam(options, &param_);
     if (status != RC_SUCCESS) {
@@ -37,11 +44,119 @@ RetCode ConvTransposeOp::Init(const OptKernelOptions& options) {
 
     infer_type_func_ = GenericInferType;
 
+    convtranspose_param_.param = param_.get();
+
     return RC_SUCCESS;
 }
 
+RetCode ConvTransposeOp::SelectAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) {
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+
+    if (!(options.device->GetISA() & (ISA_X86_FMA | ISA_X86_AVX512))) {
+        return RC_SUCCESS;
+    }
+    if (param_->kernel_shape.size() != 2 || param_->strides.size() < 2 || param_->pads.size() < 2 ||
+        param_->dilations.size() < 2) {
+        return RC_SUCCESS;
+    }
+
+    auto weight_data_it = graph_data->constants.find(node->GetInput(1));
+    if (weight_data_it == graph_data->constants.end()) {
+        LOG(INFO) << "ConvTransposeOp constant weight not found, will use ndarray kernel.";
+        return RC_SUCCESS;
+    }
+    const float* bias_data = nullptr;
+    if (node->GetInputCount() >= 3) {
+        auto bias_data_it = graph_data->constants.find(node->GetInput(2));
+        if (bias_data_it == graph_data->constants.end()) {
+            LOG(INFO) << "ConvTransposeOp constant bias not found, will use ndarray kernel.";
+            return RC_SUCCESS;
+        }
+        bias_data = (const float*)bias_data_it->second.data.data();
+    }
+
+    const ir::Shape& weight_shape = graph_data->shapes.find(node->GetInput(1))->second;
+    if (weight_shape.dims.size() != 4) {
+        return RC_SUCCESS;
+    }
+    const int64_t channels = weight_shape.dims[0];
+    const int64_t num_output = weight_shape.dims[1] * param_->group;
+    if (!ppl::kernel::x86::conv_transpose_n16cx_is_supported_fp32(channels, num_output, param_->group)) {
+        return RC_SUCCESS;
+    }
+
+    auto allocator = options.device->GetAllocator();
+    const uint64_t packed_size = ppl::kernel::x86::conv_transpose_n16cx_cal_packed_filter_size_fp32(
+        channels, num_output, param_->group, param_->kernel_shape[0], param_->kernel_shape[1]);
+    float* packed_filter = (float*)allocator->Alloc(packed_size);
+    if (!packed_filter) {
+        return RC_OUT_OF_MEMORY;
+    }
+    auto status = ppl::kernel::x86::conv_transpose_n16cx_pack_filter_fp32(
+        (const float*)weight_data_it->second.data.data(), channels, num_output, param_->group,
+        param_->kernel_shape[0], param_->kernel_shape[1], packed_filter);
+    if (status != RC_SUCCESS) {
+        allocator->Free(packed_filter);
+        return RC_SUCCESS;
+    }
+
+    if (convtranspose_param_.packed_filter) {
+        convtranspose_param_.allocator->Free(convtranspose_param_.packed_filter);
+    }
+    convtranspose_param_.packed_filter = packed_filter;
+    convtranspose_param_.allocator = allocator;
+    convtranspose_param_.bias.clear();
+    if (bias_data) {
+        convtranspose_param_.bias.assign(bias_data, bias_data + num_output);
+    }
+    convtranspose_param_.fuse_flag = 0;
+
+    return RC_SUCCESS;
+}
+
+RetCode ConvTransposeOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
+                                      vector<dataformat_t>* selected_output_formats) {
+    if (convtranspose_param_.packed_filter) {
+        selected_input_formats->at(0) = DATAFORMAT_N16CX;
+        if (convtranspose_param_.fuse_flag & ppl::kernel::x86::conv_fuse_flag::sum) {
+            selected_input_formats->at(info.GetInputCount() - 1) = DATAFORMAT_N16CX;
+        }
+        selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    }
+    return RC_SUCCESS;
+}
+
+bool ConvTransposeOp::SetFuseReLU() {
+    if (!convtranspose_param_.packed_filter ||
+        (convtranspose_param_.fuse_flag & ppl::kernel::x86::conv_fuse_flag::activation)) {
+        return false;
+    }
+    convtranspose_param_.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::relu;
+    return true;
+}
+
+bool ConvTransposeOp::SetFuseReLU6() {
+    if (!convtranspose_param_.packed_filter ||
+        (convtranspose_param_.fuse_flag & ppl::kernel::x86::conv_fuse_flag::activation)) {
+        return false;
+    }
+    convtranspose_param_.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::relu6;
+    return true;
+}
+
+bool ConvTransposeOp::SetFuseSum() {
+    if (!convtranspose_param_.packed_filter ||
+        (convtranspose_param_.fuse_flag &
+         (ppl::kernel::x86::conv_fuse_flag::activation | ppl::kernel::x86::conv_fuse_flag::sum))) {
+        return false; // sum cannot fuse behind activation
+    }
+    convtranspose_param_.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::sum;
+    return true;
+}
+
 KernelImpl* ConvTransposeOp::CreateKernelImpl() const {
-    return CreateKernelImplWithParam<ConvTransposeKernel>(param_.get());
+    return CreateKernelImplWithParam<ConvTransposeKernel>(&convtranspose_param_);
 }
 
 }}} // namespace ppl::nn::x86
@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_CONVTRANSPOSE_OP_H_
 
 #include "ppl/nn/params/onnx/convtranspose_param.h"
+#include "ppl/nn/engines/x86/params/convtranspose_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -26,11 +27,20 @@ namespace ppl { namespace nn { namespace x86 {
 class ConvTransposeOp final : public X86OptKernel {
 public:
     ConvTransposeOp(const ir::Node* node) : X86OptKernel(node) {}
+    ~ConvTransposeOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    ppl::common::RetCode SelectFormat(const InputOutputInfo& info,
+                                      std::vector<ppl::common::dataformat_t>* selected_input_formats,
+                                      std::vector<ppl::common::dataformat_t>* selected_output_formats) override;
+    ppl::common::RetCode SelectAlgorithm(const InputOutputInfo& info, const OptKernelOptions& options) override;
+    bool SetFuseReLU();
+    bool SetFuseReLU6();
+    bool SetFuseSum();
 
 private:
     std::shared_ptr<ppl::nn::common::ConvTransposeParam> param_;
+    ConvTransposeParam convtranspose_param_;
 };
 
 }}} // namespace ppl::nn::x86
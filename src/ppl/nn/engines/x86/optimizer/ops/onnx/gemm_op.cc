@@ -98,28 +98,64 @@ RetCode GemmOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
-bool GemmOp::SetFuseReLU() {
-    gemm_fuse_relu_ = true;
-    if (fc_param_) {
+bool GemmOp::SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag_t gemm_flag, ppl::kernel::x86::fc_fuse_flag_t fc_flag) {
+    gemm_fuse_flag_ |= gemm_flag;
+    if (fc_param_ && fc_param_->mgr) {
         ppl::kernel::x86::fc_fp32_param param = fc_param_->mgr->param();
-        param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::relu;
+        param.fuse_flag |= fc_flag;
         fc_param_->mgr->set_param(param);
+        fc_param_->param = param;
+    }
+    return true;
+}
+
+bool GemmOp::SetFuseReLU() {
+    if (gemm_fuse_flag_ != ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+        return false;
+    }
+    return SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag::relu, ppl::kernel::x86::fc_fuse_flag::relu);
+}
+
+bool GemmOp::SetFuseSigmoid() {
+    if (gemm_fuse_flag_ != ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+        return false;
+    }
+    return SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag::sigmoid, ppl::kernel::x86::fc_fuse_flag::sigmoid);
+}
+
+bool GemmOp::SetFuseBias(const float* bias) {
+    // the fallback kernel reads the bias as C, so there must be no C yet and beta must keep it unscaled
+    if (gemm_fuse_flag_ != ppl::kernel::x86::gemm_v2_fuse_flag::none || GetNode()->GetInputCount() != 2 ||
+        param_->beta != 1.0f) {
+        return false;
+    }
+    if (fc_param_ && fc_param_->mgr) {
+        if (fc_param_->mgr->fuse_bias(bias) != RC_SUCCESS) {
+            return false;
+        }
     }
     return true;
 }
 
+bool GemmOp::SetFuseSum() {
+    if (gemm_fuse_flag_ & ppl::kernel::x86::gemm_v2_fuse_flag::sum) {
+        return false;
+    }
+    return SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag::sum, ppl::kernel::x86::fc_fuse_flag::sum);
+}
+
 KernelImpl* GemmOp::CreateKernelImpl() const {
     if (fc_param_) {
         if (fc_param_->algo_info.algo_type == ppl::kernel::x86::fc_fp32_algo::unknown) {
             auto kernel = CreateKernelImplWithParam<GemmKernel>(param_.get());
-            kernel->SetFuseReLU(gemm_fuse_relu_);
+            kernel->SetFuseFlag(gemm_fuse_flag_);
             return kernel;
         } else {
             return CreateKernelImplWithParam<FCKernel>(fc_param_);
         }
     } else {
         auto kernel = CreateKernelImplWithParam<GemmKernel>(param_.get());
-        kernel->SetFuseReLU(gemm_fuse_relu_);
+        kernel->SetFuseFlag(gemm_fuse_flag_);
         return kernel;
     }
 }
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/params/onnx/gemm_param.h"
 #include "ppl/nn/engines/x86/params/fc_param.h"
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -31,11 +32,18 @@ public:
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
     bool SetFuseReLU();
+    bool SetFuseSigmoid();
+    // bias must have num_output elements; it is added before any fused activation
+    bool SetFuseBias(const float* bias);
+    bool SetFuseSum();
+
+private:
+    bool SetFuseFlag(ppl::kernel::x86::gemm_v2_fuse_flag_t gemm_flag, ppl::kernel::x86::fc_fuse_flag_t fc_flag);
 
 private:
     FCParam* fc_param_;
     std::shared_ptr<ppl::nn::common::GemmParam> param_;
-    bool gemm_fuse_relu_ = false;
+    ppl::kernel::x86::gemm_v2_fuse_flag_t gemm_fuse_flag_ = ppl::kernel::x86::gemm_v2_fuse_flag::none;
 };
 
 }}} // namespace ppl::nn::x86
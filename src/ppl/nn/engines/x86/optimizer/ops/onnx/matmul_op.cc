@@ -33,8 +33,45 @@ RetCode MatMulOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
+bool MatMulOp::SetFuseReLU() {
+    if (fuse_flag_ != ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+        return false;
+    }
+    fuse_flag_ |= ppl::kernel::x86::gemm_v2_fuse_flag::relu;
+    return true;
+}
+
+bool MatMulOp::SetFuseSigmoid() {
+    if (fuse_flag_ != ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+        return false;
+    }
+    fuse_flag_ |= ppl::kernel::x86::gemm_v2_fuse_flag::sigmoid;
+    return true;
+}
+
+bool MatMulOp::SetFuseBias() {
+    if (fuse_bias_ || fuse_flag_ != ppl::kernel::x86::gemm_v2_fuse_flag::none) {
+        return false;
+    }
+    fuse_bias_ = true;
+    return true;
+}
+
+bool MatMulOp::SetFuseSum() {
+    if (fuse_flag_ & ppl::kernel::x86::gemm_v2_fuse_flag::sum) {
+        return false;
+    }
+    fuse_flag_ |= ppl::kernel::x86::gemm_v2_fuse_flag::sum;
+    return true;
+}
+
 KernelImpl* MatMulOp::CreateKernelImpl() const {
-    return CreateKernelImplWithoutParam<MatMulKernel>();
+    auto kernel = CreateKernelImplWithoutParam<MatMulKernel>();
+    if (kernel) {
+        kernel->SetFuseFlag(fuse_flag_);
+        kernel->SetFuseBias(fuse_bias_);
+    }
+    return kernel;
 }
 
 }}} // namespace ppl::nn::x86
@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_MATMUL_OP_H_
 
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -27,6 +28,15 @@ public:
     MatMulOp(const ir::Node* node) : X86OptKernel(node) {}
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    bool SetFuseReLU();
+    bool SetFuseSigmoid();
+    // the bias becomes input 2 and must have as many elements as the last dim of output
+    bool SetFuseBias();
+    bool SetFuseSum();
+
+private:
+    ppl::kernel::x86::gemm_v2_fuse_flag_t fuse_flag_ = ppl::kernel::x86::gemm_v2_fuse_flag::none;
+    bool fuse_bias_ = false;
 };
 
 }}} // namespace ppl::nn::x86
@@ -45,6 +45,10 @@ RetCode MaxPoolOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t
     if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_N16CX && info.GetOutputCount() == 1) {
         selected_input_formats->at(0) = DATAFORMAT_N16CX;
         selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    } else if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_NHWC &&
+               info.GetOutputCount() == 1) {
+        selected_input_formats->at(0) = DATAFORMAT_NHWC;
+        selected_output_formats->at(0) = DATAFORMAT_NHWC;
     }
     return RC_SUCCESS;
 }
@@ -42,9 +42,15 @@ RetCode ReduceSumOp::Init(const OptKernelOptions& options) {
 
 RetCode ReduceSumOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
                                   vector<dataformat_t>* selected_output_formats) {
-    if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_N16CX && param_->keep_dims) {
-        selected_input_formats->at(0) = DATAFORMAT_N16CX;
-        selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    auto& input_shape = info.GetInput<TensorImpl>(0)->GetShape();
+    if (input_shape.GetDataFormat() == DATAFORMAT_N16CX) {
+        if (param_->keep_dims) {
+            selected_input_formats->at(0) = DATAFORMAT_N16CX;
+            selected_output_formats->at(0) = DATAFORMAT_N16CX;
+        } else if (input_shape.GetDataType() == DATATYPE_FLOAT32 && input_shape.GetDimCount() >= 3) {
+            // reduced result is reordered into NDARRAY inside the kernel
+            selected_input_formats->at(0) = DATAFORMAT_N16CX;
+        }
     }
     return RC_SUCCESS;
 }
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/rnn_op.h"
+#include "ppl/nn/engines/x86/kernels/onnx/rnn_kernel.h"
+#include "ppl/nn/oputils/onnx/reshape_rnn.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+RetCode RNNOp::Init(const OptKernelOptions& options) {
+    auto status = GenericLoadParam(options, &param_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "load param failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    auto node = GetNode();
+    auto& kernel_param = kernel_param_.param;
+
+    const string& op_type = node->GetType().name;
+    if (op_type == "LSTM") {
+        kernel_param.cell = ppl::kernel::x86::rnn_cell_type::lstm;
+    } else if (op_type == "GRU") {
+        kernel_param.cell = ppl::kernel::x86::rnn_cell_type::gru;
+    } else {
+        kernel_param.cell = ppl::kernel::x86::rnn_cell_type::rnn;
+    }
+    kernel_param.direction = param_->direction;
+    kernel_param.hidden_size = param_->hidden_size;
+    kernel_param.clip = param_->clip;
+    kernel_param.input_forget = param_->input_forget;
+    kernel_param.linear_before_reset = param_->linear_before_reset;
+
+    const uint32_t num_activation = ppl::kernel::x86::rnn_num_activation(kernel_param.cell) *
+        ppl::kernel::x86::rnn_num_direction(kernel_param.direction);
+    if (param_->activations.size() != num_activation) {
+        LOG(ERROR) << "activations size[" << param_->activations.size() << "] != " << num_activation;
+        return RC_INVALID_VALUE;
+    }
+    for (uint32_t i = 0; i < num_activation; ++i) {
+        kernel_param.activations[i] = param_->activations[i];
+    }
+
+    // recurrence weight is streamed once per timestep, pack it ahead of time when it is known
+    auto graph_data = options.graph_data;
+    auto R_data_it = graph_data->constants.find(node->GetInput(2));
+    if (R_data_it != graph_data->constants.end()) {
+        const ir::Shape& R_shape = graph_data->shapes.find(node->GetInput(2))->second;
+        if (R_shape.data_type == DATATYPE_FLOAT32) {
+            kernel_param_.packed_R.resize(ppl::kernel::x86::rnn_fp32_get_packed_weight_bytes(kernel_param) /
+                                          sizeof(float));
+            ppl::kernel::x86::rnn_fp32_pack_weight(kernel_param, (const float*)R_data_it->second.data.data(),
+                                                   kernel_param_.packed_R.data());
+        }
+    }
+
+    infer_dims_func_ = [this](InputOutputInfo* info) -> RetCode {
+        return oputils::ReshapeRNN(info, param_.get(), ppl::kernel::x86::rnn_num_gate(kernel_param_.param.cell));
+    };
+
+    infer_type_func_ = GenericInferType;
+
+    return RC_SUCCESS;
+}
+
+KernelImpl* RNNOp::CreateKernelImpl() const {
+    return CreateKernelImplWithParam<RNNKernel>(&kernel_param_);
+}
+
+}}} // namespace ppl::nn::x86
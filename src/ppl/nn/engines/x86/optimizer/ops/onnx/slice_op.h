@@ -27,6 +27,9 @@ public:
     SliceOp(const ir::Node* node) : X86OptKernel(node) {}
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    bool MayShareInputBuffer() const override {
+        return true;
+    }
 };
 
 }}} // namespace ppl::nn::x86
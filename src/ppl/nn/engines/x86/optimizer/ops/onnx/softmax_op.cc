@@ -36,6 +36,18 @@ RetCode SoftmaxOp::Init(const OptKernelOptions& options) {
     return RC_SUCCESS;
 }
 
+RetCode SoftmaxOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
+                                vector<dataformat_t>* selected_output_formats) {
+    auto& input_shape = info.GetInput<TensorImpl>(0)->GetShape();
+    const int32_t real_axis = param_->axis < 0 ? param_->axis + input_shape.GetDimCount() : param_->axis;
+    if (input_shape.GetDataFormat() == DATAFORMAT_N16CX && input_shape.GetDataType() == DATATYPE_FLOAT32 &&
+        real_axis == 1) {
+        selected_input_formats->at(0) = DATAFORMAT_N16CX;
+        selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    }
+    return RC_SUCCESS;
+}
+
 KernelImpl* SoftmaxOp::CreateKernelImpl() const {
     return CreateKernelImplWithParam<SoftmaxKernel>(param_.get());
 }
@@ -40,6 +40,16 @@ RetCode SubOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* s
         selected_input_formats->at(0) = DATAFORMAT_N16CX;
         selected_input_formats->at(1) = DATAFORMAT_N16CX;
         selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    } else if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_NHWC &&
+               info.GetInput<TensorImpl>(1)->GetShape().GetDataFormat() == DATAFORMAT_NHWC &&
+               info.GetInput<TensorImpl>(0)->GetShape().GetElementsExcludingPadding() ==
+                   info.GetOutput<TensorImpl>(0)->GetShape().GetElementsExcludingPadding() &&
+               info.GetInput<TensorImpl>(1)->GetShape().GetElementsExcludingPadding() ==
+                   info.GetOutput<TensorImpl>(0)->GetShape().GetElementsExcludingPadding()) {
+        // nhwc only runs the elementwise path, broadcasting is done on ndarray
+        selected_input_formats->at(0) = DATAFORMAT_NHWC;
+        selected_input_formats->at(1) = DATAFORMAT_NHWC;
+        selected_output_formats->at(0) = DATAFORMAT_NHWC;
     }
     return RC_SUCCESS;
 }
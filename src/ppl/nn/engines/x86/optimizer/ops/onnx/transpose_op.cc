@@ -49,6 +49,17 @@ RetCode TransposeOp::SelectFormat(const InputOutputInfo& info, vector<dataformat
         selected_input_formats->at(0) = DATAFORMAT_N16CX;
         selected_output_formats->at(0) = DATAFORMAT_NDARRAY;
     }
+    if (info.GetInput<TensorImpl>(0)->GetShape().GetDataFormat() == DATAFORMAT_NHWC &&
+        info.GetInput<TensorImpl>(0)->GetShape().GetDataType() == DATATYPE_FLOAT32 &&
+        info.GetInput<TensorImpl>(0)->GetShape().GetDimCount() == 4 && param_->reverse == false) {
+        if (param_->perm == std::vector<int32_t>{0, 3, 1, 2}) { // ndarray NHWC -> nhwc NCHW, where nhwc ops start
+            selected_input_formats->at(0) = DATAFORMAT_NDARRAY;
+            selected_output_formats->at(0) = DATAFORMAT_NHWC;
+        } else if (param_->perm == std::vector<int32_t>{0, 2, 3, 1}) { // nhwc NCHW -> ndarray NHWC
+            selected_input_formats->at(0) = DATAFORMAT_NHWC;
+            selected_output_formats->at(0) = DATAFORMAT_NDARRAY;
+        }
+    }
     return RC_SUCCESS;
 }
 
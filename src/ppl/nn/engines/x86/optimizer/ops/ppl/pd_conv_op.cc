@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/pd_conv_op.h"
+#include "ppl/nn/engines/x86/kernels/ppl/pd_conv2d_kernel.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+static void DeleteConv2DParam(Convolution2DParam* conv2d_param) {
+    if (conv2d_param->mgr != nullptr) {
+        conv2d_param->mgr->release_cvt_weights();
+        delete conv2d_param->mgr;
+    }
+    if (conv2d_param->fallback_mgr != nullptr) {
+        conv2d_param->fallback_mgr->release_cvt_weights();
+        delete conv2d_param->fallback_mgr;
+    }
+    delete conv2d_param;
+}
+
+PDConvOp::~PDConvOp() {
+    if (pd_conv2d_param_ != nullptr) {
+        if (pd_conv2d_param_->mgr != nullptr) {
+            delete pd_conv2d_param_->mgr;
+        }
+        if (pd_conv2d_param_->conv2d_param != nullptr) {
+            DeleteConv2DParam(pd_conv2d_param_->conv2d_param);
+        }
+        if (pd_conv2d_param_->post_conv2d_param != nullptr) {
+            DeleteConv2DParam(pd_conv2d_param_->post_conv2d_param);
+        }
+        delete pd_conv2d_param_;
+    }
+}
+
+static RetCode CalcConv2DOutputSize(const ppl::kernel::x86::conv2d_fp32_param& param, int64_t* h, int64_t* w) {
+    const int64_t ext_kernel_h = (param.kernel_h - 1) * param.dilation_h + 1;
+    const int64_t ext_kernel_w = (param.kernel_w - 1) * param.dilation_w + 1;
+    const int64_t out_h = (*h + 2 * param.pad_h - ext_kernel_h) / param.stride_h + 1;
+    const int64_t out_w = (*w + 2 * param.pad_w - ext_kernel_w) / param.stride_w + 1;
+    if (out_h <= 0 || out_w <= 0) {
+        LOG(ERROR) << "Output Width or Height Is Invalid Value!";
+        return RC_INVALID_VALUE;
+    }
+    *h = out_h;
+    *w = out_w;
+    return RC_SUCCESS;
+}
+
+RetCode PDConvOp::Init(const OptKernelOptions& options) {
+    infer_dims_func_ = [this](InputOutputInfo* info) -> RetCode {
+        if (!pd_conv2d_param_) {
+            return RC_INVALID_VALUE;
+        }
+        auto x = &info->GetInput<TensorImpl>(0)->GetShape();
+        auto y = &info->GetOutput<TensorImpl>(0)->GetShape();
+        if (x->GetDimCount() != 4) {
+            return RC_INVALID_VALUE;
+        }
+
+        int64_t h = x->GetDim(2);
+        int64_t w = x->GetDim(3);
+        auto status = CalcConv2DOutputSize(pd_conv2d_param_->conv2d_param->param, &h, &w);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+        status = CalcConv2DOutputSize(pd_conv2d_param_->post_conv2d_param->param, &h, &w);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        y->SetDimCount(4);
+        y->SetDim(0, x->GetDim(0));
+        y->SetDim(1, pd_conv2d_param_->post_conv2d_param->param.num_output);
+        y->SetDim(2, h);
+        y->SetDim(3, w);
+        y->CalcPadding();
+        return RC_SUCCESS;
+    };
+
+    infer_type_func_ = GenericInferType;
+
+    return RC_SUCCESS;
+}
+
+void PDConvOp::SetPDConv2DParam(PDConv2DParam* param) {
+    pd_conv2d_param_ = param;
+}
+
+RetCode PDConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
+                               vector<dataformat_t>* selected_output_formats) {
+    if (pd_conv2d_param_) {
+        selected_input_formats->at(0) = pd_conv2d_param_->algo_info.input_format;
+        selected_output_formats->at(0) = pd_conv2d_param_->algo_info.output_format;
+    }
+    return RC_SUCCESS;
+}
+
+KernelImpl* PDConvOp::CreateKernelImpl() const {
+    return CreateKernelImplWithParam<PDConv2dKernel>(pd_conv2d_param_);
+}
+
+}}} // namespace ppl::nn::x86
@@ -20,15 +20,25 @@
 #include "ppl/nn/utils/utils.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/conv_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/convtranspose_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/concat_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/channel_shuffle_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/pd_conv_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/add_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/mul_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/sub_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/div_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gemm_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/matmul_op.h"
 #include "ppl/nn/params/onnx/transpose_param.h"
+#include "ppl/nn/params/onnx/leaky_relu_param.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/batch_normalization_op.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
 #include <string.h>
+#include <float.h>
+#include <algorithm>
+#include <map>
+#include <set>
 
 //#define SHOW_GRAPH_VIS
 #ifdef SHOW_GRAPH_VIS
@@ -204,11 +214,30 @@ inline bool IsGraphOutput(const ir::Graph* graph, edgeid_t edge_id) {
     return false;
 }
 
-RetCode OptGraph::LayoutOptimize(const OptKernelOptions& options) {
-    vector<nodeid_t> sorted_nodes;
-    graph_->topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
-        sorted_nodes.push_back(nid);
-    });
+// formats every node is probed with when collecting its layout candidates
+static const dataformat_t g_layout_probe_formats[] = {DATAFORMAT_NDARRAY, DATAFORMAT_N16CX, DATAFORMAT_NHWC};
+
+// blocked formats are only probed on fp32 spatial tensors, which are what the blocked kernels produce
+static bool CanProbeFormat(const TensorShape& shape, dataformat_t format) {
+    if (format == DATAFORMAT_NDARRAY) {
+        return true;
+    }
+    if (format == DATAFORMAT_NHWC) { // only 2d conv and pooling have nhwc kernels
+        return shape.GetDataType() == DATATYPE_FLOAT32 && shape.GetDimCount() == 4;
+    }
+    return shape.GetDataType() == DATATYPE_FLOAT32 && shape.GetDimCount() >= 4;
+}
+
+RetCode OptGraph::CollectLayoutCandidates(const OptKernelOptions& options, const vector<nodeid_t>& sorted_nodes,
+                                          vector<NodeLayout>* layouts) {
+    layouts->resize(graph_->topo->GetMaxNodeId());
+
+    const isa_t device_isa = options.device->GetISA();
+    uint32_t num_threads = options.device->GetThreadNum();
+    if (num_threads == 0) {
+        num_threads = ppl::kernel::x86::get_omp_max_threads();
+    }
+    const double bytes_per_us = cost_model_.GetMemoryBandwidth(num_threads);
 
     for (auto node_id : sorted_nodes) {
         if (info_->kernels.find(node_id) == info_->kernels.end()) {
@@ -217,6 +246,7 @@ RetCode OptGraph::LayoutOptimize(const OptKernelOptions& options) {
         }
         auto kernel = (X86OptKernel*)info_->kernels[node_id].get();
         auto node = kernel->GetNode();
+        auto& layout = layouts->at(node_id);
 
         InputOutputInfo IOinfo;
         IOinfo.SetNode(node);
@@ -234,14 +264,348 @@ RetCode OptGraph::LayoutOptimize(const OptKernelOptions& options) {
             return status;
         }
 
-        vector<dataformat_t> selected_input_formats(node->GetInputCount(), DATAFORMAT_NDARRAY);
-        vector<dataformat_t> selected_output_formats(node->GetOutputCount(), DATAFORMAT_NDARRAY);
+        // kernels of different formats may use different isas, e.g. nhwc conv is fma only
+        vector<ir::Shape> input_shapes(node->GetInputCount());
+        vector<const ir::Shape*> input_shape_ptrs(node->GetInputCount(), nullptr);
+        for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+            auto edge_id = node->GetInput(i);
+            if (edge_id != INVALID_EDGEID) {
+                auto& shape = tensor_impls_[edge_id]->GetShape();
+                input_shapes[i].data_type = shape.GetDataType();
+                input_shapes[i].data_format = shape.GetDataFormat();
+                input_shapes[i].dims.assign(shape.GetDims(), shape.GetDims() + shape.GetDimCount());
+                input_shape_ptrs[i] = &input_shapes[i];
+            }
+        }
+        auto estimate_kernel_cost = [this, kernel, node, device_isa, num_threads, bytes_per_us,
+                                     &input_shape_ptrs](LayoutCandidate* candidate) -> void {
+            const isa_t isa = kernel->GetKernelISA(candidate->input_formats, device_isa);
+            double cost = 0;
+            if (cost_model_.Estimate(graph_, node, input_shape_ptrs, isa, num_threads, &cost) == RC_SUCCESS) {
+                candidate->kernel_cost = cost * bytes_per_us;
+            }
+        };
+
+        auto select_format = [kernel, node, &IOinfo, &estimate_kernel_cost](dataformat_t probe_format,
+                                                                            LayoutCandidate* candidate) -> RetCode {
+            candidate->probe_format = probe_format;
+            candidate->input_formats.assign(node->GetInputCount(), DATAFORMAT_NDARRAY);
+            candidate->output_formats.assign(node->GetOutputCount(), DATAFORMAT_NDARRAY);
+            auto status = kernel->SelectFormat(IOinfo, &candidate->input_formats, &candidate->output_formats);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "kernel[" << node->GetName() << "] SelectFormat failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            estimate_kernel_cost(candidate);
+            return RC_SUCCESS;
+        };
+        auto add_candidate = [&layout](const LayoutCandidate& candidate) -> uint32_t {
+            for (uint32_t i = 0; i < layout.candidates.size(); i++) {
+                if (layout.candidates[i].input_formats == candidate.input_formats &&
+                    layout.candidates[i].output_formats == candidate.output_formats) {
+                    return i;
+                }
+            }
+            layout.candidates.push_back(candidate);
+            return layout.candidates.size() - 1;
+        };
+
+        vector<dataformat_t> input_formats(node->GetInputCount(), DATAFORMAT_UNKNOWN);
+        for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+            auto edge_id = node->GetInput(i);
+            if (edge_id != INVALID_EDGEID) {
+                input_formats[i] = tensor_impls_[edge_id]->GetShape().GetDataFormat();
+            }
+        }
 
-        status = kernel->SelectFormat(IOinfo, &selected_input_formats, &selected_output_formats);
+        for (auto probe_format : g_layout_probe_formats) {
+            for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+                auto edge_id = node->GetInput(i);
+                if (edge_id != INVALID_EDGEID) {
+                    auto& shape = tensor_impls_[edge_id]->GetShape();
+                    shape.SetDataFormat(CanProbeFormat(shape, probe_format) ? probe_format : DATAFORMAT_NDARRAY);
+                }
+            }
+
+            LayoutCandidate candidate;
+            status = select_format(probe_format, &candidate);
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+            add_candidate(candidate);
+        }
+
+        for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+            auto edge_id = node->GetInput(i);
+            if (edge_id != INVALID_EDGEID) {
+                tensor_impls_[edge_id]->GetShape().SetDataFormat(input_formats[i]);
+            }
+        }
+
+        // what per-node selection picks with the formats its producers chose; the search starts from here
+        LayoutCandidate candidate;
+        status = select_format(DATAFORMAT_UNKNOWN, &candidate);
         if (status != RC_SUCCESS) {
-            LOG(ERROR) << "kernel[" << node->GetName() << "] SelectFormat failed: " << GetRetCodeStr(status);
             return status;
         }
+        layout.selected = add_candidate(candidate);
+
+        for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+            tensor_impls_[node->GetOutput(i)]->GetShape().SetDataFormat(candidate.output_formats[i]);
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+/*
+  cost of `nodes` and `edges` under `layouts`, in bytes moved:
+    - each node costs the estimated time of its kernel in the selected formats, converted to bytes
+    - the producer writes the edge in its selected format, which is how layouts with padding get more expensive
+    - each distinct format that consumers ask for and the producer does not write costs one reorder (read + write).
+      reorders to the same format on one edge are merged by FuseReorderOp, so they are only counted once.
+*/
+double OptGraph::CalcLayoutCost(const vector<nodeid_t>& nodes, const vector<edgeid_t>& edges,
+                                const vector<NodeLayout>& layouts) const {
+    auto calc_bytes = [this](edgeid_t edge_id, dataformat_t format) -> double {
+        TensorShape shape = tensor_impls_.find(edge_id)->second->GetShape();
+        shape.SetDataFormat(format);
+        auto bytes = shape.GetBytesIncludingPadding();
+        return bytes > 0 ? (double)bytes : 1.0; // unknown dims: at least count the number of reorders
+    };
+
+    double cost = 0;
+    for (auto node_id : nodes) {
+        cost += layouts[node_id].candidates[layouts[node_id].selected].kernel_cost;
+    }
+    for (auto edge_id : edges) {
+        auto edge = graph_->topo->GetEdgeById(edge_id);
+
+        auto produced_format = tensor_impls_.find(edge_id)->second->GetShape().GetDataFormat();
+        auto producer_id = edge->GetProducer();
+        if (producer_id != INVALID_NODEID) {
+            auto producer = graph_->topo->GetNodeById(producer_id);
+            auto& candidate = layouts[producer_id].candidates[layouts[producer_id].selected];
+            for (uint32_t i = 0; i < producer->GetOutputCount(); i++) {
+                if (producer->GetOutput(i) == edge_id) {
+                    produced_format = candidate.output_formats[i];
+                    break;
+                }
+            }
+            cost += calc_bytes(edge_id, produced_format);
+        }
+
+        vector<dataformat_t> reorder_formats;
+        auto add_demand = [produced_format, &reorder_formats](dataformat_t format) -> void {
+            if (format != produced_format &&
+                std::find(reorder_formats.begin(), reorder_formats.end(), format) == reorder_formats.end()) {
+                reorder_formats.push_back(format);
+            }
+        };
+        for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+            auto consumer = graph_->topo->GetNodeById(it.Get());
+            auto& candidate = layouts[consumer->GetId()].candidates[layouts[consumer->GetId()].selected];
+            for (uint32_t i = 0; i < consumer->GetInputCount(); i++) {
+                if (consumer->GetInput(i) == edge_id) {
+                    add_demand(candidate.input_formats[i]);
+                }
+            }
+            for (uint32_t i = 0; i < consumer->GetExtraInputCount(); i++) {
+                if (consumer->GetExtraInput(i) == edge_id) {
+                    add_demand(DATAFORMAT_NDARRAY);
+                }
+            }
+        }
+
+        for (auto format : reorder_formats) {
+            cost += calc_bytes(edge_id, produced_format) + calc_bytes(edge_id, format);
+        }
+    }
+
+    return cost;
+}
+
+/*
+  local search starting from the per-node selection. a move either switches one node to another candidate, or
+  switches a whole connected region of nodes that were probed with the same format (e.g. a chain of elementwise ops
+  between two convolutions) to the candidates probed with another format. moves are only taken if they strictly
+  lower the cost, so the result never needs more conversions than per-node selection.
+*/
+void OptGraph::SearchLayoutAssignment(const vector<nodeid_t>& sorted_nodes, vector<NodeLayout>* layouts) const {
+    auto find_candidate = [](const NodeLayout& layout, dataformat_t probe_format) -> uint32_t {
+        for (uint32_t i = 0; i < layout.candidates.size(); i++) {
+            if (layout.candidates[i].probe_format == probe_format) {
+                return i;
+            }
+        }
+        return UINT32_MAX;
+    };
+
+    auto try_assign = [this, layouts](const vector<nodeid_t>& nodes, const vector<uint32_t>& selected) -> bool {
+        std::set<edgeid_t> edge_set;
+        for (auto node_id : nodes) {
+            auto node = graph_->topo->GetNodeById(node_id);
+            for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+                if (node->GetInput(i) != INVALID_EDGEID) {
+                    edge_set.insert(node->GetInput(i));
+                }
+            }
+            for (uint32_t i = 0; i < node->GetExtraInputCount(); i++) {
+                edge_set.insert(node->GetExtraInput(i));
+            }
+            for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+                edge_set.insert(node->GetOutput(i));
+            }
+        }
+        const vector<edgeid_t> edges(edge_set.begin(), edge_set.end());
+
+        const double old_cost = CalcLayoutCost(nodes, edges, *layouts);
+        vector<uint32_t> old_selected(nodes.size());
+        for (uint32_t i = 0; i < nodes.size(); i++) {
+            old_selected[i] = layouts->at(nodes[i]).selected;
+            layouts->at(nodes[i]).selected = selected[i];
+        }
+        if (CalcLayoutCost(nodes, edges, *layouts) < old_cost - 0.5) {
+            return true;
+        }
+        for (uint32_t i = 0; i < nodes.size(); i++) {
+            layouts->at(nodes[i]).selected = old_selected[i];
+        }
+        return false;
+    };
+
+    // producers and consumers of each node, which do not change during the search
+    vector<vector<nodeid_t>> neighbors(layouts->size());
+    for (auto node_id : sorted_nodes) {
+        auto node = graph_->topo->GetNodeById(node_id);
+        for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+            if (node->GetInput(i) != INVALID_EDGEID) {
+                auto producer_id = graph_->topo->GetEdgeById(node->GetInput(i))->GetProducer();
+                if (producer_id != INVALID_NODEID) {
+                    neighbors[node_id].push_back(producer_id);
+                }
+            }
+        }
+        for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+            auto edge = graph_->topo->GetEdgeById(node->GetOutput(i));
+            for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+                neighbors[node_id].push_back(it.Get());
+            }
+        }
+    }
+
+    /*
+      a region is the same for every node in it, so it is searched and tried once until a move changes the
+      selections. region_index maps a node and the format to switch to to the region found from it.
+    */
+    struct Region {
+        vector<nodeid_t> nodes;
+        vector<uint32_t> selected;
+    };
+    vector<Region> regions;
+    std::map<std::pair<nodeid_t, dataformat_t>, uint32_t> region_index;
+
+    auto find_region = [&](nodeid_t node_id, uint32_t c) -> const Region& {
+        auto& layout = layouts->at(node_id);
+        auto from_format = layout.candidates[layout.selected].probe_format;
+        auto to_format = layout.candidates[c].probe_format;
+        auto ref = region_index.find(std::make_pair(node_id, to_format));
+        if (ref != region_index.end()) {
+            return regions[ref->second];
+        }
+
+        Region region;
+        region.nodes.push_back(node_id);
+        region.selected.push_back(c);
+        std::set<nodeid_t> visited = {node_id};
+        for (uint32_t r = 0; r < region.nodes.size(); r++) {
+            for (auto neighbor_id : neighbors[region.nodes[r]]) {
+                if (!visited.insert(neighbor_id).second) {
+                    continue;
+                }
+                auto& neighbor = layouts->at(neighbor_id);
+                auto neighbor_candidate = find_candidate(neighbor, to_format);
+                if (neighbor.candidates[neighbor.selected].probe_format == from_format &&
+                    neighbor_candidate != UINT32_MAX) {
+                    region.nodes.push_back(neighbor_id);
+                    region.selected.push_back(neighbor_candidate);
+                }
+            }
+        }
+
+        for (auto member_id : region.nodes) {
+            region_index[std::make_pair(member_id, to_format)] = regions.size();
+        }
+        regions.push_back(std::move(region));
+        return regions.back();
+    };
+
+    const uint32_t max_rounds = 8;
+    for (uint32_t round = 0; round < max_rounds; round++) {
+        bool improved = false;
+        for (auto node_id : sorted_nodes) {
+            auto& layout = layouts->at(node_id);
+            bool moved = false;
+            for (uint32_t c = 0; c < layout.candidates.size() && !moved; c++) {
+                if (c == layout.selected) {
+                    continue;
+                }
+                if (try_assign({node_id}, {c})) {
+                    moved = true;
+                    break;
+                }
+
+                auto from_format = layout.candidates[layout.selected].probe_format;
+                auto to_format = layout.candidates[c].probe_format;
+                if (from_format == DATAFORMAT_UNKNOWN || to_format == DATAFORMAT_UNKNOWN) {
+                    continue;
+                }
+
+                const bool searched = (region_index.find(std::make_pair(node_id, to_format)) != region_index.end());
+                auto& region = find_region(node_id, c);
+                // a region found before failed already if nothing moved since
+                if (!searched && region.nodes.size() > 1 && try_assign(region.nodes, region.selected)) {
+                    moved = true;
+                }
+            }
+
+            if (moved) {
+                improved = true;
+                regions.clear();
+                region_index.clear();
+            }
+        }
+        if (!improved) {
+            break;
+        }
+    }
+}
+
+RetCode OptGraph::LayoutOptimize(const OptKernelOptions& options) {
+    vector<nodeid_t> sorted_nodes;
+    graph_->topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    vector<NodeLayout> layouts;
+    auto status = CollectLayoutCandidates(options, sorted_nodes, &layouts);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "CollectLayoutCandidates failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    vector<uint32_t> greedy_selected(layouts.size());
+    for (uint32_t i = 0; i < layouts.size(); i++) {
+        greedy_selected[i] = layouts[i].selected;
+    }
+
+    SearchLayoutAssignment(sorted_nodes, &layouts);
+
+    for (auto node_id : sorted_nodes) {
+        auto kernel = (X86OptKernel*)info_->kernels[node_id].get();
+        auto node = kernel->GetNode();
+        auto& selected = layouts[node_id].candidates[layouts[node_id].selected];
+        auto& greedy = layouts[node_id].candidates[greedy_selected[node_id]];
 
         for (uint32_t i = 0; i < node->GetInputCount(); i++) {
             auto edge_id = node->GetInput(i);
@@ -249,7 +613,7 @@ RetCode OptGraph::LayoutOptimize(const OptKernelOptions& options) {
                 continue;
             }
             auto input_format = tensor_impls_[edge_id]->GetShape().GetDataFormat();
-            auto selected_input_format = selected_input_formats[i];
+            auto selected_input_format = selected.input_formats[i];
             if (input_format != selected_input_format) {
                 status = AddReorderOp(options, edge_id, node_id, REORDER_INPUT, input_format, selected_input_format);
                 if (status != RC_SUCCESS) {
@@ -272,15 +636,33 @@ RetCode OptGraph::LayoutOptimize(const OptKernelOptions& options) {
             }
         }
 
+        // algorithms were selected with the greedy input formats, e.g. conv picks its nhwc kernels by input format
+        if (selected.input_formats != greedy.input_formats) {
+            InputOutputInfo IOinfo;
+            IOinfo.SetNode(node);
+            IOinfo.SetAcquireObjectFunc([this](edgeid_t eid, uint32_t, Device*) -> EdgeObject* {
+                auto iter = tensor_impls_.find(eid);
+                if (iter == tensor_impls_.end()) {
+                    return nullptr;
+                }
+                return iter->second.get();
+            });
+            status = kernel->SelectAlgorithm(IOinfo, options);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "kernel[" << node->GetName() << "] SelectAlgorithm failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+
         for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
             auto edge_id = node->GetOutput(i);
-            auto selected_output_format = selected_output_formats[i];
+            auto selected_output_format = selected.output_formats[i];
             tensor_impls_[edge_id]->GetShape().SetDataFormat(selected_output_format);
             kernel->SetOutputDataFormat(i, selected_output_format);
         }
     }
 
-    auto status = FuseReorderOp();
+    status = FuseReorderOp();
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "FuseReorderOp failed: " << GetRetCodeStr(status);
         return status;
@@ -353,51 +735,274 @@ RetCode OptGraph::FuseReorderOp() {
     return RC_SUCCESS;
 }
 
-static bool IsFloatReLU6(const ir::Graph* graph, const ir::Node* clip_node) {
-    if (clip_node->GetType().domain != "" || clip_node->GetType().name != "Clip") {
+inline bool IsReorderNode(const ir::Node* node) {
+    return node->GetType().domain == "ppl" && node->GetType().name == "Reorder";
+}
+
+// whether the concat kernel can reorder inputs of `input_formats` into an output of `output_format` by itself
+static bool CanConcatWithReorder(const vector<const TensorShape*>& input_shapes,
+                                 const vector<dataformat_t>& input_formats, dataformat_t output_format) {
+    if (output_format != DATAFORMAT_NDARRAY && output_format != DATAFORMAT_N16CX) {
         return false;
     }
-    if (clip_node->GetInputCount() != 3) {
+    for (uint32_t i = 0; i < input_shapes.size(); i++) {
+        auto shape = input_shapes[i];
+        if (shape->GetDataType() != DATATYPE_FLOAT32 || shape->GetDimCount() < 3 || shape->GetDim(0) <= 0 ||
+            shape->GetDim(1) <= 0) {
+            return false;
+        }
+        if (input_formats[i] != DATAFORMAT_NDARRAY && input_formats[i] != DATAFORMAT_N16CX) {
+            return false;
+        }
+        // channels of all inputs but the last one must fill whole blocks
+        if (output_format == DATAFORMAT_N16CX && i + 1 < input_shapes.size() && shape->GetDim(1) % 16 != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  concat on channels reads NDARRAY and N16CX inputs and writes either format itself, so reorders next to it do not
+  need a pass of their own:
+    reorder -> concat: the concat reads the reorder's input directly
+    concat -> reorder: the concat writes the reorder's output format directly
+*/
+bool OptGraph::FuseReorderConcat() {
+    bool graph_changed = false;
+
+    for (auto it = graph_->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto concat_node = it->Get();
+        if (concat_node->GetType().domain != "" || concat_node->GetType().name != "Concat") {
+            continue;
+        }
+        auto concat_kernel_it = info_->kernels.find(concat_node->GetId());
+        if (concat_kernel_it == info_->kernels.end()) {
+            continue;
+        }
+        auto concat_kernel = (ConcatOp*)concat_kernel_it->second.get();
+
+        const int32_t dim_count = tensor_impls_[concat_node->GetOutput(0)]->GetShape().GetDimCount();
+        const int32_t axis = concat_kernel->GetConcatParam()->axis;
+        if ((axis < 0 ? axis + dim_count : axis) != 1) {
+            continue;
+        }
+
+        vector<const TensorShape*> input_shapes(concat_node->GetInputCount());
+        vector<dataformat_t> input_formats(concat_node->GetInputCount());
+        for (uint32_t i = 0; i < concat_node->GetInputCount(); i++) {
+            input_shapes[i] = &tensor_impls_[concat_node->GetInput(i)]->GetShape();
+            input_formats[i] = input_shapes[i]->GetDataFormat();
+        }
+
+        // concat -> output_edge -> reorder_node -> reorder_output_edge
+        auto output_edge = graph_->topo->GetEdgeById(concat_node->GetOutput(0));
+        if (output_edge->CalcConsumerCount() == 1 && !IsGraphOutput(graph_, output_edge->GetId())) {
+            auto reorder_node = graph_->topo->GetNodeById(output_edge->CreateConsumerIter().Get());
+            if (IsReorderNode(reorder_node)) {
+                auto reorder_output_edge = graph_->topo->GetEdgeById(reorder_node->GetOutput(0));
+                auto reorder_output_format = tensor_impls_[reorder_output_edge->GetId()]->GetShape().GetDataFormat();
+                if (CanConcatWithReorder(input_shapes, input_formats, reorder_output_format)) {
+                    concat_node->ReplaceOutput(output_edge->GetId(), reorder_output_edge->GetId());
+                    reorder_output_edge->SetProducer(concat_node->GetId());
+                    concat_kernel->SetOutputDataFormat(0, reorder_output_format);
+
+                    info_->kernels.erase(reorder_node->GetId());
+                    graph_->topo->DelNodeById(reorder_node->GetId());
+                    graph_->topo->DelEdgeById(output_edge->GetId());
+                    graph_changed = true;
+                }
+            }
+        }
+
+        // reorder_input_edge -> reorder_node -> input_edge -> concat
+        auto output_format = tensor_impls_[concat_node->GetOutput(0)]->GetShape().GetDataFormat();
+        for (uint32_t i = 0; i < concat_node->GetInputCount(); i++) {
+            auto input_edge = graph_->topo->GetEdgeById(concat_node->GetInput(i));
+            if (input_edge->GetProducer() == INVALID_NODEID || input_edge->CalcConsumerCount() != 1 ||
+                IsGraphOutput(graph_, input_edge->GetId())) {
+                continue;
+            }
+            auto reorder_node = graph_->topo->GetNodeById(input_edge->GetProducer());
+            if (!IsReorderNode(reorder_node)) {
+                continue;
+            }
+
+            auto reorder_input_edge = graph_->topo->GetEdgeById(reorder_node->GetInput(0));
+            auto& reorder_input_shape = tensor_impls_[reorder_input_edge->GetId()]->GetShape();
+            auto fused_input_shapes = input_shapes;
+            auto fused_input_formats = input_formats;
+            for (uint32_t j = 0; j < concat_node->GetInputCount(); j++) {
+                if (concat_node->GetInput(j) == input_edge->GetId()) {
+                    fused_input_shapes[j] = &reorder_input_shape;
+                    fused_input_formats[j] = reorder_input_shape.GetDataFormat();
+                }
+            }
+            if (!CanConcatWithReorder(fused_input_shapes, fused_input_formats, output_format)) {
+                continue;
+            }
+
+            concat_node->ReplaceInput(input_edge->GetId(), reorder_input_edge->GetId());
+            reorder_input_edge->DelConsumer(reorder_node->GetId());
+            reorder_input_edge->AddConsumer(concat_node->GetId());
+            input_shapes = fused_input_shapes;
+            input_formats = fused_input_formats;
+
+            info_->kernels.erase(reorder_node->GetId());
+            graph_->topo->DelNodeById(reorder_node->GetId());
+            graph_->topo->DelEdgeById(input_edge->GetId());
+            graph_changed = true;
+        }
+    }
+
+    return graph_changed;
+}
+
+static bool GetFloatClipRange(const ir::Graph* graph, const ir::Node* clip_node, float* min_val, float* max_val) {
+    if (clip_node->GetType().domain != "" || clip_node->GetType().name != "Clip") {
         return false;
     }
 
-    auto min_edge_id = clip_node->GetInput(1);
-    auto max_edge_id = clip_node->GetInput(2);
+    *min_val = -FLT_MAX;
+    *max_val = FLT_MAX;
     auto& constants = graph->data->constants;
-    if (constants.find(min_edge_id) == constants.end() || constants.find(max_edge_id) == constants.end()) {
+    auto& shapes = graph->data->shapes;
+    for (uint32_t i = 1; i < clip_node->GetInputCount(); ++i) {
+        auto edge_id = clip_node->GetInput(i);
+        if (edge_id == INVALID_EDGEID) { // optional input is not set
+            continue;
+        }
+        if (constants.find(edge_id) == constants.end()) {
+            return false;
+        }
+        if (shapes.find(edge_id) == shapes.end() || shapes[edge_id].data_type != DATATYPE_FLOAT32) {
+            return false;
+        }
+        const float val = *((float*)constants[edge_id].data.data());
+        if (i == 1) {
+            *min_val = val;
+        } else {
+            *max_val = val;
+        }
+    }
+
+    return true;
+}
+
+static bool IsFloatReLU6(const ir::Graph* graph, const ir::Node* clip_node) {
+    float min_val, max_val;
+    if (!GetFloatClipRange(graph, clip_node, &min_val, &max_val)) {
         return false;
     }
+    return min_val == 0.0f && max_val == 6.0f;
+}
+
+// remove node's constant inputs except input[0], such as clip's min/max, which will not be used after fusion
+static void RemoveConstantInputs(ir::Graph* graph, const ir::Node* node) {
+    for (uint32_t i = 1; i < node->GetInputCount(); ++i) {
+        auto edge = graph->topo->GetEdgeById(node->GetInput(i));
+        if (!edge) {
+            continue;
+        }
+        edge->DelConsumer(node->GetId());
+        if (edge->CalcConsumerCount() == 0 && !IsGraphOutput(graph, edge->GetId())) {
+            graph->data->constants.erase(edge->GetId());
+            graph->topo->DelEdgeById(edge->GetId());
+        }
+    }
+}
 
-    auto& shapes = graph->data->shapes;
-    if (shapes.find(min_edge_id) == shapes.end() || shapes.find(max_edge_id) == shapes.end()) {
+// conv -> sigmoid -> mul
+//      ----------->
+static bool FuseConvSwish(ir::Graph* graph, RuntimePartitionInfo* info, ir::Node* conv_node) {
+    auto conv_output_edge_id = conv_node->GetOutput(0);
+    auto conv_output_edge = graph->topo->GetEdgeById(conv_output_edge_id);
+    if (conv_output_edge->CalcConsumerCount() != 2) {
         return false;
     }
-    if (shapes[min_edge_id].data_type != DATATYPE_FLOAT32 || shapes[max_edge_id].data_type != DATATYPE_FLOAT32) {
+
+    ir::Node* sigmoid_node = nullptr;
+    ir::Node* mul_node = nullptr;
+    for (auto it = conv_output_edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+        auto consumer = graph->topo->GetNodeById(it.Get());
+        if (consumer->GetType().domain != "") {
+            return false;
+        }
+        if (consumer->GetType().name == "Sigmoid") {
+            sigmoid_node = consumer;
+        } else if (consumer->GetType().name == "Mul") {
+            mul_node = consumer;
+        }
+    }
+    if (!sigmoid_node || !mul_node) {
         return false;
     }
 
-    float min_val = *((float*)constants[min_edge_id].data.data());
-    float max_val = *((float*)constants[max_edge_id].data.data());
-    if (min_val != 0.0f && max_val != 6.0f) {
+    auto sigmoid_output_edge_id = sigmoid_node->GetOutput(0);
+    auto sigmoid_output_edge = graph->topo->GetEdgeById(sigmoid_output_edge_id);
+    if (sigmoid_output_edge->CalcConsumerCount() != 1 || IsGraphOutput(graph, sigmoid_output_edge_id) ||
+        sigmoid_output_edge->CreateConsumerIter().Get() != mul_node->GetId()) {
+        return false;
+    }
+    if (!(mul_node->GetInput(0) == conv_output_edge_id && mul_node->GetInput(1) == sigmoid_output_edge_id) &&
+        !(mul_node->GetInput(1) == conv_output_edge_id && mul_node->GetInput(0) == sigmoid_output_edge_id)) {
         return false;
     }
 
+    auto conv_kernel = static_cast<ConvOp*>(info->kernels[conv_node->GetId()].get());
+    if (!conv_kernel->SetFuseSwish()) {
+        return false;
+    }
+
+    // conv_node -> conv_output_edge -> sigmoid_node -> sigmoid_output_edge -> mul_node -> mul_output_edge
+    // conv_node                                                                        -> mul_output_edge
+    auto mul_output_edge = graph->topo->GetEdgeById(mul_node->GetOutput(0));
+    conv_node->ReplaceOutput(conv_output_edge_id, mul_output_edge->GetId());
+    mul_output_edge->SetProducer(conv_node->GetId());
+
+    info->kernels.erase(sigmoid_node->GetId());
+    info->kernels.erase(mul_node->GetId());
+    graph->topo->DelNodeById(sigmoid_node->GetId());
+    graph->topo->DelNodeById(mul_node->GetId());
+    graph->topo->DelEdgeById(sigmoid_output_edge_id);
+    graph->topo->DelEdgeById(conv_output_edge_id);
+
     return true;
 }
 
+// n16cx conv transpose only has relu/relu6 in its epilogue
+static bool SetConvTransposeActivation(ir::Graph* graph, ConvTransposeOp* deconv_kernel, ir::Node* successor_node) {
+    if (successor_node->GetType().name == "Relu") {
+        return deconv_kernel->SetFuseReLU();
+    }
+    if (IsFloatReLU6(graph, successor_node)) {
+        if (!deconv_kernel->SetFuseReLU6()) {
+            return false;
+        }
+        RemoveConstantInputs(graph, successor_node);
+        return true;
+    }
+    return false;
+}
+
 bool OptGraph::FuseConvActivation() {
     bool graph_changed = false;
 
     for (auto it = graph_->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
         auto node = it->Get();
-        if (node->GetType().domain == "" && node->GetType().name == "Conv") {
+        const bool is_conv_transpose = node->GetType().name == "ConvTranspose";
+        if (node->GetType().domain == "" && (node->GetType().name == "Conv" || is_conv_transpose)) {
             auto conv_node = node;
             auto conv_output_edge_id = conv_node->GetOutput(0);
             auto conv_output_edge = graph_->topo->GetEdgeById(conv_output_edge_id);
-            if (conv_output_edge->CalcConsumerCount() != 1) {
+            if (IsGraphOutput(graph_, conv_output_edge_id)) {
                 continue;
             }
-            if (IsGraphOutput(graph_, conv_output_edge_id)) {
+            if (!is_conv_transpose && FuseConvSwish(graph_, info_, conv_node)) {
+                graph_changed = true;
+                continue;
+            }
+            if (conv_output_edge->CalcConsumerCount() != 1) {
                 continue;
             }
 
@@ -407,8 +1012,14 @@ bool OptGraph::FuseConvActivation() {
                 continue;
             }
 
-            auto conv_kernel = static_cast<ConvOp*>(info_->kernels[conv_node->GetId()].get());
-            if (successor_node->GetType().name == "Relu") {
+            auto op = info_->kernels[conv_node->GetId()].get();
+            auto conv_kernel = is_conv_transpose ? nullptr : static_cast<ConvOp*>(op);
+            float clip_min, clip_max;
+            if (is_conv_transpose) {
+                if (!SetConvTransposeActivation(graph_, static_cast<ConvTransposeOp*>(op), successor_node)) {
+                    continue;
+                }
+            } else if (successor_node->GetType().name == "Relu") {
                 if (!conv_kernel->SetFuseReLU()) { // set fuse flag to conv_op
                     continue;
                 }
@@ -417,17 +1028,25 @@ bool OptGraph::FuseConvActivation() {
                     continue;
                 }
                 // remove relu6's input min/max's connect in advance
-                auto min_edge = graph_->topo->GetEdgeById(successor_node->GetInput(1));
-                auto max_edge = graph_->topo->GetEdgeById(successor_node->GetInput(2));
-                min_edge->DelConsumer(successor_node->GetId());
-                max_edge->DelConsumer(successor_node->GetId());
-                if (min_edge->CalcConsumerCount() == 0 && !IsGraphOutput(graph_, min_edge->GetId())) {
-                    graph_->data->constants.erase(min_edge->GetId());
-                    graph_->topo->DelEdgeById(min_edge->GetId());
+                RemoveConstantInputs(graph_, successor_node);
+            } else if (GetFloatClipRange(graph_, successor_node, &clip_min, &clip_max)) {
+                if (!conv_kernel->SetFuseClip(clip_min, clip_max)) {
+                    continue;
                 }
-                if (max_edge->CalcConsumerCount() == 0 && !IsGraphOutput(graph_, max_edge->GetId())) {
-                    graph_->data->constants.erase(max_edge->GetId());
-                    graph_->topo->DelEdgeById(max_edge->GetId());
+                RemoveConstantInputs(graph_, successor_node);
+            } else if (successor_node->GetType().name == "Sigmoid") {
+                if (!conv_kernel->SetFuseSigmoid()) {
+                    continue;
+                }
+            } else if (successor_node->GetType().name == "LeakyRelu") {
+                auto& attrs = graph_->data->attrs;
+                auto attr_it = attrs.find(successor_node->GetId());
+                if (attr_it == attrs.end()) {
+                    continue;
+                }
+                auto leaky_relu_param = (const common::LeakyReLUParam*)attr_it->second.get();
+                if (!conv_kernel->SetFuseLeakyReLU(leaky_relu_param->alpha)) {
+                    continue;
                 }
             } else {
                 continue;
@@ -540,6 +1159,22 @@ RetCode OptGraph::TryToInferDims(X86Device* device) {
     return RC_SUCCESS;
 }
 
+// sets sum fuse flag on a Conv or ConvTranspose predecessor, returns false for other ops
+static bool TrySetConvFuseSum(RuntimePartitionInfo* info, ir::Node* node) {
+    if (node->GetType().domain != "") {
+        return false;
+    }
+    if (node->GetType().name == "Conv") {
+        auto conv_op = (ConvOp*)info->kernels[node->GetId()].get();
+        return conv_op->SetFuseSum() || conv_op->SetFusePostSum();
+    }
+    if (node->GetType().name == "ConvTranspose") {
+        auto deconv_op = (ConvTransposeOp*)info->kernels[node->GetId()].get();
+        return deconv_op->SetFuseSum();
+    }
+    return false;
+}
+
 bool OptGraph::FuseConvAdd() {
     bool graph_changed = false;
 
@@ -575,24 +1210,18 @@ bool OptGraph::FuseConvAdd() {
             if (!conv_node && input_edge_0->GetProducer() != INVALID_NODEID && input_edge_0->CalcConsumerCount() == 1 &&
                 !IsGraphOutput(graph_, input_edge_0->GetId())) {
                 auto predecessor_node_0 = graph_->topo->GetNodeById(input_edge_0->GetProducer());
-                if (predecessor_node_0->GetType().domain == "" && predecessor_node_0->GetType().name == "Conv") {
-                    auto conv_op = (ConvOp*)info_->kernels[predecessor_node_0->GetId()].get();
-                    if (conv_op->SetFuseSum()) {
-                        conv_node = predecessor_node_0;
-                        src_sum_edge = input_edge_1;
-                    }
+                if (TrySetConvFuseSum(info_, predecessor_node_0)) {
+                    conv_node = predecessor_node_0;
+                    src_sum_edge = input_edge_1;
                 }
             }
 
             if (!conv_node && input_edge_1->GetProducer() != INVALID_NODEID && input_edge_1->CalcConsumerCount() == 1 &&
                 !IsGraphOutput(graph_, input_edge_1->GetId())) {
                 auto predecessor_node_1 = graph_->topo->GetNodeById(input_edge_1->GetProducer());
-                if (predecessor_node_1->GetType().domain == "" && predecessor_node_1->GetType().name == "Conv") {
-                    auto conv_op = (ConvOp*)info_->kernels[predecessor_node_1->GetId()].get();
-                    if (conv_op->SetFuseSum()) {
-                        conv_node = predecessor_node_1;
-                        src_sum_edge = input_edge_0;
-                    }
+                if (TrySetConvFuseSum(info_, predecessor_node_1)) {
+                    conv_node = predecessor_node_1;
+                    src_sum_edge = input_edge_0;
                 }
             }
 
@@ -802,6 +1431,134 @@ bool OptGraph::FuseChannelShuffle() {
     return graph_changed;
 }
 
+// conv(pointwise) -> conv(depthwise) or conv(depthwise) -> conv(pointwise) => pd_conv
+bool OptGraph::FusePDConv() {
+    bool graph_changed = false;
+
+    for (auto it = graph_->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (node->GetType().domain != "" || node->GetType().name != "Conv") {
+            continue;
+        }
+        auto conv_node = node;
+        auto conv_output_edge_id = conv_node->GetOutput(0);
+        auto conv_output_edge = graph_->topo->GetEdgeById(conv_output_edge_id);
+        if (conv_output_edge->CalcConsumerCount() != 1) {
+            continue;
+        }
+        if (IsGraphOutput(graph_, conv_output_edge_id)) {
+            continue;
+        }
+
+        auto post_conv_node = graph_->topo->GetNodeById(conv_output_edge->CreateConsumerIter().Get());
+        if (post_conv_node->GetType().domain != "" || post_conv_node->GetType().name != "Conv") {
+            continue;
+        }
+        if (post_conv_node->GetInput(0) != conv_output_edge_id) {
+            continue;
+        }
+
+        auto conv_op = (ConvOp*)info_->kernels[conv_node->GetId()].get();
+        auto post_conv_op = (ConvOp*)info_->kernels[post_conv_node->GetId()].get();
+        auto conv2d_param = conv_op->GetConv2DParam();
+        auto post_conv2d_param = post_conv_op->GetConv2DParam();
+        if (!conv2d_param || !conv2d_param->mgr || conv2d_param->fallback_mgr) {
+            continue;
+        }
+        if (!post_conv2d_param || !post_conv2d_param->mgr || post_conv2d_param->fallback_mgr) {
+            continue;
+        }
+
+        auto algo_info =
+            ppl::kernel::x86::pd_conv2d_algo_selector::select_algo(conv2d_param->algo_info, post_conv2d_param->algo_info);
+        if (algo_info.algo_type == ppl::kernel::x86::pd_conv2d_fp32_algo::unknown) {
+            continue;
+        }
+        auto pd_conv_mgr =
+            ppl::kernel::x86::pd_conv2d_algo_selector::gen_algo(algo_info, conv2d_param->mgr, post_conv2d_param->mgr);
+        if (!pd_conv_mgr) {
+            continue;
+        }
+        if (!pd_conv_mgr->is_supported()) {
+            delete pd_conv_mgr;
+            continue;
+        }
+
+        // add PDConv node into graph
+        // conv_input_edge -> conv_node -> conv_output_edge -> post_conv_node -> post_conv_output_edge
+        // conv_input_edge -> pd_conv_node -> post_conv_output_edge
+        std::string pd_conv_node_name = "PDConv_" + conv_node->GetName() + "_" + post_conv_node->GetName();
+        auto node_ret_pair = graph_->topo->AddNode(pd_conv_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << pd_conv_node_name << "] already exists.";
+            delete pd_conv_mgr;
+            continue;
+        }
+        ir::Node* pd_conv_node = node_ret_pair.first;
+        pd_conv_node->SetType(ir::Node::Type("ppl", "PDConv"));
+
+        // X86OptKernel sizes its output formats by the node's outputs, so wire them before creating it
+        auto conv_input_edge = graph_->topo->GetEdgeById(conv_node->GetInput(0));
+        auto post_conv_output_edge = graph_->topo->GetEdgeById(post_conv_node->GetOutput(0));
+        pd_conv_node->AddInput(conv_input_edge->GetId());
+        pd_conv_node->AddOutput(post_conv_output_edge->GetId());
+
+        auto type = pd_conv_node->GetType();
+        auto creator = OptKernelCreatorManager::Instance()->Find(type.domain, type.name);
+        if (!creator) {
+            LOG(ERROR) << "cannot find creator for X86OptKernel[" << pd_conv_node->GetName() << "] type["
+                       << type.domain << ":" << type.name << "]";
+            graph_->topo->DelNodeById(pd_conv_node->GetId());
+            delete pd_conv_mgr;
+            continue;
+        }
+
+        auto opt_kernel = unique_ptr<X86OptKernel>(creator(pd_conv_node));
+        if (!opt_kernel) {
+            LOG(ERROR) << "create X86OptKernel failed: oom";
+            graph_->topo->DelNodeById(pd_conv_node->GetId());
+            delete pd_conv_mgr;
+            continue;
+        }
+
+        auto status = opt_kernel->Init(OptKernelOptions());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "Init for kernel[" << opt_kernel->GetNode()->GetName()
+                       << "] failed: " << GetRetCodeStr(status);
+            graph_->topo->DelNodeById(pd_conv_node->GetId());
+            delete pd_conv_mgr;
+            continue;
+        }
+
+        auto pd_conv2d_param = new PDConv2DParam;
+        pd_conv2d_param->algo_info = algo_info;
+        pd_conv2d_param->mgr = pd_conv_mgr;
+        pd_conv2d_param->conv2d_param = conv_op->ReleaseConv2DParam();
+        pd_conv2d_param->post_conv2d_param = post_conv_op->ReleaseConv2DParam();
+        static_cast<PDConvOp*>(opt_kernel.get())->SetPDConv2DParam(pd_conv2d_param);
+        opt_kernel->SetOutputDataFormat(0, algo_info.output_format);
+        info_->kernels.emplace(pd_conv_node->GetId(), std::move(opt_kernel));
+
+        conv_input_edge->DelConsumer(conv_node->GetId());
+        conv_input_edge->AddConsumer(pd_conv_node->GetId());
+        post_conv_output_edge->SetProducer(pd_conv_node->GetId());
+
+        // weights have been converted by managers
+        RemoveConstantInputs(graph_, conv_node);
+        RemoveConstantInputs(graph_, post_conv_node);
+
+        info_->kernels.erase(conv_node->GetId());
+        info_->kernels.erase(post_conv_node->GetId());
+        graph_->topo->DelEdgeById(conv_output_edge_id);
+        graph_->topo->DelNodeById(conv_node->GetId());
+        graph_->topo->DelNodeById(post_conv_node->GetId());
+
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
 bool OptGraph::FuseBNReLU() {
     bool graph_changed = false;
 
@@ -934,12 +1691,42 @@ bool OptGraph::FuseArithmeticReLU() {
     return graph_changed;
 }
 
-bool OptGraph::FuseFcActivation() {
+// sets activation fuse flag on a Gemm or MatMul predecessor, returns false for other ops or activations
+static bool TrySetGemmActivation(RuntimePartitionInfo* info, ir::Node* node, const ir::Node* activation_node) {
+    if (node->GetType().domain != "" || activation_node->GetType().domain != "") {
+        return false;
+    }
+    auto kernel_it = info->kernels.find(node->GetId());
+    if (kernel_it == info->kernels.end()) {
+        return false;
+    }
+    const string& activation = activation_node->GetType().name;
+    if (node->GetType().name == "Gemm") {
+        auto gemm_op = (GemmOp*)kernel_it->second.get();
+        if (activation == "Relu") {
+            return gemm_op->SetFuseReLU();
+        }
+        if (activation == "Sigmoid") {
+            return gemm_op->SetFuseSigmoid();
+        }
+    } else if (node->GetType().name == "MatMul") {
+        auto matmul_op = (MatMulOp*)kernel_it->second.get();
+        if (activation == "Relu") {
+            return matmul_op->SetFuseReLU();
+        }
+        if (activation == "Sigmoid") {
+            return matmul_op->SetFuseSigmoid();
+        }
+    }
+    return false;
+}
+
+bool OptGraph::FuseGemmActivation() {
     bool graph_changed = false;
 
     for (auto it = graph_->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
         auto node = it->Get();
-        if (node->GetType().domain == "" && node->GetType().name == "Gemm") {
+        if (node->GetType().domain == "" && (node->GetType().name == "Gemm" || node->GetType().name == "MatMul")) {
             auto fc_node = node;
             auto fc_output_edge_id = fc_node->GetOutput(0);
             auto fc_output_edge = graph_->topo->GetEdgeById(fc_output_edge_id);
@@ -949,19 +1736,15 @@ bool OptGraph::FuseFcActivation() {
             if (IsGraphOutput(graph_, fc_output_edge_id)) {
                 continue;
             }
-
-            auto successor_node_id = fc_output_edge->CreateConsumerIter().Get();
-            auto successor_node = graph_->topo->GetNodeById(successor_node_id);
-            if (successor_node->GetType().domain != "") {
+            auto& fc_output_shape = tensor_impls_[fc_output_edge_id]->GetShape();
+            if (fc_output_shape.GetDataType() != DATATYPE_FLOAT32 ||
+                fc_output_shape.GetDataFormat() != DATAFORMAT_NDARRAY) {
                 continue;
             }
 
-            auto fc_kernel = static_cast<GemmOp*>(info_->kernels[fc_node->GetId()].get());
-            if (successor_node->GetType().name == "Relu") {
-                if (!fc_kernel->SetFuseReLU()) { // set fuse flag to fc_op
-                    continue;
-                }
-            } else {
+            auto successor_node_id = fc_output_edge->CreateConsumerIter().Get();
+            auto successor_node = graph_->topo->GetNodeById(successor_node_id);
+            if (!TrySetGemmActivation(info_, fc_node, successor_node)) { // set fuse flag to fc_op
                 continue;
             }
 
@@ -988,6 +1771,264 @@ bool OptGraph::FuseFcActivation() {
     return graph_changed;
 }
 
+// a constant whose dims are [N] or [1, ..., 1, N] and which does not broadcast the output up
+static bool IsGemmBiasShape(const TensorShape& bias_shape, const TensorShape& output_shape) {
+    if (bias_shape.GetDimCount() == 0 || bias_shape.GetDimCount() > output_shape.GetDimCount()) {
+        return false;
+    }
+    const uint32_t last = bias_shape.GetDimCount() - 1;
+    for (uint32_t i = 0; i < last; ++i) {
+        if (bias_shape.GetDim(i) != 1) {
+            return false;
+        }
+    }
+    return bias_shape.GetDim(last) == output_shape.GetDim(output_shape.GetDimCount() - 1);
+}
+
+// folds Add(Gemm/MatMul, x) into the producer: a constant bias-shaped x is added in the gemm epilogue before any
+// activation, any other x with the same shape as the output is added after it.
+bool OptGraph::FuseGemmAdd() {
+    bool graph_changed = false;
+
+    for (auto it = graph_->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (node->GetType().domain != "" || node->GetType().name != "Add") {
+            continue;
+        }
+        auto add_node = node;
+        auto add_kernel_it = info_->kernels.find(add_node->GetId());
+        if (add_kernel_it == info_->kernels.end() || ((AddOp*)add_kernel_it->second.get())->GetFuseReLU()) {
+            continue;
+        }
+        if (add_node->GetInput(0) == add_node->GetInput(1)) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            auto gemm_output_edge = graph_->topo->GetEdgeById(add_node->GetInput(i));
+            auto other_edge = graph_->topo->GetEdgeById(add_node->GetInput(1 - i));
+            if (!gemm_output_edge || !other_edge || gemm_output_edge->GetProducer() == INVALID_NODEID ||
+                gemm_output_edge->CalcConsumerCount() != 1 || IsGraphOutput(graph_, gemm_output_edge->GetId())) {
+                continue;
+            }
+            auto gemm_node = graph_->topo->GetNodeById(gemm_output_edge->GetProducer());
+            if (gemm_node->GetType().domain != "" ||
+                (gemm_node->GetType().name != "Gemm" && gemm_node->GetType().name != "MatMul")) {
+                continue;
+            }
+            auto gemm_kernel_it = info_->kernels.find(gemm_node->GetId());
+            if (gemm_kernel_it == info_->kernels.end()) {
+                continue;
+            }
+            const bool is_matmul = gemm_node->GetType().name == "MatMul";
+
+            auto& output_shape = tensor_impls_[gemm_output_edge->GetId()]->GetShape();
+            auto& other_shape = tensor_impls_[other_edge->GetId()]->GetShape();
+            if (output_shape.IsEmpty() || other_shape.IsEmpty() || output_shape.GetDimCount() < 2 ||
+                output_shape.GetDataType() != DATATYPE_FLOAT32 || other_shape.GetDataType() != DATATYPE_FLOAT32 ||
+                output_shape.GetDataFormat() != DATAFORMAT_NDARRAY ||
+                other_shape.GetDataFormat() != DATAFORMAT_NDARRAY) {
+                continue;
+            }
+            if (is_matmul) { // 1-d operands change which dim of output is N
+                auto& a_shape = tensor_impls_[gemm_node->GetInput(0)]->GetShape();
+                auto& b_shape = tensor_impls_[gemm_node->GetInput(1)]->GetShape();
+                if (a_shape.GetDimCount() < 2 || b_shape.GetDimCount() < 2) {
+                    continue;
+                }
+            }
+
+            auto constant_it = graph_->data->constants.find(other_edge->GetId());
+            bool fused = false;
+            if (constant_it != graph_->data->constants.end() && IsGemmBiasShape(other_shape, output_shape)) {
+                if (is_matmul) {
+                    fused = ((MatMulOp*)gemm_kernel_it->second.get())->SetFuseBias();
+                } else {
+                    fused = ((GemmOp*)gemm_kernel_it->second.get())
+                                ->SetFuseBias((const float*)constant_it->second.data.data());
+                }
+            } else if (constant_it == graph_->data->constants.end()) {
+                bool same_dims = other_shape.GetDimCount() == output_shape.GetDimCount();
+                for (uint32_t d = 0; same_dims && d < output_shape.GetDimCount(); ++d) {
+                    same_dims = other_shape.GetDim(d) == output_shape.GetDim(d);
+                }
+                if (!same_dims) {
+                    continue;
+                }
+                if (is_matmul) {
+                    fused = ((MatMulOp*)gemm_kernel_it->second.get())->SetFuseSum();
+                } else {
+                    fused = ((GemmOp*)gemm_kernel_it->second.get())->SetFuseSum();
+                }
+            }
+            if (!fused) {
+                continue;
+            }
+
+            // gemm_node -> gemm_output_edge -> add_node -> add_output_edge
+            // gemm_node(bias/sum as the last input)     -> add_output_edge
+            auto gemm_output_edge_id = gemm_output_edge->GetId();
+            auto add_output_edge = graph_->topo->GetEdgeById(add_node->GetOutput(0));
+            gemm_node->AddInput(other_edge->GetId());
+            other_edge->AddConsumer(gemm_node->GetId());
+            other_edge->DelConsumer(add_node->GetId());
+            gemm_node->ReplaceOutput(gemm_output_edge_id, add_output_edge->GetId());
+            add_output_edge->SetProducer(gemm_node->GetId());
+
+            // LOG(INFO) << "fuse add " << add_node->GetName() << " into kernel " << gemm_node->GetName() << ".";
+            info_->kernels.erase(add_node->GetId());
+            tensor_impls_.erase(gemm_output_edge_id);
+            graph_->topo->DelNodeById(add_node->GetId());
+            graph_->topo->DelEdgeById(gemm_output_edge_id);
+
+            graph_changed = true;
+            break;
+        }
+    }
+
+    return graph_changed;
+}
+
+// lets producers of a concat write their outputs into the concat output buffer directly. only concats whose inputs
+// are contiguous slices of the output, i.e. all dims before axis are 1, are handled. slices that do not start on an
+// allocator-aligned address and producers that may share their input buffers are left to the concat copy.
+bool OptGraph::InplaceConcat(X86Device* device) {
+    bool graph_changed = false;
+    const uint64_t alignment = device->GetAllocator()->GetAlignment();
+
+    for (auto it = graph_->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto concat_node = it->Get();
+        if (concat_node->GetType().domain != "" || concat_node->GetType().name != "Concat") {
+            continue;
+        }
+        auto concat_kernel_it = info_->kernels.find(concat_node->GetId());
+        if (concat_kernel_it == info_->kernels.end() || concat_node->GetInputCount() < 2) {
+            continue;
+        }
+        auto concat_kernel = (ConcatOp*)concat_kernel_it->second.get();
+        if (concat_kernel->GetInplaceConcatBinding(0)) { // output is already a slice of another concat
+            continue;
+        }
+
+        auto output_ref = tensor_impls_.find(concat_node->GetOutput(0));
+        if (output_ref == tensor_impls_.end()) {
+            continue;
+        }
+        auto& output_shape = output_ref->second->GetShape();
+        if (output_shape.IsEmpty() || output_shape.GetBytesIncludingPadding() == 0) {
+            continue;
+        }
+
+        const int32_t dim_count = output_shape.GetDimCount();
+        const int32_t axis = concat_kernel->GetConcatParam()->axis;
+        const int32_t real_axis = axis < 0 ? axis + dim_count : axis;
+        const auto data_format = output_shape.GetDataFormat();
+        if (real_axis < 0 || real_axis >= dim_count) {
+            continue;
+        }
+        if (data_format != DATAFORMAT_NDARRAY && !(data_format == DATAFORMAT_N16CX && real_axis == 1)) {
+            continue;
+        }
+        bool outer_is_one = true;
+        for (int32_t i = 0; i < real_axis; ++i) {
+            if (output_shape.GetDim(i) != 1) {
+                outer_is_one = false;
+                break;
+            }
+        }
+        if (!outer_is_one) {
+            continue;
+        }
+
+        auto concat_info = make_shared<InplaceConcatInfo>();
+        concat_info->output_shape = output_shape;
+
+        bool layout_ok = true;
+        uint64_t offset = 0;
+        for (uint32_t i = 0; i < concat_node->GetInputCount(); ++i) {
+            auto input_ref = tensor_impls_.find(concat_node->GetInput(i));
+            if (input_ref == tensor_impls_.end()) {
+                layout_ok = false;
+                break;
+            }
+            auto& input_shape = input_ref->second->GetShape();
+            if (input_shape.IsEmpty() || input_shape.GetDataType() != output_shape.GetDataType() ||
+                input_shape.GetDataFormat() != data_format) {
+                layout_ok = false;
+                break;
+            }
+            // channels of all inputs but the last one must fill whole blocks
+            if (data_format == DATAFORMAT_N16CX && i + 1 < concat_node->GetInputCount() &&
+                input_shape.GetDim(1) % 16 != 0) {
+                layout_ok = false;
+                break;
+            }
+            concat_info->input_shapes.push_back(input_shape);
+            concat_info->input_offsets.push_back(offset);
+            offset += input_shape.GetBytesIncludingPadding();
+        }
+        if (!layout_ok || offset != output_shape.GetBytesIncludingPadding()) {
+            continue;
+        }
+
+        bool bound = false;
+        for (uint32_t i = 0; i < concat_node->GetInputCount(); ++i) {
+            auto input_edge_id = concat_node->GetInput(i);
+            auto input_edge = graph_->topo->GetEdgeById(input_edge_id);
+            if (input_edge->GetProducer() == INVALID_NODEID || input_edge->CalcConsumerCount() != 1 ||
+                IsGraphOutput(graph_, input_edge_id)) {
+                continue;
+            }
+            // kernels assume their outputs are aligned
+            if (concat_info->input_offsets[i] % alignment != 0) {
+                continue;
+            }
+            bool is_duplicated = false;
+            for (uint32_t j = 0; j < concat_node->GetInputCount(); ++j) {
+                if (j != i && concat_node->GetInput(j) == input_edge_id) {
+                    is_duplicated = true;
+                    break;
+                }
+            }
+            if (is_duplicated) {
+                continue;
+            }
+
+            auto producer_node = graph_->topo->GetNodeById(input_edge->GetProducer());
+            auto producer_kernel_it = info_->kernels.find(producer_node->GetId());
+            if (producer_kernel_it == info_->kernels.end()) {
+                continue;
+            }
+            auto producer_kernel = (X86OptKernel*)producer_kernel_it->second.get();
+            if (producer_kernel->MayShareInputBuffer()) {
+                continue;
+            }
+            for (uint32_t j = 0; j < producer_node->GetOutputCount(); ++j) {
+                if (producer_node->GetOutput(j) == input_edge_id) {
+                    if (producer_kernel->GetInplaceConcatBinding(j)) { // output of another inplace concat
+                        break;
+                    }
+                    InplaceConcatBinding binding;
+                    binding.info = concat_info;
+                    binding.input_idx = i;
+                    producer_kernel->SetInplaceConcatBinding(j, binding);
+                    bound = true;
+                    break;
+                }
+            }
+        }
+
+        if (bound) {
+            InplaceConcatBinding binding;
+            binding.info = concat_info;
+            concat_kernel->SetInplaceConcatBinding(0, binding);
+            graph_changed = true;
+        }
+    }
+
+    return graph_changed;
+}
+
 RetCode OptGraph::DoOptimize(X86Device* device) {
     OptKernelOptions options;
     options.resource = resource_;
@@ -1036,9 +2077,16 @@ RetCode OptGraph::DoOptimize(X86Device* device) {
         return status;
     }
 
-    while (FuseConvActivation() || FuseConvAdd() || FuseBNReLU() || FuseArithmeticReLU() || FuseFcActivation())
+    FuseReorderConcat();
+
+    while (FuseConvActivation() || FuseConvAdd() || FuseBNReLU() || FuseGemmAdd() || FuseArithmeticReLU() ||
+           FuseGemmActivation())
         ;
 
+    FusePDConv();
+
+    InplaceConcat(device);
+
 #ifdef SHOW_GRAPH_VIS
     std::string vis = utils::ToGraphviz(graph_->topo.get());
     std::ofstream out_file("./graph.dot");
@@ -22,7 +22,9 @@
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/runtime/runtime_partition_info.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/nn/engines/x86/op_cost_model.h"
 #include <memory>
+#include <vector>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -32,27 +34,50 @@ public:
     ppl::common::RetCode DoOptimize(X86Device*);
 
 private:
+    // one way to run a node: the formats it reads its inputs in and writes its outputs in
+    struct LayoutCandidate {
+        ppl::common::dataformat_t probe_format; // DATAFORMAT_UNKNOWN if only reachable from mixed input formats
+        std::vector<ppl::common::dataformat_t> input_formats;
+        std::vector<ppl::common::dataformat_t> output_formats;
+        double kernel_cost = 0; // estimated time of the kernel, as the bytes memory could move meanwhile
+    };
+    struct NodeLayout {
+        std::vector<LayoutCandidate> candidates;
+        uint32_t selected = 0;
+    };
+
     ppl::common::RetCode InitKernels(const ir::Graph* graph);
     ppl::common::RetCode InitTensorImpls();
     ppl::common::RetCode AddReorderOp(const OptKernelOptions& options, const edgeid_t& edge_id, const nodeid_t& node_id,
                                       const int32_t& reorder_type, const ppl::common::dataformat_t& reorder_in_format,
                                       const ppl::common::dataformat_t& reorder_out_format);
+    ppl::common::RetCode CollectLayoutCandidates(const OptKernelOptions& options,
+                                                 const std::vector<nodeid_t>& sorted_nodes,
+                                                 std::vector<NodeLayout>* layouts);
+    double CalcLayoutCost(const std::vector<nodeid_t>& nodes, const std::vector<edgeid_t>& edges,
+                          const std::vector<NodeLayout>& layouts) const;
+    void SearchLayoutAssignment(const std::vector<nodeid_t>& sorted_nodes, std::vector<NodeLayout>* layouts) const;
     ppl::common::RetCode LayoutOptimize(const OptKernelOptions& options);
     ppl::common::RetCode FuseReorderOp();
+    bool FuseReorderConcat();
     ppl::common::RetCode TryToInferType(X86Device* device);
     ppl::common::RetCode TryToInferDims(X86Device* device);
     bool FuseConvActivation();
     bool FuseConvAdd();
     bool FuseChannelShuffle();
+    bool FusePDConv();
     bool FuseBNReLU();
     bool FuseArithmeticReLU();
-    bool FuseFcActivation();
+    bool FuseGemmActivation();
+    bool FuseGemmAdd();
+    bool InplaceConcat(X86Device* device);
 
 private:
     utils::SharedResource* resource_ = nullptr;
     ir::Graph* graph_ = nullptr;
     RuntimePartitionInfo* info_ = nullptr;
     std::map<edgeid_t, std::unique_ptr<TensorImpl>> tensor_impls_;
+    OpCostModel cost_model_; // not calibrated: measured times do not tell how other formats would perform
 };
 
 }}} // namespace ppl::nn::x86
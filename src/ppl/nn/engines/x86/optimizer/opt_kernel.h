@@ -71,9 +71,36 @@ public:
         return ppl::common::RC_SUCCESS;
     }
 
+    /** @brief isa of the kernel that reads `input_formats`, used by the layout pass to estimate its cost */
+    virtual ppl::common::isa_t GetKernelISA(const std::vector<ppl::common::dataformat_t>& input_formats,
+                                            ppl::common::isa_t device_isa) const {
+        return device_isa;
+    }
+
+    /** @brief true if outputs of the created kernel may be views of its inputs, see X86Kernel::CanShareInputBuffer() */
+    virtual bool MayShareInputBuffer() const {
+        return false;
+    }
+
     void SetOutputDataFormat(uint32_t idx, ppl::common::dataformat_t format) {
         common_param_.output_formats[idx] = format;
     }
+    ppl::common::dataformat_t GetOutputDataFormat(uint32_t idx) const {
+        return common_param_.output_formats[idx];
+    }
+
+    const InplaceConcatBinding* GetInplaceConcatBinding(uint32_t idx) const {
+        if (idx < common_param_.inplace_concat_bindings.size() && common_param_.inplace_concat_bindings[idx].info) {
+            return &common_param_.inplace_concat_bindings[idx];
+        }
+        return nullptr;
+    }
+    void SetInplaceConcatBinding(uint32_t idx, const InplaceConcatBinding& binding) {
+        if (common_param_.inplace_concat_bindings.size() <= idx) {
+            common_param_.inplace_concat_bindings.resize(idx + 1);
+        }
+        common_param_.inplace_concat_bindings[idx] = binding;
+    }
 
 protected:
     template <typename T>
@@ -55,6 +55,7 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/non_max_suppression_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/non_zero_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/not_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/rnn_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/roialign_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/pad_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/pow_op.h"
@@ -91,6 +92,7 @@
 #include "ppl/nn/engines/x86/optimizer/ops/mmcv/mmcv_roialign_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/reorder_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/channel_shuffle_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/pd_conv_op.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
@@ -148,6 +150,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("", "GatherND", GatherNDOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Gather", GatherOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Gemm", GemmOp);
+    REGISTER_OPT_KERNEL_CREATOR("", "GRU", RNNOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Greater", GreaterOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Identity", IdentityOp);
     REGISTER_OPT_KERNEL_CREATOR("", "If", IfOp);
@@ -155,6 +158,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("", "Less", LessOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Log", LogOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Loop", LoopOp);
+    REGISTER_OPT_KERNEL_CREATOR("", "LSTM", RNNOp);
     REGISTER_OPT_KERNEL_CREATOR("", "MatMul", MatMulOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Max", MaxOp);
     REGISTER_OPT_KERNEL_CREATOR("", "MaxPool", MaxPoolOp);
@@ -175,6 +179,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("", "Relu", ReluOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Reshape", ReshapeOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Resize", ResizeOp);
+    REGISTER_OPT_KERNEL_CREATOR("", "RNN", RNNOp);
     REGISTER_OPT_KERNEL_CREATOR("", "RoiAlign", ROIAlignOp);
     REGISTER_OPT_KERNEL_CREATOR("", "ScatterElements", ScatterElementsOp);
     REGISTER_OPT_KERNEL_CREATOR("", "ScatterND", ScatterNDOp);
@@ -204,6 +209,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     // ppl
     REGISTER_OPT_KERNEL_CREATOR("ppl", "ChannelShuffle", ChannelShuffleOp);
     REGISTER_OPT_KERNEL_CREATOR("ppl", "Reorder", ReorderOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "PDConv", PDConvOp);
 }
 
 }}} // namespace ppl::nn::x86
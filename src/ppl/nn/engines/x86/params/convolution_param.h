@@ -22,6 +22,7 @@
 
 #include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/fp32/conv3d.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -34,6 +35,12 @@ struct Convolution2DParam {
         infer_fallback_func;
 };
 
+struct Convolution3DParam {
+    ppl::kernel::x86::conv3d_fp32_param param;
+    ppl::kernel::x86::conv3d_fp32_algo_info algo_info;
+    ppl::kernel::x86::conv3d_fp32_manager* mgr = nullptr;
+};
+
 }}}; // namespace ppl::nn::x86
 
 #endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "ppl/nn/engines/x86/policy_allocator.h"
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/nn/common/logger.h"
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+static const uint64_t g_page_size = 4096;
+static const uint64_t g_huge_page_size = 2 * 1024 * 1024;
+// pages of smaller buffers from the system allocator may be shared with other buffers and cannot be bound
+static const uint64_t g_min_numa_bytes = 64 * 1024;
+
+static inline uint64_t Align(uint64_t x, uint64_t n) {
+    return (x + n - 1) & (~(n - 1));
+}
+
+#ifdef __linux__
+// parses lists like "0-1,3" in /sys/devices/system/node/online
+static uint64_t ReadOnlineNodes() {
+    ifstream ifs("/sys/devices/system/node/online");
+    string content;
+    if (!ifs.is_open() || !getline(ifs, content)) {
+        return 0;
+    }
+
+    uint64_t mask = 0;
+    const char* cur = content.c_str();
+    while (true) {
+        char* end = nullptr;
+        const unsigned long first = strtoul(cur, &end, 10);
+        if (end == cur) {
+            break;
+        }
+
+        unsigned long last = first;
+        if (*end == '-') {
+            cur = end + 1;
+            last = strtoul(cur, &end, 10);
+            if (end == cur) {
+                break;
+            }
+        }
+        for (unsigned long i = first; i <= last && i < 64; ++i) {
+            mask |= (1ull << i);
+        }
+
+        if (*end != ',') {
+            break;
+        }
+        cur = end + 1;
+    }
+    return mask;
+}
+
+// returns the NUMA node of `cpu`, which has a `node<N>` entry in /sys/devices/system/cpu/cpu<cpu>, or -1
+static int32_t ReadCpuNode(int32_t cpu) {
+    const string path = "/sys/devices/system/cpu/cpu" + to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return -1;
+    }
+
+    int32_t node = -1;
+    for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+        char* end = nullptr;
+        if (strncmp(entry->d_name, "node", 4) == 0) {
+            const long value = strtol(entry->d_name + 4, &end, 10);
+            if (end != entry->d_name + 4 && *end == '\0') {
+                node = value;
+                break;
+            }
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+// returns `bytes` mapped pages aligned to `alignment`, or nullptr if it fails
+static void* MapPages(uint64_t bytes, uint64_t alignment) {
+    const uint64_t mapped_bytes = bytes + alignment - g_page_size;
+    void* addr = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    auto base = (uintptr_t)addr;
+    auto start = Align(base, alignment);
+    const uint64_t head = start - base;
+    const uint64_t tail = mapped_bytes - head - bytes;
+    if (head > 0) {
+        munmap(addr, head);
+    }
+    if (tail > 0) {
+        munmap((void*)(start + bytes), tail);
+    }
+    return (void*)start;
+}
+#endif
+
+PolicyAllocator::PolicyAllocator(uint64_t alignment, uint32_t policy)
+    : Allocator(alignment), policy_(policy), small_allocator_(alignment) {
+#ifdef __linux__
+    if (policy_ & (X86_MEM_NUMA_LOCAL | X86_MEM_NUMA_INTERLEAVE)) {
+        online_nodes_ = ReadOnlineNodes();
+        if (__builtin_popcountll(online_nodes_) < 2) {
+            LOG(DEBUG) << "only one NUMA node is available. NUMA policies are ignored.";
+            policy_ &= ~(X86_MEM_NUMA_LOCAL | X86_MEM_NUMA_INTERLEAVE);
+        }
+    }
+#else
+    policy_ = X86_MEM_DEFAULT;
+#endif
+}
+
+PolicyAllocator::~PolicyAllocator() {
+#ifdef __linux__
+    for (auto it = mapped_bytes_.begin(); it != mapped_bytes_.end(); ++it) {
+        munmap(it->first, it->second);
+    }
+#endif
+}
+
+void PolicyAllocator::SetCpuSet(const vector<int32_t>& cpus) {
+    cpu_set_nodes_ = 0;
+#ifdef __linux__
+    if (!(policy_ & X86_MEM_NUMA_LOCAL)) {
+        return;
+    }
+    for (auto cpu : cpus) {
+        const int32_t node = ReadCpuNode(cpu);
+        if (node < 0 || node >= 64) {
+            LOG(DEBUG) << "unknown NUMA node of cpu[" << cpu << "]. use the node of the allocating thread instead.";
+            cpu_set_nodes_ = 0;
+            return;
+        }
+        cpu_set_nodes_ |= (1ull << node);
+    }
+#endif
+}
+
+bool PolicyAllocator::UseMappedPages(uint64_t size) const {
+    if (policy_ & (X86_MEM_NUMA_LOCAL | X86_MEM_NUMA_INTERLEAVE)) {
+        return (size >= g_min_numa_bytes);
+    }
+    if (policy_ & X86_MEM_HUGE_PAGE) {
+        return (size >= g_huge_page_size);
+    }
+    return false;
+}
+
+void PolicyAllocator::BindPages(void* addr, uint64_t bytes) const {
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+    int mode;
+    unsigned long nodes;
+    if ((policy_ & X86_MEM_NUMA_LOCAL) && cpu_set_nodes_ != 0) {
+        // threads of kernels run on the cpu set. pages are spread over its nodes if it has more than one.
+        mode = (__builtin_popcountll(cpu_set_nodes_) == 1) ? MPOL_PREFERRED : MPOL_INTERLEAVE;
+        nodes = cpu_set_nodes_;
+    } else if (policy_ & X86_MEM_NUMA_LOCAL) {
+        // pages are still allocated from other nodes if the preferred one is full
+        unsigned cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= 64) {
+            return;
+        }
+        mode = MPOL_PREFERRED;
+        nodes = (1ul << node);
+    } else if (policy_ & X86_MEM_NUMA_INTERLEAVE) {
+        mode = MPOL_INTERLEAVE;
+        nodes = online_nodes_;
+    } else {
+        return;
+    }
+
+    if (syscall(SYS_mbind, addr, bytes, mode, &nodes, sizeof(nodes) * 8, 0) != 0) {
+        LOG(DEBUG) << "mbind [" << bytes << "] bytes failed. memory is allocated by the default policy.";
+    }
+#endif
+}
+
+void* PolicyAllocator::Alloc(uint64_t size) {
+#ifdef __linux__
+    if (UseMappedPages(size)) {
+        const bool use_huge_page = ((policy_ & X86_MEM_HUGE_PAGE) && size >= g_huge_page_size);
+        const uint64_t alignment = use_huge_page ? g_huge_page_size : g_page_size;
+        const uint64_t bytes = Align(size, alignment);
+
+        void* addr = MapPages(bytes, alignment);
+        if (addr) {
+#ifdef MADV_HUGEPAGE
+            if (use_huge_page) {
+                // fails if transparent huge pages are disabled, and normal pages are used
+                madvise(addr, bytes, MADV_HUGEPAGE);
+            }
+#endif
+            BindPages(addr, bytes);
+
+            lock_guard<mutex> guard(mapped_lock_);
+            mapped_bytes_[addr] = bytes;
+            return addr;
+        }
+
+        LOG(DEBUG) << "mmap [" << bytes << "] bytes failed. use the system allocator instead.";
+    }
+#endif
+    return small_allocator_.Alloc(size);
+}
+
+void PolicyAllocator::Free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+#ifdef __linux__
+    uint64_t bytes = 0;
+    {
+        lock_guard<mutex> guard(mapped_lock_);
+        auto ref = mapped_bytes_.find(ptr);
+        if (ref != mapped_bytes_.end()) {
+            bytes = ref->second;
+            mapped_bytes_.erase(ref);
+        }
+    }
+    if (bytes > 0) {
+        munmap(ptr, bytes);
+        return;
+    }
+#endif
+
+    small_allocator_.Free(ptr);
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_POLICY_ALLOCATOR_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_POLICY_ALLOCATOR_H_
+
+#include "ppl/common/generic_cpu_allocator.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @class PolicyAllocator
+   @brief allocates large buffers from pages mapped with a memory policy defined by `X86_MEM_*` in
+   x86_options.h, and small ones from the system allocator. falls back to the system allocator if mapping fails,
+   and ignores huge page or NUMA settings that the system does not support.
+*/
+class PolicyAllocator final : public ppl::common::Allocator {
+public:
+    PolicyAllocator(uint64_t alignment, uint32_t policy);
+    ~PolicyAllocator();
+
+    /**
+       @brief `X86_MEM_NUMA_LOCAL` binds large buffers to the NUMA nodes of `cpus`, or to the node of the thread
+       that allocates them if `cpus` is empty. buffers allocated before are not moved.
+    */
+    void SetCpuSet(const std::vector<int32_t>& cpus);
+
+    void* Alloc(uint64_t size) override;
+    void Free(void* ptr) override;
+
+private:
+    bool UseMappedPages(uint64_t size) const;
+    void BindPages(void* addr, uint64_t bytes) const;
+
+private:
+    uint32_t policy_;
+    uint64_t online_nodes_ = 0; // bit mask of NUMA nodes
+    uint64_t cpu_set_nodes_ = 0; // bit mask of NUMA nodes of the cpu set, or 0 if it is not set
+    ppl::common::GenericCpuAllocator small_allocator_;
+
+    std::mutex mapped_lock_;
+    std::map<void*, uint64_t> mapped_bytes_;
+
+private:
+    PolicyAllocator(const PolicyAllocator&) = delete;
+    PolicyAllocator& operator=(const PolicyAllocator&) = delete;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -33,8 +33,9 @@ private:
     }
 
 public:
-    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, MemoryManagementPolicy mm_policy)
-        : X86Device(alignment, isa) {
+    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, MemoryManagementPolicy mm_policy,
+                     uint32_t mem_policy = X86_MEM_DEFAULT)
+        : X86Device(alignment, isa, mem_policy) {
         if (mm_policy == MM_BETTER_PERFORMANCE) {
             buffer_manager_.reset(new utils::StackBufferManager(GetAllocator()));
         } else if (mm_policy == MM_LESS_MEMORY) {
@@ -45,6 +46,7 @@ public:
     ~RuntimeX86Device() {
         LOG(DEBUG) << "buffer manager[" << buffer_manager_->GetName() << "] allocates ["
                    << buffer_manager_->GetAllocatedBytes() << "] bytes.";
+        FreeSharedBuffers();
         buffer_manager_->Free(&shared_tmp_buffer_);
         buffer_manager_.reset();
     }
@@ -19,11 +19,34 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_X86_COMMON_PARAM_H_
 
 #include <stdint.h>
+#include <memory>
+#include <vector>
+#include "ppl/nn/common/tensor_shape.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
+/**
+   @brief layout of a Concat output whose inputs are written in place by their producers.
+   shapes are inferred at build time and are checked again before each execution.
+*/
+struct InplaceConcatInfo {
+    TensorShape output_shape;
+    std::vector<TensorShape> input_shapes;
+    std::vector<uint64_t> input_offsets; // in bytes, relative to the beginning of the output buffer
+};
+
+struct InplaceConcatBinding {
+    static const uint32_t CONCAT_OUTPUT = UINT32_MAX;
+
+    std::shared_ptr<const InplaceConcatInfo> info;
+    /** index of the concat input this output is written to, or CONCAT_OUTPUT for the output of the concat itself */
+    uint32_t input_idx = CONCAT_OUTPUT;
+};
+
 struct X86CommonParam {
     std::vector<ppl::common::dataformat_t> output_formats;
+    /** empty or one entry per output. outputs with a null `info` are allocated as usual. */
+    std::vector<InplaceConcatBinding> inplace_concat_bindings;
 };
 
 }}} // namespace ppl::nn::x86
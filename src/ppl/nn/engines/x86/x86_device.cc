@@ -0,0 +1,132 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "ppl/nn/engines/x86/x86_device.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include <thread>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+X86Device::X86Device(uint64_t alignment, isa_t isa, uint32_t mem_policy)
+    : GenericCpuDevice(alignment), isa_(isa), data_converter_(isa) {
+    SetMemoryPolicy(mem_policy);
+}
+
+uint32_t X86Device::GetThreadNum() const {
+    if (cpus_.empty()) {
+        return num_threads_;
+    }
+    if (num_threads_ == 0 || num_threads_ > cpus_.size()) {
+        return cpus_.size();
+    }
+    return num_threads_;
+}
+
+/*
+  the device whose cpu set the calling thread and its OpenMP threads are bound to, and their affinity before the
+  outermost scope that bound them, which kernels of devices without cpu set run with.
+*/
+static thread_local X86Device* g_bound_device = nullptr;
+static thread_local const ppl::kernel::x86::omp_core_binding_t* g_original_binding = nullptr;
+
+static void BindThreads(X86Device* device, ppl::kernel::x86::omp_core_binding_t* prev, bool* owns_original_binding,
+                        X86Device** prev_bound_device) {
+    ppl::kernel::x86::swap_omp_core_binding(device->GetCpuSet().data(), device->GetThreadNum(), prev);
+    if (!g_original_binding) {
+        g_original_binding = prev;
+        *owns_original_binding = true;
+    }
+    *prev_bound_device = g_bound_device;
+    g_bound_device = device;
+}
+
+static void ResetBoundDevice(bool owns_original_binding, X86Device* prev_bound_device) {
+    if (owns_original_binding) {
+        g_original_binding = nullptr;
+    }
+    g_bound_device = prev_bound_device;
+}
+
+X86Device::RunScope::RunScope(X86Device* device) {
+    if (device->cpus_.empty() || g_bound_device == device) {
+        return;
+    }
+    BindThreads(device, &prev_binding_, &owns_original_binding_, &prev_bound_device_);
+    bound_ = true;
+}
+
+X86Device::RunScope::~RunScope() {
+    if (bound_) {
+        ppl::kernel::x86::restore_omp_core_binding(prev_binding_);
+        ResetBoundDevice(owns_original_binding_, prev_bound_device_);
+    }
+}
+
+X86Device::ThreadingScope::ThreadingScope(X86Device* device, bool uses_thread_pool) : device_(device) {
+    const uint32_t num_threads = device->GetThreadNum();
+
+    if (device->parallel_backend_ == X86_PARALLEL_THREAD_POOL) {
+        if (!device->thread_pool_) {
+            const uint32_t pool_size = (num_threads > 0) ? num_threads : thread::hardware_concurrency();
+            device->thread_pool_.reset(new ppl::kernel::x86::thread_pool(
+                pool_size, device->cpus_.empty() ? nullptr : device->cpus_.data(), device->spin_count_));
+        }
+        prev_thread_pool_ = ppl::kernel::x86::set_thread_pool(device->thread_pool_.get());
+        if (!uses_thread_pool) {
+            device->thread_pool_->park();
+        }
+    }
+
+    if (num_threads > 0) {
+        prev_num_threads_ = ppl::kernel::x86::set_omp_num_threads(num_threads);
+    }
+
+    // the thread pool binds its own threads
+    if (uses_thread_pool || g_bound_device == device) {
+        return;
+    }
+    if (!device->cpus_.empty()) {
+        BindThreads(device, &prev_binding_, &owns_original_binding_, &prev_bound_device_);
+        rebound_ = true;
+    } else if (g_bound_device && g_original_binding) {
+        ppl::kernel::x86::restore_omp_core_binding(*g_original_binding);
+        prev_bound_device_ = g_bound_device;
+        g_bound_device = nullptr;
+        unbound_ = true;
+    }
+}
+
+X86Device::ThreadingScope::~ThreadingScope() {
+    if (rebound_) {
+        ppl::kernel::x86::restore_omp_core_binding(prev_binding_);
+        ResetBoundDevice(owns_original_binding_, prev_bound_device_);
+    } else if (unbound_) {
+        ppl::kernel::x86::omp_core_binding_t unused;
+        ppl::kernel::x86::swap_omp_core_binding(prev_bound_device_->GetCpuSet().data(),
+                                                prev_bound_device_->GetThreadNum(), &unused);
+        g_bound_device = prev_bound_device_;
+    }
+    if (prev_num_threads_ > 0) {
+        ppl::kernel::x86::set_omp_num_threads(prev_num_threads_);
+    }
+    if (device_->parallel_backend_ == X86_PARALLEL_THREAD_POOL) {
+        ppl::kernel::x86::set_thread_pool(prev_thread_pool_);
+    }
+}
+
+}}} // namespace ppl::nn::x86
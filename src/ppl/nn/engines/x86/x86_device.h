@@ -20,13 +20,22 @@
 
 #include "ppl/nn/utils/generic_cpu_device.h"
 #include "ppl/nn/engines/x86/data_converter.h"
+#include "ppl/nn/engines/x86/policy_allocator.h"
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/kernel/x86/common/thread_pool.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace ppl { namespace nn { namespace x86 {
 
 class X86Device : public utils::GenericCpuDevice {
 public:
-    X86Device(uint64_t alignment, ppl::common::isa_t isa)
-        : GenericCpuDevice(alignment), isa_(isa), data_converter_(isa) {}
+    X86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mem_policy = X86_MEM_DEFAULT);
+    virtual ~X86Device() {
+        FreeSharedBuffers();
+    }
 
     void SetISA(ppl::common::isa_t isa) {
         isa_ = isa;
@@ -36,6 +45,109 @@ public:
         return isa_;
     }
 
+    /**
+       @brief sets how buffers are allocated. `policy` is a combination of `X86_MEM_*` in x86_options.h.
+       @note MUST be called before any buffer is allocated.
+    */
+    void SetMemoryPolicy(uint32_t policy) {
+        mem_policy_ = policy;
+        if (policy == X86_MEM_DEFAULT) {
+            SetAllocator(nullptr);
+            policy_allocator_.reset();
+        } else {
+            policy_allocator_.reset(new PolicyAllocator(GetAllocator()->GetAlignment(), policy));
+            policy_allocator_->SetCpuSet(cpus_);
+            SetAllocator(policy_allocator_.get());
+        }
+    }
+    uint32_t GetMemoryPolicy() const {
+        return mem_policy_;
+    }
+
+    /** @brief kernels use `num_threads` threads, or the default of OpenMP if it is 0. */
+    void SetThreadNum(uint32_t num_threads) {
+        num_threads_ = num_threads;
+    }
+    /** @brief binds the i-th thread of kernels to cpus[i]. the thread number is at most the size of `cpus`. */
+    void SetCpuSet(const std::vector<int32_t>& cpus) {
+        cpus_ = cpus;
+        if (policy_allocator_) {
+            policy_allocator_->SetCpuSet(cpus);
+        }
+    }
+    const std::vector<int32_t>& GetCpuSet() const {
+        return cpus_;
+    }
+    /** @brief returns the number of threads used by kernels, or 0 if it is the default of OpenMP. */
+    uint32_t GetThreadNum() const;
+
+    /** @brief `backend` is one of `X86_PARALLEL_*` in x86_options.h */
+    void SetParallelBackend(uint32_t backend) {
+        parallel_backend_ = backend;
+    }
+    uint32_t GetParallelBackend() const {
+        return parallel_backend_;
+    }
+
+    void SetSpinCount(uint64_t spin_count) {
+        spin_count_ = spin_count;
+        if (thread_pool_) {
+            thread_pool_->set_spin_count(spin_count);
+        }
+    }
+    uint64_t GetSpinCount() const {
+        return spin_count_;
+    }
+
+    /**
+       @brief binds the calling thread and its OpenMP threads to the cpu set of a device once for all kernels of a
+       run, and restores their affinity on destruction. does nothing if the device has no cpu set or its cpu set is
+       bound already.
+    */
+    class RunScope final {
+    public:
+        RunScope(X86Device* device);
+        ~RunScope();
+
+    private:
+        RunScope(const RunScope&) = delete;
+        RunScope& operator=(const RunScope&) = delete;
+
+    private:
+        bool bound_ = false;
+        bool owns_original_binding_ = false;
+        X86Device* prev_bound_device_ = nullptr;
+        ppl::kernel::x86::omp_core_binding_t prev_binding_;
+    };
+
+    /**
+       @brief makes parallel regions started by the calling thread use the threads configured for a device during its
+       lifetime, and restores the thread number and thread pool on destruction.
+       threads are only bound here if they are not bound to this device by a `RunScope` yet, e.g. if kernels of
+       devices with different cpu sets, or without any, run one after another. kernels using the thread pool leave
+       OpenMP threads alone, and workers of the pool are parked for the others, so that they do not spin on the cores
+       used by OpenMP.
+    */
+    class ThreadingScope final {
+    public:
+        ThreadingScope(X86Device* device, bool uses_thread_pool = false);
+        ~ThreadingScope();
+
+    private:
+        ThreadingScope(const ThreadingScope&) = delete;
+        ThreadingScope& operator=(const ThreadingScope&) = delete;
+
+    private:
+        X86Device* device_;
+        int32_t prev_num_threads_ = 0;
+        ppl::kernel::x86::thread_pool* prev_thread_pool_ = nullptr;
+        bool rebound_ = false;
+        bool unbound_ = false;
+        bool owns_original_binding_ = false;
+        X86Device* prev_bound_device_ = nullptr;
+        ppl::kernel::x86::omp_core_binding_t prev_binding_;
+    };
+
     virtual ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
         return Realloc(bytes, buffer);
     }
@@ -47,9 +159,47 @@ public:
         return &data_converter_;
     }
 
+    /**
+       @brief returns the buffer identified by `key` which is shared by several kernels of a runtime.
+       `addr` of the returned buffer is nullptr if it is not allocated yet.
+    */
+    BufferDesc* GetSharedBuffer(const void* key) {
+        return &shared_buffers_[key];
+    }
+    /** @brief forgets the buffer identified by `key` without freeing it, e.g. after it is handed over to a tensor */
+    void DetachSharedBuffer(const void* key) {
+        shared_buffers_.erase(key);
+    }
+    void FreeSharedBuffer(const void* key) {
+        auto ref = shared_buffers_.find(key);
+        if (ref != shared_buffers_.end()) {
+            Free(&ref->second);
+            shared_buffers_.erase(ref);
+        }
+    }
+
+protected:
+    /** @note must be called by derived classes whose Free() differs from this one before they are destroyed */
+    void FreeSharedBuffers() {
+        for (auto it = shared_buffers_.begin(); it != shared_buffers_.end(); ++it) {
+            if (it->second.addr) {
+                Free(&it->second);
+            }
+        }
+        shared_buffers_.clear();
+    }
+
 private:
     ppl::common::isa_t isa_;
+    uint32_t mem_policy_ = X86_MEM_DEFAULT;
+    std::unique_ptr<PolicyAllocator> policy_allocator_;
+    uint32_t num_threads_ = 0;
+    std::vector<int32_t> cpus_;
+    uint32_t parallel_backend_ = X86_PARALLEL_OPENMP;
+    uint64_t spin_count_ = ppl::kernel::x86::thread_pool::default_spin_count;
+    std::unique_ptr<ppl::kernel::x86::thread_pool> thread_pool_; // created by the first kernel that runs
     X86DataConverter data_converter_;
+    std::map<const void*, BufferDesc> shared_buffers_;
 };
 
 }}} // namespace ppl::nn::x86
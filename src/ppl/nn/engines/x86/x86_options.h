@@ -31,10 +31,109 @@ enum {
     */
     X86_CONF_DISABLE_AVX512 = 0,
 
+    /**
+       @brief uses kernel timings of a profiling run as op costs of nodes with the same names when partitioning
+       graphs, instead of the estimation by flops and memory bandwidth.
+
+       @note example:
+       @code{.cpp}
+       ProfilingStatistics stat;
+       runtime->GetProfilingStatistics(&stat);
+       x86_engine->Configure(X86_CONF_SET_OP_COST_CALIBRATION, &stat);
+       @endcode
+    */
+    X86_CONF_SET_OP_COST_CALIBRATION,
+
+    /**
+       @brief sets how memory of weights and runtime buffers is allocated, which is a combination of
+       `X86_MEM_*` flags below. MUST be set before building models and creating runtimes.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_MEMORY_POLICY, X86_MEM_HUGE_PAGE | X86_MEM_NUMA_LOCAL);
+       @endcode
+    */
+    X86_CONF_SET_MEMORY_POLICY,
+
+    /**
+       @brief sets the number of threads used by kernels of runtimes created later. 0 means the default of OpenMP.
+       runtimes running in different threads use different thread teams.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_THREAD_NUM, 8);
+       @endcode
+    */
+    X86_CONF_SET_THREAD_NUM,
+
+    /**
+       @brief binds the i-th thread used by kernels of runtimes created later to the i-th cpu in the list.
+       the number of threads is the number of cpus unless a smaller one is set by `X86_CONF_SET_THREAD_NUM`.
+       the thread calling `Runtime::Run()` is the first thread and is bound, too. threads are bound during each
+       `Runtime::Run()` and get their previous affinity back after it.
+
+       @note example:
+       @code{.cpp}
+       int32_t cpus[] = {0, 1, 2, 3};
+       x86_engine->Configure(X86_CONF_SET_CPU_SET, cpus, 4);
+       @endcode
+    */
+    X86_CONF_SET_CPU_SET,
+
+    /**
+       @brief selects what runs parallel regions of kernels of runtimes created later, which is one of
+       `X86_PARALLEL_*` below. kernels that are not ported to the thread pool always use OpenMP, and
+       idle workers of the pool sleep while they run.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_PARALLEL_BACKEND, X86_PARALLEL_THREAD_POOL);
+       @endcode
+    */
+    X86_CONF_SET_PARALLEL_BACKEND,
+
+    /**
+       @brief sets how many times an idle worker of the thread pool polls for new jobs before sleeping. larger values
+       cut the latency of back-to-back small ops at the cost of burning cpu between runs. 0 means sleeping at once.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_THREAD_POOL_SPIN_COUNT, (uint64_t)100000);
+       @endcode
+    */
+    X86_CONF_SET_THREAD_POOL_SPIN_COUNT,
+
     /** max value */
     X86_CONF_MAX,
 };
 
+/** memory policies used by `X86_CONF_SET_MEMORY_POLICY`. unavailable ones are ignored. */
+enum {
+    /** aligned memory from the system allocator */
+    X86_MEM_DEFAULT = 0,
+
+    /** 2MB-aligned memory backed by transparent huge pages for large buffers */
+    X86_MEM_HUGE_PAGE = 1,
+
+    /**
+       binds large buffers to the NUMA nodes of the cpus set by `X86_CONF_SET_CPU_SET`, or to the node of the thread
+       that allocates them if no cpu set is given
+    */
+    X86_MEM_NUMA_LOCAL = 2,
+
+    /** interleaves pages of large buffers across all NUMA nodes. ignored if `X86_MEM_NUMA_LOCAL` is set. */
+    X86_MEM_NUMA_INTERLEAVE = 4,
+};
+
+/** parallel backends used by `X86_CONF_SET_PARALLEL_BACKEND` */
+enum {
+    /** OpenMP, or running sequentially if OpenMP is not enabled */
+    X86_PARALLEL_OPENMP = 0,
+
+    /** a spinning thread pool of each runtime, whose threads are bound to the cpu set if any */
+    X86_PARALLEL_THREAD_POOL = 1,
+};
+
 }}} // namespace ppl::nn::x86
 
 #endif
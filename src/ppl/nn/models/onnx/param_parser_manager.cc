@@ -41,6 +41,7 @@
 #include "ppl/nn/models/onnx/parsers/parse_pooling_param.h"
 #include "ppl/nn/models/onnx/parsers/parse_reduce_param.h"
 #include "ppl/nn/models/onnx/parsers/parse_resize_param.h"
+#include "ppl/nn/models/onnx/parsers/parse_rnn_param.h"
 #include "ppl/nn/models/onnx/parsers/parse_roialign_param.h"
 #include "ppl/nn/models/onnx/parsers/parse_scatter_elements_param.h"
 #include "ppl/nn/models/onnx/parsers/parse_softmax_param.h"
@@ -136,6 +137,7 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Floor");
     PPL_REGISTER_OP_WITH_PARAM("", "Gather", ppl::nn::common::GatherParam, ParseGatherParam);
     PPL_REGISTER_OP_WITH_PARAM("", "GatherND", ppl::nn::common::GatherNDParam, ParseGatherNDParam);
+    PPL_REGISTER_OP_WITH_PARAM("", "GRU", ppl::nn::common::RNNParam, ParseRNNParam);
     PPL_REGISTER_OP_WITH_PARAM("", "Gemm", ppl::nn::common::GemmParam, ParseGemmParam);
     PPL_REGISTER_OP_WITH_PARAM("", "GlobalAveragePool", ppl::nn::common::PoolingParam, ParsePoolingParam);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Greater");
@@ -144,6 +146,7 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Less");
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Log");
     PPL_REGISTER_OP_WITH_PARAM("", "Loop", ppl::nn::common::LoopParam, ParseLoopParam);
+    PPL_REGISTER_OP_WITH_PARAM("", "LSTM", ppl::nn::common::RNNParam, ParseRNNParam);
     PPL_REGISTER_OP_WITH_PARAM("", "LeakyRelu", ppl::nn::common::LeakyReLUParam, ParseLeakyReLUParam);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "MatMul");
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Max");
@@ -158,6 +161,7 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITH_PARAM("", "Pad", ppl::nn::common::PadParam, ParsePadParam);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Pow");
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Range");
+    PPL_REGISTER_OP_WITH_PARAM("", "RNN", ppl::nn::common::RNNParam, ParseRNNParam);
     PPL_REGISTER_OP_WITH_PARAM("", "ReduceMax", ppl::nn::common::ReduceParam, ParseReduceParam);
     PPL_REGISTER_OP_WITH_PARAM("", "ReduceMean", ppl::nn::common::ReduceParam, ParseReduceParam);
     PPL_REGISTER_OP_WITH_PARAM("", "ReduceMin", ppl::nn::common::ReduceParam, ParseReduceParam);
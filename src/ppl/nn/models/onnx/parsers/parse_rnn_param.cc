@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/models/onnx/parsers/parse_rnn_param.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/models/onnx/utils.h"
+using namespace std;
+
+namespace ppl { namespace nn { namespace onnx {
+
+ppl::common::RetCode ParseRNNParam(const ::onnx::NodeProto& pb_node, void* arg, ir::Node*, ir::GraphTopo*) {
+    auto param = static_cast<ppl::nn::common::RNNParam*>(arg);
+
+    vector<string> default_activations;
+    if (pb_node.op_type() == "LSTM") {
+        default_activations = {"Sigmoid", "Tanh", "Tanh"};
+    } else if (pb_node.op_type() == "GRU") {
+        default_activations = {"Sigmoid", "Tanh"};
+    } else if (pb_node.op_type() == "RNN") {
+        default_activations = {"Tanh"};
+    } else {
+        LOG(ERROR) << "unexpected op type: " << pb_node.op_type();
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    string direction = utils::GetNodeAttrByKey<string>(pb_node, "direction", "forward");
+    if (direction == "forward") {
+        param->direction = ppl::nn::common::RNNParam::DIR_FORWARD;
+    } else if (direction == "reverse") {
+        param->direction = ppl::nn::common::RNNParam::DIR_REVERSE;
+    } else if (direction == "bidirectional") {
+        param->direction = ppl::nn::common::RNNParam::DIR_BIDIRECTIONAL;
+    } else {
+        LOG(ERROR) << "unexpected direction: " << direction;
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    const uint32_t num_direction = (param->direction == ppl::nn::common::RNNParam::DIR_BIDIRECTIONAL) ? 2 : 1;
+
+    param->hidden_size = utils::GetNodeAttrByKey<int32_t>(pb_node, "hidden_size", 0);
+    if (param->hidden_size <= 0) {
+        LOG(ERROR) << "invalid hidden_size[" << param->hidden_size << "] of " << pb_node.op_type() << "["
+                   << pb_node.name() << "]";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    param->clip = utils::GetNodeAttrByKey<float>(pb_node, "clip", 0.0f);
+    param->input_forget = utils::GetNodeAttrByKey<int32_t>(pb_node, "input_forget", 0);
+    param->linear_before_reset = utils::GetNodeAttrByKey<int32_t>(pb_node, "linear_before_reset", 0);
+
+    auto activations = utils::GetNodeAttrsByKey<string>(pb_node, "activations");
+    if (activations.empty()) {
+        for (uint32_t i = 0; i < num_direction; ++i) {
+            activations.insert(activations.end(), default_activations.begin(), default_activations.end());
+        }
+    }
+    if (activations.size() != default_activations.size() * num_direction) {
+        LOG(ERROR) << "activations size[" << activations.size()
+                   << "] != " << default_activations.size() * num_direction;
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    param->activations.resize(activations.size());
+    for (uint32_t i = 0; i < activations.size(); ++i) {
+        if (activations[i] == "Sigmoid") {
+            param->activations[i] = ppl::nn::common::RNNParam::ACT_SIGMOID;
+        } else if (activations[i] == "Tanh") {
+            param->activations[i] = ppl::nn::common::RNNParam::ACT_TANH;
+        } else if (activations[i] == "Relu") {
+            param->activations[i] = ppl::nn::common::RNNParam::ACT_RELU;
+        } else {
+            LOG(ERROR) << "unsupported activation: " << activations[i];
+            return ppl::common::RC_UNSUPPORTED;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::onnx
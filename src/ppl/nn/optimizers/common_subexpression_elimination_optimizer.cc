@@ -0,0 +1,184 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/common_subexpression_elimination_optimizer.h"
+#include "ppl/nn/models/op_info_manager.h"
+#include "ppl/nn/common/logger.h"
+#include <map>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+inline bool IsGraphOutput(const ir::Graph* graph, edgeid_t edge_id) {
+    for (uint32_t i = 0; i < graph->topo->GetOutputCount(); i++) {
+        if (graph->topo->GetOutput(i) == edge_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool IsSkippedNode(const ir::Node* node) {
+    static const vector<ir::Node::Type> skipped_node_types{
+        ir::Node::Type{"", "Conv"}, // cannot compare param correctly
+        ir::Node::Type{"", "Reshape"}, // cannot compare param correctly
+        ir::Node::Type{"", "If"}, // has subgraph
+        ir::Node::Type{"", "Loop"} // has subgraph
+    };
+    for (uint32_t i = 0; i < skipped_node_types.size(); i++) {
+        if (node->GetType() == skipped_node_types[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool HasSameParam(const ir::Graph* graph, const ir::Node* node_0, const ir::Node* node_1) {
+    auto param_it_0 = graph->data->attrs.find(node_0->GetId());
+    auto param_it_1 = graph->data->attrs.find(node_1->GetId());
+    const bool has_param_0 = (param_it_0 != graph->data->attrs.end());
+    const bool has_param_1 = (param_it_1 != graph->data->attrs.end());
+    if (!has_param_0 && !has_param_1) {
+        return true;
+    }
+    if (has_param_0 != has_param_1) {
+        return false;
+    }
+
+    // params of ops without OpInfo cannot be compared
+    auto op_info = OpInfoManager::Instance()->Find(node_0->GetType().domain, node_0->GetType().name);
+    if (!op_info || !op_info->param_equal) {
+        return false;
+    }
+    return op_info->param_equal(param_it_0->second.get(), param_it_1->second.get());
+}
+
+// inputs and extra inputs separated by INVALID_EDGEID
+static vector<edgeid_t> GenInputKey(const ir::Node* node) {
+    vector<edgeid_t> key;
+    key.reserve(node->GetInputCount() + node->GetExtraInputCount() + 1);
+    for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+        key.push_back(node->GetInput(i));
+    }
+    key.push_back(INVALID_EDGEID);
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); i++) {
+        key.push_back(node->GetExtraInput(i));
+    }
+    return key;
+}
+
+// redirects consumers of `dup_node`'s outputs to `kept_node`'s outputs and removes `dup_node`
+static void ReplaceNode(ir::Graph* graph, ir::Node* dup_node, const ir::Node* kept_node) {
+    auto topo = graph->topo.get();
+    for (uint32_t i = 0; i < dup_node->GetInputCount(); i++) {
+        auto input_edge = topo->GetEdgeById(dup_node->GetInput(i));
+        if (input_edge) {
+            input_edge->DelConsumer(dup_node->GetId());
+        }
+    }
+    for (uint32_t i = 0; i < dup_node->GetExtraInputCount(); i++) {
+        auto input_edge = topo->GetEdgeById(dup_node->GetExtraInput(i));
+        if (input_edge) {
+            input_edge->DelConsumer(dup_node->GetId());
+        }
+    }
+
+    for (uint32_t i = 0; i < dup_node->GetOutputCount(); i++) {
+        auto dup_edge = topo->GetEdgeById(dup_node->GetOutput(i));
+        auto kept_edge = topo->GetEdgeById(kept_node->GetOutput(i));
+        if (!dup_edge) {
+            continue;
+        }
+        for (auto it = dup_edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+            auto consumer = topo->GetNodeById(it.Get());
+            consumer->ReplaceInput(dup_edge->GetId(), kept_edge->GetId());
+            consumer->ReplaceExtraInput(dup_edge->GetId(), kept_edge->GetId());
+            kept_edge->AddConsumer(consumer->GetId());
+        }
+        graph->data->shapes.erase(dup_edge->GetId());
+        topo->DelEdgeById(dup_edge->GetId());
+    }
+
+    graph->data->attrs.erase(dup_node->GetId());
+    topo->DelNodeById(dup_node->GetId());
+}
+
+static bool CanBeReplaced(const ir::Graph* graph, const ir::Node* dup_node, const ir::Node* kept_node) {
+    if (!(dup_node->GetType() == kept_node->GetType()) ||
+        dup_node->GetOutputCount() != kept_node->GetOutputCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < dup_node->GetOutputCount(); i++) {
+        if (IsGraphOutput(graph, dup_node->GetOutput(i))) {
+            return false;
+        }
+        // optional outputs must be absent or present in both nodes
+        auto dup_edge = graph->topo->GetEdgeById(dup_node->GetOutput(i));
+        auto kept_edge = graph->topo->GetEdgeById(kept_node->GetOutput(i));
+        if (dup_edge && dup_edge->CalcConsumerCount() > 0 && !kept_edge) {
+            return false;
+        }
+    }
+    return HasSameParam(graph, dup_node, kept_node);
+}
+
+RetCode CommonSubexpressionEliminationOptimizer::Optimize(ir::Graph* graph) const {
+    auto topo = graph->topo.get();
+
+    vector<nodeid_t> sorted_nodes;
+    topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    // consumers of a replaced node are redirected before they are visited, so their keys
+    // already refer to the kept outputs and a duplicated chain is merged level by level.
+    map<vector<edgeid_t>, vector<const ir::Node*>> key2nodes;
+    uint32_t eliminated_count = 0;
+    for (auto nid = sorted_nodes.begin(); nid != sorted_nodes.end(); ++nid) {
+        auto node = topo->GetNodeById(*nid);
+        if (!node || node->GetInputCount() == 0 || IsSkippedNode(node)) {
+            continue;
+        }
+
+        auto& candidates = key2nodes[GenInputKey(node)];
+        const ir::Node* kept_node = nullptr;
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+            if (CanBeReplaced(graph, node, *it)) {
+                kept_node = *it;
+                break;
+            }
+        }
+
+        if (kept_node) {
+            ReplaceNode(graph, node, kept_node);
+            ++eliminated_count;
+        } else {
+            candidates.push_back(node);
+        }
+    }
+
+    if (eliminated_count > 0) {
+        LOG(DEBUG) << "eliminated [" << eliminated_count << "] duplicated nodes of graph[" << topo->GetName()
+                   << "]";
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,38 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPTIMIZERS_COMMON_SUBEXPRESSION_ELIMINATION_OPTIMIZER_H_
+#define _ST_HPC_PPL_NN_OPTIMIZERS_COMMON_SUBEXPRESSION_ELIMINATION_OPTIMIZER_H_
+
+#include "ppl/nn/optimizers/graph_optimizer.h"
+
+namespace ppl { namespace nn {
+
+/**
+   @brief merges nodes that have the same type, the same params and the same inputs, e.g. the same Transpose
+   or Shape computed several times by an exported model. Nodes are visited in topological order so that
+   duplicated chains are merged as a whole.
+*/
+class CommonSubexpressionEliminationOptimizer : public GraphOptimizer {
+public:
+    virtual ~CommonSubexpressionEliminationOptimizer() {}
+    ppl::common::RetCode Optimize(ir::Graph*) const override;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -0,0 +1,809 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <string.h>
+
+#include <functional>
+
+#include "ppl/nn/optimizers/constant_folding_optimizer.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/params/onnx/cast_param.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/constant_of_shape_param.h"
+#include "ppl/nn/params/onnx/gather_param.h"
+#include "ppl/nn/params/onnx/squeeze_param.h"
+#include "ppl/nn/params/onnx/unsqueeze_param.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+struct FoldingInput final {
+    const ir::Shape* shape;
+    const string* data;
+};
+
+struct FoldingOutput final {
+    ir::Shape shape;
+    string data;
+};
+
+typedef function<RetCode(const void* param, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs)>
+    FoldingFunc;
+
+/* -------------------------------------------------------------------------- */
+
+// data types that can be folded, 0 for others
+static uint32_t GetFoldingElementSize(datatype_t data_type) {
+    switch (data_type) {
+        case DATATYPE_FLOAT32:
+        case DATATYPE_INT32:
+            return 4;
+        case DATATYPE_INT64:
+            return 8;
+        case DATATYPE_BOOL:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int64_t CalcElementCount(const vector<int64_t>& dims) {
+    int64_t count = 1;
+    for (auto d = dims.begin(); d != dims.end(); ++d) {
+        count *= *d;
+    }
+    return count;
+}
+
+template <typename T>
+static T GetElement(datatype_t data_type, const string& data, int64_t idx) {
+    switch (data_type) {
+        case DATATYPE_FLOAT32:
+            return (T)((const float*)data.data())[idx];
+        case DATATYPE_INT32:
+            return (T)((const int32_t*)data.data())[idx];
+        case DATATYPE_INT64:
+            return (T)((const int64_t*)data.data())[idx];
+        case DATATYPE_BOOL:
+            return (T)((const uint8_t*)data.data())[idx];
+        default:
+            return T(0);
+    }
+}
+
+template <typename T>
+static T GetElement(const FoldingInput& in, int64_t idx) {
+    return GetElement<T>(in.shape->data_type, *in.data, idx);
+}
+
+template <typename T>
+static void SetElement(FoldingOutput* out, int64_t idx, T value) {
+    switch (out->shape.data_type) {
+        case DATATYPE_FLOAT32:
+            ((float*)&out->data[0])[idx] = (float)value;
+            break;
+        case DATATYPE_INT32:
+            ((int32_t*)&out->data[0])[idx] = (int32_t)value;
+            break;
+        case DATATYPE_INT64:
+            ((int64_t*)&out->data[0])[idx] = (int64_t)value;
+            break;
+        case DATATYPE_BOOL:
+            ((uint8_t*)&out->data[0])[idx] = (value != T(0));
+            break;
+        default:
+            break;
+    }
+}
+
+static void InitOutput(datatype_t data_type, const vector<int64_t>& dims, FoldingOutput* out) {
+    out->shape.data_type = data_type;
+    out->shape.data_format = DATAFORMAT_NDARRAY;
+    out->shape.dims = dims;
+    out->data.resize(CalcElementCount(dims) * GetFoldingElementSize(data_type));
+}
+
+static bool NormalizeAxis(int64_t axis, int64_t rank, int64_t* normalized) {
+    if (axis < -rank || axis >= rank) {
+        return false;
+    }
+    *normalized = (axis < 0) ? axis + rank : axis;
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+// calls func(out_idx, in_offsets) for each output element, with numpy style broadcasting of inputs
+static bool ForEachBroadcastElement(const vector<FoldingInput>& inputs, vector<int64_t>* out_dims,
+                                    const function<void(int64_t, const vector<int64_t>&)>& func) {
+    uint32_t rank = 0;
+    for (auto x = inputs.begin(); x != inputs.end(); ++x) {
+        rank = max<uint32_t>(rank, x->shape->dims.size());
+    }
+
+    out_dims->assign(rank, 1);
+    for (auto x = inputs.begin(); x != inputs.end(); ++x) {
+        auto& dims = x->shape->dims;
+        const uint32_t offset = rank - dims.size();
+        for (uint32_t i = 0; i < dims.size(); ++i) {
+            auto& d = (*out_dims)[offset + i];
+            if (d == 1) {
+                d = dims[i];
+            } else if (dims[i] != 1 && dims[i] != d) {
+                return false;
+            }
+        }
+    }
+
+    // strides of each input aligned to output rank, 0 for broadcast dims
+    vector<vector<int64_t>> strides(inputs.size(), vector<int64_t>(rank, 0));
+    for (uint32_t k = 0; k < inputs.size(); ++k) {
+        auto& dims = inputs[k].shape->dims;
+        const uint32_t offset = rank - dims.size();
+        int64_t stride = 1;
+        for (int64_t i = dims.size() - 1; i >= 0; --i) {
+            strides[k][offset + i] = (dims[i] == 1) ? 0 : stride;
+            stride *= dims[i];
+        }
+    }
+
+    const int64_t count = CalcElementCount(*out_dims);
+    vector<int64_t> index(rank, 0);
+    vector<int64_t> offsets(inputs.size(), 0);
+    for (int64_t n = 0; n < count; ++n) {
+        func(n, offsets);
+        for (int64_t i = rank - 1; i >= 0; --i) {
+            ++index[i];
+            for (uint32_t k = 0; k < inputs.size(); ++k) {
+                offsets[k] += strides[k][i];
+            }
+            if (index[i] < (*out_dims)[i]) {
+                break;
+            }
+            for (uint32_t k = 0; k < inputs.size(); ++k) {
+                offsets[k] -= strides[k][i] * index[i];
+            }
+            index[i] = 0;
+        }
+    }
+
+    return true;
+}
+
+template <typename ComputeFunc>
+static RetCode FoldArithmetic(const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs,
+                              const ComputeFunc& compute) {
+    auto data_type = inputs[0].shape->data_type;
+    if (inputs[1].shape->data_type != data_type) {
+        return RC_UNSUPPORTED;
+    }
+
+    auto out = &outputs->at(0);
+    vector<int64_t> out_dims;
+    bool ok = ForEachBroadcastElement(inputs, &out_dims, [](int64_t, const vector<int64_t>&) -> void {});
+    if (!ok) {
+        return RC_INVALID_VALUE;
+    }
+    InitOutput(data_type, out_dims, out);
+
+    bool is_valid = true;
+    ForEachBroadcastElement(inputs, &out_dims, [&](int64_t n, const vector<int64_t>& offsets) -> void {
+        if (data_type == DATATYPE_FLOAT32) {
+            SetElement<double>(out, n,
+                               compute(GetElement<double>(inputs[0], offsets[0]),
+                                       GetElement<double>(inputs[1], offsets[1]), &is_valid));
+        } else {
+            SetElement<int64_t>(out, n,
+                                compute(GetElement<int64_t>(inputs[0], offsets[0]),
+                                        GetElement<int64_t>(inputs[1], offsets[1]), &is_valid));
+        }
+    });
+
+    return is_valid ? RC_SUCCESS : RC_UNSUPPORTED;
+}
+
+template <typename CompareFunc>
+static RetCode FoldCompare(const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs,
+                           const CompareFunc& compare) {
+    auto data_type = inputs[0].shape->data_type;
+    if (inputs[1].shape->data_type != data_type) {
+        return RC_UNSUPPORTED;
+    }
+
+    auto out = &outputs->at(0);
+    vector<int64_t> out_dims;
+    if (!ForEachBroadcastElement(inputs, &out_dims, [](int64_t, const vector<int64_t>&) -> void {})) {
+        return RC_INVALID_VALUE;
+    }
+    InitOutput(DATATYPE_BOOL, out_dims, out);
+
+    ForEachBroadcastElement(inputs, &out_dims, [&](int64_t n, const vector<int64_t>& offsets) -> void {
+        bool result;
+        if (data_type == DATATYPE_FLOAT32) {
+            result = compare(GetElement<double>(inputs[0], offsets[0]), GetElement<double>(inputs[1], offsets[1]));
+        } else {
+            result = compare(GetElement<int64_t>(inputs[0], offsets[0]), GetElement<int64_t>(inputs[1], offsets[1]));
+        }
+        SetElement<int64_t>(out, n, result);
+    });
+
+    return RC_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static RetCode FoldShape(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto& dims = inputs[0].shape->dims;
+    auto out = &outputs->at(0);
+    InitOutput(DATATYPE_INT64, {(int64_t)dims.size()}, out);
+    if (!dims.empty()) {
+        memcpy(&out->data[0], dims.data(), dims.size() * sizeof(int64_t));
+    }
+    return RC_SUCCESS;
+}
+
+static RetCode FoldIdentity(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto out = &outputs->at(0);
+    out->shape = *inputs[0].shape;
+    out->data = *inputs[0].data;
+    return RC_SUCCESS;
+}
+
+static RetCode FoldCast(const void* arg, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto param = (const common::CastParam*)arg;
+    if (GetFoldingElementSize(param->to) == 0) {
+        return RC_UNSUPPORTED;
+    }
+
+    auto out = &outputs->at(0);
+    InitOutput(param->to, inputs[0].shape->dims, out);
+    const int64_t count = CalcElementCount(out->shape.dims);
+    for (int64_t i = 0; i < count; ++i) {
+        if (param->to == DATATYPE_FLOAT32 || inputs[0].shape->data_type == DATATYPE_FLOAT32) {
+            SetElement<double>(out, i, GetElement<double>(inputs[0], i));
+        } else {
+            SetElement<int64_t>(out, i, GetElement<int64_t>(inputs[0], i));
+        }
+    }
+    return RC_SUCCESS;
+}
+
+static RetCode FoldUnsqueeze(const void* arg, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto param = (const common::UnsqueezeParam*)arg;
+    auto& in_dims = inputs[0].shape->dims;
+    const int64_t out_rank = in_dims.size() + param->axes.size();
+
+    vector<bool> is_new_axis(out_rank, false);
+    for (auto x = param->axes.begin(); x != param->axes.end(); ++x) {
+        int64_t axis;
+        if (!NormalizeAxis(*x, out_rank, &axis) || is_new_axis[axis]) {
+            return RC_INVALID_VALUE;
+        }
+        is_new_axis[axis] = true;
+    }
+
+    auto out = &outputs->at(0);
+    out->shape = *inputs[0].shape;
+    out->shape.dims.clear();
+    for (int64_t i = 0, j = 0; i < out_rank; ++i) {
+        out->shape.dims.push_back(is_new_axis[i] ? 1 : in_dims[j++]);
+    }
+    out->data = *inputs[0].data;
+    return RC_SUCCESS;
+}
+
+static RetCode FoldSqueeze(const void* arg, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto param = (const common::SqueezeParam*)arg;
+    auto& in_dims = inputs[0].shape->dims;
+
+    vector<bool> is_removed(in_dims.size(), param->axes.empty());
+    for (auto x = param->axes.begin(); x != param->axes.end(); ++x) {
+        int64_t axis;
+        if (!NormalizeAxis(*x, in_dims.size(), &axis) || in_dims[axis] != 1) {
+            return RC_INVALID_VALUE;
+        }
+        is_removed[axis] = true;
+    }
+
+    auto out = &outputs->at(0);
+    out->shape = *inputs[0].shape;
+    out->shape.dims.clear();
+    for (uint32_t i = 0; i < in_dims.size(); ++i) {
+        if (!is_removed[i] || in_dims[i] != 1) {
+            out->shape.dims.push_back(in_dims[i]);
+        }
+    }
+    out->data = *inputs[0].data;
+    return RC_SUCCESS;
+}
+
+static RetCode FoldReshape(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto& in_dims = inputs[0].shape->dims;
+    const int64_t count = CalcElementCount(in_dims);
+
+    vector<int64_t> out_dims(CalcElementCount(inputs[1].shape->dims));
+    int64_t infer_axis = -1;
+    int64_t known = 1;
+    for (uint32_t i = 0; i < out_dims.size(); ++i) {
+        int64_t d = GetElement<int64_t>(inputs[1], i);
+        if (d == 0) {
+            if (i >= in_dims.size()) {
+                return RC_INVALID_VALUE;
+            }
+            d = in_dims[i];
+        }
+        if (d == -1) {
+            if (infer_axis >= 0) {
+                return RC_INVALID_VALUE;
+            }
+            infer_axis = i;
+        } else {
+            known *= d;
+        }
+        out_dims[i] = d;
+    }
+    if (infer_axis >= 0) {
+        if (known == 0 || count % known != 0) {
+            return RC_INVALID_VALUE;
+        }
+        out_dims[infer_axis] = count / known;
+    } else if (known != count) {
+        return RC_INVALID_VALUE;
+    }
+
+    auto out = &outputs->at(0);
+    out->shape = *inputs[0].shape;
+    out->shape.dims = out_dims;
+    out->data = *inputs[0].data;
+    return RC_SUCCESS;
+}
+
+static RetCode FoldConcat(const void* arg, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto param = (const common::ConcatParam*)arg;
+    auto& first_shape = *inputs[0].shape;
+    const int64_t rank = first_shape.dims.size();
+    const uint32_t elem_size = GetFoldingElementSize(first_shape.data_type);
+
+    int64_t axis;
+    if (!NormalizeAxis(param->axis, rank, &axis)) {
+        return RC_INVALID_VALUE;
+    }
+
+    vector<int64_t> out_dims = first_shape.dims;
+    out_dims[axis] = 0;
+    for (auto x = inputs.begin(); x != inputs.end(); ++x) {
+        if (x->shape->data_type != first_shape.data_type || (int64_t)x->shape->dims.size() != rank) {
+            return RC_INVALID_VALUE;
+        }
+        out_dims[axis] += x->shape->dims[axis];
+    }
+
+    int64_t outer = 1;
+    for (int64_t i = 0; i < axis; ++i) {
+        outer *= out_dims[i];
+    }
+
+    auto out = &outputs->at(0);
+    InitOutput(first_shape.data_type, out_dims, out);
+    out->data.clear();
+    for (int64_t o = 0; o < outer; ++o) {
+        for (auto x = inputs.begin(); x != inputs.end(); ++x) {
+            const int64_t inner_bytes = CalcElementCount(x->shape->dims) / outer * elem_size;
+            out->data.append(x->data->data() + o * inner_bytes, inner_bytes);
+        }
+    }
+    return RC_SUCCESS;
+}
+
+static RetCode FoldGather(const void* arg, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto param = (const common::GatherParam*)arg;
+    auto& data_shape = *inputs[0].shape;
+    auto& indices_shape = *inputs[1].shape;
+    const int64_t rank = data_shape.dims.size();
+    const uint32_t elem_size = GetFoldingElementSize(data_shape.data_type);
+
+    int64_t axis;
+    if (!NormalizeAxis(param->axis, rank, &axis)) {
+        return RC_INVALID_VALUE;
+    }
+
+    vector<int64_t> out_dims(data_shape.dims.begin(), data_shape.dims.begin() + axis);
+    out_dims.insert(out_dims.end(), indices_shape.dims.begin(), indices_shape.dims.end());
+    out_dims.insert(out_dims.end(), data_shape.dims.begin() + axis + 1, data_shape.dims.end());
+
+    int64_t outer = 1, inner = 1;
+    for (int64_t i = 0; i < axis; ++i) {
+        outer *= data_shape.dims[i];
+    }
+    for (int64_t i = axis + 1; i < rank; ++i) {
+        inner *= data_shape.dims[i];
+    }
+    const int64_t axis_dim = data_shape.dims[axis];
+    const int64_t num_indices = CalcElementCount(indices_shape.dims);
+    const int64_t inner_bytes = inner * elem_size;
+
+    auto out = &outputs->at(0);
+    InitOutput(data_shape.data_type, out_dims, out);
+    for (int64_t o = 0; o < outer; ++o) {
+        for (int64_t n = 0; n < num_indices; ++n) {
+            int64_t idx = GetElement<int64_t>(inputs[1], n);
+            if (idx < -axis_dim || idx >= axis_dim) {
+                return RC_INVALID_VALUE;
+            }
+            idx = (idx < 0) ? idx + axis_dim : idx;
+            memcpy(&out->data[(o * num_indices + n) * inner_bytes],
+                   inputs[0].data->data() + (o * axis_dim + idx) * inner_bytes, inner_bytes);
+        }
+    }
+    return RC_SUCCESS;
+}
+
+// opset 11, starts/ends/axes/steps are inputs
+static RetCode FoldSlice(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto& data_shape = *inputs[0].shape;
+    const int64_t rank = data_shape.dims.size();
+    const uint32_t elem_size = GetFoldingElementSize(data_shape.data_type);
+
+    vector<int64_t> starts(rank, 0), steps(rank, 1), out_dims = data_shape.dims;
+    const int64_t num_axes = CalcElementCount(inputs[1].shape->dims);
+    for (int64_t i = 0; i < num_axes; ++i) {
+        int64_t axis = i;
+        if (inputs.size() > 3 && inputs[3].data) {
+            if (!NormalizeAxis(GetElement<int64_t>(inputs[3], i), rank, &axis)) {
+                return RC_INVALID_VALUE;
+            }
+        }
+        const int64_t dim = data_shape.dims[axis];
+        const int64_t step = (inputs.size() > 4 && inputs[4].data) ? GetElement<int64_t>(inputs[4], i) : 1;
+        int64_t start = GetElement<int64_t>(inputs[1], i);
+        int64_t end = GetElement<int64_t>(inputs[2], i);
+        if (step == 0) {
+            return RC_INVALID_VALUE;
+        }
+        start = (start < 0) ? start + dim : start;
+        end = (end < 0) ? end + dim : end;
+        if (step > 0) {
+            start = min(max<int64_t>(start, 0), dim);
+            end = min(max<int64_t>(end, 0), dim);
+            out_dims[axis] = max<int64_t>((end - start + step - 1) / step, 0);
+        } else {
+            start = min(max<int64_t>(start, 0), dim - 1);
+            end = min(max<int64_t>(end, -1), dim - 1);
+            out_dims[axis] = max<int64_t>((start - end - step - 1) / (-step), 0);
+        }
+        starts[axis] = start;
+        steps[axis] = step;
+    }
+
+    vector<int64_t> in_strides(rank, 1);
+    for (int64_t i = rank - 2; i >= 0; --i) {
+        in_strides[i] = in_strides[i + 1] * data_shape.dims[i + 1];
+    }
+
+    auto out = &outputs->at(0);
+    InitOutput(data_shape.data_type, out_dims, out);
+    const int64_t count = CalcElementCount(out_dims);
+    vector<int64_t> index(rank, 0);
+    for (int64_t n = 0; n < count; ++n) {
+        int64_t offset = 0;
+        for (int64_t i = 0; i < rank; ++i) {
+            offset += (starts[i] + index[i] * steps[i]) * in_strides[i];
+        }
+        memcpy(&out->data[n * elem_size], inputs[0].data->data() + offset * elem_size, elem_size);
+        for (int64_t i = rank - 1; i >= 0; --i) {
+            if (++index[i] < out_dims[i]) {
+                break;
+            }
+            index[i] = 0;
+        }
+    }
+    return RC_SUCCESS;
+}
+
+static RetCode FoldWhere(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto data_type = inputs[1].shape->data_type;
+    if (inputs[2].shape->data_type != data_type) {
+        return RC_UNSUPPORTED;
+    }
+    const uint32_t elem_size = GetFoldingElementSize(data_type);
+
+    auto out = &outputs->at(0);
+    vector<int64_t> out_dims;
+    if (!ForEachBroadcastElement(inputs, &out_dims, [](int64_t, const vector<int64_t>&) -> void {})) {
+        return RC_INVALID_VALUE;
+    }
+    InitOutput(data_type, out_dims, out);
+
+    ForEachBroadcastElement(inputs, &out_dims, [&](int64_t n, const vector<int64_t>& offsets) -> void {
+        auto& src = GetElement<int64_t>(inputs[0], offsets[0]) ? inputs[1] : inputs[2];
+        auto src_offset = GetElement<int64_t>(inputs[0], offsets[0]) ? offsets[1] : offsets[2];
+        memcpy(&out->data[n * elem_size], src.data->data() + src_offset * elem_size, elem_size);
+    });
+    return RC_SUCCESS;
+}
+
+static RetCode FoldConstantOfShape(const void* arg, const vector<FoldingInput>& inputs,
+                                   vector<FoldingOutput>* outputs) {
+    auto param = (const common::ConstantOfShapeParam*)arg;
+    const uint32_t elem_size = GetFoldingElementSize(param->data_type);
+    if (elem_size == 0 || param->data.size() < elem_size) {
+        return RC_UNSUPPORTED;
+    }
+
+    vector<int64_t> out_dims(CalcElementCount(inputs[0].shape->dims));
+    for (uint32_t i = 0; i < out_dims.size(); ++i) {
+        out_dims[i] = GetElement<int64_t>(inputs[0], i);
+    }
+
+    auto out = &outputs->at(0);
+    InitOutput(param->data_type, out_dims, out);
+    const int64_t count = CalcElementCount(out_dims);
+    for (int64_t i = 0; i < count; ++i) {
+        memcpy(&out->data[i * elem_size], param->data.data(), elem_size);
+    }
+    return RC_SUCCESS;
+}
+
+static RetCode FoldRange(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    auto data_type = inputs[0].shape->data_type;
+    const double start = GetElement<double>(inputs[0], 0);
+    const double limit = GetElement<double>(inputs[1], 0);
+    const double delta = GetElement<double>(inputs[2], 0);
+    if (delta == 0) {
+        return RC_INVALID_VALUE;
+    }
+
+    const int64_t count = max<int64_t>((int64_t)ceil((limit - start) / delta), 0);
+    auto out = &outputs->at(0);
+    InitOutput(data_type, {count}, out);
+    for (int64_t i = 0; i < count; ++i) {
+        if (data_type == DATATYPE_FLOAT32) {
+            SetElement<double>(out, i, start + i * delta);
+        } else {
+            SetElement<int64_t>(out, i, (int64_t)start + i * (int64_t)delta);
+        }
+    }
+    return RC_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+struct AddFunctor final {
+    template <typename T>
+    T operator()(T a, T b, bool*) const {
+        return a + b;
+    }
+};
+
+struct SubFunctor final {
+    template <typename T>
+    T operator()(T a, T b, bool*) const {
+        return a - b;
+    }
+};
+
+struct MulFunctor final {
+    template <typename T>
+    T operator()(T a, T b, bool*) const {
+        return a * b;
+    }
+};
+
+struct DivFunctor final {
+    template <typename T>
+    T operator()(T a, T b, bool* is_valid) const {
+        if (b == T(0)) {
+            *is_valid = false;
+            return a;
+        }
+        return a / b;
+    }
+};
+
+struct EqualFunctor final {
+    template <typename T>
+    bool operator()(T a, T b) const {
+        return a == b;
+    }
+};
+
+struct GreaterFunctor final {
+    template <typename T>
+    bool operator()(T a, T b) const {
+        return a > b;
+    }
+};
+
+struct LessFunctor final {
+    template <typename T>
+    bool operator()(T a, T b) const {
+        return a < b;
+    }
+};
+
+template <typename Functor>
+static RetCode FoldArithmeticOp(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    return FoldArithmetic(inputs, outputs, Functor());
+}
+
+template <typename Functor>
+static RetCode FoldCompareOp(const void*, const vector<FoldingInput>& inputs, vector<FoldingOutput>* outputs) {
+    return FoldCompare(inputs, outputs, Functor());
+}
+
+struct FoldingInfo final {
+    uint32_t min_input_count;
+    bool need_param;
+    FoldingFunc func;
+};
+
+static const map<string, FoldingInfo>& GetFoldingInfos() {
+    static const map<string, FoldingInfo> infos = {
+        {"Add", {2, false, FoldArithmeticOp<AddFunctor>}},
+        {"Cast", {1, true, FoldCast}},
+        {"Concat", {1, true, FoldConcat}},
+        {"ConstantOfShape", {1, true, FoldConstantOfShape}},
+        {"Div", {2, false, FoldArithmeticOp<DivFunctor>}},
+        {"Equal", {2, false, FoldCompareOp<EqualFunctor>}},
+        {"Gather", {2, true, FoldGather}},
+        {"Greater", {2, false, FoldCompareOp<GreaterFunctor>}},
+        {"Identity", {1, false, FoldIdentity}},
+        {"Less", {2, false, FoldCompareOp<LessFunctor>}},
+        {"Mul", {2, false, FoldArithmeticOp<MulFunctor>}},
+        {"Range", {3, false, FoldRange}},
+        {"Reshape", {2, false, FoldReshape}},
+        {"Shape", {1, false, FoldShape}},
+        {"Slice", {3, false, FoldSlice}},
+        {"Squeeze", {1, true, FoldSqueeze}},
+        {"Sub", {2, false, FoldArithmeticOp<SubFunctor>}},
+        {"Unsqueeze", {1, true, FoldUnsqueeze}},
+        {"Where", {3, false, FoldWhere}},
+    };
+    return infos;
+}
+
+static bool IsGraphOutput(const ir::GraphTopo* topo, edgeid_t eid) {
+    for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+        if (topo->GetOutput(i) == eid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// collects constant inputs of `node`, returns false if any of them is not a foldable constant
+static bool CollectFoldingInputs(const ir::Graph* graph, const ir::Node* node, vector<FoldingInput>* inputs) {
+    auto& constants = graph->data->constants;
+    auto& shapes = graph->data->shapes;
+    // Shape only reads dims, its input can be of any type
+    const bool only_need_dims = (node->GetType().name == "Shape");
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto eid = node->GetInput(i);
+        if (eid == INVALID_EDGEID) {
+            return false;
+        }
+        auto constant_ref = constants.find(eid);
+        auto shape_ref = shapes.find(eid);
+        if (constant_ref == constants.end() || shape_ref == shapes.end()) {
+            return false;
+        }
+
+        auto& shape = shape_ref->second;
+        if (!only_need_dims) {
+            const uint32_t elem_size = GetFoldingElementSize(shape.data_type);
+            if (elem_size == 0 || shape.data_format != DATAFORMAT_NDARRAY ||
+                constant_ref->second.data.size() < CalcElementCount(shape.dims) * elem_size) {
+                return false;
+            }
+        }
+
+        FoldingInput input;
+        input.shape = &shape;
+        input.data = &constant_ref->second.data;
+        inputs->push_back(input);
+    }
+
+    return true;
+}
+
+RetCode ConstantFoldingOptimizer::Optimize(ir::Graph* graph) const {
+    auto topo = graph->topo.get();
+    auto& attrs = graph->data->attrs;
+    auto& constants = graph->data->constants;
+    auto& shapes = graph->data->shapes;
+    auto& infos = GetFoldingInfos();
+
+    // in topological order so that a whole chain of foldable nodes is folded in one pass
+    vector<nodeid_t> sorted_nodes;
+    topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    uint32_t folded_count = 0;
+    for (auto nid = sorted_nodes.begin(); nid != sorted_nodes.end(); ++nid) {
+        auto node = topo->GetNodeById(*nid);
+        if (!node->GetType().domain.empty() || node->GetExtraInputCount() > 0 || node->GetOutputCount() != 1) {
+            continue;
+        }
+        auto info_ref = infos.find(node->GetType().name);
+        if (info_ref == infos.end() || node->GetInputCount() < info_ref->second.min_input_count) {
+            continue;
+        }
+
+        auto output_edge = topo->GetEdgeById(node->GetOutput(0));
+        if (!output_edge || IsGraphOutput(topo, output_edge->GetId())) {
+            continue;
+        }
+
+        const void* param = nullptr;
+        auto attr_ref = attrs.find(node->GetId());
+        if (attr_ref != attrs.end()) {
+            param = attr_ref->second.get();
+        }
+        if (info_ref->second.need_param && !param) {
+            continue;
+        }
+
+        vector<FoldingInput> inputs;
+        if (!CollectFoldingInputs(graph, node, &inputs)) {
+            continue;
+        }
+
+        vector<FoldingOutput> outputs(1);
+        auto status = info_ref->second.func(param, inputs, &outputs);
+        if (status != RC_SUCCESS) {
+            LOG(DEBUG) << "skip folding node[" << node->GetName() << "]: " << GetRetCodeStr(status);
+            continue;
+        }
+
+        // output becomes a graph constant
+        auto output_id = output_edge->GetId();
+        constants[output_id].data = std::move(outputs[0].data);
+        shapes[output_id] = std::move(outputs[0].shape);
+        output_edge->SetProducer(INVALID_NODEID);
+        topo->MarkAsConstant(output_id);
+
+        // delete constant inputs that are no longer used
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto input_edge = topo->GetEdgeById(node->GetInput(i));
+            if (!input_edge) {
+                continue;
+            }
+            input_edge->DelConsumer(node->GetId());
+            if (input_edge->CalcConsumerCount() == 0 && !IsGraphOutput(topo, input_edge->GetId())) {
+                constants.erase(input_edge->GetId());
+                shapes.erase(input_edge->GetId());
+                topo->DelEdgeById(input_edge->GetId());
+            }
+        }
+
+        attrs.erase(node->GetId());
+        topo->DelNodeById(node->GetId());
+        ++folded_count;
+    }
+
+    if (folded_count > 0) {
+        LOG(DEBUG) << "folded [" << folded_count << "] constant nodes of graph[" << topo->GetName() << "]";
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,472 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+static const double g_cost_epsilon = 1e-9;
+
+// used when costs cannot be estimated. keeps op : conversion : partition = 1 : 2 : 4.
+static const double g_default_op_cost = 10.0;
+static const double g_default_conversion_cost = 20.0;
+// about 10GB/s
+static const double g_conversion_bytes_per_us = 10000.0;
+
+static void CollectInputShapes(const ir::Graph* graph, const ir::Node* node, vector<const ir::Shape*>* shapes) {
+    auto& all_shapes = graph->data->shapes;
+    shapes->assign(node->GetInputCount(), nullptr);
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto ref = all_shapes.find(node->GetInput(i));
+        if (ref != all_shapes.end()) {
+            shapes->at(i) = &ref->second;
+        }
+    }
+}
+
+double DefaultGraphPartitionCostModel::GetOpCost(const ir::Graph* graph, const ir::Node* node,
+                                                 EngineImpl* engine) const {
+    if (!engines_) {
+        return g_default_op_cost;
+    }
+
+    vector<const ir::Shape*> input_shapes;
+    CollectInputShapes(graph, node, &input_shapes);
+
+    // estimations are not comparable with defaults, so they are used only if all candidates give one
+    double engine_cost = g_default_op_cost;
+    for (auto it = engines_->begin(); it != engines_->end(); ++it) {
+        auto e = it->get();
+        if (!e->CanRunOp(node)) {
+            continue;
+        }
+
+        double cost = 0;
+        if (e->EstimateOpCost(graph, node, input_shapes, &cost) != RC_SUCCESS) {
+            return g_default_op_cost;
+        }
+        if (e == engine) {
+            engine_cost = cost;
+        }
+    }
+
+    return engine_cost;
+}
+
+double DefaultGraphPartitionCostModel::GetConversionCost(const ir::Graph* graph, const ir::Edge* edge, EngineImpl*,
+                                                         EngineImpl*) const {
+    auto ref = graph->data->shapes.find(edge->GetId());
+    if (ref == graph->data->shapes.end()) {
+        return g_default_conversion_cost;
+    }
+
+    const ir::Shape& shape = ref->second;
+    double bytes = GetSizeOfDataType(shape.data_type);
+    for (auto it = shape.dims.begin(); it != shape.dims.end(); ++it) {
+        if (*it < 0) {
+            return g_default_conversion_cost;
+        }
+        bytes *= *it;
+    }
+
+    // read and write, plus a fixed overhead of launching a converter
+    return 1.0 + 2.0 * bytes / g_conversion_bytes_per_us;
+}
+
+struct EngineCandidate {
+    EngineImpl* engine;
+    double op_cost;
+};
+
+struct PartitionContext {
+    const ir::Graph* graph;
+    const GraphPartitionCostModel* cost_model;
+    vector<nodeid_t> sorted_nodes;
+    vector<vector<EngineCandidate>> candidates; // indexed by node id
+    vector<EngineImpl*> node2engine; // indexed by node id
+};
+
+static const EngineCandidate* FindCandidate(const PartitionContext& ctx, nodeid_t nid, EngineImpl* engine) {
+    auto& candidates = ctx.candidates[nid];
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        if (it->engine == engine) {
+            return &(*it);
+        }
+    }
+    return nullptr;
+}
+
+// a converter is inserted for each engine other than the producer's. graph inputs and constants have no producer.
+static double CalcEdgeCost(const PartitionContext& ctx, const ir::Edge* edge) {
+    if (edge->GetProducer() == INVALID_NODEID) {
+        return 0;
+    }
+
+    auto from = ctx.node2engine[edge->GetProducer()];
+    vector<EngineImpl*> to_engines;
+    double cost = 0;
+    for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+        auto to = ctx.node2engine[it.Get()];
+        if (to && to != from && std::find(to_engines.begin(), to_engines.end(), to) == to_engines.end()) {
+            to_engines.push_back(to);
+            cost += ctx.cost_model->GetConversionCost(ctx.graph, edge, from, to);
+        }
+    }
+    return cost;
+}
+
+static void CollectEdges(const ir::Node* node, vector<edgeid_t>* edges) {
+    edges->clear();
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        edges->push_back(node->GetInput(i));
+    }
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+        edges->push_back(node->GetExtraInput(i));
+    }
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        edges->push_back(node->GetOutput(i));
+    }
+    std::sort(edges->begin(), edges->end());
+    edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
+}
+
+// op cost of `node` plus conversion costs of edges around it when it runs on `candidate`
+static double CalcNodeCost(const ir::Node* node, const EngineCandidate& candidate, PartitionContext* ctx) {
+    auto topo = ctx->graph->topo.get();
+    auto nid = node->GetId();
+
+    auto saved_engine = ctx->node2engine[nid];
+    ctx->node2engine[nid] = candidate.engine;
+
+    vector<edgeid_t> edges;
+    CollectEdges(node, &edges);
+
+    double cost = candidate.op_cost;
+    for (auto it = edges.begin(); it != edges.end(); ++it) {
+        auto edge = topo->GetEdgeById(*it);
+        if (edge) {
+            cost += CalcEdgeCost(*ctx, edge);
+        }
+    }
+
+    ctx->node2engine[nid] = saved_engine;
+    return cost;
+}
+
+static void FindPartitions(const PartitionContext& ctx, vector<vector<nodeid_t>>* partitions) {
+    auto topo = ctx.graph->topo.get();
+    vector<bool> visited(ctx.node2engine.size(), false);
+
+    partitions->clear();
+    for (auto x = ctx.sorted_nodes.begin(); x != ctx.sorted_nodes.end(); ++x) {
+        if (visited[*x]) {
+            continue;
+        }
+
+        auto engine = ctx.node2engine[*x];
+        vector<nodeid_t> connected_nodes;
+        vector<nodeid_t> nodes_stack(1, *x);
+        visited[*x] = true;
+
+        do {
+            auto nid = nodes_stack.back();
+            nodes_stack.pop_back();
+            connected_nodes.push_back(nid);
+
+            auto neighbors = topo->FindPredecessors(nid);
+            auto next_ids = topo->FindSuccessors(nid);
+            neighbors.insert(neighbors.end(), next_ids.begin(), next_ids.end());
+            for (auto it = neighbors.begin(); it != neighbors.end(); ++it) {
+                if (!visited[*it] && ctx.node2engine[*it] == engine) {
+                    visited[*it] = true;
+                    nodes_stack.push_back(*it);
+                }
+            }
+        } while (!nodes_stack.empty());
+
+        partitions->push_back(std::move(connected_nodes));
+    }
+}
+
+static RetCode InitCandidates(utils::SharedResource* resource, PartitionContext* ctx) {
+    auto topo = ctx->graph->topo.get();
+    ctx->candidates.resize(topo->GetMaxNodeId());
+    ctx->node2engine.resize(topo->GetMaxNodeId(), nullptr);
+
+    for (auto x = ctx->sorted_nodes.begin(); x != ctx->sorted_nodes.end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+        auto& candidates = ctx->candidates[*x];
+
+        for (auto it = resource->engines.begin(); it != resource->engines.end(); ++it) {
+            auto engine = it->get();
+            if (engine->CanRunOp(node)) {
+                EngineCandidate candidate;
+                candidate.engine = engine;
+                candidate.op_cost = ctx->cost_model->GetOpCost(ctx->graph, node, engine);
+                candidates.push_back(candidate);
+            }
+        }
+
+        if (candidates.empty()) {
+            const ir::Node::Type& type = node->GetType();
+            LOG(ERROR) << "cannot find implementation of op[" << type.domain << ":" << type.name << "]";
+            return RC_NOT_FOUND;
+        }
+
+        // the first engine wins if costs are equal
+        auto best = &candidates[0];
+        for (auto it = candidates.begin() + 1; it != candidates.end(); ++it) {
+            if (it->op_cost < best->op_cost - g_cost_epsilon) {
+                best = &(*it);
+            }
+        }
+        ctx->node2engine[*x] = best->engine;
+    }
+
+    return RC_SUCCESS;
+}
+
+// moves single nodes to other engines if that lowers the cost of them and their edges. returns true if any node moved.
+static bool RefineAssignment(PartitionContext* ctx) {
+    auto topo = ctx->graph->topo.get();
+    bool changed = false;
+
+    for (auto x = ctx->sorted_nodes.begin(); x != ctx->sorted_nodes.end(); ++x) {
+        auto& candidates = ctx->candidates[*x];
+        if (candidates.size() < 2) {
+            continue;
+        }
+
+        auto node = topo->GetNodeById(*x);
+        auto best = FindCandidate(*ctx, *x, ctx->node2engine[*x]);
+        double best_cost = CalcNodeCost(node, *best, ctx);
+        for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+            double cost = CalcNodeCost(node, *it, ctx);
+            if (cost < best_cost - g_cost_epsilon) {
+                best = &(*it);
+                best_cost = cost;
+            }
+        }
+
+        if (best->engine != ctx->node2engine[*x]) {
+            ctx->node2engine[*x] = best->engine;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+static bool CanRunAll(const PartitionContext& ctx, const vector<nodeid_t>& nodes, EngineImpl* engine) {
+    for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+        if (!FindCandidate(ctx, *it, engine)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void SetEngine(const vector<nodeid_t>& nodes, EngineImpl* engine, PartitionContext* ctx) {
+    for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+        ctx->node2engine[*it] = engine;
+    }
+}
+
+// cost change of moving `island` to `engine`, counting its ops and the edges around it but not partitions
+static double CalcMoveCost(const vector<nodeid_t>& island, EngineImpl* engine, PartitionContext* ctx) {
+    auto topo = ctx->graph->topo.get();
+    auto island_engine = ctx->node2engine[island.front()];
+
+    vector<edgeid_t> edge_ids, node_edge_ids;
+    double cost = 0;
+    for (auto x = island.begin(); x != island.end(); ++x) {
+        cost += FindCandidate(*ctx, *x, engine)->op_cost - FindCandidate(*ctx, *x, island_engine)->op_cost;
+        CollectEdges(topo->GetNodeById(*x), &node_edge_ids);
+        edge_ids.insert(edge_ids.end(), node_edge_ids.begin(), node_edge_ids.end());
+    }
+    std::sort(edge_ids.begin(), edge_ids.end());
+    edge_ids.erase(std::unique(edge_ids.begin(), edge_ids.end()), edge_ids.end());
+
+    vector<const ir::Edge*> edges;
+    for (auto it = edge_ids.begin(); it != edge_ids.end(); ++it) {
+        auto edge = topo->GetEdgeById(*it);
+        if (edge) {
+            edges.push_back(edge);
+        }
+    }
+
+    for (auto it = edges.begin(); it != edges.end(); ++it) {
+        cost -= CalcEdgeCost(*ctx, *it);
+    }
+    SetEngine(island, engine, ctx);
+    for (auto it = edges.begin(); it != edges.end(); ++it) {
+        cost += CalcEdgeCost(*ctx, *it);
+    }
+    SetEngine(island, island_engine, ctx);
+
+    return cost;
+}
+
+static uint32_t FindRoot(uint32_t idx, vector<uint32_t>* parents) {
+    while ((*parents)[idx] != idx) {
+        (*parents)[idx] = (*parents)[(*parents)[idx]];
+        idx = (*parents)[idx];
+    }
+    return idx;
+}
+
+/*
+  moves partitions of at most `max_island_size` nodes to the engine of a neighbor if the total cost decreases.
+  a move only changes the island's op costs, the edges around it and the number of partitions, which drops by the
+  number of partitions of the new engine it joins, so moves are evaluated locally. partitions joined by a move are
+  tracked with a union-find, so that one pass over all islands finds partitions once. returns true if any island
+  moved.
+*/
+static bool MergeIslands(uint32_t max_island_size, PartitionContext* ctx) {
+    auto topo = ctx->graph->topo.get();
+
+    vector<vector<nodeid_t>> partitions;
+    FindPartitions(*ctx, &partitions);
+    if (partitions.size() < 2) {
+        return false;
+    }
+
+    vector<uint32_t> parents(partitions.size());
+    vector<uint32_t> node2partition(ctx->node2engine.size());
+    for (uint32_t i = 0; i < partitions.size(); ++i) {
+        parents[i] = i;
+        for (auto x = partitions[i].begin(); x != partitions[i].end(); ++x) {
+            node2partition[*x] = i;
+        }
+    }
+
+    bool changed = false;
+    for (uint32_t i = 0; i < partitions.size(); ++i) {
+        if (FindRoot(i, &parents) != i || partitions[i].size() > max_island_size) {
+            continue;
+        }
+
+        // partitions around the island grouped by their engines
+        const vector<nodeid_t>& island = partitions[i];
+        vector<pair<EngineImpl*, vector<uint32_t>>> neighbor_partitions;
+        for (auto x = island.begin(); x != island.end(); ++x) {
+            auto neighbors = topo->FindPredecessors(*x);
+            auto next_ids = topo->FindSuccessors(*x);
+            neighbors.insert(neighbors.end(), next_ids.begin(), next_ids.end());
+            for (auto it = neighbors.begin(); it != neighbors.end(); ++it) {
+                auto root = FindRoot(node2partition[*it], &parents);
+                if (root == i) {
+                    continue;
+                }
+
+                auto engine = ctx->node2engine[*it];
+                auto ref = std::find_if(neighbor_partitions.begin(), neighbor_partitions.end(),
+                                        [engine](const pair<EngineImpl*, vector<uint32_t>>& p) -> bool {
+                                            return p.first == engine;
+                                        });
+                if (ref == neighbor_partitions.end()) {
+                    neighbor_partitions.emplace_back(engine, vector<uint32_t>(1, root));
+                } else if (std::find(ref->second.begin(), ref->second.end(), root) == ref->second.end()) {
+                    ref->second.push_back(root);
+                }
+            }
+        }
+
+        for (auto e = neighbor_partitions.begin(); e != neighbor_partitions.end(); ++e) {
+            if (!CanRunAll(*ctx, island, e->first)) {
+                continue;
+            }
+
+            const double cost = CalcMoveCost(island, e->first, ctx) -
+                ctx->cost_model->GetPartitionCost() * e->second.size();
+            if (cost < -g_cost_epsilon) {
+                SetEngine(island, e->first, ctx);
+
+                auto root = e->second.front();
+                auto& merged_nodes = partitions[root];
+                e->second.push_back(i);
+                for (auto it = e->second.begin() + 1; it != e->second.end(); ++it) {
+                    parents[*it] = root;
+                    merged_nodes.insert(merged_nodes.end(), partitions[*it].begin(), partitions[*it].end());
+                    vector<nodeid_t>().swap(partitions[*it]);
+                }
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    return changed;
+}
+
+RetCode CostGraphPartitioner::Partition(utils::SharedResource* resource, ir::Graph* graph,
+                                        vector<pair<EngineImpl*, vector<nodeid_t>>>* partitions) const {
+    DefaultGraphPartitionCostModel default_cost_model(&resource->engines);
+
+    PartitionContext ctx;
+    ctx.graph = graph;
+    ctx.cost_model = cost_model_ ? cost_model_ : &default_cost_model;
+    graph->topo->TopologicalSort([&ctx](nodeid_t nid) -> void {
+        ctx.sorted_nodes.push_back(nid);
+    });
+
+    auto status = InitCandidates(resource, &ctx);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    if (resource->engines.size() > 1) {
+        for (uint32_t i = 0; i < max_refine_passes_; ++i) {
+            if (!RefineAssignment(&ctx)) {
+                break;
+            }
+        }
+        while (MergeIslands(max_island_size_, &ctx))
+            ;
+    }
+
+    vector<vector<nodeid_t>> components;
+    FindPartitions(ctx, &components);
+
+    bool single_engine = true;
+    for (auto it = components.begin(); it != components.end(); ++it) {
+        if (ctx.node2engine[it->front()] != ctx.node2engine[components.front().front()]) {
+            single_engine = false;
+            break;
+        }
+    }
+
+    if (single_engine && !components.empty()) {
+        // disconnected parts of a graph run by one engine are still processed together
+        partitions->emplace_back(ctx.node2engine[components.front().front()], std::move(ctx.sorted_nodes));
+    } else {
+        for (auto it = components.begin(); it != components.end(); ++it) {
+            auto engine = ctx.node2engine[it->front()];
+            partitions->emplace_back(engine, std::move(*it));
+        }
+    }
+
+    LOG(INFO) << "total partition(s) of graph[" << graph->topo->GetName() << "]: " << partitions->size() << ".";
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
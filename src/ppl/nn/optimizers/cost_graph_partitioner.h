@@ -0,0 +1,97 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPTIMIZERS_COST_GRAPH_PARTITIONER_H_
+#define _ST_HPC_PPL_NN_OPTIMIZERS_COST_GRAPH_PARTITIONER_H_
+
+#include "ppl/nn/ir/graph.h"
+#include "ppl/nn/utils/shared_resource.h"
+#include <vector>
+#include <memory>
+
+namespace ppl { namespace nn {
+
+/**
+   @class GraphPartitionCostModel
+   @brief estimates used by CostGraphPartitioner. costs only need to be comparable with each other.
+*/
+class GraphPartitionCostModel {
+public:
+    virtual ~GraphPartitionCostModel() {}
+
+    /** @brief cost of running `node` on `engine`, which is able to run it */
+    virtual double GetOpCost(const ir::Graph*, const ir::Node* node, EngineImpl* engine) const = 0;
+
+    /** @brief cost of converting data of `edge` produced by engine `from` for engine `to` */
+    virtual double GetConversionCost(const ir::Graph*, const ir::Edge* edge, EngineImpl* from,
+                                     EngineImpl* to) const = 0;
+
+    /** @brief fixed overhead of each partition, e.g. graph processing and synchronization */
+    virtual double GetPartitionCost() const = 0;
+};
+
+/**
+   @class DefaultGraphPartitionCostModel
+   @brief costs are in microseconds. op costs come from EngineImpl::EstimateOpCost() if every engine that can run
+   the node gives an estimation, otherwise every op costs the same on every engine, so that only conversions and
+   partitions make a difference.
+*/
+class DefaultGraphPartitionCostModel final : public GraphPartitionCostModel {
+public:
+    /** @param engines engines to be asked for op costs. uses uniform op costs if it is nullptr. */
+    DefaultGraphPartitionCostModel(const std::vector<std::unique_ptr<EngineImpl>>* engines = nullptr)
+        : engines_(engines) {}
+
+    double GetOpCost(const ir::Graph*, const ir::Node* node, EngineImpl* engine) const override;
+    double GetConversionCost(const ir::Graph*, const ir::Edge* edge, EngineImpl* from,
+                             EngineImpl* to) const override;
+    double GetPartitionCost() const override {
+        return 40.0;
+    }
+
+private:
+    const std::vector<std::unique_ptr<EngineImpl>>* engines_;
+};
+
+/**
+   @class CostGraphPartitioner
+   @brief assigns each node to the engine with the lowest op cost, then moves nodes between engines when conversions
+   cost more than they save, and finally merges small partitions into neighbors when the total cost decreases.
+   partitions are connected components of nodes assigned to the same engine.
+*/
+class CostGraphPartitioner final {
+public:
+    /** @param cost_model uses DefaultGraphPartitionCostModel with engines in SharedResource if it is nullptr. */
+    CostGraphPartitioner(const GraphPartitionCostModel* cost_model = nullptr) : cost_model_(cost_model) {}
+
+    /** @brief partitions of at most `size` nodes are candidates of merging. default is 2. */
+    void SetMaxIslandSize(uint32_t size) {
+        max_island_size_ = size;
+    }
+
+    ppl::common::RetCode Partition(utils::SharedResource*, ir::Graph*,
+                                   std::vector<std::pair<EngineImpl*, std::vector<nodeid_t>>>*) const;
+
+private:
+    const GraphPartitionCostModel* cost_model_;
+    uint32_t max_island_size_ = 2;
+    uint32_t max_refine_passes_ = 4;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/dead_node_elimination_optimizer.h"
+#include "ppl/nn/common/logger.h"
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+inline bool IsGraphOutput(const ir::Graph* graph, edgeid_t edge_id) {
+    for (uint32_t i = 0; i < graph->topo->GetOutputCount(); i++) {
+        if (graph->topo->GetOutput(i) == edge_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool IsDeadNode(const ir::Graph* graph, const ir::Node* node) {
+    for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+        auto output_edge = graph->topo->GetEdgeById(node->GetOutput(i));
+        if (output_edge && (output_edge->CalcConsumerCount() > 0 || IsGraphOutput(graph, output_edge->GetId()))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void RemoveNode(ir::Graph* graph, ir::Node* node) {
+    auto topo = graph->topo.get();
+    for (uint32_t i = 0; i < node->GetInputCount(); i++) {
+        auto input_edge = topo->GetEdgeById(node->GetInput(i));
+        if (input_edge) {
+            input_edge->DelConsumer(node->GetId());
+        }
+    }
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); i++) {
+        auto input_edge = topo->GetEdgeById(node->GetExtraInput(i));
+        if (input_edge) {
+            input_edge->DelConsumer(node->GetId());
+        }
+    }
+    for (uint32_t i = 0; i < node->GetOutputCount(); i++) {
+        auto output_edge = topo->GetEdgeById(node->GetOutput(i));
+        if (output_edge && output_edge->GetProducer() == node->GetId()) {
+            graph->data->shapes.erase(output_edge->GetId());
+            topo->DelEdgeById(output_edge->GetId());
+        }
+    }
+
+    graph->data->attrs.erase(node->GetId());
+    topo->DelNodeById(node->GetId());
+}
+
+RetCode DeadNodeEliminationOptimizer::Optimize(ir::Graph* graph) const {
+    auto topo = graph->topo.get();
+
+    vector<nodeid_t> sorted_nodes;
+    topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    // consumers are visited before producers, so a whole dead chain is removed in one pass
+    uint32_t removed_node_count = 0;
+    for (auto nid = sorted_nodes.rbegin(); nid != sorted_nodes.rend(); ++nid) {
+        auto node = topo->GetNodeById(*nid);
+        if (node && IsDeadNode(graph, node)) {
+            RemoveNode(graph, node);
+            ++removed_node_count;
+        }
+    }
+
+    vector<edgeid_t> unused_constants;
+    for (uint32_t i = 0; i < topo->GetConstantCount(); i++) {
+        auto edge = topo->GetEdgeById(topo->GetConstant(i));
+        if (edge && edge->CalcConsumerCount() == 0 && !IsGraphOutput(graph, edge->GetId())) {
+            unused_constants.push_back(edge->GetId());
+        }
+    }
+    for (auto eid = unused_constants.begin(); eid != unused_constants.end(); ++eid) {
+        graph->data->constants.erase(*eid);
+        graph->data->shapes.erase(*eid);
+        topo->DelEdgeById(*eid);
+    }
+
+    if (removed_node_count > 0 || !unused_constants.empty()) {
+        LOG(DEBUG) << "removed [" << removed_node_count << "] dead nodes and [" << unused_constants.size()
+                   << "] unused constants of graph[" << topo->GetName() << "]";
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
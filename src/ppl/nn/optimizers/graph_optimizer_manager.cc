@@ -19,6 +19,9 @@
 #include "ppl/nn/common/logger.h"
 
 #include "ppl/nn/optimizers/constant_node_optimizer.h"
+#include "ppl/nn/optimizers/constant_folding_optimizer.h"
+#include "ppl/nn/optimizers/common_subexpression_elimination_optimizer.h"
+#include "ppl/nn/optimizers/dead_node_elimination_optimizer.h"
 #include "ppl/nn/optimizers/fuse_parallel_node_optimizer.h"
 #include "ppl/nn/optimizers/fuse_bn_optimizer.h"
 
@@ -27,12 +30,15 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn {
 
-#define REGISTER_OPTIMIZER(name, type) name2optimizer_.emplace(name, unique_ptr<GraphOptimizer>(new type()))
+#define REGISTER_OPTIMIZER(name, type) name2optimizer_.emplace_back(name, unique_ptr<GraphOptimizer>(new type()))
 
 GraphOptimizerManager::GraphOptimizerManager() {
     REGISTER_OPTIMIZER("ConstantNodeOptimizer", ConstantNodeOptimizer);
-    REGISTER_OPTIMIZER("FuseParallelNodeOptimizer", FuseParallelNodeOptimizer);
+    REGISTER_OPTIMIZER("ConstantFoldingOptimizer", ConstantFoldingOptimizer);
+    REGISTER_OPTIMIZER("CommonSubexpressionEliminationOptimizer", CommonSubexpressionEliminationOptimizer);
     REGISTER_OPTIMIZER("FuseBNOptimizer", FuseBNOptimizer);
+    REGISTER_OPTIMIZER("FuseParallelNodeOptimizer", FuseParallelNodeOptimizer);
+    REGISTER_OPTIMIZER("DeadNodeEliminationOptimizer", DeadNodeEliminationOptimizer);
 }
 
 RetCode GraphOptimizerManager::Process(ir::Graph* graph) const {
@@ -19,7 +19,9 @@
 #define _ST_HPC_PPL_NN_OPTIMIZERS_GRAPH_OPTIMIZER_MANAGER_H_
 
 #include "ppl/nn/optimizers/graph_optimizer.h"
-#include <map>
+#include <vector>
+#include <memory>
+#include <string>
 
 namespace ppl { namespace nn {
 
@@ -31,7 +33,8 @@ public:
     ppl::common::RetCode Process(ir::Graph*) const;
 
 private:
-    std::map<std::string, std::unique_ptr<GraphOptimizer>> name2optimizer_;
+    // optimizers are applied in the order they are registered
+    std::vector<std::pair<std::string, std::unique_ptr<GraphOptimizer>>> name2optimizer_;
 };
 
 }} // namespace ppl::nn
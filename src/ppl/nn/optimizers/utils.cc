@@ -17,7 +17,7 @@
 
 #include "ppl/nn/optimizers/utils.h"
 #include "ppl/nn/utils/utils.h"
-#include "ppl/nn/optimizers/simple_graph_partitioner.h"
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
 #include "ppl/nn/optimizers/graph_optimizer_manager.h"
 #include "ppl/nn/engines/common/ppl/converter_op.h"
 #include "ppl/nn/ir/partial_graph_topo.h"
@@ -423,7 +423,7 @@ RetCode ProcessGraph(utils::SharedResource* resource, ir::Graph* graph, RuntimeG
 
     vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
 
-    SimpleGraphPartitioner partitioner;
+    CostGraphPartitioner partitioner;
     status = partitioner.Partition(resource, graph, &partitions);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "partitioning graph[" << graph->topo->GetName() << "] failed: " << GetRetCodeStr(status);
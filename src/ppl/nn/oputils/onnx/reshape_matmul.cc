@@ -24,7 +24,8 @@ using namespace ppl::common;
 namespace ppl { namespace nn { namespace oputils {
 
 RetCode ReshapeMatMul(InputOutputInfo* info, const void*) {
-    if (info->GetInputCount() != 2) {
+    // engines may append fused inputs after A and B
+    if (info->GetInputCount() < 2) {
         LOG(ERROR) << "2 input required.";
         return RC_INVALID_VALUE;
     }
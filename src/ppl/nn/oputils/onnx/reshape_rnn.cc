@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/oputils/onnx/reshape_rnn.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+using namespace ppl::common;
+using namespace ppl::nn::common;
+
+namespace ppl { namespace nn { namespace oputils {
+
+RetCode ReshapeRNN(InputOutputInfo* info, const void* arg, int64_t num_gate) {
+    auto param = (const RNNParam*)arg;
+    if (info->GetInputCount() < 3 || info->GetOutputCount() < 1 || info->GetOutputCount() > 3) {
+        LOG(ERROR) << "invalid input count[" << info->GetInputCount() << "] or output count["
+                   << info->GetOutputCount() << "].";
+        return RC_INVALID_VALUE;
+    }
+
+    auto& X = info->GetInput<TensorImpl>(0)->GetShape();
+    auto& W = info->GetInput<TensorImpl>(1)->GetShape();
+    auto& R = info->GetInput<TensorImpl>(2)->GetShape();
+    if (X.GetDimCount() != 3 || W.GetDimCount() != 3 || R.GetDimCount() != 3) {
+        LOG(ERROR) << "X, W and R must be 3d.";
+        return RC_INVALID_VALUE;
+    }
+    if (param->hidden_size <= 0) {
+        LOG(ERROR) << "invalid hidden_size[" << param->hidden_size << "].";
+        return RC_INVALID_VALUE;
+    }
+
+    const int64_t num_direction = param->direction == RNNParam::DIR_BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X.GetDim(0);
+    const int64_t batch = X.GetDim(1);
+    const int64_t hidden_size = param->hidden_size;
+    // W: [num_directions, num_gate * hidden_size, input_size], R: [num_directions, num_gate * hidden_size, hidden_size]
+    if (W.GetDim(0) != num_direction || W.GetDim(1) != num_gate * hidden_size || W.GetDim(2) != X.GetDim(2)) {
+        LOG(ERROR) << "W's shape does not match X and hidden_size.";
+        return RC_INVALID_VALUE;
+    }
+    if (R.GetDim(0) != num_direction || R.GetDim(1) != num_gate * hidden_size || R.GetDim(2) != hidden_size) {
+        LOG(ERROR) << "R's shape does not match hidden_size.";
+        return RC_INVALID_VALUE;
+    }
+
+    // Y: [seq_length, num_directions, batch_size, hidden_size]
+    auto Y = info->GetOutput<TensorImpl>(0);
+    if (Y) {
+        const int64_t dims[] = {seq_len, num_direction, batch, hidden_size};
+        Y->GetShape().Reshape(dims, 4);
+        Y->GetShape().CalcPadding();
+    }
+
+    // Y_h and Y_c: [num_directions, batch_size, hidden_size]
+    for (uint32_t i = 1; i < info->GetOutputCount(); ++i) {
+        auto Y_state = info->GetOutput<TensorImpl>(i);
+        if (Y_state) {
+            const int64_t dims[] = {num_direction, batch, hidden_size};
+            Y_state->GetShape().Reshape(dims, 3);
+            Y_state->GetShape().CalcPadding();
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::oputils
@@ -0,0 +1,32 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPUTILS_ONNX_RESHAPE_RNN_H_
+#define _ST_HPC_PPL_NN_OPUTILS_ONNX_RESHAPE_RNN_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/nn/params/onnx/rnn_param.h"
+#include "ppl/nn/common/input_output_info.h"
+
+namespace ppl { namespace nn { namespace oputils {
+
+// shared by LSTM, GRU and RNN. `num_gate` is 4 for LSTM, 3 for GRU and 1 for RNN.
+ppl::common::RetCode ReshapeRNN(InputOutputInfo*, const void*, int64_t num_gate);
+
+}}} // namespace ppl::nn::oputils
+
+#endif
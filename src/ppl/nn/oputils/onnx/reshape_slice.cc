@@ -56,6 +56,8 @@ RetCode ReshapeSlice(InputOutputInfo* info, const int64_t* starts, const int64_t
             start_val = cur_dim_size;
         if (start_val < 0)
             start_val = cur_dim_size + start_val;
+        if (start_val < 0)
+            start_val = 0;
         if (end_val == LONG_MAX || end_val > cur_dim_size)
             end_val = cur_dim_size;
         if (end_val < 0) {
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_PARAMS_ONNX_RNN_PARAM_H_
+#define _ST_HPC_PPL_NN_PARAMS_ONNX_RNN_PARAM_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ppl { namespace nn { namespace common {
+
+// shared by LSTM, GRU and RNN
+struct RNNParam {
+    typedef enum { DIR_FORWARD = 0, DIR_REVERSE = 1, DIR_BIDIRECTIONAL = 2 } direction_t;
+    typedef enum { ACT_SIGMOID = 0, ACT_TANH = 1, ACT_RELU = 2 } activation_t;
+
+    int32_t direction;
+    int32_t hidden_size;
+    float clip; // no clipping when <= 0
+    std::vector<int32_t> activations; // activation_t, per cell and direction as listed in onnx
+    int32_t input_forget; // LSTM only
+    int32_t linear_before_reset; // GRU only
+
+    bool operator==(const RNNParam& p) const {
+        return this->direction == p.direction && this->hidden_size == p.hidden_size && this->clip == p.clip &&
+            this->activations == p.activations && this->input_forget == p.input_forget &&
+            this->linear_before_reset == p.linear_before_reset;
+    }
+};
+
+}}} // namespace ppl::nn::common
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/ir/graph.h"
 #include "ppl/nn/runtime/kernel_exec_context.h"
+#include "ppl/nn/runtime/runtime_options.h"
 #include <string>
 
 namespace ppl { namespace nn {
@@ -60,6 +61,14 @@ public:
         return device_;
     }
 
+    /**
+       @brief called by the runtime which this kernel belongs to after the kernel is created.
+       kernels running nested graphs, e.g. Loop, create their runtimes with the same options here.
+    */
+    virtual ppl::common::RetCode SetRuntimeOptions(const RuntimeOptions&) {
+        return ppl::common::RC_SUCCESS;
+    }
+
     /**
        @brief evaluate this op.
        @param ctx contexts needed during execution
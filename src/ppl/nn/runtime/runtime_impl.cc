@@ -80,6 +80,12 @@ static RetCode InitRuntimeGraphKernels(const ir::GraphTopo* topo, const RuntimeG
 
         impl->SetDevice(ctx->GetDevice());
         graph->nodeid2kernel[it->op->GetNode()->GetId()].reset(impl);
+
+        auto status = impl->SetRuntimeOptions(options);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "SetRuntimeOptions of kernel[" << impl->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
     }
 
     return RC_SUCCESS;
@@ -385,7 +391,14 @@ RetCode RuntimeImpl::Init(const RuntimeOptions& options, const shared_ptr<ir::Gr
 }
 
 RetCode RuntimeImpl::Run() {
-    return sched_->Run(&profiler_);
+    for (auto it = engctx_.begin(); it != engctx_.end(); ++it) {
+        (*it)->BeforeRun();
+    }
+    auto status = sched_->Run(&profiler_);
+    for (auto it = engctx_.rbegin(); it != engctx_.rend(); ++it) {
+        (*it)->AfterRun();
+    }
+    return status;
 }
 
 RetCode RuntimeImpl::Sync() {
@@ -403,6 +416,52 @@ RetCode RuntimeImpl::Sync() {
     return RC_SUCCESS;
 }
 
+RetCode RuntimeImpl::WarmUp(uint32_t count) {
+    for (uint32_t i = 0; i < GetInputCount(); ++i) {
+        auto input = GetInputTensorImpl(i);
+        const uint64_t bytes = input->GetShape().GetBytesIncludingPadding();
+        if (input->GetBufferPtr() || bytes == 0) {
+            continue;
+        }
+
+        auto status = input->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "ReallocBuffer for input[" << input->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
+        vector<char> zeros(bytes, 0);
+        status = input->CopyFromHost(zeros.data());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "fill input[" << input->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    // warm-up runs are not counted in profiling statistics
+    const bool profiling_flag = conf_.profiling_flag;
+    conf_.profiling_flag = false;
+#endif
+
+    RetCode status = RC_SUCCESS;
+    for (uint32_t i = 0; i < count && status == RC_SUCCESS; ++i) {
+        status = Run();
+        if (status == RC_SUCCESS) {
+            status = Sync();
+        }
+    }
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    conf_.profiling_flag = profiling_flag;
+#endif
+
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "warm-up run failed: " << GetRetCodeStr(status);
+    }
+    return status;
+}
+
 RetCode RuntimeImpl::GetProfilingStatistics(ProfilingStatistics* stat) const {
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
     return profiler_.GetProfilingStatistics(stat);
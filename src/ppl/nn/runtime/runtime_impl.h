@@ -77,6 +77,7 @@ public:
 
     ppl::common::RetCode Run() override;
     ppl::common::RetCode Sync() override;
+    ppl::common::RetCode WarmUp(uint32_t count) override;
 
     ppl::common::RetCode GetProfilingStatistics(ProfilingStatistics* stat) const override;
 
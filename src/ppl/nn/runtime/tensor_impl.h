@@ -68,8 +68,19 @@ public:
        @note this tensor will inherits the ownership of `another`.
     */
     void TransferBufferFrom(TensorImpl* another) {
-        buffer_info_.SetBuffer(another->GetBufferDesc(), another->GetDevice(), another->IsBufferOwner());
-        another->DetachBuffer();
+        buffer_info_.TransferBufferFrom(&another->buffer_info_);
+    }
+
+    bool CanShareBuffer() const {
+        return buffer_info_.CanShareBuffer();
+    }
+
+    /**
+       @brief makes this tensor a view of `another`'s buffer starting at `offset` bytes.
+       @note the buffer is freed after `another` and all of its views are released.
+    */
+    ppl::common::RetCode ShareBufferFrom(TensorImpl* another, uint64_t offset = 0) {
+        return buffer_info_.ShareBufferFrom(&another->buffer_info_, offset);
     }
 
     BufferDesc DetachBuffer() {
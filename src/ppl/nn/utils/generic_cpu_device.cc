@@ -24,7 +24,7 @@ namespace ppl { namespace nn { namespace utils {
 
 RetCode GenericCpuDevice::Realloc(uint64_t bytes, BufferDesc* buffer) {
     if (buffer->addr) {
-        allocator_.Free(buffer->addr);
+        allocator_->Free(buffer->addr);
     }
 
     if (bytes == 0) {
@@ -32,7 +32,7 @@ RetCode GenericCpuDevice::Realloc(uint64_t bytes, BufferDesc* buffer) {
         return RC_SUCCESS;
     }
 
-    buffer->addr = allocator_.Alloc(bytes);
+    buffer->addr = allocator_->Alloc(bytes);
     if (!buffer->addr) {
         return RC_OUT_OF_MEMORY;
     }
@@ -47,7 +47,7 @@ RetCode GenericCpuDevice::Realloc(const TensorShape& shape, BufferDesc* buffer)
 
 void GenericCpuDevice::Free(BufferDesc* buffer) {
     if (buffer->addr) {
-        allocator_.Free(buffer->addr);
+        allocator_->Free(buffer->addr);
         buffer->addr = nullptr;
     }
 }
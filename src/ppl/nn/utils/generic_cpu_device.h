@@ -26,12 +26,12 @@ namespace ppl { namespace nn { namespace utils {
 
 class GenericCpuDevice : public Device {
 public:
-    GenericCpuDevice(uint64_t alignment = 64) : allocator_(alignment) {}
+    GenericCpuDevice(uint64_t alignment = 64) : default_allocator_(alignment), allocator_(&default_allocator_) {}
     virtual ~GenericCpuDevice() {}
 
     /** @brief get the underlying allocator used to allocate/free memories */
     ppl::common::Allocator* GetAllocator() const {
-        return &allocator_;
+        return allocator_;
     }
 
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc*) override;
@@ -50,8 +50,18 @@ public:
         return &data_converter_;
     }
 
+protected:
+    /**
+       @brief replaces the underlying allocator, or restores the default one if `allocator` is nullptr.
+       @note MUST be called before any buffer is allocated. `allocator` is not owned by this device.
+    */
+    void SetAllocator(ppl::common::Allocator* allocator) {
+        allocator_ = allocator ? allocator : &default_allocator_;
+    }
+
 private:
-    mutable ppl::common::GenericCpuAllocator allocator_;
+    mutable ppl::common::GenericCpuAllocator default_allocator_;
+    ppl::common::Allocator* allocator_;
     GenericCpuDataConverter data_converter_;
 };
 
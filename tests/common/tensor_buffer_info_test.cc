@@ -52,3 +52,45 @@ TEST(TensorBufferInfoTest, setbuffer) {
     EXPECT_EQ(nullptr, info.GetBufferPtr());
     device.Free(&buf);
 }
+
+TEST(TensorBufferInfoTest, sharebuffer) {
+    utils::GenericCpuDevice device;
+    auto parent = GenRandomTensorBufferInfo(&device);
+    auto base = parent.GetBufferPtr<char>();
+    EXPECT_TRUE(parent.CanShareBuffer());
+
+    TensorBufferInfo view0, view1;
+    EXPECT_EQ(RC_SUCCESS, view0.ShareBufferFrom(&parent, 0));
+    EXPECT_EQ(RC_SUCCESS, view1.ShareBufferFrom(&parent, 64));
+    EXPECT_EQ(base, view0.GetBufferPtr<char>());
+    EXPECT_EQ(base + 64, view1.GetBufferPtr<char>());
+    EXPECT_FALSE(parent.IsBufferOwner());
+    EXPECT_FALSE(view0.IsBufferOwner());
+
+    // the shared buffer is still alive after the parent is released
+    parent.FreeBuffer();
+    EXPECT_FALSE(parent.CanShareBuffer());
+    EXPECT_TRUE(view1.CanShareBuffer());
+
+    TensorBufferInfo view2;
+    view2.TransferBufferFrom(&view1);
+    EXPECT_EQ(base + 64, view2.GetBufferPtr<char>());
+    EXPECT_EQ(nullptr, view1.GetBufferPtr());
+    EXPECT_TRUE(view2.CanShareBuffer());
+
+    view0.FreeBuffer();
+    view2.FreeBuffer();
+}
+
+TEST(TensorBufferInfoTest, sharebuffer_not_owner) {
+    utils::GenericCpuDevice device;
+    BufferDesc buffer;
+    device.Realloc(1000, &buffer);
+
+    TensorBufferInfo parent, view;
+    parent.SetBuffer(buffer, &device, false);
+    EXPECT_FALSE(parent.CanShareBuffer());
+    EXPECT_NE(RC_SUCCESS, view.ShareBufferFrom(&parent, 0));
+
+    device.Free(&buffer);
+}
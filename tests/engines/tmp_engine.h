@@ -83,4 +83,40 @@ private:
     utils::GenericCpuDevice device_;
 };
 
+// runs every op, used to test partitioning between engines with overlapping ops.
+// estimates every op as `op_cost` if it is positive.
+class TmpEngineAny final : public EngineImpl {
+public:
+    TmpEngineAny(const std::string& name = "tmpAny", double op_cost = 0) : EngineImpl(name), op_cost_(op_cost) {}
+    ppl::common::RetCode Configure(uint32_t, ...) override {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    EngineContext* CreateEngineContext(const std::string&, const EngineContextOptions&) override {
+        return new TmpEngineContext(GetName());
+    }
+    bool CanRunOp(const ir::Node*) const override {
+        return true;
+    }
+    ppl::common::RetCode EstimateOpCost(const ir::Graph*, const ir::Node*, const std::vector<const ir::Shape*>&,
+                                        double* cost) const override {
+        if (op_cost_ <= 0) {
+            return ppl::common::RC_UNSUPPORTED;
+        }
+        *cost = op_cost_;
+        return ppl::common::RC_SUCCESS;
+    }
+    ppl::common::RetCode ProcessGraph(utils::SharedResource*, ir::Graph* graph, RuntimePartitionInfo* info) override {
+        auto topo = graph->topo.get();
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            info->kernels.emplace(node->GetId(), std::unique_ptr<OptKernel>(new TmpOptKernelOne(node)));
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
+private:
+    double op_cost_;
+    utils::GenericCpuDevice device_;
+};
+
 }}} // namespace ppl::nn::test
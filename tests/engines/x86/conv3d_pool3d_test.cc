@@ -0,0 +1,420 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/conv3d.h"
+#include "ppl/kernel/x86/fp32/maxpool3d.h"
+#include "ppl/kernel/x86/fp32/averagepool3d.h"
+#include "ppl/kernel/x86/fp32/reorder.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "ppl/nn/params/onnx/pooling_param.h"
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static TensorShape MakeShape(const vector<int64_t>& dims, dataformat_t format) {
+    TensorShape shape;
+    shape.SetDataType(DATATYPE_FLOAT32);
+    shape.SetDataFormat(format);
+    shape.Reshape(dims);
+    return shape;
+}
+
+static vector<float> ToN16CX(const vector<float>& src, const vector<int64_t>& dims) {
+    auto ndarray_shape = MakeShape(dims, DATAFORMAT_NDARRAY);
+    auto n16cx_shape = MakeShape(dims, DATAFORMAT_N16CX);
+    vector<float> dst(n16cx_shape.GetElementsIncludingPadding(), 0.0f);
+    EXPECT_EQ(RC_SUCCESS, reorder_ndarray_n16cx_fp32(&ndarray_shape, src.data(), dst.data()));
+    return dst;
+}
+
+static vector<float> FromN16CX(const vector<float>& src, const vector<int64_t>& dims) {
+    auto n16cx_shape = MakeShape(dims, DATAFORMAT_N16CX);
+    vector<float> dst(MakeShape(dims, DATAFORMAT_NDARRAY).GetElementsExcludingPadding());
+    EXPECT_EQ(RC_SUCCESS, reorder_n16cx_ndarray_fp32(&n16cx_shape, src.data(), dst.data()));
+    return dst;
+}
+
+static void ExpectNear(const vector<float>& ref, const vector<float>& out, float eps, const string& tag) {
+    ASSERT_EQ(ref.size(), out.size()) << tag;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_NEAR(ref[i], out[i], eps * max(1.0f, fabsf(ref[i]))) << tag << " at " << i;
+    }
+}
+
+/* --------------------------------- conv3d --------------------------------- */
+
+struct Conv3DCase {
+    int64_t batch, channels, num_output, group;
+    vector<int64_t> src_spatial, kernel, strides, pads, dilations;
+    conv_fuse_flag_t fuse_flag;
+};
+
+static void RunConv3DCase(const Conv3DCase& c, isa_t isa) {
+    RefConvParam ref_param;
+    ref_param.kernel = c.kernel;
+    ref_param.strides = c.strides;
+    ref_param.pads = c.pads;
+    ref_param.dilations = c.dilations;
+    ref_param.group = c.group;
+
+    vector<int64_t> src_dims = {c.batch, c.channels};
+    src_dims.insert(src_dims.end(), c.src_spatial.begin(), c.src_spatial.end());
+    auto dst_dims = RefConvOutputDims(src_dims, c.num_output, ref_param);
+    const int64_t dst_count = MakeShape(dst_dims, DATAFORMAT_NDARRAY).GetElementsExcludingPadding();
+    const int64_t src_count = MakeShape(src_dims, DATAFORMAT_NDARRAY).GetElementsExcludingPadding();
+
+    auto src = GenTestData(src_count, 1);
+    auto filter = GenTestData(c.num_output * c.channels / c.group * c.kernel[0] * c.kernel[1] * c.kernel[2], 2);
+    auto bias = GenTestData(c.num_output, 3);
+    auto sum_src = GenTestData(dst_count, 4);
+
+    auto ref = RefConv(src, src_dims, filter, bias, c.num_output, ref_param);
+    for (int64_t i = 0; i < dst_count; ++i) {
+        if (c.fuse_flag & conv_fuse_flag::sum) {
+            ref[i] += sum_src[i];
+        }
+        if (c.fuse_flag & (conv_fuse_flag::relu | conv_fuse_flag::relu6)) {
+            ref[i] = max(ref[i], 0.0f);
+        }
+        if (c.fuse_flag & conv_fuse_flag::relu6) {
+            ref[i] = min(ref[i], 6.0f);
+        }
+    }
+
+    conv3d_fp32_param param;
+    param.kernel_d = c.kernel[0];
+    param.kernel_h = c.kernel[1];
+    param.kernel_w = c.kernel[2];
+    param.stride_d = c.strides[0];
+    param.stride_h = c.strides[1];
+    param.stride_w = c.strides[2];
+    param.dilation_d = c.dilations[0];
+    param.dilation_h = c.dilations[1];
+    param.dilation_w = c.dilations[2];
+    param.pad_d = c.pads[0];
+    param.pad_h = c.pads[1];
+    param.pad_w = c.pads[2];
+    param.channels = c.channels;
+    param.num_output = c.num_output;
+    param.group = c.group;
+    param.fuse_flag = c.fuse_flag;
+
+    GenericCpuAllocator allocator(64);
+    auto algo_info = conv3d_algo_selector::select_algo(DATAFORMAT_N16CX, param, isa);
+    ASSERT_TRUE(algo_info.algo_type != conv3d_fp32_algo::unknown);
+    unique_ptr<conv3d_fp32_manager> mgr(conv3d_algo_selector::gen_algo(param, algo_info, &allocator));
+    ASSERT_NE(nullptr, mgr.get());
+    ASSERT_TRUE(mgr->is_supported());
+    ASSERT_TRUE(mgr->is_fuse_supported(c.fuse_flag));
+    ASSERT_EQ(RC_SUCCESS, mgr->gen_cvt_weights(filter.data(), bias.data()));
+
+    auto src_shape = MakeShape(src_dims, DATAFORMAT_N16CX);
+    auto dst_shape = MakeShape(dst_dims, DATAFORMAT_N16CX);
+    auto src16 = ToN16CX(src, src_dims);
+    auto sum_src16 = ToN16CX(sum_src, dst_dims);
+    vector<float> dst16(dst_shape.GetElementsIncludingPadding(), 0.0f);
+
+    unique_ptr<conv3d_fp32_executor> exe(mgr->gen_executor());
+    exe->set_src_shape(&src_shape);
+    exe->set_src(src16.data());
+    exe->set_dst_shape(&dst_shape);
+    exe->set_dst(dst16.data());
+    exe->set_sum_src_shape(&dst_shape);
+    exe->set_sum_src(sum_src16.data());
+    ASSERT_EQ(RC_SUCCESS, exe->prepare());
+    vector<char> temp_buffer(exe->cal_temp_buffer_size() + 64);
+    exe->set_temp_buffer(temp_buffer.data());
+    ASSERT_EQ(RC_SUCCESS, exe->execute());
+    mgr->release_cvt_weights();
+
+    ExpectNear(ref, FromN16CX(dst16, dst_dims), 1e-4f,
+               "algo " + to_string(algo_info.algo_type) + " isa " + to_string(algo_info.isa));
+}
+
+static vector<isa_t> TestedISAs() {
+    vector<isa_t> isas = {ISA_X86_FMA};
+    if (GetCpuISA() & ISA_X86_AVX512) {
+        isas.push_back(ISA_X86_AVX512);
+    }
+    return isas;
+}
+
+static const conv_fuse_flag_t kRelu = conv_fuse_flag::relu;
+static const conv_fuse_flag_t kRelu6 = conv_fuse_flag::relu6;
+static const conv_fuse_flag_t kSum = conv_fuse_flag::sum;
+
+TEST(Conv3DKernelTest, direct_matches_reference) {
+    const vector<Conv3DCase> cases = {
+        {1, 16, 32, 1, {5, 7, 9}, {3, 3, 3}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, 0},
+        {2, 20, 37, 1, {6, 8, 10}, {3, 3, 3}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, kSum | kRelu},
+        {1, 64, 48, 1, {4, 9, 17}, {3, 3, 3}, {2, 2, 2}, {1, 1, 1}, {1, 1, 1}, kRelu6},
+        {1, 32, 32, 2, {5, 6, 7}, {2, 3, 3}, {1, 2, 1}, {0, 1, 1}, {1, 1, 1}, kSum},
+        {1, 16, 16, 1, {3, 8, 8}, {3, 3, 3}, {1, 1, 1}, {2, 1, 1}, {2, 1, 2}, 0},
+        // some output depths only see padding
+        {1, 16, 16, 1, {2, 5, 5}, {3, 1, 1}, {1, 1, 1}, {2, 0, 0}, {1, 1, 1}, kRelu},
+    };
+    for (auto isa : TestedISAs()) {
+        for (auto& c : cases) {
+            RunConv3DCase(c, isa);
+        }
+    }
+}
+
+TEST(Conv3DKernelTest, gemm_direct_matches_reference) {
+    const vector<Conv3DCase> cases = {
+        {2, 32, 48, 1, {3, 5, 7}, {1, 1, 1}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, kSum | kRelu},
+        {1, 64, 64, 2, {4, 6, 6}, {1, 1, 1}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, kRelu6},
+        {1, 300, 40, 1, {3, 5, 6}, {1, 1, 1}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, 0},
+    };
+    for (auto isa : TestedISAs()) {
+        for (auto& c : cases) {
+            RunConv3DCase(c, isa);
+        }
+    }
+}
+
+/* --------------------------------- pool3d --------------------------------- */
+
+struct Pool3DCase {
+    int64_t batch, channels;
+    vector<int64_t> src_spatial, kernel, strides, pads;
+};
+
+// onnx semantic, pooling_mode is one of PoolingParam::pooling_mode_t
+static vector<float> RefPool3D(const vector<float>& src, const Pool3DCase& c, int32_t pooling_mode, int32_t ceil_mode,
+                               vector<int64_t>* dst_dims) {
+    *dst_dims = {c.batch, c.channels};
+    for (int i = 0; i < 3; ++i) {
+        const double len = double(c.src_spatial[i] + 2 * c.pads[i] - c.kernel[i]) / c.strides[i];
+        dst_dims->push_back(int64_t(ceil_mode ? ceil(len) : floor(len)) + 1);
+    }
+    const int64_t od = (*dst_dims)[2], oh = (*dst_dims)[3], ow = (*dst_dims)[4];
+    const int64_t id = c.src_spatial[0], ih = c.src_spatial[1], iw = c.src_spatial[2];
+    vector<float> dst(c.batch * c.channels * od * oh * ow);
+    for (int64_t bc = 0; bc < c.batch * c.channels; ++bc) {
+        for (int64_t d = 0; d < od; ++d) {
+            for (int64_t h = 0; h < oh; ++h) {
+                for (int64_t w = 0; w < ow; ++w) {
+                    const int64_t pos[3] = {d, h, w};
+                    const int64_t in_len[3] = {id, ih, iw};
+                    int64_t start[3], end[3], pad_len = 1;
+                    for (int i = 0; i < 3; ++i) {
+                        const int64_t s = pos[i] * c.strides[i] - c.pads[i];
+                        const int64_t e = ceil_mode ? s + c.kernel[i] : min(s + c.kernel[i], in_len[i] + c.pads[i]);
+                        pad_len *= e - s;
+                        start[i] = max<int64_t>(s, 0);
+                        end[i] = min(e, in_len[i]);
+                    }
+                    float max_val = -FLT_MAX, sum = 0.0f;
+                    int64_t count = 0;
+                    for (int64_t a = start[0]; a < end[0]; ++a) {
+                        for (int64_t b = start[1]; b < end[1]; ++b) {
+                            for (int64_t e = start[2]; e < end[2]; ++e) {
+                                const float v = src[((bc * id + a) * ih + b) * iw + e];
+                                max_val = max(max_val, v);
+                                sum += v;
+                                ++count;
+                            }
+                        }
+                    }
+                    float out;
+                    if (pooling_mode == common::PoolingParam::POOLING_MAX) {
+                        out = count ? max_val : 0.0f;
+                    } else if (pooling_mode == common::PoolingParam::POOLING_AVERAGE_EXCLUDE) {
+                        out = count ? sum / count : 0.0f;
+                    } else {
+                        out = pad_len > 0 ? sum / pad_len : 0.0f;
+                    }
+                    dst[((bc * od + d) * oh + h) * ow + w] = out;
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+static void RunPool3DCase(const Pool3DCase& c, int32_t pooling_mode, int32_t ceil_mode) {
+    vector<int64_t> src_dims = {c.batch, c.channels, c.src_spatial[0], c.src_spatial[1], c.src_spatial[2]};
+    auto src = GenTestData(MakeShape(src_dims, DATAFORMAT_NDARRAY).GetElementsExcludingPadding(), 7);
+    vector<int64_t> dst_dims;
+    auto ref = RefPool3D(src, c, pooling_mode, ceil_mode, &dst_dims);
+
+    const bool is_max = pooling_mode == common::PoolingParam::POOLING_MAX;
+    const string tag = "mode " + to_string(pooling_mode) + " ceil " + to_string(ceil_mode);
+
+    {
+        auto src_shape = MakeShape(src_dims, DATAFORMAT_NDARRAY);
+        auto dst_shape = MakeShape(dst_dims, DATAFORMAT_NDARRAY);
+        vector<float> dst(ref.size());
+        auto rc = is_max ? maxpool3d_ncdhw_normal_fp32(&src_shape, &dst_shape, src.data(), c.kernel[0], c.kernel[1],
+                                                       c.kernel[2], c.strides[0], c.strides[1], c.strides[2],
+                                                       c.pads[0], c.pads[1], c.pads[2], dst.data())
+                         : averagepool3d_ncdhw_normal_fp32(&src_shape, &dst_shape, src.data(), c.kernel[0],
+                                                           c.kernel[1], c.kernel[2], c.strides[0], c.strides[1],
+                                                           c.strides[2], c.pads[0], c.pads[1], c.pads[2],
+                                                           pooling_mode, ceil_mode, dst.data());
+        ASSERT_EQ(RC_SUCCESS, rc);
+        ExpectNear(ref, dst, 1e-5f, "ndarray " + tag);
+    }
+
+    auto src_shape = MakeShape(src_dims, DATAFORMAT_N16CX);
+    auto dst_shape = MakeShape(dst_dims, DATAFORMAT_N16CX);
+    auto src16 = ToN16CX(src, src_dims);
+    for (int avx512 = 0; avx512 < 2; ++avx512) {
+        if (avx512 && !(GetCpuISA() & ISA_X86_AVX512)) {
+            continue;
+        }
+        vector<float> dst16(dst_shape.GetElementsIncludingPadding(), 0.0f);
+        RetCode rc;
+        if (is_max) {
+            auto func = avx512 ? maxpool3d_n16cdhw_blk1x16_fp32_avx512 : maxpool3d_n16cdhw_blk1x8_fp32_avx;
+            rc = func(&src_shape, &dst_shape, src16.data(), c.kernel[0], c.kernel[1], c.kernel[2], c.strides[0],
+                      c.strides[1], c.strides[2], c.pads[0], c.pads[1], c.pads[2], dst16.data());
+        } else {
+            auto func = avx512 ? averagepool3d_n16cdhw_blk1x16_fp32_avx512 : averagepool3d_n16cdhw_blk1x8_fp32_avx;
+            rc = func(&src_shape, &dst_shape, src16.data(), c.kernel[0], c.kernel[1], c.kernel[2], c.strides[0],
+                      c.strides[1], c.strides[2], c.pads[0], c.pads[1], c.pads[2], pooling_mode, ceil_mode,
+                      dst16.data());
+        }
+        ASSERT_EQ(RC_SUCCESS, rc);
+        ExpectNear(ref, FromN16CX(dst16, dst_dims), 1e-5f, (avx512 ? "avx512 " : "avx ") + tag);
+    }
+}
+
+TEST(Pool3DKernelTest, matches_reference) {
+    const vector<Pool3DCase> cases = {
+        {1, 20, {6, 9, 21}, {2, 2, 2}, {2, 2, 2}, {0, 0, 0}},
+        {2, 16, {7, 8, 19}, {3, 3, 3}, {1, 1, 1}, {1, 1, 1}},
+        {1, 32, {5, 7, 9}, {3, 3, 3}, {2, 2, 2}, {1, 1, 1}},
+        {1, 16, {4, 3, 3}, {3, 3, 3}, {3, 3, 3}, {1, 1, 1}},
+    };
+    for (auto& c : cases) {
+        RunPool3DCase(c, common::PoolingParam::POOLING_MAX, 0);
+        for (int32_t ceil_mode = 0; ceil_mode < 2; ++ceil_mode) {
+            RunPool3DCase(c, common::PoolingParam::POOLING_AVERAGE_EXCLUDE, ceil_mode);
+            RunPool3DCase(c, common::PoolingParam::POOLING_AVERAGE_INCLUDE, ceil_mode);
+        }
+    }
+}
+
+/* ------------------------------- graph fusion ------------------------------ */
+
+// conv3d -> add -> relu becomes one conv3d with sum and relu fused by ConvOp::SetFuseConv3D.
+// the summand comes from another conv3d so both add inputs are blocked and no reorder splits the pair
+TEST(Conv3DFusionTest, sum_and_relu_fused) {
+    const int64_t ic = 16, oc = 24;
+    const vector<int64_t> x_dims = {1, ic, 4, 6, 7};
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("conv", ir::Node::Type("", "Conv"), {"x", "w", "b"}, {"c"});
+    builder->AddNode("conv_z", ir::Node::Type("", "Conv"), {"x", "wz"}, {"z"});
+    builder->AddNode("add", ir::Node::Type("", "Add"), {"c", "z"}, {"s"});
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"s"}, {"y"});
+
+    auto param = make_shared<common::ConvolutionParam>();
+    param->kernel_shape = {3, 3, 3};
+    param->dilations = {1, 1, 1};
+    param->strides = {1, 1, 1};
+    param->pads = {1, 1, 1, 1, 1, 1};
+    param->group = 1;
+    runner.SetParam("conv", param);
+    auto param_z = make_shared<common::ConvolutionParam>(*param);
+    param_z->kernel_shape = {1, 1, 1};
+    param_z->pads = {0, 0, 0, 0, 0, 0};
+    runner.SetParam("conv_z", param_z);
+
+    auto w = GenTestData(oc * ic * 27, 1);
+    auto b = GenTestData(oc, 2);
+    auto wz = GenTestData(oc * ic, 3);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+    runner.SetConstant("w", DATATYPE_FLOAT32, {oc, ic, 3, 3, 3}, w);
+    runner.SetConstant("b", DATATYPE_FLOAT32, {oc}, b);
+    runner.SetConstant("wz", DATATYPE_FLOAT32, {oc, ic, 1, 1, 1}, wz);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(2, runner.CountNodes("Conv"));
+    EXPECT_EQ(0, runner.CountNodes("Add"));
+    EXPECT_EQ(0, runner.CountNodes("Relu"));
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(ic * 4 * 6 * 7, 4);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+
+    RefConvParam ref_param;
+    ref_param.kernel = {3, 3, 3};
+    ref_param.strides = {1, 1, 1};
+    ref_param.pads = {1, 1, 1};
+    ref_param.dilations = {1, 1, 1};
+    auto ref = RefConv(x, x_dims, w, b, oc, ref_param);
+    ref_param.kernel = {1, 1, 1};
+    ref_param.pads = {0, 0, 0};
+    auto z = RefConv(x, x_dims, wz, {}, oc, ref_param);
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ref[i] = max(ref[i] + z[i], 0.0f);
+    }
+    ExpectNear(ref, y, 1e-4f, "fused conv3d");
+}
+
+// relu in front of add forbids fusing the sum into conv, conv_z may still take it
+TEST(Conv3DFusionTest, sum_not_fused_behind_relu) {
+    const int64_t ic = 16, oc = 16;
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("conv", ir::Node::Type("", "Conv"), {"x", "w"}, {"c"});
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"c"}, {"r"});
+    builder->AddNode("conv_z", ir::Node::Type("", "Conv"), {"x", "wz"}, {"z"});
+    builder->AddNode("add", ir::Node::Type("", "Add"), {"r", "z"}, {"y"});
+
+    auto param = make_shared<common::ConvolutionParam>();
+    param->kernel_shape = {1, 1, 1};
+    param->dilations = {1, 1, 1};
+    param->strides = {1, 1, 1};
+    param->pads = {0, 0, 0, 0, 0, 0};
+    param->group = 1;
+    runner.SetParam("conv", param);
+    runner.SetParam("conv_z", make_shared<common::ConvolutionParam>(*param));
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {1, ic, 2, 3, 4});
+    runner.SetConstant("w", DATATYPE_FLOAT32, {oc, ic, 1, 1, 1}, GenTestData(oc * ic, 1));
+    runner.SetConstant("wz", DATATYPE_FLOAT32, {oc, ic, 1, 1, 1}, GenTestData(oc * ic, 2));
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(0, runner.CountNodes("Relu"));
+    EXPECT_EQ(0, runner.CountNodes("Add"));
+    auto topo = runner.GetGraphBuilder()->GetGraph()->topo.get();
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (node->GetName() == "conv") {
+            EXPECT_EQ(2, node->GetInputCount());
+        } else if (node->GetName() == "conv_z") {
+            EXPECT_EQ(3, node->GetInputCount()); // summand appended as the last input
+        }
+    }
+}
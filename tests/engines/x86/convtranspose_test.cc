@@ -0,0 +1,167 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/convtranspose_param.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <math.h>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+struct ConvTransposeCase {
+    int64_t batch, channels, num_output, src_h, src_w;
+    int32_t kernel_h, kernel_w, stride_h, stride_w, pad_h, pad_w, dilation_h, dilation_w;
+    bool with_bias;
+};
+
+static vector<float> RefConvTranspose(const ConvTransposeCase& c, const vector<float>& src, const vector<float>& filter,
+                                      const vector<float>& bias, vector<int64_t>* dst_dims) {
+    const int64_t dst_h = (c.src_h - 1) * c.stride_h + (c.kernel_h - 1) * c.dilation_h + 1 - 2 * c.pad_h;
+    const int64_t dst_w = (c.src_w - 1) * c.stride_w + (c.kernel_w - 1) * c.dilation_w + 1 - 2 * c.pad_w;
+    *dst_dims = {c.batch, c.num_output, dst_h, dst_w};
+    vector<float> dst(c.batch * c.num_output * dst_h * dst_w, 0.0f);
+    for (int64_t b = 0; b < c.batch; ++b) {
+        for (int64_t oc = 0; oc < c.num_output; ++oc) {
+            for (int64_t i = 0; i < dst_h * dst_w; ++i) {
+                dst[(b * c.num_output + oc) * dst_h * dst_w + i] = c.with_bias ? bias[oc] : 0.0f;
+            }
+        }
+        for (int64_t ic = 0; ic < c.channels; ++ic) {
+            for (int64_t ih = 0; ih < c.src_h; ++ih) {
+                for (int64_t iw = 0; iw < c.src_w; ++iw) {
+                    const float v = src[((b * c.channels + ic) * c.src_h + ih) * c.src_w + iw];
+                    for (int64_t oc = 0; oc < c.num_output; ++oc) {
+                        for (int64_t kh = 0; kh < c.kernel_h; ++kh) {
+                            for (int64_t kw = 0; kw < c.kernel_w; ++kw) {
+                                const int64_t oh = ih * c.stride_h - c.pad_h + kh * c.dilation_h;
+                                const int64_t ow = iw * c.stride_w - c.pad_w + kw * c.dilation_w;
+                                if (oh < 0 || oh >= dst_h || ow < 0 || ow >= dst_w) {
+                                    continue;
+                                }
+                                dst[((b * c.num_output + oc) * dst_h + oh) * dst_w + ow] +=
+                                    v * filter[((ic * c.num_output + oc) * c.kernel_h + kh) * c.kernel_w + kw];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+/*
+    a constant weight makes ConvTransposeOp pack the filter and run DoExecuteN16CX,
+    a weight fed at runtime leaves it on the ndarray kernel.
+*/
+static void RunConvTranspose(const ConvTransposeCase& c, bool const_weight, bool with_relu, const vector<float>& src,
+                             const vector<float>& filter, const vector<float>& bias, vector<float>* dst,
+                             dataformat_t* conv_output_format) {
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    vector<string> inputs = {"x", "w"};
+    if (c.with_bias) {
+        inputs.push_back("b");
+    }
+    const string y_name = with_relu ? "c" : "y";
+    builder->AddNode("deconv", ir::Node::Type("", "ConvTranspose"), inputs, {y_name});
+    if (with_relu) {
+        builder->AddNode("relu", ir::Node::Type("", "Relu"), {"c"}, {"y"});
+    }
+
+    auto param = make_shared<common::ConvTransposeParam>();
+    param->group = 1;
+    param->kernel_shape = {c.kernel_h, c.kernel_w};
+    param->strides = {c.stride_h, c.stride_w};
+    param->pads = {c.pad_h, c.pad_w, c.pad_h, c.pad_w};
+    param->dilations = {c.dilation_h, c.dilation_w};
+    runner.SetParam("deconv", param);
+
+    const vector<int64_t> x_dims = {c.batch, c.channels, c.src_h, c.src_w};
+    const vector<int64_t> w_dims = {c.channels, c.num_output, c.kernel_h, c.kernel_w};
+    runner.SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+    if (const_weight) {
+        runner.SetConstant("w", DATATYPE_FLOAT32, w_dims, filter);
+    } else {
+        runner.SetInputShape("w", DATATYPE_FLOAT32, w_dims);
+    }
+    if (c.with_bias) {
+        runner.SetConstant("b", DATATYPE_FLOAT32, {c.num_output}, bias);
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+    if (with_relu && const_weight) {
+        EXPECT_EQ(0, runner.CountNodes("Relu")); // only the n16cx kernel fuses activations
+    }
+
+    *conv_output_format = runner.GetOutputFormat("deconv");
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, src));
+    if (!const_weight) {
+        ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "w", w_dims, filter));
+    }
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", dst));
+}
+
+class ConvTransposeTest : public testing::TestWithParam<ConvTransposeCase> {};
+
+TEST_P(ConvTransposeTest, n16cx_and_ndarray_match) {
+    const auto& c = GetParam();
+    auto src = GenTestData(c.batch * c.channels * c.src_h * c.src_w, 1);
+    auto filter = GenTestData(c.channels * c.num_output * c.kernel_h * c.kernel_w, 2);
+    auto bias = GenTestData(c.num_output, 3);
+    vector<int64_t> dst_dims;
+    auto ref = RefConvTranspose(c, src, filter, bias, &dst_dims);
+
+    for (bool with_relu : {false, true}) {
+        auto expected = ref;
+        if (with_relu) {
+            for (auto& v : expected) {
+                v = max(v, 0.0f);
+            }
+        }
+
+        vector<float> n16cx_dst, ndarray_dst;
+        dataformat_t n16cx_format = DATAFORMAT_UNKNOWN, ndarray_format = DATAFORMAT_UNKNOWN;
+        RunConvTranspose(c, true, with_relu, src, filter, bias, &n16cx_dst, &n16cx_format);
+        RunConvTranspose(c, false, with_relu, src, filter, bias, &ndarray_dst, &ndarray_format);
+        EXPECT_EQ(DATAFORMAT_N16CX, n16cx_format);
+        EXPECT_EQ(DATAFORMAT_NDARRAY, ndarray_format);
+
+        ASSERT_EQ(expected.size(), n16cx_dst.size());
+        ASSERT_EQ(expected.size(), ndarray_dst.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const float eps = 1e-4f * max(1.0f, fabsf(expected[i]));
+            ASSERT_NEAR(expected[i], n16cx_dst[i], eps) << "n16cx relu " << with_relu << " at " << i;
+            ASSERT_NEAR(expected[i], ndarray_dst[i], eps) << "ndarray relu " << with_relu << " at " << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Cases, ConvTransposeTest,
+    testing::Values(ConvTransposeCase{1, 16, 16, 5, 6, 3, 3, 1, 1, 1, 1, 1, 1, true},
+                    ConvTransposeCase{2, 20, 37, 7, 9, 4, 4, 2, 2, 1, 1, 1, 1, true},
+                    ConvTransposeCase{1, 64, 21, 8, 31, 2, 2, 2, 2, 0, 0, 1, 1, false},
+                    ConvTransposeCase{1, 33, 40, 6, 5, 3, 3, 2, 2, 1, 1, 2, 2, true},
+                    ConvTransposeCase{1, 17, 19, 3, 40, 5, 5, 1, 3, 2, 0, 1, 1, true}));
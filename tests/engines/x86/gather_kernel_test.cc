@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/gather.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class GatherKernelTest : public testing::TestWithParam<int64_t> {};
+
+// every output row copies inner_dim elements, rows of one thread may cross outer boundaries
+TEST_P(GatherKernelTest, matches_reference) {
+    const int64_t inner_dim = GetParam();
+    const int64_t outer_dim = 97, gather_dim = 13, num_indices = 64, indices_dim = 3;
+    const int64_t rows_per_outer = num_indices * indices_dim;
+
+    auto src = GenTestData(outer_dim * gather_dim * inner_dim, 1, 251, -125, 1.0f);
+    vector<int64_t> indices(rows_per_outer);
+    for (int64_t i = 0; i < rows_per_outer; ++i) {
+        indices[i] = (i * 7 + 3) % gather_dim;
+    }
+
+    vector<float> ref(outer_dim * rows_per_outer * inner_dim);
+    for (int64_t o = 0; o < outer_dim; ++o) {
+        for (int64_t r = 0; r < rows_per_outer; ++r) {
+            for (int64_t i = 0; i < inner_dim; ++i) {
+                ref[(o * rows_per_outer + r) * inner_dim + i] = src[(o * gather_dim + indices[r]) * inner_dim + i];
+            }
+        }
+    }
+
+    for (int32_t num_threads : {1, 4}) {
+        auto prev_num_threads = ppl::kernel::x86::set_omp_num_threads(num_threads);
+        vector<float> dst(ref.size(), -1.0f);
+        auto rc = ppl::kernel::x86::gather_ndarray_fp32(src.data(), indices.data(), outer_dim, gather_dim, inner_dim,
+                                                        num_indices, indices_dim, dst.data());
+        ppl::kernel::x86::set_omp_num_threads(prev_num_threads);
+        ASSERT_EQ(RC_SUCCESS, rc);
+        EXPECT_EQ(ref, dst) << "num_threads " << num_threads;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(InnerDims, GatherKernelTest, testing::Values(1, 2, 3, 4, 17));
@@ -0,0 +1,195 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/gemm_param.h"
+#include "gtest/gtest.h"
+#include <math.h>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static shared_ptr<void> MakeGemmParam(int32_t trans_b) {
+    auto param = make_shared<common::GemmParam>();
+    param->num_output = 0;
+    param->bias_term = 0;
+    param->alpha = 1.0f;
+    param->beta = 1.0f;
+    param->transA = 0;
+    param->transB = trans_b;
+    param->N = 0;
+    return param;
+}
+
+/** @brief [batch, m, k] x [k, n] or, with trans_b, [n, k] */
+static vector<float> RefMatMul(const vector<float>& a, const vector<float>& b, int64_t batch, int64_t m, int64_t n,
+                               int64_t k, bool trans_b) {
+    vector<float> y(batch * m * n);
+    for (int64_t bt = 0; bt < batch; ++bt) {
+        for (int64_t i = 0; i < m; ++i) {
+            for (int64_t j = 0; j < n; ++j) {
+                float sum = 0;
+                for (int64_t p = 0; p < k; ++p) {
+                    sum += a[(bt * m + i) * k + p] * (trans_b ? b[j * k + p] : b[p * n + j]);
+                }
+                y[(bt * m + i) * n + j] = sum;
+            }
+        }
+    }
+    return y;
+}
+
+static void ExpectOutputNear(X86GraphRunner* runner, const vector<pair<string, vector<int64_t>>>& input_dims,
+                             const vector<vector<float>>& input_data, const vector<float>& ref) {
+    unique_ptr<Runtime> runtime(runner->CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    for (size_t i = 0; i < input_dims.size(); ++i) {
+        ASSERT_EQ(RC_SUCCESS,
+                  X86GraphRunner::SetInputData(runtime.get(), input_dims[i].first, input_dims[i].second,
+                                               input_data[i]));
+    }
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+    ASSERT_EQ(ref.size(), y.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_NEAR(ref[i], y[i], 1e-4f) << "at " << i;
+    }
+}
+
+// fc path: Gemm(x, constant w^T) -> Add(constant bias) -> Relu becomes a single Gemm with bias and relu fused
+TEST(GemmFusionTest, fc_bias_relu) {
+    const int64_t m = 13, n = 40, k = 24;
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("gemm", ir::Node::Type("", "Gemm"), {"x", "w"}, {"g"});
+    builder->AddNode("add", ir::Node::Type("", "Add"), {"g", "b"}, {"a"});
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"a"}, {"y"});
+    runner.SetParam("gemm", MakeGemmParam(1));
+
+    auto w = GenTestData(n * k, 1);
+    auto b = GenTestData(n, 2);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {m, k});
+    runner.SetConstant("w", DATATYPE_FLOAT32, {n, k}, w);
+    runner.SetConstant("b", DATATYPE_FLOAT32, {1, n}, b);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(1, runner.CountNodes("Gemm"));
+    EXPECT_EQ(0, runner.CountNodes("Add"));
+    EXPECT_EQ(0, runner.CountNodes("Relu"));
+
+    auto x = GenTestData(m * k, 3);
+    auto ref = RefMatMul(x, w, 1, m, n, k, true);
+    for (int64_t i = 0; i < m * n; ++i) {
+        ref[i] = max(ref[i] + b[i % n], 0.0f);
+    }
+    ExpectOutputNear(&runner, {{"x", {m, k}}}, {x}, ref);
+}
+
+// gemm_v2 path: Gemm(x, w) -> Sigmoid -> Add(r) puts sigmoid and the residual sum into the gemm epilogue
+TEST(GemmFusionTest, gemm_sigmoid_residual) {
+    const int64_t m = 17, n = 30, k = 19;
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("gemm", ir::Node::Type("", "Gemm"), {"x", "w"}, {"g"});
+    builder->AddNode("sigmoid", ir::Node::Type("", "Sigmoid"), {"g"}, {"s"});
+    builder->AddNode("add", ir::Node::Type("", "Add"), {"r", "s"}, {"y"});
+    runner.SetParam("gemm", MakeGemmParam(0));
+
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {m, k});
+    runner.SetInputShape("w", DATATYPE_FLOAT32, {k, n});
+    runner.SetInputShape("r", DATATYPE_FLOAT32, {m, n});
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(1, runner.CountNodes("Gemm"));
+    EXPECT_EQ(0, runner.CountNodes("Sigmoid"));
+    EXPECT_EQ(0, runner.CountNodes("Add"));
+
+    auto x = GenTestData(m * k, 4);
+    auto w = GenTestData(k * n, 5);
+    auto r = GenTestData(m * n, 6);
+    auto ref = RefMatMul(x, w, 1, m, n, k, false);
+    for (int64_t i = 0; i < m * n; ++i) {
+        ref[i] = 1.0f / (1.0f + expf(-ref[i])) + r[i];
+    }
+    ExpectOutputNear(&runner, {{"x", {m, k}}, {"w", {k, n}}, {"r", {m, n}}}, {x, w, r}, ref);
+}
+
+// batched MatMul -> Add(constant bias) -> Sigmoid -> Add(r) folds everything into the MatMul
+TEST(GemmFusionTest, matmul_bias_sigmoid_residual) {
+    const int64_t batch = 3, m = 9, n = 21, k = 14;
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("matmul", ir::Node::Type("", "MatMul"), {"x", "w"}, {"mm"});
+    builder->AddNode("bias", ir::Node::Type("", "Add"), {"mm", "b"}, {"a"});
+    builder->AddNode("sigmoid", ir::Node::Type("", "Sigmoid"), {"a"}, {"s"});
+    builder->AddNode("residual", ir::Node::Type("", "Add"), {"s", "r"}, {"y"});
+
+    auto w = GenTestData(k * n, 7);
+    auto b = GenTestData(n, 8);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {batch, m, k});
+    runner.SetInputShape("r", DATATYPE_FLOAT32, {batch, m, n});
+    runner.SetConstant("w", DATATYPE_FLOAT32, {k, n}, w);
+    runner.SetConstant("b", DATATYPE_FLOAT32, {n}, b);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(1, runner.CountNodes("MatMul"));
+    EXPECT_EQ(0, runner.CountNodes("Add"));
+    EXPECT_EQ(0, runner.CountNodes("Sigmoid"));
+
+    auto x = GenTestData(batch * m * k, 9);
+    auto r = GenTestData(batch * m * n, 10);
+    auto ref = RefMatMul(x, w, batch, m, n, k, false);
+    for (int64_t i = 0; i < batch * m * n; ++i) {
+        ref[i] = 1.0f / (1.0f + expf(-(ref[i] + b[i % n]))) + r[i];
+    }
+    ExpectOutputNear(&runner, {{"x", {batch, m, k}}, {"r", {batch, m, n}}}, {x, r}, ref);
+}
+
+// the residual sum is applied after the activation, so a Relu following it must stay a separate node
+TEST(GemmFusionTest, relu_after_residual_is_not_fused) {
+    const int64_t m = 11, n = 26, k = 16;
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("matmul", ir::Node::Type("", "MatMul"), {"x", "w"}, {"mm"});
+    builder->AddNode("residual", ir::Node::Type("", "Add"), {"mm", "r"}, {"a"});
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"a"}, {"y"});
+
+    auto w = GenTestData(k * n, 11);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {m, k});
+    runner.SetInputShape("r", DATATYPE_FLOAT32, {m, n});
+    runner.SetConstant("w", DATATYPE_FLOAT32, {k, n}, w);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(1, runner.CountNodes("MatMul"));
+    EXPECT_EQ(0, runner.CountNodes("Add"));
+    EXPECT_EQ(1, runner.CountNodes("Relu"));
+
+    auto x = GenTestData(m * k, 12);
+    auto r = GenTestData(m * n, 13);
+    auto ref = RefMatMul(x, w, 1, m, n, k, false);
+    for (int64_t i = 0; i < m * n; ++i) {
+        ref[i] = max(ref[i] + r[i], 0.0f);
+    }
+    ExpectOutputNear(&runner, {{"x", {m, k}}, {"r", {m, n}}}, {x, r}, ref);
+}
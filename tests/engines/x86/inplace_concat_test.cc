@@ -0,0 +1,211 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static shared_ptr<void> MakeConcatParam(int32_t axis) {
+    auto param = make_shared<common::ConcatParam>();
+    param->axis = axis;
+    return param;
+}
+
+static const x86::InplaceConcatBinding* GetBinding(const X86GraphRunner& runner, const string& node_name) {
+    auto kernel = runner.GetOptKernel(node_name);
+    return kernel ? kernel->GetInplaceConcatBinding(0) : nullptr;
+}
+
+static vector<float> Relu(const vector<float>& src) {
+    vector<float> dst(src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        dst[i] = max(src[i], 0.0f);
+    }
+    return dst;
+}
+
+static void ExpectEq(const vector<float>& ref, const vector<float>& out) {
+    ASSERT_EQ(ref.size(), out.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_EQ(ref[i], out[i]) << "at " << i;
+    }
+}
+
+// both relus write their outputs into the concat output directly
+TEST(InplaceConcatTest, producers_are_bound) {
+    const vector<int64_t> a_dims = {1, 16, 3, 5}, b_dims = {1, 32, 3, 5};
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("relu_a", ir::Node::Type("", "Relu"), {"a"}, {"ra"});
+    builder->AddNode("relu_b", ir::Node::Type("", "Relu"), {"b"}, {"rb"});
+    builder->AddNode("concat", ir::Node::Type("", "Concat"), {"ra", "rb"}, {"y"});
+    runner.SetParam("concat", MakeConcatParam(1));
+    runner.SetInputShape("a", DATATYPE_FLOAT32, a_dims);
+    runner.SetInputShape("b", DATATYPE_FLOAT32, b_dims);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    auto binding_a = GetBinding(runner, "relu_a");
+    auto binding_b = GetBinding(runner, "relu_b");
+    auto binding_y = GetBinding(runner, "concat");
+    ASSERT_NE(nullptr, binding_a);
+    ASSERT_NE(nullptr, binding_b);
+    ASSERT_NE(nullptr, binding_y);
+    EXPECT_EQ(0u, binding_a->input_idx);
+    EXPECT_EQ(1u, binding_b->input_idx);
+    EXPECT_TRUE(binding_y->input_idx == x86::InplaceConcatBinding::CONCAT_OUTPUT);
+    EXPECT_EQ(binding_y->info.get(), binding_a->info.get());
+    EXPECT_EQ(binding_y->info.get(), binding_b->info.get());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto a = GenTestData(16 * 3 * 5, 1);
+    auto b = GenTestData(32 * 3 * 5, 2);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "a", a_dims, a));
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "b", b_dims, b));
+
+    auto ref = Relu(a);
+    auto ref_b = Relu(b);
+    ref.insert(ref.end(), ref_b.begin(), ref_b.end());
+    // the shared buffer is taken over by the output and allocated again by the next run
+    for (int run = 0; run < 2; ++run) {
+        ASSERT_EQ(RC_SUCCESS, runtime->Run());
+        vector<float> y;
+        ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+        ExpectEq(ref, y);
+    }
+}
+
+// the second slice starts 20 bytes into the output, so its producer is not bound and the concat copies it
+TEST(InplaceConcatTest, unaligned_slice_is_copied) {
+    const vector<int64_t> a_dims = {1, 5}, b_dims = {1, 7};
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("relu_a", ir::Node::Type("", "Relu"), {"a"}, {"ra"});
+    builder->AddNode("relu_b", ir::Node::Type("", "Relu"), {"b"}, {"rb"});
+    builder->AddNode("concat", ir::Node::Type("", "Concat"), {"ra", "rb"}, {"y"});
+    runner.SetParam("concat", MakeConcatParam(1));
+    runner.SetInputShape("a", DATATYPE_FLOAT32, a_dims);
+    runner.SetInputShape("b", DATATYPE_FLOAT32, b_dims);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_NE(nullptr, GetBinding(runner, "relu_a"));
+    EXPECT_EQ(nullptr, GetBinding(runner, "relu_b"));
+    EXPECT_NE(nullptr, GetBinding(runner, "concat"));
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto a = GenTestData(5, 1);
+    auto b = GenTestData(7, 2);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "a", a_dims, a));
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "b", b_dims, b));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+    auto ref = Relu(a);
+    auto ref_b = Relu(b);
+    ref.insert(ref.end(), ref_b.begin(), ref_b.end());
+    ExpectEq(ref, y);
+}
+
+// a slice output may be a view of its input and cannot be redirected into the concat output
+TEST(InplaceConcatTest, slice_producer_is_not_bound) {
+    const vector<int64_t> x_dims = {1, 48, 2, 3}, b_dims = {1, 16, 2, 3};
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("slice", ir::Node::Type("", "Slice"), {"x", "starts", "ends", "axes"}, {"s"});
+    builder->AddNode("relu_b", ir::Node::Type("", "Relu"), {"b"}, {"rb"});
+    builder->AddNode("concat", ir::Node::Type("", "Concat"), {"s", "rb"}, {"y"});
+    runner.SetParam("concat", MakeConcatParam(1));
+    runner.SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+    runner.SetInputShape("b", DATATYPE_FLOAT32, b_dims);
+    runner.SetConstant("starts", DATATYPE_INT64, {1}, vector<int64_t>{16});
+    runner.SetConstant("ends", DATATYPE_INT64, {1}, vector<int64_t>{32});
+    runner.SetConstant("axes", DATATYPE_INT64, {1}, vector<int64_t>{1});
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(nullptr, GetBinding(runner, "slice"));
+    EXPECT_NE(nullptr, GetBinding(runner, "relu_b"));
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(48 * 2 * 3, 1);
+    auto b = GenTestData(16 * 2 * 3, 2);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "b", b_dims, b));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+    vector<float> ref(x.begin() + 16 * 2 * 3, x.begin() + 32 * 2 * 3);
+    auto ref_b = Relu(b);
+    ref.insert(ref.end(), ref_b.begin(), ref_b.end());
+    ExpectEq(ref, y);
+}
+
+/*
+  inputs are built as [16, 16, 32] channels and run as [32, 16, 16]. rb is still bound at channel 16 of the output,
+  but belongs at channel 32, and copying ra overwrites it unless rb is moved first. a case with the middle input
+  moving towards the front is run as well.
+*/
+TEST(InplaceConcatTest, bound_input_moved_by_other_shapes) {
+    const vector<vector<int64_t>> build_channels = {{16, 16, 32}, {32, 32, 16}};
+    const vector<vector<int64_t>> run_channels = {{32, 16, 16}, {16, 32, 32}};
+
+    for (size_t c = 0; c < build_channels.size(); ++c) {
+        X86GraphRunner runner;
+        auto builder = runner.GetGraphBuilder();
+        const vector<string> names = {"a", "b", "c"};
+        vector<string> relu_outputs;
+        for (size_t i = 0; i < names.size(); ++i) {
+            builder->AddNode("relu_" + names[i], ir::Node::Type("", "Relu"), {names[i]}, {"r" + names[i]});
+            runner.SetInputShape(names[i], DATATYPE_FLOAT32, {1, build_channels[c][i], 2, 3});
+            relu_outputs.push_back("r" + names[i]);
+        }
+        builder->AddNode("concat", ir::Node::Type("", "Concat"), relu_outputs, {"y"});
+        runner.SetParam("concat", MakeConcatParam(1));
+        ASSERT_EQ(RC_SUCCESS, runner.Process());
+        ASSERT_NE(nullptr, GetBinding(runner, "relu_b"));
+
+        unique_ptr<Runtime> runtime(runner.CreateRuntime());
+        ASSERT_NE(nullptr, runtime.get());
+        vector<float> ref;
+        for (size_t i = 0; i < names.size(); ++i) {
+            auto src = GenTestData(run_channels[c][i] * 2 * 3, i + 1);
+            ASSERT_EQ(RC_SUCCESS,
+                      X86GraphRunner::SetInputData(runtime.get(), names[i], {1, run_channels[c][i], 2, 3}, src));
+            auto ref_i = Relu(src);
+            ref.insert(ref.end(), ref_i.begin(), ref_i.end());
+        }
+        ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+        vector<float> y;
+        ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+        SCOPED_TRACE(testing::Message() << "case " << c);
+        ExpectEq(ref, y);
+    }
+}
@@ -0,0 +1,203 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "ppl/nn/params/onnx/pooling_param.h"
+#include "ppl/nn/params/onnx/transpose_param.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <math.h>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static const int64_t g_channels = 24, g_height = 28, g_width = 28;
+
+static shared_ptr<void> MakeConvParam() {
+    auto param = make_shared<common::ConvolutionParam>();
+    param->kernel_shape = {3, 3};
+    param->dilations = {1, 1};
+    param->strides = {1, 1};
+    param->pads = {1, 1, 1, 1};
+    param->group = 1;
+    return param;
+}
+
+static shared_ptr<void> MakeMaxPoolParam() {
+    auto param = make_shared<common::PoolingParam>();
+    param->kernel_shape = {2, 2};
+    param->dilations = {1, 1};
+    param->strides = {2, 2};
+    param->pads = {0, 0, 0, 0};
+    param->mode = common::PoolingParam::POOLING_MAX;
+    param->ceil_mode = 0;
+    param->global_pooling = 0;
+    return param;
+}
+
+static vector<float> RefMaxPool2x2(const vector<float>& src, const vector<int64_t>& src_dims,
+                                   vector<int64_t>* dst_dims) {
+    const int64_t channels = src_dims[0] * src_dims[1], src_h = src_dims[2], src_w = src_dims[3];
+    const int64_t dst_h = src_h / 2, dst_w = src_w / 2;
+    *dst_dims = {src_dims[0], src_dims[1], dst_h, dst_w};
+    vector<float> dst(channels * dst_h * dst_w);
+    for (int64_t c = 0; c < channels; ++c) {
+        for (int64_t oh = 0; oh < dst_h; ++oh) {
+            for (int64_t ow = 0; ow < dst_w; ++ow) {
+                const float* p = src.data() + (c * src_h + 2 * oh) * src_w + 2 * ow;
+                dst[(c * dst_h + oh) * dst_w + ow] = max(max(p[0], p[1]), max(p[src_w], p[src_w + 1]));
+            }
+        }
+    }
+    return dst;
+}
+
+/*
+  channels-last x -> transpose(0, 3, 1, 2) -> conv(3x3) -> maxpool(2x2) -> conv(3x3) -> y, with 24 channels.
+  nhwc needs no reorder behind the transpose and pads channels to 8 instead of 16, so it moves fewer bytes. its conv
+  kernels are fma only though, so n16cx is cheaper when avx512 is available.
+*/
+static void RunConvPoolConv(bool disable_avx512, dataformat_t* conv_format, dataformat_t* pool_format) {
+    const vector<int64_t> x_dims = {1, g_height, g_width, g_channels};
+    const vector<int64_t> w_dims = {g_channels, g_channels, 3, 3};
+
+    X86GraphRunner runner;
+    if (disable_avx512) {
+        runner.GetEngine()->Configure(x86::X86_CONF_DISABLE_AVX512);
+    }
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("transpose", ir::Node::Type("", "Transpose"), {"x"}, {"t"});
+    builder->AddNode("conv1", ir::Node::Type("", "Conv"), {"t", "w1", "b1"}, {"c1"});
+    builder->AddNode("pool", ir::Node::Type("", "MaxPool"), {"c1"}, {"p"});
+    builder->AddNode("conv2", ir::Node::Type("", "Conv"), {"p", "w2", "b2"}, {"y"});
+    auto transpose_param = make_shared<common::TransposeParam>();
+    transpose_param->perm = {0, 3, 1, 2};
+    runner.SetParam("transpose", transpose_param);
+    runner.SetParam("conv1", MakeConvParam());
+    runner.SetParam("pool", MakeMaxPoolParam());
+    runner.SetParam("conv2", MakeConvParam());
+
+    auto w1 = GenTestData(g_channels * g_channels * 9, 1);
+    auto b1 = GenTestData(g_channels, 2);
+    auto w2 = GenTestData(g_channels * g_channels * 9, 3);
+    auto b2 = GenTestData(g_channels, 4);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+    runner.SetConstant("w1", DATATYPE_FLOAT32, w_dims, w1);
+    runner.SetConstant("b1", DATATYPE_FLOAT32, {g_channels}, b1);
+    runner.SetConstant("w2", DATATYPE_FLOAT32, w_dims, w2);
+    runner.SetConstant("b2", DATATYPE_FLOAT32, {g_channels}, b2);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    *conv_format = runner.GetOutputFormat("conv1");
+    *pool_format = runner.GetOutputFormat("pool");
+    EXPECT_EQ(*conv_format, runner.GetOutputFormat("conv2"));
+    EXPECT_EQ(*conv_format, *pool_format);
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(g_channels * g_height * g_width, 5);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+
+    RefConvParam conv_param;
+    conv_param.kernel = {3, 3};
+    conv_param.strides = {1, 1};
+    conv_param.pads = {1, 1};
+    conv_param.dilations = {1, 1};
+    vector<int64_t> c1_dims, p_dims, y_dims;
+    vector<float> t(x.size());
+    for (int64_t c = 0; c < g_channels; ++c) {
+        for (int64_t hw = 0; hw < g_height * g_width; ++hw) {
+            t[c * g_height * g_width + hw] = x[hw * g_channels + c];
+        }
+    }
+    auto c1 = RefConv(t, {1, g_channels, g_height, g_width}, w1, b1, g_channels, conv_param, &c1_dims);
+    auto p = RefMaxPool2x2(c1, c1_dims, &p_dims);
+    auto ref = RefConv(p, p_dims, w2, b2, g_channels, conv_param, &y_dims);
+    ASSERT_EQ(ref.size(), y.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_NEAR(ref[i], y[i], 1e-3f * max(1.0f, fabsf(ref[i]))) << "at " << i;
+    }
+}
+
+TEST(LayoutSelectionTest, avx512_prefers_n16cx) {
+    if (!(GetCpuISA() & ISA_X86_AVX512)) {
+        return;
+    }
+    dataformat_t conv_format, pool_format;
+    RunConvPoolConv(false, &conv_format, &pool_format);
+    EXPECT_EQ(DATAFORMAT_N16CX, conv_format);
+    EXPECT_EQ(DATAFORMAT_N16CX, pool_format);
+}
+
+TEST(LayoutSelectionTest, fma_prefers_nhwc) {
+    if (!(GetCpuISA() & ISA_X86_FMA)) {
+        return;
+    }
+    dataformat_t conv_format, pool_format;
+    RunConvPoolConv(true, &conv_format, &pool_format);
+    EXPECT_EQ(DATAFORMAT_NHWC, conv_format);
+    EXPECT_EQ(DATAFORMAT_NHWC, pool_format);
+}
+
+// more independent transpose -> conv -> maxpool -> conv chains than search rounds, so that several of them have to
+// switch to nhwc in the same round
+TEST(LayoutSelectionTest, many_nodes_move_in_one_round) {
+    if (!(GetCpuISA() & ISA_X86_FMA)) {
+        return;
+    }
+    const int32_t num_chains = 12;
+    const vector<int64_t> x_dims = {1, g_height, g_width, g_channels};
+    const vector<int64_t> w_dims = {g_channels, g_channels, 3, 3};
+
+    X86GraphRunner runner;
+    runner.GetEngine()->Configure(x86::X86_CONF_DISABLE_AVX512);
+    auto builder = runner.GetGraphBuilder();
+    auto transpose_param = make_shared<common::TransposeParam>();
+    transpose_param->perm = {0, 3, 1, 2};
+    for (int32_t i = 0; i < num_chains; ++i) {
+        const string id = to_string(i);
+        builder->AddNode("transpose" + id, ir::Node::Type("", "Transpose"), {"x" + id}, {"t" + id});
+        builder->AddNode("conv1_" + id, ir::Node::Type("", "Conv"), {"t" + id, "w1_" + id, "b1_" + id}, {"c1_" + id});
+        builder->AddNode("pool" + id, ir::Node::Type("", "MaxPool"), {"c1_" + id}, {"p" + id});
+        builder->AddNode("conv2_" + id, ir::Node::Type("", "Conv"), {"p" + id, "w2_" + id, "b2_" + id}, {"y" + id});
+        runner.SetParam("transpose" + id, transpose_param);
+        runner.SetParam("conv1_" + id, MakeConvParam());
+        runner.SetParam("pool" + id, MakeMaxPoolParam());
+        runner.SetParam("conv2_" + id, MakeConvParam());
+        runner.SetInputShape("x" + id, DATATYPE_FLOAT32, x_dims);
+        runner.SetConstant("w1_" + id, DATATYPE_FLOAT32, w_dims, GenTestData(g_channels * g_channels * 9, 1));
+        runner.SetConstant("b1_" + id, DATATYPE_FLOAT32, {g_channels}, GenTestData(g_channels, 2));
+        runner.SetConstant("w2_" + id, DATATYPE_FLOAT32, w_dims, GenTestData(g_channels * g_channels * 9, 3));
+        runner.SetConstant("b2_" + id, DATATYPE_FLOAT32, {g_channels}, GenTestData(g_channels, 4));
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    for (int32_t i = 0; i < num_chains; ++i) {
+        const string id = to_string(i);
+        EXPECT_EQ(DATAFORMAT_NHWC, runner.GetOutputFormat("conv1_" + id)) << "chain " << i;
+        EXPECT_EQ(DATAFORMAT_NHWC, runner.GetOutputFormat("pool" + id)) << "chain " << i;
+        EXPECT_EQ(DATAFORMAT_NHWC, runner.GetOutputFormat("conv2_" + id)) << "chain " << i;
+    }
+}
@@ -0,0 +1,158 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/loop_param.h"
+#include "gtest/gtest.h"
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static const vector<int64_t> g_v_dims = {2, 3};
+
+static void SetShape(ir::Graph* graph, const string& name, datatype_t data_type, const vector<int64_t>& dims) {
+    auto& shape = graph->data->shapes[graph->topo->GetEdgeByName(name)->GetId()];
+    shape.data_type = data_type;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+}
+
+template <typename T>
+static void SetConstant(ir::Graph* graph, const string& name, datatype_t data_type, const vector<T>& values) {
+    auto edge = graph->topo->GetEdgeByName(name);
+    graph->topo->MarkAsConstant(edge->GetId());
+    graph->data->constants[edge->GetId()].data.assign((const char*)values.data(), values.size() * sizeof(T));
+    SetShape(graph, name, data_type, {(int64_t)values.size()});
+}
+
+/*
+  body(i, cond_in, v) -> (cond_out, v + 1, v * 2), so iteration i scans out (v0 + i) * 2. cond_out is i < limit if
+  `limit` >= 0, or cond_in passed through otherwise.
+*/
+static shared_ptr<void> MakeLoopParam(int64_t limit) {
+    GraphBuilder body;
+    body.AddNode("next", ir::Node::Type("", "Add"), {"v", "one"}, {"v_next"});
+    body.AddNode("scan", ir::Node::Type("", "Mul"), {"v", "two"}, {"s"});
+    if (limit >= 0) {
+        body.AddNode("cond", ir::Node::Type("", "Less"), {"i", "limit"}, {"cond_out"});
+    } else {
+        body.AddNode("cond", ir::Node::Type("", "Identity"), {"cond_in"}, {"cond_out"});
+    }
+    body.SetGraphName("body");
+
+    auto graph = body.GetGraph();
+    auto topo = graph->topo.get();
+    if (limit < 0) {
+        topo->AddEdge("i"); // unused but required by the loop signature
+    }
+    if (limit >= 0) {
+        topo->AddEdge("cond_in");
+        SetConstant<int64_t>(graph, "limit", DATATYPE_INT64, {limit});
+    }
+    SetConstant<float>(graph, "one", DATATYPE_FLOAT32, {1.0f});
+    SetConstant<float>(graph, "two", DATATYPE_FLOAT32, {2.0f});
+
+    SetShape(graph, "i", DATATYPE_INT64, {1});
+    SetShape(graph, "cond_in", DATATYPE_BOOL, {1});
+    SetShape(graph, "v", DATATYPE_FLOAT32, g_v_dims);
+    for (auto name : {"i", "cond_in", "v"}) {
+        topo->MarkAsInput(topo->GetEdgeByName(name)->GetId());
+    }
+    // output shapes are recorded as the onnx parser does from value infos of graph outputs
+    SetShape(graph, "cond_out", DATATYPE_BOOL, {1});
+    SetShape(graph, "v_next", DATATYPE_FLOAT32, g_v_dims);
+    SetShape(graph, "s", DATATYPE_FLOAT32, g_v_dims);
+    for (auto name : {"cond_out", "v_next", "s"}) {
+        topo->MarkAsOutput(topo->GetEdgeByName(name)->GetId());
+    }
+
+    auto param = make_shared<common::LoopParam>();
+    param->graph = *graph;
+    return param;
+}
+
+struct LoopResult {
+    vector<int64_t> v_dims;
+    vector<float> v;
+    vector<int64_t> scan_dims;
+    vector<float> scan;
+};
+
+static void RunLoop(int64_t max_trip_count, int64_t limit, const vector<float>& v0, uint32_t run_count,
+                    LoopResult* result) {
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("loop", ir::Node::Type("", "Loop"), {"m", "cond", "v0"}, {"v_final", "scans"});
+    runner.SetParam("loop", MakeLoopParam(limit));
+    runner.SetConstant<int64_t>("m", DATATYPE_INT64, {1}, {max_trip_count});
+    runner.SetConstant<uint8_t>("cond", DATATYPE_BOOL, {1}, {1});
+    runner.SetInputShape("v0", DATATYPE_FLOAT32, g_v_dims);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "v0", g_v_dims, v0));
+    // running again checks that a handed-over scan buffer is not reused
+    for (uint32_t i = 0; i < run_count; ++i) {
+        ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    }
+    result->v_dims = X86GraphRunner::GetOutputDims(runtime.get(), "v_final");
+    result->scan_dims = X86GraphRunner::GetOutputDims(runtime.get(), "scans");
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "v_final", &result->v));
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "scans", &result->scan));
+}
+
+static void ExpectLoopResult(const vector<float>& v0, int64_t trip_count, const LoopResult& result) {
+    EXPECT_EQ(g_v_dims, result.v_dims);
+    ASSERT_EQ(v0.size(), result.v.size());
+    for (size_t j = 0; j < v0.size(); ++j) {
+        EXPECT_EQ(v0[j] + trip_count, result.v[j]) << "at " << j;
+    }
+
+    EXPECT_EQ(vector<int64_t>({trip_count, g_v_dims[0], g_v_dims[1]}), result.scan_dims);
+    ASSERT_EQ(trip_count * v0.size(), result.scan.size());
+    for (int64_t i = 0; i < trip_count; ++i) {
+        for (size_t j = 0; j < v0.size(); ++j) {
+            EXPECT_EQ((v0[j] + i) * 2, result.scan[i * v0.size() + j]) << "iteration " << i << " at " << j;
+        }
+    }
+}
+
+// 20 iterations reserve 8, 16 and then 20 slices, each reserve keeping the slices written before it
+TEST(LoopKernelTest, scan_outputs_across_reserve_growth) {
+    auto v0 = GenTestData(g_v_dims[0] * g_v_dims[1], 1);
+    LoopResult result;
+    RunLoop(20, -1, v0, 2, &result);
+    ExpectLoopResult(v0, 20, result);
+}
+
+// stopped by cond rather than by the trip count, so the reserved capacity is larger than the scan output
+TEST(LoopKernelTest, scan_outputs_stopped_by_cond) {
+    auto v0 = GenTestData(g_v_dims[0] * g_v_dims[1], 2);
+    LoopResult result;
+    RunLoop(1000, 10, v0, 2, &result); // cond_out is false after iteration 10
+    ExpectLoopResult(v0, 11, result);
+}
+
+TEST(LoopKernelTest, zero_trip_count) {
+    auto v0 = GenTestData(g_v_dims[0] * g_v_dims[1], 3);
+    LoopResult result;
+    RunLoop(0, -1, v0, 1, &result);
+    ExpectLoopResult(v0, 0, result);
+}
@@ -0,0 +1,231 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/argmax_param.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "ppl/nn/params/onnx/reduce_param.h"
+#include "ppl/nn/params/onnx/softmax_param.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <algorithm>
+#include <limits>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+// 20 channels leave padded lanes in the last channel block of N16CX
+static const vector<int64_t> g_x_dims = {2, 8, 5, 7};
+static const int64_t g_channels = 20;
+
+/*
+  x -> conv(3x3) -> c -> head -> y. the conv output is N16CX, which the head reads without a reorder node in
+  between. returns the conv output and its dims in `conv_out` and `conv_dims`.
+*/
+static void RunConvHead(const string& head_type, const shared_ptr<void>& head_param, Runtime** runtime,
+                        vector<float>* conv_out, vector<int64_t>* conv_dims) {
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("conv", ir::Node::Type("", "Conv"), {"x", "w", "b"}, {"c"});
+    builder->AddNode("head", ir::Node::Type("", head_type), {"c"}, {"y"});
+
+    auto conv_param = make_shared<common::ConvolutionParam>();
+    conv_param->kernel_shape = {3, 3};
+    conv_param->dilations = {1, 1};
+    conv_param->strides = {1, 1};
+    conv_param->pads = {1, 1, 1, 1};
+    conv_param->group = 1;
+    runner.SetParam("conv", conv_param);
+    runner.SetParam("head", head_param);
+
+    auto w = GenTestData(g_channels * g_x_dims[1] * 9, 1);
+    auto b = GenTestData(g_channels, 2);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, g_x_dims);
+    runner.SetConstant("w", DATATYPE_FLOAT32, {g_channels, g_x_dims[1], 3, 3}, w);
+    runner.SetConstant("b", DATATYPE_FLOAT32, {g_channels}, b);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+    ASSERT_EQ(DATAFORMAT_N16CX, runner.GetOutputFormat("conv"));
+    EXPECT_EQ(0, runner.CountNodes("Reorder"));
+
+    *runtime = runner.CreateRuntime();
+    ASSERT_NE(nullptr, *runtime);
+    auto x = GenTestData(g_x_dims[0] * g_x_dims[1] * g_x_dims[2] * g_x_dims[3], 3);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(*runtime, "x", g_x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, (*runtime)->Run());
+
+    RefConvParam ref_param;
+    ref_param.kernel = {3, 3};
+    ref_param.strides = {1, 1};
+    ref_param.pads = {1, 1};
+    ref_param.dilations = {1, 1};
+    *conv_out = RefConv(x, g_x_dims, w, b, g_channels, ref_param, conv_dims);
+}
+
+TEST(N16CXHeadTest, softmax_from_channels) {
+    auto param = make_shared<common::SoftmaxParam>();
+    param->axis = 1;
+    Runtime* runtime = nullptr;
+    vector<float> c;
+    vector<int64_t> c_dims;
+    RunConvHead("Softmax", param, &runtime, &c, &c_dims);
+    unique_ptr<Runtime> runtime_guard(runtime);
+    if (HasFatalFailure()) {
+        return;
+    }
+
+    // inputs are coerced into [N, C * H * W] as in opset 11
+    const int64_t inner_dim = c_dims[1] * c_dims[2] * c_dims[3];
+    vector<float> ref(c.size());
+    for (int64_t n = 0; n < c_dims[0]; ++n) {
+        const float* src = c.data() + n * inner_dim;
+        float* dst = ref.data() + n * inner_dim;
+        float sum = 0;
+        for (int64_t i = 0; i < inner_dim; ++i) {
+            dst[i] = expf(src[i]);
+            sum += dst[i];
+        }
+        for (int64_t i = 0; i < inner_dim; ++i) {
+            dst[i] /= sum;
+        }
+    }
+
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime, "y", &y));
+    ASSERT_EQ(ref.size(), y.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_NEAR(ref[i], y[i], 1e-5f) << "at " << i;
+    }
+}
+
+TEST(N16CXHeadTest, argmax_over_channels) {
+    auto param = make_shared<common::ArgMaxParam>();
+    param->axis = 1;
+    param->keepdims = 0;
+    Runtime* runtime = nullptr;
+    vector<float> c;
+    vector<int64_t> c_dims;
+    RunConvHead("ArgMax", param, &runtime, &c, &c_dims);
+    unique_ptr<Runtime> runtime_guard(runtime);
+    if (HasFatalFailure()) {
+        return;
+    }
+
+    const int64_t channels = c_dims[1], space = c_dims[2] * c_dims[3];
+    vector<int64_t> ref(c_dims[0] * space);
+    for (int64_t n = 0; n < c_dims[0]; ++n) {
+        for (int64_t s = 0; s < space; ++s) {
+            const float* src = c.data() + n * channels * space + s;
+            int64_t idx = 0;
+            for (int64_t i = 1; i < channels; ++i) {
+                if (src[i * space] > src[idx * space]) { // first index of the max value
+                    idx = i;
+                }
+            }
+            ref[n * space + s] = idx;
+        }
+    }
+
+    EXPECT_EQ(vector<int64_t>({c_dims[0], c_dims[2], c_dims[3]}), X86GraphRunner::GetOutputDims(runtime, "y"));
+    auto y = (const int64_t*)X86GraphRunner::GetOutputBufferPtr(runtime, "y");
+    ASSERT_NE(nullptr, y);
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_EQ(ref[i], y[i]) << "at " << i;
+    }
+}
+
+struct ReduceCase {
+    const char* op_type;
+    vector<int32_t> axes;
+};
+
+class N16CXReduceTest : public testing::TestWithParam<ReduceCase> {};
+
+// keep_dims=0 reduces N16CX into a NDARRAY output
+TEST_P(N16CXReduceTest, without_kept_dims) {
+    const auto& rc = GetParam();
+    auto param = make_shared<common::ReduceParam>();
+    param->axes = rc.axes;
+    param->keep_dims = false;
+    Runtime* runtime = nullptr;
+    vector<float> c;
+    vector<int64_t> c_dims;
+    RunConvHead(rc.op_type, param, &runtime, &c, &c_dims);
+    unique_ptr<Runtime> runtime_guard(runtime);
+    if (HasFatalFailure()) {
+        return;
+    }
+
+    const string op_type(rc.op_type);
+    vector<bool> reduced(4, rc.axes.empty());
+    for (auto axis : rc.axes) {
+        reduced[axis < 0 ? axis + 4 : axis] = true;
+    }
+    vector<int64_t> ref_dims, kept_dims(4);
+    int64_t reduce_count = 1;
+    for (int64_t i = 0; i < 4; ++i) {
+        kept_dims[i] = reduced[i] ? 1 : c_dims[i];
+        reduce_count *= reduced[i] ? c_dims[i] : 1;
+        if (!reduced[i]) {
+            ref_dims.push_back(c_dims[i]);
+        }
+    }
+
+    const float init = op_type == "ReduceMax" ? -numeric_limits<float>::infinity()
+        : op_type == "ReduceMin"               ? numeric_limits<float>::infinity()
+                                               : 0.0f;
+    vector<float> ref(kept_dims[0] * kept_dims[1] * kept_dims[2] * kept_dims[3], init);
+    for (int64_t n = 0; n < c_dims[0]; ++n) {
+        for (int64_t ch = 0; ch < c_dims[1]; ++ch) {
+            for (int64_t h = 0; h < c_dims[2]; ++h) {
+                for (int64_t w = 0; w < c_dims[3]; ++w) {
+                    const float val = c[((n * c_dims[1] + ch) * c_dims[2] + h) * c_dims[3] + w];
+                    float& dst = ref[(((reduced[0] ? 0 : n) * kept_dims[1] + (reduced[1] ? 0 : ch)) * kept_dims[2] +
+                                      (reduced[2] ? 0 : h)) *
+                                         kept_dims[3] +
+                                     (reduced[3] ? 0 : w)];
+                    if (op_type == "ReduceMax") {
+                        dst = max(dst, val);
+                    } else if (op_type == "ReduceMin") {
+                        dst = min(dst, val);
+                    } else {
+                        dst += val;
+                    }
+                }
+            }
+        }
+    }
+    if (op_type == "ReduceMean") {
+        for (auto& v : ref) {
+            v /= reduce_count;
+        }
+    }
+
+    EXPECT_EQ(ref_dims, X86GraphRunner::GetOutputDims(runtime, "y"));
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime, "y", &y));
+    ASSERT_EQ(ref.size(), y.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_NEAR(ref[i], y[i], 1e-3f) << "at " << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Ops, N16CXReduceTest,
+                        testing::Values(ReduceCase{"ReduceMax", {2, 3}}, ReduceCase{"ReduceMin", {1}},
+                                        ReduceCase{"ReduceMean", {-2, -1}}, ReduceCase{"ReduceSum", {1, 3}},
+                                        ReduceCase{"ReduceSum", {}}));
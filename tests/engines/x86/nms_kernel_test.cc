@@ -0,0 +1,270 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/mmcv_nms.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <algorithm>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+
+// indices in descending score order, equal scores keep the lower index first
+static vector<uint32_t> SortByScore(const float* scores, uint32_t num_boxes) {
+    vector<uint32_t> order(num_boxes);
+    for (uint32_t i = 0; i < num_boxes; ++i) {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [scores](uint32_t a, uint32_t b) {
+        return scores[a] > scores[b];
+    });
+    return order;
+}
+
+static float CalcIoU(const float* a, const float* b) {
+    const float iw = min(a[2], b[2]) - max(a[0], b[0]);
+    const float ih = min(a[3], b[3]) - max(a[1], b[1]);
+    const float inter = max(iw, 0.0f) * max(ih, 0.0f);
+    if (inter <= 0) {
+        return 0;
+    }
+    return inter / ((a[2] - a[0]) * (a[3] - a[1]) + (b[2] - b[0]) * (b[3] - b[1]) - inter);
+}
+
+// [x1, y1, x2, y2] of a box in either input format of NonMaxSuppression
+static vector<float> ToCorners(const float* box, bool center_point_box) {
+    if (center_point_box) {
+        return {box[0] - box[2] / 2, box[1] - box[3] / 2, box[0] + box[2] / 2, box[1] + box[3] / 2};
+    }
+    return {min(box[1], box[3]), min(box[0], box[2]), max(box[1], box[3]), max(box[0], box[2])};
+}
+
+// triplets of [batch, class, box] as NonMaxSuppression in onnx
+static vector<int64_t> NmsRef(const vector<float>& boxes, const vector<float>& scores, uint32_t num_boxes,
+                              uint32_t batch, uint32_t num_classes, bool center_point_box, int64_t max_output,
+                              float iou_threshold, float score_threshold) {
+    vector<int64_t> dst;
+    for (uint32_t n = 0; n < batch; ++n) {
+        const float* p_boxes = boxes.data() + n * num_boxes * 4;
+        for (uint32_t c = 0; c < num_classes; ++c) {
+            const float* p_scores = scores.data() + (n * num_classes + c) * num_boxes;
+            vector<vector<float>> selected;
+            for (auto idx : SortByScore(p_scores, num_boxes)) {
+                if ((int64_t)selected.size() >= max_output || p_scores[idx] <= score_threshold) {
+                    break;
+                }
+                auto box = ToCorners(p_boxes + idx * 4, center_point_box);
+                bool keep = true;
+                for (auto& s : selected) {
+                    keep = keep && !(CalcIoU(box.data(), s.data()) > iou_threshold);
+                }
+                if (keep) {
+                    selected.push_back(box);
+                    dst.insert(dst.end(), {n, c, idx});
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+static void CheckNms(const vector<float>& boxes, const vector<float>& scores, uint32_t num_boxes, uint32_t batch,
+                     uint32_t num_classes, bool center_point_box, int64_t max_output, float iou_threshold,
+                     float score_threshold) {
+    auto ref = NmsRef(boxes, scores, num_boxes, batch, num_classes, center_point_box, max_output, iou_threshold,
+                      score_threshold);
+    for (int32_t num_threads : {1, 3}) {
+        auto prev_num_threads = ppl::kernel::x86::set_omp_num_threads(num_threads);
+        vector<int64_t> dst(batch * num_classes * num_boxes * 3, -1);
+        int64_t num_boxes_out = -1;
+        auto rc = ppl::kernel::x86::nms_ndarray_fp32(boxes.data(), scores.data(), num_boxes, batch, num_classes,
+                                                     center_point_box, max_output, iou_threshold, score_threshold,
+                                                     dst.data(), &num_boxes_out);
+        ppl::kernel::x86::set_omp_num_threads(prev_num_threads);
+        ASSERT_EQ(RC_SUCCESS, rc);
+        ASSERT_EQ(int64_t(ref.size() / 3), num_boxes_out)
+            << "num_threads " << num_threads << ", max_output " << max_output;
+        dst.resize(ref.size());
+        EXPECT_EQ(ref, dst) << "num_threads " << num_threads << ", max_output " << max_output;
+    }
+}
+
+// boxes on a small grid so that many of them overlap, scores from a few levels so that many of them tie
+static void GenBoxes(uint32_t count, uint32_t seed, bool center_point_box, vector<float>* boxes) {
+    uint32_t state = seed;
+    auto next = [&state](uint32_t mod) {
+        state = state * 1664525u + 1013904223u;
+        return float((state >> 8) % mod);
+    };
+    boxes->resize(count * 4);
+    for (uint32_t i = 0; i < count; ++i) {
+        float* box = boxes->data() + i * 4;
+        const float a = next(16), b = next(16), w = 1 + next(8), h = 1 + next(8);
+        if (center_point_box) {
+            box[0] = a, box[1] = b, box[2] = 2 * w, box[3] = 2 * h;
+        } else if (i % 2) { // corners may come in either order
+            box[0] = b + h, box[1] = a + w, box[2] = b, box[3] = a;
+        } else {
+            box[0] = b, box[1] = a, box[2] = b + h, box[3] = a + w;
+        }
+    }
+}
+
+static void GenScores(uint32_t count, uint32_t seed, uint32_t levels, vector<float>* scores) {
+    uint32_t state = seed;
+    scores->resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        (*scores)[i] = float((state >> 8) % levels) / levels;
+    }
+}
+
+// more boxes than one sorting window, with limits below, at and above what the classes can select
+TEST(NmsKernelTest, max_output_boxes_per_class) {
+    const uint32_t num_boxes = 300, batch = 2, num_classes = 3;
+    for (bool center_point_box : {false, true}) {
+        vector<float> boxes, scores;
+        GenBoxes(batch * num_boxes, 1, center_point_box, &boxes);
+        GenScores(batch * num_classes * num_boxes, 2, 10, &scores);
+        for (int64_t max_output : {0, 1, 3, 40, 100, 300, 1000}) {
+            SCOPED_TRACE(testing::Message() << "center_point_box " << center_point_box);
+            CheckNms(boxes, scores, num_boxes, batch, num_classes, center_point_box, max_output, 0.3f, 0.25f);
+            CheckNms(boxes, scores, num_boxes, batch, num_classes, center_point_box, max_output, 0.7f, -1.0f);
+        }
+    }
+}
+
+// all scores are equal, so the lower index wins every overlap and fills the limit first
+TEST(NmsKernelTest, score_ties) {
+    const uint32_t num_boxes = 200;
+    vector<float> boxes, scores(num_boxes, 0.5f);
+    GenBoxes(num_boxes, 3, false, &boxes);
+    for (int64_t max_output : {1, 5, 200}) {
+        CheckNms(boxes, scores, num_boxes, 1, 1, false, max_output, 0.5f, 0.0f);
+    }
+
+    // a score equal to the threshold is not selected
+    GenScores(num_boxes, 4, 4, &scores);
+    CheckNms(boxes, scores, num_boxes, 1, 1, false, 200, 0.5f, 0.5f);
+
+    const vector<float> same_boxes = {0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1};
+    const vector<float> same_scores = {0.5f, 0.9f, 0.9f};
+    vector<int64_t> dst(9, -1);
+    int64_t num_boxes_out = -1;
+    ASSERT_EQ(RC_SUCCESS,
+              ppl::kernel::x86::nms_ndarray_fp32(same_boxes.data(), same_scores.data(), 3, 1, 1, false, 3, 0.5f,
+                                                 0.0f, dst.data(), &num_boxes_out));
+    ASSERT_EQ(1, num_boxes_out);
+    EXPECT_EQ(1, dst[2]);
+}
+
+// box 1 covers box 0 and twice its area, so their iou is exactly 0.5, which suppresses only below 0.5
+TEST(NmsKernelTest, iou_threshold_boundary) {
+    const vector<float> boxes = {0, 0, 2, 2, 0, 0, 4, 2};
+    const vector<float> scores = {0.9f, 0.8f};
+    const float below = nextafterf(0.5f, 0.0f);
+    CheckNms(boxes, scores, 2, 1, 1, false, 2, 0.5f, 0.0f);
+    CheckNms(boxes, scores, 2, 1, 1, false, 2, below, 0.0f);
+
+    vector<int64_t> dst(6, -1);
+    int64_t num_boxes_out = -1;
+    ASSERT_EQ(RC_SUCCESS, ppl::kernel::x86::nms_ndarray_fp32(boxes.data(), scores.data(), 2, 1, 1, false, 2, 0.5f,
+                                                             0.0f, dst.data(), &num_boxes_out));
+    EXPECT_EQ(2, num_boxes_out);
+    ASSERT_EQ(RC_SUCCESS, ppl::kernel::x86::nms_ndarray_fp32(boxes.data(), scores.data(), 2, 1, 1, false, 2, below,
+                                                             0.0f, dst.data(), &num_boxes_out));
+    EXPECT_EQ(1, num_boxes_out);
+}
+
+// kept box indices as nms in mmcv, boxes are [x1, y1, x2, y2] and an overlap at the threshold suppresses
+static vector<int64_t> MmcvNmsRef(const vector<float>& boxes, const vector<float>& scores, float iou_threshold,
+                                  int64_t offset) {
+    const uint32_t num_boxes = scores.size();
+    auto area = [&boxes, offset](uint32_t i) {
+        const float* b = boxes.data() + i * 4;
+        return (b[2] - b[0] + offset) * (b[3] - b[1] + offset);
+    };
+    vector<int64_t> dst;
+    for (auto idx : SortByScore(scores.data(), num_boxes)) {
+        const float* a = boxes.data() + idx * 4;
+        bool keep = true;
+        for (auto s : dst) {
+            const float* b = boxes.data() + s * 4;
+            const float w = max(0.0f, min(a[2], b[2]) - max(a[0], b[0]) + offset);
+            const float h = max(0.0f, min(a[3], b[3]) - max(a[1], b[1]) + offset);
+            const float inter = w * h;
+            keep = keep && !(inter / (area(idx) + area(s) - inter) >= iou_threshold);
+        }
+        if (keep) {
+            dst.push_back(idx);
+        }
+    }
+    return dst;
+}
+
+static void CheckMmcvNms(const vector<float>& boxes, const vector<float>& scores, float iou_threshold,
+                         int64_t offset) {
+    auto ref = MmcvNmsRef(boxes, scores, iou_threshold, offset);
+    vector<int64_t> dst(scores.size(), -1);
+    int64_t num_boxes_out = -1;
+    ASSERT_EQ(RC_SUCCESS,
+              ppl::kernel::x86::mmcv_nms_ndarray_fp32(boxes.data(), scores.data(), scores.size(), iou_threshold,
+                                                      offset, dst.data(), &num_boxes_out));
+    ASSERT_EQ(int64_t(ref.size()), num_boxes_out) << "iou_threshold " << iou_threshold << ", offset " << offset;
+    dst.resize(ref.size());
+    EXPECT_EQ(ref, dst) << "iou_threshold " << iou_threshold << ", offset " << offset;
+}
+
+TEST(MmcvNmsKernelTest, matches_reference) {
+    const uint32_t num_boxes = 300;
+    vector<float> boxes, scores;
+    GenBoxes(num_boxes, 5, false, &boxes);
+    // mmcv boxes are [x1, y1, x2, y2] with x1 <= x2
+    for (uint32_t i = 0; i < num_boxes; ++i) {
+        float* box = boxes.data() + i * 4;
+        auto corners = ToCorners(box, false);
+        copy(corners.begin(), corners.end(), box);
+    }
+    for (uint32_t levels : {1, 10, 1000}) {
+        GenScores(num_boxes, 6, levels, &scores);
+        for (float iou_threshold : {0.0f, 0.3f, 0.5f, 0.9f}) {
+            CheckMmcvNms(boxes, scores, iou_threshold, 0);
+            CheckMmcvNms(boxes, scores, iou_threshold, 1);
+        }
+    }
+}
+
+// iou of the two boxes is exactly 0.5, which suppresses at a threshold of 0.5 but not above it
+TEST(MmcvNmsKernelTest, iou_threshold_boundary) {
+    const vector<float> boxes = {0, 0, 2, 2, 0, 0, 4, 2};
+    const vector<float> scores = {0.8f, 0.8f};
+    const float above = nextafterf(0.5f, 1.0f);
+    CheckMmcvNms(boxes, scores, 0.5f, 0);
+    CheckMmcvNms(boxes, scores, above, 0);
+
+    vector<int64_t> dst(2, -1);
+    int64_t num_boxes_out = -1;
+    ASSERT_EQ(RC_SUCCESS, ppl::kernel::x86::mmcv_nms_ndarray_fp32(boxes.data(), scores.data(), 2, 0.5f, 0,
+                                                                  dst.data(), &num_boxes_out));
+    ASSERT_EQ(1, num_boxes_out);
+    EXPECT_EQ(0, dst[0]);
+    ASSERT_EQ(RC_SUCCESS, ppl::kernel::x86::mmcv_nms_ndarray_fp32(boxes.data(), scores.data(), 2, above, 0,
+                                                                  dst.data(), &num_boxes_out));
+    EXPECT_EQ(2, num_boxes_out);
+}
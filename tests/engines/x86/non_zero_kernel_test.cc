@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/non_zero.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+
+// coordinates are written dim by dim in row-major order of the non-zero elements
+static vector<int64_t> NonZeroRef(const vector<int64_t>& dims, const vector<float>& src) {
+    vector<vector<int64_t>> coords;
+    vector<int64_t> idx(dims.size(), 0);
+    for (size_t i = 0; i < src.size(); ++i) {
+        if (src[i] != 0) {
+            coords.push_back(idx);
+        }
+        for (int64_t j = dims.size() - 1; j >= 0; --j) {
+            if (++idx[j] < dims[j]) {
+                break;
+            }
+            idx[j] = 0;
+        }
+    }
+    vector<int64_t> dst;
+    for (size_t j = 0; j < dims.size(); ++j) {
+        for (auto& c : coords) {
+            dst.push_back(c[j]);
+        }
+    }
+    return dst;
+}
+
+static void CheckNonZero(const vector<int64_t>& dims, const vector<float>& src) {
+    ppl::nn::TensorShape shape;
+    shape.SetDataType(DATATYPE_FLOAT32);
+    shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    shape.Reshape(dims);
+    auto ref = NonZeroRef(dims, src);
+
+    for (int32_t num_threads : {1, 3, 8}) {
+        auto prev_num_threads = ppl::kernel::x86::set_omp_num_threads(num_threads);
+        vector<char> temp_buffer(ppl::kernel::x86::non_zero_ndarray_fp32_get_buffer_bytes(&shape));
+        vector<int64_t> dst(src.size() * dims.size(), -1);
+        int64_t non_zero_num = -1;
+        auto rc = ppl::kernel::x86::non_zero_ndarray_fp32(&shape, src.data(), temp_buffer.data(), &non_zero_num,
+                                                          dst.data());
+        ppl::kernel::x86::set_omp_num_threads(prev_num_threads);
+        ASSERT_EQ(RC_SUCCESS, rc);
+        ASSERT_EQ(int64_t(ref.size() / dims.size()), non_zero_num) << "num_threads " << num_threads;
+        dst.resize(ref.size());
+        EXPECT_EQ(ref, dst) << "num_threads " << num_threads;
+    }
+}
+
+TEST(NonZeroKernelTest, sparse_3d) {
+    const vector<int64_t> dims = {7, 129, 65};
+    vector<float> src(7 * 129 * 65, 0.0f);
+    for (size_t i = 0; i < src.size(); ++i) {
+        if ((i * 2654435761u) % 13 == 0) {
+            src[i] = float(i % 5) - 2.0f;
+        }
+    }
+    CheckNonZero(dims, src);
+}
+
+TEST(NonZeroKernelTest, zeros_in_some_chunks_only) {
+    const vector<int64_t> dims = {4096, 8};
+    vector<float> src(4096 * 8, 0.0f);
+    for (size_t i = src.size() - 100; i < src.size(); ++i) {
+        src[i] = 1.0f;
+    }
+    src[3] = -1.0f;
+    CheckNonZero(dims, src);
+}
+
+TEST(NonZeroKernelTest, all_zero_and_tiny) {
+    CheckNonZero({64, 64}, vector<float>(64 * 64, 0.0f));
+    CheckNonZero({3}, {0.0f, 2.0f, 0.0f});
+}
@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static shared_ptr<void> MakeConvParam(int32_t kernel, int32_t pad, int32_t group) {
+    auto param = make_shared<common::ConvolutionParam>();
+    param->kernel_shape = {kernel, kernel};
+    param->dilations = {1, 1};
+    param->strides = {1, 1};
+    param->pads = {pad, pad, pad, pad};
+    param->group = group;
+    return param;
+}
+
+// conv1x1 -> relu -> depthwise conv3x3 is fused into a single PDConv node
+TEST(PDConvFusionTest, pointwise_relu_depthwise) {
+    const int64_t ic = 32, oc = 48, h = 9, w = 11;
+    const vector<int64_t> x_dims = {1, ic, h, w};
+
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("pw", ir::Node::Type("", "Conv"), {"x", "w1", "b1"}, {"y1"});
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"y1"}, {"r1"});
+    builder->AddNode("dw", ir::Node::Type("", "Conv"), {"r1", "w2", "b2"}, {"y"});
+    runner.SetParam("pw", MakeConvParam(1, 0, 1));
+    runner.SetParam("dw", MakeConvParam(3, 1, oc));
+
+    auto w1 = GenTestData(oc * ic, 1);
+    auto b1 = GenTestData(oc, 2);
+    auto w2 = GenTestData(oc * 9, 3);
+    auto b2 = GenTestData(oc, 4);
+    runner.SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+    runner.SetConstant("w1", DATATYPE_FLOAT32, {oc, ic, 1, 1}, w1);
+    runner.SetConstant("b1", DATATYPE_FLOAT32, {oc}, b1);
+    runner.SetConstant("w2", DATATYPE_FLOAT32, {oc, 1, 3, 3}, w2);
+    runner.SetConstant("b2", DATATYPE_FLOAT32, {oc}, b2);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(1, runner.CountNodes("PDConv"));
+    EXPECT_EQ(0, runner.CountNodes("Conv"));
+    EXPECT_EQ(0, runner.CountNodes("Relu"));
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(ic * h * w, 5);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    vector<float> y;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+
+    RefConvParam pw_param;
+    pw_param.kernel = {1, 1};
+    pw_param.strides = {1, 1};
+    pw_param.pads = {0, 0};
+    pw_param.dilations = {1, 1};
+    vector<int64_t> y1_dims;
+    auto y1 = RefConv(x, x_dims, w1, b1, oc, pw_param, &y1_dims);
+    for (auto& v : y1) {
+        v = max(v, 0.0f);
+    }
+    RefConvParam dw_param = pw_param;
+    dw_param.kernel = {3, 3};
+    dw_param.pads = {1, 1};
+    dw_param.group = oc;
+    auto y_ref = RefConv(y1, y1_dims, w2, b2, oc, dw_param);
+
+    ASSERT_EQ(y_ref.size(), y.size());
+    for (size_t i = 0; i < y.size(); ++i) {
+        EXPECT_NEAR(y_ref[i], y[i], 1e-4f) << "at " << i;
+    }
+}
+
+// the pointwise output has another consumer, so the pair must stay unfused
+TEST(PDConvFusionTest, no_fusion_when_intermediate_is_shared) {
+    const int64_t ic = 32, oc = 32;
+    X86GraphRunner runner;
+    auto builder = runner.GetGraphBuilder();
+    builder->AddNode("pw", ir::Node::Type("", "Conv"), {"x", "w1"}, {"y1"});
+    builder->AddNode("dw", ir::Node::Type("", "Conv"), {"y1", "w2"}, {"y"});
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"y1"}, {"r1"});
+    runner.SetParam("pw", MakeConvParam(1, 0, 1));
+    runner.SetParam("dw", MakeConvParam(3, 1, oc));
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {1, ic, 8, 8});
+    runner.SetConstant("w1", DATATYPE_FLOAT32, {oc, ic, 1, 1}, GenTestData(oc * ic, 1));
+    runner.SetConstant("w2", DATATYPE_FLOAT32, {oc, 1, 3, 3}, GenTestData(oc * 9, 2));
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    EXPECT_EQ(0, runner.CountNodes("PDConv"));
+    EXPECT_EQ(2, runner.CountNodes("Conv"));
+}
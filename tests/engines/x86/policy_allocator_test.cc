@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/policy_allocator.h"
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "gtest/gtest.h"
+#include <errno.h>
+#include <malloc.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+using namespace ppl::nn::x86;
+
+static const uint64_t g_huge_page_size = 2 * 1024 * 1024;
+
+// true if the page at `ptr` is not mapped any more
+static bool IsUnmapped(void* ptr) {
+    unsigned char vec = 0;
+    return (mincore(ptr, 4096, &vec) != 0 && errno == ENOMEM);
+}
+
+// buffers from the system allocator are known to malloc
+static bool IsFromSystemAllocator(void* ptr, uint64_t size) {
+    return malloc_usable_size(ptr) >= size;
+}
+
+// online nodes are listed as "0" on single node machines
+static bool HasMultipleNumaNodes() {
+    ifstream ifs("/sys/devices/system/node/online");
+    string content;
+    return ifs.is_open() && getline(ifs, content) && content.find_first_of("-,") != string::npos;
+}
+
+TEST(PolicyAllocatorTest, large_huge_page_buffer_is_mapped_and_2mb_aligned) {
+    PolicyAllocator allocator(64, X86_MEM_HUGE_PAGE);
+    const uint64_t size = 3 * g_huge_page_size + 100;
+    auto ptr = (char*)allocator.Alloc(size);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(0u, (uintptr_t)ptr % g_huge_page_size);
+    memset(ptr, 1, size);
+    EXPECT_EQ(1, ptr[size - 1]);
+
+    allocator.Free(ptr);
+    // the whole buffer is rounded up to huge pages and unmapped
+    EXPECT_TRUE(IsUnmapped(ptr));
+    EXPECT_TRUE(IsUnmapped(ptr + 3 * g_huge_page_size));
+}
+
+TEST(PolicyAllocatorTest, small_buffer_falls_back_to_system_allocator) {
+    PolicyAllocator allocator(64, X86_MEM_HUGE_PAGE);
+    vector<void*> ptrs;
+    for (uint64_t size : vector<uint64_t>{1, 100, 4096, g_huge_page_size - 1}) {
+        auto ptr = allocator.Alloc(size);
+        ASSERT_NE(nullptr, ptr);
+        EXPECT_EQ(0u, (uintptr_t)ptr % 64);
+        EXPECT_TRUE(IsFromSystemAllocator(ptr, size)) << "size " << size;
+        memset(ptr, 1, size);
+        ptrs.push_back(ptr);
+    }
+    for (auto ptr : ptrs) {
+        allocator.Free(ptr);
+    }
+    allocator.Free(nullptr);
+}
+
+// buffers mapped and allocated by the system allocator are freed by the one that allocates them
+TEST(PolicyAllocatorTest, free_mixed_buffers) {
+    PolicyAllocator allocator(64, X86_MEM_HUGE_PAGE);
+    auto small = allocator.Alloc(1024);
+    auto large = allocator.Alloc(g_huge_page_size);
+    auto small2 = allocator.Alloc(2048);
+    ASSERT_NE(nullptr, small);
+    ASSERT_NE(nullptr, large);
+    ASSERT_NE(nullptr, small2);
+
+    allocator.Free(small);
+    allocator.Free(large);
+    EXPECT_TRUE(IsUnmapped(large));
+    memset(small2, 1, 2048);
+    allocator.Free(small2);
+
+    // buffers that are not freed are unmapped by the destructor
+    allocator.Alloc(g_huge_page_size);
+}
+
+TEST(PolicyAllocatorTest, numa_policies_without_numa_nodes) {
+    const vector<uint32_t> policies = {X86_MEM_NUMA_LOCAL, X86_MEM_NUMA_INTERLEAVE, X86_MEM_NUMA_LOCAL | X86_MEM_HUGE_PAGE};
+    for (auto policy : policies) {
+        PolicyAllocator allocator(64, policy);
+        allocator.SetCpuSet({0});
+        const uint64_t size = 1024 * 1024;
+        auto ptr = allocator.Alloc(size);
+        ASSERT_NE(nullptr, ptr);
+        memset(ptr, 1, size);
+        if (HasMultipleNumaNodes()) {
+            // bound or not, large buffers are mapped pages
+            EXPECT_EQ(0u, (uintptr_t)ptr % 4096) << "policy " << policy;
+            allocator.Free(ptr);
+            EXPECT_TRUE(IsUnmapped(ptr)) << "policy " << policy;
+        } else {
+            // NUMA policies are ignored, and buffers smaller than a huge page come from the system allocator
+            EXPECT_TRUE(IsFromSystemAllocator(ptr, size)) << "policy " << policy;
+            allocator.Free(ptr);
+        }
+    }
+}
@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_TESTS_ENGINES_X86_REFERENCE_OPS_H_
+#define _ST_HPC_PPL_NN_TESTS_ENGINES_X86_REFERENCE_OPS_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ppl { namespace nn { namespace test {
+
+/** @brief spatial sizes and attributes of a 2d or 3d convolution, pads are symmetric */
+struct RefConvParam {
+    std::vector<int64_t> kernel;
+    std::vector<int64_t> strides;
+    std::vector<int64_t> pads;
+    std::vector<int64_t> dilations;
+    int64_t group = 1;
+};
+
+static inline std::vector<int64_t> RefConvOutputDims(const std::vector<int64_t>& src_dims, int64_t num_output,
+                                                     const RefConvParam& p) {
+    std::vector<int64_t> dst_dims = {src_dims[0], num_output};
+    for (size_t i = 0; i < p.kernel.size(); ++i) {
+        const int64_t ext_kernel = (p.kernel[i] - 1) * p.dilations[i] + 1;
+        dst_dims.push_back((src_dims[i + 2] + 2 * p.pads[i] - ext_kernel) / p.strides[i] + 1);
+    }
+    return dst_dims;
+}
+
+/** @brief naive NCHW/NCDHW convolution, `bias` may be empty */
+static inline std::vector<float> RefConv(const std::vector<float>& src, const std::vector<int64_t>& src_dims,
+                                         const std::vector<float>& filter, const std::vector<float>& bias,
+                                         int64_t num_output, const RefConvParam& p,
+                                         std::vector<int64_t>* out_dims = nullptr) {
+    const auto dst_dims = RefConvOutputDims(src_dims, num_output, p);
+    const size_t nsp = p.kernel.size();
+    int64_t src_space = 1, dst_space = 1, ker_space = 1;
+    for (size_t i = 0; i < nsp; ++i) {
+        src_space *= src_dims[i + 2];
+        dst_space *= dst_dims[i + 2];
+        ker_space *= p.kernel[i];
+    }
+    const int64_t batch = src_dims[0];
+    const int64_t ic_per_g = src_dims[1] / p.group;
+    const int64_t oc_per_g = num_output / p.group;
+
+    std::vector<float> dst(batch * num_output * dst_space);
+    std::vector<int64_t> opos(nsp), kpos(nsp);
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t oc = 0; oc < num_output; ++oc) {
+            const int64_t g = oc / oc_per_g;
+            for (int64_t o = 0; o < dst_space; ++o) {
+                for (int64_t r = o, i = nsp - 1; i >= 0; --i) {
+                    opos[i] = r % dst_dims[i + 2];
+                    r /= dst_dims[i + 2];
+                }
+                float sum = bias.empty() ? 0.0f : bias[oc];
+                for (int64_t ic = 0; ic < ic_per_g; ++ic) {
+                    const float* src_c = src.data() + (b * src_dims[1] + g * ic_per_g + ic) * src_space;
+                    const float* ker_c = filter.data() + (oc * ic_per_g + ic) * ker_space;
+                    for (int64_t k = 0; k < ker_space; ++k) {
+                        for (int64_t r = k, i = nsp - 1; i >= 0; --i) {
+                            kpos[i] = r % p.kernel[i];
+                            r /= p.kernel[i];
+                        }
+                        int64_t src_off = 0;
+                        bool inside = true;
+                        for (size_t i = 0; i < nsp; ++i) {
+                            const int64_t ipos = opos[i] * p.strides[i] - p.pads[i] + kpos[i] * p.dilations[i];
+                            if (ipos < 0 || ipos >= src_dims[i + 2]) {
+                                inside = false;
+                                break;
+                            }
+                            src_off = src_off * src_dims[i + 2] + ipos;
+                        }
+                        if (inside) {
+                            sum += src_c[src_off] * ker_c[k];
+                        }
+                    }
+                }
+                dst[(b * num_output + oc) * dst_space + o] = sum;
+            }
+        }
+    }
+    if (out_dims) {
+        *out_dims = dst_dims;
+    }
+    return dst;
+}
+
+/** @brief deterministic small values, exactly representable so results are stable across kernels */
+static inline std::vector<float> GenTestData(uint64_t count, uint32_t seed, int32_t mod = 7, int32_t shift = -3,
+                                             float scale = 0.125f) {
+    std::vector<float> data(count);
+    uint32_t state = seed * 2654435761u + 1;
+    for (uint64_t i = 0; i < count; ++i) {
+        state = state * 1103515245u + 12345u;
+        data[i] = (int32_t((state >> 16) % mod) + shift) * scale;
+    }
+    return data;
+}
+
+}}} // namespace ppl::nn::test
+
+#endif
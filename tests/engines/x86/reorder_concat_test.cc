@@ -0,0 +1,152 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <algorithm>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static const vector<int64_t> g_x_dims = {2, 8, 4, 5};
+static const vector<int64_t> g_b_dims = {2, 8, 4, 5};
+static const int64_t g_conv_channels = 16;
+static const int64_t g_head_channels = 16;
+
+static shared_ptr<void> MakePointwiseConvParam() {
+    auto param = make_shared<common::ConvolutionParam>();
+    param->kernel_shape = {1, 1};
+    param->dilations = {1, 1};
+    param->strides = {1, 1};
+    param->pads = {0, 0, 0, 0};
+    param->group = 1;
+    return param;
+}
+
+static RefConvParam MakePointwiseRefParam() {
+    RefConvParam param;
+    param.kernel = {1, 1};
+    param.strides = {1, 1};
+    param.pads = {0, 0};
+    param.dilations = {1, 1};
+    return param;
+}
+
+/*
+  x -> conv -> c (N16CX) --+
+                           +-> concat(axis 1) -> cat [-> conv_head -> y]
+  b -> relu -> rb (NDARRAY) +
+  without folding, a reorder is needed in front of the concat for the input whose format differs from the output,
+  and behind it when the head wants a format other than the one the concat writes.
+*/
+class ReorderConcatTest : public testing::Test {
+protected:
+    void Build(bool with_head) {
+        auto builder = runner_.GetGraphBuilder();
+        builder->AddNode("conv", ir::Node::Type("", "Conv"), {"x", "w"}, {"c"});
+        builder->AddNode("relu", ir::Node::Type("", "Relu"), {"b"}, {"rb"});
+        builder->AddNode("concat", ir::Node::Type("", "Concat"), {"c", "rb"}, {with_head ? "cat" : "y"});
+        if (with_head) {
+            builder->AddNode("conv_head", ir::Node::Type("", "Conv"), {"cat", "w_head"}, {"y"});
+            runner_.SetParam("conv_head", MakePointwiseConvParam());
+            w_head_ = GenTestData(g_head_channels * (g_conv_channels + g_b_dims[1]), 2);
+            runner_.SetConstant("w_head", DATATYPE_FLOAT32, {g_head_channels, g_conv_channels + g_b_dims[1], 1, 1},
+                                w_head_);
+        }
+
+        auto concat_param = make_shared<common::ConcatParam>();
+        concat_param->axis = 1;
+        runner_.SetParam("concat", concat_param);
+        runner_.SetParam("conv", MakePointwiseConvParam());
+
+        w_ = GenTestData(g_conv_channels * g_x_dims[1], 1);
+        runner_.SetInputShape("x", DATATYPE_FLOAT32, g_x_dims);
+        runner_.SetInputShape("b", DATATYPE_FLOAT32, g_b_dims);
+        runner_.SetConstant("w", DATATYPE_FLOAT32, {g_conv_channels, g_x_dims[1], 1, 1}, w_);
+        ASSERT_EQ(RC_SUCCESS, runner_.Process());
+    }
+
+    /** @brief runs the graph and compares `y` with the op-by-op result, in which every tensor is NDARRAY */
+    void RunAndCompare(bool with_head) {
+        unique_ptr<Runtime> runtime(runner_.CreateRuntime());
+        ASSERT_NE(nullptr, runtime.get());
+        auto x = GenTestData(g_x_dims[0] * g_x_dims[1] * g_x_dims[2] * g_x_dims[3], 3);
+        auto b = GenTestData(g_b_dims[0] * g_b_dims[1] * g_b_dims[2] * g_b_dims[3], 4);
+        ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", g_x_dims, x));
+        ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "b", g_b_dims, b));
+        ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+        vector<int64_t> c_dims;
+        auto c = RefConv(x, g_x_dims, w_, {}, g_conv_channels, MakePointwiseRefParam(), &c_dims);
+        const int64_t c_batch = c.size() / c_dims[0];
+        const int64_t b_batch = b.size() / g_b_dims[0];
+        vector<float> ref;
+        for (int64_t n = 0; n < g_x_dims[0]; ++n) {
+            ref.insert(ref.end(), c.begin() + n * c_batch, c.begin() + (n + 1) * c_batch);
+            for (int64_t i = n * b_batch; i < (n + 1) * b_batch; ++i) {
+                ref.push_back(max(b[i], 0.0f));
+            }
+        }
+        vector<int64_t> ref_dims = {g_x_dims[0], g_conv_channels + g_b_dims[1], g_x_dims[2], g_x_dims[3]};
+        if (with_head) {
+            ref = RefConv(ref, ref_dims, w_head_, {}, g_head_channels, MakePointwiseRefParam(), &ref_dims);
+        }
+
+        EXPECT_EQ(ref_dims, X86GraphRunner::GetOutputDims(runtime.get(), "y"));
+        vector<float> y;
+        ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime.get(), "y", &y));
+        ASSERT_EQ(ref.size(), y.size());
+        for (size_t i = 0; i < ref.size(); ++i) {
+            ASSERT_NEAR(ref[i], y[i], 1e-4f * max(1.0f, fabsf(ref[i]))) << "at " << i;
+        }
+    }
+
+protected:
+    X86GraphRunner runner_;
+    vector<float> w_, w_head_;
+};
+
+// the concat writes NDARRAY and reads the N16CX conv output without a reorder in front of it
+TEST_F(ReorderConcatTest, reorder_before_concat_is_folded) {
+    Build(false);
+    if (HasFatalFailure()) {
+        return;
+    }
+    EXPECT_EQ(0u, runner_.CountNodes("Reorder"));
+    EXPECT_EQ(DATAFORMAT_N16CX, runner_.GetOutputFormat("conv"));
+    EXPECT_EQ(DATAFORMAT_NDARRAY, runner_.GetOutputFormat("relu"));
+    EXPECT_EQ(DATAFORMAT_NDARRAY, runner_.GetOutputFormat("concat"));
+    RunAndCompare(false);
+}
+
+// the concat writes the N16CX input of the head conv itself, reading the NDARRAY relu output as it is
+TEST_F(ReorderConcatTest, reorder_after_concat_is_folded) {
+    Build(true);
+    if (HasFatalFailure()) {
+        return;
+    }
+    EXPECT_EQ(0u, runner_.CountNodes("Reorder"));
+    EXPECT_EQ(DATAFORMAT_N16CX, runner_.GetOutputFormat("conv"));
+    EXPECT_EQ(DATAFORMAT_NDARRAY, runner_.GetOutputFormat("relu"));
+    EXPECT_EQ(DATAFORMAT_N16CX, runner_.GetOutputFormat("concat"));
+    RunAndCompare(true);
+}
@@ -0,0 +1,305 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/nn/params/onnx/rnn_param.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <algorithm>
+#include <memory>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+using namespace ppl::nn::test;
+
+struct RnnCase {
+    rnn_cell_type_t cell;
+    rnn_direction_t direction;
+    int64_t seq_len, batch, input_size, hidden_size;
+    float clip;
+    int32_t input_forget, linear_before_reset;
+    bool with_bias, with_sequence_lens, with_initial, with_peephole;
+};
+
+static float Activate(float x, rnn_activation_t act) {
+    if (act == rnn_activation::sigmoid) {
+        return 1.0f / (1.0f + expf(-x));
+    }
+    if (act == rnn_activation::tanh) {
+        return tanhf(x);
+    }
+    return max(x, 0.0f);
+}
+
+static float Clip(float x, float clip) {
+    return clip > 0 ? min(max(x, -clip), clip) : x;
+}
+
+// straight from the onnx spec, one batch item and one timestep at a time
+static void RefRnn(const rnn_fp32_param& p, int64_t seq_len, int64_t batch, int64_t input_size, const float* X,
+                   const float* W, const float* R, const float* B, const int32_t* sequence_lens,
+                   const float* initial_h, const float* initial_c, const float* P, float* Y, float* Y_h, float* Y_c) {
+    const int64_t H = p.hidden_size;
+    const int64_t num_gate = rnn_num_gate(p.cell);
+    const int64_t num_direction = rnn_num_direction(p.direction);
+    const int64_t num_activation = rnn_num_activation(p.cell);
+    fill(Y, Y + seq_len * num_direction * batch * H, 0.0f);
+
+    for (int64_t d = 0; d < num_direction; ++d) {
+        const bool is_reverse = p.direction == rnn_direction::reverse || d == 1;
+        const rnn_activation_t* act = p.activations + d * num_activation;
+        const float* w = W + d * num_gate * H * input_size;
+        const float* r = R + d * num_gate * H * H;
+        const float* wb = B ? B + d * 2 * num_gate * H : nullptr;
+        const float* rb = B ? wb + num_gate * H : nullptr;
+        const float* peephole = P ? P + d * 3 * H : nullptr;
+
+        for (int64_t b = 0; b < batch; ++b) {
+            const int64_t len = sequence_lens ? sequence_lens[b] : seq_len;
+            vector<float> h(H, 0.0f), c(H, 0.0f), xw(num_gate * H), new_h(H);
+            if (initial_h) {
+                copy(initial_h + (d * batch + b) * H, initial_h + (d * batch + b + 1) * H, h.begin());
+            }
+            if (initial_c) {
+                copy(initial_c + (d * batch + b) * H, initial_c + (d * batch + b + 1) * H, c.begin());
+            }
+            auto recurrent = [&](int64_t n, const vector<float>& state) -> float {
+                double v = rb ? rb[n] : 0;
+                for (int64_t k = 0; k < H; ++k) {
+                    v += state[k] * r[n * H + k];
+                }
+                return (float)v;
+            };
+
+            for (int64_t s = 0; s < len; ++s) {
+                const int64_t t = is_reverse ? len - 1 - s : s;
+                const float* x = X + (t * batch + b) * input_size;
+                for (int64_t n = 0; n < num_gate * H; ++n) {
+                    double v = wb ? wb[n] : 0;
+                    for (int64_t k = 0; k < input_size; ++k) {
+                        v += x[k] * w[n * input_size + k];
+                    }
+                    xw[n] = (float)v;
+                }
+
+                if (p.cell == rnn_cell_type::lstm) { // gates i, o, f, c
+                    for (int64_t j = 0; j < H; ++j) {
+                        float gi = xw[j] + recurrent(j, h);
+                        float go = xw[H + j] + recurrent(H + j, h);
+                        float gf = xw[2 * H + j] + recurrent(2 * H + j, h);
+                        float gc = xw[3 * H + j] + recurrent(3 * H + j, h);
+                        if (peephole) {
+                            gi += peephole[j] * c[j];
+                            gf += peephole[2 * H + j] * c[j];
+                        }
+                        gi = Activate(Clip(gi, p.clip), act[0]);
+                        gf = p.input_forget ? 1.0f - gi : Activate(Clip(gf, p.clip), act[0]);
+                        gc = Activate(Clip(gc, p.clip), act[1]);
+                        const float new_c = gf * c[j] + gi * gc;
+                        if (peephole) {
+                            go += peephole[H + j] * new_c;
+                        }
+                        go = Activate(Clip(go, p.clip), act[0]);
+                        new_h[j] = go * Activate(new_c, act[2]);
+                        c[j] = new_c;
+                    }
+                } else if (p.cell == rnn_cell_type::gru) { // gates z, r, h
+                    vector<float> z(H), reset(H), reset_h(H);
+                    for (int64_t j = 0; j < H; ++j) {
+                        z[j] = Activate(Clip(xw[j] + recurrent(j, h), p.clip), act[0]);
+                        reset[j] = Activate(Clip(xw[H + j] + recurrent(H + j, h), p.clip), act[0]);
+                        reset_h[j] = reset[j] * h[j];
+                    }
+                    for (int64_t j = 0; j < H; ++j) {
+                        float gh;
+                        if (p.linear_before_reset) {
+                            gh = xw[2 * H + j] + reset[j] * recurrent(2 * H + j, h);
+                        } else {
+                            gh = xw[2 * H + j] + recurrent(2 * H + j, reset_h);
+                        }
+                        gh = Activate(Clip(gh, p.clip), act[1]);
+                        new_h[j] = (1.0f - z[j]) * gh + z[j] * h[j];
+                    }
+                } else {
+                    for (int64_t j = 0; j < H; ++j) {
+                        new_h[j] = Activate(Clip(xw[j] + recurrent(j, h), p.clip), act[0]);
+                    }
+                }
+
+                h = new_h;
+                copy(h.begin(), h.end(), Y + ((t * num_direction + d) * batch + b) * H);
+            }
+
+            copy(h.begin(), h.end(), Y_h + (d * batch + b) * H);
+            if (Y_c) {
+                copy(c.begin(), c.end(), Y_c + (d * batch + b) * H);
+            }
+        }
+    }
+}
+
+static void ExpectNear(const vector<float>& ref, const vector<float>& out, const char* what) {
+    ASSERT_EQ(ref.size(), out.size());
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ASSERT_NEAR(ref[i], out[i], 1e-4f) << what << " at " << i;
+    }
+}
+
+class RnnKernelTest : public testing::TestWithParam<RnnCase> {};
+
+TEST_P(RnnKernelTest, matches_reference) {
+    const auto& c = GetParam();
+    rnn_fp32_param p;
+    p.cell = c.cell;
+    p.direction = c.direction;
+    p.hidden_size = c.hidden_size;
+    p.clip = c.clip;
+    p.input_forget = c.input_forget;
+    p.linear_before_reset = c.linear_before_reset;
+    for (int32_t i = 0; i < 6; ++i) { // sigmoid first, tanh for the rest. rnn cells use relu.
+        p.activations[i] = (i % rnn_num_activation(c.cell) == 0) ? rnn_activation::sigmoid : rnn_activation::tanh;
+        if (c.cell == rnn_cell_type::rnn) {
+            p.activations[i] = (i % 2 == 0) ? rnn_activation::tanh : rnn_activation::relu;
+        }
+    }
+
+    const int64_t H = c.hidden_size;
+    const int64_t num_gate = rnn_num_gate(c.cell);
+    const int64_t num_direction = rnn_num_direction(c.direction);
+    const bool has_c = c.cell == rnn_cell_type::lstm;
+
+    const float scale = 0.0625f;
+    auto X = GenTestData(c.seq_len * c.batch * c.input_size, 1, 17, -8, scale);
+    auto W = GenTestData(num_direction * num_gate * H * c.input_size, 2, 17, -8, scale);
+    auto R = GenTestData(num_direction * num_gate * H * H, 3, 17, -8, scale);
+    auto B = GenTestData(num_direction * 2 * num_gate * H, 4, 17, -8, scale);
+    auto initial_h = GenTestData(num_direction * c.batch * H, 5, 17, -8, scale);
+    auto initial_c = GenTestData(num_direction * c.batch * H, 6, 17, -8, scale);
+    auto P = GenTestData(num_direction * 3 * H, 7, 17, -8, scale);
+    vector<int32_t> sequence_lens(c.batch);
+    for (int64_t b = 0; b < c.batch; ++b) {
+        sequence_lens[b] = 1 + (b * 5) % c.seq_len;
+    }
+    sequence_lens[0] = c.seq_len;
+
+    const float* b_ptr = c.with_bias ? B.data() : nullptr;
+    const int32_t* sl_ptr = c.with_sequence_lens ? sequence_lens.data() : nullptr;
+    const float* h0_ptr = c.with_initial ? initial_h.data() : nullptr;
+    const float* c0_ptr = (c.with_initial && has_c) ? initial_c.data() : nullptr;
+    const float* p_ptr = c.with_peephole ? P.data() : nullptr;
+
+    vector<float> ref_y(c.seq_len * num_direction * c.batch * H), ref_y_h(num_direction * c.batch * H);
+    vector<float> ref_y_c(has_c ? ref_y_h.size() : 0);
+    RefRnn(p, c.seq_len, c.batch, c.input_size, X.data(), W.data(), R.data(), b_ptr, sl_ptr, h0_ptr, c0_ptr, p_ptr,
+           ref_y.data(), ref_y_h.data(), has_c ? ref_y_c.data() : nullptr);
+
+    ppl::nn::TensorShape x_shape;
+    x_shape.Reshape({c.seq_len, c.batch, c.input_size});
+
+    vector<float> packed_R(rnn_fp32_get_packed_weight_bytes(p) / sizeof(float));
+    rnn_fp32_pack_weight(p, R.data(), packed_R.data());
+
+    // the sse isa runs the scalar step, fma the vectorized one
+    vector<isa_t> isas = {ISA_X86_SSE};
+    if (GetCpuISA() & ISA_X86_FMA) {
+        isas.push_back(ISA_X86_FMA | ISA_X86_AVX);
+    }
+    vector<vector<float>> isa_y;
+    for (auto isa : isas) {
+        for (bool prepacked : {false, true}) {
+            vector<uint8_t> temp(rnn_fp32_get_buffer_bytes(isa, &x_shape, p, prepacked));
+            // padding steps of short sequences must be written as zeros
+            vector<float> y(ref_y.size(), 7.0f), y_h(ref_y_h.size(), 7.0f), y_c(ref_y_c.size(), 7.0f);
+            ASSERT_EQ(RC_SUCCESS,
+                      rnn_fp32(isa, &x_shape, X.data(), W.data(), R.data(), prepacked ? packed_R.data() : nullptr,
+                               b_ptr, sl_ptr, h0_ptr, c0_ptr, p_ptr, p, temp.data(), y.data(), y_h.data(),
+                               has_c ? y_c.data() : nullptr));
+            SCOPED_TRACE(testing::Message() << "isa " << isa << (prepacked ? ", packed R" : ", R"));
+            ExpectNear(ref_y, y, "Y");
+            ExpectNear(ref_y_h, y_h, "Y_h");
+            ExpectNear(ref_y_c, y_c, "Y_c");
+            isa_y.push_back(y);
+        }
+    }
+    for (size_t i = 1; i < isa_y.size(); ++i) {
+        ExpectNear(isa_y[0], isa_y[i], "Y of the scalar step");
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    Cells, RnnKernelTest,
+    testing::Values(
+        // lstm: bidirectional with everything, peepholes, input_forget with clip, reverse with sequence_lens
+        RnnCase{rnn_cell_type::lstm, rnn_direction::bidirectional, 5, 3, 7, 19, 0, 0, 0, true, true, true, true},
+        RnnCase{rnn_cell_type::lstm, rnn_direction::forward, 4, 2, 9, 8, 0, 0, 0, false, false, false, true},
+        RnnCase{rnn_cell_type::lstm, rnn_direction::forward, 3, 5, 4, 13, 0.5f, 1, 0, true, false, true, false},
+        RnnCase{rnn_cell_type::lstm, rnn_direction::reverse, 6, 4, 5, 16, 0, 0, 0, true, true, false, false},
+        // gru: both linear_before_reset modes, bidirectional and reverse
+        RnnCase{rnn_cell_type::gru, rnn_direction::bidirectional, 5, 4, 6, 11, 0, 0, 1, true, true, true, false},
+        RnnCase{rnn_cell_type::gru, rnn_direction::reverse, 4, 3, 8, 24, 0, 0, 0, true, false, true, false},
+        RnnCase{rnn_cell_type::gru, rnn_direction::forward, 3, 6, 3, 5, 0.5f, 0, 0, false, true, false, false},
+        // rnn: tanh forward, relu backward
+        RnnCase{rnn_cell_type::rnn, rnn_direction::bidirectional, 4, 5, 10, 17, 0, 0, 0, true, true, true, false},
+        RnnCase{rnn_cell_type::rnn, rnn_direction::reverse, 6, 2, 7, 9, 0, 0, 0, true, false, false, false}));
+
+// runs lstm(x, w, r) with W: [1, w_gates * w_hidden, 5] and R: [1, r_gates * r_hidden, r_hidden]
+static RetCode ProcessLstm(int32_t hidden_size, int64_t w_gates, int64_t w_hidden, int64_t r_gates, int64_t r_hidden) {
+    ppl::nn::test::X86GraphRunner runner;
+    runner.GetGraphBuilder()->AddNode("lstm", ppl::nn::ir::Node::Type("", "LSTM"), {"x", "w", "r"}, {"y"});
+
+    auto param = make_shared<ppl::nn::common::RNNParam>();
+    param->direction = ppl::nn::common::RNNParam::DIR_FORWARD;
+    param->hidden_size = hidden_size;
+    param->clip = 0;
+    param->activations = {ppl::nn::common::RNNParam::ACT_SIGMOID, ppl::nn::common::RNNParam::ACT_TANH,
+                          ppl::nn::common::RNNParam::ACT_TANH};
+    param->input_forget = 0;
+    param->linear_before_reset = 0;
+    runner.SetParam("lstm", param);
+
+    runner.SetInputShape("x", DATATYPE_FLOAT32, {3, 2, 5});
+    runner.SetConstant("w", DATATYPE_FLOAT32, {1, w_gates * w_hidden, 5}, vector<float>(w_gates * w_hidden * 5));
+    runner.SetConstant("r", DATATYPE_FLOAT32, {1, r_gates * r_hidden, r_hidden},
+                       vector<float>(r_gates * r_hidden * r_hidden));
+    auto status = runner.Process();
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    unique_ptr<ppl::nn::Runtime> runtime(runner.CreateRuntime());
+    if (!runtime) {
+        return RC_OTHER_ERROR;
+    }
+    status = ppl::nn::test::X86GraphRunner::SetInputData(runtime.get(), "x", {3, 2, 5}, vector<float>(3 * 2 * 5));
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+    return runtime->Run();
+}
+
+TEST(RnnShapeTest, rejects_mismatched_hidden_size) {
+    EXPECT_EQ(RC_SUCCESS, ProcessLstm(4, 4, 4, 4, 4));
+    // no hidden_size attribute
+    EXPECT_NE(RC_SUCCESS, ProcessLstm(0, 4, 4, 4, 4));
+    // divisible by hidden_size, but gru sized
+    EXPECT_NE(RC_SUCCESS, ProcessLstm(4, 3, 4, 4, 4));
+    EXPECT_NE(RC_SUCCESS, ProcessLstm(2, 4, 4, 4, 4));
+    EXPECT_NE(RC_SUCCESS, ProcessLstm(4, 4, 4, 3, 4));
+    EXPECT_NE(RC_SUCCESS, ProcessLstm(4, 4, 4, 2, 8));
+}
@@ -0,0 +1,219 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#include <sched.h>
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/engines/x86/x86_device.h"
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::nn::x86;
+using namespace ppl::common;
+
+static vector<int32_t> GetCallerCpus() {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    vector<int32_t> cpus;
+    for (int32_t i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &cpuset)) {
+            cpus.push_back(i);
+        }
+    }
+    return cpus;
+}
+
+// kernels of a bound device, an unbound device and another bound device run one after another on the same thread
+TEST(ThreadingScopeTest, caller_affinity_follows_device_switches) {
+    const vector<int32_t> orig_cpus = GetCallerCpus();
+    if (orig_cpus.size() < 2) {
+        GTEST_SKIP() << "needs at least 2 cpus";
+    }
+
+    X86Device first(64, GetCpuISA()), unbound(64, GetCpuISA()), second(64, GetCpuISA());
+    first.SetCpuSet({orig_cpus[0]});
+    second.SetCpuSet({orig_cpus[1]});
+
+    {
+        X86Device::ThreadingScope scope(&first);
+        EXPECT_EQ(vector<int32_t>({orig_cpus[0]}), GetCallerCpus());
+    }
+    EXPECT_EQ(orig_cpus, GetCallerCpus());
+
+    {
+        X86Device::ThreadingScope scope(&unbound);
+        EXPECT_EQ(orig_cpus, GetCallerCpus());
+    }
+
+    {
+        X86Device::ThreadingScope scope(&second);
+        EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), GetCallerCpus());
+    }
+    EXPECT_EQ(orig_cpus, GetCallerCpus());
+}
+
+static void SetCallerCpus(const vector<int32_t>& cpus) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &cpuset);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+}
+
+// kernels of the device bound by a run do not bind again, others switch the binding and switch it back
+TEST(ThreadingScopeTest, run_scope_binds_once) {
+    const vector<int32_t> orig_cpus = GetCallerCpus();
+    if (orig_cpus.size() < 2) {
+        GTEST_SKIP() << "needs at least 2 cpus";
+    }
+
+    X86Device device(64, GetCpuISA()), unbound(64, GetCpuISA()), other(64, GetCpuISA());
+    device.SetCpuSet({orig_cpus[1]});
+    other.SetCpuSet({orig_cpus[0]});
+
+    {
+        X86Device::RunScope run_scope(&device);
+        EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), GetCallerCpus());
+
+        // changed behind the back of the device to tell whether kernels bind again
+        SetCallerCpus({orig_cpus[0]});
+        {
+            X86Device::ThreadingScope scope(&device);
+            EXPECT_EQ(vector<int32_t>({orig_cpus[0]}), GetCallerCpus());
+        }
+        SetCallerCpus({orig_cpus[1]});
+
+        {
+            X86Device::ThreadingScope scope(&unbound);
+            EXPECT_EQ(orig_cpus, GetCallerCpus());
+        }
+        EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), GetCallerCpus());
+
+        {
+            X86Device::ThreadingScope scope(&other);
+            EXPECT_EQ(vector<int32_t>({orig_cpus[0]}), GetCallerCpus());
+        }
+        EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), GetCallerCpus());
+    }
+    EXPECT_EQ(orig_cpus, GetCallerCpus());
+}
+
+// the runtime binds the calling thread for a run and gives it its affinity back afterwards
+TEST(ThreadingScopeTest, runtime_restores_caller_affinity_after_run) {
+    const vector<int32_t> orig_cpus = GetCallerCpus();
+    if (orig_cpus.size() < 2) {
+        GTEST_SKIP() << "needs at least 2 cpus";
+    }
+
+    const vector<int64_t> dims = {1, 64};
+    X86GraphRunner runner;
+    const int32_t cpus[] = {orig_cpus[1]};
+    ASSERT_EQ(RC_SUCCESS, runner.GetEngine()->Configure(X86_CONF_SET_CPU_SET, cpus, 1u));
+    runner.GetGraphBuilder()->AddNode("relu", ir::Node::Type("", "Relu"), {"x"}, {"y"});
+    runner.SetInputShape("x", DATATYPE_FLOAT32, dims);
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", dims, GenTestData(64, 1)));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+    EXPECT_EQ(orig_cpus, GetCallerCpus());
+}
+
+// kernels using the thread pool leave the binding to the pool
+TEST(ThreadingScopeTest, thread_pool_kernels_do_not_bind_openmp_threads) {
+    const vector<int32_t> orig_cpus = GetCallerCpus();
+    if (orig_cpus.size() < 2) {
+        GTEST_SKIP() << "needs at least 2 cpus";
+    }
+
+    X86Device device(64, GetCpuISA());
+    device.SetCpuSet({orig_cpus[1]});
+    device.SetParallelBackend(X86_PARALLEL_THREAD_POOL);
+    {
+        X86Device::ThreadingScope scope(&device, true);
+        EXPECT_EQ(orig_cpus, GetCallerCpus());
+    }
+    {
+        X86Device::ThreadingScope scope(&device, false);
+        EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), GetCallerCpus());
+    }
+    EXPECT_EQ(orig_cpus, GetCallerCpus());
+}
+
+#ifdef _OPENMP
+// OpenMP threads reused by the caller are bound inside the scope and get their affinity back after it
+TEST(ThreadingScopeTest, omp_thread_affinity_is_restored) {
+    const vector<int32_t> orig_cpus = GetCallerCpus();
+    if (orig_cpus.size() < 2) {
+        GTEST_SKIP() << "needs at least 2 cpus";
+    }
+
+    vector<vector<int32_t>> worker_cpus(2);
+    auto collect_worker_cpus = [&worker_cpus]() {
+#pragma omp parallel num_threads(2)
+        { worker_cpus[omp_get_thread_num()] = GetCallerCpus(); }
+    };
+
+    collect_worker_cpus();
+    const vector<vector<int32_t>> orig_worker_cpus = worker_cpus;
+
+    X86Device device(64, GetCpuISA());
+    device.SetCpuSet({orig_cpus[0], orig_cpus[1]});
+    {
+        X86Device::ThreadingScope scope(&device);
+        EXPECT_EQ(2, omp_get_max_threads());
+        collect_worker_cpus();
+        EXPECT_EQ(vector<int32_t>({orig_cpus[0]}), worker_cpus[0]);
+        EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), worker_cpus[1]);
+    }
+
+    collect_worker_cpus();
+    EXPECT_EQ(orig_worker_cpus, worker_cpus);
+}
+#endif
+
+// the caller of a pool with cores runs jobs on the first core and keeps its own affinity after them
+TEST(ThreadPoolTest, caller_affinity_is_restored_after_run) {
+    const vector<int32_t> orig_cpus = GetCallerCpus();
+    if (orig_cpus.size() < 2) {
+        GTEST_SKIP() << "needs at least 2 cpus";
+    }
+
+    ppl::kernel::x86::thread_pool pool(1, &orig_cpus[1]);
+    vector<int32_t> job_cpus;
+    pool.run(
+        [](void* ctx, const int32_t, const int32_t) {
+            *(vector<int32_t>*)ctx = GetCallerCpus();
+        },
+        &job_cpus);
+    EXPECT_EQ(vector<int32_t>({orig_cpus[1]}), job_cpus);
+    EXPECT_EQ(orig_cpus, GetCallerCpus());
+}
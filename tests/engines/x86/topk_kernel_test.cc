@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/topk.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+
+/*
+  top-k along `axis` by a stable sort of the whole row, so equal values keep the lower index first. `values` and
+  `indices` are laid out as the outputs of TopK.
+*/
+static void TopKRef(const vector<int64_t>& dims, const vector<float>& src, int64_t k, int32_t axis, bool largest,
+                    vector<float>* values, vector<int64_t>* indices) {
+    int64_t outer_dim = 1, inner_dim = 1;
+    for (int32_t i = 0; i < axis; ++i) {
+        outer_dim *= dims[i];
+    }
+    for (size_t i = axis + 1; i < dims.size(); ++i) {
+        inner_dim *= dims[i];
+    }
+    const int64_t axis_dim = dims[axis];
+    values->resize(outer_dim * k * inner_dim);
+    indices->resize(outer_dim * k * inner_dim);
+    vector<int64_t> row(axis_dim);
+    for (int64_t od = 0; od < outer_dim; ++od) {
+        for (int64_t id = 0; id < inner_dim; ++id) {
+            const float* l_src = src.data() + od * axis_dim * inner_dim + id;
+            for (int64_t i = 0; i < axis_dim; ++i) {
+                row[i] = i;
+            }
+            stable_sort(row.begin(), row.end(), [l_src, inner_dim, largest](int64_t a, int64_t b) {
+                return largest ? l_src[a * inner_dim] > l_src[b * inner_dim]
+                               : l_src[a * inner_dim] < l_src[b * inner_dim];
+            });
+            for (int64_t i = 0; i < k; ++i) {
+                (*values)[(od * k + i) * inner_dim + id] = l_src[row[i] * inner_dim];
+                (*indices)[(od * k + i) * inner_dim + id] = row[i];
+            }
+        }
+    }
+}
+
+// unsorted outputs may come in any order, so each output row is compared as a set of indices
+static void SortOutputRows(const vector<int64_t>& dims, int64_t k, int32_t axis, vector<float>* values,
+                           vector<int64_t>* indices) {
+    int64_t outer_dim = 1, inner_dim = 1;
+    for (int32_t i = 0; i < axis; ++i) {
+        outer_dim *= dims[i];
+    }
+    for (size_t i = axis + 1; i < dims.size(); ++i) {
+        inner_dim *= dims[i];
+    }
+    vector<pair<int64_t, float>> row(k);
+    for (int64_t od = 0; od < outer_dim; ++od) {
+        for (int64_t id = 0; id < inner_dim; ++id) {
+            const int64_t base = od * k * inner_dim + id;
+            for (int64_t i = 0; i < k; ++i) {
+                row[i] = make_pair((*indices)[base + i * inner_dim], (*values)[base + i * inner_dim]);
+            }
+            sort(row.begin(), row.end());
+            for (int64_t i = 0; i < k; ++i) {
+                (*indices)[base + i * inner_dim] = row[i].first;
+                (*values)[base + i * inner_dim] = row[i].second;
+            }
+        }
+    }
+}
+
+static void CheckTopK(const vector<int64_t>& dims, const vector<float>& src, int64_t k, int32_t axis,
+                      int32_t num_threads) {
+    ppl::nn::TensorShape src_shape;
+    src_shape.SetDataType(DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    src_shape.Reshape(dims);
+    auto dst_dims = dims;
+    dst_dims[axis] = k;
+    ppl::nn::TensorShape dst_shape(src_shape);
+    dst_shape.Reshape(dst_dims);
+
+    for (int32_t largest : {1, 0}) {
+        vector<float> ref_values;
+        vector<int64_t> ref_indices;
+        TopKRef(dims, src, k, axis, largest, &ref_values, &ref_indices);
+        for (int32_t sorted : {1, 0}) {
+            SCOPED_TRACE(testing::Message() << "k " << k << ", axis " << axis << ", largest " << largest
+                                            << ", sorted " << sorted << ", num_threads " << num_threads);
+            auto prev_num_threads = ppl::kernel::x86::set_omp_num_threads(num_threads);
+            vector<char> temp_buffer(ppl::kernel::x86::topk_ndarray_fp32_get_buffer_bytes(&src_shape, axis));
+            vector<float> values(ref_values.size());
+            vector<int64_t> indices(ref_indices.size(), -1);
+            auto rc = ppl::kernel::x86::topk_ndarray_fp32(&src_shape, &dst_shape, &dst_shape, src.data(), k, axis,
+                                                          largest, sorted, temp_buffer.data(), values.data(),
+                                                          indices.data());
+            ppl::kernel::x86::set_omp_num_threads(prev_num_threads);
+            ASSERT_EQ(RC_SUCCESS, rc);
+
+            auto expected_values = ref_values;
+            auto expected_indices = ref_indices;
+            if (!sorted) {
+                SortOutputRows(dims, k, axis, &values, &indices);
+                SortOutputRows(dims, k, axis, &expected_values, &expected_indices);
+            }
+            EXPECT_EQ(expected_indices, indices);
+            EXPECT_EQ(expected_values, values);
+        }
+    }
+}
+
+// few distinct values, so most rows hold runs of duplicates which must be taken by the lower index first
+static vector<float> GenValues(int64_t count, uint32_t seed, uint32_t levels) {
+    vector<float> src(count);
+    uint32_t state = seed;
+    for (int64_t i = 0; i < count; ++i) {
+        state = state * 1664525u + 1013904223u;
+        src[i] = float((state >> 8) % levels) - levels / 2;
+    }
+    return src;
+}
+
+// k * 8 <= 50 takes the bounded heap up to k = 6, larger k selects with nth_element
+TEST(TopKKernelTest, rows_on_each_axis) {
+    const vector<int64_t> dims = {3, 50, 4};
+    const auto src = GenValues(3 * 50 * 4, 1, 9);
+    for (int64_t k : {1, 6, 7, 49, 50}) {
+        CheckTopK(dims, src, k, 1, 1);
+    }
+    for (int64_t k : {1, 3}) {
+        CheckTopK(dims, src, k, 0, 1);
+        CheckTopK(dims, src, k, 2, 1);
+    }
+}
+
+TEST(TopKKernelTest, distinct_and_equal_values) {
+    const vector<int64_t> dims = {2, 300};
+    for (uint32_t levels : {1, 2, 100000}) {
+        const auto src = GenValues(2 * 300, 2, levels);
+        for (int64_t k : {1, 37, 128, 300}) {
+            CheckTopK(dims, src, k, 1, 1);
+        }
+    }
+}
+
+// a single long row is split into segments on several threads, whose partial top-k are merged
+TEST(TopKKernelTest, segmented_row) {
+    const vector<int64_t> dims = {1, 20000};
+    for (uint32_t levels : {7, 100000}) {
+        const auto src = GenValues(20000, 3, levels);
+        for (int64_t k : {1, 100, 129, 2000, 5000, 20000}) {
+            CheckTopK(dims, src, k, 1, 4);
+        }
+    }
+    // two rows of segments with the segments strided by the inner dim
+    const vector<int64_t> strided_dims = {1, 9000, 2};
+    const auto src = GenValues(18000, 4, 31);
+    for (int64_t k : {5, 1000}) {
+        CheckTopK(strided_dims, src, k, 1, 4);
+    }
+}
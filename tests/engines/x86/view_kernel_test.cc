@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "tests/engines/x86/reference_ops.h"
+#include "ppl/nn/params/onnx/split_param.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <limits>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+static vector<float> Relu(const vector<float>& src) {
+    vector<float> dst(src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        dst[i] = max(src[i], 0.0f);
+    }
+    return dst;
+}
+
+// src[b[0]:e[0], b[1]:e[1], b[2]:e[2], b[3]:e[3]] of a 4-d ndarray
+static vector<float> SliceRef(const vector<float>& src, const vector<int64_t>& dims, const vector<int64_t>& b,
+                              const vector<int64_t>& e) {
+    vector<float> dst;
+    for (int64_t n = b[0]; n < e[0]; ++n) {
+        for (int64_t c = b[1]; c < e[1]; ++c) {
+            for (int64_t h = b[2]; h < e[2]; ++h) {
+                for (int64_t w = b[3]; w < e[3]; ++w) {
+                    dst.push_back(src[((n * dims[1] + c) * dims[2] + h) * dims[3] + w]);
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+static void ExpectOutputEq(Runtime* runtime, const string& name, const vector<float>& ref) {
+    vector<float> out;
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::GetOutputData(runtime, name, &out));
+    ASSERT_EQ(ref.size(), out.size()) << name;
+    for (size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_EQ(ref[i], out[i]) << name << " at " << i;
+    }
+}
+
+static ptrdiff_t GetOutputDistance(Runtime* runtime, const string& from, const string& to) {
+    return (const char*)X86GraphRunner::GetOutputBufferPtr(runtime, to) -
+        (const char*)X86GraphRunner::GetOutputBufferPtr(runtime, from);
+}
+
+// relu -> slice(name, starts, ends, axes) for every slice
+static void AddSlices(X86GraphRunner* runner, const vector<int64_t>& x_dims,
+                      const vector<vector<vector<int64_t>>>& slices) {
+    auto builder = runner->GetGraphBuilder();
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"x"}, {"r"});
+    for (size_t i = 0; i < slices.size(); ++i) {
+        const string id = to_string(i);
+        builder->AddNode("slice" + id, ir::Node::Type("", "Slice"), {"r", "starts" + id, "ends" + id, "axes" + id},
+                         {"s" + id});
+        const vector<int64_t> dims = {(int64_t)slices[i][0].size()};
+        runner->SetConstant("starts" + id, DATATYPE_INT64, dims, slices[i][0]);
+        runner->SetConstant("ends" + id, DATATYPE_INT64, dims, slices[i][1]);
+        runner->SetConstant("axes" + id, DATATYPE_INT64, dims, slices[i][2]);
+    }
+    runner->SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+}
+
+// slices along channels are views of the relu output, negative starts counting from the end or clamped to 0
+TEST(ViewKernelTest, slice_along_leading_axis_is_view) {
+    const vector<int64_t> x_dims = {1, 4, 4, 4};
+    const int64_t max_end = numeric_limits<int64_t>::max();
+
+    X86GraphRunner runner;
+    AddSlices(&runner, x_dims, {{{-100}, {2}, {1}}, {{-2}, {max_end}, {1}}});
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(4 * 4 * 4, 1);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    auto r = Relu(x);
+    ExpectOutputEq(runtime.get(), "s0", SliceRef(r, x_dims, {0, 0, 0, 0}, {1, 2, 4, 4}));
+    ExpectOutputEq(runtime.get(), "s1", SliceRef(r, x_dims, {0, 2, 0, 0}, {1, 4, 4, 4}));
+    EXPECT_EQ(ptrdiff_t(2 * 4 * 4 * sizeof(float)), GetOutputDistance(runtime.get(), "s0", "s1"));
+}
+
+// a crop of the inner axes is not contiguous in the input and is copied
+TEST(ViewKernelTest, slice_cropping_inner_axes_is_copied) {
+    const vector<int64_t> x_dims = {1, 1, 32, 32};
+
+    X86GraphRunner runner;
+    AddSlices(&runner, x_dims, {{{0, 0}, {16, 16}, {2, 3}}, {{16, -16}, {32, 32}, {2, 3}}});
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(32 * 32, 2);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    auto r = Relu(x);
+    ExpectOutputEq(runtime.get(), "s0", SliceRef(r, x_dims, {0, 0, 0, 0}, {1, 1, 16, 16}));
+    ExpectOutputEq(runtime.get(), "s1", SliceRef(r, x_dims, {0, 0, 16, 16}, {1, 1, 32, 32}));
+}
+
+static shared_ptr<void> MakeSplitParam(int32_t axis, const vector<int32_t>& split_point) {
+    auto param = make_shared<common::SplitParam>();
+    param->axis = axis;
+    param->split_point = split_point;
+    return param;
+}
+
+// relu -> split(axis) -> y0, y1
+static void AddSplit(X86GraphRunner* runner, const vector<int64_t>& x_dims, int32_t axis,
+                     const vector<int32_t>& split_point) {
+    auto builder = runner->GetGraphBuilder();
+    builder->AddNode("relu", ir::Node::Type("", "Relu"), {"x"}, {"r"});
+    builder->AddNode("split", ir::Node::Type("", "Split"), {"r"}, {"y0", "y1"});
+    runner->SetParam("split", MakeSplitParam(axis, split_point));
+    runner->SetInputShape("x", DATATYPE_FLOAT32, x_dims);
+}
+
+TEST(ViewKernelTest, split_along_leading_axis_is_view) {
+    const vector<int64_t> x_dims = {1, 6, 4, 4};
+
+    X86GraphRunner runner;
+    AddSplit(&runner, x_dims, 1, {4, 2});
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(6 * 4 * 4, 3);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    auto r = Relu(x);
+    ExpectOutputEq(runtime.get(), "y0", SliceRef(r, x_dims, {0, 0, 0, 0}, {1, 4, 4, 4}));
+    ExpectOutputEq(runtime.get(), "y1", SliceRef(r, x_dims, {0, 4, 0, 0}, {1, 6, 4, 4}));
+    EXPECT_EQ(ptrdiff_t(4 * 4 * 4 * sizeof(float)), GetOutputDistance(runtime.get(), "y0", "y1"));
+}
+
+// outputs of a split after a non-unit axis interleave in the input and are copied
+TEST(ViewKernelTest, split_after_non_unit_axis_is_copied) {
+    const vector<int64_t> x_dims = {2, 6, 4, 4};
+
+    X86GraphRunner runner;
+    AddSplit(&runner, x_dims, 1, {4, 2});
+    ASSERT_EQ(RC_SUCCESS, runner.Process());
+
+    unique_ptr<Runtime> runtime(runner.CreateRuntime());
+    ASSERT_NE(nullptr, runtime.get());
+    auto x = GenTestData(2 * 6 * 4 * 4, 4);
+    ASSERT_EQ(RC_SUCCESS, X86GraphRunner::SetInputData(runtime.get(), "x", x_dims, x));
+    ASSERT_EQ(RC_SUCCESS, runtime->Run());
+
+    auto r = Relu(x);
+    ExpectOutputEq(runtime.get(), "y0", SliceRef(r, x_dims, {0, 0, 0, 0}, {2, 4, 4, 4}));
+    ExpectOutputEq(runtime.get(), "y1", SliceRef(r, x_dims, {0, 4, 0, 0}, {2, 6, 4, 4}));
+}
@@ -0,0 +1,181 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/nn/optimizers/utils.h"
+#include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace test {
+
+X86GraphRunner::X86GraphRunner()
+    : resource_(make_shared<utils::SharedResource>())
+    , graph_info_(make_shared<RuntimeGraphInfo>())
+    , aux_info_(make_shared<RuntimeAuxInfo>()) {
+    resource_->engines.emplace_back(unique_ptr<EngineImpl>(static_cast<EngineImpl*>(X86EngineFactory::Create())));
+}
+
+void X86GraphRunner::SetInputShape(const string& name, datatype_t data_type, const vector<int64_t>& dims) {
+    auto graph = builder_.GetGraph();
+    auto edge = graph->topo->GetEdgeByName(name);
+    auto& shape = graph->data->shapes[edge->GetId()];
+    shape.data_type = data_type;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+}
+
+void X86GraphRunner::SetConstant(const string& name, datatype_t data_type, const vector<int64_t>& dims,
+                                 const void* data, uint64_t bytes) {
+    auto graph = builder_.GetGraph();
+    auto edge = graph->topo->GetEdgeByName(name);
+    graph->topo->MarkAsConstant(edge->GetId());
+    graph->data->constants[edge->GetId()].data.assign((const char*)data, bytes);
+    SetInputShape(name, data_type, dims);
+}
+
+void X86GraphRunner::SetParam(const string& node_name, const shared_ptr<void>& param) {
+    auto graph = builder_.GetGraph();
+    for (auto it = graph->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        if (it->Get()->GetName() == node_name) {
+            graph->data->attrs[it->Get()->GetId()] = param;
+            return;
+        }
+    }
+}
+
+RetCode X86GraphRunner::Process() {
+    auto graph = builder_.GetGraph();
+    auto topo = graph->topo.get();
+    for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+        auto edge = it->Get();
+        if (edge->GetProducer() == INVALID_NODEID && topo->GetConstant(edge->GetName()) == INVALID_EDGEID) {
+            topo->MarkAsInput(edge->GetId());
+        }
+        if (edge->CalcConsumerCount() == 0) {
+            topo->MarkAsOutput(edge->GetId());
+        }
+    }
+
+    auto status = utils::ProcessGraph(resource_.get(), graph, graph_info_.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "process graph failed: " << GetRetCodeStr(status);
+        return status;
+    }
+    return GenerateRuntimeAuxInfo(*graph_info_, aux_info_.get());
+}
+
+const x86::X86OptKernel* X86GraphRunner::GetOptKernel(const string& node_name) const {
+    for (auto it = graph_info_->kernels.begin(); it != graph_info_->kernels.end(); ++it) {
+        if (it->op->GetNode()->GetName() == node_name) {
+            return static_cast<const x86::X86OptKernel*>(it->op.get());
+        }
+    }
+    return nullptr;
+}
+
+dataformat_t X86GraphRunner::GetOutputFormat(const string& node_name, uint32_t idx) const {
+    auto kernel = GetOptKernel(node_name);
+    return kernel ? kernel->GetOutputDataFormat(idx) : DATAFORMAT_UNKNOWN;
+}
+
+uint32_t X86GraphRunner::CountNodes(const string& op_type) const {
+    uint32_t count = 0;
+    for (auto it = builder_.GetGraph()->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        if (it->Get()->GetType().name == op_type) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+Runtime* X86GraphRunner::CreateRuntime() {
+    auto runtime = new RuntimeImpl();
+    auto status = runtime->Init(RuntimeOptions(), builder_.GetGraph()->topo, graph_info_, aux_info_, resource_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init runtime failed: " << GetRetCodeStr(status);
+        delete runtime;
+        return nullptr;
+    }
+    return runtime;
+}
+
+static Tensor* FindTensor(Runtime* runtime, const string& name, bool is_input) {
+    const uint32_t count = is_input ? runtime->GetInputCount() : runtime->GetOutputCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        auto tensor = is_input ? runtime->GetInputTensor(i) : runtime->GetOutputTensor(i);
+        if (name == tensor->GetName()) {
+            return tensor;
+        }
+    }
+    return nullptr;
+}
+
+RetCode X86GraphRunner::SetInputData(Runtime* runtime, const string& name, const vector<int64_t>& dims,
+                                     const vector<float>& data) {
+    auto tensor = FindTensor(runtime, name, true);
+    if (!tensor) {
+        return RC_NOT_FOUND;
+    }
+
+    TensorShape src_desc;
+    src_desc.SetDataType(DATATYPE_FLOAT32);
+    src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    src_desc.Reshape(dims);
+
+    auto& shape = tensor->GetShape();
+    shape.SetDataType(DATATYPE_FLOAT32);
+    shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    shape.Reshape(dims);
+    auto status = tensor->ReallocBuffer();
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+    return tensor->ConvertFromHost(data.data(), src_desc);
+}
+
+RetCode X86GraphRunner::GetOutputData(Runtime* runtime, const string& name, vector<float>* data) {
+    auto tensor = FindTensor(runtime, name, false);
+    if (!tensor) {
+        return RC_NOT_FOUND;
+    }
+
+    TensorShape dst_desc = tensor->GetShape();
+    dst_desc.SetDataType(DATATYPE_FLOAT32);
+    dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    data->resize(dst_desc.GetElementsExcludingPadding());
+    return tensor->ConvertToHost(data->data(), dst_desc);
+}
+
+vector<int64_t> X86GraphRunner::GetOutputDims(Runtime* runtime, const string& name) {
+    auto tensor = FindTensor(runtime, name, false);
+    if (!tensor) {
+        return vector<int64_t>();
+    }
+    auto& shape = tensor->GetShape();
+    return vector<int64_t>(shape.GetDims(), shape.GetDims() + shape.GetRealDimCount());
+}
+
+const void* X86GraphRunner::GetOutputBufferPtr(Runtime* runtime, const string& name) {
+    auto tensor = FindTensor(runtime, name, false);
+    return tensor ? static_cast<TensorImpl*>(tensor)->GetBufferPtr() : nullptr;
+}
+
+}}} // namespace ppl::nn::test
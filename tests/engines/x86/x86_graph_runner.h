@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_TESTS_ENGINES_X86_X86_GRAPH_RUNNER_H_
+#define _ST_HPC_PPL_NN_TESTS_ENGINES_X86_X86_GRAPH_RUNNER_H_
+
+#include "ppl/nn/engines/engine_impl.h"
+#include "ppl/nn/runtime/runtime.h"
+#include "ppl/nn/runtime/runtime_graph_info.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/utils/shared_resource.h"
+#include "tests/ir/graph_builder.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+class X86OptKernel;
+}}} // namespace ppl::nn::x86
+
+namespace ppl { namespace nn { namespace test {
+
+/** @brief optimizes a graph built by `GraphBuilder` with an x86 engine and creates runtimes of it */
+class X86GraphRunner final {
+public:
+    X86GraphRunner();
+
+    GraphBuilder* GetGraphBuilder() {
+        return &builder_;
+    }
+    /** @note options MUST be set before `Process()` */
+    EngineImpl* GetEngine() const {
+        return resource_->engines[0].get();
+    }
+
+    void SetInputShape(const std::string& name, ppl::common::datatype_t data_type, const std::vector<int64_t>& dims);
+    void SetConstant(const std::string& name, ppl::common::datatype_t data_type, const std::vector<int64_t>& dims,
+                     const void* data, uint64_t bytes);
+    template <typename T>
+    void SetConstant(const std::string& name, ppl::common::datatype_t data_type, const std::vector<int64_t>& dims,
+                     const std::vector<T>& values) {
+        SetConstant(name, data_type, dims, values.data(), values.size() * sizeof(T));
+    }
+    void SetParam(const std::string& node_name, const std::shared_ptr<void>& param);
+
+    /** @brief marks inputs, constants excluded, and outputs, then optimizes the graph */
+    ppl::common::RetCode Process();
+
+    /** @brief kernel of node `node_name` after `Process()`, or nullptr if the node is removed */
+    const x86::X86OptKernel* GetOptKernel(const std::string& node_name) const;
+    /** @brief format of output `idx` of node `node_name` chosen by the engine, or DATAFORMAT_UNKNOWN if the node is
+        removed */
+    ppl::common::dataformat_t GetOutputFormat(const std::string& node_name, uint32_t idx = 0) const;
+    /** @brief number of nodes of type `op_type` after `Process()` */
+    uint32_t CountNodes(const std::string& op_type) const;
+
+    Runtime* CreateRuntime();
+
+    static ppl::common::RetCode SetInputData(Runtime*, const std::string& name, const std::vector<int64_t>& dims,
+                                             const std::vector<float>& data);
+    /** @brief converts output `name` to fp32 ndarray */
+    static ppl::common::RetCode GetOutputData(Runtime*, const std::string& name, std::vector<float>* data);
+    /** @brief dims of output `name` after `Run()`, or empty if it is a scalar or not found */
+    static std::vector<int64_t> GetOutputDims(Runtime*, const std::string& name);
+    /** @brief buffer of output `name` after `Run()`, or nullptr if not found */
+    static const void* GetOutputBufferPtr(Runtime*, const std::string& name);
+
+private:
+    GraphBuilder builder_;
+    std::shared_ptr<utils::SharedResource> resource_;
+    std::shared_ptr<RuntimeGraphInfo> graph_info_;
+    std::shared_ptr<RuntimeAuxInfo> aux_info_;
+};
+
+}}} // namespace ppl::nn::test
+
+#endif
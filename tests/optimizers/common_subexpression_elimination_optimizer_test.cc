@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/common_subexpression_elimination_optimizer.h"
+#include "gtest/gtest.h"
+#include "tests/ir/graph_builder.h"
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class CommonSubexpressionEliminationOptimizerTest : public testing::Test {
+protected:
+    uint32_t CountNodes() {
+        uint32_t count = 0;
+        for (auto it = builder_.GetGraph()->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            ++count;
+        }
+        return count;
+    }
+
+    GraphBuilder builder_;
+};
+
+TEST_F(CommonSubexpressionEliminationOptimizerTest, merge_duplicated_chain) {
+    builder_.AddNode("relu_0", ir::Node::Type("", "Relu"), {"x"}, {"r0"});
+    builder_.AddNode("relu_1", ir::Node::Type("", "Relu"), {"x"}, {"r1"});
+    builder_.AddNode("sigmoid_0", ir::Node::Type("", "Sigmoid"), {"r0"}, {"s0"});
+    builder_.AddNode("sigmoid_1", ir::Node::Type("", "Sigmoid"), {"r1"}, {"s1"});
+    builder_.AddNode("add", ir::Node::Type("", "Add"), {"s0", "s1"}, {"y"});
+    builder_.Finalize();
+
+    auto topo = builder_.GetGraph()->topo.get();
+    CommonSubexpressionEliminationOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(builder_.GetGraph()));
+
+    EXPECT_EQ(3, CountNodes());
+    // either branch may be kept
+    EXPECT_TRUE((topo->GetEdgeByName("r0") == nullptr) != (topo->GetEdgeByName("r1") == nullptr));
+    EXPECT_TRUE((topo->GetEdgeByName("s0") == nullptr) != (topo->GetEdgeByName("s1") == nullptr));
+
+    auto y = topo->GetEdgeByName("y");
+    auto add = topo->GetNodeById(y->GetProducer());
+    EXPECT_EQ(add->GetInput(0), add->GetInput(1));
+    auto s = topo->GetEdgeById(add->GetInput(0));
+    ASSERT_NE(nullptr, s);
+    EXPECT_EQ(1, s->CalcConsumerCount());
+}
+
+TEST_F(CommonSubexpressionEliminationOptimizerTest, keep_graph_outputs) {
+    builder_.AddNode("relu_0", ir::Node::Type("", "Relu"), {"x"}, {"y0"});
+    builder_.AddNode("relu_1", ir::Node::Type("", "Relu"), {"x"}, {"y1"});
+    builder_.Finalize();
+
+    CommonSubexpressionEliminationOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(builder_.GetGraph()));
+    EXPECT_EQ(2, CountNodes());
+}
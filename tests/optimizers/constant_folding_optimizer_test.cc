@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/constant_folding_optimizer.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/gather_param.h"
+#include "ppl/nn/params/onnx/unsqueeze_param.h"
+#include "gtest/gtest.h"
+#include "tests/ir/graph_builder.h"
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class ConstantFoldingOptimizerTest : public testing::Test {
+protected:
+    template <typename T>
+    void SetConstant(const string& name, datatype_t data_type, const vector<int64_t>& dims, const vector<T>& values) {
+        auto graph = builder_.GetGraph();
+        auto edge = graph->topo->GetEdgeByName(name);
+        graph->topo->MarkAsConstant(edge->GetId());
+        graph->data->constants[edge->GetId()].data.assign((const char*)values.data(), values.size() * sizeof(T));
+        auto& shape = graph->data->shapes[edge->GetId()];
+        shape.data_type = data_type;
+        shape.data_format = DATAFORMAT_NDARRAY;
+        shape.dims = dims;
+    }
+
+    template <typename T>
+    vector<T> GetConstant(edgeid_t eid) {
+        auto& data = builder_.GetGraph()->data->constants[eid].data;
+        return vector<T>((const T*)data.data(), (const T*)(data.data() + data.size()));
+    }
+
+    ir::Node* FindNode(const string& name) {
+        for (auto it = builder_.GetGraph()->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            if (it->Get()->GetName() == name) {
+                return it->Get();
+            }
+        }
+        return nullptr;
+    }
+
+    uint32_t CountNodes() {
+        uint32_t count = 0;
+        for (auto it = builder_.GetGraph()->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            ++count;
+        }
+        return count;
+    }
+
+    GraphBuilder builder_;
+};
+
+// Reshape(x, Concat(Unsqueeze(Gather(Shape(w), 0)), [-1])) as exported by x.view(w.size(0), -1)
+TEST_F(ConstantFoldingOptimizerTest, fold_shape_chain) {
+    builder_.AddNode("reshape", ir::Node::Type("", "Reshape"), {"x", "new_shape"}, {"y"});
+    builder_.AddNode("shape", ir::Node::Type("", "Shape"), {"w"}, {"w_shape"});
+    builder_.AddNode("gather", ir::Node::Type("", "Gather"), {"w_shape", "idx"}, {"w_dim0"});
+    builder_.AddNode("unsqueeze", ir::Node::Type("", "Unsqueeze"), {"w_dim0"}, {"w_dim0_1d"});
+    builder_.AddNode("concat", ir::Node::Type("", "Concat"), {"w_dim0_1d", "minus_one"}, {"new_shape"});
+    builder_.Finalize();
+
+    auto graph = builder_.GetGraph();
+    auto topo = graph->topo.get();
+    SetConstant<float>("w", DATATYPE_FLOAT32, {2, 3, 4}, vector<float>(24, 1.0f));
+    SetConstant<int64_t>("idx", DATATYPE_INT64, {}, {0});
+    SetConstant<int64_t>("minus_one", DATATYPE_INT64, {1}, {-1});
+
+    auto gather_param = make_shared<common::GatherParam>();
+    gather_param->axis = 0;
+    graph->data->attrs[FindNode("gather")->GetId()] = gather_param;
+    auto unsqueeze_param = make_shared<common::UnsqueezeParam>();
+    unsqueeze_param->axes = {0};
+    graph->data->attrs[FindNode("unsqueeze")->GetId()] = unsqueeze_param;
+    auto concat_param = make_shared<common::ConcatParam>();
+    concat_param->axis = 0;
+    graph->data->attrs[FindNode("concat")->GetId()] = concat_param;
+
+    ConstantFoldingOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    EXPECT_EQ(1, CountNodes());
+    EXPECT_NE(nullptr, FindNode("reshape"));
+    EXPECT_EQ(nullptr, topo->GetEdgeByName("w"));
+    EXPECT_EQ(nullptr, topo->GetEdgeByName("w_dim0"));
+
+    auto new_shape = topo->GetEdgeByName("new_shape");
+    ASSERT_NE(nullptr, new_shape);
+    EXPECT_EQ(INVALID_NODEID, new_shape->GetProducer());
+    EXPECT_EQ(vector<int64_t>({2}), graph->data->shapes[new_shape->GetId()].dims);
+    EXPECT_EQ(vector<int64_t>({2, -1}), GetConstant<int64_t>(new_shape->GetId()));
+}
+
+TEST_F(ConstantFoldingOptimizerTest, fold_broadcast_arithmetic) {
+    builder_.AddNode("add", ir::Node::Type("", "Add"), {"a", "b"}, {"sum"});
+    builder_.AddNode("mul", ir::Node::Type("", "Mul"), {"sum", "x"}, {"y"});
+    builder_.Finalize();
+
+    auto graph = builder_.GetGraph();
+    auto topo = graph->topo.get();
+    SetConstant<float>("a", DATATYPE_FLOAT32, {2, 1}, {1.0f, 2.0f});
+    SetConstant<float>("b", DATATYPE_FLOAT32, {3}, {10.0f, 20.0f, 30.0f});
+
+    ConstantFoldingOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    // Mul has a non-constant input and is kept
+    EXPECT_EQ(1, CountNodes());
+    auto sum = topo->GetEdgeByName("sum");
+    ASSERT_NE(nullptr, sum);
+    EXPECT_EQ(vector<int64_t>({2, 3}), graph->data->shapes[sum->GetId()].dims);
+    EXPECT_EQ(vector<float>({11.0f, 21.0f, 31.0f, 12.0f, 22.0f, 32.0f}), GetConstant<float>(sum->GetId()));
+}
+
+TEST_F(ConstantFoldingOptimizerTest, fold_slice_with_negative_step) {
+    builder_.AddNode("slice", ir::Node::Type("", "Slice"), {"data", "starts", "ends", "axes", "steps"}, {"sliced"});
+    builder_.AddNode("relu", ir::Node::Type("", "Relu"), {"sliced"}, {"y"});
+    builder_.Finalize();
+
+    auto graph = builder_.GetGraph();
+    auto topo = graph->topo.get();
+    SetConstant<int64_t>("data", DATATYPE_INT64, {2, 4}, {0, 1, 2, 3, 4, 5, 6, 7});
+    SetConstant<int64_t>("starts", DATATYPE_INT64, {1}, {-1});
+    SetConstant<int64_t>("ends", DATATYPE_INT64, {1}, {INT64_MIN});
+    SetConstant<int64_t>("axes", DATATYPE_INT64, {1}, {1});
+    SetConstant<int64_t>("steps", DATATYPE_INT64, {1}, {-2});
+
+    ConstantFoldingOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    auto sliced = topo->GetEdgeByName("sliced");
+    ASSERT_NE(nullptr, sliced);
+    EXPECT_EQ(vector<int64_t>({2, 2}), graph->data->shapes[sliced->GetId()].dims);
+    EXPECT_EQ(vector<int64_t>({3, 1, 7, 5}), GetConstant<int64_t>(sliced->GetId()));
+}
@@ -0,0 +1,215 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
+
+#include "gtest/gtest.h"
+#include "tests/ir/graph_builder.h"
+#include "tests/engines/tmp_engine.h"
+
+#include <map>
+#include <vector>
+#include <memory>
+
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+using namespace ppl::nn::test;
+
+class TableCostModel final : public GraphPartitionCostModel {
+public:
+    void SetOpCost(const string& engine, const string& op, double cost) {
+        op_costs_[make_pair(engine, op)] = cost;
+    }
+    double GetOpCost(const ir::Graph*, const ir::Node* node, EngineImpl* engine) const override {
+        auto ref = op_costs_.find(make_pair(string(engine->GetName()), node->GetType().name));
+        return (ref == op_costs_.end()) ? 1.0 : ref->second;
+    }
+    double GetConversionCost(const ir::Graph*, const ir::Edge*, EngineImpl*, EngineImpl*) const override {
+        return 2.0;
+    }
+    double GetPartitionCost() const override {
+        return 4.0;
+    }
+
+private:
+    map<pair<string, string>, double> op_costs_;
+};
+
+class CostGraphPartitionerTest : public testing::Test {
+protected:
+    virtual void SetUp() override {
+        builder_.SetGraphName("tmp");
+        builder_.AddNode("a", ir::Node::Type("test", "op1"), {"input_of_a"}, {"output_of_a"});
+        builder_.AddNode("b", ir::Node::Type("test", "op2"), {"output_of_a"}, {"output_of_b"});
+        builder_.AddNode("c", ir::Node::Type("test", "op3"), {"output_of_b"}, {"output_of_c"});
+        builder_.AddNode("d", ir::Node::Type("test", "op4"), {"output_of_c"}, {"output_of_d"});
+        builder_.Finalize();
+    }
+
+    static string GetEngineOfNode(const vector<pair<EngineImpl*, vector<nodeid_t>>>& partitions, nodeid_t nid) {
+        for (auto p = partitions.begin(); p != partitions.end(); ++p) {
+            for (auto x = p->second.begin(); x != p->second.end(); ++x) {
+                if (*x == nid) {
+                    return p->first->GetName();
+                }
+            }
+        }
+        return "";
+    }
+
+    GraphBuilder builder_;
+    utils::SharedResource resource_;
+};
+
+TEST_F(CostGraphPartitionerTest, disjoint_engines) {
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineTwo()));
+
+    CostGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder_.GetGraph(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(2, partitions.size());
+    EXPECT_EQ("tmpOne", GetEngineOfNode(partitions, 0));
+    EXPECT_EQ("tmpOne", GetEngineOfNode(partitions, 1));
+    EXPECT_EQ("tmpTwo", GetEngineOfNode(partitions, 2));
+    EXPECT_EQ("tmpTwo", GetEngineOfNode(partitions, 3));
+}
+
+TEST_F(CostGraphPartitionerTest, merge_small_island) {
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny()));
+
+    // first-match puts a and b on tmpOne, but a whole graph on tmpAny saves a conversion and a partition
+    CostGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder_.GetGraph(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(1, partitions.size());
+    EXPECT_EQ(string("tmpAny"), partitions[0].first->GetName());
+    EXPECT_EQ(4, partitions[0].second.size());
+}
+
+TEST_F(CostGraphPartitionerTest, keep_cheaper_engine) {
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny()));
+
+    TableCostModel cost_model;
+    cost_model.SetOpCost("tmpAny", "op1", 10);
+    cost_model.SetOpCost("tmpAny", "op2", 10);
+
+    CostGraphPartitioner partitioner(&cost_model);
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder_.GetGraph(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(2, partitions.size());
+    EXPECT_EQ("tmpOne", GetEngineOfNode(partitions, 0));
+    EXPECT_EQ("tmpOne", GetEngineOfNode(partitions, 1));
+    EXPECT_EQ("tmpAny", GetEngineOfNode(partitions, 2));
+    EXPECT_EQ("tmpAny", GetEngineOfNode(partitions, 3));
+}
+
+TEST_F(CostGraphPartitionerTest, avoid_conversions) {
+    GraphBuilder builder;
+    builder.SetGraphName("tmp");
+    builder.AddNode("x", ir::Node::Type("test", "op1"), {"input_of_x"}, {"output_of_x"});
+    builder.AddNode("y", ir::Node::Type("test", "op5"), {"output_of_x"}, {"output_of_y"});
+    builder.AddNode("z", ir::Node::Type("test", "op2"), {"output_of_y"}, {"output_of_z"});
+    builder.Finalize();
+
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny()));
+
+    // only tmpAny runs op5, and moving x and z there removes both conversions without merging islands
+    CostGraphPartitioner partitioner;
+    partitioner.SetMaxIslandSize(0);
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder.GetGraph(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(1, partitions.size());
+    EXPECT_EQ(string("tmpAny"), partitions[0].first->GetName());
+}
+
+TEST_F(CostGraphPartitionerTest, merge_islands_in_chain) {
+    // op5 -> [op1 -> op2] -> op5 -> [op1 -> op2] -> op5 -> [op1 -> op2] -> op5
+    GraphBuilder builder;
+    builder.SetGraphName("tmp");
+    string input = "input_of_0";
+    for (int i = 0; i < 10; ++i) {
+        const string op = (i % 3 == 0) ? "op5" : ((i % 3 == 1) ? "op1" : "op2");
+        const string output = "output_of_" + std::to_string(i);
+        builder.AddNode("n" + std::to_string(i), ir::Node::Type("test", op), {input}, {output});
+        input = output;
+    }
+    builder.Finalize();
+
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny()));
+
+    /*
+      moving a single op1 or op2 to tmpAny costs 5 more and saves no conversion. moving a pair costs 10 more, which
+      pays off only by saving both conversions and both partitions around it. each pair after the first one is next
+      to a partition which an earlier move has joined.
+    */
+    TableCostModel cost_model;
+    cost_model.SetOpCost("tmpAny", "op1", 6);
+    cost_model.SetOpCost("tmpAny", "op2", 6);
+
+    CostGraphPartitioner partitioner(&cost_model);
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder.GetGraph(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(1, partitions.size());
+    EXPECT_EQ(string("tmpAny"), partitions[0].first->GetName());
+    EXPECT_EQ(10, partitions[0].second.size());
+}
+
+TEST_F(CostGraphPartitionerTest, engine_estimated_cost) {
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny("tmpSlow", 100)));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny("tmpFast", 1)));
+
+    CostGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder_.GetGraph(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(1, partitions.size());
+    EXPECT_EQ(string("tmpFast"), partitions[0].first->GetName());
+}
+
+TEST_F(CostGraphPartitionerTest, partially_estimated_cost) {
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineAny("tmpAny", 0.1)));
+
+    // estimations of tmpAny are ignored for op1 and op2 because tmpOne gives none
+    DefaultGraphPartitionCostModel cost_model(&resource_.engines);
+    auto graph = builder_.GetGraph();
+    auto topo = graph->topo.get();
+    auto engine_any = resource_.engines[1].get();
+    EXPECT_EQ(cost_model.GetOpCost(graph, topo->GetNodeById(0), resource_.engines[0].get()),
+              cost_model.GetOpCost(graph, topo->GetNodeById(0), engine_any));
+    EXPECT_DOUBLE_EQ(0.1, cost_model.GetOpCost(graph, topo->GetNodeById(2), engine_any));
+}
+
+TEST_F(CostGraphPartitionerTest, unsupported_op) {
+    resource_.engines.emplace_back(unique_ptr<EngineImpl>(new TmpEngineOne()));
+
+    CostGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(&resource_, builder_.GetGraph(), &partitions);
+    EXPECT_EQ(RC_NOT_FOUND, status);
+}
@@ -0,0 +1,55 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/dead_node_elimination_optimizer.h"
+#include "gtest/gtest.h"
+#include "tests/ir/graph_builder.h"
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+TEST(DeadNodeEliminationOptimizerTest, remove_unused_chain_and_constants) {
+    GraphBuilder builder;
+    builder.AddNode("relu", ir::Node::Type("", "Relu"), {"x"}, {"y"});
+    builder.AddNode("mul", ir::Node::Type("", "Mul"), {"x", "w"}, {"m"});
+    builder.AddNode("sigmoid", ir::Node::Type("", "Sigmoid"), {"m"}, {"s"});
+
+    auto graph = builder.GetGraph();
+    auto topo = graph->topo.get();
+    // "s" is not a graph output
+    topo->MarkAsInput(topo->GetEdgeByName("x")->GetId());
+    topo->MarkAsOutput(topo->GetEdgeByName("y")->GetId());
+    auto w = topo->GetEdgeByName("w");
+    topo->MarkAsConstant(w->GetId());
+    graph->data->constants[w->GetId()].data = string(4, '\0');
+
+    DeadNodeEliminationOptimizer optimizer;
+    EXPECT_EQ(RC_SUCCESS, optimizer.Optimize(graph));
+
+    uint32_t node_count = 0;
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        EXPECT_EQ("relu", it->Get()->GetName());
+        ++node_count;
+    }
+    EXPECT_EQ(1, node_count);
+    EXPECT_EQ(nullptr, topo->GetEdgeByName("m"));
+    EXPECT_EQ(nullptr, topo->GetEdgeByName("w"));
+    EXPECT_EQ(0, topo->GetConstantCount());
+    EXPECT_TRUE(graph->data->constants.empty());
+    EXPECT_EQ(1, topo->GetEdgeByName("x")->CalcConsumerCount());
+}
@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/optimizers/utils.h"
+#include "ppl/nn/engines/engine_impl.h"
+#include "ppl/nn/runtime/runtime_partition_info.h"
+#include "ppl/nn/runtime/tensor_impl.h"
+#include "tests/engines/tmp_engine_context.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+// what CountingKernel saw in each run
+struct RunRecord final {
+    bool input_is_set = false;
+    bool input_is_zero = true;
+};
+
+// copies its input to its output and records the input of every run
+class CountingKernel final : public KernelImpl {
+public:
+    CountingKernel(const ir::Node* node, vector<RunRecord>* records) : KernelImpl(node), records_(records) {}
+    RetCode Execute(KernelExecContext* ctx) override {
+        auto input = ctx->GetInput<TensorImpl>(0);
+        auto output = ctx->GetOutput<TensorImpl>(0);
+
+        RunRecord record;
+        vector<float> data(input->GetShape().GetElementsIncludingPadding());
+        record.input_is_set = (input->GetBufferPtr() != nullptr);
+        if (record.input_is_set) {
+            auto status = input->CopyToHost(data.data());
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+            for (auto value : data) {
+                record.input_is_zero = record.input_is_zero && (value == 0);
+            }
+        }
+        records_->push_back(record);
+
+        output->GetShape() = input->GetShape();
+        auto status = output->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+        return output->CopyFromHost(data.data());
+    }
+
+private:
+    vector<RunRecord>* records_;
+};
+
+class CountingOptKernel final : public OptKernel {
+public:
+    CountingOptKernel(const ir::Node* node, vector<RunRecord>* records) : OptKernel(node), records_(records) {}
+    KernelImpl* CreateKernelImpl() const override {
+        return new CountingKernel(GetNode(), records_);
+    }
+
+private:
+    vector<RunRecord>* records_;
+};
+
+class CountingEngine final : public EngineImpl {
+public:
+    CountingEngine(vector<RunRecord>* records) : EngineImpl("counting"), records_(records) {}
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+    EngineContext* CreateEngineContext(const string&, const EngineContextOptions&) override {
+        return new TmpEngineContext(GetName());
+    }
+    bool CanRunOp(const ir::Node*) const override {
+        return true;
+    }
+    RetCode ProcessGraph(utils::SharedResource*, ir::Graph* graph, RuntimePartitionInfo* info) override {
+        for (auto it = graph->topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            info->kernels.emplace(node->GetId(), unique_ptr<OptKernel>(new CountingOptKernel(node, records_)));
+        }
+        return RC_SUCCESS;
+    }
+
+private:
+    vector<RunRecord>* records_;
+};
+
+class RuntimeWarmUpTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("count", ir::Node::Type("test", "count"), {"x"}, {"y"});
+        auto topo = builder_.GetGraph()->topo.get();
+        topo->MarkAsInput(topo->GetEdgeByName("x")->GetId());
+        topo->MarkAsOutput(topo->GetEdgeByName("y")->GetId());
+        builder_.Finalize();
+
+        resource_ = make_shared<utils::SharedResource>();
+        resource_->engines.emplace_back(unique_ptr<EngineImpl>(new CountingEngine(&records_)));
+        graph_info_ = make_shared<RuntimeGraphInfo>();
+        aux_info_ = make_shared<RuntimeAuxInfo>();
+        ASSERT_EQ(RC_SUCCESS, utils::ProcessGraph(resource_.get(), builder_.GetGraph(), graph_info_.get()));
+        ASSERT_EQ(RC_SUCCESS, GenerateRuntimeAuxInfo(*graph_info_, aux_info_.get()));
+
+        runtime_.reset(new RuntimeImpl());
+        ASSERT_EQ(RC_SUCCESS,
+                  runtime_->Init(RuntimeOptions(), builder_.GetGraph()->topo, graph_info_, aux_info_, resource_));
+
+        auto& shape = runtime_->GetInputTensor(0)->GetShape();
+        shape.SetDataType(DATATYPE_FLOAT32);
+        shape.SetDataFormat(DATAFORMAT_NDARRAY);
+        shape.Reshape({2, 3});
+    }
+
+protected:
+    vector<RunRecord> records_;
+    GraphBuilder builder_;
+    shared_ptr<utils::SharedResource> resource_;
+    shared_ptr<RuntimeGraphInfo> graph_info_;
+    shared_ptr<RuntimeAuxInfo> aux_info_;
+    unique_ptr<RuntimeImpl> runtime_;
+};
+
+TEST_F(RuntimeWarmUpTest, runs_count_times_with_zero_inputs) {
+    ASSERT_EQ(RC_SUCCESS, runtime_->WarmUp(3));
+    ASSERT_EQ(3u, records_.size());
+    for (auto& record : records_) {
+        EXPECT_TRUE(record.input_is_set);
+        EXPECT_TRUE(record.input_is_zero);
+    }
+
+    // inputs set by callers are kept
+    records_.clear();
+    vector<float> x = {1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(RC_SUCCESS, runtime_->GetInputTensor(0)->CopyFromHost(x.data()));
+    ASSERT_EQ(RC_SUCCESS, runtime_->WarmUp(1));
+    ASSERT_EQ(1u, records_.size());
+    EXPECT_FALSE(records_[0].input_is_zero);
+
+    records_.clear();
+    ASSERT_EQ(RC_SUCCESS, runtime_->WarmUp(0));
+    EXPECT_EQ(0u, records_.size());
+}
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+TEST_F(RuntimeWarmUpTest, profiling_excludes_warm_up_runs) {
+    ASSERT_EQ(RC_SUCCESS, runtime_->Configure(RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG, 1u));
+    ASSERT_EQ(RC_SUCCESS, runtime_->WarmUp(2));
+    ASSERT_EQ(RC_SUCCESS, runtime_->Run());
+    ASSERT_EQ(RC_SUCCESS, runtime_->Sync());
+    EXPECT_EQ(3u, records_.size());
+
+    ProfilingStatistics stat;
+    ASSERT_EQ(RC_SUCCESS, runtime_->GetProfilingStatistics(&stat));
+    ASSERT_EQ(1u, stat.prof_info.size());
+    EXPECT_EQ(1u, stat.prof_info[0].exec_count);
+}
+#endif
@@ -20,6 +20,7 @@
 #include "ppl/nn/utils/version.h"
 #include "ppl/common/file_mapping.h"
 #include <string.h>
+#include <stdlib.h>
 #include <chrono>
 #include <string>
 #include <memory>
@@ -109,11 +110,32 @@ static inline bool RegisterEngines(vector<unique_ptr<Engine>>* engines) {
 
 Define_bool_opt("--disable-avx512", g_flag_disable_avx512, false, "disable avx512 feature");
 Define_bool_opt("--core-binding", g_flag_core_binding, false, "core binding");
+Define_bool_opt("--huge-page", g_flag_huge_page, false, "use transparent huge pages for large buffers");
+Define_string_opt("--numa-policy", g_flag_numa_policy, "",
+                  "\"local\" => bind large buffers to the local NUMA node, or \"interleave\" => interleave them");
+Define_uint32_opt("--num-threads", g_flag_num_threads, 0, "number of threads used by kernels, 0 => openmp default");
+Define_int32list_opt("--cpu-list", g_flag_cpu_list, "cpus separated by space that threads of kernels are bound to");
+Define_bool_opt("--thread-pool", g_flag_thread_pool, false, "run supported kernels on a spinning thread pool");
+Define_int64_opt("--spin-count", g_flag_spin_count, -1,
+                 "polls of idle thread pool workers before sleeping, 0 => sleeping at once, -1 => default");
 
 #include "ppl/nn/engines/x86/engine_factory.h"
 #include "ppl/nn/engines/x86/x86_options.h"
 #include "ppl/kernel/x86/common/threading_tools.h"
 static inline bool RegisterEngines(vector<unique_ptr<Engine>>* engines) {
+    uint32_t mem_policy = ppl::nn::x86::X86_MEM_DEFAULT;
+    if (g_flag_huge_page) {
+        mem_policy |= ppl::nn::x86::X86_MEM_HUGE_PAGE;
+    }
+    if (g_flag_numa_policy == "local") {
+        mem_policy |= ppl::nn::x86::X86_MEM_NUMA_LOCAL;
+    } else if (g_flag_numa_policy == "interleave") {
+        mem_policy |= ppl::nn::x86::X86_MEM_NUMA_INTERLEAVE;
+    } else if (!g_flag_numa_policy.empty()) {
+        LOG(ERROR) << "unknown numa policy[" << g_flag_numa_policy << "]";
+        return false;
+    }
+
     auto x86_engine = X86EngineFactory::Create();
     if (g_flag_disable_avx512) {
         x86_engine->Configure(ppl::nn::x86::X86_CONF_DISABLE_AVX512);
@@ -121,6 +143,22 @@ static inline bool RegisterEngines(vector<unique_ptr<Engine>>* engines) {
     if (g_flag_core_binding) {
         ppl::kernel::x86::set_omp_core_binding(nullptr, 0, 1);
     }
+    if (mem_policy != ppl::nn::x86::X86_MEM_DEFAULT) {
+        x86_engine->Configure(ppl::nn::x86::X86_CONF_SET_MEMORY_POLICY, mem_policy);
+    }
+    if (g_flag_num_threads > 0) {
+        x86_engine->Configure(ppl::nn::x86::X86_CONF_SET_THREAD_NUM, g_flag_num_threads);
+    }
+    if (!g_flag_cpu_list.empty()) {
+        x86_engine->Configure(ppl::nn::x86::X86_CONF_SET_CPU_SET, g_flag_cpu_list.data(),
+                              (uint32_t)g_flag_cpu_list.size());
+    }
+    if (g_flag_thread_pool) {
+        x86_engine->Configure(ppl::nn::x86::X86_CONF_SET_PARALLEL_BACKEND, ppl::nn::x86::X86_PARALLEL_THREAD_POOL);
+    }
+    if (g_flag_spin_count >= 0) {
+        x86_engine->Configure(ppl::nn::x86::X86_CONF_SET_THREAD_POOL_SPIN_COUNT, (uint64_t)g_flag_spin_count);
+    }
     // configure engine
     engines->emplace_back(unique_ptr<Engine>(x86_engine));
     LOG(INFO) << "***** register X86Engine *****";
@@ -781,12 +819,18 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (g_flag_warmup_times > 0) {
+        LOG(INFO) << "Warm up start for " << g_flag_warmup_times << " times.";
+        auto status = runtime->WarmUp(g_flag_warmup_times);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "WarmUp() failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+        LOG(INFO) << "Warm up end.";
+    }
+
     auto run_begin_ts = std::chrono::system_clock::now();
 #ifdef PPLNN_USE_CUDA
-    for (uint32_t i = 0; i < g_flag_warmup_times; ++i) {
-        runtime->Run();
-    }
-    run_begin_ts = std::chrono::system_clock::now();
     for (uint32_t i = 0; i < g_flag_running_times - 1; ++i) {
         runtime->Run();
     }
@@ -815,16 +859,6 @@ int main(int argc, char* argv[]) {
     LOG(INFO) << "Run ok";
 
     if (g_flag_enable_profiling) {
-        if (g_flag_warmup_times > 0) {
-            LOG(INFO) << "Warm up start for " << g_flag_warmup_times << " times.";
-            for (uint32_t i = 0; i < g_flag_warmup_times; ++i) {
-                auto status = runtime->Run();
-                if (status == RC_SUCCESS) {
-                    status = runtime->Sync();
-                }
-            }
-            LOG(INFO) << "Warm up end.";
-        }
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
         auto status = runtime->Configure(RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG, true);
         if (status != RC_SUCCESS) {